@@ -0,0 +1,406 @@
+/*
+ * Copyright (c) 2014-2016 Jim Tremblay
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/*
+ * Latency benchmark of nOS services, measured with nOS_GetCycleCount (NOS_CONFIG_CYCLE_COUNTER_ENABLE).
+ *
+ * Cortex-M3/M4/M7 ports count CPU cycles with DWT->CYCCNT, POSIX port count nanoseconds of host monotonic clock
+ * (pthread switch time of the host, not of a target CPU).
+ *
+ *   sem give -> waiter wake    : nOS_SemGive from a thread until a higher prio thread waiting on semaphore run.
+ *   queue round trip           : nOS_QueueWrite to a higher prio reader until its answer is read back.
+ *   mutex handoff (inherit)    : nOS_MutexUnlock by a boosted owner until the higher prio waiter own it and run.
+ *   context switch (yield)     : nOS_Yield until the other thread of same prio run (PendSV on Cortex-M).
+ *   nOS_Tick, n threads/timers : one call to nOS_Tick(1) with n threads sleeping and n timers running.
+ *
+ * Each line give minimum, average and maximum of BENCH_SAMPLES measures. Maximum include interrupts that occur during
+ * the measure (tick, other peripherals). nOS_Tick is called from the benchmark thread to isolate its cost, every call
+ * advance tick counter by one like a real tick. A line give "no samples" when the measured thread never ran.
+ *
+ * Configuration needed in nOSConfig.h, in addition to default ones:
+ *   - NOS_CONFIG_CYCLE_COUNTER_ENABLE set to 1.
+ *   - NOS_CONFIG_HIGHEST_THREAD_PRIO set to 3 or higher and NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE set to 1.
+ *   - NOS_CONFIG_SEM_ENABLE, NOS_CONFIG_QUEUE_ENABLE, NOS_CONFIG_MUTEX_ENABLE, NOS_CONFIG_SLEEP_ENABLE,
+ *     NOS_CONFIG_TIMER_ENABLE and NOS_CONFIG_TIMER_TICK_ENABLE set to 1.
+ * Results are printed with printf, retarget it to an UART or to semihosting on MCU. Run it again with the options that
+ * need to be evaluated (NOS_CONFIG_SORTED_TIMEOUT_LIST_ENABLE, NOS_CONFIG_TIMER_WHEEL_ENABLE, ...) to compare them.
+ *
+ * On MCU, SysTick must be configured and its handler must call nOS_Tick before main call nOS_Start.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "nOS.h"
+
+#ifdef NOS_SIMULATED_STACK
+ #ifdef _WIN32
+  #include <windows.h>
+ #else
+  #include <unistd.h>
+ #endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if (NOS_CONFIG_CYCLE_COUNTER_ENABLE == 0)
+ #error "Benchmark: NOS_CONFIG_CYCLE_COUNTER_ENABLE must be set to 1."
+#endif
+#if (NOS_CONFIG_HIGHEST_THREAD_PRIO < 3) || (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE == 0)
+ #error "Benchmark: preemptive scheduler with NOS_CONFIG_HIGHEST_THREAD_PRIO of 3 or higher is needed."
+#endif
+#if (NOS_CONFIG_SEM_ENABLE == 0) || (NOS_CONFIG_QUEUE_ENABLE == 0) || (NOS_CONFIG_MUTEX_ENABLE == 0)
+ #error "Benchmark: semaphore, queue and mutex modules must be enabled."
+#endif
+#if (NOS_CONFIG_SLEEP_ENABLE == 0) || (NOS_CONFIG_TIMER_ENABLE == 0) || (NOS_CONFIG_TIMER_TICK_ENABLE == 0)
+ #error "Benchmark: sleep and timer modules must be enabled, with timers updated by nOS_Tick."
+#endif
+
+#define BENCH_SAMPLES                   100
+#define BENCH_STACK_SIZE                256
+#define BENCH_CALL_STACK_SIZE           16
+#define BENCH_MAX_LOAD                  16      /* Highest number of sleeping threads and running timers */
+#define BENCH_LOAD_DELAY                60000   /* Ticks, sleeping threads and timers never expire during the tests */
+
+#define BENCH_LOW_PRIO                  1       /* Sleeping threads */
+#define BENCH_PRIO                      2       /* Benchmark thread */
+#define BENCH_HIGH_PRIO                 3       /* Threads waked up by benchmark thread */
+
+#if (NOS_CONFIG_THREAD_JOIN_ENABLE > 0)
+ #define BENCH_THREAD(name)             static int name (void *arg)
+ #define BENCH_THREAD_END               return 0
+#else
+ #define BENCH_THREAD(name)             static void name (void *arg)
+ #define BENCH_THREAD_END               return
+#endif
+
+#ifdef NOS_SIMULATED_STACK
+ #define _Stack(i)                      &_stacks[i]
+ static nOS_Stack                       _stacks[5 + BENCH_MAX_LOAD];
+#else
+ #define _Stack(i)                      _stacks[i]
+ static nOS_Stack                       _stacks[5 + BENCH_MAX_LOAD][BENCH_STACK_SIZE];
+#endif
+
+typedef struct _Stats
+{
+    uint32_t    min;
+    uint32_t    max;
+    uint32_t    sum;
+    uint32_t    count;
+} _Stats;
+
+static nOS_Thread               _bench;
+static nOS_Thread               _semWaiter;
+static nOS_Thread               _queueReader;
+static nOS_Thread               _mutexWaiter;
+static nOS_Thread               _yieldPartner;
+static nOS_Thread               _sleepers[BENCH_MAX_LOAD];
+static nOS_Timer                _timers[BENCH_MAX_LOAD];
+
+static nOS_Sem                  _sem;
+static nOS_Sem                  _go;
+static nOS_Sem                  _never;
+static nOS_Queue                _request;
+static nOS_Queue                _answer;
+static uint32_t                 _requestBuffer[1];
+static uint32_t                 _answerBuffer[1];
+static nOS_Mutex                _mutex;
+
+static volatile uint32_t        _start;
+static _Stats                   _stats;
+
+static void _Reset (void)
+{
+    _stats.min   = UINT32_MAX;
+    _stats.max   = 0;
+    _stats.sum   = 0;
+    _stats.count = 0;
+}
+
+static void _Sample (uint32_t cycles)
+{
+    if (cycles < _stats.min) {
+        _stats.min = cycles;
+    }
+    if (cycles > _stats.max) {
+        _stats.max = cycles;
+    }
+    _stats.sum += cycles;
+    _stats.count++;
+}
+
+static void _Print (const char *name, unsigned int n)
+{
+    char    label[32];
+
+    snprintf(label, sizeof(label), name, n);
+    if (_stats.count == 0) {
+        /* Measured thread never ran, scheduler has lost a switch */
+        printf("%-28s no samples\n", label);
+    } else {
+        printf("%-28s min %6lu avg %6lu max %6lu\n", label,
+               (unsigned long)_stats.min,
+               (unsigned long)(_stats.sum / _stats.count),
+               (unsigned long)_stats.max);
+    }
+}
+
+static void _CreateThread (nOS_Thread *thread, nOS_ThreadEntry entry, nOS_Stack *stack, uint8_t prio)
+{
+    nOS_ThreadCreate(thread,
+                     entry,
+                     NULL,
+                     stack,
+                     BENCH_STACK_SIZE
+#ifdef NOS_USE_SEPARATE_CALL_STACK
+                    ,BENCH_CALL_STACK_SIZE
+#endif
+                    ,prio
+#if (NOS_CONFIG_THREAD_SUSPEND_ENABLE > 0)
+                    ,NOS_THREAD_READY
+#endif
+#if (NOS_CONFIG_THREAD_NAME_ENABLE > 0)
+                    ,"Bench"
+#endif
+#if (NOS_CONFIG_THREAD_FPU_ENABLE > 0)
+                    ,false
+#endif
+#if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+                    ,0
+#endif
+                    );
+}
+
+BENCH_THREAD(_SemWaiter)
+{
+    NOS_UNUSED(arg);
+
+    for (;;) {
+        nOS_SemTake(&_sem, NOS_WAIT_INFINITE);
+        _Sample(nOS_GetCycleCount() - _start);
+    }
+
+    BENCH_THREAD_END;
+}
+
+BENCH_THREAD(_QueueReader)
+{
+    uint32_t    value;
+
+    NOS_UNUSED(arg);
+
+    for (;;) {
+        nOS_QueueRead(&_request, &value, NOS_WAIT_INFINITE);
+        nOS_QueueWrite(&_answer, &value, NOS_NO_WAIT);
+    }
+
+    BENCH_THREAD_END;
+}
+
+BENCH_THREAD(_MutexWaiter)
+{
+    NOS_UNUSED(arg);
+
+    for (;;) {
+        nOS_SemTake(&_go, NOS_WAIT_INFINITE);
+        /* Owner inherit prio of this thread until it unlock the mutex */
+        nOS_MutexLock(&_mutex, NOS_WAIT_INFINITE);
+        _Sample(nOS_GetCycleCount() - _start);
+        nOS_MutexUnlock(&_mutex);
+    }
+
+    BENCH_THREAD_END;
+}
+
+BENCH_THREAD(_YieldPartner)
+{
+    uint16_t    i;
+
+    NOS_UNUSED(arg);
+
+    /* First run come from thread creation, not from a switch that is measured */
+    nOS_Yield();
+    for (i = 0; i < BENCH_SAMPLES; i++) {
+        _Sample(nOS_GetCycleCount() - _start);
+        nOS_Yield();
+    }
+    for (;;) {
+        nOS_SemTake(&_never, NOS_WAIT_INFINITE);
+    }
+
+    BENCH_THREAD_END;
+}
+
+BENCH_THREAD(_Sleeper)
+{
+    NOS_UNUSED(arg);
+
+    for (;;) {
+        nOS_Sleep(BENCH_LOAD_DELAY);
+    }
+
+    BENCH_THREAD_END;
+}
+
+static void _TimerCallback (nOS_Timer *timer, void *arg)
+{
+    NOS_UNUSED(timer);
+    NOS_UNUSED(arg);
+}
+
+static void _BenchSem (void)
+{
+    uint16_t    i;
+
+    _Reset();
+    _CreateThread(&_semWaiter, _SemWaiter, _Stack(0), BENCH_HIGH_PRIO);
+    for (i = 0; i < BENCH_SAMPLES; i++) {
+        _start = nOS_GetCycleCount();
+        nOS_SemGive(&_sem);
+    }
+    _Print("sem give -> waiter wake", 0);
+}
+
+static void _BenchQueue (void)
+{
+    uint32_t    value = 0;
+    uint32_t    start;
+    uint16_t    i;
+
+    _Reset();
+    _CreateThread(&_queueReader, _QueueReader, _Stack(1), BENCH_HIGH_PRIO);
+    for (i = 0; i < BENCH_SAMPLES; i++) {
+        start = nOS_GetCycleCount();
+        nOS_QueueWrite(&_request, &value, NOS_NO_WAIT);
+        nOS_QueueRead(&_answer, &value, NOS_NO_WAIT);
+        _Sample(nOS_GetCycleCount() - start);
+    }
+    _Print("queue round trip", 0);
+}
+
+static void _BenchMutex (void)
+{
+    uint16_t    i;
+
+    _Reset();
+    _CreateThread(&_mutexWaiter, _MutexWaiter, _Stack(2), BENCH_HIGH_PRIO);
+    for (i = 0; i < BENCH_SAMPLES; i++) {
+        nOS_MutexLock(&_mutex, NOS_WAIT_INFINITE);
+        /* Waiter run and block on mutex */
+        nOS_SemGive(&_go);
+        _start = nOS_GetCycleCount();
+        nOS_MutexUnlock(&_mutex);
+    }
+    _Print("mutex handoff (inherit)", 0);
+}
+
+static void _BenchSwitch (void)
+{
+    uint16_t    i;
+
+    _Reset();
+    _CreateThread(&_yieldPartner, _YieldPartner, _Stack(3), BENCH_PRIO);
+    nOS_Yield();
+    for (i = 0; i < BENCH_SAMPLES; i++) {
+        _start = nOS_GetCycleCount();
+        nOS_Yield();
+    }
+    _Print("context switch (yield)", 0);
+}
+
+static void _BenchTick (void)
+{
+    static const uint8_t    loads[] = {0, 4, 8, BENCH_MAX_LOAD};
+    uint8_t                 created = 0;
+    uint32_t                start;
+    uint16_t                i;
+    uint8_t                 l;
+
+    for (l = 0; l < sizeof(loads); l++) {
+        while (created < loads[l]) {
+            _CreateThread(&_sleepers[created], _Sleeper, _Stack(5 + created), BENCH_LOW_PRIO);
+            nOS_TimerCreate(&_timers[created], _TimerCallback, NULL, BENCH_LOAD_DELAY, NOS_TIMER_FREE_RUNNING
+#if (NOS_CONFIG_TIMER_HIGHEST_PRIO > 0)
+                           ,0
+#endif
+#if (NOS_CONFIG_TIMER_SLACK_ENABLE > 0)
+                           ,0
+#endif
+                           );
+            nOS_TimerStart(&_timers[created]);
+            created++;
+        }
+        /* Let new threads start to sleep */
+        nOS_Sleep(2);
+
+        _Reset();
+        for (i = 0; i < BENCH_SAMPLES; i++) {
+            start = nOS_GetCycleCount();
+            nOS_Tick(1);
+            _Sample(nOS_GetCycleCount() - start);
+        }
+        _Print("nOS_Tick, %u threads/timers", loads[l]);
+    }
+}
+
+BENCH_THREAD(_Bench)
+{
+    NOS_UNUSED(arg);
+
+    printf("nOS benchmark, %u samples (cycles, ns on POSIX)\n", BENCH_SAMPLES);
+    _BenchSem();
+    _BenchQueue();
+    _BenchMutex();
+    _BenchSwitch();
+    _BenchTick();
+    printf("done\n");
+#ifdef NOS_SIMULATED_STACK
+    fflush(stdout);
+    exit(0);
+#endif
+
+    for (;;) {
+        nOS_SemTake(&_never, NOS_WAIT_INFINITE);
+    }
+
+    BENCH_THREAD_END;
+}
+
+int main (void)
+{
+    nOS_Init();
+
+    nOS_SemCreate(&_sem, 0, 1);
+    nOS_SemCreate(&_go, 0, 1);
+    nOS_SemCreate(&_never, 0, 1);
+    nOS_QueueCreate(&_request, _requestBuffer, sizeof(uint32_t), 1);
+    nOS_QueueCreate(&_answer, _answerBuffer, sizeof(uint32_t), 1);
+    nOS_MutexCreate(&_mutex, NOS_MUTEX_NORMAL, NOS_MUTEX_PRIO_INHERIT);
+    _CreateThread(&_bench, _Bench, _Stack(4), BENCH_PRIO);
+
+    nOS_Start();
+
+    for (;;) {
+#ifdef NOS_SIMULATED_STACK
+        /* Give time to tick thread of simulator */
+ #ifdef _WIN32
+        Sleep(1);
+ #else
+        usleep(1000);
+ #endif
+#endif
+        nOS_Yield();
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
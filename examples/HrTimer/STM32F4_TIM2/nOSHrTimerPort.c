@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2014-2016 Jim Tremblay
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/*
+ * Reference implementation of high resolution timer hooks for MCU ports (NOS_CONFIG_HRTIMER_ENABLE).
+ *
+ * Free running counter and one-shot compare are both taken from the 32 bits general purpose timer TIM2 of STM32F4
+ * (channel 1 in output compare mode, interrupt TIM2_IRQn), counting at NOS_CONFIG_HRTIMER_FREQUENCY. Any MCU timer
+ * with a 32 bits counter and a compare channel can be used the same way, only register addresses change:
+ *   - nOS_HrTimerReadCounter return the counter.
+ *   - nOS_HrTimerSetCompare write the compare register and enable its interrupt, or pend it if count is reached.
+ *   - Compare interrupt disable itself and call nOS_HrTimerIsr, which program the next deadline if any.
+ *
+ * A 16 bits timer can't be used directly, counter must use its full 32 bits range. DWT cycle counter of Cortex-M3/M4/M7
+ * has the range but no compare interrupt, it can't be used alone.
+ *
+ * Application call HrTimerInit before nOS_Start, with TIM2 kernel clock frequency in Hz (APB1 timer clock), and give
+ * to TIM2 interrupt a priority that is allowed to use nOS API (NOS_CONFIG_MAX_UNSAFE_ISR_PRIO).
+ */
+
+#include "nOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if (NOS_CONFIG_HRTIMER_ENABLE > 0)
+#define _RCC_APB1ENR                    (*(volatile uint32_t *)0x40023840UL)
+#define _RCC_APB1ENR_TIM2EN             0x00000001UL
+
+#define _TIM2_CR1                       (*(volatile uint32_t *)0x40000000UL)
+#define _TIM2_DIER                      (*(volatile uint32_t *)0x4000000CUL)
+#define _TIM2_SR                        (*(volatile uint32_t *)0x40000010UL)
+#define _TIM2_EGR                       (*(volatile uint32_t *)0x40000014UL)
+#define _TIM2_CNT                       (*(volatile uint32_t *)0x40000024UL)
+#define _TIM2_PSC                       (*(volatile uint32_t *)0x40000028UL)
+#define _TIM2_ARR                       (*(volatile uint32_t *)0x4000002CUL)
+#define _TIM2_CCR1                      (*(volatile uint32_t *)0x40000034UL)
+#define _TIM_CR1_CEN                    0x00000001UL
+#define _TIM_CC1                        0x00000002UL    /* CC1IE in DIER, CC1IF in SR and CC1G in EGR */
+
+#define _NVIC_ISER0                     (*(volatile uint32_t *)0xE000E100UL)
+#define _TIM2_IRQN                      28
+
+void HrTimerInit (uint32_t clock)
+{
+    _RCC_APB1ENR |= _RCC_APB1ENR_TIM2EN;
+
+    _TIM2_CR1  = 0;
+    _TIM2_DIER = 0;
+    _TIM2_PSC  = (clock / NOS_CONFIG_HRTIMER_FREQUENCY) - 1;
+    _TIM2_ARR  = 0xFFFFFFFFUL;
+    /* Load prescaler now, then clear update flag set by this event */
+    _TIM2_EGR  = 0x00000001UL;
+    _TIM2_SR   = 0;
+    _TIM2_CR1  = _TIM_CR1_CEN;
+
+    _NVIC_ISER0 = (0x00000001UL << _TIM2_IRQN);
+}
+
+uint32_t nOS_HrTimerReadCounter (void)
+{
+    return _TIM2_CNT;
+}
+
+/* Called from critical section */
+void nOS_HrTimerSetCompare (uint32_t count)
+{
+    _TIM2_CCR1 = count;
+    _TIM2_SR   = (uint32_t)~_TIM_CC1;
+    _TIM2_DIER |= _TIM_CC1;
+    if ((int32_t)(count - _TIM2_CNT) <= 0) {
+        /* Deadline is already reached, compare match will not happen before next wrap of counter */
+        _TIM2_EGR = _TIM_CC1;
+    }
+}
+
+NOS_ISR(TIM2_IRQHandler)
+{
+    /* One-shot compare, nOS_HrTimerIsr enable it again for next deadline */
+    _TIM2_DIER &= (uint32_t)~_TIM_CC1;
+    _TIM2_SR    = (uint32_t)~_TIM_CC1;
+
+    nOS_HrTimerIsr();
+}
+#endif  /* NOS_CONFIG_HRTIMER_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
@@ -19,6 +19,17 @@
  **********************************************************************************************************************/
 #define NOS_CONFIG_SAFE                             1
 
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable compact list nodes. Nodes don't store a pointer to the object they are embedded in, it is found  *
+ * back from offset of node in object, which save one pointer per node (up to four per thread and two per timer).     *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Can't be used with message queues, message pointer is stored in node provided by sender.                      *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_COMPACT_NODE_ENABLE              0
+
 /**********************************************************************************************************************
  *                                                                                                                    *
  * Highest priority a thread can have (0 to 255 inclusively). Set to 0 to enable a cooperative scheduling with all    *
@@ -45,6 +56,19 @@
  **********************************************************************************************************************/
 #define NOS_CONFIG_TICK_COUNT_WIDTH                 32
 
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable lock-free read of ticks counter by nOS_GetTickCount.                                             *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Useful when ticks counter is wider than CPU register (e.g. 64 bits on 32-bit CPU), it can't be read at once   *
+ *      and would need a critical section otherwise.                                                                  *
+ *   2. nOS_Tick publish two copies of ticks counter at each tick, reader always take the copy that is not being      *
+ *      written. nOS_GetTickCount can then be called from any ISR, including ISR above NOS_CONFIG_MAX_UNSAFE_ISR_PRIO.*
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_TICK_COUNT_LOCK_FREE_ENABLE      0
+
 /**********************************************************************************************************************
  *                                                                                                                    *
  * Number of ticks per second. nOS_MsToTicks and nOS_SleepMs use this value to convert ms to ticks.                   *
@@ -55,6 +79,81 @@
  **********************************************************************************************************************/
 #define NOS_CONFIG_TICKS_PER_SECOND                 1000
 
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable tickless idle support. When enabled, nOS_GetNextWakeupTicks return the number of ticks until     *
+ * the next thread timeout, timer deadline or alarm, so the port can stop the systick for that interval.              *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. On Cortex-M ports (GCC), nOS_TicklessIdle can be called from main thread (idle) to reprogram SysTick and put  *
+ *      CPU in sleep until next event, then send elapsed ticks to scheduler on wake up.                               *
+ *   2. SysTick must be configured and enabled by the application before calling nOS_TicklessIdle.                    *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_TICKLESS_ENABLE                  0
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable power-aware idle manager. When enabled, nOS_PowerIdle can be called in loop from main thread     *
+ * (idle) to put CPU in the deepest low power mode of the port whose wake up latency fit both the time until next     *
+ * event that need the scheduler (nOS_GetNextWakeupTicks) and latency constraints registered by drivers with          *
+ * nOS_PowerRequestMaxLatency.                                                                                        *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Only available on Cortex-M, MSP430 and AVR platforms with GCC compiler, each port has its own mode table.     *
+ *   2. Need NOS_CONFIG_TICKS_PER_SECOND to be defined. Without NOS_CONFIG_TICKLESS_ENABLE, next event is always      *
+ *      considered to be on next tick and only modes that keep tick running are used.                                 *
+ *   3. Modes that stop tick source are used only when nothing is waiting on ticks, tick counter doesn't advance      *
+ *      while sleeping in them. Application is responsible to configure interrupts that will wake up the CPU.         *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_POWER_ENABLE                     0
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Deepest low power mode that nOS_PowerIdle can use, from 0 (lightest mode of the port) to 255 (no limit). Can be    *
+ * used when tick source of the application doesn't run in some modes of the port table.                              *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_POWER_DEEPEST_MODE               255
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Wake up latency in microseconds of low power modes that stop main oscillator (Cortex-M deep sleep, AVR power down  *
+ * and MSP430 LPM4). Depend on device and clock configuration (oscillator and PLL start up time).                     *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_POWER_DEEP_LATENCY               1000
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Maximum number of ticks processed by nOS_Tick in a single critical section. Set to 0 to process all ticks at once. *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. When nOS_Tick is called with a large number of ticks (like when recovering from MCU sleep), ticks are         *
+ *      processed by batch of this size and interrupts are allowed between each batch to bound interrupt latency.     *
+ *   2. Threads, timers, time and alarms are all updated in the same critical section for each batch.                 *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_TICK_BATCH_SIZE                  0
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Maximum number of nodes visited in a single critical section by long list walks (suspend/resume all threads,       *
+ * flag send, timer and alarm ticks). Set to 0 to walk all nodes at once.                                             *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Walks leave critical section for a moment after each batch of nodes to bound interrupt latency,               *
+ *      independently of number of threads, timers and alarms.                                                        *
+ *   2. Scheduler is locked during the whole walk: only interrupts can run in between and threads made ready by them  *
+ *      run when walk is completed.                                                                                   *
+ *   3. Can't be used when NOS_CONFIG_SCHED_LOCK_ENABLE == 0.                                                         *
+ *   4. Timer and alarm ticks are bounded only when called by application (NOS_CONFIG_TIMER_TICK_ENABLE == 0 or       *
+ *      NOS_CONFIG_ALARM_TICK_ENABLE == 0), when called from nOS_Tick they stay in critical section of tick.          *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_CRITICAL_WALK_LIMIT              0
+
 /**********************************************************************************************************************
  *                                                                                                                    *
  * Enable or disable preemptive scheduler. When enabled, the scheduler will ensure it's always the highest priority   *
@@ -77,6 +176,19 @@
  **********************************************************************************************************************/
 #define NOS_CONFIG_SCHED_ROUND_ROBIN_ENABLE         1
 
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Default time slice of threads in number of ticks for round-robin scheduler. Running thread give its place to the   *
+ * next ready thread of the same priority only when its time slice has expired or when it yield. Time slice can be    *
+ * changed per thread at run-time with nOS_ThreadSetQuantum.                                                          *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Must be set between 1 and 65535 inclusively.                                                                  *
+ *   2. Not used if round-robin scheduler is disabled.                                                                *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_SCHED_ROUND_ROBIN_QUANTUM        1
+
 /**********************************************************************************************************************
  *                                                                                                                    *
  * Enable or disable lock/unlock scheduler.                                                                           *
@@ -87,6 +199,72 @@
  **********************************************************************************************************************/
 #define NOS_CONFIG_SCHED_LOCK_ENABLE                1
 
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable deferred scheduling. When enabled, services that make a thread ready only mark that a            *
+ * scheduling decision is needed and the decision is taken only once when leaving outermost critical section or       *
+ * interrupt. A burst of semaphore gives or queue writes from the same critical section or interrupt will then cost   *
+ * only one decision and one context switch request.                                                                  *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Can't be used with cooperative scheduling.                                                                    *
+ *   2. Only available on ports that support it (ARM Cortex-M and POSIX).                                             *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_SCHED_DEFERRED_ENABLE            0
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable earliest deadline first scheduling inside one reserved level of priority. Threads of this level  *
+ * are kept ordered by absolute deadline in their ready list, so the most urgent one run first. The other levels are  *
+ * not affected and stay scheduled by fixed priority.                                                                 *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Can't be used with cooperative scheduling or with more than one core.                                         *
+ *   2. Threads without deadline run after threads with a deadline in the reserved level.                             *
+ *   3. Round-robin doesn't apply to the reserved level.                                                              *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_SCHED_EDF_ENABLE                 0
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Level of priority reserved for earliest deadline first scheduling.                                                 *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Must be set between 1 and NOS_CONFIG_HIGHEST_THREAD_PRIO inclusively.                                         *
+ *   2. Not used if earliest deadline first scheduling is disabled.                                                   *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_SCHED_EDF_PRIO                   16
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Number of cores managed by the scheduler (symmetric multiprocessing). 1 is a single core build. When higher than 1,*
+ * each core has its own ready to run lists, running thread and idle thread, and each thread is pinned to the core    *
+ * given to nOS_ThreadCreate. Kernel data is protected by a lock shared by all cores and a core that make ready a     *
+ * thread of another core send it a request to reschedule.                                                            *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Only available on ports that support it (POSIX, cores are simulated by host threads).                         *
+ *   2. Can't be used with cooperative scheduling (NOS_CONFIG_HIGHEST_THREAD_PRIO == 0) or deferred scheduling.       *
+ *   3. Tick is received by core 0, round robin is done on all cores.                                                 *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_SMP_CORE_COUNT                   1
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable work stealing between cores (SMP load balancing). When a core has no other thread than its idle  *
+ * thread ready to run, it takes the highest prio migratable thread waiting to run on another core. Threads created   *
+ * with core NOS_THREAD_CORE_ANY are migratable, threads created with a core number keep strict affinity to it.       *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Only used when NOS_CONFIG_SMP_CORE_COUNT is higher than 1.                                                    *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_SMP_WORK_STEALING_ENABLE         0
+
 /**********************************************************************************************************************
  *                                                                                                                    *
  * Enable or disable sleeping from running thread.                                                                    *
@@ -168,477 +346,1144 @@
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Enable or disable variable timeout when thread trying to take sem, lock mutex, wait on flags, ...                  *
+ * Enable or disable spawning threads from a pool of thread objects and stacks (nOS_ThreadSpawn). Pooled thread       *
+ * objects are given back to pool when their entry returns.                                                           *
  *                                                                                                                    *
  * Notes                                                                                                              *
- *   1. If disabled, everything other than NOS_NO_WAIT for timeout is equivalent to NOS_WAIT_INFINITE.                *
+ *   1. Need NOS_CONFIG_THREAD_JOIN_ENABLE to know when entry of a spawned thread returns.                            *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_WAITING_TIMEOUT_ENABLE           1
+#define NOS_CONFIG_THREAD_SPAWN_ENABLE              0
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Enable or disable semaphore.                                                                                       *
+ * Number of thread objects in spawn pool (maximum number of spawned threads running at the same time).               *
  *                                                                                                                    *
  * Notes                                                                                                              *
- *   1. Can be disabled if not needed by the application to decrease flash space used.                                *
+ *   1. Not used if thread spawn is disabled.                                                                         *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_SEM_ENABLE                       1
+#define NOS_CONFIG_THREAD_SPAWN_COUNT               4
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Enable or disable deleting semaphore at run-time.                                                                  *
+ * Stack size of each spawned thread.                                                                                 *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Not used if thread spawn is disabled.                                                                         *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_SEM_DELETE_ENABLE                1
+#define NOS_CONFIG_THREAD_SPAWN_STACK_SIZE          128
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Semaphore count width in bits (can be 8, 16, 32 or 64).                                                            *
+ * Call stack size of each spawned thread.                                                                            *
  *                                                                                                                    *
  * Notes                                                                                                              *
- *   1. Bits width directly affects the maximum number of times that a semaphore can be took.                         *
- *   2. For maximum performance, it is recommenced to set width of a CPU register.                                    *
+ *   1. Only available on AVR platform with IAR compiler.                                                             *
+ *   2. Not used if thread spawn is disabled.                                                                         *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_SEM_COUNT_WIDTH                  32
+#define NOS_CONFIG_THREAD_SPAWN_CALL_STACK_SIZE     16
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Enable or disable mutex.                                                                                           *
+ * Enable or disable thread notifications (notification value stored in each thread, set from other threads or ISR).  *
  *                                                                                                                    *
  * Notes                                                                                                              *
- *   1. Can be disabled if not needed by the application to decrease flash space used.                                *
+ *   1. Lighter than a semaphore or a flag object to wake up a known thread, no object and no waiting list needed.    *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_MUTEX_ENABLE                     1
+#define NOS_CONFIG_THREAD_NOTIFY_ENABLE             0
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Enable or disable deleting mutex at run-time.                                                                      *
+ * Enable or disable execution budget of threads. A thread with a budget can run for a number of ticks in each period;*
+ * when its budget is exhausted, it is demoted to a lower priority until its budget is replenished at next period.    *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Budget is charged in nOS_Tick to the thread that was running, with a resolution of one tick.                  *
+ *   2. Not available if NOS_CONFIG_HIGHEST_THREAD_PRIO is defined to 0.                                              *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_MUTEX_DELETE_ENABLE              1
+#define NOS_CONFIG_THREAD_BUDGET_ENABLE             0
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Mutex count width in bits (can be 8, 16, 32 or 64).                                                                *
+ * Enable or disable periodic threads (nOS_ThreadSetPeriodic and nOS_WaitNextPeriod) with release jitter, response    *
+ * time and deadline miss statistics.                                                                                 *
  *                                                                                                                    *
  * Notes                                                                                                              *
- *   1. Bits width directly affects the maximum number of times that a mutex can be locked.                           *
- *   2. For maximum performance, it is recommenced to set width of a CPU register.                                    *
+ *   1. Statistics are measured with a resolution of one tick.                                                        *
+ *   2. Not available if NOS_CONFIG_SLEEP_UNTIL_ENABLE is defined to 0.                                               *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_MUTEX_COUNT_WIDTH                32
+#define NOS_CONFIG_THREAD_PERIODIC_ENABLE           0
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Enable or disable flag.                                                                                            *
+ * Enable or disable variable timeout when thread trying to take sem, lock mutex, wait on flags, ...                  *
  *                                                                                                                    *
  * Notes                                                                                                              *
- *   1. Can be disabled if not needed by the application to decrease flash space used.                                *
+ *   1. If disabled, everything other than NOS_NO_WAIT for timeout is equivalent to NOS_WAIT_INFINITE.                *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_FLAG_ENABLE                      1
+#define NOS_CONFIG_WAITING_TIMEOUT_ENABLE           1
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Enable or disable deleting flag at run-time.                                                                       *
+ * Enable or disable sorting of threads waiting with a timeout by their deadline.                                     *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. If enabled, nOS_Tick only look at threads that have reached their deadline instead of walking through all     *
+ *      threads waiting with a timeout. Cost is moved to the insertion, which walk the list to find the position of   *
+ *      the new deadline.                                                                                             *
+ *   2. Not used if NOS_CONFIG_WAITING_TIMEOUT_ENABLE, NOS_CONFIG_SLEEP_ENABLE and NOS_CONFIG_SLEEP_UNTIL_ENABLE are  *
+ *      all disabled.                                                                                                 *
+ *   3. Disabled by default, set to 1 to opt-in.                                                                      *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_FLAG_DELETE_ENABLE               1
+#define NOS_CONFIG_SORTED_TIMEOUT_LIST_ENABLE       0
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Size of flag in number of bits (can be 8, 16, 32 or 64).                                                           *
+ * Enable or disable priority ordered waiting list of semaphore, mutex, flag, queue, mem and barrier. When enabled,   *
+ * the highest priority thread waiting on an object is always the first to be waked up.                               *
  *                                                                                                                    *
  * Notes                                                                                                              *
- *   1. Bits width directly affects the number of different bits that can be held by flag.                            *
- *   2. For maximum performance, it is recommenced to set width of a CPU register.                                    *
+ *   1. Disabled by default: threads are waked up in the same order they started to wait on the object (FIFO). Set    *
+ *      to 1 to opt-in to priority order.                                                                             *
+ *   2. Threads with the same priority stay in FIFO order.                                                            *
+ *   3. Mutex with priority inheritance find the highest priority waiting thread in constant time.                    *
+ *   4. Not used if NOS_CONFIG_HIGHEST_THREAD_PRIO is set to 0.                                                       *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_FLAG_NB_BITS                     32
+#define NOS_CONFIG_WAITING_PRIO_ORDER_ENABLE        0
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Enable or disable queue.                                                                                           *
+ * Enable or disable per object waiting policy. When enabled, nOS_SetWaitingPolicy can be used to select if threads   *
+ * waiting on a given object are waked up in priority order or in FIFO order.                                         *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Each event object (semaphore, mutex, flag, queue, mem and barrier) is one byte larger (or more with padding). *
+ *   2. Objects are created with priority ordered waiting policy.                                                     *
+ *   3. Not used if NOS_CONFIG_WAITING_PRIO_ORDER_ENABLE is set to 0.                                                 *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_WAITING_POLICY_ENABLE            0
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable semaphore.                                                                                       *
  *                                                                                                                    *
  * Notes                                                                                                              *
  *   1. Can be disabled if not needed by the application to decrease flash space used.                                *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_QUEUE_ENABLE                     1
+#define NOS_CONFIG_SEM_ENABLE                       1
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Enable or disable deleting queue at run-time.                                                                      *
+ * Enable or disable deleting semaphore at run-time.                                                                  *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_QUEUE_DELETE_ENABLE              1
+#define NOS_CONFIG_SEM_DELETE_ENABLE                1
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Queue block count width in bits (can be 8, 16, 32 or 64).                                                          *
+ * Semaphore count width in bits (can be 8, 16, 32 or 64).                                                            *
  *                                                                                                                    *
  * Notes                                                                                                              *
- *   1. Bits width directly affects the maximum count of block that can be stored in queue.                           *
+ *   1. Bits width directly affects the maximum number of times that a semaphore can be took.                         *
  *   2. For maximum performance, it is recommenced to set width of a CPU register.                                    *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_QUEUE_BLOCK_COUNT_WIDTH          32
+#define NOS_CONFIG_SEM_COUNT_WIDTH                  32
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Enable or disable fixed-sized array of memory block.                                                               *
+ * Enable or disable multiple count semaphore API (nOS_SemGiveN and nOS_SemTakeN).                                    *
  *                                                                                                                    *
  * Notes                                                                                                              *
- *   1. Can be disabled if not needed by the application to decrease flash space used.                                *
+ *   1. Accounting and wake up of all waiting threads that can be satisfied are done in the same critical section with*
+ *      only one scheduling decision.                                                                                 *
+ *   2. Waiting threads are served in waiting order, a thread that need more than what is available block the ones    *
+ *      waiting behind it.                                                                                            *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_MEM_ENABLE                       1
+#define NOS_CONFIG_SEM_MULTI_ENABLE                 0
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Enable or disable deleting of memory array at run-time.                                                            *
+ * Enable or disable mutex.                                                                                           *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Can be disabled if not needed by the application to decrease flash space used.                                *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_MEM_DELETE_ENABLE                1
+#define NOS_CONFIG_MUTEX_ENABLE                     1
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Memory block size width in bits (can be 8, 16, 32 or 64).                                                          *
- *                                                                                                                    *
- * Notes                                                                                                              *
- *   1. Bits width directly affects the maximum size of block that can be allocated from memory.                      *
- *   2. For maximum performance, it is recommenced to set width of a CPU register.                                    *
+ * Enable or disable deleting mutex at run-time.                                                                      *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_MEM_BLOCK_SIZE_WIDTH             32
+#define NOS_CONFIG_MUTEX_DELETE_ENABLE              1
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Memory block count width in bits (can be 8, 16, 32 or 64).                                                         *
+ * Mutex count width in bits (can be 8, 16, 32 or 64).                                                                *
  *                                                                                                                    *
  * Notes                                                                                                              *
- *   1. Bits width directly affects the maximum count of block that can be allocated from memory.                     *
+ *   1. Bits width directly affects the maximum number of times that a mutex can be locked.                           *
  *   2. For maximum performance, it is recommenced to set width of a CPU register.                                    *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_MEM_BLOCK_COUNT_WIDTH            32
+#define NOS_CONFIG_MUTEX_COUNT_WIDTH                32
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Enable or disable sanity check of pointer when they are freed (useful for debugging).                              *
+ * Maximum number of times nOS_MutexLock check again a mutex owned by a thread running on another core before blocking*
+ * the calling thread. Set to 0 to block immediately.                                                                 *
  *                                                                                                                    *
  * Notes                                                                                                              *
- *   1. If enabled, freeing memory block can return error if pointer has been corrupted.                              *
+ *   1. Only used when NOS_CONFIG_SMP_CORE_COUNT is higher than 1, single core always block immediately because owner *
+ *      can't run while calling thread is running.                                                                    *
+ *   2. Critical section is released between each check to let owner unlock the mutex, avoiding two context switches  *
+ *      for short locked sections.                                                                                    *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_MEM_SANITY_CHECK_ENABLE          1
+#define NOS_CONFIG_MUTEX_SPIN_COUNT                 0
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Enable or disable timer with callback.                                                                             *
+ * Enable or disable reader-writer lock.                                                                              *
  *                                                                                                                    *
  * Notes                                                                                                              *
  *   1. Can be disabled if not needed by the application to decrease flash space used.                                *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_TIMER_ENABLE                     1
+#define NOS_CONFIG_RWLOCK_ENABLE                    0
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Enable or disable deleting timer at run-time.                                                                      *
+ * Enable or disable deleting reader-writer lock at run-time.                                                         *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_TIMER_DELETE_ENABLE              1
+#define NOS_CONFIG_RWLOCK_DELETE_ENABLE             1
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Highest priority a timer can take (0 to 7 inclusively). Set to 0 to disable timer priority with all timers at      *
- * the same priority.                                                                                                 *
- *                                                                                                                    *
- * 0 = Lowest priority                                                                                                *
- * 7 = Highest priority                                                                                               *
+ * Reader-writer lock readers count width in bits (can be 8, 16 or 32).                                               *
  *                                                                                                                    *
  * Notes                                                                                                              *
- *   1. It is recommenced to set the timer highest priority adjusted to the minimum required by the application to    *
- *      minimize memory consumed.                                                                                     *
+ *   1. Bits width directly affects the maximum number of readers that can own a reader-writer lock at the same time. *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_TIMER_HIGHEST_PRIO               0
+#define NOS_CONFIG_RWLOCK_COUNT_WIDTH               16
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Enable or disable timer tick from nOS_Tick.                                                                        *
+ * Enable or disable flag.                                                                                            *
  *                                                                                                                    *
  * Notes                                                                                                              *
- *   1. If disabled, application is responsible to call nOS_TimerTick.                                                *
+ *   1. Can be disabled if not needed by the application to decrease flash space used.                                *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_TIMER_TICK_ENABLE                1
+#define NOS_CONFIG_FLAG_ENABLE                      1
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Enable or disable timer thread that will take care of callback.                                                    *
- *                                                                                                                    *
- * Notes                                                                                                              *
- *   1. If disabled, application is responsible to call nOS_TimerProcess.                                             *
+ * Enable or disable deleting flag at run-time.                                                                       *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_TIMER_THREAD_ENABLE              1
+#define NOS_CONFIG_FLAG_DELETE_ENABLE               1
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Priority of timer thread.                                                                                          *
+ * Size of flag in number of bits (can be 8, 16, 32 or 64).                                                           *
  *                                                                                                                    *
  * Notes                                                                                                              *
- *   1. Not used if timer thread is disabled.                                                                         *
+ *   1. Bits width directly affects the number of different bits that can be held by flag.                            *
+ *   2. For maximum performance, it is recommenced to set width of a CPU register.                                    *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_TIMER_THREAD_PRIO                1
+#define NOS_CONFIG_FLAG_NB_BITS                     32
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Stack size of timer thread.                                                                                        *
+ * Enable or disable queue.                                                                                           *
  *                                                                                                                    *
  * Notes                                                                                                              *
- *   1. Not used if timer thread is disabled.                                                                         *
+ *   1. Can be disabled if not needed by the application to decrease flash space used.                                *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_TIMER_THREAD_STACK_SIZE          128
+#define NOS_CONFIG_QUEUE_ENABLE                     1
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Call stack size of timer thread.                                                                                   *
- *                                                                                                                    *
- * Notes                                                                                                              *
- *   1. Only available on AVR platform with IAR compiler.                                                             *
- *   2. Not used if timer thread is disabled.                                                                         *
+ * Enable or disable deleting queue at run-time.                                                                      *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_TIMER_THREAD_CALL_STACK_SIZE     16
+#define NOS_CONFIG_QUEUE_DELETE_ENABLE              1
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Timer counter width in bits (can be 8, 16, 32 or 64).                                                              *
+ * Enable or disable zero-copy queue API (nOS_QueueWriteReserve/Commit and nOS_QueueReadAcquire/Release).             *
  *                                                                                                                    *
  * Notes                                                                                                              *
- *   1. Bits width directly affects the maximum number of ticks that a timer can count.                               *
- *   2. For maximum performance, it is recommenced to set width of a CPU register.                                    *
+ *   1. Threads can build blocks in place and read them directly from queue buffer without copying them.              *
+ *   2. Can't be used with queue created with block count at 0 (pipe).                                                *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_TIMER_COUNT_WIDTH                32
+#define NOS_CONFIG_QUEUE_ZERO_COPY_ENABLE           0
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Enable or disable signal callback (can be used like software IRQ or any asynchronous event).                       *
+ * Queue block count width in bits (can be 8, 16, 32 or 64).                                                          *
  *                                                                                                                    *
  * Notes                                                                                                              *
- *   1. Can be disabled if not needed by the application to decrease flash space used.                                *
+ *   1. Bits width directly affects the maximum count of block that can be stored in queue.                           *
+ *   2. For maximum performance, it is recommenced to set width of a CPU register.                                    *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_SIGNAL_ENABLE                    1
+#define NOS_CONFIG_QUEUE_BLOCK_COUNT_WIDTH          32
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Enable or disable deleting signal at run-time.                                                                     *
+ * Queue block size width in bits (can be 8, 16, 32 or 64).                                                           *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Bits width directly affects the maximum size of block that can be stored in queue.                            *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_SIGNAL_DELETE_ENABLE             1
+#define NOS_CONFIG_QUEUE_BLOCK_SIZE_WIDTH           8
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Highest priority a signal can take (0 to 7 inclusively). Set to 0 to disable signal priority with all signals at   *
- * the same priority.                                                                                                 *
- *                                                                                                                    *
- * 0 = Lowest priority                                                                                                *
- * 7 = Highest priority                                                                                               *
+ * Enable or disable power of 2 queue block count.                                                                    *
  *                                                                                                                    *
  * Notes                                                                                                              *
- *   1. It is recommenced to set the signal highest priority adjusted to the minimum required by the application to   *
- *      minimize memory consumed.                                                                                     *
+ *   1. Queue block count (bmax) must be a power of 2 when enabled, except for pipe.                                  *
+ *   2. Read and write indexes are wrapped with a mask instead of a modulo (no division on each block).               *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_SIGNAL_HIGHEST_PRIO              0
+#define NOS_CONFIG_QUEUE_POW2_ENABLE                0
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Enable or disable signal thread that will take care of callback.                                                   *
+ * Enable or disable multiple blocks queue API (nOS_QueueWriteN and nOS_QueueReadN).                                  *
  *                                                                                                                    *
  * Notes                                                                                                              *
- *   1. If disabled, application is responsible to call nOS_SignalProcess.                                            *
+ *   1. A contiguous run of blocks is moved with at most two memcpy and waiting threads are waked up at once.         *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_SIGNAL_THREAD_ENABLE             1
+#define NOS_CONFIG_QUEUE_MULTI_ENABLE               0
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Priority of signal thread.                                                                                         *
+ * Enable or disable overwrite mode of queue (nOS_QueueSetOverwrite).                                                 *
  *                                                                                                                    *
  * Notes                                                                                                              *
- *   1. Not used if signal thread is disabled.                                                                        *
+ *   1. Writing in a full queue in overwrite mode drop its oldest block instead of returning NOS_E_FULL or waiting.   *
+ *   2. NOS_QUEUE_LATEST_DEFINE give a single block queue always holding last written value.                          *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_SIGNAL_THREAD_PRIO               1
+#define NOS_CONFIG_QUEUE_OVERWRITE_ENABLE           0
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Stack size of signal thread.                                                                                       *
+ * Enable or disable stream (lock-free single producer/single consumer ring buffer).                                  *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Can be disabled if not needed by the application to decrease flash space used.                                *
+ *   2. Only one producer (thread or ISR) and one consumer thread can use a stream.                                   *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_STREAM_ENABLE                    0
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable deleting stream at run-time.                                                                     *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_STREAM_DELETE_ENABLE             1
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Stream block count and block size width in bits (can be 8, 16 or 32).                                              *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Read and write indexes are updated without critical section, width can't be higher than CPU register width.   *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_STREAM_COUNT_WIDTH               32
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable mailbox (queue of message pointers).                                                             *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Can be disabled if not needed by the application to decrease flash space used.                                *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_MBOX_ENABLE                      0
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable deleting mailbox at run-time.                                                                    *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_MBOX_DELETE_ENABLE               1
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Mailbox count width in bits (can be 8, 16 or 32).                                                                  *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Bits width directly affects the maximum number of messages that can be stored in a mailbox.                   *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_MBOX_COUNT_WIDTH                 16
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable message queue (unbounded queue of messages linked with nodes provided by sender).                *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Can be disabled if not needed by the application to decrease flash space used.                                *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_MSGQUEUE_ENABLE                  0
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable deleting message queue at run-time.                                                              *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_MSGQUEUE_DELETE_ENABLE           1
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable fixed-sized array of memory block.                                                               *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Can be disabled if not needed by the application to decrease flash space used.                                *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_MEM_ENABLE                       1
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable deleting of memory array at run-time.                                                            *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_MEM_DELETE_ENABLE                1
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Memory block size width in bits (can be 8, 16, 32 or 64).                                                          *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Bits width directly affects the maximum size of block that can be allocated from memory.                      *
+ *   2. For maximum performance, it is recommenced to set width of a CPU register.                                    *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_MEM_BLOCK_SIZE_WIDTH             32
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Memory block count width in bits (can be 8, 16, 32 or 64).                                                         *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Bits width directly affects the maximum count of block that can be allocated from memory.                     *
+ *   2. For maximum performance, it is recommenced to set width of a CPU register.                                    *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_MEM_BLOCK_COUNT_WIDTH            32
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable sanity check of pointer when they are freed (useful for debugging).                              *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. If enabled, freeing memory block can return error if pointer has been corrupted.                              *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_MEM_SANITY_CHECK_ENABLE          1
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable bitmap of allocated blocks used by sanity check.                                                 *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Only used if NOS_CONFIG_MEM_SANITY_CHECK_ENABLE is enabled.                                                   *
+ *   2. If enabled, detection of a block freed twice is done in constant time, but application shall give to          *
+ *      nOS_MemCreate an array of NOS_MEM_BITMAP_SIZE(bmax) bytes.                                                    *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_MEM_BITMAP_ENABLE                0
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable usage statistics of mem objects (high-water mark and failures count).                            *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_MEM_STATS_ENABLE                 0
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable per-thread cache of blocks in front of mem objects.                                              *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Allocating and freeing from cache don't enter critical section, blocks are moved from/to mem object in batch. *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_MEM_CACHE_ENABLE                 0
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable variable-sized allocator built on top of mem objects (heap with size classes).                   *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Only available if NOS_CONFIG_MEM_ENABLE is enabled.                                                           *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_HEAP_ENABLE                      0
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable allocation from larger size classes when smallest fitting size class has no block available.     *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. If disabled, nOS_HeapAlloc only try to allocate from smallest fitting size class.                             *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_HEAP_FALLBACK_ENABLE             1
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Maximum number of callbacks (1 to 32 inclusively) taken in the same critical section by timer, signal and alarm    *
+ * threads, or by nOS_TimerProcessBatch, nOS_SignalProcessBatch and nOS_AlarmProcessBatch. Callbacks are then called  *
+ * one after the other outside of critical section.                                                                   *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Taking a callback is O(1), masked time only grow by this short step for each item of a batch.                 *
+ *   2. Each item of a batch use 3 pointers on stack of caller.                                                       *
+ *   3. A timer, signal or alarm deleted by a callback can still have its callback called in the same batch.          *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_PROCESS_BATCH_SIZE               1
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable timer with callback.                                                                             *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Can be disabled if not needed by the application to decrease flash space used.                                *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_TIMER_ENABLE                     1
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable deleting timer at run-time.                                                                      *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_TIMER_DELETE_ENABLE              1
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Highest priority a timer can take (0 to 255 inclusively). Set to 0 to disable timer priority with all timers at    *
+ * the same priority.                                                                                                 *
+ *                                                                                                                    *
+ * 0   = Lowest priority                                                                                              *
+ * 255 = Highest priority                                                                                             *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. It is recommenced to set the timer highest priority adjusted to the minimum required by the application to    *
+ *      minimize memory consumed.                                                                                     *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_TIMER_HIGHEST_PRIO               0
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable timer tick from nOS_Tick.                                                                        *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. If disabled, application is responsible to call nOS_TimerTick.                                                *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_TIMER_TICK_ENABLE                1
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable timer thread that will take care of callback.                                                    *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. If disabled, application is responsible to call nOS_TimerProcess.                                             *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_TIMER_THREAD_ENABLE              1
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Priority of timer thread.                                                                                          *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Not used if timer thread is disabled.                                                                         *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_TIMER_THREAD_PRIO                1
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Number of timer threads (1 to 8 inclusively). Timer priorities are split in bands of about the same size, one by   *
+ * timer thread, so a slow callback of a low prio timer can't delay callbacks of a timer in a higher band. Thread of  *
+ * band n run at priority NOS_CONFIG_TIMER_THREAD_PRIO + n, highest band in highest prio thread.                      *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Not used if timer thread is disabled.                                                                         *
+ *   2. Can't be higher than NOS_CONFIG_TIMER_HIGHEST_PRIO + 1.                                                       *
+ *   3. Each timer thread use its own stack of NOS_CONFIG_TIMER_THREAD_STACK_SIZE.                                    *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_TIMER_THREAD_COUNT               1
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Stack size of timer thread.                                                                                        *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Not used if timer thread is disabled.                                                                         *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_TIMER_THREAD_STACK_SIZE          128
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Call stack size of timer thread.                                                                                   *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Only available on AVR platform with IAR compiler.                                                             *
+ *   2. Not used if timer thread is disabled.                                                                         *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_TIMER_THREAD_CALL_STACK_SIZE     16
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Timer counter width in bits (can be 8, 16, 32 or 64).                                                              *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Bits width directly affects the maximum number of ticks that a timer can count.                               *
+ *   2. For maximum performance, it is recommenced to set width of a CPU register.                                    *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_TIMER_COUNT_WIDTH                32
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable timing wheel to store running timers.                                                            *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. If disabled, all running timers are stored in the same list and nOS_TimerTick walk through all of them at     *
+ *      each tick.                                                                                                    *
+ *   2. If enabled, running timers are hashed by their deadline in NOS_CONFIG_TIMER_WHEEL_SIZE slots and              *
+ *      nOS_TimerTick only walk through the slot of the current tick.                                                 *
+ *   3. If enabled with NOS_CONFIG_TICKLESS_ENABLE, earliest deadline of each slot is kept up to date so              *
+ *      nOS_GetNextWakeupTicks only look at each slot instead of walking through all running timers.                  *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_TIMER_WHEEL_ENABLE               0
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Number of slots in timer wheel (power of 2 between 2 and 1024 inclusively).                                        *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Each slot use the size of a list in RAM.                                                                      *
+ *   2. For best performance, set it higher than the number of running timers.                                        *
+ *   3. Not used if timer wheel is disabled.                                                                          *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_TIMER_WHEEL_SIZE                 32
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable timer slack (coalesced timers). Each timer is given a slack in ticks at creation: its callback   *
+ * can be delayed up to this number of ticks after its deadline to be triggered on the same tick as other timers.     *
+ * Timers are triggered only when one of them reach the end of its slack window, together with all timers that        *
+ * already reached their deadline.                                                                                    *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Can't be used with timer wheel.                                                                               *
+ *   2. Free running timers keep their period, only the callback is delayed.                                          *
+ *   3. With tickless mode, nOS_TimerGetNextWakeup return end of slack window, scattered deadlines are grouped in     *
+ *      fewer wakeups.                                                                                                *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_TIMER_SLACK_ENABLE               0
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable high resolution timers and nOS_HrSleep, with sub-tick deadlines counted on a free running        *
+ * hardware counter and its compare interrupt.                                                                        *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Port or application must implement nOS_HrTimerReadCounter and nOS_HrTimerSetCompare, and call nOS_HrTimerIsr  *
+ *      from compare interrupt (see examples/HrTimer for a reference on MCU).                                         *
+ *   2. Only nOS_HrTimer objects and nOS_HrSleep have sub-tick resolution. nOS_Timer, nOS_Sleep and timeouts of all   *
+ *      waiting functions stay counted in ticks.                                                                      *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_HRTIMER_ENABLE                   0
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Frequency in Hz of high resolution timer counter.                                                                  *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_HRTIMER_FREQUENCY                1000000UL
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable signal callback (can be used like software IRQ or any asynchronous event).                       *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Can be disabled if not needed by the application to decrease flash space used.                                *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_SIGNAL_ENABLE                    1
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable deleting signal at run-time.                                                                     *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_SIGNAL_DELETE_ENABLE             1
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Highest priority a signal can take (0 to 255 inclusively). Set to 0 to disable signal priority with all signals at *
+ * the same priority.                                                                                                 *
+ *                                                                                                                    *
+ * 0   = Lowest priority                                                                                              *
+ * 255 = Highest priority                                                                                             *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. It is recommenced to set the signal highest priority adjusted to the minimum required by the application to   *
+ *      minimize memory consumed.                                                                                     *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_SIGNAL_HIGHEST_PRIO              0
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable queue of arguments per signal (see nOS_SignalSetQueue), so each raise is dispatched even if      *
+ * signal is raised again before it is processed.                                                                     *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. If disabled, a signal can only be raised once between two dispatches, with a single argument.                 *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_SIGNAL_QUEUE_ENABLE              0
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable signal thread that will take care of callback.                                                   *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. If disabled, application is responsible to call nOS_SignalProcess.                                            *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_SIGNAL_THREAD_ENABLE             1
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Priority of signal thread.                                                                                         *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Not used if signal thread is disabled.                                                                        *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_SIGNAL_THREAD_PRIO               1
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Stack size of signal thread.                                                                                       *
  *                                                                                                                    *
  * Notes                                                                                                              *
  *   1. Not used if signal thread is disabled.                                                                        *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_SIGNAL_THREAD_STACK_SIZE         128
+#define NOS_CONFIG_SIGNAL_THREAD_STACK_SIZE         128
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Call stack size of signal thread.                                                                                  *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Only available on AVR platform with IAR compiler.                                                             *
+ *   2. Not used if signal thread is disabled.                                                                        *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_SIGNAL_THREAD_CALL_STACK_SIZE    16
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable time management.                                                                                 *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Can be disabled if not needed by the application to decrease flash space used.                                *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_TIME_ENABLE                      1
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable time tick from nOS_Tick.                                                                         *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. If disabled, application is responsible to call nOS_TimeTick.                                                 *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_TIME_TICK_ENABLE                 1
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable waiting for specific time and date from running thread.                                          *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Can't sleep from main thread (idle).                                                                          *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_TIME_WAIT_ENABLE                 1
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Number of time ticks per second. Time need this value to know how much ticks equal to 1 second.                    *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. It is recommended to don't go higher than 1000 ticks per second.                                              *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_TIME_TICKS_PER_SECOND            NOS_CONFIG_TICKS_PER_SECOND
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Time ticks counter width in bits (can be 32 or 64).                                                                *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Bits width directly affects the highest time/date that can be represented.                                    *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_TIME_COUNT_WIDTH                 32
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable cached current date. nOS_TimeDateGet return a copy of the cached date instead of converting      *
+ * time at each call.                                                                                                 *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Cached date is advanced incrementally by nOS_TimeTick at each elapsed second, it is fully converted again     *
+ *      only when more than one second elapse at once or when time is set.                                            *
+ *   2. Useful when date is read often (e.g. timestamp of each log record).                                           *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_TIME_DATE_CACHE_ENABLE           0
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable precise time. nOS_TimeGetPrecise return seconds with ticks elapsed in current second, and        *
+ * cycle counter sampled at last time tick when NOS_CONFIG_CYCLE_COUNTER_ENABLE is enabled.                           *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. nOS_TimeGetPrecise never enter critical section and can be called from any ISR, including ISR above           *
+ *      NOS_CONFIG_MAX_UNSAFE_ISR_PRIO.                                                                               *
+ *   2. nOS_TimeTick publish two copies of time at each tick, reader always take the copy that is not being written.  *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_TIME_PRECISE_ENABLE              0
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable alarm management.                                                                                *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Can be disabled if not needed by the application to decrease flash space used.                                *
+ *   2. Alarm management is dependant from Time module.                                                               *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_ALARM_ENABLE                     1
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable deleting alarm at run-time.                                                                      *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_ALARM_DELETE_ENABLE              1
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable alarm tick from nOS_Tick.                                                                        *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. If disabled, application is responsible to call nOS_AlarmTick.                                                *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_ALARM_TICK_ENABLE                1
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable alarm thread that will take care of callback.                                                    *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. If disabled, application is responsible to call nOS_AlarmProcess.                                             *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_ALARM_THREAD_ENABLE              1
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Call stack size of signal thread.                                                                                  *
+ * Priority of alarm thread.                                                                                          *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Not used if alarm thread is disabled.                                                                         *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_ALARM_THREAD_PRIO                1
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Stack size of alarm thread.                                                                                        *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Not used if alarm thread is disabled.                                                                         *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_ALARM_THREAD_STACK_SIZE          128
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Call stack size of alarm thread.                                                                                   *
  *                                                                                                                    *
  * Notes                                                                                                              *
  *   1. Only available on AVR platform with IAR compiler.                                                             *
- *   2. Not used if signal thread is disabled.                                                                        *
+ *   2. Not used if alarm thread is disabled.                                                                         *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_SIGNAL_THREAD_CALL_STACK_SIZE    16
+#define NOS_CONFIG_ALARM_THREAD_CALL_STACK_SIZE     16
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Enable or disable time management.                                                                                 *
+ * Enable or disable barrier.                                                                                         *
  *                                                                                                                    *
  * Notes                                                                                                              *
  *   1. Can be disabled if not needed by the application to decrease flash space used.                                *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_TIME_ENABLE                      1
+#define NOS_CONFIG_BARRIER_ENABLE                   1
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Enable or disable time tick from nOS_Tick.                                                                         *
+ * Enable or disable deleting barrier at run-time.                                                                    *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_BARRIER_DELETE_ENABLE            1
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable work queue (jobs and parallel-for ranges executed by a group of worker threads).                 *
  *                                                                                                                    *
  * Notes                                                                                                              *
- *   1. If disabled, application is responsible to call nOS_TimeTick.                                                 *
+ *   1. Can be disabled if not needed by the application to decrease flash space used.                                *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_TIME_TICK_ENABLE                 1
+#define NOS_CONFIG_WORKQUEUE_ENABLE                 0
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Enable or disable waiting for specific time and date from running thread.                                          *
+ * Enable or disable deleting work queue at run-time.                                                                 *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_WORKQUEUE_DELETE_ENABLE          1
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable publish/subscribe topic (ring of samples read in place by each subscriber).                      *
  *                                                                                                                    *
  * Notes                                                                                                              *
- *   1. Can't sleep from main thread (idle).                                                                          *
+ *   1. Can be disabled if not needed by the application to decrease flash space used.                                *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_TIME_WAIT_ENABLE                 1
+#define NOS_CONFIG_TOPIC_ENABLE                     0
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Number of time ticks per second. Time need this value to know how much ticks equal to 1 second.                    *
+ * Enable or disable deleting topic at run-time.                                                                      *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_TOPIC_DELETE_ENABLE              1
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable asynchronous I/O requests (queued per device, started by driver and completed from its ISR).     *
  *                                                                                                                    *
  * Notes                                                                                                              *
- *   1. It is recommended to don't go higher than 1000 ticks per second.                                              *
+ *   1. Can be disabled if not needed by the application to decrease flash space used.                                *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_TIME_TICKS_PER_SECOND            NOS_CONFIG_TICKS_PER_SECOND
+#define NOS_CONFIG_IO_ENABLE                        0
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Time ticks counter width in bits (can be 32 or 64).                                                                *
+ * Enable or disable stackless tasks (protothreads sharing the stack of a single dispatcher thread).                  *
  *                                                                                                                    *
  * Notes                                                                                                              *
- *   1. Bits width directly affects the highest time/date that can be represented.                                    *
+ *   1. Can be disabled if not needed by the application to decrease flash space used.                                *
+ *   2. If enabled, semaphores, queues and flags wake up dispatcher each time they change.                            *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_TIME_COUNT_WIDTH                 32
+#define NOS_CONFIG_TASK_ENABLE                      0
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Enable or disable alarm management.                                                                                *
+ * Enable or disable deleting task at run-time.                                                                       *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_TASK_DELETE_ENABLE               1
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable task thread that will dispatch tasks.                                                            *
  *                                                                                                                    *
  * Notes                                                                                                              *
- *   1. Can be disabled if not needed by the application to decrease flash space used.                                *
- *   2. Alarm management is dependant from Time module.                                                               *
+ *   1. If disabled, application is responsible to call nOS_TaskProcess.                                              *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_ALARM_ENABLE                     1
+#define NOS_CONFIG_TASK_THREAD_ENABLE               1
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Enable or disable deleting alarm at run-time.                                                                      *
+ * Priority of task thread.                                                                                           *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Not used if task thread is disabled.                                                                          *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_ALARM_DELETE_ENABLE              1
+#define NOS_CONFIG_TASK_THREAD_PRIO                 1
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Enable or disable alarm tick from nOS_Tick.                                                                        *
+ * Stack size of task thread, shared by all tasks.                                                                    *
  *                                                                                                                    *
  * Notes                                                                                                              *
- *   1. If disabled, application is responsible to call nOS_AlarmTick.                                                *
+ *   1. Not used if task thread is disabled.                                                                          *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_ALARM_TICK_ENABLE                1
+#define NOS_CONFIG_TASK_THREAD_STACK_SIZE           128
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Enable or disable alarm thread that will take care of callback.                                                    *
+ * Call stack size of task thread.                                                                                    *
  *                                                                                                                    *
  * Notes                                                                                                              *
- *   1. If disabled, application is responsible to call nOS_AlarmProcess.                                             *
+ *   1. Only available on AVR platform with IAR compiler.                                                             *
+ *   2. Not used if task thread is disabled.                                                                          *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_ALARM_THREAD_ENABLE              1
+#define NOS_CONFIG_TASK_THREAD_CALL_STACK_SIZE      16
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Priority of alarm thread.                                                                                          *
+ * Enable or disable run-to-completion jobs scheduled with stack resource policy (SRP), all sharing the stack of job  *
+ * thread. A job can only be preempted by jobs of higher prio than system ceiling, as a nested function call.         *
  *                                                                                                                    *
  * Notes                                                                                                              *
- *   1. Not used if alarm thread is disabled.                                                                         *
+ *   1. Can be disabled if not needed by the application to decrease flash space used.                                *
+ *   2. Mutex prio is used as resource ceiling when mutex is locked by a job (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0).    *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_ALARM_THREAD_PRIO                1
+#define NOS_CONFIG_JOB_ENABLE                       0
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Stack size of alarm thread.                                                                                        *
+ * Enable or disable deleting job at run-time.                                                                        *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_JOB_DELETE_ENABLE                1
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Highest preemption level a job can take (0 to 7 inclusively).                                                      *
+ *                                                                                                                    *
+ * 0 = Lowest priority                                                                                                *
+ * 7 = Highest priority                                                                                               *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_JOB_HIGHEST_PRIO                 7
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Priority of job thread.                                                                                            *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_JOB_THREAD_PRIO                  1
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Stack size of job thread, shared by all jobs.                                                                      *
  *                                                                                                                    *
  * Notes                                                                                                              *
- *   1. Not used if alarm thread is disabled.                                                                         *
+ *   1. Must be large enough for the sum of deepest job of each preemption level.                                     *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_ALARM_THREAD_STACK_SIZE          128
+#define NOS_CONFIG_JOB_THREAD_STACK_SIZE            256
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Call stack size of alarm thread.                                                                                   *
+ * Call stack size of job thread.                                                                                     *
  *                                                                                                                    *
  * Notes                                                                                                              *
  *   1. Only available on AVR platform with IAR compiler.                                                             *
- *   2. Not used if alarm thread is disabled.                                                                         *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_ALARM_THREAD_CALL_STACK_SIZE     16
+#define NOS_CONFIG_JOB_THREAD_CALL_STACK_SIZE       32
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Enable or disable barrier.                                                                                         *
+ * Enable or disable active objects: event handlers with their own ring of event pointers, run as jobs so many        *
+ * of them share each preemption level of job thread instead of having their own thread, stack and queue.             *
  *                                                                                                                    *
  * Notes                                                                                                              *
  *   1. Can be disabled if not needed by the application to decrease flash space used.                                *
+ *   2. Needs NOS_CONFIG_JOB_ENABLE.                                                                                  *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_BARRIER_ENABLE                   1
+#define NOS_CONFIG_ACTIVE_ENABLE                    0
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Enable or disable deleting barrier at run-time.                                                                    *
+ * Enable or disable deleting active object at run-time.                                                              *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Needs NOS_CONFIG_JOB_DELETE_ENABLE.                                                                           *
  *                                                                                                                    *
  **********************************************************************************************************************/
-#define NOS_CONFIG_BARRIER_DELETE_ENABLE            1
+#define NOS_CONFIG_ACTIVE_DELETE_ENABLE             1
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable waiting on multiple objects at the same time (semaphores, queues, flags and mem).                *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. If enabled, each object use a second list to keep selecting threads.                                          *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_SELECT_ENABLE                    0
 
 /**********************************************************************************************************************
  *                                                                                                                    *
@@ -676,3 +1521,243 @@
  *                                                                                                                    *
  **********************************************************************************************************************/
 #define NOS_CONFIG_MAX_UNSAFE_ISR_PRIO              5
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Interrupts that use nOS API on ARM Cortex M0/M0+ (bit n = IRQn). Critical sections of nOS disable only these       *
+ * interrupts in NVIC and SysTick interrupt, other interrupts keep zero interrupt latency like with                   *
+ * NOS_CONFIG_MAX_UNSAFE_ISR_PRIO on ARM Cortex M3, M4 and M7. Application should not call any nOS API from           *
+ * interrupts that are not in this mask.                                                                              *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Only applicable to ARM Cortex M0/M0+, not used on the others.                                                 *
+ *   2. Can be set to zero to completely disable interrupts in critical section.                                      *
+ *   3. Interrupts of this mask are enabled or disabled in NVIC by application only outside of critical sections,     *
+ *      their state is restored when leaving outermost critical section.                                              *
+ *   4. Tick must come from SysTick or from an interrupt of this mask.                                                *
+ *   5. Only verified with GCC compiler, IAR and Keil ports stop with an error when it is not zero.                   *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_KERNEL_IRQ_MASK                  0x00000000UL
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable placement of scheduler state and context switch path in tightly coupled memories. When enabled,  *
+ * ready lists and bitmap, running and high prio thread pointers, idle thread, nesting counters and ticks counter are *
+ * put in section .nos_dtcm, and PendSV_Handler, nOS_SwitchContext, nOS_Schedule and list and bitmap functions they   *
+ * use are put in section .nos_itcm. Application can put its own threads in DTCM with NOS_FAST_DATA at start of their *
+ * declaration.                                                                                                       *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Only available on ARM Cortex M7 platforms, not used on the others.                                            *
+ *   2. Linker file of application must place both sections, see nOSTCM.ld (GCC), nOSTCM.icf (IAR) or nOSTCM.sct      *
+ *      (Keil) in port directory.                                                                                     *
+ *   3. Objects put in .nos_dtcm are zero initialized like .bss, they can't have an initial value.                    *
+ *   4. No switch time is given for this option, compare it with and without on target with examples/Benchmark.       *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_TCM_ENABLE                       0
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable per thread FPU access. When enabled, nOS_ThreadCreate take an additional parameter to tell if    *
+ * the thread use the FPU. Only threads that use the FPU have access to it, others will fault if they execute a       *
+ * floating point instruction instead of touching the FP context of another thread. Hardware lazy stacking is always  *
+ * enabled by the port, high FP registers (S16-S31) are saved and restored only for threads that have used the FPU.   *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Only available on ARM Cortex M4 and M7 platforms with FPU.                                                    *
+ *   2. Interrupt service routines must not use the FPU when enabled.                                                 *
+ *   3. No switch time is given for this option, measure it on target with examples/Benchmark.                        *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_THREAD_FPU_ENABLE                0
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable cycle counter. When enabled, port start a free running 32 bits counter at initialization and     *
+ * nOS_GetCycleCount() return its current value. Application can use it to measure latency and cost of nOS services   *
+ * (semaphore give to waiter wake up, queue round trip, mutex handoff, tick processing, context switch, ...).         *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Only available on ARM Cortex M3, M4 and M7 (DWT CYCCNT, CPU cycles) and POSIX (nanoseconds) platforms.        *
+ *   2. Counter wrap around, elapsed count must be computed with unsigned subtraction of two values.                  *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_CYCLE_COUNTER_ENABLE             0
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable critical section profiler. When enabled, ports read cycle counter when outermost critical section*
+ * is entered and left, and keep count and longest masked duration of each call site (file and line where             *
+ * nOS_EnterCritical is used). Application read results with nOS_CriticalProfileRead to find which sections hurt      *
+ * interrupt latency. When disabled, profiler hooks are empty macros and cost nothing.                                *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Need NOS_CONFIG_CYCLE_COUNTER_ENABLE to be defined to 1.                                                      *
+ *   2. Only available on ARM Cortex M3, M4 and M7 (CPU cycles) and POSIX (nanoseconds) platforms.                    *
+ *   3. Looking up call site is done before interrupts are unmasked, it lengthens every critical section by few       *
+ *      cycles per site already recorded, but is not included in measured durations.                                  *
+ *   4. On POSIX, a critical section that switch to another thread is accounted to the site where it was entered.     *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_CRITICAL_PROFILE_ENABLE          0
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Maximum number of call sites recorded by critical section profiler (1 to 255). Sections entered from other sites   *
+ * when table is full are accumulated in one extra entry that has no file (NULL).                                     *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_CRITICAL_PROFILE_SITES           16
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable per thread execution time accounting. When enabled, each context switch add elapsed cycles       *
+ * since previous switch to the thread that is leaving, count switches to the thread that is entering and keep the    *
+ * longest time slice. Time spent in main thread (idle) is accounted the same way. See nOS_ThreadGetStats and         *
+ * nOS_GetIdleStats. Cost is one read of the cycle counter and few additions per context switch.                      *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Need NOS_CONFIG_CYCLE_COUNTER_ENABLE to be defined to 1.                                                      *
+ *   2. Only available on ARM Cortex M3, M4 and M7 and POSIX platforms.                                               *
+ *   3. Time spent in interrupt service routines is accounted to the interrupted thread.                              *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_THREAD_STATS_ENABLE              0
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable thread stack usage measurement. When enabled, each thread stack is painted with a known pattern  *
+ * at creation and nOS_ThreadScanStack, called from main thread (idle) loop, verify a bounded number of words of one  *
+ * thread stack per call to find how deep it has been used. See nOS_ThreadGetStackUsage.                              *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Not available on simulated platforms (POSIX and WIN32), threads are using host stacks.                        *
+ *   2. Reported usage is the deepest word that has been found modified, a word overwritten with the paint pattern is *
+ *      not detected.                                                                                                 *
+ *   3. Stack of main thread (idle) is not measured.                                                                  *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_THREAD_STACK_USAGE_ENABLE        0
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Maximum number of stack words verified by each call to nOS_ThreadScanStack. Scan is done in a critical section, a  *
+ * higher value find usage changes faster, a lower value give a shorter interrupt latency.                            *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_THREAD_STACK_SCAN_WORDS          16
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable binary trace of scheduler and object events. When enabled, compact records are written in a RAM  *
+ * ring buffer for context switches, threads waiting and waked up, timers fired, signals dispatched and interrupts    *
+ * entered and leaved. Application read them with nOS_TraceRead to stream them (SWO, RTT, UART, file, ...) for        *
+ * offline timeline analysis. When disabled, trace hooks are empty macros and cost nothing.                           *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Each record is 12 bytes: time (32 bits), object address (32 bits), sequence (16 bits), type and argument      *
+ *      (8 bits each). Time is cycle counter if NOS_CONFIG_CYCLE_COUNTER_ENABLE is enabled, tick counter otherwise.   *
+ *   2. Context switch records are only written by ports that support NOS_CONFIG_THREAD_STATS_ENABLE.                 *
+ *   3. Oldest record is overwritten when buffer is full, lost records are seen as gaps in sequence numbers.          *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_TRACE_ENABLE                     0
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Number of records in trace ring buffer.                                                                            *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_TRACE_BUFFER_SIZE                64
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable deferred logging. When enabled, nOS_Log0 to nOS_Log4 only store format string pointer and up to  *
+ * 4 raw arguments in a RAM ring buffer, formatting is done later by log thread (printf) or by host that read records *
+ * with nOS_LogRead (binary streaming, format strings resolved from image). Logging can be done from threads and ISR, *
+ * it cost few dozen cycles instead of thousands for printf, and nOS_Print (POSIX and Win32) don't need to be used    *
+ * from hot paths anymore.                                                                                            *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Arguments are stored as size_t (nOS_LogArg): format shall only use integer conversions that fit in an int,    *
+ *      %p, and %s with strings that are never modified (constants).                                                  *
+ *   2. On ports with exclusive load/store (NOS_USE_EXCLUSIVE), records are written without critical section.         *
+ *   3. Records are dropped when buffer is full, see nOS_LogGetLost.                                                  *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_LOG_ENABLE                       0
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Number of records in log ring buffer, must be a power of 2.                                                        *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_LOG_BUFFER_SIZE                  32
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable log thread that format records with printf.                                                      *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. If disabled, application or host is responsible to call nOS_LogRead.                                          *
+ *   2. Need NOS_CONFIG_SLEEP_ENABLE to be defined to 1, log thread poll buffer.                                      *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_LOG_THREAD_ENABLE                1
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Priority of log thread.                                                                                            *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Not used if log thread is disabled.                                                                           *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_LOG_THREAD_PRIO                  1
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Number of ticks that log thread sleep when buffer is empty.                                                        *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Not used if log thread is disabled.                                                                           *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_LOG_THREAD_PERIOD                10
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Stack size of log thread, printf need a large stack.                                                               *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Not used if log thread is disabled.                                                                           *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_LOG_THREAD_STACK_SIZE            256
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Call stack size of log thread.                                                                                     *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Only available on AVR platform with IAR compiler.                                                             *
+ *   2. Not used if log thread is disabled.                                                                           *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_LOG_THREAD_CALL_STACK_SIZE       16
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Enable or disable virtual time on simulated platforms. When enabled, systick of simulator doesn't follow host      *
+ * clock anymore: ticks are sent to scheduler as fast as possible, only when all threads are waiting (only main       *
+ * thread is ready to run). When tickless idle is enabled, scheduler jump directly to next thread timeout, timer,     *
+ * time or alarm event, long simulations can be done in seconds.                                                      *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Only used by simulated platforms (POSIX and Win32).                                                           *
+ *   2. A thread that is running (busy loop or blocked in host calls) stop the time.                                  *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_CONFIG_VIRTUAL_TIME_ENABLE              0
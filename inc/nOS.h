@@ -14,6 +14,7 @@ extern "C" {
 #endif
 
 #include <stdlib.h>
+#include <stddef.h>
 #include <string.h>
 
 #define _C99_COMPLIANT_         0
@@ -70,7 +71,7 @@ extern "C" {
 
 #define NOS_QUOTE(s)                #s
 #define NOS_STR(s)                  NOS_QUOTE(s)
-#define NOS_VERSION                 NOS_STR(NOS_VERSION_MAJOR)"."NOS_STR(NOS_VERSION_MINOR)"."NOS_STR(NOS_VERSION_BUILD)
+#define NOS_VERSION                 NOS_STR(NOS_VERSION_MAJOR) "." NOS_STR(NOS_VERSION_MINOR) "." NOS_STR(NOS_VERSION_BUILD)
 
 #define NOS_VERSION_MAJOR           0
 #define NOS_VERSION_MINOR           1
@@ -96,6 +97,12 @@ extern "C" {
  #error "nOSConfig.h: NOS_CONFIG_SAFE is set to invalid value: must be set to 0 or 1."
 #endif
 
+#ifndef NOS_CONFIG_COMPACT_NODE_ENABLE
+ #error "nOSConfig.h: NOS_CONFIG_COMPACT_NODE_ENABLE is not defined: must be set to 0 or 1."
+#elif (NOS_CONFIG_COMPACT_NODE_ENABLE != 0) && (NOS_CONFIG_COMPACT_NODE_ENABLE != 1)
+ #error "nOSConfig.h: NOS_CONFIG_COMPACT_NODE_ENABLE is set to invalid value: must be set to 0 or 1."
+#endif
+
 #ifndef NOS_CONFIG_HIGHEST_THREAD_PRIO
  #error "nOSConfig.h: NOS_CONFIG_HIGHEST_THREAD_PRIO is not defined: must be set between 0 and 255 inclusively."
 #elif (NOS_CONFIG_HIGHEST_THREAD_PRIO < 0) || (NOS_CONFIG_HIGHEST_THREAD_PRIO > 255)
@@ -108,6 +115,44 @@ extern "C" {
  #error "nOSConfig.h: NOS_CONFIG_TICK_COUNT_WIDTH is set to invalid value: must be set to 8, 16, 32 or 64."
 #endif
 
+#ifndef NOS_CONFIG_TICK_COUNT_LOCK_FREE_ENABLE
+ #error "nOSConfig.h: NOS_CONFIG_TICK_COUNT_LOCK_FREE_ENABLE is not defined: must be set to 0 or 1."
+#elif (NOS_CONFIG_TICK_COUNT_LOCK_FREE_ENABLE != 0) && (NOS_CONFIG_TICK_COUNT_LOCK_FREE_ENABLE != 1)
+ #error "nOSConfig.h: NOS_CONFIG_TICK_COUNT_LOCK_FREE_ENABLE is set to invalid value: must be set to 0 or 1."
+#endif
+
+#ifndef NOS_CONFIG_TICKLESS_ENABLE
+ #error "nOSConfig.h: NOS_CONFIG_TICKLESS_ENABLE is not defined: must be set to 0 or 1."
+#elif (NOS_CONFIG_TICKLESS_ENABLE != 0) && (NOS_CONFIG_TICKLESS_ENABLE != 1)
+ #error "nOSConfig.h: NOS_CONFIG_TICKLESS_ENABLE is set to invalid value: must be set to 0 or 1."
+#endif
+
+#ifndef NOS_CONFIG_POWER_ENABLE
+ #error "nOSConfig.h: NOS_CONFIG_POWER_ENABLE is not defined: must be set to 0 or 1."
+#elif (NOS_CONFIG_POWER_ENABLE != 0) && (NOS_CONFIG_POWER_ENABLE != 1)
+ #error "nOSConfig.h: NOS_CONFIG_POWER_ENABLE is set to invalid value: must be set to 0 or 1."
+#elif (NOS_CONFIG_POWER_ENABLE > 0) && (!defined(NOS_CONFIG_TICKS_PER_SECOND) || (NOS_CONFIG_TICKS_PER_SECOND == 0))
+ #error "nOSConfig.h: NOS_CONFIG_POWER_ENABLE can't be used when NOS_CONFIG_TICKS_PER_SECOND is not defined."
+#elif (NOS_CONFIG_POWER_ENABLE > 0)
+ #ifndef NOS_CONFIG_POWER_DEEPEST_MODE
+  #error "nOSConfig.h: NOS_CONFIG_POWER_DEEPEST_MODE is not defined: must be set between 0 and 255 inclusively."
+ #elif (NOS_CONFIG_POWER_DEEPEST_MODE < 0) || (NOS_CONFIG_POWER_DEEPEST_MODE > 255)
+  #error "nOSConfig.h: NOS_CONFIG_POWER_DEEPEST_MODE is set to invalid value: must be set between 0 and 255 inclusively."
+ #endif
+ #ifndef NOS_CONFIG_POWER_DEEP_LATENCY
+  #error "nOSConfig.h: NOS_CONFIG_POWER_DEEP_LATENCY is not defined."
+ #endif
+#else
+ #undef NOS_CONFIG_POWER_DEEPEST_MODE
+ #undef NOS_CONFIG_POWER_DEEP_LATENCY
+#endif
+
+#ifndef NOS_CONFIG_TICK_BATCH_SIZE
+ #error "nOSConfig.h: NOS_CONFIG_TICK_BATCH_SIZE is not defined: must be set to 0 (unlimited) or higher."
+#elif (NOS_CONFIG_TICK_BATCH_SIZE < 0)
+ #error "nOSConfig.h: NOS_CONFIG_TICK_BATCH_SIZE is set to invalid value: must be set to 0 (unlimited) or higher."
+#endif
+
 #ifndef NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE
  #if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
   #error "nOSConfig.h: NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE is not defined: must be set to 0 or 1."
@@ -124,6 +169,14 @@ extern "C" {
  #error "nOSConfig.h: NOS_CONFIG_SCHED_ROUND_ROBIN_ENABLE is set to invalid value: must be set to 0 or 1."
 #elif (NOS_CONFIG_SCHED_ROUND_ROBIN_ENABLE > 0) && (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE == 0) && (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
  #error "nOSConfig.h: NOS_CONFIG_SCHED_ROUND_ROBIN_ENABLE should not be used in cooperative scheduling with more than 1 level of priority."
+#elif (NOS_CONFIG_SCHED_ROUND_ROBIN_ENABLE > 0)
+ #ifndef NOS_CONFIG_SCHED_ROUND_ROBIN_QUANTUM
+  #error "nOSConfig.h: NOS_CONFIG_SCHED_ROUND_ROBIN_QUANTUM is not defined: must be set between 1 and 65535 inclusively."
+ #elif (NOS_CONFIG_SCHED_ROUND_ROBIN_QUANTUM < 1) || (NOS_CONFIG_SCHED_ROUND_ROBIN_QUANTUM > 65535)
+  #error "nOSConfig.h: NOS_CONFIG_SCHED_ROUND_ROBIN_QUANTUM is set to invalid value: must be set between 1 and 65535 inclusively."
+ #endif
+#else
+ #undef NOS_CONFIG_SCHED_ROUND_ROBIN_QUANTUM
 #endif
 
 #ifndef NOS_CONFIG_SCHED_LOCK_ENABLE
@@ -132,6 +185,56 @@ extern "C" {
  #error "nOSConfig.h: NOS_CONFIG_SCHED_LOCK_ENABLE is set to invalid value: must be set to 0 or 1."
 #endif
 
+#ifndef NOS_CONFIG_CRITICAL_WALK_LIMIT
+ #error "nOSConfig.h: NOS_CONFIG_CRITICAL_WALK_LIMIT is not defined: must be set between 0 (unlimited) and 255 inclusively."
+#elif (NOS_CONFIG_CRITICAL_WALK_LIMIT < 0) || (NOS_CONFIG_CRITICAL_WALK_LIMIT > 255)
+ #error "nOSConfig.h: NOS_CONFIG_CRITICAL_WALK_LIMIT is set to invalid value: must be set between 0 (unlimited) and 255 inclusively."
+#elif (NOS_CONFIG_CRITICAL_WALK_LIMIT > 0) && (NOS_CONFIG_SCHED_LOCK_ENABLE == 0)
+ #error "nOSConfig.h: NOS_CONFIG_CRITICAL_WALK_LIMIT can't be used when NOS_CONFIG_SCHED_LOCK_ENABLE == 0."
+#endif
+
+#ifndef NOS_CONFIG_SCHED_DEFERRED_ENABLE
+ #error "nOSConfig.h: NOS_CONFIG_SCHED_DEFERRED_ENABLE is not defined: must be set to 0 or 1."
+#elif (NOS_CONFIG_SCHED_DEFERRED_ENABLE != 0) && (NOS_CONFIG_SCHED_DEFERRED_ENABLE != 1)
+ #error "nOSConfig.h: NOS_CONFIG_SCHED_DEFERRED_ENABLE is set to invalid value: must be set to 0 or 1."
+#elif (NOS_CONFIG_SCHED_DEFERRED_ENABLE > 0) && (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE == 0)
+ #error "nOSConfig.h: NOS_CONFIG_SCHED_DEFERRED_ENABLE can't be used when NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE == 0 (cooperative scheduling)."
+#endif
+
+#ifndef NOS_CONFIG_SCHED_EDF_ENABLE
+ #error "nOSConfig.h: NOS_CONFIG_SCHED_EDF_ENABLE is not defined: must be set to 0 or 1."
+#elif (NOS_CONFIG_SCHED_EDF_ENABLE != 0) && (NOS_CONFIG_SCHED_EDF_ENABLE != 1)
+ #error "nOSConfig.h: NOS_CONFIG_SCHED_EDF_ENABLE is set to invalid value: must be set to 0 or 1."
+#elif (NOS_CONFIG_SCHED_EDF_ENABLE > 0) && (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE == 0)
+ #error "nOSConfig.h: NOS_CONFIG_SCHED_EDF_ENABLE can't be used when NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE == 0 (cooperative scheduling)."
+#elif (NOS_CONFIG_SCHED_EDF_ENABLE > 0) && (NOS_CONFIG_SMP_CORE_COUNT > 1)
+ #error "nOSConfig.h: NOS_CONFIG_SCHED_EDF_ENABLE can't be used when NOS_CONFIG_SMP_CORE_COUNT is higher than 1."
+#elif (NOS_CONFIG_SCHED_EDF_ENABLE > 0)
+ #ifndef NOS_CONFIG_SCHED_EDF_PRIO
+  #error "nOSConfig.h: NOS_CONFIG_SCHED_EDF_PRIO is not defined: must be set between 1 and NOS_CONFIG_HIGHEST_THREAD_PRIO inclusively."
+ #elif (NOS_CONFIG_SCHED_EDF_PRIO < 1) || (NOS_CONFIG_SCHED_EDF_PRIO > NOS_CONFIG_HIGHEST_THREAD_PRIO)
+  #error "nOSConfig.h: NOS_CONFIG_SCHED_EDF_PRIO is set to invalid value: must be set between 1 and NOS_CONFIG_HIGHEST_THREAD_PRIO inclusively."
+ #endif
+#else
+ #undef NOS_CONFIG_SCHED_EDF_PRIO
+#endif
+
+#ifndef NOS_CONFIG_SMP_CORE_COUNT
+ #error "nOSConfig.h: NOS_CONFIG_SMP_CORE_COUNT is not defined: must be set between 1 and 8 inclusively."
+#elif (NOS_CONFIG_SMP_CORE_COUNT < 1) || (NOS_CONFIG_SMP_CORE_COUNT > 8)
+ #error "nOSConfig.h: NOS_CONFIG_SMP_CORE_COUNT is set to invalid value: must be set between 1 and 8 inclusively."
+#elif (NOS_CONFIG_SMP_CORE_COUNT > 1) && (NOS_CONFIG_HIGHEST_THREAD_PRIO == 0)
+ #error "nOSConfig.h: NOS_CONFIG_SMP_CORE_COUNT can't be higher than 1 when NOS_CONFIG_HIGHEST_THREAD_PRIO == 0 (cooperative scheduling)."
+#elif (NOS_CONFIG_SMP_CORE_COUNT > 1) && (NOS_CONFIG_SCHED_DEFERRED_ENABLE > 0)
+ #error "nOSConfig.h: NOS_CONFIG_SMP_CORE_COUNT can't be higher than 1 when NOS_CONFIG_SCHED_DEFERRED_ENABLE is enabled."
+#endif
+
+#ifndef NOS_CONFIG_SMP_WORK_STEALING_ENABLE
+ #error "nOSConfig.h: NOS_CONFIG_SMP_WORK_STEALING_ENABLE is not defined: must be set to 0 or 1."
+#elif (NOS_CONFIG_SMP_WORK_STEALING_ENABLE != 0) && (NOS_CONFIG_SMP_WORK_STEALING_ENABLE != 1)
+ #error "nOSConfig.h: NOS_CONFIG_SMP_WORK_STEALING_ENABLE is set to invalid value: must be set to 0 or 1."
+#endif
+
 #ifndef NOS_CONFIG_SLEEP_ENABLE
  #error "nOSConfig.h: NOS_CONFIG_SLEEP_ENABLE is not defined: must be set to 0 or 1."
 #elif (NOS_CONFIG_SLEEP_ENABLE != 0) && (NOS_CONFIG_SLEEP_ENABLE != 1)
@@ -189,12 +292,87 @@ extern "C" {
  #error "nOSConfig.h: NOS_CONFIG_THREAD_JOIN_ENABLE is set to invalid value: must be set to 0 or 1."
 #endif
 
+#ifndef NOS_CONFIG_THREAD_SPAWN_ENABLE
+ #error "nOSConfig.h: NOS_CONFIG_THREAD_SPAWN_ENABLE is not defined: must be set to 0 or 1."
+#elif (NOS_CONFIG_THREAD_SPAWN_ENABLE != 0) && (NOS_CONFIG_THREAD_SPAWN_ENABLE != 1)
+ #error "nOSConfig.h: NOS_CONFIG_THREAD_SPAWN_ENABLE is set to invalid value: must be set to 0 or 1."
+#elif (NOS_CONFIG_THREAD_SPAWN_ENABLE > 0) && (NOS_CONFIG_THREAD_JOIN_ENABLE == 0)
+ #error "nOSConfig.h: NOS_CONFIG_THREAD_SPAWN_ENABLE can't be used when NOS_CONFIG_THREAD_JOIN_ENABLE == 0."
+#elif (NOS_CONFIG_THREAD_SPAWN_ENABLE > 0)
+ #ifndef NOS_CONFIG_THREAD_SPAWN_COUNT
+  #error "nOSConfig.h: NOS_CONFIG_THREAD_SPAWN_COUNT is not defined: must be set between 1 and 255 inclusively."
+ #elif (NOS_CONFIG_THREAD_SPAWN_COUNT < 1) || (NOS_CONFIG_THREAD_SPAWN_COUNT > 255)
+  #error "nOSConfig.h: NOS_CONFIG_THREAD_SPAWN_COUNT is set to invalid value: must be set between 1 and 255 inclusively."
+ #endif
+ #ifndef NOS_CONFIG_THREAD_SPAWN_STACK_SIZE
+  #error "nOSConfig.h: NOS_CONFIG_THREAD_SPAWN_STACK_SIZE is not defined."
+ #endif
+#else
+ #undef NOS_CONFIG_THREAD_SPAWN_COUNT
+ #undef NOS_CONFIG_THREAD_SPAWN_STACK_SIZE
+#endif
+
+#ifndef NOS_CONFIG_THREAD_NOTIFY_ENABLE
+ #error "nOSConfig.h: NOS_CONFIG_THREAD_NOTIFY_ENABLE is not defined: must be set to 0 or 1."
+#elif (NOS_CONFIG_THREAD_NOTIFY_ENABLE != 0) && (NOS_CONFIG_THREAD_NOTIFY_ENABLE != 1)
+ #error "nOSConfig.h: NOS_CONFIG_THREAD_NOTIFY_ENABLE is set to invalid value: must be set to 0 or 1."
+#endif
+
+#ifndef NOS_CONFIG_THREAD_BUDGET_ENABLE
+ #error "nOSConfig.h: NOS_CONFIG_THREAD_BUDGET_ENABLE is not defined: must be set to 0 or 1."
+#elif (NOS_CONFIG_THREAD_BUDGET_ENABLE != 0) && (NOS_CONFIG_THREAD_BUDGET_ENABLE != 1)
+ #error "nOSConfig.h: NOS_CONFIG_THREAD_BUDGET_ENABLE is set to invalid value: must be set to 0 or 1."
+#elif (NOS_CONFIG_THREAD_BUDGET_ENABLE > 0) && (NOS_CONFIG_HIGHEST_THREAD_PRIO == 0)
+ #error "nOSConfig.h: NOS_CONFIG_THREAD_BUDGET_ENABLE can't be used when NOS_CONFIG_HIGHEST_THREAD_PRIO == 0 (cooperative scheduling)."
+#endif
+
+#ifndef NOS_CONFIG_THREAD_PERIODIC_ENABLE
+ #error "nOSConfig.h: NOS_CONFIG_THREAD_PERIODIC_ENABLE is not defined: must be set to 0 or 1."
+#elif (NOS_CONFIG_THREAD_PERIODIC_ENABLE != 0) && (NOS_CONFIG_THREAD_PERIODIC_ENABLE != 1)
+ #error "nOSConfig.h: NOS_CONFIG_THREAD_PERIODIC_ENABLE is set to invalid value: must be set to 0 or 1."
+#elif (NOS_CONFIG_THREAD_PERIODIC_ENABLE > 0) && (NOS_CONFIG_SLEEP_UNTIL_ENABLE == 0)
+ #error "nOSConfig.h: NOS_CONFIG_THREAD_PERIODIC_ENABLE can't be used when NOS_CONFIG_SLEEP_UNTIL_ENABLE == 0."
+#endif
+
 #ifndef NOS_CONFIG_WAITING_TIMEOUT_ENABLE
  #error "nOSConfig.h: NOS_CONFIG_WAITING_TIMEOUT_ENABLE is not defined: must be set to 0 or 1."
 #elif (NOS_CONFIG_WAITING_TIMEOUT_ENABLE != 0) && (NOS_CONFIG_WAITING_TIMEOUT_ENABLE != 1)
  #error "nOSConfig.h: NOS_CONFIG_WAITING_TIMEOUT_ENABLE is set to invalid value: must be set to 0 or 1."
 #endif
 
+#if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0) || (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
+ #ifndef NOS_CONFIG_SORTED_TIMEOUT_LIST_ENABLE
+  #error "nOSConfig.h: NOS_CONFIG_SORTED_TIMEOUT_LIST_ENABLE is not defined: must be set to 0 or 1."
+ #elif (NOS_CONFIG_SORTED_TIMEOUT_LIST_ENABLE != 0) && (NOS_CONFIG_SORTED_TIMEOUT_LIST_ENABLE != 1)
+  #error "nOSConfig.h: NOS_CONFIG_SORTED_TIMEOUT_LIST_ENABLE is set to invalid value: must be set to 0 or 1."
+ #endif
+#else
+ #undef NOS_CONFIG_SORTED_TIMEOUT_LIST_ENABLE
+ #define NOS_CONFIG_SORTED_TIMEOUT_LIST_ENABLE  0
+#endif
+
+#if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
+ #ifndef NOS_CONFIG_WAITING_PRIO_ORDER_ENABLE
+  #error "nOSConfig.h: NOS_CONFIG_WAITING_PRIO_ORDER_ENABLE is not defined: must be set to 0 or 1."
+ #elif (NOS_CONFIG_WAITING_PRIO_ORDER_ENABLE != 0) && (NOS_CONFIG_WAITING_PRIO_ORDER_ENABLE != 1)
+  #error "nOSConfig.h: NOS_CONFIG_WAITING_PRIO_ORDER_ENABLE is set to invalid value: must be set to 0 or 1."
+ #endif
+#else
+ #undef NOS_CONFIG_WAITING_PRIO_ORDER_ENABLE
+ #define NOS_CONFIG_WAITING_PRIO_ORDER_ENABLE   0
+#endif
+
+#if (NOS_CONFIG_WAITING_PRIO_ORDER_ENABLE > 0)
+ #ifndef NOS_CONFIG_WAITING_POLICY_ENABLE
+  #error "nOSConfig.h: NOS_CONFIG_WAITING_POLICY_ENABLE is not defined: must be set to 0 or 1."
+ #elif (NOS_CONFIG_WAITING_POLICY_ENABLE != 0) && (NOS_CONFIG_WAITING_POLICY_ENABLE != 1)
+  #error "nOSConfig.h: NOS_CONFIG_WAITING_POLICY_ENABLE is set to invalid value: must be set to 0 or 1."
+ #endif
+#else
+ #undef NOS_CONFIG_WAITING_POLICY_ENABLE
+ #define NOS_CONFIG_WAITING_POLICY_ENABLE       0
+#endif
+
 #ifndef NOS_CONFIG_SEM_ENABLE
  #error "nOSConfig.h: NOS_CONFIG_SEM_ENABLE is not defined: must be set to 0 or 1."
 #elif (NOS_CONFIG_SEM_ENABLE != 0) && (NOS_CONFIG_SEM_ENABLE != 1)
@@ -210,9 +388,15 @@ extern "C" {
  #elif (NOS_CONFIG_SEM_COUNT_WIDTH != 8) && (NOS_CONFIG_SEM_COUNT_WIDTH != 16) && (NOS_CONFIG_SEM_COUNT_WIDTH != 32) && (NOS_CONFIG_SEM_COUNT_WIDTH != 64)
   #error "nOSConfig.h: NOS_CONFIG_SEM_COUNT_WIDTH is set to invalid value: must be set to 8, 16, 32 or 64."
  #endif
+ #ifndef NOS_CONFIG_SEM_MULTI_ENABLE
+  #error "nOSConfig.h: NOS_CONFIG_SEM_MULTI_ENABLE is not defined: must be set to 0 or 1."
+ #elif (NOS_CONFIG_SEM_MULTI_ENABLE != 0) && (NOS_CONFIG_SEM_MULTI_ENABLE != 1)
+  #error "nOSConfig.h: NOS_CONFIG_SEM_MULTI_ENABLE is set to invalid value: must be set to 0 or 1."
+ #endif
 #else
  #undef NOS_CONFIG_SEM_DELETE_ENABLE
  #undef NOS_CONFIG_SEM_COUNT_WIDTH
+ #undef NOS_CONFIG_SEM_MULTI_ENABLE
 #endif
 
 #ifndef NOS_CONFIG_MUTEX_ENABLE
@@ -230,9 +414,35 @@ extern "C" {
  #elif (NOS_CONFIG_MUTEX_COUNT_WIDTH != 8) && (NOS_CONFIG_MUTEX_COUNT_WIDTH != 16) && (NOS_CONFIG_MUTEX_COUNT_WIDTH != 32) && (NOS_CONFIG_MUTEX_COUNT_WIDTH != 64)
   #error "nOSConfig.h: NOS_CONFIG_MUTEX_COUNT_WIDTH is set to invalid value: must be set to 8, 16, 32 or 64."
  #endif
+ #ifndef NOS_CONFIG_MUTEX_SPIN_COUNT
+  #error "nOSConfig.h: NOS_CONFIG_MUTEX_SPIN_COUNT is not defined: must be set to 0 (disabled) or higher."
+ #elif (NOS_CONFIG_MUTEX_SPIN_COUNT < 0)
+  #error "nOSConfig.h: NOS_CONFIG_MUTEX_SPIN_COUNT is set to invalid value: must be set to 0 (disabled) or higher."
+ #endif
 #else
  #undef NOS_CONFIG_MUTEX_DELETE_ENABLE
  #undef NOS_CONFIG_MUTEX_COUNT_WIDTH
+ #undef NOS_CONFIG_MUTEX_SPIN_COUNT
+#endif
+
+#ifndef NOS_CONFIG_RWLOCK_ENABLE
+ #error "nOSConfig.h: NOS_CONFIG_RWLOCK_ENABLE is not defined: must be set to 0 or 1."
+#elif (NOS_CONFIG_RWLOCK_ENABLE != 0) && (NOS_CONFIG_RWLOCK_ENABLE != 1)
+ #error "nOSConfig.h: NOS_CONFIG_RWLOCK_ENABLE is set to invalid value: must be set to 0 or 1."
+#elif (NOS_CONFIG_RWLOCK_ENABLE > 0)
+ #ifndef NOS_CONFIG_RWLOCK_DELETE_ENABLE
+  #error "nOSConfig.h: NOS_CONFIG_RWLOCK_DELETE_ENABLE is not defined: must be set to 0 or 1."
+ #elif (NOS_CONFIG_RWLOCK_DELETE_ENABLE != 0) && (NOS_CONFIG_RWLOCK_DELETE_ENABLE != 1)
+  #error "nOSConfig.h: NOS_CONFIG_RWLOCK_DELETE_ENABLE is set to invalid value: must be set to 0 or 1."
+ #endif
+ #ifndef NOS_CONFIG_RWLOCK_COUNT_WIDTH
+  #error "nOSConfig.h: NOS_CONFIG_RWLOCK_COUNT_WIDTH is not defined: must be set to 8, 16 or 32."
+ #elif (NOS_CONFIG_RWLOCK_COUNT_WIDTH != 8) && (NOS_CONFIG_RWLOCK_COUNT_WIDTH != 16) && (NOS_CONFIG_RWLOCK_COUNT_WIDTH != 32)
+  #error "nOSConfig.h: NOS_CONFIG_RWLOCK_COUNT_WIDTH is set to invalid value: must be set to 8, 16 or 32."
+ #endif
+#else
+ #undef NOS_CONFIG_RWLOCK_DELETE_ENABLE
+ #undef NOS_CONFIG_RWLOCK_COUNT_WIDTH
 #endif
 
 #ifndef NOS_CONFIG_FLAG_ENABLE
@@ -265,14 +475,100 @@ extern "C" {
  #elif (NOS_CONFIG_QUEUE_DELETE_ENABLE != 0) && (NOS_CONFIG_QUEUE_DELETE_ENABLE != 1)
   #error "nOSConfig.h: NOS_CONFIG_QUEUE_DELETE_ENABLE is set to invalid value: must be set to 0 or 1."
  #endif
+ #ifndef NOS_CONFIG_QUEUE_ZERO_COPY_ENABLE
+  #error "nOSConfig.h: NOS_CONFIG_QUEUE_ZERO_COPY_ENABLE is not defined: must be set to 0 or 1."
+ #elif (NOS_CONFIG_QUEUE_ZERO_COPY_ENABLE != 0) && (NOS_CONFIG_QUEUE_ZERO_COPY_ENABLE != 1)
+  #error "nOSConfig.h: NOS_CONFIG_QUEUE_ZERO_COPY_ENABLE is set to invalid value: must be set to 0 or 1."
+ #endif
  #ifndef NOS_CONFIG_QUEUE_BLOCK_COUNT_WIDTH
   #error "nOSConfig.h: NOS_CONFIG_QUEUE_BLOCK_COUNT_WIDTH is not defined: must be set to 8, 16, 32, or 64."
  #elif (NOS_CONFIG_QUEUE_BLOCK_COUNT_WIDTH != 8) && (NOS_CONFIG_QUEUE_BLOCK_COUNT_WIDTH != 16) && (NOS_CONFIG_QUEUE_BLOCK_COUNT_WIDTH != 32) && (NOS_CONFIG_QUEUE_BLOCK_COUNT_WIDTH != 64)
   #error "nOSConfig.h: NOS_CONFIG_QUEUE_BLOCK_COUNT_WIDTH is set to invalid value: must be set to 8, 16, 32 or 64."
  #endif
+ #ifndef NOS_CONFIG_QUEUE_BLOCK_SIZE_WIDTH
+  #error "nOSConfig.h: NOS_CONFIG_QUEUE_BLOCK_SIZE_WIDTH is not defined: must be set to 8, 16, 32, or 64."
+ #elif (NOS_CONFIG_QUEUE_BLOCK_SIZE_WIDTH != 8) && (NOS_CONFIG_QUEUE_BLOCK_SIZE_WIDTH != 16) && (NOS_CONFIG_QUEUE_BLOCK_SIZE_WIDTH != 32) && (NOS_CONFIG_QUEUE_BLOCK_SIZE_WIDTH != 64)
+  #error "nOSConfig.h: NOS_CONFIG_QUEUE_BLOCK_SIZE_WIDTH is set to invalid value: must be set to 8, 16, 32 or 64."
+ #endif
+ #ifndef NOS_CONFIG_QUEUE_POW2_ENABLE
+  #error "nOSConfig.h: NOS_CONFIG_QUEUE_POW2_ENABLE is not defined: must be set to 0 or 1."
+ #elif (NOS_CONFIG_QUEUE_POW2_ENABLE != 0) && (NOS_CONFIG_QUEUE_POW2_ENABLE != 1)
+  #error "nOSConfig.h: NOS_CONFIG_QUEUE_POW2_ENABLE is set to invalid value: must be set to 0 or 1."
+ #endif
+ #ifndef NOS_CONFIG_QUEUE_MULTI_ENABLE
+  #error "nOSConfig.h: NOS_CONFIG_QUEUE_MULTI_ENABLE is not defined: must be set to 0 or 1."
+ #elif (NOS_CONFIG_QUEUE_MULTI_ENABLE != 0) && (NOS_CONFIG_QUEUE_MULTI_ENABLE != 1)
+  #error "nOSConfig.h: NOS_CONFIG_QUEUE_MULTI_ENABLE is set to invalid value: must be set to 0 or 1."
+ #endif
+ #ifndef NOS_CONFIG_QUEUE_OVERWRITE_ENABLE
+  #error "nOSConfig.h: NOS_CONFIG_QUEUE_OVERWRITE_ENABLE is not defined: must be set to 0 or 1."
+ #elif (NOS_CONFIG_QUEUE_OVERWRITE_ENABLE != 0) && (NOS_CONFIG_QUEUE_OVERWRITE_ENABLE != 1)
+  #error "nOSConfig.h: NOS_CONFIG_QUEUE_OVERWRITE_ENABLE is set to invalid value: must be set to 0 or 1."
+ #endif
 #else
  #undef NOS_CONFIG_QUEUE_DELETE_ENABLE
+ #undef NOS_CONFIG_QUEUE_ZERO_COPY_ENABLE
  #undef NOS_CONFIG_QUEUE_BLOCK_COUNT_WIDTH
+ #undef NOS_CONFIG_QUEUE_BLOCK_SIZE_WIDTH
+ #undef NOS_CONFIG_QUEUE_POW2_ENABLE
+ #undef NOS_CONFIG_QUEUE_MULTI_ENABLE
+ #undef NOS_CONFIG_QUEUE_OVERWRITE_ENABLE
+#endif
+
+#ifndef NOS_CONFIG_STREAM_ENABLE
+ #error "nOSConfig.h: NOS_CONFIG_STREAM_ENABLE is not defined: must be set to 0 or 1."
+#elif (NOS_CONFIG_STREAM_ENABLE != 0) && (NOS_CONFIG_STREAM_ENABLE != 1)
+ #error "nOSConfig.h: NOS_CONFIG_STREAM_ENABLE is set to invalid value: must be set to 0 or 1."
+#elif (NOS_CONFIG_STREAM_ENABLE > 0)
+ #ifndef NOS_CONFIG_STREAM_DELETE_ENABLE
+  #error "nOSConfig.h: NOS_CONFIG_STREAM_DELETE_ENABLE is not defined: must be set to 0 or 1."
+ #elif (NOS_CONFIG_STREAM_DELETE_ENABLE != 0) && (NOS_CONFIG_STREAM_DELETE_ENABLE != 1)
+  #error "nOSConfig.h: NOS_CONFIG_STREAM_DELETE_ENABLE is set to invalid value: must be set to 0 or 1."
+ #endif
+ #ifndef NOS_CONFIG_STREAM_COUNT_WIDTH
+  #error "nOSConfig.h: NOS_CONFIG_STREAM_COUNT_WIDTH is not defined: must be set to 8, 16 or 32."
+ #elif (NOS_CONFIG_STREAM_COUNT_WIDTH != 8) && (NOS_CONFIG_STREAM_COUNT_WIDTH != 16) && (NOS_CONFIG_STREAM_COUNT_WIDTH != 32)
+  #error "nOSConfig.h: NOS_CONFIG_STREAM_COUNT_WIDTH is set to invalid value: must be set to 8, 16 or 32."
+ #endif
+#else
+ #undef NOS_CONFIG_STREAM_DELETE_ENABLE
+ #undef NOS_CONFIG_STREAM_COUNT_WIDTH
+#endif
+
+#ifndef NOS_CONFIG_MBOX_ENABLE
+ #error "nOSConfig.h: NOS_CONFIG_MBOX_ENABLE is not defined: must be set to 0 or 1."
+#elif (NOS_CONFIG_MBOX_ENABLE != 0) && (NOS_CONFIG_MBOX_ENABLE != 1)
+ #error "nOSConfig.h: NOS_CONFIG_MBOX_ENABLE is set to invalid value: must be set to 0 or 1."
+#elif (NOS_CONFIG_MBOX_ENABLE > 0)
+ #ifndef NOS_CONFIG_MBOX_DELETE_ENABLE
+  #error "nOSConfig.h: NOS_CONFIG_MBOX_DELETE_ENABLE is not defined: must be set to 0 or 1."
+ #elif (NOS_CONFIG_MBOX_DELETE_ENABLE != 0) && (NOS_CONFIG_MBOX_DELETE_ENABLE != 1)
+  #error "nOSConfig.h: NOS_CONFIG_MBOX_DELETE_ENABLE is set to invalid value: must be set to 0 or 1."
+ #endif
+ #ifndef NOS_CONFIG_MBOX_COUNT_WIDTH
+  #error "nOSConfig.h: NOS_CONFIG_MBOX_COUNT_WIDTH is not defined: must be set to 8, 16 or 32."
+ #elif (NOS_CONFIG_MBOX_COUNT_WIDTH != 8) && (NOS_CONFIG_MBOX_COUNT_WIDTH != 16) && (NOS_CONFIG_MBOX_COUNT_WIDTH != 32)
+  #error "nOSConfig.h: NOS_CONFIG_MBOX_COUNT_WIDTH is set to invalid value: must be set to 8, 16 or 32."
+ #endif
+#else
+ #undef NOS_CONFIG_MBOX_DELETE_ENABLE
+ #undef NOS_CONFIG_MBOX_COUNT_WIDTH
+#endif
+
+#ifndef NOS_CONFIG_MSGQUEUE_ENABLE
+ #error "nOSConfig.h: NOS_CONFIG_MSGQUEUE_ENABLE is not defined: must be set to 0 or 1."
+#elif (NOS_CONFIG_MSGQUEUE_ENABLE != 0) && (NOS_CONFIG_MSGQUEUE_ENABLE != 1)
+ #error "nOSConfig.h: NOS_CONFIG_MSGQUEUE_ENABLE is set to invalid value: must be set to 0 or 1."
+#elif (NOS_CONFIG_MSGQUEUE_ENABLE > 0) && (NOS_CONFIG_COMPACT_NODE_ENABLE > 0)
+ #error "nOSConfig.h: NOS_CONFIG_MSGQUEUE_ENABLE can't be used with NOS_CONFIG_COMPACT_NODE_ENABLE (message is stored in node)."
+#elif (NOS_CONFIG_MSGQUEUE_ENABLE > 0)
+ #ifndef NOS_CONFIG_MSGQUEUE_DELETE_ENABLE
+  #error "nOSConfig.h: NOS_CONFIG_MSGQUEUE_DELETE_ENABLE is not defined: must be set to 0 or 1."
+ #elif (NOS_CONFIG_MSGQUEUE_DELETE_ENABLE != 0) && (NOS_CONFIG_MSGQUEUE_DELETE_ENABLE != 1)
+  #error "nOSConfig.h: NOS_CONFIG_MSGQUEUE_DELETE_ENABLE is set to invalid value: must be set to 0 or 1."
+ #endif
+#else
+ #undef NOS_CONFIG_MSGQUEUE_DELETE_ENABLE
 #endif
 
 #ifndef NOS_CONFIG_MEM_ENABLE
@@ -299,12 +595,55 @@ extern "C" {
   #error "nOSConfig.h: NOS_CONFIG_MEM_SANITY_CHECK_ENABLE is not defined: must be set to 0 or 1."
  #elif (NOS_CONFIG_MEM_SANITY_CHECK_ENABLE != 0) && (NOS_CONFIG_MEM_SANITY_CHECK_ENABLE != 1)
   #error "nOSConfig.h: NOS_CONFIG_MEM_SANITY_CHECK_ENABLE is set to invalid value: must be set to 0 or 1."
+ #elif (NOS_CONFIG_MEM_SANITY_CHECK_ENABLE > 0)
+  #ifndef NOS_CONFIG_MEM_BITMAP_ENABLE
+   #error "nOSConfig.h: NOS_CONFIG_MEM_BITMAP_ENABLE is not defined: must be set to 0 or 1."
+  #elif (NOS_CONFIG_MEM_BITMAP_ENABLE != 0) && (NOS_CONFIG_MEM_BITMAP_ENABLE != 1)
+   #error "nOSConfig.h: NOS_CONFIG_MEM_BITMAP_ENABLE is set to invalid value: must be set to 0 or 1."
+  #endif
+ #else
+  #undef NOS_CONFIG_MEM_BITMAP_ENABLE
+ #endif
+ #ifndef NOS_CONFIG_MEM_STATS_ENABLE
+  #error "nOSConfig.h: NOS_CONFIG_MEM_STATS_ENABLE is not defined: must be set to 0 or 1."
+ #elif (NOS_CONFIG_MEM_STATS_ENABLE != 0) && (NOS_CONFIG_MEM_STATS_ENABLE != 1)
+  #error "nOSConfig.h: NOS_CONFIG_MEM_STATS_ENABLE is set to invalid value: must be set to 0 or 1."
+ #endif
+ #ifndef NOS_CONFIG_MEM_CACHE_ENABLE
+  #error "nOSConfig.h: NOS_CONFIG_MEM_CACHE_ENABLE is not defined: must be set to 0 or 1."
+ #elif (NOS_CONFIG_MEM_CACHE_ENABLE != 0) && (NOS_CONFIG_MEM_CACHE_ENABLE != 1)
+  #error "nOSConfig.h: NOS_CONFIG_MEM_CACHE_ENABLE is set to invalid value: must be set to 0 or 1."
+ #endif
+ #ifndef NOS_CONFIG_HEAP_ENABLE
+  #error "nOSConfig.h: NOS_CONFIG_HEAP_ENABLE is not defined: must be set to 0 or 1."
+ #elif (NOS_CONFIG_HEAP_ENABLE != 0) && (NOS_CONFIG_HEAP_ENABLE != 1)
+  #error "nOSConfig.h: NOS_CONFIG_HEAP_ENABLE is set to invalid value: must be set to 0 or 1."
+ #elif (NOS_CONFIG_HEAP_ENABLE > 0)
+  #ifndef NOS_CONFIG_HEAP_FALLBACK_ENABLE
+   #error "nOSConfig.h: NOS_CONFIG_HEAP_FALLBACK_ENABLE is not defined: must be set to 0 or 1."
+  #elif (NOS_CONFIG_HEAP_FALLBACK_ENABLE != 0) && (NOS_CONFIG_HEAP_FALLBACK_ENABLE != 1)
+   #error "nOSConfig.h: NOS_CONFIG_HEAP_FALLBACK_ENABLE is set to invalid value: must be set to 0 or 1."
+  #endif
+ #else
+  #undef NOS_CONFIG_HEAP_FALLBACK_ENABLE
  #endif
 #else
  #undef NOS_CONFIG_MEM_DELETE_ENABLE
  #undef NOS_CONFIG_MEM_BLOCK_SIZE_WIDTH
  #undef NOS_CONFIG_MEM_BLOCK_COUNT_WIDTH
  #undef NOS_CONFIG_MEM_SANITY_CHECK_ENABLE
+ #undef NOS_CONFIG_MEM_BITMAP_ENABLE
+ #undef NOS_CONFIG_MEM_STATS_ENABLE
+ #undef NOS_CONFIG_MEM_CACHE_ENABLE
+ #undef NOS_CONFIG_HEAP_ENABLE
+ #define NOS_CONFIG_HEAP_ENABLE                 0
+ #undef NOS_CONFIG_HEAP_FALLBACK_ENABLE
+#endif
+
+#ifndef NOS_CONFIG_PROCESS_BATCH_SIZE
+ #error "nOSConfig.h: NOS_CONFIG_PROCESS_BATCH_SIZE is not defined: must be set between 1 and 32 inclusively."
+#elif (NOS_CONFIG_PROCESS_BATCH_SIZE < 1) || (NOS_CONFIG_PROCESS_BATCH_SIZE > 32)
+ #error "nOSConfig.h: NOS_CONFIG_PROCESS_BATCH_SIZE is set to invalid value: must be set between 1 and 32 inclusively."
 #endif
 
 #ifndef NOS_CONFIG_TIMER_ENABLE
@@ -323,9 +662,9 @@ extern "C" {
   #error "nOSConfig.h: NOS_CONFIG_TIMER_DELETE_ENABLE is set to invalid value: must be set to 0 or 1."
  #endif
  #ifndef NOS_CONFIG_TIMER_HIGHEST_PRIO
-  #error "nOSConfig.h: NOS_CONFIG_TIMER_HIGHEST_PRIO is not defined: must be set between 0 and 7 inclusively."
- #elif (NOS_CONFIG_TIMER_HIGHEST_PRIO < 0) || (NOS_CONFIG_TIMER_HIGHEST_PRIO > 7)
-  #error "nOSConfig.h: NOS_CONFIG_TIMER_HIGHEST_PRIO is set to invalid value: must be set between 0 and 7 inclusively."
+  #error "nOSConfig.h: NOS_CONFIG_TIMER_HIGHEST_PRIO is not defined: must be set between 0 and 255 inclusively."
+ #elif (NOS_CONFIG_TIMER_HIGHEST_PRIO < 0) || (NOS_CONFIG_TIMER_HIGHEST_PRIO > 255)
+  #error "nOSConfig.h: NOS_CONFIG_TIMER_HIGHEST_PRIO is set to invalid value: must be set between 0 and 255 inclusively."
  #endif
  #ifndef NOS_CONFIG_TIMER_THREAD_ENABLE
   #error "nOSConfig.h: NOS_CONFIG_TIMER_THREAD_ENABLE is not defined: must be set to 0 or 1."
@@ -346,15 +685,47 @@ extern "C" {
   #ifndef NOS_CONFIG_TIMER_THREAD_STACK_SIZE
    #error "nOSConfig.h: NOS_CONFIG_TIMER_THREAD_STACK_SIZE is not defined."
   #endif
+  #ifndef NOS_CONFIG_TIMER_THREAD_COUNT
+   #error "nOSConfig.h: NOS_CONFIG_TIMER_THREAD_COUNT is not defined: must be set between 1 and 8 inclusively."
+  #elif (NOS_CONFIG_TIMER_THREAD_COUNT < 1) || (NOS_CONFIG_TIMER_THREAD_COUNT > 8)
+   #error "nOSConfig.h: NOS_CONFIG_TIMER_THREAD_COUNT is set to invalid value: must be set between 1 and 8 inclusively."
+  #elif (NOS_CONFIG_TIMER_THREAD_COUNT > (NOS_CONFIG_TIMER_HIGHEST_PRIO + 1))
+   #error "nOSConfig.h: NOS_CONFIG_TIMER_THREAD_COUNT is higher than NOS_CONFIG_TIMER_HIGHEST_PRIO + 1: each timer thread need at least one timer priority."
+  #elif (NOS_CONFIG_TIMER_THREAD_COUNT > 1) && (NOS_CONFIG_HIGHEST_THREAD_PRIO == 0)
+   #error "nOSConfig.h: NOS_CONFIG_TIMER_THREAD_COUNT can't be higher than 1 when NOS_CONFIG_HIGHEST_THREAD_PRIO == 0 (cooperative scheduling)."
+  #elif (NOS_CONFIG_TIMER_THREAD_COUNT > 1) && ((NOS_CONFIG_TIMER_THREAD_PRIO + NOS_CONFIG_TIMER_THREAD_COUNT - 1) > NOS_CONFIG_HIGHEST_THREAD_PRIO)
+   #error "nOSConfig.h: NOS_CONFIG_TIMER_THREAD_PRIO + NOS_CONFIG_TIMER_THREAD_COUNT - 1 is higher than NOS_CONFIG_HIGHEST_THREAD_PRIO."
+  #endif
  #else
   #undef NOS_CONFIG_TIMER_THREAD_PRIO
   #undef NOS_CONFIG_TIMER_THREAD_STACK_SIZE
+  #undef NOS_CONFIG_TIMER_THREAD_COUNT
  #endif
  #ifndef NOS_CONFIG_TIMER_COUNT_WIDTH
   #error "nOSConfig.h: NOS_CONFIG_TIMER_COUNT_WIDTH is not defined: must be set to 8, 16, 32 or 64."
  #elif (NOS_CONFIG_TIMER_COUNT_WIDTH != 8) && (NOS_CONFIG_TIMER_COUNT_WIDTH != 16) && (NOS_CONFIG_TIMER_COUNT_WIDTH != 32) && (NOS_CONFIG_TIMER_COUNT_WIDTH != 64)
   #error "nOSConfig.h: NOS_CONFIG_TIMER_COUNT_WIDTH is set to invalid value: must be set to 8, 16, 32 or 64."
  #endif
+ #ifndef NOS_CONFIG_TIMER_WHEEL_ENABLE
+  #error "nOSConfig.h: NOS_CONFIG_TIMER_WHEEL_ENABLE is not defined: must be set to 0 or 1."
+ #elif (NOS_CONFIG_TIMER_WHEEL_ENABLE != 0) && (NOS_CONFIG_TIMER_WHEEL_ENABLE != 1)
+  #error "nOSConfig.h: NOS_CONFIG_TIMER_WHEEL_ENABLE is set to invalid value: must be set to 0 or 1."
+ #elif (NOS_CONFIG_TIMER_WHEEL_ENABLE > 0)
+  #ifndef NOS_CONFIG_TIMER_WHEEL_SIZE
+   #error "nOSConfig.h: NOS_CONFIG_TIMER_WHEEL_SIZE is not defined: must be a power of 2 between 2 and 1024 inclusively."
+  #elif (NOS_CONFIG_TIMER_WHEEL_SIZE < 2) || (NOS_CONFIG_TIMER_WHEEL_SIZE > 1024) || ((NOS_CONFIG_TIMER_WHEEL_SIZE & (NOS_CONFIG_TIMER_WHEEL_SIZE - 1)) != 0)
+   #error "nOSConfig.h: NOS_CONFIG_TIMER_WHEEL_SIZE is set to invalid value: must be a power of 2 between 2 and 1024 inclusively."
+  #endif
+ #else
+  #undef NOS_CONFIG_TIMER_WHEEL_SIZE
+ #endif
+ #ifndef NOS_CONFIG_TIMER_SLACK_ENABLE
+  #error "nOSConfig.h: NOS_CONFIG_TIMER_SLACK_ENABLE is not defined: must be set to 0 or 1."
+ #elif (NOS_CONFIG_TIMER_SLACK_ENABLE != 0) && (NOS_CONFIG_TIMER_SLACK_ENABLE != 1)
+  #error "nOSConfig.h: NOS_CONFIG_TIMER_SLACK_ENABLE is set to invalid value: must be set to 0 or 1."
+ #elif (NOS_CONFIG_TIMER_SLACK_ENABLE > 0) && (NOS_CONFIG_TIMER_WHEEL_ENABLE > 0)
+  #error "nOSConfig.h: NOS_CONFIG_TIMER_SLACK_ENABLE can't be used when NOS_CONFIG_TIMER_WHEEL_ENABLE is enabled."
+ #endif
 #else
  #undef NOS_CONFIG_TIMER_TICK_ENABLE
  #undef NOS_CONFIG_TIMER_DELETE_ENABLE
@@ -362,7 +733,25 @@ extern "C" {
  #undef NOS_CONFIG_TIMER_THREAD_ENABLE
  #undef NOS_CONFIG_TIMER_THREAD_PRIO
  #undef NOS_CONFIG_TIMER_THREAD_STACK_SIZE
+ #undef NOS_CONFIG_TIMER_THREAD_COUNT
  #undef NOS_CONFIG_TIMER_COUNT_WIDTH
+ #undef NOS_CONFIG_TIMER_WHEEL_ENABLE
+ #undef NOS_CONFIG_TIMER_WHEEL_SIZE
+ #undef NOS_CONFIG_TIMER_SLACK_ENABLE
+#endif
+
+#ifndef NOS_CONFIG_HRTIMER_ENABLE
+ #error "nOSConfig.h: NOS_CONFIG_HRTIMER_ENABLE is not defined: must be set to 0 or 1."
+#elif (NOS_CONFIG_HRTIMER_ENABLE != 0) && (NOS_CONFIG_HRTIMER_ENABLE != 1)
+ #error "nOSConfig.h: NOS_CONFIG_HRTIMER_ENABLE is set to invalid value: must be set to 0 or 1."
+#elif (NOS_CONFIG_HRTIMER_ENABLE > 0)
+ #ifndef NOS_CONFIG_HRTIMER_FREQUENCY
+  #error "nOSConfig.h: NOS_CONFIG_HRTIMER_FREQUENCY is not defined: must be higher than 0."
+ #elif (NOS_CONFIG_HRTIMER_FREQUENCY == 0)
+  #error "nOSConfig.h: NOS_CONFIG_HRTIMER_FREQUENCY is set to invalid value: must be higher than 0."
+ #endif
+#else
+ #undef NOS_CONFIG_HRTIMER_FREQUENCY
 #endif
 
 #ifndef NOS_CONFIG_SIGNAL_ENABLE
@@ -376,9 +765,14 @@ extern "C" {
   #error "nOSConfig.h: NOS_CONFIG_SIGNAL_DELETE_ENABLE is set to invalid value: must be set to 0 or 1."
  #endif
  #ifndef NOS_CONFIG_SIGNAL_HIGHEST_PRIO
-  #error "nOSConfig.h: NOS_CONFIG_SIGNAL_HIGHEST_PRIO is not defined: must be set between 0 and 7 inclusively."
- #elif (NOS_CONFIG_SIGNAL_HIGHEST_PRIO < 0) || (NOS_CONFIG_SIGNAL_HIGHEST_PRIO > 7)
-  #error "nOSConfig.h: NOS_CONFIG_SIGNAL_HIGHEST_PRIO is set to invalid value: must be set between 0 and 7 inclusively."
+  #error "nOSConfig.h: NOS_CONFIG_SIGNAL_HIGHEST_PRIO is not defined: must be set between 0 and 255 inclusively."
+ #elif (NOS_CONFIG_SIGNAL_HIGHEST_PRIO < 0) || (NOS_CONFIG_SIGNAL_HIGHEST_PRIO > 255)
+  #error "nOSConfig.h: NOS_CONFIG_SIGNAL_HIGHEST_PRIO is set to invalid value: must be set between 0 and 255 inclusively."
+ #endif
+ #ifndef NOS_CONFIG_SIGNAL_QUEUE_ENABLE
+  #error "nOSConfig.h: NOS_CONFIG_SIGNAL_QUEUE_ENABLE is not defined: must be set to 0 or 1."
+ #elif (NOS_CONFIG_SIGNAL_QUEUE_ENABLE != 0) && (NOS_CONFIG_SIGNAL_QUEUE_ENABLE != 1)
+  #error "nOSConfig.h: NOS_CONFIG_SIGNAL_QUEUE_ENABLE is set to invalid value: must be set to 0 or 1."
  #endif
  #ifndef NOS_CONFIG_SIGNAL_THREAD_ENABLE
   #error "nOSConfig.h: NOS_CONFIG_SIGNAL_THREAD_ENABLE is not defined: must be set to 0 or 1."
@@ -406,6 +800,7 @@ extern "C" {
 #else
  #undef NOS_CONFIG_SIGNAL_DELETE_ENABLE
  #undef NOS_CONFIG_SIGNAL_HIGHEST_PRIO
+ #undef NOS_CONFIG_SIGNAL_QUEUE_ENABLE
  #undef NOS_CONFIG_SIGNAL_THREAD_ENABLE
  #undef NOS_CONFIG_SIGNAL_THREAD_PRIO
  #undef NOS_CONFIG_SIGNAL_THREAD_STACK_SIZE
@@ -440,11 +835,23 @@ extern "C" {
  #elif (NOS_CONFIG_TIME_COUNT_WIDTH != 32) && (NOS_CONFIG_TIME_COUNT_WIDTH != 64)
   #error "nOSConfig.h: NOS_CONFIG_TIME_COUNT_WIDTH is set to invalid value: must be set to 32 or 64."
  #endif
+ #ifndef NOS_CONFIG_TIME_DATE_CACHE_ENABLE
+  #error "nOSConfig.h: NOS_CONFIG_TIME_DATE_CACHE_ENABLE is not defined: must be set to 0 or 1."
+ #elif (NOS_CONFIG_TIME_DATE_CACHE_ENABLE != 0) && (NOS_CONFIG_TIME_DATE_CACHE_ENABLE != 1)
+  #error "nOSConfig.h: NOS_CONFIG_TIME_DATE_CACHE_ENABLE is set to invalid value: must be set to 0 or 1."
+ #endif
+ #ifndef NOS_CONFIG_TIME_PRECISE_ENABLE
+  #error "nOSConfig.h: NOS_CONFIG_TIME_PRECISE_ENABLE is not defined: must be set to 0 or 1."
+ #elif (NOS_CONFIG_TIME_PRECISE_ENABLE != 0) && (NOS_CONFIG_TIME_PRECISE_ENABLE != 1)
+  #error "nOSConfig.h: NOS_CONFIG_TIME_PRECISE_ENABLE is set to invalid value: must be set to 0 or 1."
+ #endif
 #else
  #undef NOS_CONFIG_TIME_TICK_ENABLE
  #undef NOS_CONFIG_TIME_WAIT_ENABLE
  #undef NOS_CONFIG_TIME_TICKS_PER_SECOND
  #undef NOS_CONFIG_TIME_COUNT_WIDTH
+ #undef NOS_CONFIG_TIME_DATE_CACHE_ENABLE
+ #undef NOS_CONFIG_TIME_PRECISE_ENABLE
 #endif
 
 #ifndef NOS_CONFIG_ALARM_ENABLE
@@ -510,11 +917,262 @@ extern "C" {
  #undef NOS_CONFIG_BARRIER_DELETE_ENABLE
 #endif
 
+#ifndef NOS_CONFIG_WORKQUEUE_ENABLE
+ #error "nOSConfig.h: NOS_CONFIG_WORKQUEUE_ENABLE is not defined: must be set to 0 or 1."
+#elif (NOS_CONFIG_WORKQUEUE_ENABLE != 0) && (NOS_CONFIG_WORKQUEUE_ENABLE != 1)
+ #error "nOSConfig.h: NOS_CONFIG_WORKQUEUE_ENABLE is set to invalid value: must be set to 0 or 1."
+#elif (NOS_CONFIG_WORKQUEUE_ENABLE > 0)
+ #ifndef NOS_CONFIG_WORKQUEUE_DELETE_ENABLE
+  #error "nOSConfig.h: NOS_CONFIG_WORKQUEUE_DELETE_ENABLE is not defined: must be set to 0 or 1."
+ #elif (NOS_CONFIG_WORKQUEUE_DELETE_ENABLE != 0) && (NOS_CONFIG_WORKQUEUE_DELETE_ENABLE != 1)
+  #error "nOSConfig.h: NOS_CONFIG_WORKQUEUE_DELETE_ENABLE is set to invalid value: must be set to 0 or 1."
+ #endif
+#else
+ #undef NOS_CONFIG_WORKQUEUE_DELETE_ENABLE
+#endif
+
+#ifndef NOS_CONFIG_TOPIC_ENABLE
+ #error "nOSConfig.h: NOS_CONFIG_TOPIC_ENABLE is not defined: must be set to 0 or 1."
+#elif (NOS_CONFIG_TOPIC_ENABLE != 0) && (NOS_CONFIG_TOPIC_ENABLE != 1)
+ #error "nOSConfig.h: NOS_CONFIG_TOPIC_ENABLE is set to invalid value: must be set to 0 or 1."
+#elif (NOS_CONFIG_TOPIC_ENABLE > 0)
+ #ifndef NOS_CONFIG_TOPIC_DELETE_ENABLE
+  #error "nOSConfig.h: NOS_CONFIG_TOPIC_DELETE_ENABLE is not defined: must be set to 0 or 1."
+ #elif (NOS_CONFIG_TOPIC_DELETE_ENABLE != 0) && (NOS_CONFIG_TOPIC_DELETE_ENABLE != 1)
+  #error "nOSConfig.h: NOS_CONFIG_TOPIC_DELETE_ENABLE is set to invalid value: must be set to 0 or 1."
+ #endif
+#else
+ #undef NOS_CONFIG_TOPIC_DELETE_ENABLE
+#endif
+
+#ifndef NOS_CONFIG_IO_ENABLE
+ #error "nOSConfig.h: NOS_CONFIG_IO_ENABLE is not defined: must be set to 0 or 1."
+#elif (NOS_CONFIG_IO_ENABLE != 0) && (NOS_CONFIG_IO_ENABLE != 1)
+ #error "nOSConfig.h: NOS_CONFIG_IO_ENABLE is set to invalid value: must be set to 0 or 1."
+#endif
+
+#ifndef NOS_CONFIG_TASK_ENABLE
+ #error "nOSConfig.h: NOS_CONFIG_TASK_ENABLE is not defined: must be set to 0 or 1."
+#elif (NOS_CONFIG_TASK_ENABLE != 0) && (NOS_CONFIG_TASK_ENABLE != 1)
+ #error "nOSConfig.h: NOS_CONFIG_TASK_ENABLE is set to invalid value: must be set to 0 or 1."
+#elif (NOS_CONFIG_TASK_ENABLE > 0)
+ #ifndef NOS_CONFIG_TASK_DELETE_ENABLE
+  #error "nOSConfig.h: NOS_CONFIG_TASK_DELETE_ENABLE is not defined: must be set to 0 or 1."
+ #elif (NOS_CONFIG_TASK_DELETE_ENABLE != 0) && (NOS_CONFIG_TASK_DELETE_ENABLE != 1)
+  #error "nOSConfig.h: NOS_CONFIG_TASK_DELETE_ENABLE is set to invalid value: must be set to 0 or 1."
+ #endif
+ #ifndef NOS_CONFIG_TASK_THREAD_ENABLE
+  #error "nOSConfig.h: NOS_CONFIG_TASK_THREAD_ENABLE is not defined: must be set to 0 or 1."
+ #elif (NOS_CONFIG_TASK_THREAD_ENABLE != 0) && (NOS_CONFIG_TASK_THREAD_ENABLE != 1)
+  #error "nOSConfig.h: NOS_CONFIG_TASK_THREAD_ENABLE is set to invalid value: must be set to 0 or 1."
+ #elif (NOS_CONFIG_TASK_THREAD_ENABLE > 0)
+  #if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
+   #ifndef NOS_CONFIG_TASK_THREAD_PRIO
+    #error "nOSConfig.h: NOS_CONFIG_TASK_THREAD_PRIO is not defined: must be set between 0 and NOS_CONFIG_HIGHEST_THREAD_PRIO inclusively."
+   #elif (NOS_CONFIG_TASK_THREAD_PRIO < 0)
+    #error "nOSConfig.h: NOS_CONFIG_TASK_THREAD_PRIO is set to invalid value: must be set between 0 and NOS_CONFIG_HIGHEST_THREAD_PRIO inclusively."
+   #elif (NOS_CONFIG_TASK_THREAD_PRIO > NOS_CONFIG_HIGHEST_THREAD_PRIO)
+    #error "nOSConfig.h: NOS_CONFIG_TASK_THREAD_PRIO is higher than NOS_CONFIG_HIGHEST_THREAD_PRIO: must be set between 0 and NOS_CONFIG_HIGHEST_THREAD_PRIO inclusively."
+   #endif
+  #else
+   #undef NOS_CONFIG_TASK_THREAD_PRIO
+  #endif
+  #ifndef NOS_CONFIG_TASK_THREAD_STACK_SIZE
+   #error "nOSConfig.h: NOS_CONFIG_TASK_THREAD_STACK_SIZE is not defined."
+  #endif
+ #else
+  #undef NOS_CONFIG_TASK_THREAD_PRIO
+  #undef NOS_CONFIG_TASK_THREAD_STACK_SIZE
+ #endif
+#else
+ #undef NOS_CONFIG_TASK_DELETE_ENABLE
+ #undef NOS_CONFIG_TASK_THREAD_ENABLE
+ #undef NOS_CONFIG_TASK_THREAD_PRIO
+ #undef NOS_CONFIG_TASK_THREAD_STACK_SIZE
+#endif
+
+#ifndef NOS_CONFIG_JOB_ENABLE
+ #error "nOSConfig.h: NOS_CONFIG_JOB_ENABLE is not defined: must be set to 0 or 1."
+#elif (NOS_CONFIG_JOB_ENABLE != 0) && (NOS_CONFIG_JOB_ENABLE != 1)
+ #error "nOSConfig.h: NOS_CONFIG_JOB_ENABLE is set to invalid value: must be set to 0 or 1."
+#elif (NOS_CONFIG_JOB_ENABLE > 0)
+ #ifndef NOS_CONFIG_JOB_DELETE_ENABLE
+  #error "nOSConfig.h: NOS_CONFIG_JOB_DELETE_ENABLE is not defined: must be set to 0 or 1."
+ #elif (NOS_CONFIG_JOB_DELETE_ENABLE != 0) && (NOS_CONFIG_JOB_DELETE_ENABLE != 1)
+  #error "nOSConfig.h: NOS_CONFIG_JOB_DELETE_ENABLE is set to invalid value: must be set to 0 or 1."
+ #endif
+ #ifndef NOS_CONFIG_JOB_HIGHEST_PRIO
+  #error "nOSConfig.h: NOS_CONFIG_JOB_HIGHEST_PRIO is not defined: must be set between 0 and 7 inclusively."
+ #elif (NOS_CONFIG_JOB_HIGHEST_PRIO < 0) || (NOS_CONFIG_JOB_HIGHEST_PRIO > 7)
+  #error "nOSConfig.h: NOS_CONFIG_JOB_HIGHEST_PRIO is set to invalid value: must be set between 0 and 7 inclusively."
+ #endif
+ #if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
+  #ifndef NOS_CONFIG_JOB_THREAD_PRIO
+   #error "nOSConfig.h: NOS_CONFIG_JOB_THREAD_PRIO is not defined: must be set between 0 and NOS_CONFIG_HIGHEST_THREAD_PRIO inclusively."
+  #elif (NOS_CONFIG_JOB_THREAD_PRIO < 0)
+   #error "nOSConfig.h: NOS_CONFIG_JOB_THREAD_PRIO is set to invalid value: must be set between 0 and NOS_CONFIG_HIGHEST_THREAD_PRIO inclusively."
+  #elif (NOS_CONFIG_JOB_THREAD_PRIO > NOS_CONFIG_HIGHEST_THREAD_PRIO)
+   #error "nOSConfig.h: NOS_CONFIG_JOB_THREAD_PRIO is higher than NOS_CONFIG_HIGHEST_THREAD_PRIO: must be set between 0 and NOS_CONFIG_HIGHEST_THREAD_PRIO inclusively."
+  #endif
+ #else
+  #undef NOS_CONFIG_JOB_THREAD_PRIO
+ #endif
+ #ifndef NOS_CONFIG_JOB_THREAD_STACK_SIZE
+  #error "nOSConfig.h: NOS_CONFIG_JOB_THREAD_STACK_SIZE is not defined."
+ #endif
+#else
+ #undef NOS_CONFIG_JOB_DELETE_ENABLE
+ #undef NOS_CONFIG_JOB_HIGHEST_PRIO
+ #undef NOS_CONFIG_JOB_THREAD_PRIO
+ #undef NOS_CONFIG_JOB_THREAD_STACK_SIZE
+#endif
+
+#ifndef NOS_CONFIG_ACTIVE_ENABLE
+ #error "nOSConfig.h: NOS_CONFIG_ACTIVE_ENABLE is not defined: must be set to 0 or 1."
+#elif (NOS_CONFIG_ACTIVE_ENABLE != 0) && (NOS_CONFIG_ACTIVE_ENABLE != 1)
+ #error "nOSConfig.h: NOS_CONFIG_ACTIVE_ENABLE is set to invalid value: must be set to 0 or 1."
+#elif (NOS_CONFIG_ACTIVE_ENABLE > 0) && (NOS_CONFIG_JOB_ENABLE == 0)
+ #error "nOSConfig.h: NOS_CONFIG_ACTIVE_ENABLE can't be used when NOS_CONFIG_JOB_ENABLE == 0."
+#elif (NOS_CONFIG_ACTIVE_ENABLE > 0)
+ #ifndef NOS_CONFIG_ACTIVE_DELETE_ENABLE
+  #error "nOSConfig.h: NOS_CONFIG_ACTIVE_DELETE_ENABLE is not defined: must be set to 0 or 1."
+ #elif (NOS_CONFIG_ACTIVE_DELETE_ENABLE != 0) && (NOS_CONFIG_ACTIVE_DELETE_ENABLE != 1)
+  #error "nOSConfig.h: NOS_CONFIG_ACTIVE_DELETE_ENABLE is set to invalid value: must be set to 0 or 1."
+ #elif (NOS_CONFIG_ACTIVE_DELETE_ENABLE > 0) && (NOS_CONFIG_JOB_DELETE_ENABLE == 0)
+  #error "nOSConfig.h: NOS_CONFIG_ACTIVE_DELETE_ENABLE can't be used when NOS_CONFIG_JOB_DELETE_ENABLE == 0."
+ #endif
+#else
+ #undef NOS_CONFIG_ACTIVE_DELETE_ENABLE
+#endif
+
+#ifndef NOS_CONFIG_THREAD_FPU_ENABLE
+ #error "nOSConfig.h: NOS_CONFIG_THREAD_FPU_ENABLE is not defined: must be set to 0 or 1."
+#elif (NOS_CONFIG_THREAD_FPU_ENABLE != 0) && (NOS_CONFIG_THREAD_FPU_ENABLE != 1)
+ #error "nOSConfig.h: NOS_CONFIG_THREAD_FPU_ENABLE is set to invalid value: must be set to 0 or 1."
+#endif
+
+#ifndef NOS_CONFIG_CYCLE_COUNTER_ENABLE
+ #error "nOSConfig.h: NOS_CONFIG_CYCLE_COUNTER_ENABLE is not defined: must be set to 0 or 1."
+#elif (NOS_CONFIG_CYCLE_COUNTER_ENABLE != 0) && (NOS_CONFIG_CYCLE_COUNTER_ENABLE != 1)
+ #error "nOSConfig.h: NOS_CONFIG_CYCLE_COUNTER_ENABLE is set to invalid value: must be set to 0 or 1."
+#endif
+
+#ifndef NOS_CONFIG_THREAD_STATS_ENABLE
+ #error "nOSConfig.h: NOS_CONFIG_THREAD_STATS_ENABLE is not defined: must be set to 0 or 1."
+#elif (NOS_CONFIG_THREAD_STATS_ENABLE != 0) && (NOS_CONFIG_THREAD_STATS_ENABLE != 1)
+ #error "nOSConfig.h: NOS_CONFIG_THREAD_STATS_ENABLE is set to invalid value: must be set to 0 or 1."
+#elif (NOS_CONFIG_THREAD_STATS_ENABLE > 0) && (NOS_CONFIG_CYCLE_COUNTER_ENABLE == 0)
+ #error "nOSConfig.h: NOS_CONFIG_THREAD_STATS_ENABLE can't be used when NOS_CONFIG_CYCLE_COUNTER_ENABLE == 0."
+#endif
+
+#ifndef NOS_CONFIG_CRITICAL_PROFILE_ENABLE
+ #error "nOSConfig.h: NOS_CONFIG_CRITICAL_PROFILE_ENABLE is not defined: must be set to 0 or 1."
+#elif (NOS_CONFIG_CRITICAL_PROFILE_ENABLE != 0) && (NOS_CONFIG_CRITICAL_PROFILE_ENABLE != 1)
+ #error "nOSConfig.h: NOS_CONFIG_CRITICAL_PROFILE_ENABLE is set to invalid value: must be set to 0 or 1."
+#elif (NOS_CONFIG_CRITICAL_PROFILE_ENABLE > 0) && (NOS_CONFIG_CYCLE_COUNTER_ENABLE == 0)
+ #error "nOSConfig.h: NOS_CONFIG_CRITICAL_PROFILE_ENABLE can't be used when NOS_CONFIG_CYCLE_COUNTER_ENABLE == 0."
+#elif (NOS_CONFIG_CRITICAL_PROFILE_ENABLE > 0) && (NOS_CONFIG_SMP_CORE_COUNT > 1)
+ #error "nOSConfig.h: NOS_CONFIG_CRITICAL_PROFILE_ENABLE can't be used when NOS_CONFIG_SMP_CORE_COUNT is higher than 1."
+#elif (NOS_CONFIG_CRITICAL_PROFILE_ENABLE > 0)
+ #ifndef NOS_CONFIG_CRITICAL_PROFILE_SITES
+  #error "nOSConfig.h: NOS_CONFIG_CRITICAL_PROFILE_SITES is not defined: must be set between 1 and 255 inclusively."
+ #elif (NOS_CONFIG_CRITICAL_PROFILE_SITES < 1) || (NOS_CONFIG_CRITICAL_PROFILE_SITES > 255)
+  #error "nOSConfig.h: NOS_CONFIG_CRITICAL_PROFILE_SITES is set to invalid value: must be set between 1 and 255 inclusively."
+ #endif
+#else
+ #undef NOS_CONFIG_CRITICAL_PROFILE_SITES
+#endif
+
+#ifndef NOS_CONFIG_THREAD_STACK_USAGE_ENABLE
+ #error "nOSConfig.h: NOS_CONFIG_THREAD_STACK_USAGE_ENABLE is not defined: must be set to 0 or 1."
+#elif (NOS_CONFIG_THREAD_STACK_USAGE_ENABLE != 0) && (NOS_CONFIG_THREAD_STACK_USAGE_ENABLE != 1)
+ #error "nOSConfig.h: NOS_CONFIG_THREAD_STACK_USAGE_ENABLE is set to invalid value: must be set to 0 or 1."
+#elif (NOS_CONFIG_THREAD_STACK_USAGE_ENABLE > 0)
+ #ifndef NOS_CONFIG_THREAD_STACK_SCAN_WORDS
+  #error "nOSConfig.h: NOS_CONFIG_THREAD_STACK_SCAN_WORDS is not defined: must be higher than 0."
+ #elif (NOS_CONFIG_THREAD_STACK_SCAN_WORDS == 0)
+  #error "nOSConfig.h: NOS_CONFIG_THREAD_STACK_SCAN_WORDS is set to invalid value: must be higher than 0."
+ #endif
+#endif
+
+#ifndef NOS_CONFIG_TRACE_ENABLE
+ #error "nOSConfig.h: NOS_CONFIG_TRACE_ENABLE is not defined: must be set to 0 or 1."
+#elif (NOS_CONFIG_TRACE_ENABLE != 0) && (NOS_CONFIG_TRACE_ENABLE != 1)
+ #error "nOSConfig.h: NOS_CONFIG_TRACE_ENABLE is set to invalid value: must be set to 0 or 1."
+#elif (NOS_CONFIG_TRACE_ENABLE > 0)
+ #ifndef NOS_CONFIG_TRACE_BUFFER_SIZE
+  #error "nOSConfig.h: NOS_CONFIG_TRACE_BUFFER_SIZE is not defined: must be higher than 0."
+ #elif (NOS_CONFIG_TRACE_BUFFER_SIZE == 0)
+  #error "nOSConfig.h: NOS_CONFIG_TRACE_BUFFER_SIZE is set to invalid value: must be higher than 0."
+ #endif
+#endif
+
+#ifndef NOS_CONFIG_LOG_ENABLE
+ #error "nOSConfig.h: NOS_CONFIG_LOG_ENABLE is not defined: must be set to 0 or 1."
+#elif (NOS_CONFIG_LOG_ENABLE != 0) && (NOS_CONFIG_LOG_ENABLE != 1)
+ #error "nOSConfig.h: NOS_CONFIG_LOG_ENABLE is set to invalid value: must be set to 0 or 1."
+#elif (NOS_CONFIG_LOG_ENABLE > 0)
+ #ifndef NOS_CONFIG_LOG_BUFFER_SIZE
+  #error "nOSConfig.h: NOS_CONFIG_LOG_BUFFER_SIZE is not defined: must be a power of 2 between 2 and 32768 inclusively."
+ #elif (NOS_CONFIG_LOG_BUFFER_SIZE < 2) || (NOS_CONFIG_LOG_BUFFER_SIZE > 32768) || ((NOS_CONFIG_LOG_BUFFER_SIZE & (NOS_CONFIG_LOG_BUFFER_SIZE - 1)) != 0)
+  #error "nOSConfig.h: NOS_CONFIG_LOG_BUFFER_SIZE is set to invalid value: must be a power of 2 between 2 and 32768 inclusively."
+ #endif
+ #ifndef NOS_CONFIG_LOG_THREAD_ENABLE
+  #error "nOSConfig.h: NOS_CONFIG_LOG_THREAD_ENABLE is not defined: must be set to 0 or 1."
+ #elif (NOS_CONFIG_LOG_THREAD_ENABLE != 0) && (NOS_CONFIG_LOG_THREAD_ENABLE != 1)
+  #error "nOSConfig.h: NOS_CONFIG_LOG_THREAD_ENABLE is set to invalid value: must be set to 0 or 1."
+ #elif (NOS_CONFIG_LOG_THREAD_ENABLE > 0) && (NOS_CONFIG_SLEEP_ENABLE == 0)
+  #error "nOSConfig.h: NOS_CONFIG_LOG_THREAD_ENABLE can't be used when NOS_CONFIG_SLEEP_ENABLE == 0."
+ #elif (NOS_CONFIG_LOG_THREAD_ENABLE > 0)
+  #if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
+   #ifndef NOS_CONFIG_LOG_THREAD_PRIO
+    #error "nOSConfig.h: NOS_CONFIG_LOG_THREAD_PRIO is not defined: must be set between 0 and NOS_CONFIG_HIGHEST_THREAD_PRIO inclusively."
+   #elif (NOS_CONFIG_LOG_THREAD_PRIO < 0)
+    #error "nOSConfig.h: NOS_CONFIG_LOG_THREAD_PRIO is set to invalid value: must be set between 0 and NOS_CONFIG_HIGHEST_THREAD_PRIO inclusively."
+   #elif (NOS_CONFIG_LOG_THREAD_PRIO > NOS_CONFIG_HIGHEST_THREAD_PRIO)
+    #error "nOSConfig.h: NOS_CONFIG_LOG_THREAD_PRIO is higher than NOS_CONFIG_HIGHEST_THREAD_PRIO: must be set between 0 and NOS_CONFIG_HIGHEST_THREAD_PRIO inclusively."
+   #endif
+  #else
+   #undef NOS_CONFIG_LOG_THREAD_PRIO
+  #endif
+  #ifndef NOS_CONFIG_LOG_THREAD_PERIOD
+   #error "nOSConfig.h: NOS_CONFIG_LOG_THREAD_PERIOD is not defined: must be higher than 0."
+  #elif (NOS_CONFIG_LOG_THREAD_PERIOD == 0)
+   #error "nOSConfig.h: NOS_CONFIG_LOG_THREAD_PERIOD is set to invalid value: must be higher than 0."
+  #endif
+  #ifndef NOS_CONFIG_LOG_THREAD_STACK_SIZE
+   #error "nOSConfig.h: NOS_CONFIG_LOG_THREAD_STACK_SIZE is not defined."
+  #endif
+ #else
+  #undef NOS_CONFIG_LOG_THREAD_PRIO
+  #undef NOS_CONFIG_LOG_THREAD_PERIOD
+  #undef NOS_CONFIG_LOG_THREAD_STACK_SIZE
+ #endif
+#else
+ #undef NOS_CONFIG_LOG_BUFFER_SIZE
+ #undef NOS_CONFIG_LOG_THREAD_ENABLE
+ #undef NOS_CONFIG_LOG_THREAD_PRIO
+ #undef NOS_CONFIG_LOG_THREAD_PERIOD
+ #undef NOS_CONFIG_LOG_THREAD_STACK_SIZE
+#endif
+
+#ifndef NOS_CONFIG_SELECT_ENABLE
+ #error "nOSConfig.h: NOS_CONFIG_SELECT_ENABLE is not defined: must be set to 0 or 1."
+#elif (NOS_CONFIG_SELECT_ENABLE != 0) && (NOS_CONFIG_SELECT_ENABLE != 1)
+ #error "nOSConfig.h: NOS_CONFIG_SELECT_ENABLE is set to invalid value: must be set to 0 or 1."
+#endif
+
 typedef void(*nOS_Callback)(void);
 typedef struct nOS_List             nOS_List;
 typedef struct nOS_Node             nOS_Node;
 typedef void(*nOS_NodeHandler)(void*,void*);
+#if (NOS_CONFIG_CRITICAL_WALK_LIMIT > 0)
+ typedef struct nOS_ListWalk        nOS_ListWalk;
+#endif
 typedef struct nOS_Thread           nOS_Thread;
+#if (NOS_CONFIG_THREAD_STATS_ENABLE > 0)
+ typedef struct nOS_ThreadStats     nOS_ThreadStats;
+#endif
 #if (NOS_CONFIG_THREAD_JOIN_ENABLE > 0)
  typedef int(*nOS_ThreadEntry)(void*);
 #else
@@ -530,6 +1188,14 @@ typedef struct nOS_Event            nOS_Event;
 #elif (NOS_CONFIG_TICK_COUNT_WIDTH == 64)
  typedef uint64_t                   nOS_TickCounter;
 #endif
+#if (NOS_CONFIG_HRTIMER_ENABLE > 0)
+ typedef struct nOS_HrTimer         nOS_HrTimer;
+ typedef void(*nOS_HrTimerCallback)(nOS_HrTimer*,void*);
+#endif
+#if (NOS_CONFIG_THREAD_PERIODIC_ENABLE > 0)
+ typedef struct nOS_PeriodicStats   nOS_PeriodicStats;
+ typedef void(*nOS_PeriodicCallback)(nOS_Thread*,nOS_TickCounter);
+#endif
 #if (NOS_CONFIG_SEM_ENABLE > 0)
  typedef struct nOS_Sem             nOS_Sem;
  #if (NOS_CONFIG_SEM_COUNT_WIDTH == 8)
@@ -554,6 +1220,16 @@ typedef struct nOS_Event            nOS_Event;
   typedef uint64_t                  nOS_MutexCounter;
  #endif
 #endif
+#if (NOS_CONFIG_RWLOCK_ENABLE > 0)
+ typedef struct nOS_RWLock          nOS_RWLock;
+ #if (NOS_CONFIG_RWLOCK_COUNT_WIDTH == 8)
+  typedef uint8_t                   nOS_RWLockCounter;
+ #elif (NOS_CONFIG_RWLOCK_COUNT_WIDTH == 16)
+  typedef uint16_t                  nOS_RWLockCounter;
+ #elif (NOS_CONFIG_RWLOCK_COUNT_WIDTH == 32)
+  typedef uint32_t                  nOS_RWLockCounter;
+ #endif
+#endif
 #if (NOS_CONFIG_QUEUE_ENABLE > 0)
  typedef struct nOS_Queue           nOS_Queue;
  #if (NOS_CONFIG_QUEUE_BLOCK_COUNT_WIDTH == 8)
@@ -565,8 +1241,41 @@ typedef struct nOS_Event            nOS_Event;
  #elif (NOS_CONFIG_QUEUE_BLOCK_COUNT_WIDTH == 64)
   typedef uint64_t                  nOS_QueueCounter;
  #endif
+ #if (NOS_CONFIG_QUEUE_BLOCK_SIZE_WIDTH == 8)
+  typedef uint8_t                   nOS_QueueSize;
+ #elif (NOS_CONFIG_QUEUE_BLOCK_SIZE_WIDTH == 16)
+  typedef uint16_t                  nOS_QueueSize;
+ #elif (NOS_CONFIG_QUEUE_BLOCK_SIZE_WIDTH == 32)
+  typedef uint32_t                  nOS_QueueSize;
+ #elif (NOS_CONFIG_QUEUE_BLOCK_SIZE_WIDTH == 64)
+  typedef uint64_t                  nOS_QueueSize;
+ #endif
  typedef void(*nOS_QueueCallback)(nOS_Queue*,void*);
 #endif
+#if (NOS_CONFIG_STREAM_ENABLE > 0)
+ typedef struct nOS_Stream          nOS_Stream;
+ #if (NOS_CONFIG_STREAM_COUNT_WIDTH == 8)
+  typedef uint8_t                   nOS_StreamCounter;
+ #elif (NOS_CONFIG_STREAM_COUNT_WIDTH == 16)
+  typedef uint16_t                  nOS_StreamCounter;
+ #elif (NOS_CONFIG_STREAM_COUNT_WIDTH == 32)
+  typedef uint32_t                  nOS_StreamCounter;
+ #endif
+#endif
+#if (NOS_CONFIG_MBOX_ENABLE > 0)
+ typedef struct nOS_Mbox            nOS_Mbox;
+ #if (NOS_CONFIG_MBOX_COUNT_WIDTH == 8)
+  typedef uint8_t                   nOS_MboxCounter;
+ #elif (NOS_CONFIG_MBOX_COUNT_WIDTH == 16)
+  typedef uint16_t                  nOS_MboxCounter;
+ #elif (NOS_CONFIG_MBOX_COUNT_WIDTH == 32)
+  typedef uint32_t                  nOS_MboxCounter;
+ #endif
+ typedef void(*nOS_MboxCallback)(nOS_Mbox*,void*);
+#endif
+#if (NOS_CONFIG_MSGQUEUE_ENABLE > 0)
+ typedef struct nOS_MsgQueue        nOS_MsgQueue;
+#endif
 #if (NOS_CONFIG_FLAG_ENABLE > 0)
  typedef struct nOS_Flag            nOS_Flag;
  typedef struct nOS_FlagContext     nOS_FlagContext;
@@ -600,6 +1309,16 @@ typedef struct nOS_Event            nOS_Event;
  #elif (NOS_CONFIG_MEM_BLOCK_COUNT_WIDTH == 64)
   typedef uint64_t                  nOS_MemCounter;
  #endif
+ #if (NOS_CONFIG_MEM_STATS_ENABLE > 0)
+  typedef struct nOS_MemStats       nOS_MemStats;
+ #endif
+ #if (NOS_CONFIG_MEM_CACHE_ENABLE > 0)
+  typedef struct nOS_MemCache       nOS_MemCache;
+ #endif
+ #if (NOS_CONFIG_HEAP_ENABLE > 0)
+  typedef struct nOS_Heap           nOS_Heap;
+  typedef struct nOS_HeapClass      nOS_HeapClass;
+ #endif
 #endif
 #if (NOS_CONFIG_TIMER_ENABLE > 0)
  typedef struct nOS_Timer           nOS_Timer;
@@ -625,6 +1344,9 @@ typedef struct nOS_Event            nOS_Event;
   typedef uint64_t                  nOS_Time;
  #endif
  typedef struct nOS_TimeDate        nOS_TimeDate;
+ #if (NOS_CONFIG_TIME_PRECISE_ENABLE > 0)
+  typedef struct nOS_TimePrecise    nOS_TimePrecise;
+ #endif
 #endif
 #if (NOS_CONFIG_ALARM_ENABLE > 0)
  typedef struct nOS_Alarm           nOS_Alarm;
@@ -633,6 +1355,51 @@ typedef struct nOS_Event            nOS_Event;
 #if (NOS_CONFIG_BARRIER_ENABLE > 0)
  typedef struct nOS_Barrier         nOS_Barrier;
 #endif
+#if (NOS_CONFIG_WORKQUEUE_ENABLE > 0)
+ typedef struct nOS_WorkQueue       nOS_WorkQueue;
+ typedef struct nOS_Work            nOS_Work;
+ typedef void(*nOS_WorkCallback)(void*,uint32_t,uint32_t);
+#endif
+#if (NOS_CONFIG_TOPIC_ENABLE > 0)
+ typedef struct nOS_Topic           nOS_Topic;
+ typedef struct nOS_Subscriber      nOS_Subscriber;
+#endif
+#if (NOS_CONFIG_IO_ENABLE > 0)
+ typedef struct nOS_IoDevice        nOS_IoDevice;
+ typedef struct nOS_IoRequest       nOS_IoRequest;
+ typedef struct nOS_IoBuffer        nOS_IoBuffer;
+ typedef void(*nOS_IoStart)(nOS_IoDevice*,nOS_IoRequest*);
+#endif
+#if (NOS_CONFIG_TASK_ENABLE > 0)
+ typedef struct nOS_Task            nOS_Task;
+ typedef uint16_t                   nOS_TaskLine;
+#endif
+#if (NOS_CONFIG_JOB_ENABLE > 0)
+ typedef struct nOS_Job             nOS_Job;
+ typedef void(*nOS_JobHandler)(nOS_Job*,void*);
+#endif
+#if (NOS_CONFIG_ACTIVE_ENABLE > 0)
+ typedef struct nOS_Active          nOS_Active;
+ typedef void(*nOS_ActiveHandler)(nOS_Active*,void*);
+#endif
+#if (NOS_CONFIG_SELECT_ENABLE > 0)
+ typedef struct nOS_SelectItem      nOS_SelectItem;
+ typedef struct nOS_SelectContext   nOS_SelectContext;
+#endif
+#if (NOS_CONFIG_TRACE_ENABLE > 0)
+ typedef struct nOS_TraceRecord     nOS_TraceRecord;
+#endif
+#if (NOS_CONFIG_CRITICAL_PROFILE_ENABLE > 0)
+ typedef struct nOS_CriticalSite    nOS_CriticalSite;
+#endif
+#if (NOS_CONFIG_POWER_ENABLE > 0)
+ typedef struct nOS_PowerMode       nOS_PowerMode;
+ typedef struct nOS_PowerRequest    nOS_PowerRequest;
+#endif
+#if (NOS_CONFIG_LOG_ENABLE > 0)
+ typedef size_t                     nOS_LogArg;
+ typedef struct nOS_LogRecord       nOS_LogRecord;
+#endif
 
 typedef enum nOS_Error
 {
@@ -676,12 +1443,25 @@ typedef enum nOS_ThreadState
     NOS_THREAD_WAITING_TIME     = 0x08,
     NOS_THREAD_ON_BARRIER       = 0x09,
     NOS_THREAD_JOINING          = 0x0A,
-    NOS_THREAD_ON_HOLD          = 0x0F,
-    NOS_THREAD_WAITING_MASK     = 0x0F,
-    NOS_THREAD_FINISHED         = 0x10,
-    NOS_THREAD_WAIT_TIMEOUT     = 0x20,
-    NOS_THREAD_SUSPENDED        = 0x40,
-    NOS_THREAD_READY            = 0x80
+    NOS_THREAD_RESERVING_QUEUE  = 0x0B,
+    NOS_THREAD_ACQUIRING_QUEUE  = 0x0C,
+    NOS_THREAD_READING_STREAM   = 0x0D,
+    NOS_THREAD_SELECTING        = 0x0E,
+    NOS_THREAD_LOCKING_RWLOCK   = 0x0F,
+    NOS_THREAD_READING_MBOX     = 0x10,
+    NOS_THREAD_WRITING_MBOX     = 0x11,
+    NOS_THREAD_READING_MSGQUEUE = 0x12,
+    NOS_THREAD_WAITING_WORK     = 0x13,
+    NOS_THREAD_JOINING_WORK     = 0x14,
+    NOS_THREAD_READING_TOPIC    = 0x15,
+    NOS_THREAD_WAITING_NOTIFY   = 0x16,
+    NOS_THREAD_WAITING_IO       = 0x17,
+    NOS_THREAD_ON_HOLD          = 0x1F,
+    NOS_THREAD_WAITING_MASK     = 0x1F,
+    NOS_THREAD_FINISHED         = 0x20,
+    NOS_THREAD_WAIT_TIMEOUT     = 0x40,
+    NOS_THREAD_SUSPENDED        = 0x80,
+    NOS_THREAD_READY            = 0x100
 } nOS_ThreadState;
 
 #if (NOS_CONFIG_SAFE > 0)
@@ -694,10 +1474,44 @@ typedef enum nOS_EventType
     NOS_EVENT_QUEUE             = 0x04,
     NOS_EVENT_FLAG              = 0x05,
     NOS_EVENT_MEM               = 0x06,
-    NOS_EVENT_BARRIER           = 0x07
+    NOS_EVENT_BARRIER           = 0x07,
+    NOS_EVENT_STREAM            = 0x08,
+    NOS_EVENT_RWLOCK            = 0x09,
+    NOS_EVENT_MBOX              = 0x0A,
+    NOS_EVENT_MSGQUEUE          = 0x0B,
+    NOS_EVENT_WORKQUEUE         = 0x0C,
+    NOS_EVENT_TOPIC             = 0x0D,
+    NOS_EVENT_IO                = 0x0E
 } nOS_EventType;
 #endif
 
+#if (NOS_CONFIG_WAITING_POLICY_ENABLE > 0)
+typedef enum nOS_WaitingPolicy
+{
+    NOS_WAITING_POLICY_FIFO     = 0x00,
+    NOS_WAITING_POLICY_PRIO     = 0x01
+} nOS_WaitingPolicy;
+#endif
+
+#if (NOS_CONFIG_SELECT_ENABLE > 0)
+typedef enum nOS_SelectType
+{
+    NOS_SELECT_SEM              = 0x01,
+    NOS_SELECT_QUEUE            = 0x02,
+    NOS_SELECT_FLAG             = 0x03,
+    NOS_SELECT_MEM              = 0x04
+} nOS_SelectType;
+#endif
+
+#if (NOS_CONFIG_THREAD_NOTIFY_ENABLE > 0)
+typedef enum nOS_NotifyAction
+{
+    NOS_NOTIFY_SET_BITS         = 0x00,
+    NOS_NOTIFY_INCREMENT        = 0x01,
+    NOS_NOTIFY_OVERWRITE        = 0x02
+} nOS_NotifyAction;
+#endif
+
 #if (NOS_CONFIG_MUTEX_ENABLE > 0)
 typedef enum nOS_MutexType
 {
@@ -752,6 +1566,68 @@ typedef enum nOS_AlarmState
 } nOS_AlarmState;
 #endif
 
+#if (NOS_CONFIG_TASK_ENABLE > 0)
+typedef enum nOS_TaskState
+{
+    NOS_TASK_DELETED            = 0x00,
+    NOS_TASK_CREATED            = 0x80
+} nOS_TaskState;
+
+/* Value returned by task handler to dispatcher each time it leave its body */
+typedef enum nOS_TaskResult
+{
+    NOS_TASK_WAITING            = 0x00,
+    NOS_TASK_YIELDED            = 0x01,
+    NOS_TASK_SLEEPING           = 0x02,
+    NOS_TASK_ENDED              = 0x03
+} nOS_TaskResult;
+
+typedef nOS_TaskResult(*nOS_TaskHandler)(nOS_Task*,void*);
+#endif
+
+#if (NOS_CONFIG_JOB_ENABLE > 0)
+typedef enum nOS_JobState
+{
+    NOS_JOB_DELETED             = 0x00,
+    NOS_JOB_PENDING             = 0x01,
+    NOS_JOB_CREATED             = 0x80
+} nOS_JobState;
+#endif
+
+#if (NOS_CONFIG_IO_ENABLE > 0)
+typedef enum nOS_IoState
+{
+    NOS_IO_DONE                 = 0x00,
+    NOS_IO_PENDING              = 0x01,
+    NOS_IO_ACTIVE               = 0x02
+} nOS_IoState;
+#endif
+
+#if (NOS_CONFIG_TRACE_ENABLE > 0)
+typedef enum nOS_TraceType
+{
+    NOS_TRACE_SWITCH            = 0x01,
+    NOS_TRACE_WAIT              = 0x02,
+    NOS_TRACE_WAKEUP            = 0x03,
+    NOS_TRACE_TIMER             = 0x04,
+    NOS_TRACE_SIGNAL            = 0x05,
+    NOS_TRACE_ISR_ENTER         = 0x06,
+    NOS_TRACE_ISR_LEAVE         = 0x07
+} nOS_TraceType;
+#endif
+
+/* Critical section profiler hooks, called by ports with interrupts masked when outermost critical section is entered
+ * and left, site is where nOS_EnterCritical is expanded */
+#if (NOS_CONFIG_CRITICAL_PROFILE_ENABLE > 0)
+ void               nOS_ProfileEnterCritical            (const char *file, uint32_t line);
+ void               nOS_ProfileLeaveCritical            (void);
+ #define nOS_ProfileEnter(o)                do { if (o) nOS_ProfileEnterCritical(__FILE__, __LINE__); } while (0)
+ #define nOS_ProfileLeave(o)                do { if (o) nOS_ProfileLeaveCritical(); } while (0)
+#else
+ #define nOS_ProfileEnter(o)
+ #define nOS_ProfileLeave(o)
+#endif
+
 #include "nOSPort.h"
 
 /* Port specific config checkup */
@@ -791,60 +1667,281 @@ typedef enum nOS_AlarmState
  #undef NOS_CONFIG_SIGNAL_THREAD_CALL_STACK_SIZE
 #endif
 
-#ifdef NOS_DONT_USE_CONST
- #define NOS_CONST
+#ifdef NOS_USE_SEPARATE_CALL_STACK
+ #if (NOS_CONFIG_TASK_ENABLE > 0)
+  #if (NOS_CONFIG_TASK_THREAD_ENABLE > 0)
+   #ifndef NOS_CONFIG_TASK_THREAD_CALL_STACK_SIZE
+    #error "nOSConfig.h: NOS_CONFIG_TASK_THREAD_CALL_STACK_SIZE is not defined: must be higher than 0."
+   #elif (NOS_CONFIG_TASK_THREAD_CALL_STACK_SIZE == 0)
+    #error "nOSConfig.h: NOS_CONFIG_TASK_THREAD_CALL_STACK_SIZE is set to invalid value: must be higher than 0."
+   #endif
+  #else
+   #undef NOS_CONFIG_TASK_THREAD_CALL_STACK_SIZE
+  #endif
+ #else
+  #undef NOS_CONFIG_TASK_THREAD_CALL_STACK_SIZE
+ #endif
 #else
- #define NOS_CONST                  const
+ #undef NOS_CONFIG_TASK_THREAD_CALL_STACK_SIZE
 #endif
 
-struct nOS_List
-{
-    nOS_Node            *head;
-    nOS_Node            *tail;
-};
-
-struct nOS_Node
-{
-    nOS_Node            *prev;
-    nOS_Node            *next;
-    void                *payload;
-};
+#ifdef NOS_USE_SEPARATE_CALL_STACK
+ #if (NOS_CONFIG_LOG_ENABLE > 0) && (NOS_CONFIG_LOG_THREAD_ENABLE > 0)
+  #ifndef NOS_CONFIG_LOG_THREAD_CALL_STACK_SIZE
+   #error "nOSConfig.h: NOS_CONFIG_LOG_THREAD_CALL_STACK_SIZE is not defined: must be higher than 0."
+  #elif (NOS_CONFIG_LOG_THREAD_CALL_STACK_SIZE == 0)
+   #error "nOSConfig.h: NOS_CONFIG_LOG_THREAD_CALL_STACK_SIZE is set to invalid value: must be higher than 0."
+  #endif
+ #else
+  #undef NOS_CONFIG_LOG_THREAD_CALL_STACK_SIZE
+ #endif
+#else
+ #undef NOS_CONFIG_LOG_THREAD_CALL_STACK_SIZE
+#endif
 
-struct nOS_Event
-{
-#if (NOS_CONFIG_SAFE > 0)
-    nOS_EventType       type;
+#ifdef NOS_USE_SEPARATE_CALL_STACK
+ #if (NOS_CONFIG_THREAD_SPAWN_ENABLE > 0)
+  #ifndef NOS_CONFIG_THREAD_SPAWN_CALL_STACK_SIZE
+   #error "nOSConfig.h: NOS_CONFIG_THREAD_SPAWN_CALL_STACK_SIZE is not defined: must be higher than 0."
+  #elif (NOS_CONFIG_THREAD_SPAWN_CALL_STACK_SIZE == 0)
+   #error "nOSConfig.h: NOS_CONFIG_THREAD_SPAWN_CALL_STACK_SIZE is set to invalid value: must be higher than 0."
+  #endif
+ #else
+  #undef NOS_CONFIG_THREAD_SPAWN_CALL_STACK_SIZE
+ #endif
+#else
+ #undef NOS_CONFIG_THREAD_SPAWN_CALL_STACK_SIZE
+#endif
+
+#ifdef NOS_USE_SEPARATE_CALL_STACK
+ #if (NOS_CONFIG_JOB_ENABLE > 0)
+  #ifndef NOS_CONFIG_JOB_THREAD_CALL_STACK_SIZE
+   #error "nOSConfig.h: NOS_CONFIG_JOB_THREAD_CALL_STACK_SIZE is not defined: must be higher than 0."
+  #elif (NOS_CONFIG_JOB_THREAD_CALL_STACK_SIZE == 0)
+   #error "nOSConfig.h: NOS_CONFIG_JOB_THREAD_CALL_STACK_SIZE is set to invalid value: must be higher than 0."
+  #endif
+ #else
+  #undef NOS_CONFIG_JOB_THREAD_CALL_STACK_SIZE
+ #endif
+#else
+ #undef NOS_CONFIG_JOB_THREAD_CALL_STACK_SIZE
+#endif
+
+#if (NOS_CONFIG_SCHED_DEFERRED_ENABLE > 0) && !defined(NOS_USE_DEFERRED_SCHED)
+ #error "nOSConfig.h: NOS_CONFIG_SCHED_DEFERRED_ENABLE is not supported by this port."
+#endif
+
+#if (NOS_CONFIG_THREAD_FPU_ENABLE > 0) && !defined(NOS_USE_THREAD_FPU)
+ #error "nOSConfig.h: NOS_CONFIG_THREAD_FPU_ENABLE is not supported by this port (or FPU is not used)."
+#endif
+
+#if (NOS_CONFIG_CYCLE_COUNTER_ENABLE > 0) && !defined(NOS_USE_CYCLE_COUNTER)
+ #error "nOSConfig.h: NOS_CONFIG_CYCLE_COUNTER_ENABLE is not supported by this port."
+#endif
+
+#if (NOS_CONFIG_THREAD_STATS_ENABLE > 0) && !defined(NOS_USE_THREAD_STATS)
+ #error "nOSConfig.h: NOS_CONFIG_THREAD_STATS_ENABLE is not supported by this port."
+#endif
+
+#if (NOS_CONFIG_POWER_ENABLE > 0) && !defined(NOS_USE_POWER)
+ #error "nOSConfig.h: NOS_CONFIG_POWER_ENABLE is not supported by this port."
+#endif
+
+#if (NOS_CONFIG_CRITICAL_PROFILE_ENABLE > 0) && !defined(NOS_USE_CRITICAL_PROFILE)
+ #error "nOSConfig.h: NOS_CONFIG_CRITICAL_PROFILE_ENABLE is not supported by this port."
+#endif
+
+#if (NOS_CONFIG_THREAD_STACK_USAGE_ENABLE > 0) && defined(NOS_SIMULATED_STACK)
+ #error "nOSConfig.h: NOS_CONFIG_THREAD_STACK_USAGE_ENABLE is not supported by this port."
+#endif
+
+#if (NOS_CONFIG_SMP_CORE_COUNT > 1) && !defined(NOS_USE_SMP)
+ #error "nOSConfig.h: NOS_CONFIG_SMP_CORE_COUNT higher than 1 is not supported by this port."
+#endif
+
+/* Placement of scheduler state and context switch path in dedicated sections (e.g. tightly coupled memories), ports
+ * that can do it define them. Always put at start of declaration. */
+#ifndef NOS_FAST_DATA
+ #define NOS_FAST_DATA
+#endif
+#ifndef NOS_FAST_CODE
+ #define NOS_FAST_CODE
+#endif
+#ifdef NOS_GLOBALS
+ #define NOS_EXTERN_FAST            NOS_FAST_DATA
+#else
+ #define NOS_EXTERN_FAST            extern
+#endif
+
+/* Order memory accesses of lock-free objects, ports of CPU that can reorder them must define it */
+#ifndef nOS_MemoryBarrier
+ #if defined(__GNUC__)
+  #define nOS_MemoryBarrier()       __sync_synchronize()
+ #else
+  #define nOS_MemoryBarrier()
+ #endif
+#endif
+
+#ifdef NOS_DONT_USE_CONST
+ #define NOS_CONST
+#else
+ #define NOS_CONST                  const
+#endif
+
+struct nOS_List
+{
+    nOS_Node            *head;
+    nOS_Node            *tail;
+};
+
+struct nOS_Node
+{
+    nOS_Node            *prev;
+    nOS_Node            *next;
+#if (NOS_CONFIG_COMPACT_NODE_ENABLE == 0)
+    void                *payload;
+#endif
+};
+
+#if (NOS_CONFIG_CRITICAL_WALK_LIMIT > 0)
+struct nOS_ListWalk
+{
+    nOS_ListWalk        *link;
+    nOS_Node            *next;
+    uint8_t             count;
+    bool                locked;
+};
+#endif
+
+struct nOS_Event
+{
+#if (NOS_CONFIG_SAFE > 0)
+    nOS_EventType       type;
+#endif
+#if (NOS_CONFIG_WAITING_POLICY_ENABLE > 0)
+    uint8_t             policy;
+#endif
+    nOS_List            waitList;
+#if (NOS_CONFIG_SELECT_ENABLE > 0)
+    nOS_List            selectList;
+#endif
+};
+
+#if (NOS_CONFIG_THREAD_STATS_ENABLE > 0)
+struct nOS_ThreadStats
+{
+    uint64_t            runTime;
+    uint32_t            switchCount;
+    uint32_t            maxSlice;
+};
+#endif
+
+#if (NOS_CONFIG_HRTIMER_ENABLE > 0)
+struct nOS_HrTimer
+{
+    nOS_Node            node;
+    uint32_t            deadline;
+    uint32_t            period;
+    nOS_HrTimerCallback callback;
+    void                *arg;
+    bool                running;
+};
+#endif
+
+#if (NOS_CONFIG_THREAD_PERIODIC_ENABLE > 0)
+struct nOS_PeriodicStats
+{
+    uint32_t            releases;
+    uint32_t            misses;
+    nOS_TickCounter     lastJitter;
+    nOS_TickCounter     maxJitter;
+    nOS_TickCounter     lastResponse;
+    nOS_TickCounter     maxResponse;
+};
 #endif
-    nOS_List            waitList;
-};
 
 struct nOS_Thread
 {
     nOS_Stack           *stackPtr;
+#if (NOS_CONFIG_THREAD_FPU_ENABLE > 0)
+    /* Must stay just after stackPtr, used by port context switch */
+    bool                fpu;
+#endif
 #if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
     uint8_t             prio;
 #endif
-    int                 error;
     nOS_ThreadState     state;
+#if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+    uint8_t             core;
+ #if (NOS_CONFIG_SMP_WORK_STEALING_ENABLE > 0)
+    bool                migratable;
+ #endif
+#endif
+    int                 error;
+#if (NOS_CONFIG_SCHED_ROUND_ROBIN_ENABLE > 0)
+    uint16_t            quantum;
+    uint16_t            quantumLeft;
+#endif
 #if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0) || (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
     nOS_TickCounter     timeout;
+#endif
+#if (NOS_CONFIG_SCHED_EDF_ENABLE > 0)
+    nOS_TickCounter     deadline;
+    nOS_TickCounter     relDeadline;
+    nOS_TickCounter     period;
 #endif
     nOS_Event           *event;
     void                *ext;
+    nOS_Node            readyWait;
+#if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0) || (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
+    nOS_Node            tout;
+#endif
+    /* Fields above are used by scheduler and by each wait and wake up, keep them together at start of thread */
 #if (NOS_CONFIG_THREAD_NAME_ENABLE > 0)
     const char          *name;
 #endif
 #if (NOS_CONFIG_THREAD_JOIN_ENABLE > 0)
     nOS_Event           joined;
 #endif
-
-    nOS_Node            readyWait;
-#if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0) || (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
-    nOS_Node            tout;
+#if (NOS_CONFIG_THREAD_SPAWN_ENABLE > 0)
+    uint8_t             spawn;
 #endif
-#if (NOS_CONFIG_THREAD_SUSPEND_ALL_ENABLE > 0)
+#if (NOS_CONFIG_THREAD_NOTIFY_ENABLE > 0)
+    uint32_t            notified;
+    uint32_t            notifyMask;
+#endif
+#if (NOS_CONFIG_THREAD_BUDGET_ENABLE > 0)
+    nOS_TickCounter     budget;
+    nOS_TickCounter     budgetLeft;
+    nOS_TickCounter     budgetPeriod;
+    nOS_TickCounter     replenish;
+    uint8_t             budgetPrio;
+    uint8_t             backupPrio;
+    bool                depleted;
+#endif
+#if (NOS_CONFIG_THREAD_PERIODIC_ENABLE > 0)
+    nOS_TickCounter     release;
+    nOS_TickCounter     releasePeriod;
+    nOS_PeriodicCallback missed;
+    nOS_PeriodicStats   periodic;
+#endif
+#if (NOS_CONFIG_HRTIMER_ENABLE > 0)
+    nOS_HrTimer         hrSleep;
+#endif
+#if (NOS_CONFIG_THREAD_STATS_ENABLE > 0)
+    nOS_ThreadStats     stats;
+#endif
+#if (NOS_CONFIG_THREAD_STACK_USAGE_ENABLE > 0)
+    nOS_Stack           *stackBase;
+    size_t              stackSize;
+    size_t              stackFree;
+#endif
+#if (NOS_CONFIG_THREAD_SUSPEND_ALL_ENABLE > 0) || (NOS_CONFIG_THREAD_STACK_USAGE_ENABLE > 0)
     nOS_Node            node;
 #endif
+#if (NOS_CONFIG_THREAD_BUDGET_ENABLE > 0)
+    nOS_Node            budgetNode;
+#endif
 };
 
 #if (NOS_CONFIG_SEM_ENABLE > 0)
@@ -870,16 +1967,70 @@ struct nOS_Mutex
 };
 #endif
 
+#if (NOS_CONFIG_RWLOCK_ENABLE > 0)
+struct nOS_RWLock
+{
+    nOS_Event           e;
+    nOS_Thread          *owner;
+    nOS_RWLockCounter   readers;
+ #if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
+    uint8_t             prio;
+    uint8_t             backup;
+ #endif
+};
+#endif
+
 #if (NOS_CONFIG_QUEUE_ENABLE > 0)
 struct nOS_Queue
 {
     nOS_Event           e;
     uint8_t             *buffer;
-    uint8_t             bsize;
+    nOS_QueueSize       bsize;
     nOS_QueueCounter    bmax;
     nOS_QueueCounter    bcount;
     nOS_QueueCounter    r;
     nOS_QueueCounter    w;
+#if (NOS_CONFIG_QUEUE_ZERO_COPY_ENABLE > 0)
+    nOS_QueueCounter    bres;
+    nOS_QueueCounter    bacq;
+    nOS_QueueCounter    bpend;
+    nOS_QueueCounter    bbusy;
+#endif
+#if (NOS_CONFIG_QUEUE_OVERWRITE_ENABLE > 0)
+    bool                overwrite;
+#endif
+};
+#endif
+
+#if (NOS_CONFIG_STREAM_ENABLE > 0)
+struct nOS_Stream
+{
+    nOS_Event                   e;
+    uint8_t                     *buffer;
+    nOS_StreamCounter           bsize;
+    nOS_StreamCounter           bmax;
+    volatile nOS_StreamCounter  r;
+    volatile nOS_StreamCounter  w;
+};
+#endif
+
+#if (NOS_CONFIG_MBOX_ENABLE > 0)
+struct nOS_Mbox
+{
+    nOS_Event           e;
+    void                **buffer;
+    nOS_MboxCounter     bmax;
+    nOS_MboxCounter     bcount;
+    nOS_MboxCounter     r;
+    nOS_MboxCounter     w;
+};
+#endif
+
+#if (NOS_CONFIG_MSGQUEUE_ENABLE > 0)
+struct nOS_MsgQueue
+{
+    nOS_Event           e;
+    nOS_List            list;
 };
 #endif
 
@@ -888,6 +2039,7 @@ struct nOS_Flag
 {
     nOS_Event           e;
     nOS_FlagBits        flags;
+    nOS_FlagBits        waited;
 };
 
 struct nOS_FlagContext
@@ -906,10 +2058,60 @@ struct nOS_Mem
  #if (NOS_CONFIG_MEM_SANITY_CHECK_ENABLE > 0)
     void                *buffer;
     nOS_MemSize         bsize;
+  #if (NOS_CONFIG_MEM_BITMAP_ENABLE > 0)
+    uint8_t             *bitmap;
+  #endif
+ #endif
+ #if (NOS_CONFIG_MEM_SANITY_CHECK_ENABLE > 0) || (NOS_CONFIG_MEM_STATS_ENABLE > 0)
     nOS_MemCounter      bcount;
     nOS_MemCounter      bmax;
  #endif
+ #if (NOS_CONFIG_MEM_STATS_ENABLE > 0)
+    nOS_MemCounter      bmin;
+    uint32_t            allocFail;
+    uint32_t            freeFail;
+ #endif
+};
+
+ #if (NOS_CONFIG_MEM_STATS_ENABLE > 0)
+struct nOS_MemStats
+{
+    nOS_MemCounter      bmax;
+    nOS_MemCounter      bcount;
+    nOS_MemCounter      bpeak;
+    uint32_t            allocFail;
+    uint32_t            freeFail;
+};
+ #endif
+
+ #if (NOS_CONFIG_MEM_CACHE_ENABLE > 0)
+struct nOS_MemCache
+{
+    nOS_Mem             *mem;
+    void                **blist;
+    uint8_t             bcount;
+    uint8_t             bmax;
+};
+ #endif
+
+ #if (NOS_CONFIG_HEAP_ENABLE > 0)
+struct nOS_HeapClass
+{
+    nOS_Mem             mem;
+    void                *buffer;
+    nOS_MemSize         bsize;
+    nOS_MemCounter      bmax;
+  #if (NOS_CONFIG_MEM_BITMAP_ENABLE > 0)
+    void                *bitmap;
+  #endif
+};
+
+struct nOS_Heap
+{
+    nOS_HeapClass       *classes;
+    uint8_t             ccount;
 };
+ #endif
 #endif
 
 #if (NOS_CONFIG_TIMER_ENABLE > 0)
@@ -919,6 +2121,9 @@ struct nOS_Timer
     nOS_TimerCounter    count;
     nOS_TimerCounter    reload;
     nOS_TimerCounter    overflow;
+ #if (NOS_CONFIG_TIMER_SLACK_ENABLE > 0)
+    nOS_TimerCounter    slack;
+ #endif
     nOS_TimerCallback   callback;
     void                *arg;
  #if (NOS_CONFIG_TIMER_HIGHEST_PRIO > 0)
@@ -937,6 +2142,12 @@ struct nOS_Signal
     void                *arg;
 #if (NOS_CONFIG_SIGNAL_HIGHEST_PRIO > 0)
     uint8_t             prio;
+#endif
+#if (NOS_CONFIG_SIGNAL_QUEUE_ENABLE > 0)
+    void                **buffer;
+    uint8_t             bmax;
+    uint8_t             bcount;
+    uint8_t             r;
 #endif
     nOS_Node            node;
 };
@@ -953,6 +2164,17 @@ struct nOS_TimeDate
     uint8_t             minute;         /* From 0 to 59 */
     uint8_t             second;         /* From 0 to 59 */
 };
+
+ #if (NOS_CONFIG_TIME_PRECISE_ENABLE > 0)
+struct nOS_TimePrecise
+{
+    nOS_Time            time;           /* Seconds */
+    uint16_t            ticks;          /* Ticks elapsed in current second, from 0 to NOS_CONFIG_TIME_TICKS_PER_SECOND-1 */
+  #if (NOS_CONFIG_CYCLE_COUNTER_ENABLE > 0)
+    uint32_t            cycles;         /* Cycle counter at last time tick */
+  #endif
+};
+ #endif
 #endif
 
 #if (NOS_CONFIG_ALARM_ENABLE > 0)
@@ -975,6 +2197,177 @@ struct nOS_Barrier
 };
 #endif
 
+#if (NOS_CONFIG_WORKQUEUE_ENABLE > 0)
+struct nOS_Work
+{
+    nOS_Node            node;
+    nOS_WorkCallback    callback;
+    void                *arg;
+    uint32_t            next;
+    uint32_t            end;
+    uint32_t            chunk;
+};
+
+struct nOS_WorkQueue
+{
+    nOS_Event           e;
+    nOS_Event           done;
+    nOS_List            list;
+    uint16_t            running;
+};
+#endif
+
+#if (NOS_CONFIG_TOPIC_ENABLE > 0)
+struct nOS_Topic
+{
+    nOS_Event           e;
+    uint8_t             *buffer;
+    uint16_t            bsize;
+    uint16_t            bmax;
+    uint32_t            seq;
+};
+
+struct nOS_Subscriber
+{
+    nOS_Topic           *topic;
+    uint32_t            seq;
+};
+#endif
+
+#if (NOS_CONFIG_IO_ENABLE > 0)
+struct nOS_IoBuffer
+{
+    nOS_IoBuffer        *next;
+    void                *data;
+    size_t              size;
+};
+
+struct nOS_IoRequest
+{
+    nOS_Event           e;
+    nOS_Node            node;
+    nOS_IoDevice        *dev;
+    nOS_IoBuffer        *chain;
+    size_t              count;
+    nOS_Error           result;
+    nOS_IoState         state;
+    uint8_t             op;
+#if (NOS_CONFIG_SIGNAL_ENABLE > 0)
+    nOS_Signal          *signal;
+#endif
+};
+
+struct nOS_IoDevice
+{
+    nOS_List            pending;
+    nOS_IoRequest       *active;
+    nOS_IoStart         start;
+    void                *context;
+};
+#endif
+
+#if (NOS_CONFIG_TASK_ENABLE > 0)
+struct nOS_Task
+{
+    nOS_Node            node;
+    nOS_TaskState       state;
+    nOS_TaskHandler     handler;
+    void                *arg;
+    nOS_TickCounter     tick;
+    nOS_TaskLine        line;
+};
+#endif
+
+#if (NOS_CONFIG_JOB_ENABLE > 0)
+struct nOS_Job
+{
+    nOS_Node            node;
+    nOS_JobState        state;
+    nOS_JobHandler      handler;
+    void                *arg;
+    uint8_t             prio;
+};
+#endif
+
+#if (NOS_CONFIG_ACTIVE_ENABLE > 0)
+struct nOS_Active
+{
+    nOS_Job             job;
+    nOS_ActiveHandler   handler;
+    void                **events;
+    uint16_t            max;
+    uint16_t            count;
+    uint16_t            r;
+    uint16_t            w;
+};
+#endif
+
+#if (NOS_CONFIG_SELECT_ENABLE > 0)
+struct nOS_SelectItem
+{
+    nOS_Node            node;
+    nOS_Thread          *thread;
+    void                *object;
+    nOS_SelectType      type;
+ #if (NOS_CONFIG_FLAG_ENABLE > 0)
+    nOS_FlagBits        flags;
+ #endif
+};
+
+struct nOS_SelectContext
+{
+    nOS_SelectItem      *items;
+    uint8_t             count;
+    nOS_Event           *event;
+};
+#endif
+
+#if (NOS_CONFIG_TRACE_ENABLE > 0)
+struct nOS_TraceRecord
+{
+    uint32_t            time;
+    uint32_t            object;
+    uint16_t            seq;
+    uint8_t             type;
+    uint8_t             arg;
+};
+#endif
+
+#if (NOS_CONFIG_CRITICAL_PROFILE_ENABLE > 0)
+struct nOS_CriticalSite
+{
+    const char          *file;
+    uint32_t            line;
+    uint32_t            count;
+    uint32_t            max;
+};
+#endif
+
+#if (NOS_CONFIG_POWER_ENABLE > 0)
+/* Entry of port mode table, ordered from lightest to deepest mode */
+struct nOS_PowerMode
+{
+    uint32_t            latency;        /* Wake up latency in microseconds */
+    bool                tick;           /* Tick source keep running in this mode */
+};
+
+struct nOS_PowerRequest
+{
+    nOS_Node            node;
+    uint32_t            latency;
+    bool                active;
+};
+#endif
+
+#if (NOS_CONFIG_LOG_ENABLE > 0)
+struct nOS_LogRecord
+{
+    const char          *format;
+    nOS_LogArg          args[4];
+    uint16_t            seq;
+};
+#endif
+
 #define NOS_NO_WAIT                 0
 #if (NOS_CONFIG_TICK_COUNT_WIDTH == 8)
  #define NOS_TICK_COUNT_MAX         UINT8_MAX
@@ -989,6 +2382,9 @@ struct nOS_Barrier
 #define NOS_TICKS_WAIT_MAX          (NOS_TICK_COUNT_MAX-1)
 
 #define NOS_THREAD_PRIO_IDLE        0
+#if (NOS_CONFIG_SMP_CORE_COUNT > 1) && (NOS_CONFIG_SMP_WORK_STEALING_ENABLE > 0)
+ #define NOS_THREAD_CORE_ANY        0xFF
+#endif
 
 #if (NOS_CONFIG_SEM_COUNT_WIDTH == 8)
  #define NOS_SEM_COUNT_MAX          UINT8_MAX
@@ -1010,6 +2406,14 @@ struct nOS_Barrier
  #define NOS_MUTEX_COUNT_MAX        UINT64_MAX
 #endif
 
+#if (NOS_CONFIG_RWLOCK_COUNT_WIDTH == 8)
+ #define NOS_RWLOCK_COUNT_MAX       UINT8_MAX
+#elif (NOS_CONFIG_RWLOCK_COUNT_WIDTH == 16)
+ #define NOS_RWLOCK_COUNT_MAX       UINT16_MAX
+#elif (NOS_CONFIG_RWLOCK_COUNT_WIDTH == 32)
+ #define NOS_RWLOCK_COUNT_MAX       UINT32_MAX
+#endif
+
 #if (NOS_CONFIG_TIMER_COUNT_WIDTH == 8)
  #define NOS_TIMER_COUNT_MAX        UINT8_MAX
 #elif (NOS_CONFIG_TIMER_COUNT_WIDTH == 16)
@@ -1021,62 +2425,235 @@ struct nOS_Barrier
 #endif
 
 #define NOS_MUTEX_PRIO_INHERIT      0
+#define NOS_RWLOCK_PRIO_INHERIT     0
+
+#if (NOS_CONFIG_MEM_ENABLE > 0)
+ #define NOS_MEM_BITMAP_SIZE(bmax)  (((size_t)(bmax) + 7) / 8)
+#endif
 
 #define NOS_FLAG_NONE               0
 #define NOS_FLAG_TEST_ANY           false
 #define NOS_FLAG_TEST_ALL           true
 
-#ifdef NOS_PRIVATE
- #ifdef NOS_GLOBALS
-  bool                      nOS_initialized = false;
-  volatile bool             nOS_running = false;
+/* Static definitions of objects, initialized at compile time in the same state than after their create function, so
+ * they are ready to use before nOS_Init without any runtime cost. Define them at file scope, name is the object
+ * defined and buffers needed by queues and mailboxes are defined with it as static arrays named name_buffer. Objects
+ * defined this way can be deleted and created again at runtime like any other. */
+#if (NOS_CONFIG_SAFE > 0)
+ #define NOS_EVENT_TYPE_INIT(t)     .type = (t),
+#else
+ #define NOS_EVENT_TYPE_INIT(t)
+#endif
+#if (NOS_CONFIG_WAITING_POLICY_ENABLE > 0)
+ #define NOS_EVENT_POLICY_INIT      .policy = NOS_WAITING_POLICY_PRIO,
+#else
+ #define NOS_EVENT_POLICY_INIT
+#endif
+#define NOS_EVENT_INIT(t)           { NOS_EVENT_TYPE_INIT(t) NOS_EVENT_POLICY_INIT .waitList = { NULL, NULL } }
+
+#if (NOS_CONFIG_SEM_ENABLE > 0)
+ #define NOS_SEM_DEFINE(name,cnt,mx)                                                                                   \
+    nOS_Sem name = { .e = NOS_EVENT_INIT(NOS_EVENT_SEM), .count = (cnt), .max = (mx) }
+#endif
+#if (NOS_CONFIG_MUTEX_ENABLE > 0)
+ #if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
+  #define NOS_MUTEX_DEFINE(name,t,p)                                                                                   \
+    nOS_Mutex name = { .e = NOS_EVENT_INIT(NOS_EVENT_MUTEX), .owner = NULL, .type = (t), .count = 0, .prio = (p) }
+ #else
+  #define NOS_MUTEX_DEFINE(name,t)                                                                                     \
+    nOS_Mutex name = { .e = NOS_EVENT_INIT(NOS_EVENT_MUTEX), .owner = NULL, .type = (t), .count = 0 }
+ #endif
+#endif
+#if (NOS_CONFIG_QUEUE_ENABLE > 0)
+ /* bmax must be higher than 0, queues without buffer have to be created at runtime */
+ #define NOS_QUEUE_DEFINE(name,bs,bm)                                                                                  \
+    static uint8_t name##_buffer[(size_t)(bs) * (size_t)(bm)];                                                         \
+    nOS_Queue name = { .e = NOS_EVENT_INIT(NOS_EVENT_QUEUE), .buffer = name##_buffer, .bsize = (bs), .bmax = (bm) }
+ #if (NOS_CONFIG_QUEUE_OVERWRITE_ENABLE > 0)
+  /* Single block queue in overwrite mode, always holding last written value */
+  #define NOS_QUEUE_LATEST_DEFINE(name,bs)                                                                             \
+    static uint8_t name##_buffer[(size_t)(bs)];                                                                        \
+    nOS_Queue name = { .e = NOS_EVENT_INIT(NOS_EVENT_QUEUE), .buffer = name##_buffer, .bsize = (bs), .bmax = 1, .overwrite = true }
+ #endif
+#endif
+#if (NOS_CONFIG_FLAG_ENABLE > 0)
+ #define NOS_FLAG_DEFINE(name,f)                                                                                       \
+    nOS_Flag name = { .e = NOS_EVENT_INIT(NOS_EVENT_FLAG), .flags = (f), .waited = NOS_FLAG_NONE }
+#endif
+#if (NOS_CONFIG_MBOX_ENABLE > 0)
+ #define NOS_MBOX_DEFINE(name,bm)                                                                                      \
+    static void *name##_buffer[(bm)];                                                                                  \
+    nOS_Mbox name = { .e = NOS_EVENT_INIT(NOS_EVENT_MBOX), .buffer = name##_buffer, .bmax = (bm) }
+#endif
+#if (NOS_CONFIG_MSGQUEUE_ENABLE > 0)
+ #define NOS_MSGQUEUE_DEFINE(name)                                                                                     \
+    nOS_MsgQueue name = { .e = NOS_EVENT_INIT(NOS_EVENT_MSGQUEUE), .list = { NULL, NULL } }
+#endif
+#if (NOS_CONFIG_TOPIC_ENABLE > 0)
+ #define NOS_TOPIC_DEFINE(name,bs,bm)                                                                                  \
+    static uint8_t name##_buffer[(size_t)(bs) * (size_t)(bm)];                                                         \
+    nOS_Topic name = { .e = NOS_EVENT_INIT(NOS_EVENT_TOPIC), .buffer = name##_buffer, .bsize = (bs), .bmax = (bm) }
+#endif
+#if (NOS_CONFIG_TIMER_ENABLE > 0)
+ /* Timer is defined stopped, it still has to be started at runtime */
+ #if (NOS_CONFIG_TIMER_HIGHEST_PRIO > 0)
+  #define NOS_TIMER_PRIO_INIT(p)    .prio = (p),
+ #else
+  #define NOS_TIMER_PRIO_INIT(p)
+ #endif
+ #if (NOS_CONFIG_TIMER_SLACK_ENABLE > 0)
+  #define NOS_TIMER_SLACK_INIT(s)   .slack = (s),
+ #else
+  #define NOS_TIMER_SLACK_INIT(s)
+ #endif
+ #define NOS_TIMER_INIT(name,cb,a,rl,m,p,s)                                                                            \
+    { .state = (nOS_TimerState)(NOS_TIMER_CREATED | ((m) & NOS_TIMER_MODE)), .count = 0, .reload = (rl),               \
+      .overflow = 0, NOS_TIMER_SLACK_INIT(s) .callback = (cb), .arg = (a), NOS_TIMER_PRIO_INIT(p)                      \
+      .node = { NULL, NULL, &(name) }, .trig = { NULL, NULL, &(name) } }
+ #if (NOS_CONFIG_TIMER_HIGHEST_PRIO > 0) && (NOS_CONFIG_TIMER_SLACK_ENABLE > 0)
+  #define NOS_TIMER_DEFINE(name,cb,a,rl,m,p,s)      nOS_Timer name = NOS_TIMER_INIT(name,cb,a,rl,m,p,s)
+ #elif (NOS_CONFIG_TIMER_HIGHEST_PRIO > 0)
+  #define NOS_TIMER_DEFINE(name,cb,a,rl,m,p)        nOS_Timer name = NOS_TIMER_INIT(name,cb,a,rl,m,p,0)
+ #elif (NOS_CONFIG_TIMER_SLACK_ENABLE > 0)
+  #define NOS_TIMER_DEFINE(name,cb,a,rl,m,s)        nOS_Timer name = NOS_TIMER_INIT(name,cb,a,rl,m,0,s)
+ #else
+  #define NOS_TIMER_DEFINE(name,cb,a,rl,m)          nOS_Timer name = NOS_TIMER_INIT(name,cb,a,rl,m,0,0)
+ #endif
+#endif
+
+#ifdef NOS_PRIVATE
+ #ifdef NOS_GLOBALS
+  bool                      nOS_initialized = false;
+  volatile bool             nOS_running = false;
  #else
   extern bool               nOS_initialized;
   extern volatile bool      nOS_running;
  #endif
- NOS_EXTERN nOS_Thread      nOS_idleHandle;
- NOS_EXTERN nOS_TickCounter nOS_tickCounter;
- NOS_EXTERN uint8_t         nOS_isrNestingCounter;
- #if (NOS_CONFIG_SCHED_LOCK_ENABLE > 0)
-  NOS_EXTERN uint8_t        nOS_lockNestingCounter;
- #endif
- NOS_EXTERN nOS_Thread      *nOS_runningThread;
- NOS_EXTERN nOS_Thread      *nOS_highPrioThread;
- #if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
-  NOS_EXTERN nOS_List       nOS_readyThreadsList[NOS_CONFIG_HIGHEST_THREAD_PRIO+1];
+ NOS_EXTERN_FAST nOS_TickCounter nOS_tickCounter;
+ #if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+  /* One entry per core, names without index refer to core of caller */
+  NOS_EXTERN_FAST nOS_Thread     nOS_idleHandles[NOS_CONFIG_SMP_CORE_COUNT];
+  NOS_EXTERN_FAST uint8_t        nOS_isrNestingCounters[NOS_CONFIG_SMP_CORE_COUNT];
+  #if (NOS_CONFIG_SCHED_LOCK_ENABLE > 0)
+   NOS_EXTERN_FAST uint8_t       nOS_lockNestingCounters[NOS_CONFIG_SMP_CORE_COUNT];
+  #endif
+  NOS_EXTERN_FAST nOS_Thread     *nOS_runningThreads[NOS_CONFIG_SMP_CORE_COUNT];
+  NOS_EXTERN_FAST nOS_Thread     *nOS_highPrioThreads[NOS_CONFIG_SMP_CORE_COUNT];
+  #if (NOS_CONFIG_THREAD_STATS_ENABLE > 0)
+   NOS_EXTERN_FAST uint32_t      nOS_switchCyclesPerCore[NOS_CONFIG_SMP_CORE_COUNT];
+  #endif
+  NOS_EXTERN_FAST nOS_List       nOS_readyThreadsLists[NOS_CONFIG_SMP_CORE_COUNT][NOS_CONFIG_HIGHEST_THREAD_PRIO+1];
+  #define   nOS_idleHandle                              nOS_idleHandles[nOS_GetCoreId()]
+  #define   nOS_isrNestingCounter                       nOS_isrNestingCounters[nOS_GetCoreId()]
+  #define   nOS_lockNestingCounter                      nOS_lockNestingCounters[nOS_GetCoreId()]
+  #define   nOS_runningThread                           nOS_runningThreads[nOS_GetCoreId()]
+  #define   nOS_highPrioThread                          nOS_highPrioThreads[nOS_GetCoreId()]
+  #define   nOS_switchCycles                            nOS_switchCyclesPerCore[nOS_GetCoreId()]
+  #define   nOS_readyThreadsList                        nOS_readyThreadsLists[nOS_GetCoreId()]
+  #define   nOS_IsIdleThread(t)                         (((t) >= &nOS_idleHandles[0]) &&                         \
+                                                         ((t) <= &nOS_idleHandles[NOS_CONFIG_SMP_CORE_COUNT-1]))
  #else
-  NOS_EXTERN nOS_List       nOS_readyThreadsList;
+  NOS_EXTERN_FAST nOS_Thread     nOS_idleHandle;
+  NOS_EXTERN_FAST uint8_t        nOS_isrNestingCounter;
+  #if (NOS_CONFIG_SCHED_LOCK_ENABLE > 0)
+   NOS_EXTERN_FAST uint8_t       nOS_lockNestingCounter;
+  #endif
+  NOS_EXTERN_FAST nOS_Thread     *nOS_runningThread;
+  NOS_EXTERN_FAST nOS_Thread     *nOS_highPrioThread;
+  #if (NOS_CONFIG_THREAD_STATS_ENABLE > 0)
+   NOS_EXTERN_FAST uint32_t      nOS_switchCycles;
+  #endif
+  #if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
+   NOS_EXTERN_FAST nOS_List      nOS_readyThreadsList[NOS_CONFIG_HIGHEST_THREAD_PRIO+1];
+  #else
+   NOS_EXTERN_FAST nOS_List      nOS_readyThreadsList;
+  #endif
+  #define   nOS_IsIdleThread(t)                         ((t) == &nOS_idleHandle)
  #endif
  #if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0) || (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
-  NOS_EXTERN nOS_List        nOS_timeoutThreadsList;
+  NOS_EXTERN_FAST nOS_List        nOS_timeoutThreadsList;
  #endif
- #if (NOS_CONFIG_THREAD_SUSPEND_ALL_ENABLE > 0)
+ #if (NOS_CONFIG_THREAD_SUSPEND_ALL_ENABLE > 0) || (NOS_CONFIG_THREAD_STACK_USAGE_ENABLE > 0)
   NOS_EXTERN nOS_List       nOS_allThreadsList;
  #endif
+ #if (NOS_CONFIG_THREAD_BUDGET_ENABLE > 0)
+  NOS_EXTERN nOS_List       nOS_depletedThreadsList;
+ #endif
+ #if (NOS_CONFIG_JOB_ENABLE > 0)
+  /* All jobs run on the stack of this thread */
+  NOS_EXTERN nOS_Thread     nOS_jobThread;
+ #endif
 
  #if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
   nOS_Thread*       nOS_FindHighPrioThread              (void);
   void              nOS_AppendThreadToReadyList         (nOS_Thread *thread);
   void              nOS_RemoveThreadFromReadyList       (nOS_Thread *thread);
  #else
-  #define           nOS_FindHighPrioThread()            nOS_GetHeadOfList(&nOS_readyThreadsList)
+  #define           nOS_FindHighPrioThread()            nOS_GetHeadOfList(&nOS_readyThreadsList,nOS_Thread,readyWait)
   #define           nOS_AppendThreadToReadyList(t)      nOS_AppendToList(&nOS_readyThreadsList, &(t)->readyWait)
   #define           nOS_RemoveThreadFromReadyList(t)    nOS_RemoveFromList(&nOS_readyThreadsList, &(t)->readyWait)
  #endif
  nOS_Error          nOS_Schedule                        (void);
+ #if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+  /* Provided by port with nOS_GetCoreId, request another core to reschedule (inter-processor interrupt) */
+  void              nOS_ScheduleCore                    (uint8_t core);
+ #endif
+ #if (NOS_CONFIG_THREAD_STATS_ENABLE > 0) || ((NOS_CONFIG_TRACE_ENABLE > 0) && defined(NOS_USE_THREAD_STATS))
+  void              nOS_AccountSwitch                   (void);
+ #endif
 
  #define            nOS_InitList(list)                  do{ (list)->head = NULL; (list)->tail = NULL; } while(0)
- #define            nOS_GetHeadOfList(list)             ((list)->head != NULL ? (list)->head->payload : NULL)
+ #if (NOS_CONFIG_COMPACT_NODE_ENABLE > 0)
+  /* Object is found back from offset of node in it */
+  #define           nOS_GetNodeOwner(n,type,member)     ((type*)(void*)((uint8_t*)(n) - offsetof(type, member)))
+  #define           nOS_SetNodeOwner(n,o)               do{ } while(0)
+ #else
+  #define           nOS_GetNodeOwner(n,type,member)     ((type*)(n)->payload)
+  #define           nOS_SetNodeOwner(n,o)               do{ (n)->payload = (void*)(o); } while(0)
+ #endif
+ #define            nOS_GetHeadOfList(list,type,member)                                                                \
+    ((list)->head != NULL ? nOS_GetNodeOwner((list)->head, type, member) : NULL)
  void               nOS_AppendToList                    (nOS_List *list, nOS_Node *node);
+ void               nOS_InsertToList                    (nOS_List *list, nOS_Node *node, nOS_Node *next);
  void               nOS_RemoveFromList                  (nOS_List *list, nOS_Node *node);
  void               nOS_RotateList                      (nOS_List *list);
  void               nOS_WalkInList                      (nOS_List *list, nOS_NodeHandler handler, void *arg);
+ #if (NOS_CONFIG_CRITICAL_WALK_LIMIT > 0)
+  /* Long walks leave critical section for a moment every NOS_CONFIG_CRITICAL_WALK_LIMIT nodes with scheduler locked,
+   * next node of a paused walk is updated when it is removed from its list. */
+  void              nOS_BeginWalk                       (nOS_ListWalk *walk, nOS_Node *first);
+  void              nOS_PauseWalk                       (nOS_ListWalk *walk, nOS_StatusReg *sr);
+  void              nOS_EndWalk                         (nOS_ListWalk *walk);
+  void              nOS_WalkInListBounded               (nOS_List *list, nOS_NodeHandler handler, void *arg, nOS_StatusReg *sr);
+ #endif
+
+ /* Priority bitmaps of scheduler, timers, signals and jobs: first word hold one bit per group of priorities and each
+  * following word one bit per priority of its group, so highest priority set is always found with two bit scans. */
+ #ifdef NOS_32_BITS_SCHEDULER
+  typedef uint32_t                                      nOS_BitmapWord;
+  #define           NOS_BITMAP_SHIFT                    5
+ #else
+  typedef uint16_t                                      nOS_BitmapWord;
+  #define           NOS_BITMAP_SHIFT                    4
+ #endif
+ /* Number of words needed for priorities 0 to h inclusively */
+ #define            NOS_BITMAP_SIZE(h)                  ((((h) >> NOS_BITMAP_SHIFT) + 1) + 1)
+ #define            nOS_IsBitmapEmpty(b)                ((b)[0] == 0)
+ void               nOS_SetPrioInBitmap                 (nOS_BitmapWord *bitmap, uint8_t prio);
+ void               nOS_ClearPrioInBitmap               (nOS_BitmapWord *bitmap, uint8_t prio);
+ uint8_t            nOS_GetHighestPrioInBitmap          (nOS_BitmapWord *bitmap);
+ bool               nOS_FindPrioInBitmap                (nOS_BitmapWord *bitmap, uint8_t limit, uint8_t *prio);
 
  #if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
   void              nOS_SetThreadPrio                   (nOS_Thread *thread, uint8_t prio);
  #endif
- void               nOS_TickThread                      (void *payload, void *arg);
+ void               nOS_TickThread                      (void *node, void *arg);
+ #if (NOS_CONFIG_THREAD_BUDGET_ENABLE > 0)
+  void              nOS_ChargeThread                    (nOS_Thread *thread, nOS_TickCounter ticks);
+  void              nOS_ReplenishThread                 (void *node, void *arg);
+ #endif
  void               nOS_WakeUpThread                    (nOS_Thread *thread, nOS_Error err);
+ void               nOS_WakeUpThreads                   (nOS_List *list, nOS_Error err);
  #if (NOS_CONFIG_THREAD_JOIN_ENABLE > 0)
   int               nOS_ThreadWrapper                   (void *arg);
  #endif
@@ -1095,24 +2672,89 @@ struct nOS_Barrier
  #endif
                                                         );
  nOS_Thread*        nOS_SendEvent                       (nOS_Event *event, nOS_Error err);
+ #if (NOS_CONFIG_WAITING_PRIO_ORDER_ENABLE > 0)
+  void              nOS_InsertThreadToWaitList          (nOS_Event *event, nOS_Thread *thread);
+ #endif
+ #if (NOS_CONFIG_SELECT_ENABLE > 0)
+  void              nOS_SignalSelect                    (nOS_Event *event, nOS_Error err);
+  void              nOS_RemoveThreadFromSelect          (nOS_Thread *thread);
+ #endif
 
  #if (NOS_CONFIG_TIMER_ENABLE > 0)
   void              nOS_InitTimer                       (void);
+  #if (NOS_CONFIG_TICKLESS_ENABLE > 0)
+   nOS_TickCounter  nOS_TimerGetNextWakeup              (void);
+  #endif
  #endif
 
  #if (NOS_CONFIG_SIGNAL_ENABLE > 0)
   void              nOS_InitSignal                      (void);
  #endif
 
+ #if (NOS_CONFIG_TASK_ENABLE > 0)
+  void              nOS_InitTask                        (void);
+  void              nOS_WakeUpTasks                     (void);
+ #endif
+
+ #if (NOS_CONFIG_LOG_ENABLE > 0)
+  void              nOS_InitLog                         (void);
+ #endif
+
+ #if (NOS_CONFIG_THREAD_SPAWN_ENABLE > 0)
+  void              nOS_InitThreadSpawn                 (void);
+ #endif
+
+ #if (NOS_CONFIG_HRTIMER_ENABLE > 0)
+  void              nOS_InitHrTimer                     (void);
+  void              nOS_StopHrSleep                     (nOS_Thread *thread);
+ #endif
+
+ #if (NOS_CONFIG_POWER_ENABLE > 0)
+  extern NOS_CONST nOS_PowerMode nOS_powerModes[NOS_POWER_MODE_COUNT];
+  void              nOS_InitPower                       (void);
+  uint8_t           nOS_PowerSelectMode                 (nOS_TickCounter ticks);
+ #endif
+
+ #if (NOS_CONFIG_JOB_ENABLE > 0)
+  void              nOS_InitJob                         (void);
+  void              nOS_DispatchJobs                    (void);
+  uint8_t           nOS_RaiseJobCeiling                 (uint8_t prio);
+  void              nOS_RestoreJobCeiling               (uint8_t ceiling);
+ #endif
+
  #if (NOS_CONFIG_TIME_ENABLE > 0)
   void              nOS_InitTime                        (void);
+  #if (NOS_CONFIG_TIME_WAIT_ENABLE > 0)
+   void             nOS_RemoveThreadFromTimeWait        (nOS_Thread *thread);
+  #endif
+  #if (NOS_CONFIG_TICKLESS_ENABLE > 0)
+   nOS_TickCounter  nOS_TimeGetTicksUntil               (nOS_Time time);
+   nOS_TickCounter  nOS_TimeGetNextWakeup               (void);
+  #endif
  #endif
 
  #if (NOS_CONFIG_ALARM_ENABLE > 0)
   void              nOS_InitAlarm                       (void);
+  #if (NOS_CONFIG_TICKLESS_ENABLE > 0)
+   nOS_TickCounter  nOS_AlarmGetNextWakeup              (void);
+  #endif
+ #endif
+
+ /* Trace hooks, called from critical section */
+ #if (NOS_CONFIG_TRACE_ENABLE > 0)
+  void              nOS_TraceWrite                      (nOS_TraceType type, void *object, uint8_t arg);
+  #define           nOS_Trace(t,o,a)                    nOS_TraceWrite((t), (void*)(o), (uint8_t)(a))
+ #else
+  #define           nOS_Trace(t,o,a)
  #endif
 #endif
 
+/* Used by ports to take scheduling decision only once when leaving outermost critical section or interrupt */
+#if (NOS_CONFIG_SCHED_DEFERRED_ENABLE > 0)
+ NOS_EXTERN_FAST volatile bool nOS_needResched;
+ bool               nOS_ResolveSchedule                 (void);
+#endif
+
 /**********************************************************************************************************************
  *                                                                                                                    *
  * Name         : nOS_Init                                                                                            *
@@ -1173,6 +2815,8 @@ nOS_Error           nOS_Yield                           (void);
  * Notes                                                                                                              *
  *   1. Must be called x times per second by the application if needed.                                               *
  *        x = NOS_CONFIG_TICKS_PER_SECOND                                                                             *
+ *   2. Threads, timers, time and alarms are updated in a single critical section, by batch of                        *
+ *      NOS_CONFIG_TICK_BATCH_SIZE ticks if enabled.                                                                  *
  *                                                                                                                    *
  **********************************************************************************************************************/
 void                nOS_Tick                            (nOS_TickCounter ticks);
@@ -1194,6 +2838,86 @@ void                nOS_Tick                            (nOS_TickCounter ticks);
  **********************************************************************************************************************/
 nOS_TickCounter     nOS_GetTickCount                    (void);
 
+#if (NOS_CONFIG_TICKLESS_ENABLE > 0)
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name        : nOS_GetNextWakeupTicks                                                                               *
+ *                                                                                                                    *
+ * Description : Get number of ticks until next event that need the scheduler attention (thread timeout, timer        *
+ *               deadline, alarm or time waiting). Can be used by the port to disable systick during this interval.   *
+ *                                                                                                                    *
+ * Return      : Number of ticks until next event.                                                                    *
+ *   0                 : An event is already pending and need to be processed.                                        *
+ *   NOS_WAIT_INFINITE : Nothing is waiting on ticks.                                                                 *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Only services ticked from nOS_Tick are taken in account.                                                      *
+ *   2. Returned value is sent as is to nOS_Tick after the sleep period to trigger the event.                         *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_TickCounter    nOS_GetNextWakeupTicks              (void);
+#endif
+
+#if (NOS_CONFIG_POWER_ENABLE > 0)
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name        : nOS_PowerIdle                                                                                        *
+ *                                                                                                                    *
+ * Description : Put CPU in the deepest low power mode of the port table that fit next scheduler event and registered *
+ *               latency constraints, until an interrupt wake it up.                                                  *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Shall be called in loop from main thread (idle) only.                                                         *
+ *   2. Port modes (lightest to deepest):                                                                             *
+ *        Cortex-M : NOS_POWER_SLEEP (WFI, tickless idle if enabled), NOS_POWER_DEEP_SLEEP (SLEEPDEEP).               *
+ *        MSP430   : NOS_POWER_LPM0 to NOS_POWER_LPM4, tick timer is expected to be clocked by ACLK.                  *
+ *        AVR      : NOS_POWER_IDLE, NOS_POWER_DOWN.                                                                  *
+ *   3. On MSP430, only interrupts declared with NOS_ISR clear low power bits on exit and wake up main thread.        *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ void               nOS_PowerIdle                       (void);
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name        : nOS_PowerRequestMaxLatency                                                                           *
+ *                                                                                                                    *
+ * Description : Register or update a constraint on wake up latency of low power modes used by nOS_PowerIdle.         *
+ *               Deepest mode used is limited by the lowest latency of all registered requests.                       *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   request   : Pointer to request object, shall be zeroed before first use (global or static).                      *
+ *   latency   : Maximum wake up latency in microseconds (0 to keep only lightest mode).                              *
+ *                                                                                                                    *
+ * Return      : Error code.                                                                                          *
+ *   NOS_OK        : Request successfully registered or updated.                                                      *
+ *   NOS_E_INV_OBJ : Pointer to request object is invalid.                                                            *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Can be called from any thread or ISR.                                                                         *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_PowerRequestMaxLatency          (nOS_PowerRequest *request, uint32_t latency);
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name        : nOS_PowerReleaseLatency                                                                              *
+ *                                                                                                                    *
+ * Description : Remove a constraint registered with nOS_PowerRequestMaxLatency.                                      *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   request   : Pointer to request object.                                                                           *
+ *                                                                                                                    *
+ * Return      : Error code.                                                                                          *
+ *   NOS_OK        : Request successfully removed.                                                                    *
+ *   NOS_E_INV_OBJ : Pointer to request object is invalid or request is not registered.                               *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Can be called from any thread or ISR.                                                                         *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_PowerReleaseLatency             (nOS_PowerRequest *request);
+#endif
+
 #if defined(NOS_CONFIG_TICKS_PER_SECOND) && (NOS_CONFIG_TICKS_PER_SECOND > 0)
 /**********************************************************************************************************************
  *                                                                                                                    *
@@ -1274,6 +2998,80 @@ nOS_TickCounter     nOS_GetTickCount                    (void);
  nOS_Error          nOS_SleepUntil                      (nOS_TickCounter tick);
 #endif
 
+#if (NOS_CONFIG_THREAD_PERIODIC_ENABLE > 0)
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_ThreadSetPeriodic                                                                            *
+ *                                                                                                                    *
+ * Description     : Make thread periodic. First release of thread is now, next ones are aligned on period. Release   *
+ *                   jitter, response time and deadline misses are recorded by nOS_WaitNextPeriod, statistics are     *
+ *                   reset.                                                                                           *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   thread        : Pointer to thread object.                                                                        *
+ *                     See note 1.                                                                                    *
+ *   period        : Number of ticks between each release of thread (0 if thread is not periodic).                    *
+ *   callback      : Pointer to function called by thread each time it has missed its deadline (can be NULL).         *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Period successfully set.                                                                         *
+ *   NOS_E_INV_OBJ : Thread is not created.                                                                           *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Pointer can be NULL to access the running thread.                                                             *
+ *   2. Deadline of each release is next release (implicit deadline).                                                 *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_ThreadSetPeriodic               (nOS_Thread *thread, nOS_TickCounter period, nOS_PeriodicCallback callback);
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_WaitNextPeriod                                                                               *
+ *                                                                                                                    *
+ * Description     : Running thread has completed its work for current release, place it in sleeping state until its  *
+ *                   next release. Response time of current release is recorded. If current release has missed its    *
+ *                   deadline, miss is counted and callback is called with response time, then running thread         *
+ *                   continue immediately.                                                                            *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Next release has started.                                                                        *
+ *   NOS_E_INV_VAL : Running thread is not periodic.                                                                  *
+ *   NOS_E_ELAPSED : Deadline was missed, running thread continue immediately with next release. If it is late by     *
+ *                   more than one period, releases are restarted from now and lost ones are skipped.                 *
+ *   NOS_E_ISR     : Can't sleep from interrupt service routine.                                                      *
+ *   NOS_E_LOCKED  : Can't sleep from scheduler locked section.                                                       *
+ *   NOS_E_IDLE    : Can't sleep from main thread.                                                                    *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Used instead of nOS_SleepUntil(next += period), releases don't drift when thread is late.                     *
+ *   2. Jitter and response time are measured in ticks from scheduled release.                                        *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_WaitNextPeriod                  (void);
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_ThreadGetPeriodicStats                                                                       *
+ *                                                                                                                    *
+ * Description     : Get copy of release jitter, response time and deadline miss statistics of periodic thread.       *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   thread        : Pointer to thread object.                                                                        *
+ *                     See note 1.                                                                                    *
+ *   stats         : Pointer to statistics structure where to store copy.                                             *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Statistics successfully copied.                                                                  *
+ *   NOS_E_INV_OBJ : Thread is not created.                                                                           *
+ *   NOS_E_NULL    : Pointer to statistics structure is invalid.                                                      *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Pointer can be NULL to access the running thread.                                                             *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_ThreadGetPeriodicStats          (nOS_Thread *thread, nOS_PeriodicStats *stats);
+#endif
+
 #if (NOS_CONFIG_SCHED_LOCK_ENABLE > 0)
 /**********************************************************************************************************************
  *                                                                                                                    *
@@ -1344,12 +3142,19 @@ nOS_Thread *        nOS_GetRunningThread                (void);
  *                       See note 3                                                                                   *
  *   name            : Pointer to ascii string representing the name of the thread (can be useful for debugging).     *
  *                       See note 4                                                                                   *
+ *   fpu             : Thread use the FPU.                                                                            *
+ *                       true  : Thread can access the FPU.                                                           *
+ *                       false : Thread will fault if it execute a floating point instruction.                        *
+ *                       See note 5                                                                                   *
+ *   core            : Core that will run the thread: 0 <= core < NOS_CONFIG_SMP_CORE_COUNT.                          *
+ *                       NOS_THREAD_CORE_ANY  : Thread start on core of caller and can be moved to any idle core.     *
+ *                       See note 6                                                                                   *
  *                                                                                                                    *
  * Return            : Error code.                                                                                    *
  *   NOS_OK          : Thread successfully created.                                                                   *
  *   NOS_E_INV_OBJ   : Pointer to nOS_Thread object is invalid.                                                       *
- *   NOS_E_INV_VAL   : Invalid parameter(s) (can be an invalid thread entry, stack array, stack size and/or call      *
- *                     stack size).                                                                                   *
+ *   NOS_E_INV_VAL   : Invalid parameter(s) (can be an invalid thread entry, stack array, stack size, call stack      *
+ *                     size and/or core).                                                                             *
  *   NOS_E_INV_PRIO  : Priority is higher than NOS_CONFIG_HIGHEST_THREAD_PRIO.                                        *
  *   NOS_E_INV_STATE : State of the thread is invalid.                                                                *
  *                                                                                                                    *
@@ -1359,6 +3164,9 @@ nOS_Thread *        nOS_GetRunningThread                (void);
  *   3. If NOS_CONFIG_THREAD_SUSPEND_ENABLE if defined to 0, this parameter is not available and threads will always  *
  *      be created in ready state.                                                                                    *
  *   4. Not available if NOS_CONFIG_THREAD_NAME_ENABLE is defined to 0.                                               *
+ *   5. Only available if NOS_CONFIG_THREAD_FPU_ENABLE is defined to 1.                                               *
+ *   6. Only available if NOS_CONFIG_SMP_CORE_COUNT is higher than 1. Thread always run on this core, except if      *
+ *      NOS_THREAD_CORE_ANY is used (only available if NOS_CONFIG_SMP_WORK_STEALING_ENABLE is defined to 1).          *
  *                                                                                                                    *
  **********************************************************************************************************************/
 nOS_Error           nOS_ThreadCreate                    (nOS_Thread *thread,
@@ -1377,6 +3185,12 @@ nOS_Error           nOS_ThreadCreate                    (nOS_Thread *thread,
 #endif
 #if (NOS_CONFIG_THREAD_NAME_ENABLE > 0)
                                                         ,const char *name
+#endif
+#if (NOS_CONFIG_THREAD_FPU_ENABLE > 0)
+                                                        ,bool fpu
+#endif
+#if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+                                                        ,uint8_t core
 #endif
                                                         );
 
@@ -1496,472 +3310,2258 @@ nOS_Error           nOS_ThreadCreate                    (nOS_Thread *thread,
  int16_t            nOS_ThreadGetPriority               (nOS_Thread *thread);
  nOS_Error          nOS_ThreadSetPriority               (nOS_Thread *thread, uint8_t prio);
 #endif
-#if (NOS_CONFIG_THREAD_NAME_ENABLE > 0)
- const char*        nOS_ThreadGetName                   (nOS_Thread *thread);
- nOS_Error          nOS_ThreadSetName                   (nOS_Thread *thread, const char *name);
-#endif
-#if (NOS_CONFIG_THREAD_JOIN_ENABLE > 0)
- nOS_Error          nOS_ThreadJoin                      (nOS_Thread *thread, int *ret, nOS_TickCounter timeout);
-#endif
-
-#if (NOS_CONFIG_SEM_ENABLE > 0)
+#if (NOS_CONFIG_SCHED_ROUND_ROBIN_ENABLE > 0)
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Name            : nOS_SemCreate                                                                                    *
+ * Name            : nOS_ThreadSetQuantum                                                                             *
  *                                                                                                                    *
- * Description     : Create a new semaphore object.                                                                   *
+ * Description     : Set round-robin time slice of thread. Thread will give its place to the next ready thread of the *
+ *                   same priority after running quantum ticks.                                                       *
  *                                                                                                                    *
  * Parameters                                                                                                         *
- *   sem           : Pointer to semaphore object.                                                                     *
- *   count         : Initial count of semaphore.                                                                      *
- *   max           : Maximum count of semaphore.                                                                      *
+ *   thread        : Pointer to thread object.                                                                        *
+ *                     See note 1.                                                                                    *
+ *   quantum       : Time slice in number of ticks.                                                                   *
  *                                                                                                                    *
  * Return          : Error code.                                                                                      *
- *   NOS_OK        : Semaphore successfully created.                                                                  *
- *   NOS_E_INV_OBJ : Pointer to semaphore object is invalid.                                                          *
- *   NOS_E_INV_VAL : Initial count is higher than defined maximum.                                                    *
+ *   NOS_OK        : Time slice successfully set.                                                                     *
+ *   NOS_E_INV_OBJ : Thread is not created.                                                                           *
+ *   NOS_E_INV_VAL : Time slice is equal to 0.                                                                        *
  *                                                                                                                    *
  * Notes                                                                                                              *
- *   1. Semaphore object must be created before using it, else the behavior is undefined.                             *
- *   2. Must be called one time only for each semaphore object.                                                       *
+ *   1. Pointer can be NULL to access the running thread.                                                             *
+ *   2. Time slice left in current slice is reduced if higher than new time slice.                                    *
  *                                                                                                                    *
  **********************************************************************************************************************/
- nOS_Error          nOS_SemCreate                       (nOS_Sem *sem, nOS_SemCounter count, nOS_SemCounter max);
-
- #if (NOS_CONFIG_SEM_DELETE_ENABLE > 0)
+ nOS_Error          nOS_ThreadSetQuantum                (nOS_Thread *thread, uint16_t quantum);
+#endif
+#if (NOS_CONFIG_THREAD_BUDGET_ENABLE > 0)
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Name            : nOS_SemDelete                                                                                    *
+ * Name            : nOS_ThreadSetBudget                                                                              *
  *                                                                                                                    *
- * Description     : Delete semaphore object and wake up all waiting threads if any.                                  *
+ * Description     : Set execution budget of thread. Thread can run for budget ticks in each period, then it is       *
+ *                   demoted to given priority until next period. First period start now.                             *
  *                                                                                                                    *
  * Parameters                                                                                                         *
- *   sem           : Pointer to semaphore object.                                                                     *
+ *   thread        : Pointer to thread object.                                                                        *
+ *                     See note 1.                                                                                    *
+ *   budget        : Number of ticks thread can run in each period (0 to remove budget).                              *
+ *   period        : Number of ticks between each replenishment of budget.                                            *
+ *   prio          : Priority of thread when its budget is exhausted.                                                 *
  *                                                                                                                    *
  * Return          : Error code.                                                                                      *
- *   NOS_OK        : Semaphore successfully deleted.                                                                  *
- *   NOS_E_INV_OBJ : Pointer to semaphore object is invalid.                                                          *
+ *   NOS_OK        : Budget successfully set.                                                                         *
+ *   NOS_E_INV_OBJ : Thread is not created.                                                                           *
+ *   NOS_E_INV_VAL : Budget is higher than period or priority is higher than NOS_CONFIG_HIGHEST_THREAD_PRIO.          *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Pointer can be NULL to access the running thread.                                                             *
+ *   2. If thread is currently demoted, it is restored to its priority immediately.                                   *
+ *   3. If priority of thread is changed while it is demoted (mutex inheritance or nOS_ThreadSetPriority), it is      *
+ *      kept at replenishment.                                                                                        *
  *                                                                                                                    *
  **********************************************************************************************************************/
-  nOS_Error         nOS_SemDelete                       (nOS_Sem *sem);
- #endif
+ nOS_Error          nOS_ThreadSetBudget                 (nOS_Thread *thread, nOS_TickCounter budget, nOS_TickCounter period, uint8_t prio);
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Name            : nOS_SemTake                                                                                      *
+ * Name            : nOS_ThreadGetBudget                                                                              *
  *                                                                                                                    *
- * Description     : Take semaphore pointed by object pointer. If not available, calling thread will be placed in     *
- *                   event's waiting list for number of ticks specified by timeout. If semaphore is not available in  *
- *                   required time, an error will be returned and semaphore will be left unchanged.                   *
+ * Description     : Get number of ticks of budget left to thread in current period.                                  *
  *                                                                                                                    *
  * Parameters                                                                                                         *
- *   sem           : Pointer to semaphore object.                                                                     *
- *   timeout       : Timeout value.                                                                                   *
- *                     NOS_NO_WAIT                     : Don't wait if the semaphore is not available.                *
- *                     0 > timeout < NOS_WAIT_INFINITE : Maximum number of ticks to wait for the semaphore to become  *
- *                                                       available.                                                   *
- *                     NOS_WAIT_INFINITE               : Wait indefinitely until the semaphore become available.      *
+ *   thread        : Pointer to thread object.                                                                        *
+ *                     See note 1.                                                                                    *
  *                                                                                                                    *
- * Return          : Error code.                                                                                      *
- *   NOS_OK        : Requested semaphore have been successfully taken.                                                *
- *   NOS_E_INV_OBJ : Pointer to semaphore object is invalid.                                                          *
- *   NOS_E_AGAIN   : Semaphore is unavailable (happens when timeout equal NOS_NO_WAIT).                               *
- *   NOS_E_ISR     : Can't wait from interrupt service routine.                                                       *
- *   NOS_E_LOCKED  : Can't wait from scheduler locked section.                                                        *
- *   NOS_E_IDLE    : Can't wait from main thread (idle).                                                              *
- *   NOS_E_TIMEOUT : Semaphore has not been given before reaching timeout.                                            *
- *   NOS_E_DELETED : Semaphore object has been deleted.                                                               *
+ * Return          : Ticks left in current period (0 if thread is demoted or has no budget).                          *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Pointer can be NULL to access the running thread.                                                             *
  *                                                                                                                    *
  **********************************************************************************************************************/
- nOS_Error          nOS_SemTake                         (nOS_Sem *sem, nOS_TickCounter timeout);
-
+ nOS_TickCounter    nOS_ThreadGetBudget                 (nOS_Thread *thread);
+#endif
+#if (NOS_CONFIG_SCHED_EDF_ENABLE > 0)
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Name            : nOS_SemGive                                                                                      *
+ * Name            : nOS_ThreadSetDeadline                                                                            *
  *                                                                                                                    *
- * Description     : Give semaphore pointed by object pointer. If a thread is waiting, replace it in ready list with  *
- *                   operation successfull code. If no thread is waiting, increment semaphore count if lower than     *
- *                   maximum available count, else return an overflow error.                                          *
+ * Description     : Set relative deadline and period of thread scheduled by earliest deadline first. Current         *
+ *                   release of thread is set to now, so its absolute deadline is now + deadline.                     *
  *                                                                                                                    *
  * Parameters                                                                                                         *
- *   sem           : Pointer to semaphore object.                                                                     *
+ *   thread        : Pointer to thread object.                                                                        *
+ *                     See note 1.                                                                                    *
+ *   deadline      : Relative deadline in ticks (0 to remove deadline).                                               *
+ *   period        : Period in ticks between each release of thread (0 if thread is not periodic).                    *
  *                                                                                                                    *
  * Return          : Error code.                                                                                      *
- *   NOS_OK        : Requested semaphore have been successfully taken.                                                *
- *   NOS_E_INV_OBJ : Pointer to semaphore object is invalid.                                                          *
+ *   NOS_OK        : Deadline successfully set.                                                                       *
+ *   NOS_E_INV_OBJ : Thread is not created.                                                                           *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Pointer can be NULL to access the running thread.                                                             *
+ *   2. Deadline is only used when thread run at priority NOS_CONFIG_SCHED_EDF_PRIO.                                  *
  *                                                                                                                    *
  **********************************************************************************************************************/
- nOS_Error          nOS_SemGive                         (nOS_Sem *sem);
+ nOS_Error          nOS_ThreadSetDeadline               (nOS_Thread *thread, nOS_TickCounter deadline, nOS_TickCounter period);
 
+ #if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0) || (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Name            : nOS_SemIsAvailable                                                                               *
+ * Name            : nOS_ThreadWaitNextRelease                                                                        *
  *                                                                                                                    *
- * Description     : Return availability of semaphore.                                                                *
+ * Description     : Running thread has completed its work for current period, put it to sleep until its next         *
+ *                   release and set its absolute deadline for next period.                                           *
  *                                                                                                                    *
- * Parameters                                                                                                         *
- *   sem           : Pointer to semaphore object.                                                                     *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Next period has started.                                                                         *
+ *   NOS_E_INV_VAL : Running thread has no period.                                                                    *
+ *   NOS_E_ELAPSED : Next release was already reached, running thread continue immediately with its new deadline.     *
+ *   NOS_E_ISR     : Can't wait from interrupt service routine.                                                       *
+ *   NOS_E_LOCKED  : Can't wait from scheduler locked section.                                                        *
+ *   NOS_E_IDLE    : Can't wait from main thread (idle).                                                              *
  *                                                                                                                    *
- * Return          : TRUE if semaphore count is higher than 0, else FALSE.                                            *
+ * Notes                                                                                                              *
+ *   1. Releases stay aligned on period even if running thread call it late.                                          *
  *                                                                                                                    *
  **********************************************************************************************************************/
- bool               nOS_SemIsAvailable                  (nOS_Sem *sem);
+  nOS_Error         nOS_ThreadWaitNextRelease           (void);
+ #endif
 #endif
-
-#if (NOS_CONFIG_MUTEX_ENABLE > 0)
-/**********************************************************************************************************************
- *                                                                                                                    *
- * Name            : nOS_MutexCreate                                                                                  *
- *                                                                                                                    *
- * Description     : Create a new mutex object.                                                                       *
+#if (NOS_CONFIG_THREAD_NAME_ENABLE > 0)
+ const char*        nOS_ThreadGetName                   (nOS_Thread *thread);
+ nOS_Error          nOS_ThreadSetName                   (nOS_Thread *thread, const char *name);
+#endif
+#if (NOS_CONFIG_THREAD_JOIN_ENABLE > 0)
+ nOS_Error          nOS_ThreadJoin                      (nOS_Thread *thread, int *ret, nOS_TickCounter timeout);
+#endif
+#if (NOS_CONFIG_THREAD_SPAWN_ENABLE > 0)
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name        : nOS_ThreadSpawn                                                                                      *
+ *                                                                                                                    *
+ * Description : Take a thread object and its stack from pool of spawn threads and start entry in it. Thread object   *
+ *               and stack are given back to pool when entry returns, or when its exit code has been collected by     *
+ *               nOS_ThreadJoin if join is true.                                                                      *
  *                                                                                                                    *
  * Parameters                                                                                                         *
- *   mutex         : Pointer to mutex object.                                                                         *
- *   type          : Type of mutex to create.                                                                         *
- *                     NOS_MUTEX_NORMAL    : Standard mutex (like binary semaphore).                                  *
- *                     NOS_MUTEX_RECURSIVE : Mutex that can be locked recursively.                                    *
- *   prio          : Priority of mutex.                                                                               *
- *                     NOS_MUTEX_PRIO_INHERIT : Mutex owner inherit higher prio from other threads that try to lock   *
- *                                              this mutex.                                                           *
- *                     prio > 0               : Mutex owner increase its prio to this value when it lock the mutex    *
- *                                              (immediate ceiling protocol).                                         *
+ *   entry     : Pointer to function to run in spawned thread.                                                        *
+ *   arg       : Pointer that will be passed to entry.                                                                *
+ *   join      : Keep thread object until its exit code is collected.                                                 *
+ *                 false : Thread object is reused as soon as entry returns (nothing to collect).                     *
+ *                 true  : Thread object is reused after nOS_ThreadJoin returned its exit code.                       *
+ *   prio      : Priority of spawned thread (see note 1).                                                             *
  *                                                                                                                    *
- * Return          : Error code.                                                                                      *
- *   NOS_OK        : Mutex successfully created.                                                                      *
- *   NOS_E_INV_OBJ : Pointer to mutex object is invalid.                                                              *
- *   NOS_E_INV_VAL : Type of mutex is invalid.                                                                        *
+ * Return      : Pointer to spawned thread object.                                                                    *
+ *   == NULL   : No thread object available in pool or invalid parameter(s).                                          *
+ *   != NULL   : Handle of spawned thread, can be given to other nOS_Thread functions while thread is running.        *
  *                                                                                                                    *
  * Notes                                                                                                              *
- *   1. Mutex object must be created before using it, else the behavior is undefined.                                 *
- *   2. Must be called one time only for each mutex object.                                                           *
+ *   1. Not available if NOS_CONFIG_HIGHEST_THREAD_PRIO is defined to 0.                                              *
+ *   2. Can't be called from ISR: context of a finishing spawned thread can still be saved in its stack.              *
+ *   3. All spawned threads have a stack of NOS_CONFIG_THREAD_SPAWN_STACK_SIZE. On simulated platforms, host thread of*
+ *      a finished thread object is kept waiting and reused, only first spawn of each pooled thread object create one.*
+ *   4. Thread spawned with join set to true must be joined one time, otherwise its thread object is never given back *
+ *      to pool. Handle shall not be used anymore once thread object is back in pool.                                 *
  *                                                                                                                    *
  **********************************************************************************************************************/
- nOS_Error          nOS_MutexCreate                     (nOS_Mutex *mutex,
-                                                         nOS_MutexType type
+ nOS_Thread*        nOS_ThreadSpawn                     (nOS_ThreadEntry entry,
+                                                         void *arg,
+                                                         bool join
  #if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
                                                         ,uint8_t prio
  #endif
                                                         );
- #if (NOS_CONFIG_MUTEX_DELETE_ENABLE > 0)
-  nOS_Error         nOS_MutexDelete                     (nOS_Mutex *mutex);
- #endif
- nOS_Error          nOS_MutexLock                       (nOS_Mutex *mutex, nOS_TickCounter timeout);
- nOS_Error          nOS_MutexUnlock                     (nOS_Mutex *mutex);
- bool               nOS_MutexIsLocked                   (nOS_Mutex *mutex);
- nOS_Thread*        nOS_MutexGetOwner                   (nOS_Mutex *mutex);
-#endif
-
-#if (NOS_CONFIG_QUEUE_ENABLE > 0)
- nOS_Error          nOS_QueueCreate                     (nOS_Queue *queue, void *buffer, uint8_t bsize, nOS_QueueCounter bmax);
- #if (NOS_CONFIG_QUEUE_DELETE_ENABLE > 0)
-  nOS_Error         nOS_QueueDelete                     (nOS_Queue *queue);
- #endif
- nOS_Error          nOS_QueueRead                       (nOS_Queue *queue, void *block, nOS_TickCounter timeout);
- nOS_Error          nOS_QueuePeek                       (nOS_Queue *queue, void *block);
- nOS_Error          nOS_QueueWrite                      (nOS_Queue *queue, void *block, nOS_TickCounter timeout);
- nOS_Error          nOS_QueueFlush                      (nOS_Queue *queue, nOS_QueueCallback callback);
- bool               nOS_QueueIsEmpty                    (nOS_Queue *queue);
- bool               nOS_QueueIsFull                     (nOS_Queue *queue);
- nOS_QueueCounter   nOS_QueueGetCount                   (nOS_Queue *queue);
 #endif
-
-#if (NOS_CONFIG_FLAG_ENABLE > 0)
+#if (NOS_CONFIG_THREAD_NOTIFY_ENABLE > 0)
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Name            : nOS_FlagCreate                                                                                   *
+ * Name            : nOS_ThreadNotify                                                                                 *
  *                                                                                                                    *
- * Description     : Create a flag event object and initialize it with given flags.                                   *
+ * Description     : Update notification value of thread and wake it up if it is waiting for one of the notified      *
+ *                   bits.                                                                                            *
  *                                                                                                                    *
  * Parameters                                                                                                         *
- *   flag          : Pointer to flag object.                                                                          *
- *   flags         : Initial values.                                                                                  *
+ *   thread        : Pointer to thread object.                                                                        *
+ *   bits          : Bits or value used by action.                                                                    *
+ *   action        : How notification value is updated.                                                               *
+ *                     NOS_NOTIFY_SET_BITS  : Bits are set in notification value.                                     *
+ *                     NOS_NOTIFY_INCREMENT : Bits are added to notification value (used as a counter).               *
+ *                     NOS_NOTIFY_OVERWRITE : Notification value is replaced by bits.                                 *
  *                                                                                                                    *
  * Return          : Error code.                                                                                      *
- *   NOS_OK        : Flag successfully created.                                                                       *
- *   NOS_E_INV_OBJ : Pointer to flag object is invalid.                                                               *
+ *   NOS_OK        : Thread successfully notified.                                                                    *
+ *   NOS_E_INV_OBJ : Thread is not created.                                                                           *
+ *   NOS_E_INV_VAL : Action is invalid.                                                                               *
  *                                                                                                                    *
  * Notes                                                                                                              *
- *   1. Flag object must be created before using it, else the behavior is undefined.                                  *
- *   2. Must be called one time only for each flag object.                                                            *
+ *   1. Can be called from ISR.                                                                                       *
+ *   2. Doesn't walk any list, waiting thread is woken up directly.                                                   *
  *                                                                                                                    *
  **********************************************************************************************************************/
- nOS_Error          nOS_FlagCreate                      (nOS_Flag *flag, nOS_FlagBits flags);
+ nOS_Error          nOS_ThreadNotify                    (nOS_Thread *thread, uint32_t bits, nOS_NotifyAction action);
 
- #if (NOS_CONFIG_FLAG_DELETE_ENABLE > 0)
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Name            : nOS_FlagDelete                                                                                   *
+ * Name            : nOS_ThreadNotifyWait                                                                             *
  *                                                                                                                    *
- * Description     : Delete a flag event object and wake up all waiting threads.                                      *
+ * Description     : Wait until at least one of the masked bits is set in notification value of running thread. On    *
+ *                   success, masked bits are cleared from notification value.                                        *
  *                                                                                                                    *
  * Parameters                                                                                                         *
- *   flag          : Pointer to flag object.                                                                          *
+ *   mask          : Bits to wait for.                                                                                *
+ *   value         : Pointer where to store notification value before masked bits are cleared (can be NULL).          *
+ *   timeout       : Timeout value.                                                                                   *
+ *                     NOS_NO_WAIT                     : Don't wait if no masked bits are set.                        *
+ *                     0 > timeout < NOS_WAIT_INFINITE : Maximum number of ticks to wait until notified.              *
+ *                     NOS_WAIT_INFINITE               : Wait indefinitely until notified.                            *
  *                                                                                                                    *
  * Return          : Error code.                                                                                      *
- *   NOS_OK        : Flag successfully deleted.                                                                       *
- *   NOS_E_INV_OBJ : Pointer to flag object is invalid.                                                               *
- *                                                                                                                    *
- * Notes                                                                                                              *
- *   1. Flag object must be created before, else the behavior is undefined.                                           *
- *   2. Flag object must not be used after deletion, else the behavior is undefined.                                  *
+ *   NOS_OK        : Running thread has been notified.                                                                *
+ *   NOS_E_INV_VAL : Mask is equal to 0.                                                                              *
+ *   NOS_E_AGAIN   : No masked bits set (happens when timeout equal NOS_NO_WAIT).                                     *
+ *   NOS_E_ISR     : Can't wait from interrupt service routine.                                                       *
+ *   NOS_E_LOCKED  : Can't wait from scheduler locked section.                                                        *
+ *   NOS_E_IDLE    : Can't wait from main thread (idle).                                                              *
+ *   NOS_E_TIMEOUT : Running thread has not been notified before reaching timeout.                                    *
  *                                                                                                                    *
  **********************************************************************************************************************/
-  nOS_Error         nOS_FlagDelete                      (nOS_Flag *flag);
- #endif
-
+ nOS_Error          nOS_ThreadNotifyWait                (uint32_t mask, uint32_t *value, nOS_TickCounter timeout);
+#endif
+#if (NOS_CONFIG_THREAD_STATS_ENABLE > 0)
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Name            : nOS_FlagWait                                                                                     *
+ * Name            : nOS_ThreadGetStats                                                                               *
  *                                                                                                                    *
- * Description     : Wait on flag object for given flags. If flags are NOT set, calling thread will be placed in      *
- *                   event's waiting list for number of ticks specified by timeout. If flags are set before end of    *
- *                   timeout, res will contain flags that have awoken the thread. If caller specify                   *
- *                   NOS_FLAG_CLEAR_ON_EXIT, only awoken flags will be cleared.                                       *
+ * Description     : Get execution time statistics of thread.                                                         *
  *                                                                                                                    *
  * Parameters                                                                                                         *
- *   flag          : Pointer to flag object.                                                                          *
- *   flags         : All flags to wait.                                                                               *
- *   res           : Pointer where to store awoken flags if needed.                                                   *
+ *   thread        : Pointer to thread object.                                                                        *
  *                     See note 1                                                                                     *
- *   opt           : Waiting options.                                                                                 *
- *                     NOS_FLAG_WAIT_ALL      : Wait for all flags to be set.                                         *
- *                     NOS_FLAG_WAIT_ANY      : Wait for any flags to be set.                                         *
- *                   Altering options.                                                                                *
- *                     NOS_FLAG_CLEAR_ON_EXIT : Clear awoken flags.                                                   *
- *                       See note 2                                                                                   *
- *   timeout       : Timeout value.                                                                                   *
- *                     NOS_NO_WAIT                     : Don't wait if flags are not set.                             *
- *                     0 > timeout < NOS_WAIT_INFINITE : Maximum number of ticks to wait for flags to be set.         *
- *                     NOS_WAIT_INFINITE               : Wait indefinitely until flags are set.                       *
+ *   stats         : Pointer to statistics structure allocated by the application that will be filled.                *
+ *                     runTime     : Total number of cycles the thread has been running.                              *
+ *                                     See note 2                                                                     *
+ *                     switchCount : Number of times the thread has been switched in.                                 *
+ *                     maxSlice    : Longest number of cycles the thread has run without being switched out.          *
  *                                                                                                                    *
  * Return          : Error code.                                                                                      *
- *   NOS_OK        : Requested flags have been set in required time.                                                  *
- *   NOS_E_INV_OBJ : Pointer to flag object is invalid.                                                               *
- *   NOS_E_AGAIN   : Flags are not in required state (happens when timeout equal NOS_NO_WAIT).                        *
- *   NOS_E_ISR     : Can't wait from interrupt service routine.                                                       *
- *   NOS_E_LOCKED  : Can't wait from scheduler locked section.                                                        *
- *   NOS_E_IDLE    : Can't wait from main thread (idle).                                                              *
- *   NOS_E_TIMEOUT : Flags have not been set before reaching timeout.                                                 *
- *   NOS_E_DELETED : Flag object has been deleted.                                                                    *
+ *   NOS_OK        : Statistics successfully read.                                                                    *
+ *   NOS_E_INV_OBJ : Thread is not created.                                                                           *
+ *   NOS_E_NULL    : Pointer to statistics structure is invalid.                                                      *
  *                                                                                                                    *
  * Notes                                                                                                              *
- *   1. Only valid if returned error code is NOS_OK. Otherwise, res is unchanged.                                     *
- *   2. One waiting option can be OR'ed with altering option if needed.                                               *
+ *   1. If thread is NULL, running thread will be used.                                                               *
+ *   2. Include current time slice if thread is running.                                                              *
+ *   3. CPU usage of a thread is its runTime divided by the sum of runTime of all threads including idle.             *
  *                                                                                                                    *
  **********************************************************************************************************************/
- nOS_Error          nOS_FlagWait                        (nOS_Flag *flag, nOS_FlagBits flags, nOS_FlagBits *res,
-                                                         nOS_FlagOption opt, nOS_TickCounter timeout);
+ nOS_Error          nOS_ThreadGetStats                  (nOS_Thread *thread, nOS_ThreadStats *stats);
 
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Name            : nOS_FlagSend                                                                                     *
+ * Name            : nOS_GetIdleStats                                                                                 *
  *                                                                                                                    *
- * Description     : Set/clear given flags in flag object. Many flags can be set/clear atomically. Just sent flags    *
- *                   can be clear immediately if waiting threads had requested NOS_FLAG_CLEAR_ON_EXIT.                *
+ * Description     : Get execution time statistics of main thread (idle).                                             *
  *                                                                                                                    *
  * Parameters                                                                                                         *
- *   flag          : Pointer to flag object.                                                                          *
- *   flags         : All flags to set/clear depending on mask.                                                        *
- *   mask          : Mask containing which flags to affect. If corresponding bit in flags is 0, this bit will be      *
- *                   cleared. If corresponding bit in flags is 1, this bit will be set.                               *
+ *   stats         : Pointer to statistics structure allocated by the application that will be filled.                *
+ *                     See nOS_ThreadGetStats                                                                         *
  *                                                                                                                    *
  * Return          : Error code.                                                                                      *
- *   NOS_OK        : Flags successfully sent.                                                                         *
- *   NOS_E_INV_OBJ : Pointer to flag object is invalid.                                                               *
+ *   NOS_OK        : Statistics successfully read.                                                                    *
+ *   NOS_E_NULL    : Pointer to statistics structure is invalid.                                                      *
  *                                                                                                                    *
  **********************************************************************************************************************/
- nOS_Error          nOS_FlagSend                        (nOS_Flag *flag, nOS_FlagBits flags, nOS_FlagBits mask);
+ nOS_Error          nOS_GetIdleStats                    (nOS_ThreadStats *stats);
 #endif
-
-#if (NOS_CONFIG_MEM_ENABLE > 0)
+#if (NOS_CONFIG_THREAD_STACK_USAGE_ENABLE > 0)
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Name            : nOS_MemCreate                                                                                    *
+ * Name            : nOS_ThreadGetStackUsage                                                                          *
  *                                                                                                                    *
- * Description     : Create a fixed-sized array of memory block.                                                      *
+ * Description     : Get deepest stack usage of thread found so far by nOS_ThreadScanStack.                           *
  *                                                                                                                    *
  * Parameters                                                                                                         *
- *   mem           : Pointer to mem object allocated by the application.                                              *
- *   buffer        : Pointer to array of memory allocated by the application that will contains all the blocks.       *
- *                     See note 1, 2                                                                                  *
- *   bsize         : Size of one block of memory.                                                                     *
- *                     See note 3                                                                                     *
- *   bmax          : Maximum number of blocks available.                                                              *
- *                     See note 4                                                                                     *
+ *   thread        : Pointer to thread object.                                                                        *
+ *                     See note 1                                                                                     *
  *                                                                                                                    *
- * Return          : Error code.                                                                                      *
- *   NOS_OK        : Memory successfully created.                                                                     *
- *   NOS_E_INV_OBJ : Pointer to mem object is invalid.                                                                *
- *   NOS_E_NULL    : Pointer to array of memory is invalid.                                                           *
- *   NOS_E_INV_VAL : Invalid parameter(s) (too small block size, buffer not aligned in memory and/or no blocks        *
- *                   available).                                                                                      *
+ * Return          : Number of stack words (nOS_Stack) that have been used by thread.                                 *
+ *   0             : Thread is not created, or its stack has not been scanned yet.                                    *
  *                                                                                                                    *
  * Notes                                                                                                              *
- *   1. Shall be large enough to keep bmax blocks of bsize bytes per block.                                           *
- *   2. buffer can't be shared between different mem object.                                                          *
- *   3. Shall be large enough to keep a generic pointer (void*) on target platform.                                   *
- *   4. Shall be higher than 0.                                                                                       *
- *   5. Mem object must be created before using it, otherwise the behavior is undefined.                              *
- *   6. Must be called one time only for each mem object.                                                             *
+ *   1. If thread is NULL, running thread will be used.                                                               *
+ *   2. Remaining margin is stack size given to nOS_ThreadCreate minus returned value.                                *
  *                                                                                                                    *
  **********************************************************************************************************************/
- nOS_Error          nOS_MemCreate                       (nOS_Mem *mem, void *buffer, nOS_MemSize bsize, nOS_MemCounter bmax);
+ size_t             nOS_ThreadGetStackUsage             (nOS_Thread *thread);
 
- #if (NOS_CONFIG_MEM_DELETE_ENABLE > 0)
-  nOS_Error         nOS_MemDelete                       (nOS_Mem *mem);
- #endif
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name        : nOS_ThreadScanStack                                                                                  *
+ *                                                                                                                    *
+ * Description : Verify next NOS_CONFIG_THREAD_STACK_SCAN_WORDS words of stack of current thread to scan, then        *
+ *               move to next thread when its stack usage is known.                                                   *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Should be called from main thread (idle) loop, each call is bounded and never cause latency spikes.           *
+ *   2. Only the part of stack that was unused at previous scan is verified again.                                    *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ void               nOS_ThreadScanStack                 (void);
+#endif
 
+#if (NOS_CONFIG_WAITING_POLICY_ENABLE > 0)
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Name        : nOS_MemAlloc                                                                                         *
+ * Name            : nOS_SetWaitingPolicy                                                                             *
  *                                                                                                                    *
- * Description : Try to take one block from memory array of mem. If no block available, calling thread will be        *
- *               removed from list of ready to run threads and be placed in list of waiting threads for number of     *
- *               ticks specified by timeout. If a block of memory is freed before end of timeout, thread will be      *
- *               awoken and pointer to memory block will be returned.                                                 *
+ * Description     : Select order in which threads waiting on given object will be waked up.                          *
  *                                                                                                                    *
  * Parameters                                                                                                         *
- *   mem       : Pointer to mem object.                                                                               *
- *   timeout   : Timeout value.                                                                                       *
- *                 NOS_NO_WAIT                     : Don't wait if no blocks available.                               *
- *                 0 > timeout < NOS_WAIT_INFINITE : Maximum number of ticks to wait until a block became available.  *
- *                 NOS_WAIT_INFINITE               : Wait indefinitely until a block became available.                *
+ *   object        : Pointer to semaphore, mutex, flag, queue, mem or barrier object.                                 *
+ *   policy        : Waiting policy.                                                                                  *
+ *                     NOS_WAITING_POLICY_FIFO : Threads are waked up in the order they started to wait.              *
+ *                     NOS_WAITING_POLICY_PRIO : Highest priority thread is waked up first.                           *
  *                                                                                                                    *
- * Return      : Pointer to allocated block of memory.                                                                *
- *   == NULL   : No block available.                                                                                  *
- *   != NULL   : Pointer to newly allocated block of memory.                                                          *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Waiting policy successfully changed.                                                             *
+ *   NOS_E_INV_OBJ : Pointer to object is invalid.                                                                    *
+ *   NOS_E_INV_VAL : Waiting policy is invalid.                                                                       *
  *                                                                                                                    *
  * Notes                                                                                                              *
- *   1. Mem object shall be created before trying to allocate a block.                                                *
- *   2. Caller is responsible to free the block when memory is no longer needed.                                      *
+ *   1. Threads already waiting on object are reordered by priority when changing to NOS_WAITING_POLICY_PRIO.         *
+ *   2. Threads already waiting on object keep their current order when changing to NOS_WAITING_POLICY_FIFO.          *
  *                                                                                                                    *
  **********************************************************************************************************************/
- void*              nOS_MemAlloc                        (nOS_Mem *mem, nOS_TickCounter timeout);
+ nOS_Error          nOS_SetWaitingPolicy                (void *object, nOS_WaitingPolicy policy);
+#endif
 
+#if (NOS_CONFIG_SEM_ENABLE > 0)
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Name             : nOS_MemFree                                                                                     *
+ * Name            : nOS_SemCreate                                                                                    *
  *                                                                                                                    *
- * Description      : Free a previously allocated block of memory.                                                    *
+ * Description     : Create a new semaphore object.                                                                   *
  *                                                                                                                    *
  * Parameters                                                                                                         *
- *   mem            : Pointer to mem object.                                                                          *
- *   block          : Pointer to previously allocated block.                                                          *
+ *   sem           : Pointer to semaphore object.                                                                     *
+ *   count         : Initial count of semaphore.                                                                      *
+ *   max           : Maximum count of semaphore.                                                                      *
  *                                                                                                                    *
- * Return           : Error code.                                                                                     *
- *   NOS_OK         : Memory block has been freed with success.                                                       *
- *   NOS_E_INV_OBJ  : Pointer to mem object is invalid.                                                               *
- *   NOS_E_INV_VAL  : Pointer to block is outside mem defined range.                                                  *
- *                      See note 1                                                                                    *
- *   NOS_E_OVERFLOW : Too much block has been freed or block is already free.                                         *
- *                      See note 1, 2                                                                                 *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Semaphore successfully created.                                                                  *
+ *   NOS_E_INV_OBJ : Pointer to semaphore object is invalid.                                                          *
+ *   NOS_E_INV_VAL : Initial count is higher than defined maximum.                                                    *
  *                                                                                                                    *
  * Notes                                                                                                              *
- *   1. Only available if NOS_CONFIG_MEM_SANITY_CHECK_ENABLE is defined to 1.                                         *
- *   2. Never suppose to happen normally, can be a sign of corruption.                                                *
- *   3. Do not continue to use memory block after it has been freed.                                                  *
+ *   1. Semaphore object must be created before using it, else the behavior is undefined.                             *
+ *   2. Must be called one time only for each semaphore object.                                                       *
  *                                                                                                                    *
  **********************************************************************************************************************/
- nOS_Error          nOS_MemFree                         (nOS_Mem *mem, void *block);
+ nOS_Error          nOS_SemCreate                       (nOS_Sem *sem, nOS_SemCounter count, nOS_SemCounter max);
 
+ #if (NOS_CONFIG_SEM_DELETE_ENABLE > 0)
 /**********************************************************************************************************************
  *                                                                                                                    *
- * Name        : nOS_MemIsAvailable                                                                                   *
+ * Name            : nOS_SemDelete                                                                                    *
  *                                                                                                                    *
- * Description : Check if at least one block of memory is available.                                                  *
+ * Description     : Delete semaphore object and wake up all waiting threads if any.                                  *
  *                                                                                                                    *
  * Parameters                                                                                                         *
- *   mem       : Pointer to mem object.                                                                               *
+ *   sem           : Pointer to semaphore object.                                                                     *
  *                                                                                                                    *
- * Return      : Block availability.                                                                                  *
- *   false     : No block of memory is currently available.                                                           *
- *   true      : At least one block of memory is available.                                                           *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Semaphore successfully deleted.                                                                  *
+ *   NOS_E_INV_OBJ : Pointer to semaphore object is invalid.                                                          *
  *                                                                                                                    *
  **********************************************************************************************************************/
- bool               nOS_MemIsAvailable                  (nOS_Mem *mem);
-#endif
-
-#if (NOS_CONFIG_TIMER_ENABLE > 0)
- void               nOS_TimerTick                       (nOS_TickCounter ticks);
- void               nOS_TimerProcess                    (void);
- nOS_Error          nOS_TimerCreate                     (nOS_Timer *timer,
-                                                         nOS_TimerCallback callback,
-                                                         void *arg,
-                                                         nOS_TimerCounter reload,
-                                                         nOS_TimerMode mode
- #if (NOS_CONFIG_TIMER_HIGHEST_PRIO > 0)
-                                                        ,uint8_t prio
- #endif
-                                                        );
- #if (NOS_CONFIG_TIMER_DELETE_ENABLE > 0)
-  nOS_Error         nOS_TimerDelete                     (nOS_Timer *timer);
- #endif
- nOS_Error          nOS_TimerStart                      (nOS_Timer *timer);
- nOS_Error          nOS_TimerStop                       (nOS_Timer *timer, bool instant);
- nOS_Error          nOS_TimerRestart                    (nOS_Timer *timer, nOS_TimerCounter reload);
- nOS_Error          nOS_TimerPause                      (nOS_Timer *timer);
- nOS_Error          nOS_TimerContinue                   (nOS_Timer *timer);
- nOS_Error          nOS_TimerSetReload                  (nOS_Timer *timer, nOS_TimerCounter reload);
- nOS_Error          nOS_TimerSetCallback                (nOS_Timer *timer, nOS_TimerCallback callback, void *arg);
- nOS_Error          nOS_TimerSetMode                    (nOS_Timer *timer, nOS_TimerMode mode);
- #if (NOS_CONFIG_TIMER_HIGHEST_PRIO > 0)
-  nOS_Error         nOS_TimerSetPrio                    (nOS_Timer *timer, uint8_t prio);
+  nOS_Error         nOS_SemDelete                       (nOS_Sem *sem);
  #endif
- bool               nOS_TimerIsRunning                  (nOS_Timer *timer);
-#endif
 
-#if (NOS_CONFIG_SIGNAL_ENABLE > 0)
- void               nOS_SignalProcess                   (void);
- nOS_Error          nOS_SignalCreate                    (nOS_Signal *signal,
-                                                         nOS_SignalCallback callback
- #if (NOS_CONFIG_SIGNAL_HIGHEST_PRIO > 0)
-                                                        ,uint8_t prio
- #endif
-                                                        );
- #if (NOS_CONFIG_SIGNAL_DELETE_ENABLE > 0)
-  nOS_Error         nOS_SignalDelete                    (nOS_Signal *signal);
- #endif
- nOS_Error          nOS_SignalSend                      (nOS_Signal *signal, void *arg);
- nOS_Error          nOS_SignalSetCallback               (nOS_Signal *signal, nOS_SignalCallback callback);
- bool               nOS_SignalIsRaised                  (nOS_Signal *signal);
-#endif
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_SemTake                                                                                      *
+ *                                                                                                                    *
+ * Description     : Take semaphore pointed by object pointer. If not available, calling thread will be placed in     *
+ *                   event's waiting list for number of ticks specified by timeout. If semaphore is not available in  *
+ *                   required time, an error will be returned and semaphore will be left unchanged.                   *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   sem           : Pointer to semaphore object.                                                                     *
+ *   timeout       : Timeout value.                                                                                   *
+ *                     NOS_NO_WAIT                     : Don't wait if the semaphore is not available.                *
+ *                     0 > timeout < NOS_WAIT_INFINITE : Maximum number of ticks to wait for the semaphore to become  *
+ *                                                       available.                                                   *
+ *                     NOS_WAIT_INFINITE               : Wait indefinitely until the semaphore become available.      *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Requested semaphore have been successfully taken.                                                *
+ *   NOS_E_INV_OBJ : Pointer to semaphore object is invalid.                                                          *
+ *   NOS_E_AGAIN   : Semaphore is unavailable (happens when timeout equal NOS_NO_WAIT).                               *
+ *   NOS_E_ISR     : Can't wait from interrupt service routine.                                                       *
+ *   NOS_E_LOCKED  : Can't wait from scheduler locked section.                                                        *
+ *   NOS_E_IDLE    : Can't wait from main thread (idle).                                                              *
+ *   NOS_E_TIMEOUT : Semaphore has not been given before reaching timeout.                                            *
+ *   NOS_E_DELETED : Semaphore object has been deleted.                                                               *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_SemTake                         (nOS_Sem *sem, nOS_TickCounter timeout);
+
+ #if (NOS_CONFIG_SEM_MULTI_ENABLE > 0)
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_SemTakeN                                                                                     *
+ *                                                                                                                    *
+ * Description     : Take n counts of semaphore pointed by object pointer. If not available or if other threads are   *
+ *                   already waiting, calling thread will be placed in event's waiting list for number of ticks       *
+ *                   specified by timeout. If semaphore is not available in required time, an error will be returned  *
+ *                   and semaphore will be left unchanged.                                                            *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   sem           : Pointer to semaphore object.                                                                     *
+ *   n             : Number of counts to take at once.                                                                *
+ *   timeout       : Timeout value.                                                                                   *
+ *                     NOS_NO_WAIT                     : Don't wait if the semaphore is not available.                *
+ *                     0 > timeout < NOS_WAIT_INFINITE : Maximum number of ticks to wait for the semaphore to become  *
+ *                                                       available.                                                   *
+ *                     NOS_WAIT_INFINITE               : Wait indefinitely until the semaphore become available.      *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Requested counts have been successfully taken.                                                   *
+ *   NOS_E_INV_OBJ : Pointer to semaphore object is invalid.                                                          *
+ *   NOS_E_INV_VAL : n is equal to 0 or higher than maximum count of semaphore.                                       *
+ *   NOS_E_AGAIN   : Semaphore is unavailable (happens when timeout equal NOS_NO_WAIT).                               *
+ *   NOS_E_ISR     : Can't wait from interrupt service routine.                                                       *
+ *   NOS_E_LOCKED  : Can't wait from scheduler locked section.                                                        *
+ *   NOS_E_IDLE    : Can't wait from main thread (idle).                                                              *
+ *   NOS_E_TIMEOUT : Semaphore has not been given before reaching timeout.                                            *
+ *   NOS_E_DELETED : Semaphore object has been deleted.                                                               *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+  nOS_Error         nOS_SemTakeN                        (nOS_Sem *sem, nOS_SemCounter n, nOS_TickCounter timeout);
+ #endif
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_SemGive                                                                                      *
+ *                                                                                                                    *
+ * Description     : Give semaphore pointed by object pointer. If a thread is waiting, replace it in ready list with  *
+ *                   operation successfull code. If no thread is waiting, increment semaphore count if lower than     *
+ *                   maximum available count, else return an overflow error.                                          *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   sem           : Pointer to semaphore object.                                                                     *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Requested semaphore have been successfully taken.                                                *
+ *   NOS_E_INV_OBJ : Pointer to semaphore object is invalid.                                                          *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_SemGive                         (nOS_Sem *sem);
+
+ #if (NOS_CONFIG_SEM_MULTI_ENABLE > 0)
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_SemGiveN                                                                                     *
+ *                                                                                                                    *
+ * Description     : Give n counts of semaphore pointed by object pointer. Waiting threads are replaced in ready list *
+ *                   in waiting order as long as given counts are enough for them, then remaining counts are added to *
+ *                   semaphore count. Accounting and wake up are done in a single critical section with only one      *
+ *                   scheduling decision.                                                                             *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   sem           : Pointer to semaphore object.                                                                     *
+ *   n             : Number of counts to give at once.                                                                *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK             : Requested counts have been successfully given.                                              *
+ *   NOS_E_INV_OBJ      : Pointer to semaphore object is invalid.                                                     *
+ *   NOS_E_INV_VAL      : n is equal to 0.                                                                            *
+ *   NOS_E_OVERFLOW     : Semaphore count has reached its maximum, extra counts are lost.                             *
+ *   NOS_E_NO_CONSUMER  : No thread waiting to consume semaphore with maximum count of 0.                             *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Can be called from ISR.                                                                                       *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+  nOS_Error         nOS_SemGiveN                        (nOS_Sem *sem, nOS_SemCounter n);
+ #endif
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_SemIsAvailable                                                                               *
+ *                                                                                                                    *
+ * Description     : Return availability of semaphore.                                                                *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   sem           : Pointer to semaphore object.                                                                     *
+ *                                                                                                                    *
+ * Return          : TRUE if semaphore count is higher than 0, else FALSE.                                            *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ bool               nOS_SemIsAvailable                  (nOS_Sem *sem);
+#endif
+
+#if (NOS_CONFIG_MUTEX_ENABLE > 0)
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_MutexCreate                                                                                  *
+ *                                                                                                                    *
+ * Description     : Create a new mutex object.                                                                       *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   mutex         : Pointer to mutex object.                                                                         *
+ *   type          : Type of mutex to create.                                                                         *
+ *                     NOS_MUTEX_NORMAL    : Standard mutex (like binary semaphore).                                  *
+ *                     NOS_MUTEX_RECURSIVE : Mutex that can be locked recursively.                                    *
+ *   prio          : Priority of mutex.                                                                               *
+ *                     NOS_MUTEX_PRIO_INHERIT : Mutex owner inherit higher prio from other threads that try to lock   *
+ *                                              this mutex.                                                           *
+ *                     prio > 0               : Mutex owner increase its prio to this value when it lock the mutex    *
+ *                                              (immediate ceiling protocol).                                         *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Mutex successfully created.                                                                      *
+ *   NOS_E_INV_OBJ : Pointer to mutex object is invalid.                                                              *
+ *   NOS_E_INV_VAL : Type of mutex is invalid.                                                                        *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Mutex object must be created before using it, else the behavior is undefined.                                 *
+ *   2. Must be called one time only for each mutex object.                                                           *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_MutexCreate                     (nOS_Mutex *mutex,
+                                                         nOS_MutexType type
+ #if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
+                                                        ,uint8_t prio
+ #endif
+                                                        );
+ #if (NOS_CONFIG_MUTEX_DELETE_ENABLE > 0)
+  nOS_Error         nOS_MutexDelete                     (nOS_Mutex *mutex);
+ #endif
+ nOS_Error          nOS_MutexLock                       (nOS_Mutex *mutex, nOS_TickCounter timeout);
+ nOS_Error          nOS_MutexUnlock                     (nOS_Mutex *mutex);
+ bool               nOS_MutexIsLocked                   (nOS_Mutex *mutex);
+ nOS_Thread*        nOS_MutexGetOwner                   (nOS_Mutex *mutex);
+#endif
+
+#if (NOS_CONFIG_RWLOCK_ENABLE > 0)
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_RWLockCreate                                                                                 *
+ *                                                                                                                    *
+ * Description     : Create a new reader-writer lock object. Many readers can own the lock at the same time, or only  *
+ *                   one writer. Readers trying to lock will wait if a writer is already waiting (writer preference). *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   rwlock        : Pointer to rwlock object.                                                                        *
+ *   prio          : Priority of rwlock.                                                                              *
+ *                     NOS_RWLOCK_PRIO_INHERIT : Writer owner inherit higher prio from other threads that try to lock *
+ *                                               this rwlock.                                                         *
+ *                     prio > 0                : Writer owner increase its prio to this value when it lock the rwlock *
+ *                                               (immediate ceiling protocol).                                        *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : RWLock successfully created.                                                                     *
+ *   NOS_E_INV_OBJ : Pointer to rwlock object is invalid.                                                             *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. RWLock object must be created before using it, else the behavior is undefined.                                *
+ *   2. Must be called one time only for each rwlock object.                                                          *
+ *   3. Readers are not tracked individually, so they can't inherit prio from a waiting writer.                       *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_RWLockCreate                    (nOS_RWLock *rwlock
+ #if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
+                                                        ,uint8_t prio
+ #endif
+                                                        );
+ #if (NOS_CONFIG_RWLOCK_DELETE_ENABLE > 0)
+  nOS_Error         nOS_RWLockDelete                    (nOS_RWLock *rwlock);
+ #endif
+ nOS_Error          nOS_RWLockReadLock                  (nOS_RWLock *rwlock, nOS_TickCounter timeout);
+ nOS_Error          nOS_RWLockReadUnlock                (nOS_RWLock *rwlock);
+ nOS_Error          nOS_RWLockWriteLock                 (nOS_RWLock *rwlock, nOS_TickCounter timeout);
+ nOS_Error          nOS_RWLockWriteUnlock               (nOS_RWLock *rwlock);
+ nOS_RWLockCounter  nOS_RWLockGetReaders                (nOS_RWLock *rwlock);
+ nOS_Thread*        nOS_RWLockGetOwner                  (nOS_RWLock *rwlock);
+#endif
+
+#if (NOS_CONFIG_QUEUE_ENABLE > 0)
+ nOS_Error          nOS_QueueCreate                     (nOS_Queue *queue, void *buffer, nOS_QueueSize bsize, nOS_QueueCounter bmax);
+ #if (NOS_CONFIG_QUEUE_DELETE_ENABLE > 0)
+  nOS_Error         nOS_QueueDelete                     (nOS_Queue *queue);
+ #endif
+ nOS_Error          nOS_QueueRead                       (nOS_Queue *queue, void *block, nOS_TickCounter timeout);
+ nOS_Error          nOS_QueuePeek                       (nOS_Queue *queue, void *block);
+ nOS_Error          nOS_QueueWrite                      (nOS_Queue *queue, void *block, nOS_TickCounter timeout);
+ #if (NOS_CONFIG_QUEUE_ZERO_COPY_ENABLE > 0)
+  nOS_Error         nOS_QueueWriteReserve               (nOS_Queue *queue, void **block, nOS_TickCounter timeout);
+  nOS_Error         nOS_QueueWriteCommit                (nOS_Queue *queue, void *block);
+  nOS_Error         nOS_QueueReadAcquire                (nOS_Queue *queue, void **block, nOS_TickCounter timeout);
+  nOS_Error         nOS_QueueReadRelease                (nOS_Queue *queue, void *block);
+ #endif
+ #if (NOS_CONFIG_QUEUE_MULTI_ENABLE > 0)
+  nOS_Error         nOS_QueueReadN                      (nOS_Queue *queue, void *blocks, nOS_QueueCounter n, nOS_QueueCounter *count, nOS_TickCounter timeout);
+  nOS_Error         nOS_QueueWriteN                     (nOS_Queue *queue, void *blocks, nOS_QueueCounter n, nOS_QueueCounter *count, nOS_TickCounter timeout);
+ #endif
+ #if (NOS_CONFIG_QUEUE_OVERWRITE_ENABLE > 0)
+  nOS_Error         nOS_QueueSetOverwrite               (nOS_Queue *queue, bool overwrite);
+ #endif
+ nOS_Error          nOS_QueueFlush                      (nOS_Queue *queue, nOS_QueueCallback callback);
+ bool               nOS_QueueIsEmpty                    (nOS_Queue *queue);
+ bool               nOS_QueueIsFull                     (nOS_Queue *queue);
+ nOS_QueueCounter   nOS_QueueGetCount                   (nOS_Queue *queue);
+#endif
+
+#if (NOS_CONFIG_STREAM_ENABLE > 0)
+ nOS_Error          nOS_StreamCreate                    (nOS_Stream *stream, void *buffer, nOS_StreamCounter bsize, nOS_StreamCounter bmax);
+ #if (NOS_CONFIG_STREAM_DELETE_ENABLE > 0)
+  nOS_Error         nOS_StreamDelete                    (nOS_Stream *stream);
+ #endif
+ nOS_Error          nOS_StreamWrite                     (nOS_Stream *stream, void *block);
+ nOS_Error          nOS_StreamRead                      (nOS_Stream *stream, void *block, nOS_TickCounter timeout);
+ nOS_StreamCounter  nOS_StreamGetCount                  (nOS_Stream *stream);
+#endif
+
+#if (NOS_CONFIG_MBOX_ENABLE > 0)
+ nOS_Error          nOS_MboxCreate                      (nOS_Mbox *mbox, void **buffer, nOS_MboxCounter bmax);
+ #if (NOS_CONFIG_MBOX_DELETE_ENABLE > 0)
+  nOS_Error         nOS_MboxDelete                      (nOS_Mbox *mbox);
+ #endif
+ nOS_Error          nOS_MboxRead                        (nOS_Mbox *mbox, void **msg, nOS_TickCounter timeout);
+ nOS_Error          nOS_MboxWrite                       (nOS_Mbox *mbox, void *msg, nOS_TickCounter timeout);
+ #if (NOS_CONFIG_MEM_ENABLE > 0)
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_MboxWriteMem                                                                                 *
+ *                                                                                                                    *
+ * Description     : Allocate a block from mem object, fill it with callback and write its pointer in mailbox. Block  *
+ *                   is given back to mem object if it can't be written in mailbox.                                   *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   mbox          : Pointer to mailbox object.                                                                       *
+ *   mem           : Pointer to mem object used to allocate message block.                                            *
+ *   callback      : Pointer to function called to fill message block before writing it (called outside of critical   *
+ *                   section).                                                                                        *
+ *   timeout       : Timeout value, used for both allocation of block and write in mailbox.                           *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Message block successfully written in mailbox.                                                   *
+ *   NOS_E_INV_OBJ : Pointer to mailbox or mem object is invalid.                                                     *
+ *   NOS_E_NULL    : Pointer to callback is invalid.                                                                  *
+ *   NOS_E_EMPTY   : No block available in mem object.                                                                *
+ *   NOS_E_FULL    : Mailbox is full (happens when timeout equal NOS_NO_WAIT).                                        *
+ *   NOS_E_TIMEOUT : Mailbox is still full after waiting required time.                                               *
+ *   NOS_E_DELETED : Mailbox object has been deleted.                                                                 *
+ *   Also any error returned by nOS_MboxWrite.                                                                        *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+  nOS_Error         nOS_MboxWriteMem                    (nOS_Mbox *mbox, nOS_Mem *mem, nOS_MboxCallback callback, nOS_TickCounter timeout);
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_MboxReadMem                                                                                  *
+ *                                                                                                                    *
+ * Description     : Read a message block pointer from mailbox, consume it with callback and give it back to mem      *
+ *                   object.                                                                                          *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   mbox          : Pointer to mailbox object.                                                                       *
+ *   mem           : Pointer to mem object that own message blocks.                                                   *
+ *   callback      : Pointer to function called to consume message block before freeing it (called outside of         *
+ *                   critical section). Can be NULL to discard message.                                               *
+ *   timeout       : Timeout value.                                                                                   *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Message block successfully read and freed.                                                       *
+ *   NOS_E_INV_OBJ : Pointer to mailbox or mem object is invalid.                                                     *
+ *   NOS_E_EMPTY   : Mailbox is empty (happens when timeout equal NOS_NO_WAIT).                                       *
+ *   NOS_E_TIMEOUT : Mailbox is still empty after waiting required time.                                              *
+ *   NOS_E_DELETED : Mailbox object has been deleted.                                                                 *
+ *   Also any error returned by nOS_MboxRead or nOS_MemFree.                                                          *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+  nOS_Error         nOS_MboxReadMem                     (nOS_Mbox *mbox, nOS_Mem *mem, nOS_MboxCallback callback, nOS_TickCounter timeout);
+ #endif
+ bool               nOS_MboxIsEmpty                     (nOS_Mbox *mbox);
+ bool               nOS_MboxIsFull                      (nOS_Mbox *mbox);
+ nOS_MboxCounter    nOS_MboxGetCount                    (nOS_Mbox *mbox);
+#endif
+
+#if (NOS_CONFIG_MSGQUEUE_ENABLE > 0)
+ nOS_Error          nOS_MsgQueueCreate                  (nOS_MsgQueue *msgq);
+ #if (NOS_CONFIG_MSGQUEUE_DELETE_ENABLE > 0)
+  nOS_Error         nOS_MsgQueueDelete                  (nOS_MsgQueue *msgq);
+ #endif
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_MsgQueueSend                                                                                 *
+ *                                                                                                                    *
+ * Description     : Send a message in message queue. Message is given directly to first waiting thread if any,       *
+ *                   else it is linked at the end of the queue with given node. Never wait, queue is never full.      *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   msgq          : Pointer to message queue object.                                                                 *
+ *   node          : Pointer to node used to link message in queue (usually embedded in message).                     *
+ *   msg           : Pointer to message.                                                                              *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Message successfully sent.                                                                       *
+ *   NOS_E_INV_OBJ : Pointer to message queue object is invalid.                                                      *
+ *   NOS_E_NULL    : Pointer to node is invalid.                                                                      *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Node must not be modified and must stay valid until message is received.                                      *
+ *   2. Can be called from ISR.                                                                                       *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_MsgQueueSend                    (nOS_MsgQueue *msgq, nOS_Node *node, void *msg);
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_MsgQueueReceive                                                                              *
+ *                                                                                                                    *
+ * Description     : Receive oldest message from message queue. If queue is empty, calling thread will be placed in   *
+ *                   event's waiting list for number of ticks specified by timeout.                                   *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   msgq          : Pointer to message queue object.                                                                 *
+ *   msg           : Pointer where to store pointer to received message.                                              *
+ *   timeout       : Timeout value.                                                                                   *
+ *                     NOS_NO_WAIT                     : Don't wait if queue is empty.                                *
+ *                     0 > timeout < NOS_WAIT_INFINITE : Maximum number of ticks to wait until a message is sent.     *
+ *                     NOS_WAIT_INFINITE               : Wait indefinitely until a message is sent.                   *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Message successfully received, its node can be reused.                                           *
+ *   NOS_E_INV_OBJ : Pointer to message queue object is invalid.                                                      *
+ *   NOS_E_NULL    : Pointer to message pointer is invalid.                                                           *
+ *   NOS_E_EMPTY   : Queue is empty (happens when timeout equal NOS_NO_WAIT).                                         *
+ *   NOS_E_ISR     : Can't wait from interrupt service routine.                                                       *
+ *   NOS_E_LOCKED  : Can't wait from scheduler locked section.                                                        *
+ *   NOS_E_IDLE    : Can't wait from main thread (idle).                                                              *
+ *   NOS_E_TIMEOUT : No message sent before reaching timeout.                                                         *
+ *   NOS_E_DELETED : Message queue object has been deleted.                                                           *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_MsgQueueReceive                 (nOS_MsgQueue *msgq, void **msg, nOS_TickCounter timeout);
+ bool               nOS_MsgQueueIsEmpty                 (nOS_MsgQueue *msgq);
+#endif
+
+#if (NOS_CONFIG_FLAG_ENABLE > 0)
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_FlagCreate                                                                                   *
+ *                                                                                                                    *
+ * Description     : Create a flag event object and initialize it with given flags.                                   *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   flag          : Pointer to flag object.                                                                          *
+ *   flags         : Initial values.                                                                                  *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Flag successfully created.                                                                       *
+ *   NOS_E_INV_OBJ : Pointer to flag object is invalid.                                                               *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Flag object must be created before using it, else the behavior is undefined.                                  *
+ *   2. Must be called one time only for each flag object.                                                            *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_FlagCreate                      (nOS_Flag *flag, nOS_FlagBits flags);
+
+ #if (NOS_CONFIG_FLAG_DELETE_ENABLE > 0)
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_FlagDelete                                                                                   *
+ *                                                                                                                    *
+ * Description     : Delete a flag event object and wake up all waiting threads.                                      *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   flag          : Pointer to flag object.                                                                          *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Flag successfully deleted.                                                                       *
+ *   NOS_E_INV_OBJ : Pointer to flag object is invalid.                                                               *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Flag object must be created before, else the behavior is undefined.                                           *
+ *   2. Flag object must not be used after deletion, else the behavior is undefined.                                  *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+  nOS_Error         nOS_FlagDelete                      (nOS_Flag *flag);
+ #endif
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_FlagWait                                                                                     *
+ *                                                                                                                    *
+ * Description     : Wait on flag object for given flags. If flags are NOT set, calling thread will be placed in      *
+ *                   event's waiting list for number of ticks specified by timeout. If flags are set before end of    *
+ *                   timeout, res will contain flags that have awoken the thread. If caller specify                   *
+ *                   NOS_FLAG_CLEAR_ON_EXIT, only awoken flags will be cleared.                                       *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   flag          : Pointer to flag object.                                                                          *
+ *   flags         : All flags to wait.                                                                               *
+ *   res           : Pointer where to store awoken flags if needed.                                                   *
+ *                     See note 1                                                                                     *
+ *   opt           : Waiting options.                                                                                 *
+ *                     NOS_FLAG_WAIT_ALL      : Wait for all flags to be set.                                         *
+ *                     NOS_FLAG_WAIT_ANY      : Wait for any flags to be set.                                         *
+ *                   Altering options.                                                                                *
+ *                     NOS_FLAG_CLEAR_ON_EXIT : Clear awoken flags.                                                   *
+ *                       See note 2                                                                                   *
+ *   timeout       : Timeout value.                                                                                   *
+ *                     NOS_NO_WAIT                     : Don't wait if flags are not set.                             *
+ *                     0 > timeout < NOS_WAIT_INFINITE : Maximum number of ticks to wait for flags to be set.         *
+ *                     NOS_WAIT_INFINITE               : Wait indefinitely until flags are set.                       *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Requested flags have been set in required time.                                                  *
+ *   NOS_E_INV_OBJ : Pointer to flag object is invalid.                                                               *
+ *   NOS_E_AGAIN   : Flags are not in required state (happens when timeout equal NOS_NO_WAIT).                        *
+ *   NOS_E_ISR     : Can't wait from interrupt service routine.                                                       *
+ *   NOS_E_LOCKED  : Can't wait from scheduler locked section.                                                        *
+ *   NOS_E_IDLE    : Can't wait from main thread (idle).                                                              *
+ *   NOS_E_TIMEOUT : Flags have not been set before reaching timeout.                                                 *
+ *   NOS_E_DELETED : Flag object has been deleted.                                                                    *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Only valid if returned error code is NOS_OK. Otherwise, res is unchanged.                                     *
+ *   2. One waiting option can be OR'ed with altering option if needed.                                               *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_FlagWait                        (nOS_Flag *flag, nOS_FlagBits flags, nOS_FlagBits *res,
+                                                         nOS_FlagOption opt, nOS_TickCounter timeout);
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_FlagSend                                                                                     *
+ *                                                                                                                    *
+ * Description     : Set/clear given flags in flag object. Many flags can be set/clear atomically. Just sent flags    *
+ *                   can be clear immediately if waiting threads had requested NOS_FLAG_CLEAR_ON_EXIT.                *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   flag          : Pointer to flag object.                                                                          *
+ *   flags         : All flags to set/clear depending on mask.                                                        *
+ *   mask          : Mask containing which flags to affect. If corresponding bit in flags is 0, this bit will be      *
+ *                   cleared. If corresponding bit in flags is 1, this bit will be set.                               *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Flags successfully sent.                                                                         *
+ *   NOS_E_INV_OBJ : Pointer to flag object is invalid.                                                               *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. List of waiting threads is walked only if at least one thread is waiting on flags that are set.               *
+ *   2. On ports with exclusive load/store (NOS_USE_EXCLUSIVE) and 32 bits flags, flags are updated without           *
+ *      entering critical section if no waiting thread can be awoken.                                                 *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_FlagSend                        (nOS_Flag *flag, nOS_FlagBits flags, nOS_FlagBits mask);
+#endif
+
+#if (NOS_CONFIG_MEM_ENABLE > 0)
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_MemCreate                                                                                    *
+ *                                                                                                                    *
+ * Description     : Create a fixed-sized array of memory block.                                                      *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   mem           : Pointer to mem object allocated by the application.                                              *
+ *   buffer        : Pointer to array of memory allocated by the application that will contains all the blocks.       *
+ *                     See note 1, 2                                                                                  *
+ *   bsize         : Size of one block of memory.                                                                     *
+ *                     See note 3                                                                                     *
+ *   bmax          : Maximum number of blocks available.                                                              *
+ *                     See note 4                                                                                     *
+ *   bitmap        : Pointer to array of NOS_MEM_BITMAP_SIZE(bmax) bytes allocated by the application used to keep    *
+ *                   track of allocated blocks.                                                                       *
+ *                     See note 7                                                                                     *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Memory successfully created.                                                                     *
+ *   NOS_E_INV_OBJ : Pointer to mem object is invalid.                                                                *
+ *   NOS_E_NULL    : Pointer to array of memory or to bitmap is invalid.                                              *
+ *   NOS_E_INV_VAL : Invalid parameter(s) (too small block size, buffer not aligned in memory and/or no blocks        *
+ *                   available).                                                                                      *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Shall be large enough to keep bmax blocks of bsize bytes per block.                                           *
+ *   2. buffer can't be shared between different mem object.                                                          *
+ *   3. Shall be large enough to keep a generic pointer (void*) on target platform.                                   *
+ *   4. Shall be higher than 0.                                                                                       *
+ *   5. Mem object must be created before using it, otherwise the behavior is undefined.                              *
+ *   6. Must be called one time only for each mem object.                                                             *
+ *   7. Only available if NOS_CONFIG_MEM_BITMAP_ENABLE is defined to 1. Allow to detect a block freed twice in        *
+ *      constant time instead of walking the list of free blocks.                                                     *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_MemCreate                       (nOS_Mem *mem,
+                                                         void *buffer,
+                                                         nOS_MemSize bsize,
+                                                         nOS_MemCounter bmax
+ #if (NOS_CONFIG_MEM_BITMAP_ENABLE > 0)
+                                                        ,void *bitmap
+ #endif
+                                                        );
+
+ #if (NOS_CONFIG_MEM_DELETE_ENABLE > 0)
+  nOS_Error         nOS_MemDelete                       (nOS_Mem *mem);
+ #endif
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name        : nOS_MemAlloc                                                                                         *
+ *                                                                                                                    *
+ * Description : Try to take one block from memory array of mem. If no block available, calling thread will be        *
+ *               removed from list of ready to run threads and be placed in list of waiting threads for number of     *
+ *               ticks specified by timeout. If a block of memory is freed before end of timeout, thread will be      *
+ *               awoken and pointer to memory block will be returned.                                                 *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   mem       : Pointer to mem object.                                                                               *
+ *   timeout   : Timeout value.                                                                                       *
+ *                 NOS_NO_WAIT                     : Don't wait if no blocks available.                               *
+ *                 0 > timeout < NOS_WAIT_INFINITE : Maximum number of ticks to wait until a block became available.  *
+ *                 NOS_WAIT_INFINITE               : Wait indefinitely until a block became available.                *
+ *                                                                                                                    *
+ * Return      : Pointer to allocated block of memory.                                                                *
+ *   == NULL   : No block available.                                                                                  *
+ *   != NULL   : Pointer to newly allocated block of memory.                                                          *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Mem object shall be created before trying to allocate a block.                                                *
+ *   2. Caller is responsible to free the block when memory is no longer needed.                                      *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ void*              nOS_MemAlloc                        (nOS_Mem *mem, nOS_TickCounter timeout);
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name             : nOS_MemFree                                                                                     *
+ *                                                                                                                    *
+ * Description      : Free a previously allocated block of memory.                                                    *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   mem            : Pointer to mem object.                                                                          *
+ *   block          : Pointer to previously allocated block.                                                          *
+ *                                                                                                                    *
+ * Return           : Error code.                                                                                     *
+ *   NOS_OK         : Memory block has been freed with success.                                                       *
+ *   NOS_E_INV_OBJ  : Pointer to mem object is invalid.                                                               *
+ *   NOS_E_INV_VAL  : Pointer to block is outside mem defined range.                                                  *
+ *                      See note 1                                                                                    *
+ *   NOS_E_OVERFLOW : Too much block has been freed or block is already free.                                         *
+ *                      See note 1, 2                                                                                 *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Only available if NOS_CONFIG_MEM_SANITY_CHECK_ENABLE is defined to 1.                                         *
+ *   2. Never suppose to happen normally, can be a sign of corruption.                                                *
+ *   3. Do not continue to use memory block after it has been freed.                                                  *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_MemFree                         (nOS_Mem *mem, void *block);
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name        : nOS_MemIsAvailable                                                                                   *
+ *                                                                                                                    *
+ * Description : Check if at least one block of memory is available.                                                  *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   mem       : Pointer to mem object.                                                                               *
+ *                                                                                                                    *
+ * Return      : Block availability.                                                                                  *
+ *   false     : No block of memory is currently available.                                                           *
+ *   true      : At least one block of memory is available.                                                           *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ bool               nOS_MemIsAvailable                  (nOS_Mem *mem);
+
+ #if (NOS_CONFIG_MEM_STATS_ENABLE > 0)
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_MemGetStats                                                                                  *
+ *                                                                                                                    *
+ * Description     : Get usage statistics of mem object.                                                              *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   mem           : Pointer to mem object.                                                                           *
+ *   stats         : Pointer to statistics structure allocated by the application that will be filled.                *
+ *                     bmax      : Maximum number of blocks available.                                                *
+ *                     bcount    : Number of blocks currently free.                                                   *
+ *                     bpeak     : Maximum number of blocks allocated at the same time (high-water mark).             *
+ *                     allocFail : Number of allocations that returned without block (no wait or timeout).            *
+ *                     freeFail  : Number of blocks that failed to be freed.                                          *
+ *                                   See note 1                                                                       *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Statistics successfully read.                                                                    *
+ *   NOS_E_INV_OBJ : Pointer to mem object is invalid.                                                                *
+ *   NOS_E_NULL    : Pointer to statistics structure is invalid.                                                      *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Always 0 if NOS_CONFIG_MEM_SANITY_CHECK_ENABLE is defined to 0.                                               *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+  nOS_Error         nOS_MemGetStats                     (nOS_Mem *mem, nOS_MemStats *stats);
+ #endif
+
+ #if (NOS_CONFIG_MEM_CACHE_ENABLE > 0)
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_MemCacheCreate                                                                               *
+ *                                                                                                                    *
+ * Description     : Create a local cache of blocks in front of a mem object. Blocks are allocated from and freed to  *
+ *                   the cache without entering critical section, and are moved from/to the mem object in batch of    *
+ *                   half the cache size.                                                                             *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   cache         : Pointer to cache object allocated by the application.                                            *
+ *   mem           : Pointer to mem object from which blocks are taken.                                               *
+ *   bmax          : Maximum number of blocks kept in cache.                                                          *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Cache successfully created.                                                                      *
+ *   NOS_E_INV_OBJ : Pointer to cache object or to mem object is invalid.                                             *
+ *   NOS_E_INV_VAL : Maximum number of blocks is 0.                                                                   *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. A cache object shall be used by only one thread, never from ISR.                                              *
+ *   2. Blocks kept in cache are seen as allocated by the mem object.                                                 *
+ *   3. Sanity check of freed blocks (if enabled) is done when blocks are given back to the mem object.               *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+  nOS_Error         nOS_MemCacheCreate                  (nOS_MemCache *cache, nOS_Mem *mem, uint8_t bmax);
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name        : nOS_MemCacheAlloc                                                                                    *
+ *                                                                                                                    *
+ * Description : Take one block from cache. If cache is empty, refill it from mem object. If no block is              *
+ *               available in mem object, calling thread will wait like nOS_MemAlloc.                                 *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   cache     : Pointer to cache object.                                                                             *
+ *   timeout   : Timeout value.                                                                                       *
+ *                 NOS_NO_WAIT                     : Don't wait if no blocks available.                               *
+ *                 0 > timeout < NOS_WAIT_INFINITE : Maximum number of ticks to wait until a block became available.  *
+ *                 NOS_WAIT_INFINITE               : Wait indefinitely until a block became available.                *
+ *                                                                                                                    *
+ * Return      : Pointer to allocated block of memory.                                                                *
+ *   == NULL   : No block available.                                                                                  *
+ *   != NULL   : Pointer to newly allocated block of memory.                                                          *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+  void*             nOS_MemCacheAlloc                   (nOS_MemCache *cache, nOS_TickCounter timeout);
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name             : nOS_MemCacheFree                                                                                *
+ *                                                                                                                    *
+ * Description      : Free a block to cache. If cache is full, half of it is given back to mem object. If a thread is *
+ *                    waiting on mem object, block is given back directly to mem object.                              *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   cache          : Pointer to cache object.                                                                        *
+ *   block          : Pointer to previously allocated block.                                                          *
+ *                                                                                                                    *
+ * Return           : Error code.                                                                                     *
+ *   NOS_OK         : Memory block has been freed with success.                                                       *
+ *   NOS_E_INV_OBJ  : Pointer to cache object is invalid.                                                             *
+ *   NOS_E_INV_VAL  : Pointer to block is outside mem defined range.                                                  *
+ *                      See note 1                                                                                    *
+ *   NOS_E_OVERFLOW : Too much block has been freed or block is already free.                                         *
+ *                      See note 1                                                                                    *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Only available if NOS_CONFIG_MEM_SANITY_CHECK_ENABLE is defined to 1. Invalid block is dropped.               *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+  nOS_Error         nOS_MemCacheFree                    (nOS_MemCache *cache, void *block);
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name             : nOS_MemCacheFlush                                                                               *
+ *                                                                                                                    *
+ * Description      : Give back all blocks kept in cache to mem object.                                               *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   cache          : Pointer to cache object.                                                                        *
+ *                                                                                                                    *
+ * Return           : Error code.                                                                                     *
+ *   NOS_OK         : All blocks have been given back with success.                                                   *
+ *   NOS_E_INV_OBJ  : Pointer to cache object is invalid.                                                             *
+ *   NOS_E_INV_VAL  : At least one block is outside mem defined range.                                                *
+ *                      See note 1                                                                                    *
+ *   NOS_E_OVERFLOW : At least one block is already free.                                                             *
+ *                      See note 1                                                                                    *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Only available if NOS_CONFIG_MEM_SANITY_CHECK_ENABLE is defined to 1. Invalid block is dropped.               *
+ *   2. Shall be called before deleting the thread that own the cache, otherwise cached blocks are lost.              *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+  nOS_Error         nOS_MemCacheFlush                   (nOS_MemCache *cache);
+ #endif
+
+ #if (NOS_CONFIG_HEAP_ENABLE > 0)
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_HeapCreate                                                                                   *
+ *                                                                                                                    *
+ * Description     : Create a variable-sized allocator from an array of fixed-sized mem objects (size classes).       *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   heap          : Pointer to heap object allocated by the application.                                             *
+ *   classes       : Pointer to array of size classes allocated and initialized by the application.                   *
+ *                     See note 1, 2                                                                                  *
+ *   ccount        : Number of size classes in array.                                                                 *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Heap successfully created.                                                                       *
+ *   NOS_E_INV_OBJ : Pointer to heap object is invalid or one of the mem objects is already created.                  *
+ *   NOS_E_NULL    : Pointer to array of size classes or to one of memory array is invalid.                           *
+ *   NOS_E_INV_VAL : Invalid parameter(s) (no size classes, size classes not sorted by block size or invalid          *
+ *                   mem parameters).                                                                                 *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Application shall set buffer, bsize, bmax (and bitmap if NOS_CONFIG_MEM_BITMAP_ENABLE is defined to 1)        *
+ *      of each size class, mem object of each size class will be created with these parameters.                      *
+ *   2. Size classes shall be sorted by block size from the smallest to the largest.                                  *
+ *   3. Heap object must be created before using it, otherwise the behavior is undefined.                             *
+ *   4. Must be called one time only for each heap object.                                                            *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+  nOS_Error         nOS_HeapCreate                      (nOS_Heap *heap, nOS_HeapClass *classes, uint8_t ccount);
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name        : nOS_HeapAlloc                                                                                        *
+ *                                                                                                                    *
+ * Description : Take one block from the smallest size class that can keep size bytes. If no block available,         *
+ *               try larger size classes (if NOS_CONFIG_HEAP_FALLBACK_ENABLE is defined to 1), otherwise calling      *
+ *               thread will wait on smallest fitting size class like nOS_MemAlloc.                                   *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   heap      : Pointer to heap object.                                                                              *
+ *   size      : Number of bytes needed.                                                                              *
+ *   timeout   : Timeout value.                                                                                       *
+ *                 NOS_NO_WAIT                     : Don't wait if no blocks available.                               *
+ *                 0 > timeout < NOS_WAIT_INFINITE : Maximum number of ticks to wait until a block became available.  *
+ *                 NOS_WAIT_INFINITE               : Wait indefinitely until a block became available.                *
+ *                                                                                                                    *
+ * Return      : Pointer to allocated block of memory.                                                                *
+ *   == NULL   : No block available or size is larger than largest size class.                                        *
+ *   != NULL   : Pointer to newly allocated block of memory.                                                          *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Caller is responsible to free the block with nOS_HeapFree when memory is no longer needed.                    *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+  void*             nOS_HeapAlloc                       (nOS_Heap *heap, size_t size, nOS_TickCounter timeout);
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name             : nOS_HeapFree                                                                                    *
+ *                                                                                                                    *
+ * Description      : Free a previously allocated block of memory to the size class it comes from.                    *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   heap           : Pointer to heap object.                                                                         *
+ *   block          : Pointer to previously allocated block.                                                          *
+ *                                                                                                                    *
+ * Return           : Error code.                                                                                     *
+ *   NOS_OK         : Memory block has been freed with success.                                                       *
+ *   NOS_E_INV_OBJ  : Pointer to heap object is invalid.                                                              *
+ *   NOS_E_INV_VAL  : Pointer to block is outside of all size classes.                                                *
+ *   NOS_E_OVERFLOW : Too much block has been freed or block is already free.                                         *
+ *                      See note 1                                                                                    *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Only available if NOS_CONFIG_MEM_SANITY_CHECK_ENABLE is defined to 1.                                         *
+ *   2. Do not continue to use memory block after it has been freed.                                                  *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+  nOS_Error         nOS_HeapFree                        (nOS_Heap *heap, void *block);
+ #endif
+#endif
+
+#if (NOS_CONFIG_TIMER_ENABLE > 0)
+ void               nOS_TimerTick                       (nOS_TickCounter ticks);
+ void               nOS_TimerProcess                    (void);
+ uint8_t            nOS_TimerProcessBatch               (void);
+ nOS_Error          nOS_TimerCreate                     (nOS_Timer *timer,
+                                                         nOS_TimerCallback callback,
+                                                         void *arg,
+                                                         nOS_TimerCounter reload,
+                                                         nOS_TimerMode mode
+ #if (NOS_CONFIG_TIMER_HIGHEST_PRIO > 0)
+                                                        ,uint8_t prio
+ #endif
+ #if (NOS_CONFIG_TIMER_SLACK_ENABLE > 0)
+                                                        ,nOS_TimerCounter slack
+ #endif
+                                                        );
+ #if (NOS_CONFIG_TIMER_DELETE_ENABLE > 0)
+  nOS_Error         nOS_TimerDelete                     (nOS_Timer *timer);
+ #endif
+ nOS_Error          nOS_TimerStart                      (nOS_Timer *timer);
+ nOS_Error          nOS_TimerStop                       (nOS_Timer *timer, bool instant);
+ nOS_Error          nOS_TimerRestart                    (nOS_Timer *timer, nOS_TimerCounter reload);
+ nOS_Error          nOS_TimerPause                      (nOS_Timer *timer);
+ nOS_Error          nOS_TimerContinue                   (nOS_Timer *timer);
+ nOS_Error          nOS_TimerSetReload                  (nOS_Timer *timer, nOS_TimerCounter reload);
+ nOS_Error          nOS_TimerSetCallback                (nOS_Timer *timer, nOS_TimerCallback callback, void *arg);
+ nOS_Error          nOS_TimerSetMode                    (nOS_Timer *timer, nOS_TimerMode mode);
+ #if (NOS_CONFIG_TIMER_HIGHEST_PRIO > 0)
+  nOS_Error         nOS_TimerSetPrio                    (nOS_Timer *timer, uint8_t prio);
+ #endif
+ #if (NOS_CONFIG_TIMER_SLACK_ENABLE > 0)
+  nOS_Error         nOS_TimerSetSlack                   (nOS_Timer *timer, nOS_TimerCounter slack);
+ #endif
+ bool               nOS_TimerIsRunning                  (nOS_Timer *timer);
+#endif
+
+#if (NOS_CONFIG_HRTIMER_ENABLE > 0)
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * High resolution timers                                                                                             *
+ *                                                                                                                    *
+ * Deadlines are counted on a free running 32 bits hardware counter at NOS_CONFIG_HRTIMER_FREQUENCY, independently of *
+ * ticks. Active timers are kept sorted by deadline and only nearest one is programmed in a compare interrupt, so     *
+ * resolution is the one of hardware counter without raising tick rate. Callbacks are called from compare interrupt.  *
+ *                                                                                                                    *
+ * Delays and periods are given in counts of hardware counter and must be lower than 2^31 counts. Use                 *
+ * NOS_HRTIMER_US(us) to convert microseconds.                                                                        *
+ *                                                                                                                    *
+ * Only nOS_HrTimer objects and nOS_HrSleep use this counter. nOS_Timer, nOS_Sleep and timeouts of all waiting        *
+ * functions stay counted in ticks.                                                                                   *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+#define NOS_HRTIMER_US(us)                  ((uint32_t)(((uint64_t)(us) * NOS_CONFIG_HRTIMER_FREQUENCY) / 1000000UL))
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_HrTimerReadCounter                                                                           *
+ *                                                                                                                    *
+ * Description     : Read free running counter of high resolution timer.                                              *
+ *                                                                                                                    *
+ * Return          : Current value of counter.                                                                        *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Implemented by port if it has a generic timer (POSIX), else by the application with an hardware timer of the  *
+ *      MCU (see examples/HrTimer for a reference with STM32F4 TIM2). Counter must use its full 32 bits range.        *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ uint32_t           nOS_HrTimerReadCounter              (void);
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_HrTimerSetCompare                                                                            *
+ *                                                                                                                    *
+ * Description     : Program compare interrupt of high resolution timer to occur when counter reach given value.      *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   count         : Value of counter when compare interrupt must occur.                                              *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Implemented by port if it has a generic timer (POSIX), else by the application with an hardware timer of the  *
+ *      MCU (see examples/HrTimer for a reference with STM32F4 TIM2).                                                 *
+ *   2. Called from critical section. If count is already reached, interrupt must be pended immediately.              *
+ *   3. Compare interrupt handler must call nOS_HrTimerIsr, between nOS_EnterIsr and nOS_LeaveIsr (NOS_ISR).          *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ void               nOS_HrTimerSetCompare               (uint32_t count);
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_HrTimerIsr                                                                                   *
+ *                                                                                                                    *
+ * Description     : Call callbacks of all expired high resolution timers, reload periodic ones and program compare   *
+ *                   interrupt for next deadline.                                                                     *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Must be called from compare interrupt of high resolution timer only.                                          *
+ *   2. Callbacks are called from critical section, only functions that can be called from ISR can be used.           *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ void               nOS_HrTimerIsr                      (void);
+ nOS_Error          nOS_HrTimerCreate                   (nOS_HrTimer *timer, nOS_HrTimerCallback callback, void *arg);
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_HrTimerStart                                                                                 *
+ *                                                                                                                    *
+ * Description     : Start or restart high resolution timer, callback will be called in delay counts from now.        *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   timer         : Pointer to high resolution timer object.                                                         *
+ *   delay         : Number of counts before first deadline (must be higher than 0).                                  *
+ *   period        : Number of counts between following deadlines (0 for one-shot timer).                             *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Timer successfully started.                                                                      *
+ *   NOS_E_INV_OBJ : Pointer to timer object is invalid.                                                              *
+ *   NOS_E_INV_VAL : Delay is 0 or not lower than 2^31 counts, or period is not lower than 2^31 counts.               *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Periodic deadlines are aligned on first deadline, they don't drift with interrupt latency.                    *
+ *   2. Can be called from ISR and from callbacks.                                                                    *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_HrTimerStart                    (nOS_HrTimer *timer, uint32_t delay, uint32_t period);
+ nOS_Error          nOS_HrTimerStop                     (nOS_HrTimer *timer);
+ bool               nOS_HrTimerIsRunning                (nOS_HrTimer *timer);
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_HrSleep                                                                                      *
+ *                                                                                                                    *
+ * Description     : Place currently running thread in sleeping state for specified number of counts of high          *
+ *                   resolution timer.                                                                                *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   count         : Number of counts to wait (lower than 2^31).                                                      *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Running thread successfully sleeping.                                                            *
+ *   NOS_E_INV_VAL : Count is not lower than 2^31.                                                                    *
+ *   NOS_E_ISR     : Can't sleep from interrupt service routine.                                                      *
+ *   NOS_E_LOCKED  : Can't sleep from scheduler locked section.                                                       *
+ *   NOS_E_IDLE    : Can't sleep from main thread.                                                                    *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Equivalent to nOS_Yield if count is 0.                                                                        *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_HrSleep                         (uint32_t count);
+#endif
+
+#if (NOS_CONFIG_SIGNAL_ENABLE > 0)
+ void               nOS_SignalProcess                   (void);
+ uint8_t            nOS_SignalProcessBatch              (void);
+ nOS_Error          nOS_SignalCreate                    (nOS_Signal *signal,
+                                                         nOS_SignalCallback callback
+ #if (NOS_CONFIG_SIGNAL_HIGHEST_PRIO > 0)
+                                                        ,uint8_t prio
+ #endif
+                                                        );
+ #if (NOS_CONFIG_SIGNAL_DELETE_ENABLE > 0)
+  nOS_Error         nOS_SignalDelete                    (nOS_Signal *signal);
+ #endif
+ nOS_Error          nOS_SignalSend                      (nOS_Signal *signal, void *arg);
+ nOS_Error          nOS_SignalSetCallback               (nOS_Signal *signal, nOS_SignalCallback callback);
+ #if (NOS_CONFIG_SIGNAL_QUEUE_ENABLE > 0)
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_SignalSetQueue                                                                               *
+ *                                                                                                                    *
+ * Description     : Give a ring of arguments to signal, so each raise is kept with its own argument and callback is  *
+ *                   called once per raise. Without queue, signal can only be raised once before it is processed.     *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   signal        : Pointer to signal object.                                                                        *
+ *   buffer        : Pointer to array of arguments allocated by the application (NULL to remove queue).               *
+ *   bmax          : Maximum number of pending raises (0 to remove queue).                                            *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Queue changed successfully.                                                                      *
+ *   NOS_E_INV_OBJ : Pointer to signal object is invalid.                                                             *
+ *   NOS_E_INV_VAL : Only one of buffer and bmax is NULL/0.                                                           *
+ *   NOS_E_INV_STATE : Signal is raised, queue can't be changed before all raises are processed.                      *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Raises of the same signal are dispatched in order, after other raised signals of the same prio.               *
+ *   2. nOS_SignalSend return NOS_E_OVERFLOW when queue is full.                                                      *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+  nOS_Error         nOS_SignalSetQueue                  (nOS_Signal *signal, void **buffer, uint8_t bmax);
+ #endif
+ bool               nOS_SignalIsRaised                  (nOS_Signal *signal);
+#endif
+
+#if (NOS_CONFIG_TIME_ENABLE > 0)
+ void               nOS_TimeTick                        (nOS_TickCounter ticks);
+ nOS_Time           nOS_TimeGet                         (void);
+ nOS_Error          nOS_TimeSet                         (nOS_Time time);
+ #if (NOS_CONFIG_TIME_PRECISE_ENABLE > 0)
+  nOS_TimePrecise   nOS_TimeGetPrecise                  (void);
+ #endif
+ nOS_TimeDate       nOS_TimeConvert                     (nOS_Time time);
+ #if (NOS_CONFIG_TIME_WAIT_ENABLE > 0)
+  nOS_Error         nOS_TimeWait                        (nOS_Time time);
+ #endif
+ bool               nOS_TimeIsLeapYear                  (uint16_t year);
+ uint16_t           nOS_TimeGetDaysPerYear              (uint16_t year);
+ uint8_t            nOS_TimeGetDaysPerMonth             (uint8_t month, uint16_t year);
+ nOS_TimeDate       nOS_TimeDateGet                     (void);
+ nOS_Error          nOS_TimeDateSet                     (nOS_TimeDate timedate);
+ nOS_Time           nOS_TimeDateConvert                 (nOS_TimeDate timedate);
+ #if (NOS_CONFIG_TIME_WAIT_ENABLE > 0)
+  nOS_Error         nOS_TimeDateWait                    (nOS_TimeDate timedate);
+ #endif
+#endif
+
+#if (NOS_CONFIG_ALARM_ENABLE > 0)
+ void               nOS_AlarmTick                       (void);
+ void               nOS_AlarmProcess                    (void);
+ uint8_t            nOS_AlarmProcessBatch               (void);
+ nOS_Error          nOS_AlarmCreate                     (nOS_Alarm *alarm, nOS_AlarmCallback callback, void *arg, nOS_Time time);
+ #if (NOS_CONFIG_ALARM_DELETE_ENABLE > 0)
+  nOS_Error         nOS_AlarmDelete                     (nOS_Alarm *alarm);
+ #endif
+ nOS_Error          nOS_AlarmSetTime                    (nOS_Alarm *alarm, nOS_Time time);
+ nOS_Error          nOS_AlarmSetCallback                (nOS_Alarm *alarm, nOS_AlarmCallback callback, void *arg);
+#endif
+
+#if (NOS_CONFIG_BARRIER_ENABLE > 0)
+ nOS_Error          nOS_BarrierCreate                   (nOS_Barrier *barrier, uint8_t max);
+ #if (NOS_CONFIG_BARRIER_DELETE_ENABLE > 0)
+  nOS_Error         nOS_BarrierDelete                   (nOS_Barrier *barrier);
+ #endif
+ nOS_Error          nOS_BarrierWait                     (nOS_Barrier *barrier);
+#endif
+
+#if (NOS_CONFIG_WORKQUEUE_ENABLE > 0)
+ nOS_Error          nOS_WorkQueueCreate                 (nOS_WorkQueue *workq);
+ #if (NOS_CONFIG_WORKQUEUE_DELETE_ENABLE > 0)
+  nOS_Error         nOS_WorkQueueDelete                 (nOS_WorkQueue *workq);
+ #endif
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_WorkQueueSubmit                                                                              *
+ *                                                                                                                    *
+ * Description     : Submit a single job to work queue. Job will be executed once by first available worker with      *
+ *                   callback(arg, 0, 1).                                                                             *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   workq         : Pointer to work queue object.                                                                    *
+ *   work          : Pointer to work item allocated by the application, used to link job in queue.                    *
+ *   callback      : Pointer to function that will execute the job.                                                   *
+ *   arg           : Pointer that will be given to callback.                                                          *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Job successfully submitted.                                                                      *
+ *   NOS_E_INV_OBJ : Pointer to work queue object is invalid.                                                         *
+ *   NOS_E_NULL    : Pointer to work item or callback is invalid.                                                     *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Work item must not be modified and must stay valid until job is done (see nOS_WorkQueueWait).                 *
+ *   2. Can be called from ISR.                                                                                       *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_WorkQueueSubmit                 (nOS_WorkQueue *workq, nOS_Work *work, nOS_WorkCallback callback, void *arg);
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_WorkQueueFor                                                                                 *
+ *                                                                                                                    *
+ * Description     : Submit a parallel-for to work queue. Range of indexes [begin, end) is split in chunks that are   *
+ *                   claimed one by one by workers, each chunk being executed with callback(arg, first, last) where   *
+ *                   last is excluded.                                                                                *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   workq         : Pointer to work queue object.                                                                    *
+ *   work          : Pointer to work item allocated by the application, used to link range in queue.                  *
+ *   callback      : Pointer to function that will execute chunks of the range.                                       *
+ *   arg           : Pointer that will be given to callback.                                                          *
+ *   begin         : First index of the range.                                                                        *
+ *   end           : Index following last index of the range.                                                         *
+ *   chunk         : Maximum number of indexes executed by each call of callback.                                     *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Range successfully submitted.                                                                    *
+ *   NOS_E_INV_OBJ : Pointer to work queue object is invalid.                                                         *
+ *   NOS_E_NULL    : Pointer to work item or callback is invalid.                                                     *
+ *   NOS_E_INV_VAL : Range is empty or chunk is equal to 0.                                                           *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Work item must not be modified and must stay valid until range is done (see nOS_WorkQueueWait).               *
+ *   2. Wake up at most one waiting worker per chunk.                                                                 *
+ *   3. Can be called from ISR.                                                                                       *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_WorkQueueFor                    (nOS_WorkQueue *workq, nOS_Work *work, nOS_WorkCallback callback, void *arg,
+                                                         uint32_t begin, uint32_t end, uint32_t chunk);
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_WorkQueueExecute                                                                             *
+ *                                                                                                                    *
+ * Description     : Claim next job or chunk of work queue and execute it in calling thread. If queue is empty,       *
+ *                   calling thread will be placed in event's waiting list for number of ticks specified by timeout.  *
+ *                   Worker threads created by the application simply call it in a never ending loop.                 *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   workq         : Pointer to work queue object.                                                                    *
+ *   timeout       : Timeout value.                                                                                   *
+ *                     NOS_NO_WAIT                     : Don't wait if queue is empty.                                *
+ *                     0 > timeout < NOS_WAIT_INFINITE : Maximum number of ticks to wait until work is submitted.     *
+ *                     NOS_WAIT_INFINITE               : Wait indefinitely until work is submitted.                   *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : One job or chunk has been executed.                                                              *
+ *   NOS_E_INV_OBJ : Pointer to work queue object is invalid.                                                         *
+ *   NOS_E_EMPTY   : Queue is empty (happens when timeout equal NOS_NO_WAIT).                                         *
+ *   NOS_E_ISR     : Can't wait from interrupt service routine.                                                       *
+ *   NOS_E_LOCKED  : Can't wait from scheduler locked section.                                                        *
+ *   NOS_E_IDLE    : Can't wait from main thread (idle).                                                              *
+ *   NOS_E_TIMEOUT : No work submitted before reaching timeout.                                                       *
+ *   NOS_E_DELETED : Work queue object has been deleted.                                                              *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Submitter can call it with NOS_NO_WAIT to help workers before waiting for completion.                         *
+ *   2. Timeout is restarted if a submitted chunk is claimed by another thread before calling thread run.             *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_WorkQueueExecute                (nOS_WorkQueue *workq, nOS_TickCounter timeout);
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_WorkQueueWait                                                                                *
+ *                                                                                                                    *
+ * Description     : Wait until all submitted jobs and ranges have been executed completely. If not, calling thread   *
+ *                   will be placed in event's waiting list for number of ticks specified by timeout.                 *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   workq         : Pointer to work queue object.                                                                    *
+ *   timeout       : Timeout value.                                                                                   *
+ *                     NOS_NO_WAIT                     : Don't wait if work is still pending.                         *
+ *                     0 > timeout < NOS_WAIT_INFINITE : Maximum number of ticks to wait until all work is done.      *
+ *                     NOS_WAIT_INFINITE               : Wait indefinitely until all work is done.                    *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : All work is done, work items can be reused.                                                      *
+ *   NOS_E_INV_OBJ : Pointer to work queue object is invalid.                                                         *
+ *   NOS_E_AGAIN   : Work is still pending (happens when timeout equal NOS_NO_WAIT).                                  *
+ *   NOS_E_ISR     : Can't wait from interrupt service routine.                                                       *
+ *   NOS_E_LOCKED  : Can't wait from scheduler locked section.                                                        *
+ *   NOS_E_IDLE    : Can't wait from main thread (idle).                                                              *
+ *   NOS_E_TIMEOUT : Work is not done before reaching timeout.                                                        *
+ *   NOS_E_DELETED : Work queue object has been deleted.                                                              *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_WorkQueueWait                   (nOS_WorkQueue *workq, nOS_TickCounter timeout);
+#endif
+
+#if (NOS_CONFIG_TOPIC_ENABLE > 0)
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Publish/subscribe topic                                                                                            *
+ *                                                                                                                    *
+ * Publisher copy each sample once in a ring of bmax slots and increment topic version. Each subscriber keep its own  *
+ * version of next sample to receive and read it in place, there is no copy per subscriber. Slot of a sample is       *
+ * reused bmax publications later, a publisher never wait on slow subscribers: they receive an overrun indication     *
+ * instead.                                                                                                           *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_TopicCreate                     (nOS_Topic *topic, void *buffer, uint16_t bsize, uint16_t bmax);
+ #if (NOS_CONFIG_TOPIC_DELETE_ENABLE > 0)
+  nOS_Error         nOS_TopicDelete                     (nOS_Topic *topic);
+ #endif
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_TopicPublish                                                                                 *
+ *                                                                                                                    *
+ * Description     : Copy sample in next slot of topic ring, overwriting oldest sample, and wake up all subscribers   *
+ *                   waiting on topic at once.                                                                        *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   topic         : Pointer to topic object.                                                                         *
+ *   sample        : Pointer to sample to publish (bsize bytes).                                                      *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Sample successfully published.                                                                   *
+ *   NOS_E_INV_OBJ : Pointer to topic object is invalid.                                                              *
+ *   NOS_E_NULL    : Pointer to sample is invalid.                                                                    *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Sample is copied from critical section, keep samples small.                                                   *
+ *   2. Can be called from ISR.                                                                                       *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_TopicPublish                    (nOS_Topic *topic, const void *sample);
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_TopicSubscribe                                                                               *
+ *                                                                                                                    *
+ * Description     : Attach subscriber to topic. Subscriber will receive samples published from now on.               *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   topic         : Pointer to topic object.                                                                         *
+ *   sub           : Pointer to subscriber object allocated by the application.                                       *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Subscriber successfully attached.                                                                *
+ *   NOS_E_INV_OBJ : Pointer to topic or subscriber object is invalid.                                                *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Subscriber don't need to be detached, topic doesn't keep track of its subscribers.                            *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_TopicSubscribe                  (nOS_Topic *topic, nOS_Subscriber *sub);
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_TopicReceive                                                                                 *
+ *                                                                                                                    *
+ * Description     : Give pointer to next sample of subscriber in topic ring. If subscriber already received all      *
+ *                   published samples, calling thread will be placed in topic's waiting list for number of ticks     *
+ *                   specified by timeout.                                                                            *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   sub           : Pointer to subscriber object.                                                                    *
+ *   sample        : Pointer where to store pointer to sample slot.                                                   *
+ *   timeout       : Timeout value.                                                                                   *
+ *                     NOS_NO_WAIT                     : Don't wait if no new sample is available.                    *
+ *                     0 > timeout < NOS_WAIT_INFINITE : Maximum number of ticks to wait until a sample is published. *
+ *                     NOS_WAIT_INFINITE               : Wait indefinitely until a sample is published.               *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK         : Pointer to sample is stored in sample.                                                          *
+ *   NOS_E_INV_OBJ  : Pointer to subscriber object is invalid or its topic has been deleted.                          *
+ *   NOS_E_NULL     : Pointer to sample is invalid.                                                                   *
+ *   NOS_E_OVERFLOW : Subscriber has been overrun, unread samples were overwritten. Subscriber is moved to oldest     *
+ *                    sample still in ring, next call will receive it.                                                *
+ *   NOS_E_EMPTY    : No new sample is available (happens when timeout equal NOS_NO_WAIT).                            *
+ *   NOS_E_ISR      : Can't wait from interrupt service routine.                                                      *
+ *   NOS_E_LOCKED   : Can't wait from scheduler locked section.                                                       *
+ *   NOS_E_IDLE     : Can't wait from main thread (idle).                                                             *
+ *   NOS_E_TIMEOUT  : No sample has been published before reaching timeout.                                           *
+ *   NOS_E_DELETED  : Topic object has been deleted.                                                                  *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Sample is read in place, it stay valid until publisher reuse its slot (see nOS_TopicIsValid).                 *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_TopicReceive                    (nOS_Subscriber *sub, const void **sample, nOS_TickCounter timeout);
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_TopicIsValid                                                                                 *
+ *                                                                                                                    *
+ * Description     : Check if last sample received by subscriber is still intact in topic ring. Used after reading    *
+ *                   sample in place to detect if publisher has reused its slot meanwhile.                            *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   sub           : Pointer to subscriber object.                                                                    *
+ *                                                                                                                    *
+ * Return          : Sample state.                                                                                    *
+ *   true          : Sample has not been overwritten.                                                                 *
+ *   false         : Sample slot has been reused (or subscriber is invalid), data read may be corrupted.              *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ bool               nOS_TopicIsValid                    (nOS_Subscriber *sub);
+#endif
+
+#if (NOS_CONFIG_IO_ENABLE > 0)
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Asynchronous I/O requests                                                                                          *
+ *                                                                                                                    *
+ * A driver creates one device object per channel with a start function that program hardware (usually a DMA) for a   *
+ * request, then call nOS_IoComplete from its end of transfer interrupt. Threads submit request descriptors carrying a*
+ * chain of buffers (scatter-gather), requests are queued in device and started one after the other: next request is  *
+ * programmed from completion interrupt before anyone is woken up, so hardware stay busy while completed data is      *
+ * processed. Completion is seen by waiting on request (nOS_IoWait) or by a signal callback given at creation.        *
+ *                                                                                                                    *
+ * Buffers are never copied by nOS, chain segments can point to blocks allocated from a nOS_Mem object and given back *
+ * by reader once request is done.                                                                                    *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_IoDeviceCreate                                                                               *
+ *                                                                                                                    *
+ * Description     : Initialize device object with an empty queue of requests.                                        *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   dev           : Pointer to device object.                                                                        *
+ *   start         : Pointer to driver function that start transfer of a request.                                     *
+ *   context       : Pointer to driver data, available in dev->context.                                               *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Device successfully created.                                                                     *
+ *   NOS_E_INV_OBJ : Pointer to device object is invalid.                                                             *
+ *   NOS_E_NULL    : Pointer to start function is invalid.                                                            *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. start is called from critical section, from thread context when request is submitted to an idle device or     *
+ *      from interrupt when previous request is completed. It shall only program hardware and return, it can call     *
+ *      nOS_IoComplete itself if transfer is done immediately.                                                        *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_IoDeviceCreate                  (nOS_IoDevice *dev, nOS_IoStart start, void *context);
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_IoRequestCreate                                                                              *
+ *                                                                                                                    *
+ * Description     : Initialize request object, ready to be submitted.                                                *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   req           : Pointer to request object.                                                                       *
+ *   signal        : Pointer to signal object sent with req as argument when request is done, can be NULL             *
+ *                   (see note 1).                                                                                    *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Request successfully created.                                                                    *
+ *   NOS_E_INV_OBJ : Pointer to request object is invalid.                                                            *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Only available if NOS_CONFIG_SIGNAL_ENABLE is defined to 1.                                                   *
+ *   2. Request can be embedded in a larger driver specific descriptor (address, flags, ...).                         *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_IoRequestCreate                 (nOS_IoRequest *req
+ #if (NOS_CONFIG_SIGNAL_ENABLE > 0)
+                                                        ,nOS_Signal *signal
+ #endif
+                                                        );
 
-#if (NOS_CONFIG_TIME_ENABLE > 0)
- void               nOS_TimeTick                        (nOS_TickCounter ticks);
- nOS_Time           nOS_TimeGet                         (void);
- nOS_Error          nOS_TimeSet                         (nOS_Time time);
- nOS_TimeDate       nOS_TimeConvert                     (nOS_Time time);
- #if (NOS_CONFIG_TIME_WAIT_ENABLE > 0)
-  nOS_Error         nOS_TimeWait                        (nOS_Time time);
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_IoSubmit                                                                                     *
+ *                                                                                                                    *
+ * Description     : Queue request at end of device queue, transfer is started immediately if device is idle.         *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   dev           : Pointer to device object.                                                                        *
+ *   req           : Pointer to request object.                                                                       *
+ *   op            : Operation code, meaning is defined by driver.                                                    *
+ *   chain         : Pointer to first buffer of chain, can be NULL if driver doesn't need data.                       *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Request successfully queued.                                                                     *
+ *   NOS_E_INV_OBJ : Pointer to device or request object is invalid.                                                  *
+ *   NOS_E_RUNNING : Request is already queued or in transfer.                                                        *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Chain and its buffers belong to driver until request is done, they shall not be modified meanwhile.           *
+ *   2. Can be called from ISR.                                                                                       *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_IoSubmit                        (nOS_IoDevice *dev,
+                                                         nOS_IoRequest *req,
+                                                         uint8_t op,
+                                                         nOS_IoBuffer *chain);
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_IoComplete                                                                                   *
+ *                                                                                                                    *
+ * Description     : Called by driver when transfer of active request is over. Next queued request is started, then   *
+ *                   threads waiting on completed request are woken up and its signal is sent.                        *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   dev           : Pointer to device object.                                                                        *
+ *   result        : Result of transfer, returned by nOS_IoWait (NOS_OK or driver error code).                        *
+ *   count         : Number of bytes transferred.                                                                     *
+ *                                                                                                                    *
+ * Return          : Pointer to completed request.                                                                    *
+ *   == NULL       : No request was in transfer.                                                                      *
+ *   != NULL       : Pointer to request that is now done.                                                             *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Usually called from DMA or peripheral ISR.                                                                    *
+ *   2. Signal can't be sent if it is already raised without queue (or with its queue full), use a signal queue       *
+ *      when several requests can complete before signal thread run.                                                  *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_IoRequest*     nOS_IoComplete                      (nOS_IoDevice *dev, nOS_Error result, size_t count);
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_IoCancel                                                                                     *
+ *                                                                                                                    *
+ * Description     : Remove request from queue of its device before its transfer is started. Request is done with     *
+ *                   NOS_E_ABORT result.                                                                              *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   req           : Pointer to request object.                                                                       *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK          : Request successfully cancelled.                                                                *
+ *   NOS_E_INV_OBJ   : Pointer to request object is invalid.                                                          *
+ *   NOS_E_RUNNING   : Transfer is already started, driver shall abort it and call nOS_IoComplete.                    *
+ *   NOS_E_INV_STATE : Request is not queued.                                                                         *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_IoCancel                        (nOS_IoRequest *req);
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_IoWait                                                                                       *
+ *                                                                                                                    *
+ * Description     : Wait until request is done. If request is queued or in transfer, calling thread will be placed   *
+ *                   in waiting list of request for number of ticks specified by timeout.                             *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   req           : Pointer to request object.                                                                       *
+ *   timeout       : Timeout value.                                                                                   *
+ *                     NOS_NO_WAIT                     : Don't wait if request is not done.                           *
+ *                     0 > timeout < NOS_WAIT_INFINITE : Maximum number of ticks to wait until request is done.       *
+ *                     NOS_WAIT_INFINITE               : Wait indefinitely until request is done.                     *
+ *                                                                                                                    *
+ * Return          : Result of request or error code.                                                                 *
+ *   NOS_OK        : Request is done with success.                                                                    *
+ *   NOS_E_INV_OBJ : Pointer to request object is invalid.                                                            *
+ *   NOS_E_ABORT   : Request has been cancelled.                                                                      *
+ *   NOS_E_AGAIN   : Request is not done (happens when timeout equal NOS_NO_WAIT).                                    *
+ *   NOS_E_ISR     : Can't wait from interrupt service routine.                                                       *
+ *   NOS_E_LOCKED  : Can't wait from scheduler locked section.                                                        *
+ *   NOS_E_IDLE    : Can't wait from main thread (idle).                                                              *
+ *   NOS_E_TIMEOUT : Request is not done before reaching timeout.                                                     *
+ *   Other         : Error code given by driver to nOS_IoComplete.                                                    *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Number of bytes transferred is available in req->count once request is done.                                  *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_IoWait                          (nOS_IoRequest *req, nOS_TickCounter timeout);
+ bool               nOS_IoIsDone                        (nOS_IoRequest *req);
+#endif
+
+#if (NOS_CONFIG_TASK_ENABLE > 0)
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Stackless tasks (protothreads)                                                                                     *
+ *                                                                                                                    *
+ * Task handler is a plain function called by dispatcher each time task can progress. Its body is enclosed between    *
+ * NOS_TASK_BEGIN and NOS_TASK_END and it leave with task macros below, which record source line where it has left    *
+ * in task object (local continuation with switch statement, Duff's device). Next call jump directly to this line.    *
+ * All tasks share dispatcher stack.                                                                                  *
+ *                                                                                                                    *
+ *   NOS_TASK_YIELD(t)                      : Give dispatcher to other tasks, continue at next pass.                  *
+ *   NOS_TASK_WAIT_UNTIL(t,cond)            : Leave until cond is true, cond is evaluated again at each pass.         *
+ *   NOS_TASK_SLEEP(t,ticks)                : Leave until given number of ticks have elapsed.                         *
+ *   NOS_TASK_SEM_TAKE(t,sem,err)           : Wait until sem is taken (err receive result of nOS_SemTake).            *
+ *   NOS_TASK_QUEUE_READ(t,queue,block,err) : Wait until a block is read (err receive result of nOS_QueueRead).       *
+ *   NOS_TASK_QUEUE_WRITE(t,queue,block,err): Wait until block is written (err receive result of nOS_QueueWrite).     *
+ *   NOS_TASK_FLAG_WAIT(t,flag,flags,res,opt,err)                                                                     *
+ *                                          : Wait until flags are set (err receive result of nOS_FlagWait).          *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Local variables are not kept when task leave, use static variables or context given in arg.                   *
+ *   2. Task macros can't be used inside a switch statement of the handler and not twice on the same line.            *
+ *   3. Task source file must be shorter than 65536 lines (nOS_TaskLine is 16-bit).                                   *
+ *   4. Waiting on objects never block dispatcher: they are tried with NOS_NO_WAIT and dispatcher is awoken each      *
+ *      time a semaphore is given, a queue is written/read or flags are sent.                                         *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ #define NOS_TASK_BEGIN(t)                  switch ((t)->line) { case 0:
+ #define NOS_TASK_END(t)                    } (t)->line = 0; return NOS_TASK_ENDED
+ #define NOS_TASK_YIELD(t)                                                                                             \
+    do {                                                                                                               \
+        (t)->line = (nOS_TaskLine)__LINE__; return NOS_TASK_YIELDED; case __LINE__:;                                   \
+    } while (0)
+ #define NOS_TASK_WAIT_UNTIL(t,cond)                                                                                   \
+    do {                                                                                                               \
+        (t)->line = (nOS_TaskLine)__LINE__; case __LINE__: if (!(cond)) return NOS_TASK_WAITING;                       \
+    } while (0)
+ #define NOS_TASK_SLEEP(t,ticks)                                                                                       \
+    do {                                                                                                               \
+        (t)->tick = (nOS_TickCounter)(nOS_GetTickCount() + (ticks));                                                   \
+        (t)->line = (nOS_TaskLine)__LINE__; case __LINE__:                                                             \
+        if ((nOS_TickCounter)(nOS_GetTickCount() - (t)->tick) > (NOS_TICK_COUNT_MAX >> 1)) return NOS_TASK_SLEEPING;   \
+    } while (0)
+ #if (NOS_CONFIG_SEM_ENABLE > 0)
+  #define NOS_TASK_SEM_TAKE(t,sem,err)                                                                                 \
+    NOS_TASK_WAIT_UNTIL(t, ((err) = nOS_SemTake((sem), NOS_NO_WAIT)) != NOS_E_AGAIN)
  #endif
- bool               nOS_TimeIsLeapYear                  (uint16_t year);
- uint16_t           nOS_TimeGetDaysPerYear              (uint16_t year);
- uint8_t            nOS_TimeGetDaysPerMonth             (uint8_t month, uint16_t year);
- nOS_TimeDate       nOS_TimeDateGet                     (void);
- nOS_Error          nOS_TimeDateSet                     (nOS_TimeDate timedate);
- nOS_Time           nOS_TimeDateConvert                 (nOS_TimeDate timedate);
- #if (NOS_CONFIG_TIME_WAIT_ENABLE > 0)
-  nOS_Error         nOS_TimeDateWait                    (nOS_TimeDate timedate);
+ #if (NOS_CONFIG_QUEUE_ENABLE > 0)
+  #define NOS_TASK_QUEUE_READ(t,queue,block,err)                                                                       \
+    NOS_TASK_WAIT_UNTIL(t, ((err) = nOS_QueueRead((queue), (block), NOS_NO_WAIT)) != NOS_E_EMPTY)
+  #define NOS_TASK_QUEUE_WRITE(t,queue,block,err)                                                                      \
+    NOS_TASK_WAIT_UNTIL(t, ((err) = nOS_QueueWrite((queue), (block), NOS_NO_WAIT)) != NOS_E_FULL)
+ #endif
+ #if (NOS_CONFIG_FLAG_ENABLE > 0)
+  #define NOS_TASK_FLAG_WAIT(t,flag,flags,res,opt,err)                                                                 \
+    NOS_TASK_WAIT_UNTIL(t, ((err) = nOS_FlagWait((flag), (flags), (res), (opt), NOS_NO_WAIT)) != NOS_E_AGAIN)
+ #endif
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_TaskCreate                                                                                   *
+ *                                                                                                                    *
+ * Description     : Create a stackless task and start it from beginning of its handler at next dispatch.             *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   task          : Pointer to task object.                                                                          *
+ *   handler       : Pointer to task handler function.                                                                *
+ *   arg           : Pointer that will be given to handler.                                                           *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Task created successfully.                                                                       *
+ *   NOS_E_INV_OBJ : Pointer to task object is invalid or task is already created.                                    *
+ *   NOS_E_NULL    : Pointer to task handler is invalid.                                                              *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Task is automatically deleted when its handler reach NOS_TASK_END and can be created again.                   *
+ *   2. Can be called from ISR and from another task.                                                                 *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_TaskCreate                      (nOS_Task *task, nOS_TaskHandler handler, void *arg);
+ #if (NOS_CONFIG_TASK_DELETE_ENABLE > 0)
+  nOS_Error         nOS_TaskDelete                      (nOS_Task *task);
  #endif
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_TaskProcess                                                                                  *
+ *                                                                                                                    *
+ * Description     : Dispatch once each created task in order of creation.                                            *
+ *                                                                                                                    *
+ * Parameters      : None.                                                                                            *
+ *                                                                                                                    *
+ * Return          : Number of ticks before a task need to be dispatched again.                                       *
+ *   0                 : At least one task has yielded or an object has changed during dispatch.                      *
+ *   NOS_WAIT_INFINITE : All tasks are waiting on condition or object.                                                *
+ *   Other value       : Number of ticks before nearest sleeping task wake up.                                        *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Called by task dispatcher thread if enabled, application is responsible to call it otherwise.                 *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_TickCounter    nOS_TaskProcess                     (void);
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_TaskWakeUp                                                                                   *
+ *                                                                                                                    *
+ * Description     : Force dispatcher to evaluate again all waiting tasks. Should be called by the application when   *
+ *                   it change a condition that a task is waiting with NOS_TASK_WAIT_UNTIL.                           *
+ *                                                                                                                    *
+ * Parameters      : None.                                                                                            *
+ *                                                                                                                    *
+ * Return          : None.                                                                                            *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Can be called from ISR.                                                                                       *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ void               nOS_TaskWakeUp                      (void);
 #endif
 
-#if (NOS_CONFIG_ALARM_ENABLE > 0)
- void               nOS_AlarmTick                       (void);
- void               nOS_AlarmProcess                    (void);
- nOS_Error          nOS_AlarmCreate                     (nOS_Alarm *alarm, nOS_AlarmCallback callback, void *arg, nOS_Time time);
- #if (NOS_CONFIG_ALARM_DELETE_ENABLE > 0)
-  nOS_Error         nOS_AlarmDelete                     (nOS_Alarm *alarm);
+#if (NOS_CONFIG_JOB_ENABLE > 0)
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_JobCreate                                                                                    *
+ *                                                                                                                    *
+ * Description     : Create a run-to-completion job scheduled with stack resource policy. All jobs run on the stack   *
+ *                   of job thread: a job can only be preempted by jobs of higher prio than current system ceiling and*
+ *                   preempting job run to completion as a nested function call, so stack needed is bounded by the sum*
+ *                   of deepest job of each prio.                                                                     *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   job           : Pointer to job object.                                                                           *
+ *   handler       : Pointer to function that will run the job.                                                       *
+ *   arg           : Pointer that will be given to handler.                                                           *
+ *   prio          : Preemption level of job (0 to NOS_CONFIG_JOB_HIGHEST_PRIO inclusively).                          *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Job created successfully.                                                                        *
+ *   NOS_E_INV_OBJ : Pointer to job object is invalid or job is already created.                                      *
+ *   NOS_E_NULL    : Pointer to handler is invalid.                                                                   *
+ *   NOS_E_INV_PRIO : Preemption level is higher than NOS_CONFIG_JOB_HIGHEST_PRIO.                                    *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. A job must never block: it can't wait on any object except mutex. Mutex used by jobs must be created with     *
+ *      prio set to highest preemption level of jobs that lock it (its ceiling) and must not be locked elsewhere.     *
+ *      Locking it raise system ceiling to mutex prio and unlocking it run pending jobs above restored ceiling.       *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_JobCreate                       (nOS_Job *job, nOS_JobHandler handler, void *arg, uint8_t prio);
+ #if (NOS_CONFIG_JOB_DELETE_ENABLE > 0)
+  nOS_Error         nOS_JobDelete                       (nOS_Job *job);
  #endif
- nOS_Error          nOS_AlarmSetTime                    (nOS_Alarm *alarm, nOS_Time time);
- nOS_Error          nOS_AlarmSetCallback                (nOS_Alarm *alarm, nOS_AlarmCallback callback, void *arg);
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_JobActivate                                                                                  *
+ *                                                                                                                    *
+ * Description     : Request job to run once. If called from a job and prio of activated job is higher than system    *
+ *                   ceiling, it run immediately before returning. Otherwise it run when job thread can take it.      *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   job           : Pointer to job object.                                                                           *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Job activated successfully.                                                                      *
+ *   NOS_E_INV_OBJ : Pointer to job object is invalid.                                                                *
+ *   NOS_E_OVERFLOW : Job is already pending.                                                                         *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Can be called from ISR.                                                                                       *
+ *   2. Job activated from ISR or from another thread can't preempt a running job of job thread before it activate    *
+ *      a job, unlock a mutex or return.                                                                              *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_JobActivate                     (nOS_Job *job);
+ bool               nOS_JobIsPending                    (nOS_Job *job);
 #endif
 
-#if (NOS_CONFIG_BARRIER_ENABLE > 0)
- nOS_Error          nOS_BarrierCreate                   (nOS_Barrier *barrier, uint8_t max);
- #if (NOS_CONFIG_BARRIER_DELETE_ENABLE > 0)
-  nOS_Error         nOS_BarrierDelete                   (nOS_Barrier *barrier);
+#if (NOS_CONFIG_ACTIVE_ENABLE > 0)
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_ActiveCreate                                                                                 *
+ *                                                                                                                    *
+ * Description     : Create an active object: a run-to-completion event handler with its own ring of event pointers,  *
+ *                   run as a job of job thread. Many objects can share each preemption level without their own       *
+ *                   thread, stack or queue.                                                                          *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   ao            : Pointer to active object.                                                                        *
+ *   handler       : Pointer to function that will receive each event.                                                *
+ *   buffer        : Pointer to array of event pointers allocated by the application.                                 *
+ *   max           : Maximum number of events that can be waiting in array.                                           *
+ *   prio          : Preemption level of object (0 to NOS_CONFIG_JOB_HIGHEST_PRIO inclusively).                       *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Active object created successfully.                                                              *
+ *   NOS_E_INV_OBJ : Pointer to active object is invalid or object is already created.                                *
+ *   NOS_E_NULL    : Pointer to handler or to array of events is invalid.                                             *
+ *   NOS_E_INV_VAL : Maximum number of events is 0.                                                                   *
+ *   NOS_E_INV_PRIO : Preemption level is higher than NOS_CONFIG_JOB_HIGHEST_PRIO.                                    *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Handler is called once for each event, in posting order, and must never block (same rules as jobs).           *
+ *   2. Objects of same preemption level are served in turn one event at a time, objects of higher level can          *
+ *      preempt between two events.                                                                                   *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_ActiveCreate                    (nOS_Active *ao, nOS_ActiveHandler handler, void **buffer, uint16_t max, uint8_t prio);
+ #if (NOS_CONFIG_ACTIVE_DELETE_ENABLE > 0)
+  nOS_Error         nOS_ActiveDelete                    (nOS_Active *ao);
  #endif
- nOS_Error          nOS_BarrierWait                     (nOS_Barrier *barrier);
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_ActivePost                                                                                   *
+ *                                                                                                                    *
+ * Description     : Post an event pointer to an active object. Only the pointer is copied, event must stay valid     *
+ *                   until handler has received it.                                                                   *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   ao            : Pointer to active object.                                                                        *
+ *   event         : Pointer to event that will be given to handler.                                                  *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Event posted successfully.                                                                       *
+ *   NOS_E_INV_OBJ : Pointer to active object is invalid.                                                             *
+ *   NOS_E_FULL    : Array of events is full.                                                                         *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Can be called from ISR.                                                                                       *
+ *   2. If called from a job of lower prio than active object, event is dispatched immediately before returning.      *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_ActivePost                      (nOS_Active *ao, void *event);
+ bool               nOS_ActiveIsEmpty                   (nOS_Active *ao);
+#endif
+
+#if (NOS_CONFIG_SELECT_ENABLE > 0)
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_Select                                                                                       *
+ *                                                                                                                    *
+ * Description     : Wait until at least one of many objects is ready. Calling thread is linked to all objects at     *
+ *                   the same time and is awoken by the first one that become ready.                                  *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   items         : Pointer to array of select items allocated by the application.                                   *
+ *                     See note 1                                                                                     *
+ *   count         : Number of items in array.                                                                        *
+ *   index         : Pointer to variable that will contain index of first ready item (can be NULL).                   *
+ *   timeout       : Timeout value.                                                                                   *
+ *                     NOS_NO_WAIT                     : Don't wait if no objects are ready.                          *
+ *                     0 > timeout < NOS_WAIT_INFINITE : Maximum number of ticks to wait until an object became ready.*
+ *                     NOS_WAIT_INFINITE               : Wait indefinitely until an object became ready.              *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : At least one object is ready.                                                                    *
+ *   NOS_E_INV_OBJ : One of the objects is invalid or doesn't match type of item.                                     *
+ *   NOS_E_NULL    : Pointer to array of items is invalid.                                                            *
+ *   NOS_E_INV_VAL : No items in array.                                                                               *
+ *   NOS_E_AGAIN   : No objects are ready and caller don't want to wait.                                              *
+ *   NOS_E_TIMEOUT : No objects became ready before end of timeout.                                                   *
+ *   NOS_E_DELETED : One of the objects has been deleted while waiting (index contains its position).                 *
+ *   NOS_E_ISR     : Can't wait from ISR.                                                                             *
+ *   NOS_E_IDLE    : Can't wait from main thread (idle).                                                              *
+ *   NOS_E_LOCKED  : Can't wait when scheduler is locked.                                                             *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Application shall set object and type of each item (and flags for NOS_SELECT_FLAG).                           *
+ *        NOS_SELECT_SEM   : Semaphore count is higher than 0.                                                        *
+ *        NOS_SELECT_QUEUE : At least one block can be read from queue.                                               *
+ *        NOS_SELECT_FLAG  : At least one of the item flags is set in flag object.                                    *
+ *        NOS_SELECT_MEM   : At least one block can be allocated from mem object.                                     *
+ *   2. Only inform the caller that object is ready, it shall be taken by the caller with NOS_NO_WAIT. Another        *
+ *      thread or ISR can take it first, caller shall be prepared to receive NOS_E_AGAIN/NOS_E_EMPTY or NULL.         *
+ *   3. A thread waiting on an object with usual function is always served before selecting threads.                  *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_Select                          (nOS_SelectItem *items, uint8_t count, uint8_t *index, nOS_TickCounter timeout);
+#endif
+
+#if (NOS_CONFIG_TRACE_ENABLE > 0)
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_TraceRead                                                                                    *
+ *                                                                                                                    *
+ * Description     : Read oldest record from trace ring buffer.                                                       *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   record        : Pointer to record allocated by the application that will be filled.                              *
+ *                     time   : Cycle counter or tick counter when event happened.                                    *
+ *                     object : Address of object related to event (truncated to 32 bits).                            *
+ *                                NOS_TRACE_SWITCH    : Thread that is switched in.                                   *
+ *                                NOS_TRACE_WAIT      : Event object on which running thread wait (NULL if sleeping). *
+ *                                NOS_TRACE_WAKEUP    : Thread that is waked up.                                      *
+ *                                NOS_TRACE_TIMER     : Timer object that fired.                                      *
+ *                                NOS_TRACE_SIGNAL    : Signal object that is dispatched.                             *
+ *                                NOS_TRACE_ISR_ENTER : NULL.                                                         *
+ *                                NOS_TRACE_ISR_LEAVE : NULL.                                                         *
+ *                     seq    : Sequence number incremented on each record written.                                   *
+ *                     type   : Type of event (nOS_TraceType).                                                        *
+ *                     arg    : Argument depending on type of event.                                                  *
+ *                                NOS_TRACE_SWITCH    : Priority of thread that is switched in.                       *
+ *                                NOS_TRACE_WAIT      : Waiting state of running thread (nOS_ThreadState).            *
+ *                                NOS_TRACE_WAKEUP    : Negated error code given to thread (0 == NOS_OK).             *
+ *                                NOS_TRACE_ISR_ENTER : Interrupt nesting level after entering.                       *
+ *                                NOS_TRACE_ISR_LEAVE : Interrupt nesting level after leaving.                        *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Record successfully read.                                                                        *
+ *   NOS_E_NULL    : Pointer to record is invalid.                                                                    *
+ *   NOS_E_EMPTY   : Trace buffer is empty.                                                                           *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Can be called from any thread or ISR, but only one reader shall be used at a time.                            *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_TraceRead                       (nOS_TraceRecord *record);
+#endif
+
+#if (NOS_CONFIG_CRITICAL_PROFILE_ENABLE > 0)
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_CriticalProfileRead                                                                          *
+ *                                                                                                                    *
+ * Description     : Copy call sites recorded by critical section profiler.                                           *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   sites         : Pointer to array of sites allocated by the application that will be filled.                      *
+ *                     file  : File where nOS_EnterCritical is used (NULL for sites that didn't fit in table).        *
+ *                     line  : Line where nOS_EnterCritical is used.                                                  *
+ *                     count : Number of times outermost critical section has been entered from this site.            *
+ *                     max   : Longest masked duration in cycles (nanoseconds on POSIX).                              *
+ *   max           : Maximum number of sites that can be copied in array.                                             *
+ *                                                                                                                    *
+ * Return          : Number of sites copied in array.                                                                 *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Sites are copied in order they have been recorded, incomplete table is not an error.                          *
+ *   2. Can be called from any thread or ISR, the section of this call is itself recorded.                            *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ uint8_t            nOS_CriticalProfileRead             (nOS_CriticalSite *sites, uint8_t max);
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_CriticalProfileReset                                                                         *
+ *                                                                                                                    *
+ * Description     : Forget all call sites recorded by critical section profiler.                                     *
+ *                                                                                                                    *
+ * Parameters      : None.                                                                                            *
+ *                                                                                                                    *
+ * Return          : None.                                                                                            *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Can be called from any thread or ISR.                                                                         *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ void               nOS_CriticalProfileReset            (void);
+#endif
+
+#if (NOS_CONFIG_LOG_ENABLE > 0)
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_LogWrite                                                                                     *
+ *                                                                                                                    *
+ * Description     : Store a format string pointer and raw arguments in log ring buffer, they will be formatted later *
+ *                   by log thread or by host. nOS_Log0 to nOS_Log4 macros cast arguments and fill unused ones.       *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   format        : Pointer to printf format string, shall stay valid until record is formatted (constant).          *
+ *   a0 to a3      : Arguments of format string, stored as size_t, unused ones are ignored.                           *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Record successfully stored.                                                                      *
+ *   NOS_E_NULL    : Pointer to format string is invalid.                                                             *
+ *   NOS_E_FULL    : Log buffer is full, record is dropped and counted as lost.                                       *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Can be called from any thread or ISR.                                                                         *
+ *   2. Only integer conversions that fit in an int, %p and %s with constant strings can be used in format string.    *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_LogWrite                        (const char *format, nOS_LogArg a0, nOS_LogArg a1, nOS_LogArg a2, nOS_LogArg a3);
+ #define           nOS_Log0(f)                         nOS_LogWrite((f), 0, 0, 0, 0)
+ #define           nOS_Log1(f,a)                       nOS_LogWrite((f), (nOS_LogArg)(a), 0, 0, 0)
+ #define           nOS_Log2(f,a,b)                     nOS_LogWrite((f), (nOS_LogArg)(a), (nOS_LogArg)(b), 0, 0)
+ #define           nOS_Log3(f,a,b,c)                   nOS_LogWrite((f), (nOS_LogArg)(a), (nOS_LogArg)(b), (nOS_LogArg)(c), 0)
+ #define           nOS_Log4(f,a,b,c,d)                 nOS_LogWrite((f), (nOS_LogArg)(a), (nOS_LogArg)(b), (nOS_LogArg)(c), (nOS_LogArg)(d))
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_LogRead                                                                                      *
+ *                                                                                                                    *
+ * Description     : Read oldest record from log ring buffer.                                                         *
+ *                                                                                                                    *
+ * Parameters                                                                                                         *
+ *   record        : Pointer to record allocated by the application that will be filled.                              *
+ *                     format : Format string given to nOS_LogWrite.                                                  *
+ *                     args   : Arguments given to nOS_LogWrite.                                                      *
+ *                     seq    : Sequence number incremented on each record stored.                                    *
+ *                                                                                                                    *
+ * Return          : Error code.                                                                                      *
+ *   NOS_OK        : Record successfully read.                                                                        *
+ *   NOS_E_NULL    : Pointer to record is invalid.                                                                    *
+ *   NOS_E_EMPTY   : Log buffer is empty (or oldest record is still being written).                                   *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Can be called from any thread or ISR, but only one reader shall be used at a time.                            *
+ *   2. Shall not be called by the application when NOS_CONFIG_LOG_THREAD_ENABLE is enabled.                          *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ nOS_Error          nOS_LogRead                         (nOS_LogRecord *record);
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS_LogGetLost                                                                                   *
+ *                                                                                                                    *
+ * Description     : Get number of records dropped because log buffer was full.                                       *
+ *                                                                                                                    *
+ * Parameters      : None.                                                                                            *
+ *                                                                                                                    *
+ * Return          : Number of records lost since initialization.                                                     *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Can be called from any thread or ISR.                                                                         *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+ uint32_t           nOS_LogGetLost                      (void);
 #endif
 
 #ifdef __cplusplus
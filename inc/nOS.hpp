@@ -0,0 +1,405 @@
+/*
+ * Copyright (c) 2014-2016 Jim Tremblay
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef NOS_HPP
+#define NOS_HPP
+
+#ifndef __cplusplus
+ #error "nOS.hpp: C++ compiler is required."
+#elif (__cplusplus < 201103L) && !(defined(_MSC_VER) && (_MSC_VER >= 1900))
+ #error "nOS.hpp: C++11 compiler is required."
+#endif
+
+#include "nOS.h"
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * C++ layer                                                                                                          *
+ *                                                                                                                    *
+ * Header-only typed wrappers of nOS objects. Each wrapper embed its storage sized at compile time from template      *
+ * parameters, so queue, memory and stack buffers can't be mismatched with their object. Calls go to the C API and    *
+ * keep its error codes: no exception, no heap and no static constructor is needed. Objects must still be created by  *
+ * application with their Create method, like C objects.                                                              *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+namespace nOS
+{
+
+#if (NOS_CONFIG_QUEUE_ENABLE > 0)
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS::Queue<T,N>                                                                                  *
+ *                                                                                                                    *
+ * Description     : Queue of N blocks of type T. Block size is sizeof(T) and is known at compile time.               *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. T is copied with memcpy by the queue: it must be trivially copyable.                                          *
+ *   2. N must be a power of 2 when NOS_CONFIG_QUEUE_POW2_ENABLE is defined to 1, then index wrapping is a mask.      *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+template <class T, nOS_QueueCounter N>
+class Queue
+{
+    static_assert(N > 0, "nOS::Queue: N must be higher than 0.");
+    static_assert(sizeof(T) <= (nOS_QueueSize)-1, "nOS::Queue: T is too big for NOS_CONFIG_QUEUE_BLOCK_SIZE_WIDTH.");
+#if (NOS_CONFIG_QUEUE_POW2_ENABLE > 0)
+    static_assert((N & (N - 1)) == 0, "nOS::Queue: N must be a power of 2 when NOS_CONFIG_QUEUE_POW2_ENABLE == 1.");
+#endif
+
+public:
+    nOS_Error Create (void)
+    {
+        return nOS_QueueCreate(&_queue, _buffer, (nOS_QueueSize)sizeof(T), N);
+    }
+#if (NOS_CONFIG_QUEUE_DELETE_ENABLE > 0)
+    nOS_Error Delete (void)
+    {
+        return nOS_QueueDelete(&_queue);
+    }
+#endif
+    nOS_Error Read (T *block, nOS_TickCounter timeout)
+    {
+        return nOS_QueueRead(&_queue, block, timeout);
+    }
+    nOS_Error Peek (T *block)
+    {
+        return nOS_QueuePeek(&_queue, block);
+    }
+    nOS_Error Write (const T &block, nOS_TickCounter timeout)
+    {
+        return nOS_QueueWrite(&_queue, const_cast<T*>(&block), timeout);
+    }
+#if (NOS_CONFIG_QUEUE_OVERWRITE_ENABLE > 0)
+    nOS_Error SetOverwrite (bool overwrite)
+    {
+        return nOS_QueueSetOverwrite(&_queue, overwrite);
+    }
+#endif
+    nOS_Error Flush (nOS_QueueCallback callback = NULL)
+    {
+        return nOS_QueueFlush(&_queue, callback);
+    }
+    bool IsEmpty (void)
+    {
+        return nOS_QueueIsEmpty(&_queue);
+    }
+    bool IsFull (void)
+    {
+        return nOS_QueueIsFull(&_queue);
+    }
+    nOS_QueueCounter GetCount (void)
+    {
+        return nOS_QueueGetCount(&_queue);
+    }
+    static constexpr nOS_QueueCounter Capacity (void)
+    {
+        return N;
+    }
+    /* Access to C object, for functions that are not wrapped (nOS_Select, zero copy, ...) */
+    nOS_Queue* Get (void)
+    {
+        return &_queue;
+    }
+
+private:
+    nOS_Queue           _queue;
+    alignas(T) uint8_t  _buffer[sizeof(T) * N];
+};
+#endif  /* NOS_CONFIG_QUEUE_ENABLE */
+
+#if (NOS_CONFIG_MEM_ENABLE > 0)
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS::Mem<T,N>                                                                                    *
+ *                                                                                                                    *
+ * Description     : Memory pool of N blocks of type T. Blocks are sized and aligned for T and for the free list link.*
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Alloc/Free don't construct or destroy T, use placement new on allocated block if needed.                      *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+template <class T, nOS_MemCounter N>
+class Mem
+{
+    /* Free blocks store link to next free block in place */
+    static constexpr size_t _Align (void)
+    {
+        return (alignof(T) > alignof(void*)) ? alignof(T) : alignof(void*);
+    }
+    static constexpr size_t _BlockSize (void)
+    {
+        return (((sizeof(T) > sizeof(void*)) ? sizeof(T) : sizeof(void*)) + _Align() - 1) / _Align() * _Align();
+    }
+
+    static_assert(N > 0, "nOS::Mem: N must be higher than 0.");
+    static_assert(_BlockSize() <= (nOS_MemSize)-1, "nOS::Mem: T is too big for nOS_MemSize.");
+
+public:
+    nOS_Error Create (void)
+    {
+        return nOS_MemCreate(&_mem, _buffer, (nOS_MemSize)_BlockSize(), N
+#if (NOS_CONFIG_MEM_BITMAP_ENABLE > 0)
+                            ,_bitmap
+#endif
+                            );
+    }
+#if (NOS_CONFIG_MEM_DELETE_ENABLE > 0)
+    nOS_Error Delete (void)
+    {
+        return nOS_MemDelete(&_mem);
+    }
+#endif
+    T* Alloc (nOS_TickCounter timeout)
+    {
+        return static_cast<T*>(nOS_MemAlloc(&_mem, timeout));
+    }
+    nOS_Error Free (T *block)
+    {
+        return nOS_MemFree(&_mem, block);
+    }
+    bool IsAvailable (void)
+    {
+        return nOS_MemIsAvailable(&_mem);
+    }
+    static constexpr nOS_MemCounter Capacity (void)
+    {
+        return N;
+    }
+    nOS_Mem* Get (void)
+    {
+        return &_mem;
+    }
+
+private:
+    nOS_Mem                     _mem;
+    alignas(_Align()) uint8_t   _buffer[_BlockSize() * N];
+#if (NOS_CONFIG_MEM_BITMAP_ENABLE > 0)
+    uint8_t                     _bitmap[NOS_MEM_BITMAP_SIZE(N)];
+#endif
+};
+#endif  /* NOS_CONFIG_MEM_ENABLE */
+
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS::Thread<SSize,CSSize>                                                                        *
+ *                                                                                                                    *
+ * Description     : Thread with its own stack of SSize entries (of nOS_Stack type).                                  *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. CSSize is call stack size, only used by ports with separate call stack (NOS_USE_SEPARATE_CALL_STACK).         *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+template <size_t SSize, size_t CSSize = 0>
+class Thread
+{
+    static_assert(SSize > 0, "nOS::Thread: SSize must be higher than 0.");
+
+public:
+    nOS_Error Create (nOS_ThreadEntry entry,
+                      void *arg
+#if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
+                     ,uint8_t prio
+#endif
+#if (NOS_CONFIG_THREAD_SUSPEND_ENABLE > 0)
+                     ,nOS_ThreadState state = NOS_THREAD_READY
+#endif
+#if (NOS_CONFIG_THREAD_NAME_ENABLE > 0)
+                     ,const char *name = NULL
+#endif
+#if (NOS_CONFIG_THREAD_FPU_ENABLE > 0)
+                     ,bool fpu = false
+#endif
+#if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+                     ,uint8_t core = 0
+#endif
+                     )
+    {
+        return nOS_ThreadCreate(&_thread,
+                                entry,
+                                arg
+#ifdef NOS_SIMULATED_STACK
+                               ,&_stack
+#else
+                               ,_stack
+#endif
+                               ,SSize
+#ifdef NOS_USE_SEPARATE_CALL_STACK
+                               ,CSSize
+#endif
+#if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
+                               ,prio
+#endif
+#if (NOS_CONFIG_THREAD_SUSPEND_ENABLE > 0)
+                               ,state
+#endif
+#if (NOS_CONFIG_THREAD_NAME_ENABLE > 0)
+                               ,name
+#endif
+#if (NOS_CONFIG_THREAD_FPU_ENABLE > 0)
+                               ,fpu
+#endif
+#if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+                               ,core
+#endif
+                               );
+    }
+#if (NOS_CONFIG_THREAD_DELETE_ENABLE > 0)
+    nOS_Error Delete (void)
+    {
+        return nOS_ThreadDelete(&_thread);
+    }
+#endif
+#if (NOS_CONFIG_THREAD_SUSPEND_ENABLE > 0)
+    nOS_Error Suspend (void)
+    {
+        return nOS_ThreadSuspend(&_thread);
+    }
+    nOS_Error Resume (void)
+    {
+        return nOS_ThreadResume(&_thread);
+    }
+#endif
+#if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0) && (NOS_CONFIG_THREAD_SET_PRIO_ENABLE > 0)
+    nOS_Error SetPriority (uint8_t prio)
+    {
+        return nOS_ThreadSetPriority(&_thread, prio);
+    }
+#endif
+#if (NOS_CONFIG_THREAD_JOIN_ENABLE > 0)
+    nOS_Error Join (int *ret, nOS_TickCounter timeout)
+    {
+        return nOS_ThreadJoin(&_thread, ret, timeout);
+    }
+#endif
+    nOS_Thread* Get (void)
+    {
+        return &_thread;
+    }
+
+private:
+    nOS_Thread          _thread;
+#ifdef NOS_SIMULATED_STACK
+    nOS_Stack           _stack;
+#else
+    nOS_Stack           _stack[SSize];
+#endif
+};
+
+#if (NOS_CONFIG_TIMER_ENABLE > 0)
+/**********************************************************************************************************************
+ *                                                                                                                    *
+ * Name            : nOS::Timer                                                                                       *
+ *                                                                                                                    *
+ * Description     : Timer whose callback can be a nOS_TimerCallback or any callable object, like a lambda with       *
+ *                   captures.                                                                                        *
+ *                                                                                                                    *
+ * Notes                                                                                                              *
+ *   1. Callable object is kept by reference, it must stay alive as long as timer can expire.                         *
+ *   2. Callable object is called without argument, from the same context than nOS_TimerCallback.                     *
+ *                                                                                                                    *
+ **********************************************************************************************************************/
+class Timer
+{
+public:
+    nOS_Error Create (nOS_TimerCallback callback,
+                      void *arg,
+                      nOS_TimerCounter reload,
+                      nOS_TimerMode mode
+#if (NOS_CONFIG_TIMER_HIGHEST_PRIO > 0)
+                     ,uint8_t prio = 0
+#endif
+#if (NOS_CONFIG_TIMER_SLACK_ENABLE > 0)
+                     ,nOS_TimerCounter slack = 0
+#endif
+                     )
+    {
+        return nOS_TimerCreate(&_timer, callback, arg, reload, mode
+#if (NOS_CONFIG_TIMER_HIGHEST_PRIO > 0)
+                              ,prio
+#endif
+#if (NOS_CONFIG_TIMER_SLACK_ENABLE > 0)
+                              ,slack
+#endif
+                              );
+    }
+    template <class F>
+    nOS_Error Create (F &callback,
+                      nOS_TimerCounter reload,
+                      nOS_TimerMode mode
+#if (NOS_CONFIG_TIMER_HIGHEST_PRIO > 0)
+                     ,uint8_t prio = 0
+#endif
+#if (NOS_CONFIG_TIMER_SLACK_ENABLE > 0)
+                     ,nOS_TimerCounter slack = 0
+#endif
+                     )
+    {
+        return nOS_TimerCreate(&_timer, _Call<F>, &callback, reload, mode
+#if (NOS_CONFIG_TIMER_HIGHEST_PRIO > 0)
+                              ,prio
+#endif
+#if (NOS_CONFIG_TIMER_SLACK_ENABLE > 0)
+                              ,slack
+#endif
+                              );
+    }
+#if (NOS_CONFIG_TIMER_DELETE_ENABLE > 0)
+    nOS_Error Delete (void)
+    {
+        return nOS_TimerDelete(&_timer);
+    }
+#endif
+    nOS_Error Start (void)
+    {
+        return nOS_TimerStart(&_timer);
+    }
+    nOS_Error Stop (bool instant = false)
+    {
+        return nOS_TimerStop(&_timer, instant);
+    }
+    nOS_Error Restart (nOS_TimerCounter reload)
+    {
+        return nOS_TimerRestart(&_timer, reload);
+    }
+    nOS_Error Pause (void)
+    {
+        return nOS_TimerPause(&_timer);
+    }
+    nOS_Error Continue (void)
+    {
+        return nOS_TimerContinue(&_timer);
+    }
+    nOS_Error SetReload (nOS_TimerCounter reload)
+    {
+        return nOS_TimerSetReload(&_timer, reload);
+    }
+    bool IsRunning (void)
+    {
+        return nOS_TimerIsRunning(&_timer);
+    }
+    nOS_Timer* Get (void)
+    {
+        return &_timer;
+    }
+
+private:
+    template <class F>
+    static void _Call (nOS_Timer *timer, void *arg)
+    {
+        NOS_UNUSED(timer);
+
+        (*static_cast<F*>(arg))();
+    }
+
+    nOS_Timer           _timer;
+};
+#endif  /* NOS_CONFIG_TIMER_ENABLE */
+
+}   /* namespace nOS */
+
+#endif /* NOS_HPP */
@@ -22,6 +22,8 @@ typedef uint32_t                            nOS_StatusReg;
 #define NOS_MEM_POINTER_WIDTH               4
 
 #define NOS_32_BITS_SCHEDULER
+#define NOS_USE_DEFERRED_SCHED
+#define NOS_USE_POWER
 
 #ifndef NOS_CONFIG_ISR_STACK_SIZE
  #error "nOSConfig.h: NOS_CONFIG_ISR_STACK_SIZE is not defined: must be higher than 0."
@@ -29,6 +31,10 @@ typedef uint32_t                            nOS_StatusReg;
  #error "nOSConfig.h: NOS_CONFIG_ISR_STACK_SIZE is set to invalid value: must be higher than 0."
 #endif
 
+#ifndef NOS_CONFIG_KERNEL_IRQ_MASK
+ #error "nOSConfig.h: NOS_CONFIG_KERNEL_IRQ_MASK is not defined."
+#endif
+
 __attribute__( ( always_inline ) ) static inline uint32_t _GetMSP (void)
 {
     uint32_t r;
@@ -92,6 +98,11 @@ __attribute__( ( always_inline ) ) static inline void _NOP (void)
     __asm volatile ("NOP");
 }
 
+__attribute__( ( always_inline ) ) static inline void _WFI (void)
+{
+    __asm volatile ("WFI");
+}
+
 __attribute__( ( always_inline ) ) static inline void _DI (void)
 {
     __asm volatile ("CPSID I");
@@ -102,6 +113,32 @@ __attribute__( ( always_inline ) ) static inline void _EI (void)
     __asm volatile ("CPSIE I");
 }
 
+#if (NOS_CONFIG_SCHED_DEFERRED_ENABLE > 0)
+/* Take pending scheduling decision when leaving outermost critical section, PendSV run when interrupts are enabled */
+#define nOS_PendSchedule(sr)                                                    \
+    do {                                                                        \
+        if (((sr) == 0) && nOS_needResched) {                                   \
+            if (nOS_ResolveSchedule()) {                                        \
+                *(volatile uint32_t *)0xE000ED04UL = 0x10000000UL;              \
+            }                                                                   \
+        }                                                                       \
+    } while (0)
+#else
+#define nOS_PendSchedule(sr)
+#endif
+
+#if (NOS_CONFIG_KERNEL_IRQ_MASK > 0)
+/* No BASEPRI on M0: only interrupts that use nOS API are disabled in NVIC, sr is critical section nesting level */
+#define nOS_EnterCritical(sr)                                                   \
+    do {                                                                        \
+        sr = nOS_MaskKernelIrqs();                                              \
+    } while (0)
+
+#define nOS_LeaveCritical(sr)                                                   \
+    do {                                                                        \
+        nOS_UnmaskKernelIrqs(sr);                                               \
+    } while (0)
+#else
 #define nOS_EnterCritical(sr)                                                   \
     do {                                                                        \
         sr = _GetPRIMASK();                                                     \
@@ -112,13 +149,29 @@ __attribute__( ( always_inline ) ) static inline void _EI (void)
 
 #define nOS_LeaveCritical(sr)                                                   \
     do {                                                                        \
+        nOS_PendSchedule(sr);                                                   \
         _SetPRIMASK(sr);                                                        \
         _DSB();                                                                 \
         _ISB();                                                                 \
     } while (0)
+#endif
+
+#if (NOS_CONFIG_KERNEL_IRQ_MASK > 0)
+ nOS_StatusReg  nOS_MaskKernelIrqs      (void);
+ void           nOS_UnmaskKernelIrqs    (nOS_StatusReg sr);
+#endif
 
 void    nOS_EnterIsr        (void);
 void    nOS_LeaveIsr        (void);
+#if (NOS_CONFIG_TICKLESS_ENABLE > 0)
+ void   nOS_TicklessIdle    (void);
+#endif
+
+#if (NOS_CONFIG_POWER_ENABLE > 0)
+ #define NOS_POWER_SLEEP                    0
+ #define NOS_POWER_DEEP_SLEEP               1
+ #define NOS_POWER_MODE_COUNT               2
+#endif
 
 #define NOS_ISR(func)                                                           \
 void func##_ISR(void) __attribute__ ( ( always_inline ) );                      \
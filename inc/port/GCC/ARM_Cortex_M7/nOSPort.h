@@ -23,6 +23,19 @@ typedef uint32_t                            nOS_StatusReg;
 
 #define NOS_32_BITS_SCHEDULER
 #define NOS_USE_CLZ
+#define NOS_USE_EXCLUSIVE
+#define NOS_USE_DEFERRED_SCHED
+#define NOS_USE_POWER
+#define NOS_USE_CYCLE_COUNTER
+#define NOS_USE_CRITICAL_PROFILE
+#define NOS_USE_THREAD_STATS
+#if defined(__VFP_FP__) && !defined(__SOFTFP__)
+ #define NOS_USE_THREAD_FPU
+#endif
+
+#if (NOS_CONFIG_CYCLE_COUNTER_ENABLE > 0)
+ #define nOS_GetCycleCount()                (*(volatile uint32_t *)0xE0001004UL)
+#endif
 
 #ifndef NOS_CONFIG_ISR_STACK_SIZE
  #error "nOSConfig.h: NOS_CONFIG_ISR_STACK_SIZE is not defined: must be higher than 0."
@@ -30,6 +43,16 @@ typedef uint32_t                            nOS_StatusReg;
  #error "nOSConfig.h: NOS_CONFIG_ISR_STACK_SIZE is set to invalid value: must be higher than 0."
 #endif
 
+#ifndef NOS_CONFIG_TCM_ENABLE
+ #error "nOSConfig.h: NOS_CONFIG_TCM_ENABLE is not defined: must be set to 0 or 1."
+#elif (NOS_CONFIG_TCM_ENABLE != 0) && (NOS_CONFIG_TCM_ENABLE != 1)
+ #error "nOSConfig.h: NOS_CONFIG_TCM_ENABLE is set to invalid value: must be set to 0 or 1."
+#elif (NOS_CONFIG_TCM_ENABLE > 0)
+ /* Sections are placed in DTCM and ITCM by application linker file, see nOSTCM.ld */
+ #define NOS_FAST_DATA                      __attribute__((section(".nos_dtcm")))
+ #define NOS_FAST_CODE                      __attribute__((section(".nos_itcm")))
+#endif
+
 /* __NVIC_PRIO_BITS defined from CMSIS if used */
 #ifdef NOS_CONFIG_NVIC_PRIO_BITS
  #define NOS_NVIC_PRIO_BITS                 NOS_CONFIG_NVIC_PRIO_BITS
@@ -124,6 +147,11 @@ __attribute__( ( always_inline ) ) static inline void _NOP (void)
     __asm volatile ("NOP");
 }
 
+__attribute__( ( always_inline ) ) static inline void _WFI (void)
+{
+    __asm volatile ("WFI");
+}
+
 __attribute__( ( always_inline ) ) static inline void _DI (void)
 {
     __asm volatile ("CPSID I");
@@ -145,6 +173,34 @@ __attribute__( ( always_inline ) ) static inline uint32_t _CLZ(uint32_t n)
     return r;
 }
 
+__attribute__( ( always_inline ) ) static inline uint32_t _LDREX(volatile uint32_t *p)
+{
+    register uint32_t r;
+    __asm volatile ("LDREX %0, [%1]" : "=r" (r) : "r" (p) : "memory");
+    return r;
+}
+
+__attribute__( ( always_inline ) ) static inline uint32_t _STREX(uint32_t v, volatile uint32_t *p)
+{
+    register uint32_t r;
+    __asm volatile ("STREX %0, %1, [%2]" : "=&r" (r) : "r" (v), "r" (p) : "memory");
+    return r;
+}
+
+#if (NOS_CONFIG_SCHED_DEFERRED_ENABLE > 0)
+/* Take pending scheduling decision when leaving outermost critical section, PendSV run when interrupts are enabled */
+#define nOS_PendSchedule(sr)                                                    \
+    do {                                                                        \
+        if (((sr) == 0) && nOS_needResched) {                                   \
+            if (nOS_ResolveSchedule()) {                                        \
+                *(volatile uint32_t *)0xE000ED04UL = 0x10000000UL;              \
+            }                                                                   \
+        }                                                                       \
+    } while (0)
+#else
+#define nOS_PendSchedule(sr)
+#endif
+
 #if (NOS_CONFIG_MAX_UNSAFE_ISR_PRIO > 0)
 #define nOS_EnterCritical(sr)                                                   \
     do {                                                                        \
@@ -154,10 +210,13 @@ __attribute__( ( always_inline ) ) static inline uint32_t _CLZ(uint32_t n)
             _DSB();                                                             \
             _ISB();                                                             \
         }                                                                       \
+        nOS_ProfileEnter(sr == 0 || sr > NOS_MAX_UNSAFE_BASEPRI);               \
     } while (0)
 
 #define nOS_LeaveCritical(sr)                                                   \
     do {                                                                        \
+        nOS_PendSchedule(sr);                                                   \
+        nOS_ProfileLeave(sr == 0 || sr > NOS_MAX_UNSAFE_BASEPRI);               \
         _SetBASEPRI(sr);                                                        \
         _DSB();                                                                 \
         _ISB();                                                                 \
@@ -169,18 +228,30 @@ __attribute__( ( always_inline ) ) static inline uint32_t _CLZ(uint32_t n)
         _DI();                                                                  \
         _DSB();                                                                 \
         _ISB();                                                                 \
+        nOS_ProfileEnter(sr == 0);                                              \
     } while (0)
 
 #define nOS_LeaveCritical(sr)                                                   \
     do {                                                                        \
+        nOS_PendSchedule(sr);                                                   \
+        nOS_ProfileLeave(sr == 0);                                              \
         _SetPRIMASK(sr);                                                        \
         _DSB();                                                                 \
         _ISB();                                                                 \
     } while (0)
 #endif
 
-void    nOS_EnterIsr    (void);
-void    nOS_LeaveIsr    (void);
+void    nOS_EnterIsr        (void);
+void    nOS_LeaveIsr        (void);
+#if (NOS_CONFIG_TICKLESS_ENABLE > 0)
+ void   nOS_TicklessIdle    (void);
+#endif
+
+#if (NOS_CONFIG_POWER_ENABLE > 0)
+ #define NOS_POWER_SLEEP                    0
+ #define NOS_POWER_DEEP_SLEEP               1
+ #define NOS_POWER_MODE_COUNT               2
+#endif
 
 #define NOS_ISR(func)                                                           \
 void func##_ISR(void) __attribute__ ( ( always_inline ) );                      \
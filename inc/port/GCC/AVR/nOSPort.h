@@ -22,6 +22,8 @@ typedef uint8_t                 nOS_StatusReg;
 #define NOS_UNUSED(v)           (void)v
 
 #define NOS_MEM_ALIGNMENT       1
+#define NOS_USE_NIBBLE_TABLE
+#define NOS_USE_POWER
 
 #ifdef NOS_CONFIG_ISR_STACK_SIZE
  #if (NOS_CONFIG_ISR_STACK_SIZE == 0)
@@ -125,10 +127,67 @@ typedef uint8_t                 nOS_StatusReg;
         "push r29                           \n"                                 \
         "push r30                           \n"                                 \
         "push r31                           \n"                                 \
+        /* Frame marker: all registers */                                       \
+        "push r1                            \n"                                 \
+    )
+
+/* Frame saved by nOS_SwitchContext, only registers preserved across function calls */
+#define PUSH_CALL_CONTEXT()                                                     \
+    asm volatile (                                                              \
+        "in   r0, %[SREG_ADDR]              \n"                                 \
+        "push r0                            \n"                                 \
+        "push r2                            \n"                                 \
+        "push r3                            \n"                                 \
+        "push r4                            \n"                                 \
+        "push r5                            \n"                                 \
+        "push r6                            \n"                                 \
+        "push r7                            \n"                                 \
+        "push r8                            \n"                                 \
+        "push r9                            \n"                                 \
+        "push r10                           \n"                                 \
+        "push r11                           \n"                                 \
+        "push r12                           \n"                                 \
+        "push r13                           \n"                                 \
+        "push r14                           \n"                                 \
+        "push r15                           \n"                                 \
+        "push r16                           \n"                                 \
+        "push r17                           \n"                                 \
+        "push r28                           \n"                                 \
+        "push r29                           \n"                                 \
+        /* Frame marker: call saved registers only */                           \
+        "ldi  r18, 1                        \n"                                 \
+        "push r18                           \n"                                 \
+        :: [SREG_ADDR] "I" (_SFR_IO_ADDR(SREG))                                 \
     )
 
+/* Restore frame saved by ISR or by nOS_SwitchContext, a call frame return directly to caller of nOS_SwitchContext */
 #define POP_CONTEXT()                                                           \
     asm volatile (                                                              \
+        "pop  r0                            \n"                                 \
+        "tst  r0                            \n"                                 \
+        "breq 1f                            \n"                                 \
+        "pop  r29                           \n"                                 \
+        "pop  r28                           \n"                                 \
+        "pop  r17                           \n"                                 \
+        "pop  r16                           \n"                                 \
+        "pop  r15                           \n"                                 \
+        "pop  r14                           \n"                                 \
+        "pop  r13                           \n"                                 \
+        "pop  r12                           \n"                                 \
+        "pop  r11                           \n"                                 \
+        "pop  r10                           \n"                                 \
+        "pop  r9                            \n"                                 \
+        "pop  r8                            \n"                                 \
+        "pop  r7                            \n"                                 \
+        "pop  r6                            \n"                                 \
+        "pop  r5                            \n"                                 \
+        "pop  r4                            \n"                                 \
+        "pop  r3                            \n"                                 \
+        "pop  r2                            \n"                                 \
+        "pop  r0                            \n"                                 \
+        "out  %[SREG_ADDR], r0              \n"                                 \
+        "ret                                \n"                                 \
+        "1:                                 \n"                                 \
         "pop  r31                           \n"                                 \
         "pop  r30                           \n"                                 \
         "pop  r29                           \n"                                 \
@@ -160,6 +219,7 @@ typedef uint8_t                 nOS_StatusReg;
         "pop  r3                            \n"                                 \
         "pop  r2                            \n"                                 \
         "pop  r1                            \n"                                 \
+        :: [SREG_ADDR] "I" (_SFR_IO_ADDR(SREG))                                 \
     );                                                                          \
     POP_EIND();                                                                 \
     POP_RAMPZ();                                                                \
@@ -173,6 +233,12 @@ typedef uint8_t                 nOS_StatusReg;
 nOS_Stack*      nOS_EnterIsr        (nOS_Stack *sp);
 nOS_Stack*      nOS_LeaveIsr        (nOS_Stack *sp);
 
+#if (NOS_CONFIG_POWER_ENABLE > 0)
+ #define NOS_POWER_IDLE         0
+ #define NOS_POWER_DOWN         1
+ #define NOS_POWER_MODE_COUNT   2
+#endif
+
 #define NOS_ISR(vect)                                                           \
 void vect##_ISR(void) __attribute__ ( ( naked ) );                              \
 inline void vect##_ISR_L2(void) __attribute__( ( always_inline ) );             \
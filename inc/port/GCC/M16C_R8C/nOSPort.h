@@ -20,6 +20,7 @@ typedef uint16_t                            nOS_StatusReg;
 
 #define NOS_MEM_ALIGNMENT                   2
 #define NOS_MEM_POINTER_WIDTH               2
+#define NOS_USE_NIBBLE_TABLE
 
 #define NOS_16_BITS_SCHEDULER
 #define NOS_DONT_USE_CONST
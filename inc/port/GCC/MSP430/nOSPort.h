@@ -25,6 +25,8 @@ extern "C" {
 #define NOS_16_BITS_SCHEDULER
 #define NOS_MEM_ALIGNMENT           __SIZEOF_POINTER__
 #define NOS_MEM_POINTER_WIDTH       __SIZEOF_POINTER__
+#define NOS_USE_BYTE_TABLE
+#define NOS_USE_POWER
 typedef uint16_t                    nOS_StatusReg;
 
 #ifdef NOS_CONFIG_ISR_STACK_SIZE
@@ -61,6 +63,8 @@ typedef uint16_t                    nOS_StatusReg;
 #if (__MSP430X__ > 0)
  #define PUSH_CONTEXT            PUSHM_X"   #12,    r15"
  #define POP_CONTEXT             POPM_X"    #12,    r15"
+ #define PUSH_CALL_CONTEXT       PUSHM_X"   #7,     r10"
+ #define POP_CALL_CONTEXT        POPM_X"    #7,     r10"
 #else
  #define PUSH_CONTEXT           "push.w     r15             \n"                 \
                                 "push.w     r14             \n"                 \
@@ -86,8 +90,37 @@ typedef uint16_t                    nOS_StatusReg;
                                 "pop.w      r13             \n"                 \
                                 "pop.w      r14             \n"                 \
                                 "pop.w      r15"
+ #define PUSH_CALL_CONTEXT      "push.w     r10             \n"                 \
+                                "push.w     r9              \n"                 \
+                                "push.w     r8              \n"                 \
+                                "push.w     r7              \n"                 \
+                                "push.w     r6              \n"                 \
+                                "push.w     r5              \n"                 \
+                                "push.w     r4"
+ #define POP_CALL_CONTEXT       "pop.w      r4              \n"                 \
+                                "pop.w      r5              \n"                 \
+                                "pop.w      r6              \n"                 \
+                                "pop.w      r7              \n"                 \
+                                "pop.w      r8              \n"                 \
+                                "pop.w      r9              \n"                 \
+                                "pop.w      r10"
 #endif
 
+/* Frame saved by ISR hold all registers, frame saved by nOS_SwitchContextHandler only registers preserved across
+ * function calls (R4 to R10). Last word pushed tell which one has to be restored, both end with SR and return. */
+#define PUSH_FULL_FRAME         PUSH_CONTEXT"               \n"                 \
+                                PUSH_X"     #0"
+#define PUSH_CALL_FRAME         PUSH_CALL_CONTEXT"          \n"                 \
+                                PUSH_X"     #1"
+#define POP_FRAME               POP_X"      r15             \n"                 \
+                                "tst.w      r15             \n"                 \
+                                "jnz        1f              \n"                 \
+                                POP_CONTEXT"                \n"                 \
+                                "jmp        2f              \n"                 \
+                                "1:                         \n"                 \
+                                POP_CALL_CONTEXT"           \n"                 \
+                                "2:"
+
 #define nOS_EnterCritical(sr)                                                   \
     do {                                                                        \
         sr = __get_interrupt_state();                                           \
@@ -104,6 +137,15 @@ typedef uint16_t                    nOS_StatusReg;
 nOS_Stack*  nOS_EnterIsr        (nOS_Stack *sp);
 nOS_Stack*  nOS_LeaveIsr        (nOS_Stack *sp);
 
+#if (NOS_CONFIG_POWER_ENABLE > 0)
+ #define NOS_POWER_LPM0             0
+ #define NOS_POWER_LPM1             1
+ #define NOS_POWER_LPM2             2
+ #define NOS_POWER_LPM3             3
+ #define NOS_POWER_LPM4             4
+ #define NOS_POWER_MODE_COUNT       5
+#endif
+
 #define NOS_ISR(vect)                                                           \
 void vect##_ISR_L2(void) __attribute__ ((naked));                               \
 inline void vect##_ISR_L3(void) __attribute__ ((always_inline));                \
@@ -120,7 +162,7 @@ void vect##_ISR_L2(void)
          PUSH_SR"                               \n"                             \
         "                                       \n"                             \
         /* Push all registers to running thread stack */                        \
-         PUSH_CONTEXT"                          \n"                             \
+         PUSH_FULL_FRAME"                       \n"                             \
         "                                       \n"                             \
         /* Switch to isr stack if isr nesting counter is zero */                \
         "mov.w      sp,                 r12     \n"                             \
@@ -136,8 +178,8 @@ void vect##_ISR_L2(void)
         CALL_X"     #nOS_LeaveIsr               \n"                             \
         "mov.w      r12,                sp      \n"                             \
         "                                       \n"                             \
-        /* Pop all registers from high prio thread stack */                     \
-         POP_CONTEXT"                           \n"                             \
+        /* Pop registers saved in high prio thread stack */                     \
+         POP_FRAME"                             \n"                             \
         "                                       \n"                             \
          POP_SR"                                \n"                             \
         "                                       \n"                             \
@@ -149,7 +191,9 @@ inline void vect##_ISR_L3(void)
 /* Unused function for this port */
 #define     nOS_InitSpecific()
 
-#define     nOS_SwitchContext()         asm volatile (CALL_X" #nOS_SwitchContextHandler")
+/* Registers not preserved across function calls are not saved by nOS_SwitchContextHandler */
+#define     nOS_SwitchContext()                                                 \
+    asm volatile (CALL_X" #nOS_SwitchContextHandler" ::: "r11", "r12", "r13", "r14", "r15", "memory")
 void        nOS_SwitchContextHandler    (void) __attribute__ ((naked));
 
 #ifdef NOS_PRIVATE
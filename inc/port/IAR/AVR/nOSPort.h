@@ -21,6 +21,8 @@ typedef uint8_t                         nOS_StatusReg;
 #define NOS_UNUSED(v)                   (void)v
 
 #define NOS_MEM_ALIGNMENT               1
+#define NOS_USE_NIBBLE_TABLE
+/* NOS_USE_POWER is not defined, power-aware idle manager (NOS_CONFIG_POWER_ENABLE) is only implemented in GCC ports */
 
 #define NOS_USE_SEPARATE_CALL_STACK
 
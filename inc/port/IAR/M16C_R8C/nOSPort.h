@@ -22,6 +22,7 @@ typedef __ilevel_t                          nOS_StatusReg;
 
 #define NOS_MEM_ALIGNMENT                   2
 #define NOS_MEM_POINTER_WIDTH               2
+#define NOS_USE_BYTE_TABLE
 
 #define NOS_16_BITS_SCHEDULER
 
@@ -35,6 +35,8 @@ extern "C" {
  #define NOS_MEM_ALIGNMENT          2
  #define NOS_MEM_POINTER_WIDTH      2
 #endif
+#define NOS_USE_BYTE_TABLE
+/* NOS_USE_POWER is not defined, power-aware idle manager (NOS_CONFIG_POWER_ENABLE) is only implemented in GCC ports */
 typedef __istate_t                  nOS_StatusReg;
 
 #ifdef NOS_CONFIG_ISR_STACK_SIZE
@@ -24,6 +24,7 @@ typedef uint8_t                 nOS_StatusReg;
 #define NOS_UNUSED(v)           (void)v
 
 #define NOS_MEM_ALIGNMENT       1
+#define NOS_USE_BYTE_TABLE
 
 #if   (__DATA_MODEL__ == __SMALL_DATA_MODEL__)
  #error "nOSConfig.h: Small data model is not supported: must use Medium or Large."
@@ -21,7 +21,11 @@ typedef uint32_t                            nOS_StatusReg;
 #define NOS_MEM_ALIGNMENT                   4
 #define NOS_MEM_POINTER_WIDTH               4
 
+#define nOS_MemoryBarrier()                 __dmb(0xF)
+
 #define NOS_32_BITS_SCHEDULER
+#define NOS_USE_DEFERRED_SCHED
+/* NOS_USE_POWER is not defined, power-aware idle manager (NOS_CONFIG_POWER_ENABLE) is only implemented in GCC ports */
 
 #ifndef NOS_CONFIG_ISR_STACK_SIZE
  #error "nOSConfig.h: NOS_CONFIG_ISR_STACK_SIZE is not defined: must be higher than 0."
@@ -29,6 +33,13 @@ typedef uint32_t                            nOS_StatusReg;
  #error "nOSConfig.h: NOS_CONFIG_ISR_STACK_SIZE is set to invalid value: must be higher than 0."
 #endif
 
+#ifndef NOS_CONFIG_KERNEL_IRQ_MASK
+ #error "nOSConfig.h: NOS_CONFIG_KERNEL_IRQ_MASK is not defined."
+#elif (NOS_CONFIG_KERNEL_IRQ_MASK > 0)
+ /* NVIC masking of this port has not been built and tested with this compiler, only GCC port is verified */
+ #error "nOSConfig.h: NOS_CONFIG_KERNEL_IRQ_MASK is not verified with this compiler: must be set to 0."
+#endif
+
 static inline uint32_t _GetMSP (void)
 {
     register uint32_t volatile _msp __asm("msp");
@@ -85,6 +96,32 @@ static inline void _SetPRIMASK (uint32_t r)
     _primask = r;
 }
 
+#if (NOS_CONFIG_SCHED_DEFERRED_ENABLE > 0)
+/* Take pending scheduling decision when leaving outermost critical section, PendSV run when interrupts are enabled */
+#define nOS_PendSchedule(sr)                                                    \
+    do {                                                                        \
+        if (((sr) == 0) && nOS_needResched) {                                   \
+            if (nOS_ResolveSchedule()) {                                        \
+                *(volatile uint32_t *)0xE000ED04UL = 0x10000000UL;              \
+            }                                                                   \
+        }                                                                       \
+    } while (0)
+#else
+#define nOS_PendSchedule(sr)
+#endif
+
+#if (NOS_CONFIG_KERNEL_IRQ_MASK > 0)
+/* No BASEPRI on M0: only interrupts that use nOS API are disabled in NVIC, sr is critical section nesting level */
+#define nOS_EnterCritical(sr)                                                   \
+    do {                                                                        \
+        sr = nOS_MaskKernelIrqs();                                              \
+    } while (0)
+
+#define nOS_LeaveCritical(sr)                                                   \
+    do {                                                                        \
+        nOS_UnmaskKernelIrqs(sr);                                               \
+    } while (0)
+#else
 #define nOS_EnterCritical(sr)                                                   \
     do {                                                                        \
         sr = _GetPRIMASK();                                                     \
@@ -95,10 +132,17 @@ static inline void _SetPRIMASK (uint32_t r)
 
 #define nOS_LeaveCritical(sr)                                                   \
     do {                                                                        \
+        nOS_PendSchedule(sr);                                                   \
         _SetPRIMASK(sr);                                                        \
         __dsb(0xF);                                                             \
         __isb(0xF);                                                             \
     } while (0)
+#endif
+
+#if (NOS_CONFIG_KERNEL_IRQ_MASK > 0)
+ nOS_StatusReg  nOS_MaskKernelIrqs      (void);
+ void           nOS_UnmaskKernelIrqs    (nOS_StatusReg sr);
+#endif
 
 void    nOS_EnterIsr    (void);
 void    nOS_LeaveIsr    (void);
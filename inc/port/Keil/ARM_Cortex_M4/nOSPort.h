@@ -21,8 +21,23 @@ typedef uint32_t                            nOS_StatusReg;
 #define NOS_MEM_ALIGNMENT                   4
 #define NOS_MEM_POINTER_WIDTH               4
 
+#define nOS_MemoryBarrier()                 __dmb(0xF)
+
 #define NOS_32_BITS_SCHEDULER
 #define NOS_USE_CLZ
+#define NOS_USE_EXCLUSIVE
+#define NOS_USE_DEFERRED_SCHED
+#define NOS_USE_CYCLE_COUNTER
+#define NOS_USE_CRITICAL_PROFILE
+#define NOS_USE_THREAD_STATS
+/* NOS_USE_POWER is not defined, power-aware idle manager (NOS_CONFIG_POWER_ENABLE) is only implemented in GCC ports */
+#if defined(__TARGET_FPU_VFP)
+ #define NOS_USE_THREAD_FPU
+#endif
+
+#if (NOS_CONFIG_CYCLE_COUNTER_ENABLE > 0)
+ #define nOS_GetCycleCount()                (*(volatile uint32_t *)0xE0001004UL)
+#endif
 
 #ifndef NOS_CONFIG_ISR_STACK_SIZE
  #error "nOSConfig.h: NOS_CONFIG_ISR_STACK_SIZE is not defined: must be higher than 0."
@@ -50,6 +65,8 @@ typedef uint32_t                            nOS_StatusReg;
 #endif
 
 #define _CLZ(n)                             __clz(n)
+#define _LDREX(p)                           __ldrex(p)
+#define _STREX(v,p)                         __strex(v, p)
 
 static inline uint32_t _GetMSP (void)
 {
@@ -121,6 +138,20 @@ static inline void _SetPRIMASK (uint32_t r)
     _primask = r;
 }
 
+#if (NOS_CONFIG_SCHED_DEFERRED_ENABLE > 0)
+/* Take pending scheduling decision when leaving outermost critical section, PendSV run when interrupts are enabled */
+#define nOS_PendSchedule(sr)                                                    \
+    do {                                                                        \
+        if (((sr) == 0) && nOS_needResched) {                                   \
+            if (nOS_ResolveSchedule()) {                                        \
+                *(volatile uint32_t *)0xE000ED04UL = 0x10000000UL;              \
+            }                                                                   \
+        }                                                                       \
+    } while (0)
+#else
+#define nOS_PendSchedule(sr)
+#endif
+
 #if (NOS_CONFIG_MAX_UNSAFE_ISR_PRIO > 0)
 #define nOS_EnterCritical(sr)                                                   \
     do {                                                                        \
@@ -130,10 +161,13 @@ static inline void _SetPRIMASK (uint32_t r)
             __dsb(0xF);                                                         \
             __isb(0xF);                                                         \
         }                                                                       \
+        nOS_ProfileEnter(sr == 0 || sr > NOS_MAX_UNSAFE_BASEPRI);               \
     } while (0)
 
 #define nOS_LeaveCritical(sr)                                                   \
     do {                                                                        \
+        nOS_PendSchedule(sr);                                                   \
+        nOS_ProfileLeave(sr == 0 || sr > NOS_MAX_UNSAFE_BASEPRI);               \
         _SetBASEPRI(sr);                                                        \
         __dsb(0xF);                                                             \
         __isb(0xF);                                                             \
@@ -145,10 +179,13 @@ static inline void _SetPRIMASK (uint32_t r)
         __disable_irq();                                                        \
         __dsb(0xF);                                                             \
         __isb(0xF);                                                             \
+        nOS_ProfileEnter(sr == 0);                                              \
     } while (0)
 
 #define nOS_LeaveCritical(sr)                                                   \
     do {                                                                        \
+        nOS_PendSchedule(sr);                                                   \
+        nOS_ProfileLeave(sr == 0);                                              \
         _SetPRIMASK(sr);                                                        \
         __dsb(0xF);                                                             \
         __isb(0xF);                                                             \
@@ -25,6 +25,11 @@ extern "C" {
 #endif
 
 #define NOS_32_BITS_SCHEDULER
+#define NOS_USE_DEFERRED_SCHED
+#define NOS_USE_CYCLE_COUNTER
+#define NOS_USE_CRITICAL_PROFILE
+#define NOS_USE_THREAD_STATS
+#define NOS_USE_SMP
 
 #define NOS_SIMULATED_STACK
 
@@ -37,14 +42,48 @@ typedef struct nOS_Stack
     pthread_cond_t      cond;
     bool                started;
     bool                running;
+    bool                exit;
+#if (NOS_CONFIG_THREAD_JOIN_ENABLE > 0)
+    bool                finished;
+#endif
 } nOS_Stack;
 
 typedef uint32_t                            nOS_StatusReg;
 
 #ifndef NOS_CONFIG_TICKS_PER_SECOND
- #error "nOSConfig.h: NOS_CONFIG_TICKS_PER_SECOND is not defined: must be set between 1 and 100 inclusively."
-#elif (NOS_CONFIG_TICKS_PER_SECOND < 1) || (NOS_CONFIG_TICKS_PER_SECOND > 100)
- #error "nOSConfig.h: NOS_CONFIG_TICKS_PER_SECOND is set to invalid value: must be set between 1 and 100 inclusively."
+ #error "nOSConfig.h: NOS_CONFIG_TICKS_PER_SECOND is not defined: must be set between 1 and 10000 inclusively."
+#elif (NOS_CONFIG_TICKS_PER_SECOND < 1) || (NOS_CONFIG_TICKS_PER_SECOND > 10000)
+ #error "nOSConfig.h: NOS_CONFIG_TICKS_PER_SECOND is set to invalid value: must be set between 1 and 10000 inclusively."
+#endif
+
+#ifndef NOS_CONFIG_VIRTUAL_TIME_ENABLE
+ #error "nOSConfig.h: NOS_CONFIG_VIRTUAL_TIME_ENABLE is not defined: must be set to 0 or 1."
+#elif (NOS_CONFIG_VIRTUAL_TIME_ENABLE != 0) && (NOS_CONFIG_VIRTUAL_TIME_ENABLE != 1)
+ #error "nOSConfig.h: NOS_CONFIG_VIRTUAL_TIME_ENABLE is set to invalid value: must be set to 0 or 1."
+#elif (NOS_CONFIG_VIRTUAL_TIME_ENABLE > 0) && (NOS_CONFIG_SMP_CORE_COUNT > 1)
+ #error "nOSConfig.h: NOS_CONFIG_VIRTUAL_TIME_ENABLE can't be used when NOS_CONFIG_SMP_CORE_COUNT is higher than 1."
+#endif
+
+#if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+ /* Each simulated core run in parallel with others, host threads keep their own core and critical nesting counter */
+ #define NOS_PORT_TLS                       __thread
+ #define nOS_GetCoreId()                    nOS_coreId
+#else
+ #define NOS_PORT_TLS
+#endif
+
+#if (NOS_CONFIG_SCHED_DEFERRED_ENABLE > 0)
+/* Take pending scheduling decision when leaving outermost critical section */
+#define nOS_PendSchedule()                                                      \
+    do {                                                                        \
+        if ((nOS_criticalNestingCounter == 1) && nOS_needResched) {             \
+            if (nOS_ResolveSchedule()) {                                        \
+                nOS_SwitchContext();                                            \
+            }                                                                   \
+        }                                                                       \
+    } while (0)
+#else
+#define nOS_PendSchedule()
 #endif
 
 #define nOS_EnterCritical(sr)                                                   \
@@ -56,11 +95,14 @@ typedef uint32_t                            nOS_StatusReg;
             pthread_mutex_unlock(&nOS_criticalSection);                         \
         }                                                                       \
         nOS_criticalNestingCounter++;                                           \
+        nOS_ProfileEnter(nOS_criticalNestingCounter == 1);                      \
     } while (0)
 
 #define nOS_LeaveCritical(sr)                                                   \
     do {                                                                        \
         NOS_UNUSED(sr);                                                         \
+        nOS_PendSchedule();                                                     \
+        nOS_ProfileLeave(nOS_criticalNestingCounter == 1);                      \
         nOS_criticalNestingCounter--;                                           \
         if (nOS_criticalNestingCounter == 0) {                                  \
             /* Unlock mutex when nesting counter reach zero */                  \
@@ -68,15 +110,27 @@ typedef uint32_t                            nOS_StatusReg;
         }                                                                       \
     } while (0)
 
-extern volatile uint32_t    nOS_criticalNestingCounter;
-extern pthread_mutex_t      nOS_criticalSection;
+extern NOS_PORT_TLS volatile uint32_t   nOS_criticalNestingCounter;
+extern pthread_mutex_t                  nOS_criticalSection;
+#if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+ extern NOS_PORT_TLS uint8_t            nOS_coreId;
+#endif
 
 int     nOS_Print           (const char *format, ...);
+#if (NOS_CONFIG_CYCLE_COUNTER_ENABLE > 0)
+ uint32_t nOS_GetCycleCount (void);
+#endif
+
+#if (NOS_CONFIG_SCHED_DEFERRED_ENABLE > 0)
+ void   nOS_SwitchContext   (void);
+#endif
 
 #ifdef NOS_PRIVATE
  void   nOS_InitSpecific    (void);
  void   nOS_InitContext     (nOS_Thread *thread, nOS_Stack *stack, size_t ssize, nOS_ThreadEntry entry, void *arg);
- void   nOS_SwitchContext   (void);
+ #if (NOS_CONFIG_SCHED_DEFERRED_ENABLE == 0)
+  void  nOS_SwitchContext   (void);
+ #endif
 #endif
 
 #ifdef __cplusplus
@@ -32,14 +32,23 @@ typedef struct nOS_Stack
     void            *arg;
     bool            sync;
     HANDLE          hsync;
+#if (NOS_CONFIG_THREAD_JOIN_ENABLE > 0)
+    bool            finished;
+#endif
 } nOS_Stack;
 
 typedef DWORD                               nOS_StatusReg;
 
 #ifndef NOS_CONFIG_TICKS_PER_SECOND
- #error "nOSConfig.h: NOS_CONFIG_TICKS_PER_SECOND is not defined: must be set between 1 and 100 inclusively."
-#elif (NOS_CONFIG_TICKS_PER_SECOND < 1) || (NOS_CONFIG_TICKS_PER_SECOND > 100)
- #error "nOSConfig.h: NOS_CONFIG_TICKS_PER_SECOND is set to invalid value: must be set between 1 and 100 inclusively."
+ #error "nOSConfig.h: NOS_CONFIG_TICKS_PER_SECOND is not defined: must be set between 1 and 10000 inclusively."
+#elif (NOS_CONFIG_TICKS_PER_SECOND < 1) || (NOS_CONFIG_TICKS_PER_SECOND > 10000)
+ #error "nOSConfig.h: NOS_CONFIG_TICKS_PER_SECOND is set to invalid value: must be set between 1 and 10000 inclusively."
+#endif
+
+#ifndef NOS_CONFIG_VIRTUAL_TIME_ENABLE
+ #error "nOSConfig.h: NOS_CONFIG_VIRTUAL_TIME_ENABLE is not defined: must be set to 0 or 1."
+#elif (NOS_CONFIG_VIRTUAL_TIME_ENABLE != 0) && (NOS_CONFIG_VIRTUAL_TIME_ENABLE != 1)
+ #error "nOSConfig.h: NOS_CONFIG_VIRTUAL_TIME_ENABLE is set to invalid value: must be set to 0 or 1."
 #endif
 
 #define nOS_EnterCritical(sr)                                                   \
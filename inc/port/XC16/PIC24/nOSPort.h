@@ -22,8 +22,10 @@ typedef uint16_t                            nOS_StatusReg;
 
 #define NOS_MEM_ALIGNMENT                   2
 #define NOS_MEM_POINTER_WIDTH               2
+#define NOS_USE_BYTE_TABLE
 
 #define NOS_16_BITS_SCHEDULER
+#define NOS_STACK_GROW_UP
 
 #ifndef NOS_CONFIG_ISR_STACK_SIZE
  #error "nOSConfig.h: NOS_CONFIG_ISR_STACK_SIZE is not defined: must be higher than 0."
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2014-2016 Jim Tremblay
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#define NOS_PRIVATE
+#include "nOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if (NOS_CONFIG_ACTIVE_ENABLE > 0)
+/* Active objects are jobs with a ring of event pointers: many of them share each preemption level of job thread
+ * instead of having their own thread, stack and queue. Posting store the pointer and activate the job only when
+ * ring was empty. Each run dispatch one event, then activate the job again if more are waiting, so other objects of
+ * same level are served in turn and higher levels can preempt between events. */
+static void _Dispatch (nOS_Job *job, void *arg)
+{
+    nOS_StatusReg   sr;
+    nOS_Active      *ao = (nOS_Active*)arg;
+    void            *event;
+    bool            more;
+
+    NOS_UNUSED(job);
+
+    nOS_EnterCritical(sr);
+    if (ao->count > 0) {
+        event = ao->events[ao->r];
+        ao->r = (uint16_t)((ao->r + 1) % ao->max);
+        ao->count--;
+        nOS_LeaveCritical(sr);
+
+        /* Handler run outside of critical section, it can post to any object including itself */
+        ao->handler(ao, event);
+
+        nOS_EnterCritical(sr);
+        more = (ao->count > 0);
+        nOS_LeaveCritical(sr);
+
+        if (more) {
+            /* Already pending if an event has been posted while ring was empty */
+            nOS_JobActivate(&ao->job);
+        }
+    }
+    else {
+        nOS_LeaveCritical(sr);
+    }
+}
+
+nOS_Error nOS_ActiveCreate (nOS_Active *ao, nOS_ActiveHandler handler, void **buffer, uint16_t max, uint8_t prio)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (ao == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if ((handler == NULL) || (buffer == NULL)) {
+        err = NOS_E_NULL;
+    }
+    else if (max == 0) {
+        err = NOS_E_INV_VAL;
+    } else
+#endif
+    {
+        /* Job validate prio and refuse an object already created */
+        err = nOS_JobCreate(&ao->job, _Dispatch, ao, prio);
+        if (err == NOS_OK) {
+            nOS_EnterCritical(sr);
+            ao->handler = handler;
+            ao->events  = buffer;
+            ao->max     = max;
+            ao->count   = 0;
+            ao->r       = 0;
+            ao->w       = 0;
+            nOS_LeaveCritical(sr);
+        }
+    }
+
+    return err;
+}
+
+#if (NOS_CONFIG_ACTIVE_DELETE_ENABLE > 0)
+/* Events still in ring are forgotten, they are reset when object is created again */
+nOS_Error nOS_ActiveDelete (nOS_Active *ao)
+{
+    nOS_Error       err;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (ao == NULL) {
+        err = NOS_E_INV_OBJ;
+    } else
+#endif
+    {
+        err = nOS_JobDelete(&ao->job);
+    }
+
+    return err;
+}
+#endif
+
+nOS_Error nOS_ActivePost (nOS_Active *ao, void *event)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+    bool            activate = false;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (ao == NULL) {
+        err = NOS_E_INV_OBJ;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (ao->job.state == NOS_JOB_DELETED) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        if (ao->count == ao->max) {
+            err = NOS_E_FULL;
+        }
+        else {
+            ao->events[ao->w] = event;
+            ao->w = (uint16_t)((ao->w + 1) % ao->max);
+            ao->count++;
+            /* Only first event need to activate the job, dispatcher activate it again for the others */
+            activate = (ao->count == 1);
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+
+        if (activate) {
+            /* Outside of critical section: if posted from a job of lower prio, object is dispatched immediately */
+            nOS_JobActivate(&ao->job);
+        }
+    }
+
+    return err;
+}
+
+bool nOS_ActiveIsEmpty (nOS_Active *ao)
+{
+    nOS_StatusReg   sr;
+    bool            empty;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (ao == NULL) {
+        empty = false;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (ao->job.state == NOS_JOB_DELETED) {
+            empty = false;
+        } else
+#endif
+        {
+            empty = (ao->count == 0);
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return empty;
+}
+#endif  /* NOS_CONFIG_ACTIVE_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
@@ -14,13 +14,12 @@ extern "C" {
 #endif
 
 #if (NOS_CONFIG_TIME_ENABLE > 0) && (NOS_CONFIG_ALARM_ENABLE > 0)
-typedef struct _TickContext
+typedef struct _Item
 {
-    nOS_Time    time;
-#if (NOS_CONFIG_ALARM_THREAD_ENABLE > 0)
-    bool        triggered;
-#endif
-} _TickContext;
+    nOS_Alarm           *alarm;
+    nOS_AlarmCallback   callback;
+    void                *arg;
+} _Item;
 
 #if (NOS_CONFIG_ALARM_THREAD_ENABLE > 0)
  #if (NOS_CONFIG_THREAD_JOIN_ENABLE > 0)
@@ -29,10 +28,9 @@ typedef struct _TickContext
   static void _Thread (void *arg);
  #endif
 #endif
-static  void    _Tick       (void *payload, void *arg);
-
-static nOS_List         _waitingList;
+static nOS_List         _waitingList;   /* Sorted by time, next alarm to trigger is at head */
 static nOS_List         _triggeredList;
+static nOS_Time         _lastTime;
 #if (NOS_CONFIG_ALARM_THREAD_ENABLE > 0)
  static nOS_Thread      _thread;
  #ifdef NOS_SIMULATED_STACK
@@ -42,6 +40,41 @@ static nOS_List         _triggeredList;
  #endif
 #endif
 
+/* Take up to max triggered alarms in the same critical section, then call their callback outside of it. Return number
+ * of alarms taken. */
+static uint8_t _Process (uint8_t max)
+{
+    nOS_StatusReg       sr;
+    nOS_Alarm           *alarm;
+    _Item               items[NOS_CONFIG_PROCESS_BATCH_SIZE];
+    uint8_t             count = 0;
+    uint8_t             i;
+
+    nOS_EnterCritical(sr);
+    alarm = nOS_GetHeadOfList(&_triggeredList, nOS_Alarm, node);
+    while ((alarm != NULL) && (count < max)) {
+        nOS_RemoveFromList(&_triggeredList, &alarm->node);
+        alarm->state = (nOS_AlarmState)(alarm->state &~ NOS_ALARM_TRIGGERED);
+
+        /* Call callback function outside of critical section */
+        items[count].alarm    = alarm;
+        items[count].callback = alarm->callback;
+        items[count].arg      = alarm->arg;
+        count++;
+
+        alarm = nOS_GetHeadOfList(&_triggeredList, nOS_Alarm, node);
+    }
+    nOS_LeaveCritical(sr);
+
+    for (i = 0; i < count; i++) {
+        if (items[i].callback != NULL) {
+            items[i].callback(items[i].alarm, items[i].arg);
+        }
+    }
+
+    return count;
+}
+
 #if (NOS_CONFIG_ALARM_THREAD_ENABLE > 0)
 #if (NOS_CONFIG_THREAD_JOIN_ENABLE > 0)
 static int _Thread (void *arg)
@@ -54,10 +87,10 @@ static void _Thread (void *arg)
     NOS_UNUSED(arg);
 
     while (true) {
-        nOS_AlarmProcess();
+        _Process(NOS_CONFIG_PROCESS_BATCH_SIZE);
 
         nOS_EnterCritical(sr);
-        if (nOS_GetHeadOfList(&_triggeredList) == NULL) {
+        if (nOS_GetHeadOfList(&_triggeredList, nOS_Alarm, node) == NULL) {
             nOS_WaitForEvent(NULL,
                              NOS_THREAD_ON_HOLD
 #if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0) || (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
@@ -78,29 +111,23 @@ static void _Thread (void *arg)
 }
 #endif
 
-/* Called from critical section */
-static void _Tick (void *payload, void *arg)
+/* Called from critical section, insert alarm after all waiting alarms with same or earlier time */
+static void _InsertToWaitingList (nOS_Alarm *alarm)
 {
-    nOS_Alarm       *alarm  = (nOS_Alarm *)payload;
-    _TickContext    *ctx    = (_TickContext *)arg;
+    nOS_Node    *it = _waitingList.head;
 
-    if (ctx->time >= alarm->time) {
-        nOS_RemoveFromList(&_waitingList, &alarm->node);
-        alarm->state = (nOS_AlarmState)(alarm->state &~ NOS_ALARM_WAITING);
-
-        alarm->state = (nOS_AlarmState)(alarm->state | NOS_ALARM_TRIGGERED);
-        nOS_AppendToList(&_triggeredList, &alarm->node);
-
-#if (NOS_CONFIG_ALARM_THREAD_ENABLE > 0)
-        ctx->triggered = true;
-#endif
+    while ((it != NULL) && (nOS_GetNodeOwner(it, nOS_Alarm, node)->time <= alarm->time)) {
+        it = it->next;
     }
+
+    nOS_InsertToList(&_waitingList, &alarm->node, it);
 }
 
 void nOS_InitAlarm(void)
 {
     nOS_InitList(&_waitingList);
     nOS_InitList(&_triggeredList);
+    _lastTime = nOS_TimeGet();
 #if (NOS_CONFIG_ALARM_THREAD_ENABLE > 0)
     nOS_ThreadCreate(&_thread,
                      _Thread,
@@ -122,6 +149,12 @@ void nOS_InitAlarm(void)
  #endif
  #if (NOS_CONFIG_THREAD_NAME_ENABLE > 0)
                     ,"nOS_Alarm"
+ #endif
+ #if (NOS_CONFIG_THREAD_FPU_ENABLE > 0)
+                    ,true   /* Callbacks can use FPU */
+ #endif
+ #if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+                    ,0      /* Service threads run on core 0 with tick */
  #endif
                     );
 #endif
@@ -133,48 +166,83 @@ void nOS_AlarmTick (void)
 #if (NOS_CONFIG_ALARM_TICK_ENABLE == 0)
     nOS_StatusReg   sr;
 #endif
-    _TickContext    ctx;
+    nOS_Time        time;
+    nOS_Alarm       *alarm;
+#if (NOS_CONFIG_ALARM_THREAD_ENABLE > 0)
+    bool            triggered = false;
+#endif
+#if (NOS_CONFIG_CRITICAL_WALK_LIMIT > 0) && (NOS_CONFIG_ALARM_TICK_ENABLE == 0)
+    nOS_ListWalk    walk;
+#endif
 
 #if (NOS_CONFIG_ALARM_TICK_ENABLE == 0)
     nOS_EnterCritical(sr);
 #endif
-    ctx.time = nOS_TimeGet();
+    time = nOS_TimeGet();
+    /* Waiting alarms are always in the future, they can only be triggered when time has changed */
+    if (time != _lastTime) {
+        _lastTime = time;
+#if (NOS_CONFIG_CRITICAL_WALK_LIMIT > 0) && (NOS_CONFIG_ALARM_TICK_ENABLE == 0)
+        /* Always restart from head of list, no position to keep while walk is paused */
+        nOS_BeginWalk(&walk, NULL);
+#endif
+        /* List is sorted by time, stop at first alarm that is still in the future */
+        alarm = nOS_GetHeadOfList(&_waitingList, nOS_Alarm, node);
+        while ((alarm != NULL) && (alarm->time <= time)) {
+            nOS_RemoveFromList(&_waitingList, &alarm->node);
+            alarm->state = (nOS_AlarmState)(alarm->state &~ NOS_ALARM_WAITING);
+
+            alarm->state = (nOS_AlarmState)(alarm->state | NOS_ALARM_TRIGGERED);
+            nOS_AppendToList(&_triggeredList, &alarm->node);
 #if (NOS_CONFIG_ALARM_THREAD_ENABLE > 0)
-    ctx.triggered = false;
+            triggered = true;
+#endif
+#if (NOS_CONFIG_CRITICAL_WALK_LIMIT > 0) && (NOS_CONFIG_ALARM_TICK_ENABLE == 0)
+            nOS_PauseWalk(&walk, &sr);
+#endif
+            alarm = nOS_GetHeadOfList(&_waitingList, nOS_Alarm, node);
+        }
+#if (NOS_CONFIG_CRITICAL_WALK_LIMIT > 0) && (NOS_CONFIG_ALARM_TICK_ENABLE == 0)
+        nOS_EndWalk(&walk);
 #endif
-    nOS_WalkInList(&_waitingList, _Tick, &ctx);
 #if (NOS_CONFIG_ALARM_THREAD_ENABLE > 0)
-    if (ctx.triggered && (_thread.state == (NOS_THREAD_READY | NOS_THREAD_ON_HOLD))) {
-        nOS_WakeUpThread(&_thread, NOS_OK);
-    }
+        if (triggered && (_thread.state == (NOS_THREAD_READY | NOS_THREAD_ON_HOLD))) {
+            nOS_WakeUpThread(&_thread, NOS_OK);
+        }
 #endif
+    }
 #if (NOS_CONFIG_ALARM_TICK_ENABLE == 0)
     nOS_LeaveCritical(sr);
 #endif
 }
 
-void nOS_AlarmProcess (void)
+#if (NOS_CONFIG_TICKLESS_ENABLE > 0)
+/* Called from critical section */
+nOS_TickCounter nOS_AlarmGetNextWakeup (void)
 {
-    nOS_StatusReg       sr;
-    nOS_Alarm           *alarm;
-    nOS_AlarmCallback   callback = NULL;
-    void                *arg;
+    nOS_TickCounter ticks = NOS_WAIT_INFINITE;
 
-    nOS_EnterCritical(sr);
-    alarm = (nOS_Alarm*)nOS_GetHeadOfList(&_triggeredList);
-    if (alarm != NULL) {
-        nOS_RemoveFromList(&_triggeredList, &alarm->node);
-        alarm->state = (nOS_AlarmState)(alarm->state &~ NOS_ALARM_TRIGGERED);
-
-        /* Call callback function outside of critical section */
-        callback = alarm->callback;
-        arg      = alarm->arg;
+    if (nOS_GetHeadOfList(&_triggeredList, nOS_Alarm, node) != NULL) {
+        /* Callbacks are waiting to be processed */
+        ticks = 0;
     }
-    nOS_LeaveCritical(sr);
-
-    if (callback != NULL) {
-        callback(alarm, arg);
+    else if (nOS_GetHeadOfList(&_waitingList, nOS_Alarm, node) != NULL) {
+        /* List is sorted by time, next alarm to trigger is at head */
+        ticks = nOS_TimeGetTicksUntil(nOS_GetHeadOfList(&_waitingList, nOS_Alarm, node)->time);
     }
+
+    return ticks;
+}
+#endif
+
+void nOS_AlarmProcess (void)
+{
+    _Process(1);
+}
+
+uint8_t nOS_AlarmProcessBatch (void)
+{
+    return _Process(NOS_CONFIG_PROCESS_BATCH_SIZE);
 }
 
 nOS_Error nOS_AlarmCreate (nOS_Alarm *alarm, nOS_AlarmCallback callback, void *arg, nOS_Time time)
@@ -199,14 +267,14 @@ nOS_Error nOS_AlarmCreate (nOS_Alarm *alarm, nOS_AlarmCallback callback, void *a
             alarm->callback = callback;
             alarm->arg      = arg;
             alarm->time     = time;
-            alarm->node.payload = (void *)alarm;
+            nOS_SetNodeOwner(&alarm->node, alarm);
             if (time <= nOS_TimeGet()) {
                 alarm->state = (nOS_AlarmState)(alarm->state | NOS_ALARM_TRIGGERED);
                 nOS_AppendToList(&_triggeredList, &alarm->node);
             }
             else {
                 alarm->state = (nOS_AlarmState)(alarm->state | NOS_ALARM_WAITING);
-                nOS_AppendToList(&_waitingList, &alarm->node);
+                _InsertToWaitingList(alarm);
             }
 
             err = NOS_OK;
@@ -289,7 +357,7 @@ nOS_Error nOS_AlarmSetTime (nOS_Alarm *alarm, nOS_Time time)
                 }
                 else {
                     alarm->state = (nOS_AlarmState)(alarm->state | NOS_ALARM_WAITING);
-                    nOS_AppendToList(&_waitingList, &alarm->node);
+                    _InsertToWaitingList(alarm);
                 }
             }
             err = NOS_OK;
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2014-2016 Jim Tremblay
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#define NOS_PRIVATE
+#include "nOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define _BIT_MASK                       ((1 << NOS_BITMAP_SHIFT) - 1)
+#define _Bit(n)                         ((nOS_BitmapWord)((nOS_BitmapWord)1 << (n)))
+/* Bits 0 to n inclusively */
+#define _BitsUpTo(n)                    ((nOS_BitmapWord)(_Bit(n) | (_Bit(n) - 1)))
+
+#ifdef NOS_USE_CLZ
+ #define _HighestBit(w)                 (uint8_t)(31 - _CLZ((uint32_t)(w)))
+#elif defined(NOS_USE_BYTE_TABLE) || defined(NOS_USE_NIBBLE_TABLE)
+ /* Without shifts and multiply: keep highest non-zero byte, then look it up in a table of 256 bytes, or keep highest
+  * non-zero nibble and use a table of 16 bytes when read-only data would be copied to RAM. */
+ #ifdef NOS_USE_BYTE_TABLE
+  static NOS_CONST uint8_t      _tableHighestBit[256] = {
+      0, 0, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3,
+      4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+      5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+      5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+      6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+      6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+      6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+      6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+      7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+      7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+      7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+      7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+      7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+      7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+      7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+      7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7
+  };
+ #else
+  static NOS_CONST uint8_t      _tableHighestBit[16] = {
+      0, 0, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3
+  };
+ #endif
+ static inline uint8_t _HighestBit (nOS_BitmapWord word)
+ {
+     uint8_t     base = 0;
+     uint8_t     b;
+
+ #ifdef NOS_32_BITS_SCHEDULER
+     if ((word >> 16) != 0) {
+         word >>= 16;
+         base = 16;
+     }
+ #endif
+     if ((word >> 8) != 0) {
+         b = (uint8_t)(word >> 8);
+         base += 8;
+     }
+     else {
+         b = (uint8_t)word;
+     }
+ #ifdef NOS_USE_NIBBLE_TABLE
+     if ((b >> 4) != 0) {
+         b >>= 4;
+         base += 4;
+     }
+ #endif
+
+     return (uint8_t)(base + _tableHighestBit[b]);
+ }
+#elif defined(NOS_32_BITS_SCHEDULER)
+ static NOS_CONST uint8_t       _tableDeBruijn[32] = {
+     0, 9, 1, 10, 13, 21, 2, 29, 11, 14, 16, 18, 22, 25, 3, 30,
+     8, 12, 20, 28, 15, 17, 24, 7, 19, 27, 23, 6, 26, 5, 4, 31
+ };
+ static inline uint8_t _HighestBit (nOS_BitmapWord word)
+ {
+     word |= word >> 1; // first round down to one less than a power of 2
+     word |= word >> 2;
+     word |= word >> 4;
+     word |= word >> 8;
+     word |= word >> 16;
+
+     return _tableDeBruijn[(uint32_t)(word * 0x07c4acddUL) >> 27];
+ }
+#else
+ static NOS_CONST uint8_t       _tableDeBruijn[16] = {
+     0, 7, 1, 13, 8, 10, 2, 14, 6, 12, 9, 5, 11, 4, 3, 15
+ };
+ static inline uint8_t _HighestBit (nOS_BitmapWord word)
+ {
+     word |= word >> 1; // first round down to one less than a power of 2
+     word |= word >> 2;
+     word |= word >> 4;
+     word |= word >> 8;
+
+     return _tableDeBruijn[(uint16_t)(word * 0xf2d) >> 12];
+ }
+#endif
+
+NOS_FAST_CODE void nOS_SetPrioInBitmap (nOS_BitmapWord *bitmap, uint8_t prio)
+{
+    uint8_t group = (uint8_t)(prio >> NOS_BITMAP_SHIFT);
+
+    bitmap[group + 1] |= _Bit(prio & _BIT_MASK);
+    bitmap[0] |= _Bit(group);
+}
+
+NOS_FAST_CODE void nOS_ClearPrioInBitmap (nOS_BitmapWord *bitmap, uint8_t prio)
+{
+    uint8_t group = (uint8_t)(prio >> NOS_BITMAP_SHIFT);
+
+    bitmap[group + 1] &=~ _Bit(prio & _BIT_MASK);
+    if (bitmap[group + 1] == 0) {
+        bitmap[0] &=~ _Bit(group);
+    }
+}
+
+/* Bitmap must not be empty */
+NOS_FAST_CODE uint8_t nOS_GetHighestPrioInBitmap (nOS_BitmapWord *bitmap)
+{
+    uint8_t group = _HighestBit(bitmap[0]);
+
+    return (uint8_t)((group << NOS_BITMAP_SHIFT) | _HighestBit(bitmap[group + 1]));
+}
+
+/* Find highest prio set from 0 to limit inclusively */
+bool nOS_FindPrioInBitmap (nOS_BitmapWord *bitmap, uint8_t limit, uint8_t *prio)
+{
+    uint8_t         group = (uint8_t)(limit >> NOS_BITMAP_SHIFT);
+    nOS_BitmapWord  word = bitmap[group + 1] & _BitsUpTo(limit & _BIT_MASK);
+    bool            found;
+
+    if (word == 0) {
+        /* Nothing set in group of limit, look in lower groups */
+        word = (nOS_BitmapWord)(bitmap[0] & (_Bit(group) - 1));
+        if (word != 0) {
+            group = _HighestBit(word);
+            word = bitmap[group + 1];
+        }
+    }
+    if (word != 0) {
+        *prio = (uint8_t)((group << NOS_BITMAP_SHIFT) | _HighestBit(word));
+        found = true;
+    }
+    else {
+        found = false;
+    }
+
+    return found;
+}
+
+#ifdef __cplusplus
+}
+#endif
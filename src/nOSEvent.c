@@ -13,6 +13,44 @@
 extern "C" {
 #endif
 
+#if (NOS_CONFIG_SORTED_TIMEOUT_LIST_ENABLE > 0)
+/* Find first thread that will reach its deadline after the given number of ticks */
+static nOS_Node* _FindTimeoutNode (nOS_TickCounter timeout)
+{
+    nOS_Node    *it = nOS_timeoutThreadsList.head;
+
+    while (it != NULL) {
+        if ((nOS_GetNodeOwner(it, nOS_Thread, tout)->timeout - nOS_tickCounter) > timeout) {
+            break;
+        }
+        it = it->next;
+    }
+
+    return it;
+}
+#endif
+
+#if (NOS_CONFIG_WAITING_PRIO_ORDER_ENABLE > 0)
+/* Insert thread after last waiting thread with same or higher priority, search from tail as
+ * new waiting thread is often of same or lower priority than the others */
+void nOS_InsertThreadToWaitList (nOS_Event *event, nOS_Thread *thread)
+{
+    nOS_Node    *it = event->waitList.tail;
+
+#if (NOS_CONFIG_WAITING_POLICY_ENABLE > 0)
+    /* Always append to tail of list with FIFO policy */
+    if (event->policy == NOS_WAITING_POLICY_PRIO)
+#endif
+    {
+        while ((it != NULL) && (nOS_GetNodeOwner(it, nOS_Thread, readyWait)->prio < thread->prio)) {
+            it = it->prev;
+        }
+    }
+
+    nOS_InsertToList(&event->waitList, &thread->readyWait, (it != NULL) ? it->next : event->waitList.head);
+}
+#endif
+
 void nOS_CreateEvent (nOS_Event *event
 #if (NOS_CONFIG_SAFE > 0)
 
@@ -22,21 +60,45 @@ void nOS_CreateEvent (nOS_Event *event
 {
 #if (NOS_CONFIG_SAFE > 0)
     event->type = type;
+#endif
+#if (NOS_CONFIG_WAITING_POLICY_ENABLE > 0)
+    event->policy = NOS_WAITING_POLICY_PRIO;
 #endif
     nOS_InitList(&event->waitList);
+#if (NOS_CONFIG_SELECT_ENABLE > 0)
+    nOS_InitList(&event->selectList);
+#endif
 }
 
 void nOS_DeleteEvent (nOS_Event *event)
 {
 #if (NOS_CONFIG_SAFE > 0)
     event->type = NOS_EVENT_INVALID;
+#endif
+#if (NOS_CONFIG_SELECT_ENABLE > 0)
+    nOS_SignalSelect(event, NOS_E_DELETED);
 #endif
     nOS_BroadcastEvent(event, NOS_E_DELETED);
 }
 
 void nOS_BroadcastEvent (nOS_Event *event, nOS_Error err)
 {
-    while (nOS_SendEvent(event, err) != NULL);
+#if (NOS_CONFIG_CRITICAL_WALK_LIMIT > 0)
+    nOS_Thread  *thread;
+
+    /* Remove threads one by one, a paused walk can have its next node in waiting list */
+    thread = nOS_GetHeadOfList(&event->waitList, nOS_Thread, readyWait);
+    while (thread != NULL) {
+        nOS_WakeUpThread(thread, err);
+        thread = nOS_GetHeadOfList(&event->waitList, nOS_Thread, readyWait);
+    }
+#else
+    nOS_List    list = event->waitList;
+
+    /* Detach whole waiting list at once */
+    nOS_InitList(&event->waitList);
+    nOS_WakeUpThreads(&list, err);
+#endif
 #if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
     /* Verify if a highest prio thread is ready to run */
     nOS_Schedule();
@@ -66,23 +128,40 @@ nOS_Error nOS_WaitForEvent (nOS_Event *event,
         /* Main thread can't wait */
         err = NOS_E_IDLE;
     } else {
+        nOS_Trace(NOS_TRACE_WAIT, event, state & NOS_THREAD_WAITING_MASK);
         nOS_RemoveThreadFromReadyList(nOS_runningThread);
 
         nOS_runningThread->state = (nOS_ThreadState)(nOS_runningThread->state | (state & NOS_THREAD_WAITING_MASK));
         nOS_runningThread->event = event;
         if (event != NULL) {
+#if (NOS_CONFIG_WAITING_PRIO_ORDER_ENABLE > 0)
+            nOS_InsertThreadToWaitList(event, nOS_runningThread);
+#else
             nOS_AppendToList(&event->waitList, &nOS_runningThread->readyWait);
+#endif
         }
 
 #if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0) || (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
         if ((timeout > 0) && (timeout < NOS_WAIT_INFINITE)) {
             nOS_runningThread->timeout = nOS_tickCounter + timeout;
             nOS_runningThread->state = (nOS_ThreadState)(nOS_runningThread->state | NOS_THREAD_WAIT_TIMEOUT);
+ #if (NOS_CONFIG_SORTED_TIMEOUT_LIST_ENABLE > 0)
+            /* Keep list sorted by deadline, threads with same deadline stay in FIFO order */
+            nOS_InsertToList(&nOS_timeoutThreadsList, &nOS_runningThread->tout, _FindTimeoutNode(timeout));
+ #else
             nOS_AppendToList(&nOS_timeoutThreadsList, &nOS_runningThread->tout);
+ #endif
         }
 #endif
 
+#if (NOS_CONFIG_SCHED_DEFERRED_ENABLE > 0)
+        /* Running thread is not ready anymore, decision can't be deferred */
+        if (nOS_ResolveSchedule()) {
+            nOS_SwitchContext();
+        }
+#else
         nOS_Schedule();
+#endif
 
         err = (nOS_Error)nOS_runningThread->error;
     }
@@ -94,7 +173,7 @@ nOS_Thread* nOS_SendEvent (nOS_Event *event, nOS_Error err)
 {
     nOS_Thread  *thread;
 
-    thread = (nOS_Thread*)nOS_GetHeadOfList(&event->waitList);
+    thread = nOS_GetHeadOfList(&event->waitList, nOS_Thread, readyWait);
     if (thread != NULL) {
         nOS_WakeUpThread(thread, err);
     }
@@ -102,6 +181,54 @@ nOS_Thread* nOS_SendEvent (nOS_Event *event, nOS_Error err)
     return thread;
 }
 
+#if (NOS_CONFIG_WAITING_POLICY_ENABLE > 0)
+nOS_Error nOS_SetWaitingPolicy (void *object, nOS_WaitingPolicy policy)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+    nOS_Event       *event = (nOS_Event*)object;
+    nOS_List        list;
+    nOS_Thread      *thread;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (event == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if ((policy != NOS_WAITING_POLICY_FIFO) && (policy != NOS_WAITING_POLICY_PRIO)) {
+        err = NOS_E_INV_VAL;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (event->type == NOS_EVENT_INVALID) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        {
+            if ((event->policy == NOS_WAITING_POLICY_FIFO) && (policy == NOS_WAITING_POLICY_PRIO)) {
+                event->policy = (uint8_t)policy;
+                /* Move all waiting threads to their priority order position */
+                list = event->waitList;
+                nOS_InitList(&event->waitList);
+                while (list.head != NULL) {
+                    thread = nOS_GetNodeOwner(list.head, nOS_Thread, readyWait);
+                    nOS_RemoveFromList(&list, &thread->readyWait);
+                    nOS_InsertThreadToWaitList(event, thread);
+                }
+            } else {
+                event->policy = (uint8_t)policy;
+            }
+
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -14,12 +14,48 @@ extern "C" {
 #endif
 
 #if (NOS_CONFIG_FLAG_ENABLE > 0)
-static void _TestFlag (void *payload, void *arg)
+typedef struct _SendContext
 {
-    nOS_Thread      *thread  = (nOS_Thread*)payload;
+    nOS_FlagBits    res;        /* Flags to clear on exit */
+#if (NOS_CONFIG_CRITICAL_WALK_LIMIT == 0)
+    nOS_List        woken;      /* Threads that can be awoken, in waiting order */
+#endif
+} _SendContext;
+
+#if defined(NOS_USE_EXCLUSIVE) && (NOS_CONFIG_FLAG_NB_BITS == 32)
+/* Exclusive access is lost on any exception, so no thread can start waiting between load and store. */
+static bool _SendFast (nOS_Flag *flag, nOS_FlagBits flags, nOS_FlagBits mask)
+{
+    uint32_t    f;
+    bool        sent;
+
+    do {
+        f = _LDREX((volatile uint32_t*)&flag->flags);
+        if ((flags & mask & flag->waited) != NOS_FLAG_NONE) {
+            /* At least one waiting thread can be awoken. */
+            sent = false;
+            break;
+        }
+#if (NOS_CONFIG_SELECT_ENABLE > 0)
+        if (((flags & mask) != NOS_FLAG_NONE) && (flag->e.selectList.head != NULL)) {
+            /* Selecting threads need to be awoken. */
+            sent = false;
+            break;
+        }
+#endif
+        sent = true;
+    } while (_STREX(f ^ ((f ^ flags) & mask), (volatile uint32_t*)&flag->flags) != 0);
+
+    return sent;
+}
+#endif
+
+static void _TestFlag (void *node, void *arg)
+{
+    nOS_Thread      *thread  = nOS_GetNodeOwner((nOS_Node*)node, nOS_Thread, readyWait);
     nOS_Flag        *flag    = (nOS_Flag*)thread->event;
     nOS_FlagContext *ctx     = (nOS_FlagContext*)thread->ext;
-    nOS_FlagBits    *res     = (nOS_FlagBits*)arg;
+    _SendContext    *send    = (_SendContext*)arg;
     nOS_FlagBits    r;
 
     /* Verify flags from object with wanted flags from waiting thread. */
@@ -29,13 +65,24 @@ static void _TestFlag (void *payload, void *arg)
     }
     /* If conditions are met, wake up the thread and give it the result. */
     if (r != NOS_FLAG_NONE) {
+#if (NOS_CONFIG_CRITICAL_WALK_LIMIT > 0)
+        /* Woken up immediately, walk can be paused and a detached list would not be valid in between. */
         nOS_WakeUpThread(thread, NOS_OK);
+#else
+        /* Woken up together once all waiting threads have been tested. */
+        nOS_RemoveFromList(&flag->e.waitList, &thread->readyWait);
+        nOS_AppendToList(&send->woken, &thread->readyWait);
+#endif
         *ctx->rflags = r;
         /* Accumulate awoken flags if waiting thread want to clear it when awoken. */
         if (ctx->opt & NOS_FLAG_CLEAR_ON_EXIT) {
-            *res |= r;
+            send->res |= r;
         }
     }
+    else {
+        /* Rebuild summary of flags waited by remaining threads. */
+        flag->waited |= ctx->flags;
+    }
 }
 
 nOS_Error nOS_FlagCreate (nOS_Flag *flag, nOS_FlagBits flags)
@@ -61,7 +108,8 @@ nOS_Error nOS_FlagCreate (nOS_Flag *flag, nOS_FlagBits flags)
                            ,NOS_EVENT_FLAG
 #endif
                            );
-            flag->flags = flags;
+            flag->flags  = flags;
+            flag->waited = NOS_FLAG_NONE;
 
             err = NOS_OK;
         }
@@ -90,7 +138,8 @@ nOS_Error nOS_FlagDelete (nOS_Flag *flag)
         } else
 #endif
         {
-            flag->flags = NOS_FLAG_NONE;
+            flag->flags  = NOS_FLAG_NONE;
+            flag->waited = NOS_FLAG_NONE;
             nOS_DeleteEvent((nOS_Event*)flag);
 
             err = NOS_OK;
@@ -147,6 +196,8 @@ nOS_Error nOS_FlagWait (nOS_Flag *flag, nOS_FlagBits flags, nOS_FlagBits *res,
                 ctx.opt     = opt;
                 ctx.rflags  = &r;
                 nOS_runningThread->ext = &ctx;
+                /* Can include flags of threads that are no longer waiting, cleaned on next walk. */
+                flag->waited |= flags;
                 err = nOS_WaitForEvent((nOS_Event*)flag,
                                        NOS_THREAD_WAITING_FLAG
 #if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0)
@@ -172,12 +223,23 @@ nOS_Error nOS_FlagSend (nOS_Flag *flag, nOS_FlagBits flags, nOS_FlagBits mask)
 {
     nOS_Error       err;
     nOS_StatusReg   sr;
-    nOS_FlagBits    res;
+    _SendContext    send;
 
 #if (NOS_CONFIG_SAFE > 0)
     if (flag == NULL) {
         err = NOS_E_INV_OBJ;
     } else
+ #if defined(NOS_USE_EXCLUSIVE) && (NOS_CONFIG_FLAG_NB_BITS == 32)
+    if (flag->e.type != NOS_EVENT_FLAG) {
+        err = NOS_E_INV_OBJ;
+    } else
+ #endif
+#endif
+#if defined(NOS_USE_EXCLUSIVE) && (NOS_CONFIG_FLAG_NB_BITS == 32)
+    if (_SendFast(flag, flags, mask)) {
+        /* No waiting thread can be awoken, flags updated without critical section. */
+        err = NOS_OK;
+    } else
 #endif
     {
         nOS_EnterCritical(sr);
@@ -188,13 +250,35 @@ nOS_Error nOS_FlagSend (nOS_Flag *flag, nOS_FlagBits flags, nOS_FlagBits mask)
 #endif
         {
             flag->flags ^= ((flag->flags ^ flags) & mask);
-            res = NOS_FLAG_NONE;
-            nOS_WalkInList(&flag->e.waitList, _TestFlag, &res);
-            /* Clear all flags that have awoken the waiting threads. */
-            flag->flags &=~ res;
+            /* Walk list of waiting threads only if at least one of them is waiting on flags that have been set. */
+            if ((flags & mask & flag->waited) != NOS_FLAG_NONE) {
+                send.res = NOS_FLAG_NONE;
+#if (NOS_CONFIG_CRITICAL_WALK_LIMIT == 0)
+                nOS_InitList(&send.woken);
+#endif
+                flag->waited = NOS_FLAG_NONE;
+#if (NOS_CONFIG_CRITICAL_WALK_LIMIT > 0)
+                nOS_WalkInListBounded(&flag->e.waitList, _TestFlag, &send, &sr);
+#else
+                nOS_WalkInList(&flag->e.waitList, _TestFlag, &send);
+                nOS_WakeUpThreads(&send.woken, NOS_OK);
+#endif
+                /* Clear all flags that have awoken the waiting threads. */
+                flag->flags &=~ send.res;
 
 #if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
-            nOS_Schedule();
+                nOS_Schedule();
+#endif
+            }
+#if (NOS_CONFIG_SELECT_ENABLE > 0)
+            if ((flags & mask & flag->flags) != NOS_FLAG_NONE) {
+                nOS_SignalSelect((nOS_Event*)flag, NOS_OK);
+            }
+#endif
+#if (NOS_CONFIG_TASK_ENABLE > 0)
+            if ((flags & mask & flag->flags) != NOS_FLAG_NONE) {
+                nOS_WakeUpTasks();
+            }
 #endif
 
             err = NOS_OK;
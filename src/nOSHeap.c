@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2014-2016 Jim Tremblay
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#define NOS_PRIVATE
+#include "nOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if (NOS_CONFIG_HEAP_ENABLE > 0)
+/* Size classes are sorted by block size, first one that fit is the smallest */
+static nOS_HeapClass* _FindClass (nOS_Heap *heap, size_t size)
+{
+    nOS_HeapClass   *hclass = heap->classes;
+    nOS_HeapClass   *end = &heap->classes[heap->ccount];
+
+    while ((hclass < end) && ((size_t)hclass->bsize < size)) {
+        hclass++;
+    }
+
+    return (hclass < end) ? hclass : NULL;
+}
+
+nOS_Error nOS_HeapCreate (nOS_Heap *heap, nOS_HeapClass *classes, uint8_t ccount)
+{
+    nOS_Error       err;
+    uint8_t         i;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (heap == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (classes == NULL) {
+        err = NOS_E_NULL;
+    }
+    else if (ccount == 0) {
+        err = NOS_E_INV_VAL;
+    } else
+#endif
+    {
+        err = NOS_OK;
+        for (i = 0; (i < ccount) && (err == NOS_OK); i++) {
+#if (NOS_CONFIG_SAFE > 0)
+            if ((i > 0) && (classes[i].bsize <= classes[i-1].bsize)) {
+                err = NOS_E_INV_VAL;
+            } else
+#endif
+            {
+                err = nOS_MemCreate(&classes[i].mem,
+                                    classes[i].buffer,
+                                    classes[i].bsize,
+                                    classes[i].bmax
+#if (NOS_CONFIG_MEM_BITMAP_ENABLE > 0)
+                                   ,classes[i].bitmap
+#endif
+                                   );
+            }
+        }
+        if (err == NOS_OK) {
+            heap->classes = classes;
+            heap->ccount  = ccount;
+        }
+    }
+
+    return err;
+}
+
+void *nOS_HeapAlloc (nOS_Heap *heap, size_t size, nOS_TickCounter timeout)
+{
+    nOS_HeapClass   *hclass;
+    void            *block;
+#if (NOS_CONFIG_HEAP_FALLBACK_ENABLE > 0)
+    nOS_HeapClass   *next;
+    nOS_HeapClass   *end;
+#endif
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (heap == NULL) {
+        block = NULL;
+    }
+    else if (heap->classes == NULL) {
+        block = NULL;
+    } else
+#endif
+    {
+        hclass = _FindClass(heap, size);
+        if (hclass == NULL) {
+            /* Larger than largest size class */
+            block = NULL;
+        }
+        else {
+            block = NULL;
+#if (NOS_CONFIG_HEAP_FALLBACK_ENABLE > 0)
+            /* Take a block from smallest size class that have one available */
+            end = &heap->classes[heap->ccount];
+            for (next = hclass; (next < end) && (block == NULL); next++) {
+                if (nOS_MemIsAvailable(&next->mem)) {
+                    block = nOS_MemAlloc(&next->mem, NOS_NO_WAIT);
+                }
+            }
+            if (block == NULL)
+#endif
+            {
+                /* Wait on smallest fitting size class */
+                block = nOS_MemAlloc(&hclass->mem, timeout);
+            }
+        }
+    }
+
+    return block;
+}
+
+nOS_Error nOS_HeapFree (nOS_Heap *heap, void *block)
+{
+    nOS_Error       err;
+    nOS_HeapClass   *hclass;
+    nOS_HeapClass   *end;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (heap == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (heap->classes == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (block == NULL) {
+        err = NOS_E_INV_VAL;
+    } else
+#endif
+    {
+        /* Find size class that own the block */
+        hclass = heap->classes;
+        end = &heap->classes[heap->ccount];
+        while ((hclass < end) &&
+               (((uint8_t*)block < (uint8_t*)hclass->buffer) ||
+                ((uint8_t*)block >= ((uint8_t*)hclass->buffer + ((size_t)hclass->bsize * (size_t)hclass->bmax))))) {
+            hclass++;
+        }
+        if (hclass == end) {
+            err = NOS_E_INV_VAL;
+        }
+        else {
+            err = nOS_MemFree(&hclass->mem, block);
+        }
+    }
+
+    return err;
+}
+#endif  /* NOS_CONFIG_HEAP_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2014-2016 Jim Tremblay
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#define NOS_PRIVATE
+#include "nOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if (NOS_CONFIG_HRTIMER_ENABLE > 0)
+/* Active timers are sorted by deadline, only head of list is programmed in compare interrupt. Deadlines are compared
+ * with signed difference to free running counter, so counter can wrap as long as delays stay lower than 2^31. */
+#define _HALF_RANGE                     0x80000000UL
+#define _Elapsed(d,c)                   ((int32_t)((uint32_t)(c) - (uint32_t)(d)) >= 0)
+
+static nOS_List                 _list;
+
+/* Called from critical section, insert timer after all timers with same or earlier deadline */
+static void _InsertTimer (nOS_HrTimer *timer)
+{
+    nOS_Node    *it = _list.head;
+
+    while ((it != NULL) && ((int32_t)(nOS_GetNodeOwner(it, nOS_HrTimer, node)->deadline - timer->deadline) <= 0)) {
+        it = it->next;
+    }
+
+    nOS_InsertToList(&_list, &timer->node, it);
+}
+
+/* Called from critical section */
+static void _StartTimer (nOS_HrTimer *timer, uint32_t delay, uint32_t period)
+{
+    if (timer->running) {
+        nOS_RemoveFromList(&_list, &timer->node);
+    }
+    timer->deadline = nOS_HrTimerReadCounter() + delay;
+    timer->period   = period;
+    timer->running  = true;
+    _InsertTimer(timer);
+    if (_list.head == &timer->node) {
+        /* New nearest deadline */
+        nOS_HrTimerSetCompare(timer->deadline);
+    }
+}
+
+/* Called from critical section */
+static void _StopTimer (nOS_HrTimer *timer)
+{
+    if (timer->running) {
+        /* Compare interrupt of a removed head will find its successor not elapsed and program it */
+        nOS_RemoveFromList(&_list, &timer->node);
+        timer->running = false;
+    }
+}
+
+/* Called from compare interrupt */
+static void _WakeUpThread (nOS_HrTimer *timer, void *arg)
+{
+    nOS_Thread  *thread = (nOS_Thread*)arg;
+
+    NOS_UNUSED(timer);
+
+    if ((thread->state & NOS_THREAD_WAITING_MASK) == NOS_THREAD_SLEEPING) {
+        nOS_WakeUpThread(thread, NOS_OK);
+#if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
+        /* Verify if a highest prio thread is ready to run */
+        nOS_Schedule();
+#endif
+    }
+}
+
+void nOS_InitHrTimer (void)
+{
+    nOS_InitList(&_list);
+}
+
+/* Called from critical section by nOS_ThreadDelete */
+void nOS_StopHrSleep (nOS_Thread *thread)
+{
+    _StopTimer(&thread->hrSleep);
+}
+
+void nOS_HrTimerIsr (void)
+{
+    nOS_StatusReg   sr;
+    nOS_HrTimer     *timer;
+
+    nOS_EnterCritical(sr);
+    timer = nOS_GetHeadOfList(&_list, nOS_HrTimer, node);
+    while ((timer != NULL) && _Elapsed(timer->deadline, nOS_HrTimerReadCounter())) {
+        nOS_RemoveFromList(&_list, &timer->node);
+        if (timer->period > 0) {
+            /* Stay aligned on first deadline */
+            timer->deadline += timer->period;
+            _InsertTimer(timer);
+        }
+        else {
+            timer->running = false;
+        }
+        timer->callback(timer, timer->arg);
+        /* Callback can have started or stopped other timers, restart from head */
+        timer = nOS_GetHeadOfList(&_list, nOS_HrTimer, node);
+    }
+    if (timer != NULL) {
+        nOS_HrTimerSetCompare(timer->deadline);
+    }
+    nOS_LeaveCritical(sr);
+}
+
+nOS_Error nOS_HrTimerCreate (nOS_HrTimer *timer, nOS_HrTimerCallback callback, void *arg)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (timer == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (callback == NULL) {
+        err = NOS_E_NULL;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+        timer->deadline = 0;
+        timer->period   = 0;
+        timer->callback = callback;
+        timer->arg      = arg;
+        timer->running  = false;
+        nOS_SetNodeOwner(&timer->node, timer);
+        nOS_LeaveCritical(sr);
+
+        err = NOS_OK;
+    }
+
+    return err;
+}
+
+nOS_Error nOS_HrTimerStart (nOS_HrTimer *timer, uint32_t delay, uint32_t period)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (timer == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (timer->callback == NULL) {
+        /* Not created */
+        err = NOS_E_INV_OBJ;
+    }
+    else if ((delay == 0) || (delay >= _HALF_RANGE) || (period >= _HALF_RANGE)) {
+        err = NOS_E_INV_VAL;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+        _StartTimer(timer, delay, period);
+        nOS_LeaveCritical(sr);
+
+        err = NOS_OK;
+    }
+
+    return err;
+}
+
+nOS_Error nOS_HrTimerStop (nOS_HrTimer *timer)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (timer == NULL) {
+        err = NOS_E_INV_OBJ;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+        _StopTimer(timer);
+        nOS_LeaveCritical(sr);
+
+        err = NOS_OK;
+    }
+
+    return err;
+}
+
+bool nOS_HrTimerIsRunning (nOS_HrTimer *timer)
+{
+    nOS_StatusReg   sr;
+    bool            running;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (timer == NULL) {
+        running = false;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+        running = timer->running;
+        nOS_LeaveCritical(sr);
+    }
+
+    return running;
+}
+
+nOS_Error nOS_HrSleep (uint32_t count)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (nOS_isrNestingCounter > 0) {
+        err = NOS_E_ISR;
+    } else
+ #if (NOS_CONFIG_SCHED_LOCK_ENABLE > 0)
+    /* Can't switch context when scheduler is locked */
+    if (nOS_lockNestingCounter > 0) {
+        err = NOS_E_LOCKED;
+    } else
+ #endif
+    if (nOS_runningThread == &nOS_idleHandle) {
+        err = NOS_E_IDLE;
+    } else
+    if (count >= _HALF_RANGE) {
+        err = NOS_E_INV_VAL;
+    } else
+#endif
+    if (count == 0) {
+        err = nOS_Yield();
+    }
+    else {
+        nOS_EnterCritical(sr);
+        nOS_runningThread->hrSleep.callback = _WakeUpThread;
+        nOS_runningThread->hrSleep.arg = nOS_runningThread;
+        nOS_SetNodeOwner(&nOS_runningThread->hrSleep.node, &nOS_runningThread->hrSleep);
+        _StartTimer(&nOS_runningThread->hrSleep, count, 0);
+        err = nOS_WaitForEvent(NULL,
+                               NOS_THREAD_SLEEPING
+#if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0) || (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
+                              ,NOS_WAIT_INFINITE
+#endif
+                              );
+        /* Thread can have been woken up by something else than its timer */
+        _StopTimer(&nOS_runningThread->hrSleep);
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+#endif  /* NOS_CONFIG_HRTIMER_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
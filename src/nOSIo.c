@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2014-2016 Jim Tremblay
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#define NOS_PRIVATE
+#include "nOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if (NOS_CONFIG_IO_ENABLE > 0)
+/* Only head of device queue is given to driver, others stay in pending list until completion interrupt of previous
+ * one. Request is its own event, so any number of threads can wait on it without a semaphore per request. */
+
+/* Called from critical section when device is idle */
+static void _StartNext (nOS_IoDevice *dev)
+{
+    nOS_IoRequest   *req = nOS_GetHeadOfList(&dev->pending, nOS_IoRequest, node);
+
+    if (req != NULL) {
+        nOS_RemoveFromList(&dev->pending, &req->node);
+        req->state  = NOS_IO_ACTIVE;
+        dev->active = req;
+        /* Driver can complete request from here, next one will be started by nOS_IoComplete */
+        dev->start(dev, req);
+    }
+}
+
+/* Called from critical section */
+static void _Finish (nOS_IoRequest *req, nOS_Error result, size_t count)
+{
+    req->result = result;
+    req->count  = count;
+    req->state  = NOS_IO_DONE;
+#if (NOS_CONFIG_SIGNAL_ENABLE > 0)
+    if (req->signal != NULL) {
+        nOS_SignalSend(req->signal, req);
+    }
+#endif
+    if (req->e.waitList.head != NULL) {
+        /* Waiting threads read result from request */
+        nOS_BroadcastEvent((nOS_Event*)req, NOS_OK);
+    }
+}
+
+nOS_Error nOS_IoDeviceCreate (nOS_IoDevice *dev, nOS_IoStart start, void *context)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (dev == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (start == NULL) {
+        err = NOS_E_NULL;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+        nOS_InitList(&dev->pending);
+        dev->active  = NULL;
+        dev->start   = start;
+        dev->context = context;
+        nOS_LeaveCritical(sr);
+
+        err = NOS_OK;
+    }
+
+    return err;
+}
+
+nOS_Error nOS_IoRequestCreate (nOS_IoRequest *req
+#if (NOS_CONFIG_SIGNAL_ENABLE > 0)
+                              ,nOS_Signal *signal
+#endif
+                              )
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (req == NULL) {
+        err = NOS_E_INV_OBJ;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (req->e.type != NOS_EVENT_INVALID) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        {
+            nOS_CreateEvent((nOS_Event*)req
+#if (NOS_CONFIG_SAFE > 0)
+                           ,NOS_EVENT_IO
+#endif
+                           );
+            nOS_SetNodeOwner(&req->node, req);
+            req->dev    = NULL;
+            req->chain  = NULL;
+            req->count  = 0;
+            req->result = NOS_OK;
+            req->state  = NOS_IO_DONE;
+            req->op     = 0;
+#if (NOS_CONFIG_SIGNAL_ENABLE > 0)
+            req->signal = signal;
+#endif
+
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+
+nOS_Error nOS_IoSubmit (nOS_IoDevice *dev, nOS_IoRequest *req, uint8_t op, nOS_IoBuffer *chain)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (dev == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (req == NULL) {
+        err = NOS_E_INV_OBJ;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if ((req->e.type != NOS_EVENT_IO) || (dev->start == NULL)) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        if (req->state != NOS_IO_DONE) {
+            err = NOS_E_RUNNING;
+        }
+        else {
+            req->dev    = dev;
+            req->chain  = chain;
+            req->op     = op;
+            req->count  = 0;
+            req->state  = NOS_IO_PENDING;
+            nOS_AppendToList(&dev->pending, &req->node);
+            if (dev->active == NULL) {
+                _StartNext(dev);
+            }
+
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+
+nOS_IoRequest* nOS_IoComplete (nOS_IoDevice *dev, nOS_Error result, size_t count)
+{
+    nOS_StatusReg   sr;
+    nOS_IoRequest   *req;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (dev == NULL) {
+        req = NULL;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+        req = dev->active;
+        if (req != NULL) {
+            dev->active = NULL;
+            /* Keep hardware busy before anyone can process completed request */
+            _StartNext(dev);
+            _Finish(req, result, count);
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return req;
+}
+
+nOS_Error nOS_IoCancel (nOS_IoRequest *req)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (req == NULL) {
+        err = NOS_E_INV_OBJ;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (req->e.type != NOS_EVENT_IO) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        if (req->state == NOS_IO_ACTIVE) {
+            err = NOS_E_RUNNING;
+        }
+        else if (req->state != NOS_IO_PENDING) {
+            err = NOS_E_INV_STATE;
+        }
+        else {
+            nOS_RemoveFromList(&req->dev->pending, &req->node);
+            _Finish(req, NOS_E_ABORT, 0);
+
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+
+nOS_Error nOS_IoWait (nOS_IoRequest *req, nOS_TickCounter timeout)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (req == NULL) {
+        err = NOS_E_INV_OBJ;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (req->e.type != NOS_EVENT_IO) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        if (req->state == NOS_IO_DONE) {
+            err = req->result;
+        }
+        else if (timeout == NOS_NO_WAIT) {
+            err = NOS_E_AGAIN;
+        }
+        else {
+            err = nOS_WaitForEvent((nOS_Event*)req,
+                                   NOS_THREAD_WAITING_IO
+#if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0)
+                                  ,timeout
+#elif (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
+                                  ,NOS_WAIT_INFINITE
+#endif
+                                  );
+            if (err == NOS_OK) {
+                err = req->result;
+            }
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+
+bool nOS_IoIsDone (nOS_IoRequest *req)
+{
+    nOS_StatusReg   sr;
+    bool            done;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (req == NULL) {
+        done = false;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+        done = (req->state == NOS_IO_DONE);
+        nOS_LeaveCritical(sr);
+    }
+
+    return done;
+}
+#endif  /* NOS_CONFIG_IO_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) 2014-2016 Jim Tremblay
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#define NOS_PRIVATE
+#include "nOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if (NOS_CONFIG_JOB_ENABLE > 0)
+/* Jobs are scheduled with stack resource policy: a pending job can start only if its prio is higher than system
+ * ceiling, which is raised to prio of running job and to prio of each mutex it lock. Preempting job run to
+ * completion as a nested function call on job thread stack, so preempted job resume only when stack is unwound.
+ * _ceiling is kept one above highest prio that can't start, 0 when no job is running. */
+#define _CanStart(j)                    ((j)->prio >= _ceiling)
+
+#if (NOS_CONFIG_THREAD_JOIN_ENABLE > 0)
+ static int _Thread (void *arg);
+#else
+ static void _Thread (void *arg);
+#endif
+
+#if (NOS_CONFIG_JOB_HIGHEST_PRIO > 0)
+ static nOS_List                _list[NOS_CONFIG_JOB_HIGHEST_PRIO+1];
+ static nOS_BitmapWord          _listByPrio[NOS_BITMAP_SIZE(NOS_CONFIG_JOB_HIGHEST_PRIO)];
+#else
+ static nOS_List                _list;
+#endif
+static uint8_t                  _ceiling;
+#ifdef NOS_SIMULATED_STACK
+ static nOS_Stack               _stack;
+#else
+ static nOS_Stack               _stack[NOS_CONFIG_JOB_THREAD_STACK_SIZE];
+#endif
+
+#if (NOS_CONFIG_JOB_HIGHEST_PRIO > 0)
+ static inline nOS_Job* _FindHighestPrio (void)
+ {
+     if (!nOS_IsBitmapEmpty(_listByPrio)) {
+         return nOS_GetNodeOwner(_list[nOS_GetHighestPrioInBitmap(_listByPrio)].head, nOS_Job, node);
+     }
+     else {
+         return (nOS_Job*)NULL;
+     }
+ }
+ static inline void _AppendToList (nOS_Job *job)
+ {
+     nOS_AppendToList(&_list[job->prio], &job->node);
+     nOS_SetPrioInBitmap(_listByPrio, job->prio);
+ }
+ static inline void _RemoveFromList (nOS_Job *job)
+ {
+     nOS_RemoveFromList(&_list[job->prio], &job->node);
+     if (_list[job->prio].head == NULL) {
+         nOS_ClearPrioInBitmap(_listByPrio, job->prio);
+     }
+ }
+#else
+ #define _FindHighestPrio()                 nOS_GetHeadOfList(&_list, nOS_Job, node)
+ #define _AppendToList(j)                   nOS_AppendToList(&_list, &(j)->node)
+ #define _RemoveFromList(j)                 nOS_RemoveFromList(&_list, &(j)->node)
+#endif
+
+#if (NOS_CONFIG_THREAD_JOIN_ENABLE > 0)
+static int _Thread (void *arg)
+#else
+static void _Thread (void *arg)
+#endif
+{
+    nOS_StatusReg   sr;
+
+    NOS_UNUSED(arg);
+
+    while (1) {
+        nOS_DispatchJobs();
+
+        nOS_EnterCritical(sr);
+        if (_FindHighestPrio() == NULL) {
+            nOS_WaitForEvent(NULL,
+                             NOS_THREAD_ON_HOLD
+#if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0) || (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
+                            ,NOS_WAIT_INFINITE
+#endif
+                            );
+        }
+        nOS_LeaveCritical(sr);
+
+#if (NOS_CONFIG_THREAD_JOIN_ENABLE > 0)
+        if (false) break; /* Remove "statement is unreachable" warning */
+    }
+
+    return 0;
+#else
+    }
+#endif
+}
+
+void nOS_InitJob (void)
+{
+#if (NOS_CONFIG_JOB_HIGHEST_PRIO > 0)
+    uint8_t i;
+    for (i = 0; i <= NOS_CONFIG_JOB_HIGHEST_PRIO; i++) {
+        nOS_InitList(&_list[i]);
+    }
+#else
+    nOS_InitList(&_list);
+#endif
+    _ceiling = 0;
+    nOS_ThreadCreate(&nOS_jobThread,
+                     _Thread,
+                     NULL
+#ifdef NOS_SIMULATED_STACK
+                    ,&_stack
+#else
+                    ,_stack
+#endif
+                    ,NOS_CONFIG_JOB_THREAD_STACK_SIZE
+#ifdef NOS_USE_SEPARATE_CALL_STACK
+                    ,NOS_CONFIG_JOB_THREAD_CALL_STACK_SIZE
+#endif
+#if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
+                    ,NOS_CONFIG_JOB_THREAD_PRIO
+#endif
+#if (NOS_CONFIG_THREAD_SUSPEND_ENABLE > 0)
+                    ,NOS_THREAD_READY
+#endif
+#if (NOS_CONFIG_THREAD_NAME_ENABLE > 0)
+                    ,"nOS_Job"
+#endif
+#if (NOS_CONFIG_THREAD_FPU_ENABLE > 0)
+                    ,true   /* Jobs can use FPU */
+#endif
+#if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+                    ,0      /* Service threads run on core 0 with tick */
+#endif
+                    );
+}
+
+/* Run all pending jobs that can preempt system ceiling, highest prio first. Jobs activated while one is running
+ * are started from here by nested calls. Do nothing if not called from job thread. */
+void nOS_DispatchJobs (void)
+{
+    nOS_StatusReg   sr;
+    nOS_Job         *job;
+    nOS_JobHandler  handler;
+    void            *arg;
+    uint8_t         ceiling;
+
+    if (nOS_runningThread == &nOS_jobThread) {
+        nOS_EnterCritical(sr);
+        job = (nOS_Job*)_FindHighestPrio();
+        while ((job != NULL) && _CanStart(job)) {
+            _RemoveFromList(job);
+            job->state = (nOS_JobState)(job->state &~ NOS_JOB_PENDING);
+            handler = job->handler;
+            arg = job->arg;
+            ceiling = _ceiling;
+            _ceiling = (uint8_t)(job->prio + 1);
+            nOS_LeaveCritical(sr);
+
+            handler(job, arg);
+
+            nOS_EnterCritical(sr);
+            _ceiling = ceiling;
+            job = (nOS_Job*)_FindHighestPrio();
+        }
+        nOS_LeaveCritical(sr);
+    }
+}
+
+/* Called from critical section by job thread when it lock a mutex, return previous ceiling */
+uint8_t nOS_RaiseJobCeiling (uint8_t prio)
+{
+    uint8_t ceiling = _ceiling;
+
+    if (prio >= _ceiling) {
+        _ceiling = (uint8_t)(prio + 1);
+    }
+
+    return ceiling;
+}
+
+/* Called from critical section by job thread when it unlock a mutex, pending jobs are run by nOS_DispatchJobs */
+void nOS_RestoreJobCeiling (uint8_t ceiling)
+{
+    _ceiling = ceiling;
+}
+
+nOS_Error nOS_JobCreate (nOS_Job *job, nOS_JobHandler handler, void *arg, uint8_t prio)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (job == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (handler == NULL) {
+        err = NOS_E_NULL;
+    }
+    else if (prio > NOS_CONFIG_JOB_HIGHEST_PRIO) {
+        err = NOS_E_INV_PRIO;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (job->state != NOS_JOB_DELETED) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        {
+            job->state        = NOS_JOB_CREATED;
+            job->handler      = handler;
+            job->arg          = arg;
+            job->prio         = prio;
+            nOS_SetNodeOwner(&job->node, job);
+
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+
+#if (NOS_CONFIG_JOB_DELETE_ENABLE > 0)
+nOS_Error nOS_JobDelete (nOS_Job *job)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (job == NULL) {
+        err = NOS_E_INV_OBJ;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (job->state == NOS_JOB_DELETED) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        {
+            if (job->state & NOS_JOB_PENDING) {
+                _RemoveFromList(job);
+            }
+            job->state = NOS_JOB_DELETED;
+
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+#endif
+
+nOS_Error nOS_JobActivate (nOS_Job *job)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (job == NULL) {
+        err = NOS_E_INV_OBJ;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (job->state == NOS_JOB_DELETED) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        if (job->state & NOS_JOB_PENDING) {
+            err = NOS_E_OVERFLOW;
+        }
+        else {
+            job->state = (nOS_JobState)(job->state | NOS_JOB_PENDING);
+            _AppendToList(job);
+
+            if ((nOS_jobThread.state & NOS_THREAD_WAITING_MASK) == NOS_THREAD_ON_HOLD) {
+                nOS_WakeUpThread(&nOS_jobThread, NOS_OK);
+#if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
+                /* Verify if a highest prio thread is ready to run */
+                nOS_Schedule();
+#endif
+            }
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+
+        if ((err == NOS_OK) && (nOS_isrNestingCounter == 0)) {
+            /* Activated from a job? Preempt it now if activated job prio is higher than system ceiling */
+            nOS_DispatchJobs();
+        }
+    }
+
+    return err;
+}
+
+bool nOS_JobIsPending (nOS_Job *job)
+{
+    nOS_StatusReg   sr;
+    bool            pending;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (job == NULL) {
+        pending = false;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (job->state == NOS_JOB_DELETED) {
+            pending = false;
+        } else
+#endif
+        {
+            pending = (job->state & NOS_JOB_PENDING) == NOS_JOB_PENDING;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return pending;
+}
+#endif  /* NOS_CONFIG_JOB_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
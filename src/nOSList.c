@@ -13,7 +13,12 @@
 extern "C" {
 #endif
 
-void nOS_AppendToList (nOS_List *list, nOS_Node *node)
+#if (NOS_CONFIG_CRITICAL_WALK_LIMIT > 0)
+/* Walks currently paused outside of critical section, most recent first */
+static nOS_ListWalk             *_walks;
+#endif
+
+NOS_FAST_CODE void nOS_AppendToList (nOS_List *list, nOS_Node *node)
 {
     node->prev = list->tail;
     node->next = NULL;
@@ -26,8 +31,35 @@ void nOS_AppendToList (nOS_List *list, nOS_Node *node)
     }
 }
 
-void nOS_RemoveFromList (nOS_List *list, nOS_Node *node)
+void nOS_InsertToList (nOS_List *list, nOS_Node *node, nOS_Node *next)
 {
+    if (next == NULL) {
+        nOS_AppendToList(list, node);
+    } else {
+        node->prev = next->prev;
+        node->next = next;
+        if (node->prev != NULL) {
+            node->prev->next = node;
+        }
+        next->prev = node;
+        if (list->head == next) {
+            list->head = node;
+        }
+    }
+}
+
+NOS_FAST_CODE void nOS_RemoveFromList (nOS_List *list, nOS_Node *node)
+{
+#if (NOS_CONFIG_CRITICAL_WALK_LIMIT > 0)
+    nOS_ListWalk    *walk;
+
+    /* Keep position of walks valid, their next node can be removed while they are paused */
+    for (walk = _walks; walk != NULL; walk = walk->link) {
+        if (walk->next == node) {
+            walk->next = node->next;
+        }
+    }
+#endif
     if (list->head == node) {
         list->head = node->next;
     }
@@ -65,11 +97,76 @@ void nOS_WalkInList (nOS_List *list, nOS_NodeHandler handler, void *arg)
 
     while (it != NULL) {
         next = it->next;
-        handler(it->payload, arg);
+        handler(it, arg);
         it = next;
     }
 }
 
+#if (NOS_CONFIG_CRITICAL_WALK_LIMIT > 0)
+/* Called from critical section. Scheduler is locked until end of walk, so only interrupts can run when walk is paused
+ * and walks can only be nested by interrupts. */
+void nOS_BeginWalk (nOS_ListWalk *walk, nOS_Node *first)
+{
+    walk->next   = first;
+    walk->count  = 0;
+    walk->locked = (nOS_lockNestingCounter == 0);
+    if (walk->locked) {
+        nOS_lockNestingCounter = 1;
+    }
+    walk->link   = _walks;
+    _walks       = walk;
+}
+
+/* Called from critical section after each node, leave it for a moment every NOS_CONFIG_CRITICAL_WALK_LIMIT nodes */
+void nOS_PauseWalk (nOS_ListWalk *walk, nOS_StatusReg *sr)
+{
+    walk->count++;
+    if (walk->count >= NOS_CONFIG_CRITICAL_WALK_LIMIT) {
+        walk->count = 0;
+        nOS_LeaveCritical(*sr);
+        nOS_EnterCritical(*sr);
+    }
+}
+
+/* Called from critical section */
+void nOS_EndWalk (nOS_ListWalk *walk)
+{
+    nOS_ListWalk    **it = &_walks;
+
+    /* Walks of different cores can end in any order */
+    while (*it != walk) {
+        it = &(*it)->link;
+    }
+    *it = walk->link;
+    if (walk->locked) {
+        nOS_lockNestingCounter = 0;
+ #if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
+        /* Threads made ready by interrupts while walk was paused */
+        nOS_Schedule();
+ #endif
+    }
+}
+
+/* Called from critical section, same as nOS_WalkInList but with interrupts allowed every
+ * NOS_CONFIG_CRITICAL_WALK_LIMIT nodes. Nodes added while walk is paused can be visited or not. */
+void nOS_WalkInListBounded (nOS_List *list, nOS_NodeHandler handler, void *arg, nOS_StatusReg *sr)
+{
+    nOS_ListWalk    walk;
+    nOS_Node        *it;
+
+    nOS_BeginWalk(&walk, list->head);
+    while (walk.next != NULL) {
+        it = walk.next;
+        walk.next = it->next;
+        handler(it, arg);
+        if (walk.next != NULL) {
+            nOS_PauseWalk(&walk, sr);
+        }
+    }
+    nOS_EndWalk(&walk);
+}
+#endif
+
 #ifdef __cplusplus
 }
 #endif
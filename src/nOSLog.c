@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2014-2016 Jim Tremblay
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#define NOS_PRIVATE
+#include "nOS.h"
+
+#if (NOS_CONFIG_LOG_ENABLE > 0) && (NOS_CONFIG_LOG_THREAD_ENABLE > 0)
+ #include <stdio.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if (NOS_CONFIG_LOG_ENABLE > 0)
+/* Writers reserve a slot by incrementing free running write counter, then publish record by storing its format
+ * pointer last. Single reader consume published records in order and release slot by clearing format pointer
+ * before incrementing read counter. A record reserved by a preempted writer hold back following ones until it is
+ * published. */
+#define _MASK                           (NOS_CONFIG_LOG_BUFFER_SIZE - 1)
+
+#if (NOS_CONFIG_LOG_THREAD_ENABLE > 0)
+ #if (NOS_CONFIG_THREAD_JOIN_ENABLE > 0)
+  static int _Thread (void *arg);
+ #else
+  static void _Thread (void *arg);
+ #endif
+#endif
+
+static volatile nOS_LogRecord   _buffer[NOS_CONFIG_LOG_BUFFER_SIZE];
+static volatile uint32_t        _w;
+static volatile uint32_t        _r;
+static volatile uint32_t        _lost;
+#if (NOS_CONFIG_LOG_THREAD_ENABLE > 0)
+ static nOS_Thread              _thread;
+ #ifdef NOS_SIMULATED_STACK
+  static nOS_Stack              _stack;
+ #else
+  static nOS_Stack              _stack[NOS_CONFIG_LOG_THREAD_STACK_SIZE];
+ #endif
+#endif
+
+#if (NOS_CONFIG_LOG_THREAD_ENABLE > 0)
+#if (NOS_CONFIG_THREAD_JOIN_ENABLE > 0)
+static int _Thread (void *arg)
+#else
+static void _Thread (void *arg)
+#endif
+{
+    nOS_LogRecord   record;
+    uint32_t        lost = 0;
+
+    NOS_UNUSED(arg);
+
+    while (1) {
+        while (nOS_LogRead(&record) == NOS_OK) {
+            printf(record.format, record.args[0], record.args[1], record.args[2], record.args[3]);
+        }
+        if (_lost != lost) {
+            printf("nOS_Log: %lu records lost\n", (unsigned long)(_lost - lost));
+            lost = _lost;
+        }
+        fflush(stdout);
+        nOS_Sleep(NOS_CONFIG_LOG_THREAD_PERIOD);
+
+#if (NOS_CONFIG_THREAD_JOIN_ENABLE > 0)
+        if (false) break; /* Remove "statement is unreachable" warning */
+    }
+
+    return 0;
+#else
+    }
+#endif
+}
+#endif  /* NOS_CONFIG_LOG_THREAD_ENABLE */
+
+void nOS_InitLog (void)
+{
+    _w    = 0;
+    _r    = 0;
+    _lost = 0;
+#if (NOS_CONFIG_LOG_THREAD_ENABLE > 0)
+    nOS_ThreadCreate(&_thread,
+                     _Thread,
+                     NULL
+ #ifdef NOS_SIMULATED_STACK
+                    ,&_stack
+ #else
+                    ,_stack
+ #endif
+                    ,NOS_CONFIG_LOG_THREAD_STACK_SIZE
+ #ifdef NOS_USE_SEPARATE_CALL_STACK
+                    ,NOS_CONFIG_LOG_THREAD_CALL_STACK_SIZE
+ #endif
+ #if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
+                    ,NOS_CONFIG_LOG_THREAD_PRIO
+ #endif
+ #if (NOS_CONFIG_THREAD_SUSPEND_ENABLE > 0)
+                    ,NOS_THREAD_READY
+ #endif
+ #if (NOS_CONFIG_THREAD_NAME_ENABLE > 0)
+                    ,"nOS_Log"
+ #endif
+ #if (NOS_CONFIG_THREAD_FPU_ENABLE > 0)
+                    ,true   /* printf can use FPU */
+ #endif
+ #if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+                    ,0      /* Service threads run on core 0 with tick */
+ #endif
+                    );
+#endif
+}
+
+nOS_Error nOS_LogWrite (const char *format, nOS_LogArg a0, nOS_LogArg a1, nOS_LogArg a2, nOS_LogArg a3)
+{
+    nOS_Error               err;
+    uint32_t                w;
+    volatile nOS_LogRecord  *record;
+#ifndef NOS_USE_EXCLUSIVE
+    nOS_StatusReg           sr;
+#endif
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (format == NULL) {
+        err = NOS_E_NULL;
+    } else
+#endif
+    {
+#ifdef NOS_USE_EXCLUSIVE
+        /* Exclusive access is lost on any exception, so no other writer can reserve same slot. */
+        do {
+            w = _LDREX(&_w);
+            if ((uint32_t)(w - _r) >= NOS_CONFIG_LOG_BUFFER_SIZE) {
+                err = NOS_E_FULL;
+                break;
+            }
+            err = NOS_OK;
+        } while (_STREX(w + 1, &_w) != 0);
+        if (err == NOS_E_FULL) {
+            do {
+                w = _LDREX(&_lost);
+            } while (_STREX(w + 1, &_lost) != 0);
+        }
+#else
+        nOS_EnterCritical(sr);
+        w = _w;
+        if ((uint32_t)(w - _r) >= NOS_CONFIG_LOG_BUFFER_SIZE) {
+            _lost++;
+            err = NOS_E_FULL;
+        }
+        else {
+            _w = w + 1;
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+#endif
+
+        if (err == NOS_OK) {
+            record = &_buffer[w & _MASK];
+            record->args[0] = a0;
+            record->args[1] = a1;
+            record->args[2] = a2;
+            record->args[3] = a3;
+            record->seq     = (uint16_t)w;
+            /* Publish record */
+            record->format  = format;
+        }
+    }
+
+    return err;
+}
+
+nOS_Error nOS_LogRead (nOS_LogRecord *record)
+{
+    nOS_Error               err;
+    uint32_t                r;
+    volatile nOS_LogRecord  *slot;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (record == NULL) {
+        err = NOS_E_NULL;
+    } else
+#endif
+    {
+        r = _r;
+        slot = &_buffer[r & _MASK];
+        if ((r == _w) || (slot->format == NULL)) {
+            err = NOS_E_EMPTY;
+        }
+        else {
+            record->format  = slot->format;
+            record->args[0] = slot->args[0];
+            record->args[1] = slot->args[1];
+            record->args[2] = slot->args[2];
+            record->args[3] = slot->args[3];
+            record->seq     = slot->seq;
+            /* Release slot before writers can see it free */
+            slot->format    = NULL;
+            _r = r + 1;
+            err = NOS_OK;
+        }
+    }
+
+    return err;
+}
+
+uint32_t nOS_LogGetLost (void)
+{
+    return _lost;
+}
+#endif  /* NOS_CONFIG_LOG_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,360 @@
+/*
+ * Copyright (c) 2014-2016 Jim Tremblay
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#define NOS_PRIVATE
+#include "nOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if (NOS_CONFIG_MBOX_ENABLE > 0)
+/* Messages are only pointers, stored and passed to waiting threads with word sized accesses. Threads can only wait to
+ * read when mailbox is empty and only wait to write when mailbox is full, so waiting list never contain both. */
+#define _NextIndex(m,i)                 ((nOS_MboxCounter)(((i) + 1) < (m)->bmax ? ((i) + 1) : 0))
+
+nOS_Error nOS_MboxCreate (nOS_Mbox *mbox, void **buffer, nOS_MboxCounter bmax)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (mbox == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (buffer == NULL) {
+        err = NOS_E_NULL;
+    }
+    else if (bmax == 0) {
+        err = NOS_E_INV_VAL;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (mbox->e.type != NOS_EVENT_INVALID) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        {
+            nOS_CreateEvent((nOS_Event*)mbox
+#if (NOS_CONFIG_SAFE > 0)
+                           ,NOS_EVENT_MBOX
+#endif
+                           );
+            mbox->buffer = buffer;
+            mbox->bmax   = bmax;
+            mbox->bcount = 0;
+            mbox->r      = 0;
+            mbox->w      = 0;
+
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+
+#if (NOS_CONFIG_MBOX_DELETE_ENABLE > 0)
+nOS_Error nOS_MboxDelete (nOS_Mbox *mbox)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (mbox == NULL) {
+        err = NOS_E_INV_OBJ;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (mbox->e.type != NOS_EVENT_MBOX) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        {
+            mbox->buffer = NULL;
+            mbox->bmax   = 0;
+            mbox->bcount = 0;
+            mbox->r      = 0;
+            mbox->w      = 0;
+            nOS_DeleteEvent((nOS_Event*)mbox);
+
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+#endif
+
+nOS_Error nOS_MboxRead (nOS_Mbox *mbox, void **msg, nOS_TickCounter timeout)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+    nOS_Thread      *thread;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (mbox == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (msg == NULL) {
+        err = NOS_E_NULL;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (mbox->e.type != NOS_EVENT_MBOX) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        if (mbox->bcount > 0) {
+            *msg = mbox->buffer[mbox->r];
+            mbox->r = _NextIndex(mbox, mbox->r);
+            mbox->bcount--;
+            /* Thread waiting in a non empty mailbox is waiting to write, give it the free slot */
+            thread = nOS_GetHeadOfList(&mbox->e.waitList, nOS_Thread, readyWait);
+            if (thread != NULL) {
+                mbox->buffer[mbox->w] = thread->ext;
+                mbox->w = _NextIndex(mbox, mbox->w);
+                mbox->bcount++;
+                nOS_WakeUpThread(thread, NOS_OK);
+#if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
+                /* Verify if a highest prio thread is ready to run */
+                nOS_Schedule();
+#endif
+            }
+            err = NOS_OK;
+        }
+        else if (timeout == NOS_NO_WAIT) {
+            err = NOS_E_EMPTY;
+        }
+        else {
+            nOS_runningThread->ext = msg;
+            err = nOS_WaitForEvent((nOS_Event*)mbox,
+                                   NOS_THREAD_READING_MBOX
+#if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0)
+                                  ,timeout
+#elif (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
+                                  ,NOS_WAIT_INFINITE
+#endif
+                                  );
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+
+nOS_Error nOS_MboxWrite (nOS_Mbox *mbox, void *msg, nOS_TickCounter timeout)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+    nOS_Thread      *thread;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (mbox == NULL) {
+        err = NOS_E_INV_OBJ;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (mbox->e.type != NOS_EVENT_MBOX) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        {
+            /* Thread waiting in an empty mailbox is waiting to read, give it the message directly */
+            thread = (mbox->bcount == 0) ? nOS_GetHeadOfList(&mbox->e.waitList, nOS_Thread, readyWait) : NULL;
+            if (thread != NULL) {
+                *(void**)thread->ext = msg;
+                nOS_WakeUpThread(thread, NOS_OK);
+#if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
+                /* Verify if a highest prio thread is ready to run */
+                nOS_Schedule();
+#endif
+                err = NOS_OK;
+            }
+            else if (mbox->bcount < mbox->bmax) {
+                mbox->buffer[mbox->w] = msg;
+                mbox->w = _NextIndex(mbox, mbox->w);
+                mbox->bcount++;
+                err = NOS_OK;
+            }
+            else if (timeout == NOS_NO_WAIT) {
+                err = NOS_E_FULL;
+            }
+            else {
+                nOS_runningThread->ext = msg;
+                err = nOS_WaitForEvent((nOS_Event*)mbox,
+                                       NOS_THREAD_WRITING_MBOX
+#if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0)
+                                      ,timeout
+#elif (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
+                                      ,NOS_WAIT_INFINITE
+#endif
+                                      );
+            }
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+
+#if (NOS_CONFIG_MEM_ENABLE > 0)
+nOS_Error nOS_MboxWriteMem (nOS_Mbox *mbox, nOS_Mem *mem, nOS_MboxCallback callback, nOS_TickCounter timeout)
+{
+    nOS_Error       err;
+    void            *block;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (mbox == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (mem == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (callback == NULL) {
+        err = NOS_E_NULL;
+    } else
+#endif
+    {
+        block = nOS_MemAlloc(mem, timeout);
+        if (block == NULL) {
+            err = NOS_E_EMPTY;
+        }
+        else {
+            /* Fill message outside of critical section */
+            callback(mbox, block);
+            err = nOS_MboxWrite(mbox, block, timeout);
+            if (err != NOS_OK) {
+                /* Block is still owned by caller, give it back */
+                nOS_MemFree(mem, block);
+            }
+        }
+    }
+
+    return err;
+}
+
+nOS_Error nOS_MboxReadMem (nOS_Mbox *mbox, nOS_Mem *mem, nOS_MboxCallback callback, nOS_TickCounter timeout)
+{
+    nOS_Error       err;
+    void            *block;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (mbox == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (mem == NULL) {
+        err = NOS_E_INV_OBJ;
+    } else
+#endif
+    {
+        err = nOS_MboxRead(mbox, &block, timeout);
+        if (err == NOS_OK) {
+            /* Consume message outside of critical section */
+            if (callback != NULL) {
+                callback(mbox, block);
+            }
+            err = nOS_MemFree(mem, block);
+        }
+    }
+
+    return err;
+}
+#endif
+
+bool nOS_MboxIsEmpty (nOS_Mbox *mbox)
+{
+    nOS_StatusReg   sr;
+    bool            empty;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (mbox == NULL) {
+        empty = false;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (mbox->e.type != NOS_EVENT_MBOX) {
+            empty = false;
+        } else
+#endif
+        {
+            empty = (mbox->bcount == 0);
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return empty;
+}
+
+bool nOS_MboxIsFull (nOS_Mbox *mbox)
+{
+    nOS_StatusReg   sr;
+    bool            full;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (mbox == NULL) {
+        full = false;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (mbox->e.type != NOS_EVENT_MBOX) {
+            full = false;
+        } else
+#endif
+        {
+            full = (mbox->bcount == mbox->bmax);
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return full;
+}
+
+nOS_MboxCounter nOS_MboxGetCount (nOS_Mbox *mbox)
+{
+    nOS_StatusReg   sr;
+    nOS_MboxCounter bcount;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (mbox == NULL) {
+        bcount = 0;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (mbox->e.type != NOS_EVENT_MBOX) {
+            bcount = 0;
+        } else
+#endif
+        {
+            bcount = mbox->bcount;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return bcount;
+}
+#endif  /* NOS_CONFIG_MBOX_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
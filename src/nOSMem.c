@@ -14,6 +14,14 @@ extern "C" {
 #endif
 
 #if (NOS_CONFIG_MEM_ENABLE > 0)
+#if (NOS_CONFIG_MEM_BITMAP_ENABLE > 0)
+/* One bit per block, set when block is allocated */
+#define _GetIndex(m,b)                  ((nOS_MemCounter)((size_t)((uint8_t*)(b) - (uint8_t*)(m)->buffer) / (m)->bsize))
+#define _IsAllocated(m,i)               (((m)->bitmap[(i) >> 3] & (uint8_t)(1 << ((i) & 7))) != 0)
+#define _SetAllocated(m,i)              (m)->bitmap[(i) >> 3] |= (uint8_t)(1 << ((i) & 7))
+#define _ClearAllocated(m,i)            (m)->bitmap[(i) >> 3] &= (uint8_t)~(1 << ((i) & 7))
+#endif
+
 #if (NOS_CONFIG_MEM_SANITY_CHECK_ENABLE > 0)
 /**********************************************************************************************************************
  *                                                                                                                    *
@@ -34,6 +42,8 @@ extern "C" {
  *                                                                                                                    *
  * Notes                                                                                                              *
  *   1. Never suppose to happen normally, can be a sign of corruption.                                                *
+ *   2. Done in constant time if NOS_CONFIG_MEM_BITMAP_ENABLE is defined to 1, otherwise list of free blocks is       *
+ *      walked.                                                                                                       *
  *                                                                                                                    *
  **********************************************************************************************************************/
 static nOS_Error _SanityCheck (nOS_Mem *mem, void *block)
@@ -58,18 +68,82 @@ static nOS_Error _SanityCheck (nOS_Mem *mem, void *block)
     }
     else {
         /* Memory block is already free? */
+#if (NOS_CONFIG_MEM_BITMAP_ENABLE > 0)
+        err = _IsAllocated(mem, _GetIndex(mem, block)) ? NOS_OK : NOS_E_OVERFLOW;
+#else
         void *p = (void*)mem->blist;
         while ((p != NULL) && (p != block)) {
             p = *(void**)p;
         }
         err = p == block ? NOS_E_OVERFLOW : NOS_OK;
+#endif
+    }
+
+#if (NOS_CONFIG_MEM_STATS_ENABLE > 0)
+    if (err != NOS_OK) {
+        mem->freeFail++;
     }
+#endif
 
     return err;
 }
 #endif  /* NOS_CONFIG_MEM_SANITY_CHECK_ENABLE */
 
-nOS_Error nOS_MemCreate (nOS_Mem *mem, void *buffer, nOS_MemSize bsize, nOS_MemCounter bmax)
+/* Called from critical section with at least one block available */
+static void* _TakeBlock (nOS_Mem *mem)
+{
+    void    *block = (void*)mem->blist;
+
+    mem->blist = *(void***)block;
+#if (NOS_CONFIG_MEM_SANITY_CHECK_ENABLE > 0) || (NOS_CONFIG_MEM_STATS_ENABLE > 0)
+    mem->bcount--;
+#endif
+#if (NOS_CONFIG_MEM_BITMAP_ENABLE > 0)
+    _SetAllocated(mem, _GetIndex(mem, block));
+#endif
+#if (NOS_CONFIG_MEM_STATS_ENABLE > 0)
+    if (mem->bcount < mem->bmin) {
+        mem->bmin = mem->bcount;
+    }
+#endif
+
+    return block;
+}
+
+/* Called from critical section, give block to first waiting thread or put it back in list of free blocks */
+static nOS_Thread* _GiveBlock (nOS_Mem *mem, void *block)
+{
+    nOS_Thread  *thread;
+
+    thread = nOS_SendEvent((nOS_Event*)mem, NOS_OK);
+    if (thread != NULL) {
+        *(void**)thread->ext = block;
+    }
+    else {
+        *(void**)block = mem->blist;
+        mem->blist = (void**)block;
+#if (NOS_CONFIG_MEM_SANITY_CHECK_ENABLE > 0) || (NOS_CONFIG_MEM_STATS_ENABLE > 0)
+        mem->bcount++;
+#endif
+#if (NOS_CONFIG_MEM_BITMAP_ENABLE > 0)
+        _ClearAllocated(mem, _GetIndex(mem, block));
+#endif
+#if (NOS_CONFIG_SELECT_ENABLE > 0)
+        nOS_SignalSelect((nOS_Event*)mem, NOS_OK);
+#endif
+    }
+
+    return thread;
+}
+
+nOS_Error nOS_MemCreate (nOS_Mem *mem,
+                         void *buffer,
+                         nOS_MemSize bsize,
+                         nOS_MemCounter bmax
+#if (NOS_CONFIG_MEM_BITMAP_ENABLE > 0)
+                        ,void *bitmap
+#endif
+                        )
 {
     nOS_Error       err;
     nOS_StatusReg   sr;
@@ -83,6 +157,11 @@ nOS_Error nOS_MemCreate (nOS_Mem *mem, void *buffer, nOS_MemSize bsize, nOS_MemC
     else if (buffer == NULL) {
         err = NOS_E_NULL;
     }
+ #if (NOS_CONFIG_MEM_BITMAP_ENABLE > 0)
+    else if (bitmap == NULL) {
+        err = NOS_E_NULL;
+    }
+ #endif
     else if (bsize < sizeof(void**)) {
         err = NOS_E_INV_VAL;
     } else
@@ -129,9 +208,20 @@ nOS_Error nOS_MemCreate (nOS_Mem *mem, void *buffer, nOS_MemSize bsize, nOS_MemC
             mem->blist  = (void**)buffer;
 #if (NOS_CONFIG_MEM_SANITY_CHECK_ENABLE > 0)
             mem->bsize  = bsize;
+ #if (NOS_CONFIG_MEM_BITMAP_ENABLE > 0)
+            mem->bitmap = (uint8_t*)bitmap;
+            memset(bitmap, 0, NOS_MEM_BITMAP_SIZE(bmax));
+ #endif
+#endif
+#if (NOS_CONFIG_MEM_SANITY_CHECK_ENABLE > 0) || (NOS_CONFIG_MEM_STATS_ENABLE > 0)
             mem->bcount = bmax;
             mem->bmax   = bmax;
 #endif
+#if (NOS_CONFIG_MEM_STATS_ENABLE > 0)
+            mem->bmin      = bmax;
+            mem->allocFail = 0;
+            mem->freeFail  = 0;
+#endif
 
             err = NOS_OK;
         }
@@ -164,6 +254,11 @@ nOS_Error nOS_MemDelete (nOS_Mem *mem)
 #if (NOS_CONFIG_MEM_SANITY_CHECK_ENABLE > 0)
             mem->buffer = NULL;
             mem->bsize  = 0;
+ #if (NOS_CONFIG_MEM_BITMAP_ENABLE > 0)
+            mem->bitmap = NULL;
+ #endif
+#endif
+#if (NOS_CONFIG_MEM_SANITY_CHECK_ENABLE > 0) || (NOS_CONFIG_MEM_STATS_ENABLE > 0)
             mem->bcount = 0;
             mem->bmax   = 0;
 #endif
@@ -196,15 +291,14 @@ void *nOS_MemAlloc(nOS_Mem *mem, nOS_TickCounter timeout)
         } else
 #endif
         if (mem->blist != NULL) {
-            block = (void*)mem->blist;
-            mem->blist = *(void***)block;
-#if (NOS_CONFIG_MEM_SANITY_CHECK_ENABLE > 0)
-            mem->bcount--;
-#endif
+            block = _TakeBlock(mem);
         }
         else if (timeout == NOS_NO_WAIT) {
             /* Caller can't wait? Try again. */
             block = NULL;
+#if (NOS_CONFIG_MEM_STATS_ENABLE > 0)
+            mem->allocFail++;
+#endif
         }
         else {
             block = NULL;
@@ -217,6 +311,12 @@ void *nOS_MemAlloc(nOS_Mem *mem, nOS_TickCounter timeout)
                             ,NOS_WAIT_INFINITE
 #endif
                             );
+#if (NOS_CONFIG_MEM_STATS_ENABLE > 0)
+            /* Block is given directly by nOS_MemFree or timeout reached */
+            if (block == NULL) {
+                mem->allocFail++;
+            }
+#endif
         }
         nOS_LeaveCritical(sr);
     }
@@ -228,7 +328,6 @@ nOS_Error nOS_MemFree(nOS_Mem *mem, void *block)
 {
     nOS_Error       err;
     nOS_StatusReg   sr;
-    nOS_Thread      *thread;
 
 #if (NOS_CONFIG_SAFE > 0)
     if (mem == NULL) {
@@ -253,19 +352,10 @@ nOS_Error nOS_MemFree(nOS_Mem *mem, void *block)
             err = NOS_OK;
 #endif
             {
-                thread = nOS_SendEvent((nOS_Event*)mem, NOS_OK);
-                if (thread != NULL) {
-                    *(void**)thread->ext = block;
+                if (_GiveBlock(mem, block) != NULL) {
 #if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
                     /* Verify if a highest prio thread is ready to run */
                     nOS_Schedule();
-#endif
-                }
-                else {
-                    *(void**)block = mem->blist;
-                    mem->blist = (void**)block;
-#if (NOS_CONFIG_MEM_SANITY_CHECK_ENABLE > 0)
-                    mem->bcount++;
 #endif
                 }
             }
@@ -301,6 +391,236 @@ bool nOS_MemIsAvailable (nOS_Mem *mem)
 
     return avail;
 }
+
+#if (NOS_CONFIG_MEM_STATS_ENABLE > 0)
+nOS_Error nOS_MemGetStats (nOS_Mem *mem, nOS_MemStats *stats)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (mem == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (stats == NULL) {
+        err = NOS_E_NULL;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (mem->e.type != NOS_EVENT_MEM) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        {
+            stats->bmax      = mem->bmax;
+            stats->bcount    = mem->bcount;
+            stats->bpeak     = mem->bmax - mem->bmin;
+            stats->allocFail = mem->allocFail;
+            stats->freeFail  = mem->freeFail;
+
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+#endif
+
+#if (NOS_CONFIG_MEM_CACHE_ENABLE > 0)
+/* Number of blocks moved from/to mem object at a time */
+#define _GetBatchSize(c)                ((uint8_t)(((c)->bmax + 1) / 2))
+
+/* Called from critical section */
+static void _Refill (nOS_MemCache *cache)
+{
+    nOS_Mem     *mem = cache->mem;
+    uint8_t     n = _GetBatchSize(cache);
+    void        *block;
+
+    while ((mem->blist != NULL) && (n > 0)) {
+        block = _TakeBlock(mem);
+        *(void**)block = cache->blist;
+        cache->blist = (void**)block;
+        cache->bcount++;
+        n--;
+    }
+}
+
+static nOS_Error _Drain (nOS_MemCache *cache, uint8_t n)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+    nOS_Mem         *mem = cache->mem;
+    void            *block;
+#if (NOS_CONFIG_MEM_SANITY_CHECK_ENABLE > 0)
+    nOS_Error       check;
+#endif
+#if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
+    bool            sched = false;
+#endif
+
+    nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+    if (mem->e.type != NOS_EVENT_MEM) {
+        err = NOS_E_INV_OBJ;
+    } else
+#endif
+    {
+        err = NOS_OK;
+        while ((cache->blist != NULL) && (n > 0)) {
+            block = (void*)cache->blist;
+            cache->blist = *(void***)block;
+            cache->bcount--;
+            n--;
+#if (NOS_CONFIG_MEM_SANITY_CHECK_ENABLE > 0)
+            check = _SanityCheck(mem, block);
+            if (check != NOS_OK) {
+                /* Corrupted block is dropped */
+                err = check;
+            } else
+#endif
+            if (_GiveBlock(mem, block) != NULL) {
+#if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
+                sched = true;
+#endif
+            }
+        }
+#if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
+        if (sched) {
+            /* Verify if a highest prio thread is ready to run */
+            nOS_Schedule();
+        }
+#endif
+    }
+    nOS_LeaveCritical(sr);
+
+    return err;
+}
+
+nOS_Error nOS_MemCacheCreate (nOS_MemCache *cache, nOS_Mem *mem, uint8_t bmax)
+{
+    nOS_Error       err;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (cache == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (mem == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (mem->e.type != NOS_EVENT_MEM) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (bmax == 0) {
+        err = NOS_E_INV_VAL;
+    } else
+#endif
+    {
+        cache->mem    = mem;
+        cache->blist  = NULL;
+        cache->bcount = 0;
+        cache->bmax   = bmax;
+
+        err = NOS_OK;
+    }
+
+    return err;
+}
+
+/* Can be called from owner thread only */
+void *nOS_MemCacheAlloc (nOS_MemCache *cache, nOS_TickCounter timeout)
+{
+    nOS_StatusReg   sr;
+    void            *block;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (cache == NULL) {
+        block = NULL;
+    }
+    else if (cache->mem == NULL) {
+        block = NULL;
+    } else
+#endif
+    {
+        if (cache->blist == NULL) {
+            nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+            if (cache->mem->e.type == NOS_EVENT_MEM)
+#endif
+            {
+                _Refill(cache);
+            }
+            nOS_LeaveCritical(sr);
+        }
+        if (cache->blist != NULL) {
+            block = (void*)cache->blist;
+            cache->blist = *(void***)block;
+            cache->bcount--;
+        }
+        else {
+            /* Mem object is empty, wait like any other thread */
+            block = nOS_MemAlloc(cache->mem, timeout);
+        }
+    }
+
+    return block;
+}
+
+/* Can be called from owner thread only */
+nOS_Error nOS_MemCacheFree (nOS_MemCache *cache, void *block)
+{
+    nOS_Error       err;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (cache == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (cache->mem == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (block == NULL) {
+        err = NOS_E_INV_VAL;
+    } else
+#endif
+    if (cache->mem->e.waitList.head != NULL) {
+        /* Don't keep block in cache while other threads are waiting for one */
+        err = nOS_MemFree(cache->mem, block);
+    }
+    else {
+        err = NOS_OK;
+        if (cache->bcount == cache->bmax) {
+            err = _Drain(cache, _GetBatchSize(cache));
+        }
+        *(void**)block = cache->blist;
+        cache->blist = (void**)block;
+        cache->bcount++;
+    }
+
+    return err;
+}
+
+nOS_Error nOS_MemCacheFlush (nOS_MemCache *cache)
+{
+    nOS_Error       err;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (cache == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (cache->mem == NULL) {
+        err = NOS_E_INV_OBJ;
+    } else
+#endif
+    {
+        err = _Drain(cache, cache->bcount);
+    }
+
+    return err;
+}
+#endif  /* NOS_CONFIG_MEM_CACHE_ENABLE */
 #endif  /* NOS_CONFIG_MEM_ENABLE */
 
 #ifdef __cplusplus
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2014-2016 Jim Tremblay
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#define NOS_PRIVATE
+#include "nOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if (NOS_CONFIG_MSGQUEUE_ENABLE > 0)
+/* Messages are linked in queue with a node provided by sender, usually embedded in message itself, so queue never
+ * copy messages and is never full. Threads can only wait to receive when queue is empty. */
+nOS_Error nOS_MsgQueueCreate (nOS_MsgQueue *msgq)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (msgq == NULL) {
+        err = NOS_E_INV_OBJ;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (msgq->e.type != NOS_EVENT_INVALID) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        {
+            nOS_CreateEvent((nOS_Event*)msgq
+#if (NOS_CONFIG_SAFE > 0)
+                           ,NOS_EVENT_MSGQUEUE
+#endif
+                           );
+            nOS_InitList(&msgq->list);
+
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+
+#if (NOS_CONFIG_MSGQUEUE_DELETE_ENABLE > 0)
+/* Messages still in queue are not touched, their nodes are simply forgotten */
+nOS_Error nOS_MsgQueueDelete (nOS_MsgQueue *msgq)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (msgq == NULL) {
+        err = NOS_E_INV_OBJ;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (msgq->e.type != NOS_EVENT_MSGQUEUE) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        {
+            nOS_InitList(&msgq->list);
+            nOS_DeleteEvent((nOS_Event*)msgq);
+
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+#endif
+
+nOS_Error nOS_MsgQueueSend (nOS_MsgQueue *msgq, nOS_Node *node, void *msg)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+    nOS_Thread      *thread;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (msgq == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (node == NULL) {
+        err = NOS_E_NULL;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (msgq->e.type != NOS_EVENT_MSGQUEUE) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        {
+            /* Thread can only wait in an empty queue, give it the message directly */
+            thread = (msgq->list.head == NULL) ? nOS_GetHeadOfList(&msgq->e.waitList, nOS_Thread, readyWait) : NULL;
+            if (thread != NULL) {
+                *(void**)thread->ext = msg;
+                nOS_WakeUpThread(thread, NOS_OK);
+#if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
+                /* Verify if a highest prio thread is ready to run */
+                nOS_Schedule();
+#endif
+            }
+            else {
+                node->payload = msg;
+                nOS_AppendToList(&msgq->list, node);
+            }
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+
+nOS_Error nOS_MsgQueueReceive (nOS_MsgQueue *msgq, void **msg, nOS_TickCounter timeout)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+    nOS_Node        *node;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (msgq == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (msg == NULL) {
+        err = NOS_E_NULL;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (msgq->e.type != NOS_EVENT_MSGQUEUE) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        if (msgq->list.head != NULL) {
+            node = msgq->list.head;
+            nOS_RemoveFromList(&msgq->list, node);
+            *msg = node->payload;
+            err = NOS_OK;
+        }
+        else if (timeout == NOS_NO_WAIT) {
+            err = NOS_E_EMPTY;
+        }
+        else {
+            nOS_runningThread->ext = msg;
+            err = nOS_WaitForEvent((nOS_Event*)msgq,
+                                   NOS_THREAD_READING_MSGQUEUE
+#if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0)
+                                  ,timeout
+#elif (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
+                                  ,NOS_WAIT_INFINITE
+#endif
+                                  );
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+
+bool nOS_MsgQueueIsEmpty (nOS_MsgQueue *msgq)
+{
+    nOS_StatusReg   sr;
+    bool            empty;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (msgq == NULL) {
+        empty = false;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (msgq->e.type != NOS_EVENT_MSGQUEUE) {
+            empty = false;
+        } else
+#endif
+        {
+            empty = (msgq->list.head == NULL);
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return empty;
+}
+#endif  /* NOS_CONFIG_MSGQUEUE_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
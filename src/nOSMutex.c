@@ -14,10 +14,13 @@ extern "C" {
 #endif
 
 #if (NOS_CONFIG_MUTEX_ENABLE > 0)
- #if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
- static void _TestPrioHighest (void *payload, void *arg)
+ #if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0) && (NOS_CONFIG_WAITING_PRIO_ORDER_ENABLE > 0) && (NOS_CONFIG_WAITING_POLICY_ENABLE == 0)
+ /* Waiting list is ordered by priority, highest priority thread is at head */
+  #define _FindHighestPrioWaiting(m)    (nOS_GetNodeOwner((m)->e.waitList.head, nOS_Thread, readyWait)->prio)
+ #elif (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
+ static void _TestPrioHighest (void *node, void *arg)
  {
-    nOS_Thread      *thread  = (nOS_Thread*)payload;
+    nOS_Thread      *thread  = nOS_GetNodeOwner((nOS_Node*)node, nOS_Thread, readyWait);
     uint8_t         *prio    = (uint8_t*)arg;
 
     if (*prio < thread->prio) {
@@ -29,12 +32,26 @@ extern "C" {
  {
     uint8_t prio = 0;
 
-    nOS_WalkInList(&mutex->e.waitList, _TestPrioHighest, &prio);
+  #if (NOS_CONFIG_WAITING_POLICY_ENABLE > 0)
+    /* Waiting list is ordered by priority, highest priority thread is at head */
+    if (mutex->e.policy == NOS_WAITING_POLICY_PRIO) {
+        prio = nOS_GetNodeOwner(mutex->e.waitList.head, nOS_Thread, readyWait)->prio;
+    } else
+  #endif
+    {
+        nOS_WalkInList(&mutex->e.waitList, _TestPrioHighest, &prio);
+    }
 
     return prio;
  }
  #endif
 
+ #if (NOS_CONFIG_SMP_CORE_COUNT > 1) && (NOS_CONFIG_MUTEX_SPIN_COUNT > 0)
+ /* Called from critical section, owner running on another core can unlock the mutex soon */
+  #define _IsOwnerRunning(m)            (((m)->owner != NULL) && ((m)->owner != nOS_runningThread) &&            \
+                                         (nOS_runningThreads[(m)->owner->core] == (m)->owner))
+ #endif
+
 nOS_Error nOS_MutexCreate (nOS_Mutex *mutex,
                            nOS_MutexType type
 #if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
@@ -117,6 +134,9 @@ nOS_Error nOS_MutexLock (nOS_Mutex *mutex, nOS_TickCounter timeout)
 {
     nOS_Error       err;
     nOS_StatusReg   sr;
+#if (NOS_CONFIG_SMP_CORE_COUNT > 1) && (NOS_CONFIG_MUTEX_SPIN_COUNT > 0)
+    uint32_t        spin;
+#endif
 
 #if (NOS_CONFIG_SAFE > 0)
     if (mutex == NULL) {
@@ -129,6 +149,19 @@ nOS_Error nOS_MutexLock (nOS_Mutex *mutex, nOS_TickCounter timeout)
 #endif
     {
         nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SMP_CORE_COUNT > 1) && (NOS_CONFIG_MUTEX_SPIN_COUNT > 0)
+        /* Spin a bounded number of times before blocking, owner need the critical section to unlock the mutex */
+        if (timeout != NOS_NO_WAIT
+ #if (NOS_CONFIG_SAFE > 0)
+            && (mutex->e.type == NOS_EVENT_MUTEX)
+ #endif
+           ) {
+            for (spin = 0; (spin < NOS_CONFIG_MUTEX_SPIN_COUNT) && _IsOwnerRunning(mutex); spin++) {
+                nOS_LeaveCritical(sr);
+                nOS_EnterCritical(sr);
+            }
+        }
+#endif
 #if (NOS_CONFIG_SAFE > 0)
         if (mutex->e.type != NOS_EVENT_MUTEX) {
             err = NOS_E_INV_OBJ;
@@ -139,10 +172,18 @@ nOS_Error nOS_MutexLock (nOS_Mutex *mutex, nOS_TickCounter timeout)
             mutex->count++;
             mutex->owner = nOS_runningThread;
 #if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
-            mutex->backup = nOS_runningThread->prio;
-            if (mutex->prio != NOS_MUTEX_PRIO_INHERIT) {
-                if (nOS_runningThread->prio < mutex->prio) {
-                    nOS_SetThreadPrio(nOS_runningThread, mutex->prio);
+ #if (NOS_CONFIG_JOB_ENABLE > 0)
+            if (nOS_runningThread == &nOS_jobThread) {
+                /* Locked by a job, mutex prio is a ceiling of job prio, raise system ceiling instead of thread prio */
+                mutex->backup = nOS_RaiseJobCeiling(mutex->prio);
+            } else
+ #endif
+            {
+                mutex->backup = nOS_runningThread->prio;
+                if (mutex->prio != NOS_MUTEX_PRIO_INHERIT) {
+                    if (nOS_runningThread->prio < mutex->prio) {
+                        nOS_SetThreadPrio(nOS_runningThread, mutex->prio);
+                    }
                 }
             }
 #endif
@@ -225,7 +266,14 @@ nOS_Error nOS_MutexUnlock (nOS_Mutex *mutex)
         else {
             if (mutex->count == 1) {
 #if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
-                nOS_SetThreadPrio(mutex->owner, mutex->backup);
+ #if (NOS_CONFIG_JOB_ENABLE > 0)
+                if (mutex->owner == &nOS_jobThread) {
+                    nOS_RestoreJobCeiling(mutex->backup);
+                } else
+ #endif
+                {
+                    nOS_SetThreadPrio(mutex->owner, mutex->backup);
+                }
 #endif
                 thread = nOS_SendEvent((nOS_Event*)mutex, NOS_OK);
                 if (thread != NULL) {
@@ -262,6 +310,13 @@ nOS_Error nOS_MutexUnlock (nOS_Mutex *mutex)
             err = NOS_OK;
         }
         nOS_LeaveCritical(sr);
+
+#if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0) && (NOS_CONFIG_JOB_ENABLE > 0)
+        if (err == NOS_OK) {
+            /* Unlocked by a job? Pending jobs above restored ceiling preempt it now */
+            nOS_DispatchJobs();
+        }
+#endif
     }
 
     return err;
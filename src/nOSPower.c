@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2014-2016 Jim Tremblay
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#define NOS_PRIVATE
+#include "nOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if (NOS_CONFIG_POWER_ENABLE > 0)
+/* Port mode tables are ordered from lightest to deepest mode: latency grow and modes that stop tick source come
+ * after all modes that keep it running, so selection stop at first mode that doesn't fit. */
+#if ((1000000UL / NOS_CONFIG_TICKS_PER_SECOND) > 0)
+ #define _US_PER_TICK                   (1000000UL / NOS_CONFIG_TICKS_PER_SECOND)
+#else
+ #define _US_PER_TICK                   1UL
+#endif
+#if (NOS_CONFIG_POWER_DEEPEST_MODE < (NOS_POWER_MODE_COUNT - 1))
+ #define _MODE_COUNT                    (NOS_CONFIG_POWER_DEEPEST_MODE + 1)
+#else
+ #define _MODE_COUNT                    NOS_POWER_MODE_COUNT
+#endif
+
+static nOS_List                 _list;
+
+void nOS_InitPower (void)
+{
+    nOS_InitList(&_list);
+}
+
+/* Called by port from main thread (idle) with interrupts disabled */
+uint8_t nOS_PowerSelectMode (nOS_TickCounter ticks)
+{
+    nOS_Node            *node;
+    nOS_PowerRequest    *request;
+    uint32_t            limit = 0xFFFFFFFFUL;
+    uint32_t            available;
+    uint8_t             mode = 0;
+    uint8_t             i;
+
+    for (node = _list.head; node != NULL; node = node->next) {
+        request = nOS_GetNodeOwner(node, nOS_PowerRequest, node);
+        if (request->latency < limit) {
+            limit = request->latency;
+        }
+    }
+
+    /* Current tick is already started, count only complete ones */
+    if (ticks == NOS_WAIT_INFINITE) {
+        available = 0xFFFFFFFFUL;
+    }
+    else if ((ticks - 1) > (0xFFFFFFFFUL / _US_PER_TICK)) {
+        available = 0xFFFFFFFFUL;
+    }
+    else {
+        available = (uint32_t)(ticks - 1) * _US_PER_TICK;
+    }
+
+    for (i = 1; i < _MODE_COUNT; i++) {
+        if (nOS_powerModes[i].latency > limit) {
+            break;
+        }
+        else if (!nOS_powerModes[i].tick && (ticks != NOS_WAIT_INFINITE)) {
+            /* Something is waiting on ticks */
+            break;
+        }
+        else if ((ticks != NOS_WAIT_INFINITE) && (nOS_powerModes[i].latency >= available)) {
+            break;
+        }
+        else {
+            mode = i;
+        }
+    }
+
+    return mode;
+}
+
+nOS_Error nOS_PowerRequestMaxLatency (nOS_PowerRequest *request, uint32_t latency)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (request == NULL) {
+        err = NOS_E_INV_OBJ;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+        if (!request->active) {
+            nOS_SetNodeOwner(&request->node, request);
+            nOS_AppendToList(&_list, &request->node);
+            request->active = true;
+        }
+        request->latency = latency;
+        nOS_LeaveCritical(sr);
+
+        err = NOS_OK;
+    }
+
+    return err;
+}
+
+nOS_Error nOS_PowerReleaseLatency (nOS_PowerRequest *request)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (request == NULL) {
+        err = NOS_E_INV_OBJ;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (!request->active) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        {
+            nOS_RemoveFromList(&_list, &request->node);
+            request->active = false;
+
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+#endif  /* NOS_CONFIG_POWER_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
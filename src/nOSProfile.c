@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2014-2016 Jim Tremblay
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#define NOS_PRIVATE
+#include "nOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if (NOS_CONFIG_CRITICAL_PROFILE_ENABLE > 0)
+/* Hooks are called by ports with interrupts masked, only for outermost critical section, so they can't nest. Last
+ * entry of table accumulate sections of sites that didn't fit. */
+static nOS_CriticalSite _sites[NOS_CONFIG_CRITICAL_PROFILE_SITES + 1];
+static uint8_t          _count;
+static const char       *_file;
+static uint32_t         _line;
+static uint32_t         _start;
+
+void nOS_ProfileEnterCritical (const char *file, uint32_t line)
+{
+    _file  = file;
+    _line  = line;
+    _start = (uint32_t)nOS_GetCycleCount();
+}
+
+void nOS_ProfileLeaveCritical (void)
+{
+    uint32_t            elapsed = (uint32_t)nOS_GetCycleCount() - _start;
+    nOS_CriticalSite    *site = NULL;
+    uint8_t             i;
+
+    for (i = 0; i < _count; i++) {
+        if ((_sites[i].line == _line) && (_sites[i].file == _file)) {
+            site = &_sites[i];
+            break;
+        }
+    }
+    if (site == NULL) {
+        if (_count < NOS_CONFIG_CRITICAL_PROFILE_SITES) {
+            site = &_sites[_count++];
+            site->file  = _file;
+            site->line  = _line;
+            site->count = 0;
+            site->max   = 0;
+        }
+        else {
+            site = &_sites[NOS_CONFIG_CRITICAL_PROFILE_SITES];
+        }
+    }
+    site->count++;
+    if (elapsed > site->max) {
+        site->max = elapsed;
+    }
+}
+
+uint8_t nOS_CriticalProfileRead (nOS_CriticalSite *sites, uint8_t max)
+{
+    nOS_StatusReg   sr;
+    uint8_t         n = 0;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (sites == NULL) {
+        n = 0;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+        while ((n < _count) && (n < max)) {
+            sites[n] = _sites[n];
+            n++;
+        }
+        if ((n < max) && (_sites[NOS_CONFIG_CRITICAL_PROFILE_SITES].count > 0)) {
+            sites[n] = _sites[NOS_CONFIG_CRITICAL_PROFILE_SITES];
+            n++;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return n;
+}
+
+void nOS_CriticalProfileReset (void)
+{
+    nOS_StatusReg   sr;
+
+    nOS_EnterCritical(sr);
+    _count = 0;
+    _sites[NOS_CONFIG_CRITICAL_PROFILE_SITES].file  = NULL;
+    _sites[NOS_CONFIG_CRITICAL_PROFILE_SITES].line  = 0;
+    _sites[NOS_CONFIG_CRITICAL_PROFILE_SITES].count = 0;
+    _sites[NOS_CONFIG_CRITICAL_PROFILE_SITES].max   = 0;
+    nOS_LeaveCritical(sr);
+}
+#endif  /* NOS_CONFIG_CRITICAL_PROFILE_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
@@ -14,29 +14,228 @@ extern "C" {
 #endif
 
 #if (NOS_CONFIG_QUEUE_ENABLE > 0)
+#if (NOS_CONFIG_QUEUE_POW2_ENABLE > 0)
+ #define _Wrap(q,i)                     ((nOS_QueueCounter)((i) & ((q)->bmax - 1)))
+#else
+ #define _Wrap(q,i)                     ((nOS_QueueCounter)((i) % (q)->bmax))
+#endif
+
+#if (NOS_CONFIG_QUEUE_ZERO_COPY_ENABLE > 0)
+/* Blocks written while some are reserved are readable only when all reserved blocks are committed, and blocks read
+ * while some are acquired are free only when all acquired blocks are released. Reserved/acquired blocks don't have
+ * to be committed/released in order and queue order is always kept. */
+ #define _GetFreeCount(q)               ((nOS_QueueCounter)((q)->bmax - (q)->bcount - (q)->bpend - (q)->bbusy))
+#else
+ #define _GetFreeCount(q)               ((nOS_QueueCounter)((q)->bmax - (q)->bcount))
+#endif
+#define _HasFreeBlock(q)                (_GetFreeCount(q) > 0)
+
+static void _Produce (nOS_Queue *queue, nOS_QueueCounter n)
+{
+    queue->w = _Wrap(queue, queue->w + n);
+#if (NOS_CONFIG_QUEUE_ZERO_COPY_ENABLE > 0)
+    if (queue->bres > 0) {
+        queue->bpend += n;
+    } else
+#endif
+    {
+        queue->bcount += n;
+    }
+#if (NOS_CONFIG_TASK_ENABLE > 0)
+    nOS_WakeUpTasks();
+#endif
+}
+
+static void _Consume (nOS_Queue *queue, nOS_QueueCounter n)
+{
+    queue->r = _Wrap(queue, queue->r + n);
+    queue->bcount -= n;
+#if (NOS_CONFIG_QUEUE_ZERO_COPY_ENABLE > 0)
+    if (queue->bacq > 0) {
+        queue->bbusy += n;
+    }
+#endif
+#if (NOS_CONFIG_TASK_ENABLE > 0)
+    nOS_WakeUpTasks();
+#endif
+}
+
 static void _Write (nOS_Queue *queue, void *block)
 {
     memcpy(&queue->buffer[(size_t)queue->w * (size_t)queue->bsize], block, queue->bsize);
-    queue->w = (queue->w + 1) % queue->bmax;
-    queue->bcount++;
+    _Produce(queue, 1);
 }
 
 static void _Read (nOS_Queue *queue, void *block)
 {
     memcpy(block, &queue->buffer[(size_t)queue->r * (size_t)queue->bsize], queue->bsize);
-    queue->r = (queue->r + 1) % queue->bmax;
-    queue->bcount--;
+    _Consume(queue, 1);
+}
+
+#if (NOS_CONFIG_QUEUE_MULTI_ENABLE > 0)
+/* Copy n blocks from w index, in two parts if they wrap at end of buffer */
+static void _WriteN (nOS_Queue *queue, uint8_t *blocks, nOS_QueueCounter n)
+{
+    nOS_QueueCounter    len = queue->bmax - queue->w;
+
+    if (len > n) {
+        len = n;
+    }
+    memcpy(&queue->buffer[(size_t)queue->w * (size_t)queue->bsize], blocks, (size_t)len * (size_t)queue->bsize);
+    if (len < n) {
+        memcpy(queue->buffer, &blocks[(size_t)len * (size_t)queue->bsize], (size_t)(n - len) * (size_t)queue->bsize);
+    }
+    _Produce(queue, n);
 }
 
+/* Copy n blocks from r index, in two parts if they wrap at end of buffer */
+static void _ReadN (nOS_Queue *queue, uint8_t *blocks, nOS_QueueCounter n)
+{
+    nOS_QueueCounter    len = queue->bmax - queue->r;
+
+    if (len > n) {
+        len = n;
+    }
+    memcpy(blocks, &queue->buffer[(size_t)queue->r * (size_t)queue->bsize], (size_t)len * (size_t)queue->bsize);
+    if (len < n) {
+        memcpy(&blocks[(size_t)len * (size_t)queue->bsize], queue->buffer, (size_t)(n - len) * (size_t)queue->bsize);
+    }
+    _Consume(queue, n);
+}
+#endif
+
 static void _Flush (nOS_Queue *queue)
 {
     queue->r = 0;
     queue->w = 0;
     queue->bcount = 0;
+#if (NOS_CONFIG_QUEUE_ZERO_COPY_ENABLE > 0)
+    queue->bres = 0;
+    queue->bacq = 0;
+    queue->bpend = 0;
+    queue->bbusy = 0;
+#endif
+#if (NOS_CONFIG_TASK_ENABLE > 0)
+    nOS_WakeUpTasks();
+#endif
+}
+
+#if (NOS_CONFIG_QUEUE_ZERO_COPY_ENABLE > 0)
+static void* _Reserve (nOS_Queue *queue)
+{
+    void    *block = &queue->buffer[(size_t)queue->w * (size_t)queue->bsize];
+
+    queue->bres++;
+    _Produce(queue, 1);
+
+    return block;
+}
+
+static void* _Acquire (nOS_Queue *queue)
+{
+    void    *block = &queue->buffer[(size_t)queue->r * (size_t)queue->bsize];
+
+    queue->bacq++;
+    _Consume(queue, 1);
+
+    return block;
+}
+
+#if (NOS_CONFIG_SAFE > 0)
+static nOS_Error _CheckBlock (nOS_Queue *queue, void *block)
+{
+    nOS_Error   err;
+
+    if ((uint8_t*)block < queue->buffer) {
+        /* Block pointer is out of range. */
+        err = NOS_E_INV_VAL;
+    }
+    else if ((uint8_t*)block >= &queue->buffer[(size_t)queue->bmax * (size_t)queue->bsize]) {
+        /* Block pointer is out of range. */
+        err = NOS_E_INV_VAL;
+    }
+    else if ((size_t)((uint8_t*)block - queue->buffer) % queue->bsize != 0) {
+        /* Block pointer is not a multiple of block size. */
+        err = NOS_E_INV_VAL;
+    }
+    else {
+        err = NOS_OK;
+    }
+
+    return err;
 }
+#endif
+
+/* Readers and writers can wait on queue at the same time when blocks are reserved or acquired */
+static nOS_Thread* _FindWaitingThread (nOS_Queue *queue, bool writing)
+{
+    nOS_Node        *it = queue->e.waitList.head;
+    nOS_Thread      *thread;
+    nOS_ThreadState state;
+
+    while (it != NULL) {
+        thread = nOS_GetNodeOwner(it, nOS_Thread, readyWait);
+        state = (nOS_ThreadState)(thread->state & NOS_THREAD_WAITING_MASK);
+        if (writing == ((state == NOS_THREAD_WRITING_QUEUE) || (state == NOS_THREAD_RESERVING_QUEUE))) {
+            return thread;
+        }
+        it = it->next;
+    }
+
+    return NULL;
+}
+#else
+ /* Only writers can wait on queue when it is not empty and only readers when it is empty */
+ #define _FindWaitingThread(q,w)        nOS_GetHeadOfList(&(q)->e.waitList, nOS_Thread, readyWait)
+#endif
+
+/* Called from critical section when one block is freed in queue */
+static nOS_Thread* _WakeUpWriter (nOS_Queue *queue)
+{
+    nOS_Thread  *thread = _FindWaitingThread(queue, true);
+
+    if (thread != NULL) {
+#if (NOS_CONFIG_QUEUE_ZERO_COPY_ENABLE > 0)
+        if ((thread->state & NOS_THREAD_WAITING_MASK) == NOS_THREAD_RESERVING_QUEUE) {
+            /* Give free block to thread waiting to reserve it */
+            *(void**)thread->ext = _Reserve(queue);
+        } else
+#endif
+        {
+            /* Write thread's block in queue */
+            _Write(queue, thread->ext);
+        }
+        nOS_WakeUpThread(thread, NOS_OK);
+    }
+
+    return thread;
+}
+
+#if (NOS_CONFIG_QUEUE_ZERO_COPY_ENABLE > 0)
+/* Called from critical section when one block is available to read in queue */
+static nOS_Thread* _WakeUpReader (nOS_Queue *queue)
+{
+    nOS_Thread  *thread = _FindWaitingThread(queue, false);
+
+    if (thread != NULL) {
+        if ((thread->state & NOS_THREAD_WAITING_MASK) == NOS_THREAD_ACQUIRING_QUEUE) {
+            /* Give stored block to thread waiting to acquire it */
+            *(void**)thread->ext = _Acquire(queue);
+        }
+        else {
+            /* Read block in thread's buffer, then a thread waiting to write can use the free block */
+            _Read(queue, thread->ext);
+            _WakeUpWriter(queue);
+        }
+        nOS_WakeUpThread(thread, NOS_OK);
+    }
+
+    return thread;
+}
+#endif
 
 /* Can create queue with block count at 0 to use it as pipe object (no buffer needed). */
-nOS_Error nOS_QueueCreate (nOS_Queue *queue, void *buffer, uint8_t bsize, nOS_QueueCounter bmax)
+nOS_Error nOS_QueueCreate (nOS_Queue *queue, void *buffer, nOS_QueueSize bsize, nOS_QueueCounter bmax)
 {
     nOS_Error       err;
     nOS_StatusReg   sr;
@@ -53,7 +252,14 @@ nOS_Error nOS_QueueCreate (nOS_Queue *queue, void *buffer, uint8_t bsize, nOS_Qu
     }
     else if ((buffer == NULL) && (bmax > 0)) {
         err = NOS_E_INV_VAL;
-    } else
+    }
+ #if (NOS_CONFIG_QUEUE_POW2_ENABLE > 0)
+    else if ((bmax & (bmax - 1)) != 0) {
+        /* Block count is not a power of 2 */
+        err = NOS_E_INV_VAL;
+    }
+ #endif
+    else
 #endif
     {
         nOS_EnterCritical(sr);
@@ -72,6 +278,9 @@ nOS_Error nOS_QueueCreate (nOS_Queue *queue, void *buffer, uint8_t bsize, nOS_Qu
             queue->bsize  = bsize;
             queue->bmax   = bmax;
             _Flush(queue);
+#if (NOS_CONFIG_QUEUE_OVERWRITE_ENABLE > 0)
+            queue->overwrite = false;
+#endif
 
             err = NOS_OK;
         }
@@ -104,6 +313,9 @@ nOS_Error nOS_QueueDelete (nOS_Queue *queue)
             queue->buffer = NULL;
             queue->bsize  = 0;
             queue->bmax   = 0;
+#if (NOS_CONFIG_QUEUE_OVERWRITE_ENABLE > 0)
+            queue->overwrite = false;
+#endif
             nOS_DeleteEvent((nOS_Event*)queue);
 
             err = NOS_OK;
@@ -140,10 +352,8 @@ nOS_Error nOS_QueueRead (nOS_Queue *queue, void *block, nOS_TickCounter timeout)
         if (queue->bcount > 0) {
             _Read(queue, block);
             /* Check if thread waiting to write in queue */
-            thread = nOS_SendEvent((nOS_Event*)queue, NOS_OK);
+            thread = _WakeUpWriter(queue);
             if (thread != NULL) {
-                /* Write thread's block in queue */
-                _Write(queue, thread->ext);
 #if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
                 /* Verify if a highest prio thread is ready to run */
                 nOS_Schedule();
@@ -225,11 +435,20 @@ nOS_Error nOS_QueueWrite (nOS_Queue *queue, void *block, nOS_TickCounter timeout
             err = NOS_E_INV_OBJ;
         } else
 #endif
-        /* If count equal 0, there are chances some threads can wait to read from queue */
-        if (queue->bcount == 0) {
-            /* Check if thread waiting to read from queue */
-            thread = nOS_SendEvent((nOS_Event*)queue, NOS_OK);
-            if (thread != NULL) {
+        {
+            /* If count equal 0, there are chances some threads can wait to read from queue */
+#if (NOS_CONFIG_QUEUE_ZERO_COPY_ENABLE > 0)
+            /* Written blocks can't bypass blocks not yet committed */
+            thread = ((queue->bcount == 0) && (queue->bpend == 0)) ? _FindWaitingThread(queue, false) : NULL;
+#else
+            thread = (queue->bcount == 0) ? _FindWaitingThread(queue, false) : NULL;
+#endif
+            if ((thread != NULL)
+#if (NOS_CONFIG_QUEUE_ZERO_COPY_ENABLE > 0)
+                && ((thread->state & NOS_THREAD_WAITING_MASK) == NOS_THREAD_READING_QUEUE)
+#endif
+               ) {
+                nOS_WakeUpThread(thread, NOS_OK);
                 /* Direct copy between thread's buffers */
                 memcpy(thread->ext, block, queue->bsize);
 #if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
@@ -238,28 +457,384 @@ nOS_Error nOS_QueueWrite (nOS_Queue *queue, void *block, nOS_TickCounter timeout
 #endif
                 err = NOS_OK;
             }
-            else if (queue->buffer != NULL) {
-                /* No thread waiting to read from queue, then store it */
+            else if (queue->buffer == NULL) {
+                /* No thread waiting to consume message, inform producer */
+                err = NOS_E_NO_CONSUMER;
+            }
+            else if (_HasFreeBlock(queue)) {
                 _Write(queue, block);
+#if (NOS_CONFIG_QUEUE_ZERO_COPY_ENABLE > 0)
+                if (thread != NULL) {
+                    /* Give stored block to thread waiting to acquire it */
+                    _WakeUpReader(queue);
+ #if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
+                    /* Verify if a highest prio thread is ready to run */
+                    nOS_Schedule();
+ #endif
+                }
+#endif
+#if (NOS_CONFIG_SELECT_ENABLE > 0)
+                if (queue->bcount > 0) {
+                    nOS_SignalSelect((nOS_Event*)queue, NOS_OK);
+                }
+#endif
                 err = NOS_OK;
             }
+#if (NOS_CONFIG_QUEUE_OVERWRITE_ENABLE > 0)
+            /* Acquired blocks are not in ring order anymore, oldest block can't be dropped until they are released */
+            else if (queue->overwrite && (queue->bcount > 0)
+ #if (NOS_CONFIG_QUEUE_ZERO_COPY_ENABLE > 0)
+                     && (queue->bacq == 0)
+ #endif
+                    ) {
+                /* Queue is full, so no thread can be waiting to read: drop oldest block and reuse its slot */
+                queue->r = _Wrap(queue, queue->r + 1);
+                queue->bcount--;
+                _Write(queue, block);
+                err = NOS_OK;
+            }
+#endif
+            else if (timeout == NOS_NO_WAIT) {
+                err = NOS_E_FULL;
+            }
             else {
+                nOS_runningThread->ext = block;
+                err = nOS_WaitForEvent((nOS_Event*)queue,
+                                       NOS_THREAD_WRITING_QUEUE
+#if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0)
+                                      ,timeout
+#elif (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
+                                      ,NOS_WAIT_INFINITE
+#endif
+                                      );
+            }
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+
+#if (NOS_CONFIG_QUEUE_MULTI_ENABLE > 0)
+nOS_Error nOS_QueueReadN (nOS_Queue *queue, void *blocks, nOS_QueueCounter n, nOS_QueueCounter *count, nOS_TickCounter timeout)
+{
+    nOS_Error           err;
+    nOS_StatusReg       sr;
+    nOS_QueueCounter    done = 0;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (queue == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (blocks == NULL) {
+        err = NOS_E_NULL;
+    }
+    else if (n == 0) {
+        err = NOS_E_INV_VAL;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (queue->e.type != NOS_EVENT_QUEUE) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        /* No chance a thread waiting to read from queue if count is higher than 0 */
+        if (queue->bcount > 0) {
+            done = (queue->bcount < n) ? queue->bcount : n;
+            _ReadN(queue, (uint8_t*)blocks, done);
+            /* Maybe some threads are waiting to write in queue */
+            while (_HasFreeBlock(queue) && (_WakeUpWriter(queue) != NULL));
+#if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
+            /* Verify if a highest prio thread is ready to run */
+            nOS_Schedule();
+#endif
+            err = NOS_OK;
+        }
+        else if (timeout == NOS_NO_WAIT) {
+            err = NOS_E_EMPTY;
+        }
+        else {
+            /* Wait for one block only */
+            nOS_runningThread->ext = blocks;
+            err = nOS_WaitForEvent((nOS_Event*)queue,
+                                   NOS_THREAD_READING_QUEUE
+#if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0)
+                                  ,timeout
+#elif (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
+                                  ,NOS_WAIT_INFINITE
+#endif
+                                  );
+            if (err == NOS_OK) {
+                done = 1;
+            }
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    if (count != NULL) {
+        *count = done;
+    }
+
+    return err;
+}
+
+nOS_Error nOS_QueueWriteN (nOS_Queue *queue, void *blocks, nOS_QueueCounter n, nOS_QueueCounter *count, nOS_TickCounter timeout)
+{
+    nOS_Error           err;
+    nOS_StatusReg       sr;
+    nOS_Thread          *thread;
+    nOS_QueueCounter    done = 0;
+    nOS_QueueCounter    len;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (queue == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (blocks == NULL) {
+        err = NOS_E_NULL;
+    }
+    else if (n == 0) {
+        err = NOS_E_INV_VAL;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (queue->e.type != NOS_EVENT_QUEUE) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        {
+            /* If count equal 0, there are chances some threads can wait to read from queue */
+            while ((done < n) && (queue->bcount == 0)
+#if (NOS_CONFIG_QUEUE_ZERO_COPY_ENABLE > 0)
+                   /* Written blocks can't bypass blocks not yet committed */
+                   && (queue->bpend == 0)
+#endif
+                  ) {
+                thread = _FindWaitingThread(queue, false);
+                if (thread == NULL) {
+                    break;
+                }
+#if (NOS_CONFIG_QUEUE_ZERO_COPY_ENABLE > 0)
+                /* Thread waiting to acquire block will get it from queue buffer */
+                if ((thread->state & NOS_THREAD_WAITING_MASK) == NOS_THREAD_ACQUIRING_QUEUE) {
+                    break;
+                }
+#endif
+                nOS_WakeUpThread(thread, NOS_OK);
+                /* Direct copy between thread's buffers */
+                memcpy(thread->ext, &((uint8_t*)blocks)[(size_t)done * (size_t)queue->bsize], queue->bsize);
+                done++;
+            }
+            /* Store remaining blocks in free space of queue */
+            if ((done < n) && (queue->buffer != NULL)) {
+                len = _GetFreeCount(queue);
+                if (len > (n - done)) {
+                    len = n - done;
+                }
+                if (len > 0) {
+                    _WriteN(queue, &((uint8_t*)blocks)[(size_t)done * (size_t)queue->bsize], len);
+                    done += len;
+#if (NOS_CONFIG_QUEUE_ZERO_COPY_ENABLE > 0)
+                    /* Maybe some threads are waiting to acquire blocks from queue */
+                    while ((queue->bcount > 0) && (_WakeUpReader(queue) != NULL));
+#endif
+#if (NOS_CONFIG_SELECT_ENABLE > 0)
+                    if (queue->bcount > 0) {
+                        nOS_SignalSelect((nOS_Event*)queue, NOS_OK);
+                    }
+#endif
+                }
+            }
+
+            if (done > 0) {
+#if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
+                /* Verify if a highest prio thread is ready to run */
+                nOS_Schedule();
+#endif
+                err = NOS_OK;
+            }
+            else if (queue->buffer == NULL) {
                 /* No thread waiting to consume message, inform producer */
                 err = NOS_E_NO_CONSUMER;
             }
+            else if (timeout == NOS_NO_WAIT) {
+                err = NOS_E_FULL;
+            }
+            else {
+                /* Wait for one block only */
+                nOS_runningThread->ext = blocks;
+                err = nOS_WaitForEvent((nOS_Event*)queue,
+                                       NOS_THREAD_WRITING_QUEUE
+#if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0)
+                                      ,timeout
+#elif (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
+                                      ,NOS_WAIT_INFINITE
+#endif
+                                      );
+                if (err == NOS_OK) {
+                    done = 1;
+                }
+            }
         }
-        else if (queue->bcount < queue->bmax) {
-            /* No chance a thread waiting to read from queue if count is higher than 0 */
-            _Write(queue, block);
+        nOS_LeaveCritical(sr);
+    }
+
+    if (count != NULL) {
+        *count = done;
+    }
+
+    return err;
+}
+#endif
+
+#if (NOS_CONFIG_QUEUE_ZERO_COPY_ENABLE > 0)
+nOS_Error nOS_QueueWriteReserve (nOS_Queue *queue, void **block, nOS_TickCounter timeout)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (queue == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (block == NULL) {
+        err = NOS_E_NULL;
+    } else
+#endif
+    {
+        *block = NULL;
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (queue->e.type != NOS_EVENT_QUEUE) {
+            err = NOS_E_INV_OBJ;
+        }
+        else if (queue->buffer == NULL) {
+            /* Pipe doesn't have blocks to reserve */
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        if (_HasFreeBlock(queue)) {
+            *block = _Reserve(queue);
             err = NOS_OK;
         }
         else if (timeout == NOS_NO_WAIT) {
             err = NOS_E_FULL;
         }
         else {
+            /* Free block will be reserved for running thread by consumer */
+            nOS_runningThread->ext = block;
+            err = nOS_WaitForEvent((nOS_Event*)queue,
+                                   NOS_THREAD_RESERVING_QUEUE
+#if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0)
+                                  ,timeout
+#elif (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
+                                  ,NOS_WAIT_INFINITE
+#endif
+                                  );
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+
+nOS_Error nOS_QueueWriteCommit (nOS_Queue *queue, void *block)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (queue == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (block == NULL) {
+        err = NOS_E_NULL;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (queue->e.type != NOS_EVENT_QUEUE) {
+            err = NOS_E_INV_OBJ;
+        }
+        else if (queue->bres == 0) {
+            /* No block has been reserved */
+            err = NOS_E_OVERFLOW;
+        }
+        else if (_CheckBlock(queue, block) != NOS_OK) {
+            err = NOS_E_INV_VAL;
+        } else
+#endif
+        {
+            queue->bres--;
+            if (queue->bres == 0) {
+                /* All reserved blocks are written, make pending blocks readable */
+                queue->bcount += queue->bpend;
+                queue->bpend = 0;
+                /* Maybe some threads are waiting to read from queue */
+                while ((queue->bcount > 0) && (_WakeUpReader(queue) != NULL));
+ #if (NOS_CONFIG_SELECT_ENABLE > 0)
+                if (queue->bcount > 0) {
+                    nOS_SignalSelect((nOS_Event*)queue, NOS_OK);
+                }
+ #endif
+#if (NOS_CONFIG_TASK_ENABLE > 0)
+                nOS_WakeUpTasks();
+#endif
+#if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
+                /* Verify if a highest prio thread is ready to run */
+                nOS_Schedule();
+#endif
+            }
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+
+nOS_Error nOS_QueueReadAcquire (nOS_Queue *queue, void **block, nOS_TickCounter timeout)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (queue == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (block == NULL) {
+        err = NOS_E_NULL;
+    } else
+#endif
+    {
+        *block = NULL;
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (queue->e.type != NOS_EVENT_QUEUE) {
+            err = NOS_E_INV_OBJ;
+        }
+        else if (queue->buffer == NULL) {
+            /* Pipe doesn't have blocks to acquire */
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        if (queue->bcount > 0) {
+            *block = _Acquire(queue);
+            err = NOS_OK;
+        }
+        else if (timeout == NOS_NO_WAIT) {
+            err = NOS_E_EMPTY;
+        }
+        else {
+            /* Stored block will be acquired for running thread by producer */
             nOS_runningThread->ext = block;
             err = nOS_WaitForEvent((nOS_Event*)queue,
-                                   NOS_THREAD_WRITING_QUEUE
+                                   NOS_THREAD_ACQUIRING_QUEUE
 #if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0)
                                   ,timeout
 #elif (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
@@ -273,6 +848,91 @@ nOS_Error nOS_QueueWrite (nOS_Queue *queue, void *block, nOS_TickCounter timeout
     return err;
 }
 
+nOS_Error nOS_QueueReadRelease (nOS_Queue *queue, void *block)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (queue == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (block == NULL) {
+        err = NOS_E_NULL;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (queue->e.type != NOS_EVENT_QUEUE) {
+            err = NOS_E_INV_OBJ;
+        }
+        else if (queue->bacq == 0) {
+            /* No block has been acquired */
+            err = NOS_E_OVERFLOW;
+        }
+        else if (_CheckBlock(queue, block) != NOS_OK) {
+            err = NOS_E_INV_VAL;
+        } else
+#endif
+        {
+            queue->bacq--;
+            if (queue->bacq == 0) {
+                /* All acquired blocks are read, free busy blocks */
+                queue->bbusy = 0;
+                /* Maybe some threads are waiting to write in queue */
+                while (_HasFreeBlock(queue) && (_WakeUpWriter(queue) != NULL));
+#if (NOS_CONFIG_TASK_ENABLE > 0)
+                nOS_WakeUpTasks();
+#endif
+#if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
+                /* Verify if a highest prio thread is ready to run */
+                nOS_Schedule();
+#endif
+            }
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+#endif
+
+#if (NOS_CONFIG_QUEUE_OVERWRITE_ENABLE > 0)
+nOS_Error nOS_QueueSetOverwrite (nOS_Queue *queue, bool overwrite)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (queue == NULL) {
+        err = NOS_E_INV_OBJ;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (queue->e.type != NOS_EVENT_QUEUE) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        if (queue->buffer == NULL) {
+            /* Pipe has no block to drop */
+            err = NOS_E_INV_VAL;
+        }
+        else {
+            queue->overwrite = overwrite;
+
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+#endif
+
 nOS_Error nOS_QueueFlush (nOS_Queue *queue, nOS_QueueCallback callback)
 {
     nOS_Error       err;
@@ -297,12 +957,16 @@ nOS_Error nOS_QueueFlush (nOS_Queue *queue, nOS_QueueCallback callback)
                     /* ... call user's callback for every stored block */
                     while (queue->bcount > 0) {
                         callback(queue, &queue->buffer[(size_t)queue->r * (size_t)queue->bsize]);
-                        queue->r = (queue->r + 1) % queue->bmax;
-                        queue->bcount--;
+                        _Consume(queue, 1);
                     }
                 }
                 else {
+#if (NOS_CONFIG_QUEUE_ZERO_COPY_ENABLE > 0)
+                    /* Keep reserved and acquired blocks */
+                    _Consume(queue, queue->bcount);
+#else
                     _Flush(queue);
+#endif
                 }
                 /* maybe some threads are waiting to write in queue */
                 nOS_BroadcastEvent((nOS_Event*)queue, NOS_E_FLUSHED);
@@ -360,8 +1024,8 @@ bool nOS_QueueIsFull (nOS_Queue *queue)
 #endif
         {
             full = queue->buffer != NULL ?
-                        queue->bcount == queue->bmax :
-                        nOS_GetHeadOfList(&queue->e.waitList) != NULL ?  /* A thread can be ready to consume message */
+                        !_HasFreeBlock(queue) :
+                        nOS_GetHeadOfList(&queue->e.waitList, nOS_Thread, readyWait) != NULL ?  /* A thread can be ready to consume message */
                             false :
                             true;
         }
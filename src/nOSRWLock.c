@@ -0,0 +1,463 @@
+/*
+ * Copyright (c) 2014-2016 Jim Tremblay
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#define NOS_PRIVATE
+#include "nOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if (NOS_CONFIG_RWLOCK_ENABLE > 0)
+/* Waiting threads are readers or writers, ext of each waiting thread point to a bool set to true for writers. Readers
+ * can only wait when lock is owned by a writer or when a writer is already waiting, so new readers can't starve
+ * waiting writers. */
+#define _IsWriter(t)                    (*(bool*)(t)->ext)
+
+#if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
+static void _TestPrioHighest (void *node, void *arg)
+{
+    nOS_Thread      *thread  = nOS_GetNodeOwner((nOS_Node*)node, nOS_Thread, readyWait);
+    uint8_t         *prio    = (uint8_t*)arg;
+
+    if (*prio < thread->prio) {
+        *prio = thread->prio;
+    }
+}
+#endif
+
+/* Called from critical section, return first writer in waiting list or NULL if only readers are waiting */
+static nOS_Thread* _FindWriterWaiting (nOS_RWLock *rwlock)
+{
+    nOS_Node        *it = rwlock->e.waitList.head;
+    nOS_Thread      *writer = NULL;
+
+    while ((it != NULL) && (writer == NULL)) {
+        if (_IsWriter(nOS_GetNodeOwner(it, nOS_Thread, readyWait))) {
+            writer = nOS_GetNodeOwner(it, nOS_Thread, readyWait);
+        }
+        it = it->next;
+    }
+
+    return writer;
+}
+
+/* Called from critical section, give ownership of the lock to given thread */
+static void _SetOwner (nOS_RWLock *rwlock, nOS_Thread *thread)
+{
+#if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
+    uint8_t         prio;
+#endif
+
+    rwlock->owner = thread;
+#if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
+    rwlock->backup = thread->prio;
+    if (rwlock->prio != NOS_RWLOCK_PRIO_INHERIT) {
+        if (thread->prio < rwlock->prio) {
+            nOS_SetThreadPrio(thread, rwlock->prio);
+        }
+    }
+    /* New writer inherit highest prio of threads still waiting behind it */
+    else if (rwlock->e.waitList.head != NULL) {
+        prio = 0;
+        nOS_WalkInList(&rwlock->e.waitList, _TestPrioHighest, &prio);
+        if (thread->prio < prio) {
+            nOS_SetThreadPrio(thread, prio);
+        }
+    }
+#endif
+}
+
+/* Called from critical section when lock is not owned by a writer, return true if waiting threads have been woken up.
+ * First waiting writer is preferred and get the lock when last reader leave it, else all waiting readers are let in
+ * at once. */
+static bool _Release (nOS_RWLock *rwlock)
+{
+    nOS_Thread      *writer = _FindWriterWaiting(rwlock);
+    nOS_List        list;
+    nOS_Node        *it;
+    bool            woken = false;
+
+    if (writer != NULL) {
+        if (rwlock->readers == 0) {
+            nOS_WakeUpThread(writer, NOS_OK);
+            _SetOwner(rwlock, writer);
+            woken = true;
+        }
+    }
+    else if (rwlock->e.waitList.head != NULL) {
+        /* Only readers are waiting, count them before waking up all of them */
+        for (it = rwlock->e.waitList.head; it != NULL; it = it->next) {
+            rwlock->readers++;
+        }
+        list = rwlock->e.waitList;
+        nOS_InitList(&rwlock->e.waitList);
+        nOS_WakeUpThreads(&list, NOS_OK);
+        woken = true;
+    }
+
+    return woken;
+}
+
+nOS_Error nOS_RWLockCreate (nOS_RWLock *rwlock
+#if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
+                           ,uint8_t prio
+#endif
+                           )
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (rwlock == NULL) {
+        err = NOS_E_INV_OBJ;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (rwlock->e.type != NOS_EVENT_INVALID) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        {
+            nOS_CreateEvent((nOS_Event*)rwlock
+#if (NOS_CONFIG_SAFE > 0)
+                           ,NOS_EVENT_RWLOCK
+#endif
+                           );
+            rwlock->owner = NULL;
+            rwlock->readers = 0;
+#if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
+            rwlock->prio = prio;
+            rwlock->backup = 0;
+#endif
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+
+#if (NOS_CONFIG_RWLOCK_DELETE_ENABLE > 0)
+nOS_Error nOS_RWLockDelete (nOS_RWLock *rwlock)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (rwlock == NULL) {
+        err = NOS_E_INV_OBJ;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (rwlock->e.type != NOS_EVENT_RWLOCK) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        {
+            rwlock->owner = NULL;
+            rwlock->readers = 0;
+            nOS_DeleteEvent((nOS_Event*)rwlock);
+
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+#endif
+
+nOS_Error nOS_RWLockReadLock (nOS_RWLock *rwlock, nOS_TickCounter timeout)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+    bool            writer = false;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (rwlock == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (nOS_isrNestingCounter > 0) {
+        /* Can't lock rwlock from ISR */
+        err = NOS_E_ISR;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (rwlock->e.type != NOS_EVENT_RWLOCK) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        if ((rwlock->owner == NULL) && (rwlock->e.waitList.head == NULL)) {
+            /* Not owned by a writer and no writer waiting? Add calling thread to readers */
+            if (rwlock->readers < NOS_RWLOCK_COUNT_MAX) {
+                rwlock->readers++;
+                err = NOS_OK;
+            }
+            else {
+                err = NOS_E_OVERFLOW;
+            }
+        }
+        else if (rwlock->owner == nOS_runningThread) {
+            /* Writer can't read its own lock, it would wait forever */
+            err = NOS_E_OVERFLOW;
+        }
+        else {
+#if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
+            if ((rwlock->owner != NULL) && (rwlock->prio == NOS_RWLOCK_PRIO_INHERIT)) {
+                if (rwlock->owner->prio < nOS_runningThread->prio) {
+                    nOS_SetThreadPrio(rwlock->owner, nOS_runningThread->prio);
+                }
+            }
+#endif
+
+            if (timeout == NOS_NO_WAIT) {
+                /* Calling thread can't wait? Try again. */
+                err = NOS_E_AGAIN;
+            }
+            else {
+                /* Calling thread must wait on rwlock, it will be added to readers when woken up. */
+                nOS_runningThread->ext = &writer;
+                err = nOS_WaitForEvent((nOS_Event*)rwlock,
+                                       NOS_THREAD_LOCKING_RWLOCK
+#if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0)
+                                      ,timeout
+#elif (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
+                                      ,NOS_WAIT_INFINITE
+#endif
+                                      );
+            }
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+
+nOS_Error nOS_RWLockReadUnlock (nOS_RWLock *rwlock)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (rwlock == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (nOS_isrNestingCounter > 0) {
+        /* Can't unlock rwlock from ISR */
+        err = NOS_E_ISR;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (rwlock->e.type != NOS_EVENT_RWLOCK) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        if (rwlock->readers == 0) {
+            err = NOS_E_UNDERFLOW;
+        }
+        else {
+            rwlock->readers--;
+            if (rwlock->readers == 0) {
+                if (_Release(rwlock)) {
+#if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0) && (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
+                    /* Verify if a highest prio thread is ready to run */
+                    nOS_Schedule();
+#endif
+                }
+            }
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+
+nOS_Error nOS_RWLockWriteLock (nOS_RWLock *rwlock, nOS_TickCounter timeout)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+    bool            writer = true;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (rwlock == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (nOS_isrNestingCounter > 0) {
+        /* Can't lock rwlock from ISR */
+        err = NOS_E_ISR;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (rwlock->e.type != NOS_EVENT_RWLOCK) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        if ((rwlock->owner == NULL) && (rwlock->readers == 0)) {
+            /* RWLock available? Reserve it for calling thread */
+            _SetOwner(rwlock, nOS_runningThread);
+            err = NOS_OK;
+        }
+        else if (rwlock->owner == nOS_runningThread) {
+            /* Can't lock multiple times */
+            err = NOS_E_OVERFLOW;
+        }
+        else {
+#if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
+            /* Only a writer owner can inherit prio, readers are not tracked */
+            if ((rwlock->owner != NULL) && (rwlock->prio == NOS_RWLOCK_PRIO_INHERIT)) {
+                if (rwlock->owner->prio < nOS_runningThread->prio) {
+                    nOS_SetThreadPrio(rwlock->owner, nOS_runningThread->prio);
+                }
+            }
+#endif
+
+            if (timeout == NOS_NO_WAIT) {
+                /* Calling thread can't wait? Try again. */
+                err = NOS_E_AGAIN;
+            }
+            else {
+                /* Calling thread must wait on rwlock, it will be the owner when woken up. */
+                nOS_runningThread->ext = &writer;
+                err = nOS_WaitForEvent((nOS_Event*)rwlock,
+                                       NOS_THREAD_LOCKING_RWLOCK
+#if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0)
+                                      ,timeout
+#elif (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
+                                      ,NOS_WAIT_INFINITE
+#endif
+                                      );
+                /* Readers that was waiting behind calling thread can have to be let in now */
+                if ((err != NOS_OK) && (rwlock->owner == NULL)) {
+                    if (_Release(rwlock)) {
+#if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0) && (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
+                        /* Verify if a highest prio thread is ready to run */
+                        nOS_Schedule();
+#endif
+                    }
+                }
+            }
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+
+nOS_Error nOS_RWLockWriteUnlock (nOS_RWLock *rwlock)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (rwlock == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (nOS_isrNestingCounter > 0) {
+        /* Can't unlock rwlock from ISR */
+        err = NOS_E_ISR;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (rwlock->e.type != NOS_EVENT_RWLOCK) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        if (rwlock->owner == NULL) {
+            err = NOS_E_UNDERFLOW;
+        }
+        else if (rwlock->owner != nOS_runningThread) {
+            err = NOS_E_OWNER;
+        }
+        else {
+#if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
+            nOS_SetThreadPrio(rwlock->owner, rwlock->backup);
+#endif
+            rwlock->owner = NULL;
+            _Release(rwlock);
+#if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0) && (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
+            /* Verify if a highest prio thread is ready to run */
+            nOS_Schedule();
+#endif
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+
+nOS_RWLockCounter nOS_RWLockGetReaders (nOS_RWLock *rwlock)
+{
+    nOS_StatusReg       sr;
+    nOS_RWLockCounter   readers;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (rwlock == NULL) {
+        readers = 0;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (rwlock->e.type != NOS_EVENT_RWLOCK) {
+            readers = 0;
+        } else
+#endif
+        {
+            readers = rwlock->readers;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return readers;
+}
+
+nOS_Thread* nOS_RWLockGetOwner (nOS_RWLock *rwlock)
+{
+    nOS_StatusReg   sr;
+    nOS_Thread      *owner;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (rwlock == NULL) {
+        owner = NULL;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (rwlock->e.type != NOS_EVENT_RWLOCK) {
+            owner = NULL;
+        } else
+#endif
+        {
+            owner = rwlock->owner;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return owner;
+}
+#endif  /* NOS_CONFIG_RWLOCK_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
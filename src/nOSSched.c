@@ -14,380 +14,181 @@
 extern "C" {
 #endif
 
-#if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
- #ifdef NOS_32_BITS_SCHEDULER
-  #if (NOS_CONFIG_HIGHEST_THREAD_PRIO < 32)
-   static uint32_t              _readyThreadByPrio;
-  #elif (NOS_CONFIG_HIGHEST_THREAD_PRIO < 256)
-   static uint32_t              _readyThreadByGroup;
-   static uint32_t              _readyThreadByPrio[((NOS_CONFIG_HIGHEST_THREAD_PRIO+31)/32)];
-  #endif
-  #ifndef NOS_USE_CLZ
-   static NOS_CONST uint8_t     _tableDeBruijn[32] = {
-       0, 9, 1, 10, 13, 21, 2, 29, 11, 14, 16, 18, 22, 25, 3, 30,
-       8, 12, 20, 28, 15, 17, 24, 7, 19, 27, 23, 6, 26, 5, 4, 31
-   };
-  #endif
- #elif defined(NOS_16_BITS_SCHEDULER)
-  #if (NOS_CONFIG_HIGHEST_THREAD_PRIO < 16)
-   static uint16_t              _readyThreadByPrio;
-  #elif (NOS_CONFIG_HIGHEST_THREAD_PRIO < 256)
-   static uint16_t              _readyThreadByGroup;
-   static uint16_t              _readyThreadByPrio[((NOS_CONFIG_HIGHEST_THREAD_PRIO+15)/16)];
-  #endif
-  static NOS_CONST uint8_t      _tableDeBruijn[16] = {
-      0, 7, 1, 13, 8, 10, 2, 14, 6, 12, 9, 5, 11, 4, 3, 15
-  };
- #else
-  #if (NOS_CONFIG_HIGHEST_THREAD_PRIO < 8)
-   static uint8_t               _readyThreadByPrio;
-   static NOS_CONST uint8_t     _tableDeBruijn[8] = {
-       0, 5, 1, 6, 4, 3, 2, 7
-   };
-  #elif (NOS_CONFIG_HIGHEST_THREAD_PRIO < 16)
-   static uint16_t              _readyThreadByPrio;
-   static NOS_CONST uint8_t     _tableDeBruijn[16] = {
-       0, 7, 1, 13, 8, 10, 2, 14, 6, 12, 9, 5, 11, 4, 3, 15
-   };
-  #elif (NOS_CONFIG_HIGHEST_THREAD_PRIO < 64)
-   static uint8_t               _readyThreadByGroup;
-   static uint8_t               _readyThreadByPrio[((NOS_CONFIG_HIGHEST_THREAD_PRIO+7)/8)];
-   static NOS_CONST uint8_t     _tableDeBruijn[8] = {
-       0, 5, 1, 6, 4, 3, 2, 7
-   };
-  #elif (NOS_CONFIG_HIGHEST_THREAD_PRIO < 256)
-   static uint16_t              _readyThreadByGroup;
-   static uint16_t              _readyThreadByPrio[((NOS_CONFIG_HIGHEST_THREAD_PRIO+15)/16)];
-   static NOS_CONST uint8_t     _tableDeBruijn[16] = {
-       0, 7, 1, 13, 8, 10, 2, 14, 6, 12, 9, 5, 11, 4, 3, 15
-   };
-  #endif
- #endif
+#if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+ /* Each core has its own ready bitmaps */
+ #define _CORE_DIM                      [NOS_CONFIG_SMP_CORE_COUNT]
+#else
+ #define _CORE_DIM
 #endif
 
 #if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
- #ifdef NOS_32_BITS_SCHEDULER
-  #ifdef NOS_USE_CLZ
-   #if (NOS_CONFIG_HIGHEST_THREAD_PRIO < 32)
-    nOS_Thread* nOS_FindHighPrioThread(void)
-    {
-        uint32_t    prio;
+ NOS_FAST_DATA static nOS_BitmapWord _readyThreadBitmap _CORE_DIM[NOS_BITMAP_SIZE(NOS_CONFIG_HIGHEST_THREAD_PRIO)];
+#endif
 
-        prio = (31 - _CLZ(_readyThreadByPrio));
+#if (NOS_CONFIG_TICK_COUNT_LOCK_FREE_ENABLE > 0)
+ static volatile uint8_t        _tickSeq;
+ static nOS_TickCounter         _tickCopy[2];
+#endif
 
-        return (nOS_Thread*)nOS_readyThreadsList[prio].head->payload;
-    }
-   #elif (NOS_CONFIG_HIGHEST_THREAD_PRIO < 256)
-    nOS_Thread* nOS_FindHighPrioThread(void)
-    {
-        uint32_t    group;
-        uint32_t    prio;
+#if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+ /* Ready threads of core of caller are searched */
+ #define _readyThreadBitmap             _readyThreadBitmap[nOS_GetCoreId()]
+#endif
 
-        group   = (31 - _CLZ(_readyThreadByGroup));
-        prio    = (31 - _CLZ(_readyThreadByPrio[group]));
+#if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
+ NOS_FAST_CODE nOS_Thread* nOS_FindHighPrioThread(void)
+ {
+     return nOS_GetNodeOwner(nOS_readyThreadsList[nOS_GetHighestPrioInBitmap(_readyThreadBitmap)].head, nOS_Thread,
+                             readyWait);
+ }
+
+ #if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+  /* Thread is added to or removed from ready lists of its own core */
+  #undef  _readyThreadBitmap
+  #undef  nOS_readyThreadsList
+  #define _readyThreadBitmap            _readyThreadBitmap[thread->core]
+  #define nOS_readyThreadsList          nOS_readyThreadsLists[thread->core]
+
+  /* Called from critical section when ready list of another core is modified, request this core to reschedule if
+   * thread can preempt its running thread or if it is its running thread */
+  static void _SignalCore (nOS_Thread *thread)
+  {
+      nOS_Thread  *running = nOS_runningThreads[thread->core];
 
-        return (nOS_Thread*)nOS_readyThreadsList[(group << 5) | prio].head->payload;
-    }
-   #endif
+      /* Other cores are started by nOS_Start */
+      if (nOS_running && (thread->core != nOS_GetCoreId())) {
+  #if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
+          if ((thread == running) || (thread->prio > running->prio))
   #else
-   #if (NOS_CONFIG_HIGHEST_THREAD_PRIO < 32)
-    nOS_Thread* nOS_FindHighPrioThread(void)
-    {
-        uint32_t    prio;
-
-        prio = _readyThreadByPrio;
-        prio |= prio >> 1; // first round down to one less than a power of 2
-        prio |= prio >> 2;
-        prio |= prio >> 4;
-        prio |= prio >> 8;
-        prio |= prio >> 16;
-        prio = (uint32_t)_tableDeBruijn[(uint32_t)(prio * 0x07c4acddUL) >> 27];
-
-        return (nOS_Thread*)nOS_readyThreadsList[prio].head->payload;
-    }
-   #elif (NOS_CONFIG_HIGHEST_THREAD_PRIO < 256)
-    nOS_Thread* nOS_FindHighPrioThread(void)
-    {
-        uint32_t    group;
-        uint32_t    prio;
-
-        group = _readyThreadByGroup;
-        group |= group >> 1;
-        group |= group >> 2;
-        group |= group >> 4;
-        group |= group >> 8;
-        group |= group >> 16;
-        group = (uint32_t)_tableDeBruijn[(uint32_t)(group * 0x07c4acddUL) >> 27];
-
-        prio = _readyThreadByPrio[group];
-        prio |= prio >> 1; // first round down to one less than a power of 2
-        prio |= prio >> 2;
-        prio |= prio >> 4;
-        prio |= prio >> 8;
-        prio |= prio >> 16;
-        prio = (uint32_t)_tableDeBruijn[(uint32_t)(prio * 0x07c4acddUL) >> 27];
-
-        return (nOS_Thread*)nOS_readyThreadsList[(group << 5) | prio].head->payload;
-    }
-   #endif
-  #endif
- #elif defined(NOS_16_BITS_SCHEDULER)
-  #if (NOS_CONFIG_HIGHEST_THREAD_PRIO < 16)
-   nOS_Thread* nOS_FindHighPrioThread(void)
-   {
-       uint16_t    prio;
-
-       prio = _readyThreadByPrio;
-       prio |= prio >> 1; // first round down to one less than a power of 2
-       prio |= prio >> 2;
-       prio |= prio >> 4;
-       prio |= prio >> 8;
-       prio = (uint16_t)_tableDeBruijn[(uint16_t)(prio * 0xf2d) >> 12];
-
-       return (nOS_Thread*)nOS_readyThreadsList[prio].head->payload;
-   }
-  #elif (NOS_CONFIG_HIGHEST_THREAD_PRIO < 256)
-   nOS_Thread* nOS_FindHighPrioThread(void)
-   {
-       uint16_t    group;
-       uint16_t    prio;
-
-       group = _readyThreadByGroup;
-       group |= group >> 1; // first round down to one less than a power of 2
-       group |= group >> 2;
-       group |= group >> 4;
-       group |= group >> 8;
-       group = (uint16_t)_tableDeBruijn[(uint16_t)(group * 0xf2d) >> 12];
-
-       prio = _readyThreadByPrio[group];
-       prio |= prio >> 1; // first round down to one less than a power of 2
-       prio |= prio >> 2;
-       prio |= prio >> 4;
-       prio |= prio >> 8;
-       prio = (uint16_t)_tableDeBruijn[(uint16_t)(prio * 0xf2d) >> 12];
-
-       return (nOS_Thread*)nOS_readyThreadsList[(group << 4) | prio].head->payload;
-   }
+          if ((thread == running) || (running == &nOS_idleHandles[thread->core]))
   #endif
- #else
-  #if (NOS_CONFIG_HIGHEST_THREAD_PRIO < 8)
-   nOS_Thread* nOS_FindHighPrioThread(void)
-   {
-       uint8_t prio;
-
-       prio = _readyThreadByPrio;
-       prio |= prio >> 1; // first round down to one less than a power of 2
-       prio |= prio >> 2;
-       prio |= prio >> 4;
-       prio = (uint8_t)_tableDeBruijn[(uint8_t)(prio * 0x1d) >> 5];
-
-       return (nOS_Thread*)nOS_readyThreadsList[prio].head->payload;
-   }
-  #elif (NOS_CONFIG_HIGHEST_THREAD_PRIO < 16)
-   nOS_Thread* nOS_FindHighPrioThread(void)
-   {
-       uint16_t    prio;
-
-       prio = _readyThreadByPrio;
-       prio |= prio >> 1; // first round down to one less than a power of 2
-       prio |= prio >> 2;
-       prio |= prio >> 4;
-       prio |= prio >> 8;
-       prio = (uint16_t)_tableDeBruijn[(uint16_t)(prio * 0xf2d) >> 12];
-
-       return (nOS_Thread*)nOS_readyThreadsList[prio].head->payload;
-   }
-  #elif (NOS_CONFIG_HIGHEST_THREAD_PRIO < 64)
-   nOS_Thread* nOS_FindHighPrioThread(void)
-   {
-       uint8_t     group;
-       uint8_t     prio;
-
-       group = _readyThreadByGroup;
-       group |= group >> 1; // first round down to one less than a power of 2
-       group |= group >> 2;
-       group |= group >> 4;
-       group = (uint8_t)_tableDeBruijn[(uint8_t)(group * 0x1d) >> 5];
-
-       prio = _readyThreadByPrio[group];
-       prio |= prio >> 1; // first round down to one less than a power of 2
-       prio |= prio >> 2;
-       prio |= prio >> 4;
-       prio = (uint8_t)_tableDeBruijn[(uint8_t)(prio * 0x1d) >> 5];
+          {
+              nOS_ScheduleCore(thread->core);
+          }
+      }
+  }
 
-       return (nOS_Thread*)nOS_readyThreadsList[(group << 3) | prio].head->payload;
-   }
-  #elif (NOS_CONFIG_HIGHEST_THREAD_PRIO < 256)
-   nOS_Thread* nOS_FindHighPrioThread(void)
+  #if (NOS_CONFIG_SMP_WORK_STEALING_ENABLE > 0)
+   /* Called from critical section when a thread is made ready, if it is migratable and have to wait behind running
+    * thread of its core, request first idle core found to reschedule, it will steal it */
+   static void _OfferThread (nOS_Thread *thread)
    {
-       uint16_t    group;
-       uint16_t    prio;
-
-       group = _readyThreadByGroup;
-       group |= group >> 1; // first round down to one less than a power of 2
-       group |= group >> 2;
-       group |= group >> 4;
-       group |= group >> 8;
-       group = (uint16_t)_tableDeBruijn[(uint16_t)(group * 0xf2d) >> 12];
-
-       prio = _readyThreadByPrio[group];
-       prio |= prio >> 1; // first round down to one less than a power of 2
-       prio |= prio >> 2;
-       prio |= prio >> 4;
-       prio |= prio >> 8;
-       prio = (uint16_t)_tableDeBruijn[(uint16_t)(prio * 0xf2d) >> 12];
-
-       return (nOS_Thread*)nOS_readyThreadsList[(group << 4) | prio].head->payload;
+       nOS_Thread  *running = nOS_runningThreads[thread->core];
+       uint8_t     c;
+
+       if (nOS_running && thread->migratable && (thread != running)) {
+   #if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
+           if (thread->prio <= running->prio)
+   #else
+           if (running != &nOS_idleHandles[thread->core])
+   #endif
+           {
+               for (c = 0; c < NOS_CONFIG_SMP_CORE_COUNT; c++) {
+                   if ((c != thread->core) && (c != nOS_GetCoreId()) && (nOS_runningThreads[c] == &nOS_idleHandles[c])) {
+                       nOS_ScheduleCore(c);
+                       break;
+                   }
+               }
+           }
+       }
    }
   #endif
  #endif
 
- #ifdef NOS_32_BITS_SCHEDULER
-  void nOS_AppendThreadToReadyList (nOS_Thread *thread)
-  {
-     /* we use 32 bits variables for maximum performance */
-      uint32_t    prio = (uint32_t)thread->prio;
-
-  #if (NOS_CONFIG_HIGHEST_THREAD_PRIO < 32)
-      nOS_AppendToList(&nOS_readyThreadsList[prio], &thread->readyWait);
-      _readyThreadByPrio |= (0x00000001UL << prio);
-  #elif (NOS_CONFIG_HIGHEST_THREAD_PRIO < 256)
-      uint32_t    group = (prio >> 5UL) & 0x00000007UL;
-
-      nOS_AppendToList(&nOS_readyThreadsList[prio], &thread->readyWait);
-      _readyThreadByPrio[group] |= (0x00000001UL << (prio & 0x0000001fUL));
-      _readyThreadByGroup |= (0x00000001UL << group);
-  #endif
-  }
-  void nOS_RemoveThreadFromReadyList (nOS_Thread *thread)
-  {
-      /* we use 32 bits variables for maximum performance */
-      uint32_t    prio = (uint32_t)thread->prio;
+ #if (NOS_CONFIG_SCHED_EDF_ENABLE > 0)
+  /* Ready list of EDF level is kept sorted by absolute deadline, so its head is always the most urgent thread and
+   * nOS_FindHighPrioThread stay unchanged. Threads without deadline are kept at the tail in FIFO order. */
+  #define _DeadlineBefore(a,b)          (((a)->relDeadline > 0) &&                                                     \
+                                         ((nOS_TickCounter)((b)->deadline - (a)->deadline) <= (NOS_TICK_COUNT_MAX >> 1)))
 
-  #if (NOS_CONFIG_HIGHEST_THREAD_PRIO < 32)
-      nOS_RemoveFromList(&nOS_readyThreadsList[prio], &thread->readyWait);
-      if (nOS_readyThreadsList[prio].head == NULL) {
-          _readyThreadByPrio &=~ (0x00000001UL << prio);
-      }
-  #elif (NOS_CONFIG_HIGHEST_THREAD_PRIO < 256)
-      uint32_t    group = (prio >> 5UL) & 0x00000007UL;
-
-      nOS_RemoveFromList(&nOS_readyThreadsList[prio], &thread->readyWait);
-      if (nOS_readyThreadsList[prio].head == NULL) {
-          _readyThreadByPrio[group] &=~ (0x00000001UL << (prio & 0x0000001fUL));
-          if (_readyThreadByPrio[group] == 0x00000000UL) {
-              _readyThreadByGroup &=~ (0x00000001UL << group);
-          }
-      }
-  #endif
-  }
- #elif defined(NOS_16_BITS_SCHEDULER)
-  void nOS_AppendThreadToReadyList (nOS_Thread *thread)
+  static void _AppendToReadyList (nOS_List *list, nOS_Thread *thread)
   {
-      /* we use 16 bits variables for maximum performance */
-      uint16_t    prio = (uint16_t)thread->prio;
-
-  #if (NOS_CONFIG_HIGHEST_THREAD_PRIO < 16)
-      nOS_AppendToList(&nOS_readyThreadsList[prio], &thread->readyWait);
-      _readyThreadByPrio |= (0x0001 << prio);
-  #elif (NOS_CONFIG_HIGHEST_THREAD_PRIO < 256)
-      uint16_t    group = (prio >> 4) & 0x000F;
-
-      nOS_AppendToList(&nOS_readyThreadsList[prio], &thread->readyWait);
-      _readyThreadByPrio[group] |= (0x0001 << (prio & 0x0f));
-      _readyThreadByGroup |= (0x0001 << group);
-  #endif
-  }
-  void nOS_RemoveThreadFromReadyList (nOS_Thread *thread)
-  {
-      /* we use 16 bits variables for maximum performance */
-      uint16_t    prio = (uint16_t)thread->prio;
+      nOS_Node    *it = NULL;
 
-  #if (NOS_CONFIG_HIGHEST_THREAD_PRIO < 16)
-      nOS_RemoveFromList(&nOS_readyThreadsList[prio], &thread->readyWait);
-      if (nOS_readyThreadsList[prio].head == NULL) {
-          _readyThreadByPrio &=~ (0x0001 << prio);
-      }
-  #elif (NOS_CONFIG_HIGHEST_THREAD_PRIO < 256)
-      uint16_t    group = (prio >> 4) & 0x000F;
-
-      nOS_RemoveFromList(&nOS_readyThreadsList[prio], &thread->readyWait);
-      if (nOS_readyThreadsList[prio].head == NULL) {
-          _readyThreadByPrio[group] &=~ (0x0001 << (prio & 0x0f));
-          if (_readyThreadByPrio[group] == 0x0000) {
-              _readyThreadByGroup &=~ (0x0001 << group);
+      if ((thread->prio == NOS_CONFIG_SCHED_EDF_PRIO) && (thread->relDeadline > 0)) {
+          /* Insert after last thread with same or earlier deadline */
+          it = list->head;
+          while ((it != NULL) && _DeadlineBefore(nOS_GetNodeOwner(it, nOS_Thread, readyWait), thread)) {
+              it = it->next;
           }
       }
-  #endif
+      nOS_InsertToList(list, &thread->readyWait, it);
   }
- #else   /* NOS_32_BITS_SCHEDULER */
-  void nOS_AppendThreadToReadyList (nOS_Thread *thread)
-  {
-      uint8_t prio = thread->prio;
-
-  #if (NOS_CONFIG_HIGHEST_THREAD_PRIO < 8)
-      nOS_AppendToList(&nOS_readyThreadsList[prio], &thread->readyWait);
-      _readyThreadByPrio |= (0x01 << prio);
-  #elif (NOS_CONFIG_HIGHEST_THREAD_PRIO < 16)
-      nOS_AppendToList(&nOS_readyThreadsList[prio], &thread->readyWait);
-      _readyThreadByPrio |= (0x0001 << prio);
-  #elif (NOS_CONFIG_HIGHEST_THREAD_PRIO < 64)
-      uint8_t     group = (prio >> 3) & 0x07;
-
-      nOS_AppendToList(&nOS_readyThreadsList[prio], &thread->readyWait);
-      _readyThreadByPrio[group] |= (0x01 << (prio & 0x07));
-      _readyThreadByGroup |= (0x01 << group);
-  #elif (NOS_CONFIG_HIGHEST_THREAD_PRIO < 256)
-      uint8_t     group = (prio >> 4) & 0x0F;
-
-      nOS_AppendToList(&nOS_readyThreadsList[prio], &thread->readyWait);
-      _readyThreadByPrio[group] |= (0x0001 << (prio & 0x0f));
-      _readyThreadByGroup |= (0x0001 << group);
+ #else
+  #define _AppendToReadyList(l,t)       nOS_AppendToList(l, &(t)->readyWait)
+ #endif
+
+ NOS_FAST_CODE void nOS_AppendThreadToReadyList (nOS_Thread *thread)
+ {
+     _AppendToReadyList(&nOS_readyThreadsList[thread->prio], thread);
+     nOS_SetPrioInBitmap(_readyThreadBitmap, thread->prio);
+ #if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+     _SignalCore(thread);
+  #if (NOS_CONFIG_SMP_WORK_STEALING_ENABLE > 0)
+     _OfferThread(thread);
   #endif
-  }
-  void nOS_RemoveThreadFromReadyList (nOS_Thread *thread)
-  {
-      uint8_t prio = thread->prio;
+ #endif
+ }
+ NOS_FAST_CODE void nOS_RemoveThreadFromReadyList (nOS_Thread *thread)
+ {
+     nOS_RemoveFromList(&nOS_readyThreadsList[thread->prio], &thread->readyWait);
+     if (nOS_readyThreadsList[thread->prio].head == NULL) {
+         nOS_ClearPrioInBitmap(_readyThreadBitmap, thread->prio);
+     }
+ #if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+     _SignalCore(thread);
+ #endif
+ }
 
-  #if (NOS_CONFIG_HIGHEST_THREAD_PRIO < 8)
-      nOS_RemoveFromList(&nOS_readyThreadsList[prio], &thread->readyWait);
-      if (nOS_readyThreadsList[prio].head == NULL) {
-          _readyThreadByPrio &=~ (0x01 << prio);
-      }
-  #elif (NOS_CONFIG_HIGHEST_THREAD_PRIO < 16)
-      nOS_RemoveFromList(&nOS_readyThreadsList[prio], &thread->readyWait);
-      if (nOS_readyThreadsList[prio].head == NULL) {
-          _readyThreadByPrio &=~ (0x0001 << prio);
-      }
-  #elif (NOS_CONFIG_HIGHEST_THREAD_PRIO < 64)
-      uint8_t     group = (prio >> 3) & 0x07;
-
-      nOS_RemoveFromList(&nOS_readyThreadsList[prio], &thread->readyWait);
-      if (nOS_readyThreadsList[prio].head == NULL) {
-          _readyThreadByPrio[group] &=~ (0x01 << (prio & 0x07));
-          if (_readyThreadByPrio[group] == 0x00) {
-              _readyThreadByGroup &=~ (0x01 << group);
-          }
-      }
-  #elif (NOS_CONFIG_HIGHEST_THREAD_PRIO < 256)
-      uint8_t     group = (prio >> 4) & 0x0F;
-
-      nOS_RemoveFromList(&nOS_readyThreadsList[prio], &thread->readyWait);
-      if (nOS_readyThreadsList[prio].head == NULL) {
-          _readyThreadByPrio[group] &=~ (0x0001 << (prio & 0x0f));
-          if (_readyThreadByPrio[group] == 0x0000) {
-              _readyThreadByGroup &=~ (0x0001 << group);
-          }
-      }
+ #if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+  #undef  nOS_readyThreadsList
+  #define nOS_readyThreadsList          nOS_readyThreadsLists[nOS_GetCoreId()]
+
+  #if (NOS_CONFIG_SMP_WORK_STEALING_ENABLE > 0)
+   /* Called from critical section when only idle thread is ready on core of caller, move highest prio migratable
+    * thread waiting to run on another core to this core. Running threads of other cores are never taken. */
+   static bool _StealThread (void)
+   {
+       nOS_Thread  *thread = NULL;
+       nOS_Node    *it;
+       uint8_t     core = nOS_GetCoreId();
+       uint8_t     prio;
+       uint8_t     c;
+
+       for (prio = NOS_CONFIG_HIGHEST_THREAD_PRIO; (prio > NOS_THREAD_PRIO_IDLE) && (thread == NULL); prio--) {
+           for (c = 0; (c < NOS_CONFIG_SMP_CORE_COUNT) && (thread == NULL); c++) {
+               if (c != core) {
+                   for (it = nOS_readyThreadsLists[c][prio].head; (it != NULL) && (thread == NULL); it = it->next) {
+                       if (nOS_GetNodeOwner(it, nOS_Thread, readyWait)->migratable &&
+                           (nOS_GetNodeOwner(it, nOS_Thread, readyWait) != nOS_runningThreads[c])) {
+                           thread = nOS_GetNodeOwner(it, nOS_Thread, readyWait);
+                       }
+                   }
+               }
+           }
+       }
+
+       if (thread != NULL) {
+           nOS_RemoveThreadFromReadyList(thread);
+           thread->core = core;
+           nOS_AppendThreadToReadyList(thread);
+       }
+
+       return (thread != NULL);
+   }
   #endif
-  }
  #endif
 #endif
 
-nOS_Error nOS_Schedule(void)
+NOS_FAST_CODE nOS_Error nOS_Schedule(void)
 {
     nOS_Error   err;
 
+#if (NOS_CONFIG_SCHED_DEFERRED_ENABLE > 0)
+    /* A thread may be ready to preempt running thread, decision is taken later by the port */
+    nOS_needResched = true;
+#endif
+
 #if (NOS_CONFIG_SAFE > 0)
     /* Switch only if initialization is completed */
     if (!nOS_running) {
@@ -405,23 +206,157 @@ nOS_Error nOS_Schedule(void)
     } else
 #endif
     {
+#if (NOS_CONFIG_SCHED_DEFERRED_ENABLE == 0)
         /* Recheck if current running thread is the highest prio thread */
         nOS_highPrioThread = nOS_FindHighPrioThread();
+ #if (NOS_CONFIG_SMP_CORE_COUNT > 1) && (NOS_CONFIG_SMP_WORK_STEALING_ENABLE > 0)
+        if ((nOS_highPrioThread == &nOS_idleHandle) && _StealThread()) {
+            /* Nothing else to run on this core, take work waiting on another one */
+            nOS_highPrioThread = nOS_FindHighPrioThread();
+        }
+ #endif
         if (nOS_runningThread != nOS_highPrioThread) {
             nOS_SwitchContext();
         }
+#endif
         err = NOS_OK;
     }
 
     return err;
 }
 
+#if (NOS_CONFIG_SCHED_DEFERRED_ENABLE > 0)
+/* Called from port when leaving outermost critical section or interrupt with interrupts still disabled, return
+ * true if port need to switch context to nOS_highPrioThread. Pending decision is kept until it can be taken. */
+NOS_FAST_CODE bool nOS_ResolveSchedule(void)
+{
+    bool    sw = false;
+
+    if (!nOS_running) {
+        /* Scheduler not started yet */
+    }
+    else if (nOS_isrNestingCounter > 0) {
+        /* Will be taken when leaving outermost interrupt */
+    } else
+ #if (NOS_CONFIG_SCHED_LOCK_ENABLE > 0)
+    if (nOS_lockNestingCounter > 0) {
+        /* Will be taken when scheduler is unlocked */
+    } else
+ #endif
+    {
+        nOS_needResched = false;
+        nOS_highPrioThread = nOS_FindHighPrioThread();
+        sw = (nOS_runningThread != nOS_highPrioThread);
+    }
+
+    return sw;
+}
+#endif
+
+#if (NOS_CONFIG_THREAD_STATS_ENABLE > 0) || ((NOS_CONFIG_TRACE_ENABLE > 0) && defined(NOS_USE_THREAD_STATS))
+/* Called from port context switch with interrupts disabled, before nOS_runningThread is replaced by nOS_highPrioThread */
+void nOS_AccountSwitch(void)
+{
+#if (NOS_CONFIG_THREAD_STATS_ENABLE > 0)
+    uint32_t    now = nOS_GetCycleCount();
+    uint32_t    slice = now - nOS_switchCycles;
+
+    nOS_runningThread->stats.runTime += slice;
+    if (slice > nOS_runningThread->stats.maxSlice) {
+        nOS_runningThread->stats.maxSlice = slice;
+    }
+    nOS_highPrioThread->stats.switchCount++;
+    nOS_switchCycles = now;
+#endif
+#if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
+    nOS_Trace(NOS_TRACE_SWITCH, nOS_highPrioThread, nOS_highPrioThread->prio);
+#else
+    nOS_Trace(NOS_TRACE_SWITCH, nOS_highPrioThread, 0);
+#endif
+}
+#endif
+
+#if (NOS_CONFIG_TICK_COUNT_LOCK_FREE_ENABLE > 0)
+/* Called from critical section, publish ticks counter to lock-free readers. Each copy is written while sequence
+ * number select the other one, a reader that interrupt this function always read a stable copy. */
+static void _PublishTickCount (void)
+{
+    _tickSeq++;
+    nOS_MemoryBarrier();
+    _tickCopy[0] = nOS_tickCounter;
+    nOS_MemoryBarrier();
+    _tickSeq++;
+    nOS_MemoryBarrier();
+    _tickCopy[1] = nOS_tickCounter;
+    nOS_MemoryBarrier();
+}
+#endif
+
+#if (NOS_CONFIG_SCHED_ROUND_ROBIN_ENABLE > 0)
+/* Called from critical section by nOS_Tick, running thread give its place to the next thread of the same priority
+ * only when its time slice has expired */
+static bool _ConsumeQuantum (nOS_Thread *thread, nOS_TickCounter ticks)
+{
+    bool    expired;
+
+    if (ticks < thread->quantumLeft) {
+        thread->quantumLeft = (uint16_t)(thread->quantumLeft - ticks);
+        expired = false;
+    }
+    else {
+        thread->quantumLeft = thread->quantum;
+        expired = true;
+    }
+
+    return expired;
+}
+#endif
+
+static void _InitIdle (nOS_Thread *thread
+#if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+                      ,uint8_t core
+#endif
+                      )
+{
+#if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
+    thread->prio = NOS_THREAD_PRIO_IDLE;
+#endif
+#if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+    thread->core = core;
+ #if (NOS_CONFIG_SMP_WORK_STEALING_ENABLE > 0)
+    thread->migratable = false;
+ #endif
+#endif
+    thread->state = NOS_THREAD_READY;
+#if (NOS_CONFIG_THREAD_FPU_ENABLE > 0)
+    /* Main thread keep FPU access given by startup code */
+    thread->fpu = true;
+#endif
+#if (NOS_CONFIG_THREAD_STATS_ENABLE > 0)
+    thread->stats.runTime = 0;
+    thread->stats.switchCount = 0;
+    thread->stats.maxSlice = 0;
+#endif
+#if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0) || (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
+    thread->timeout = 0;
+#endif
+#if (NOS_CONFIG_SCHED_ROUND_ROBIN_ENABLE > 0)
+    thread->quantum = NOS_CONFIG_SCHED_ROUND_ROBIN_QUANTUM;
+    thread->quantumLeft = NOS_CONFIG_SCHED_ROUND_ROBIN_QUANTUM;
+#endif
+    nOS_SetNodeOwner(&thread->readyWait, thread);
+    nOS_AppendThreadToReadyList(thread);
+}
+
 nOS_Error nOS_Init(void)
 {
     nOS_Error   err;
 #if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
     uint16_t    i;
 #endif
+#if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+    uint8_t     c;
+#endif
 
 #if (NOS_CONFIG_SAFE > 0)
     if (nOS_initialized) {
@@ -430,39 +365,73 @@ nOS_Error nOS_Init(void)
 #endif
     {
         nOS_tickCounter = 0;
+#if (NOS_CONFIG_TICK_COUNT_LOCK_FREE_ENABLE > 0)
+        _PublishTickCount();
+#endif
+#if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+        for (c = 0; c < NOS_CONFIG_SMP_CORE_COUNT; c++) {
+            nOS_isrNestingCounters[c] = 0;
+ #if (NOS_CONFIG_SCHED_LOCK_ENABLE > 0)
+            nOS_lockNestingCounters[c] = 0;
+ #endif
+            for (i = 0; i <= NOS_CONFIG_HIGHEST_THREAD_PRIO; i++) {
+                nOS_InitList(&nOS_readyThreadsLists[c][i]);
+            }
+        }
+#else
         nOS_isrNestingCounter = 0;
-#if (NOS_CONFIG_SCHED_LOCK_ENABLE > 0)
+ #if (NOS_CONFIG_SCHED_LOCK_ENABLE > 0)
         nOS_lockNestingCounter = 0;
+ #endif
+#endif
+#if (NOS_CONFIG_SCHED_DEFERRED_ENABLE > 0)
+        nOS_needResched = false;
 #endif
 
-#if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
+#if (NOS_CONFIG_SMP_CORE_COUNT == 1)
+ #if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
         for (i = 0; i <= NOS_CONFIG_HIGHEST_THREAD_PRIO; i++) {
             nOS_InitList(&nOS_readyThreadsList[i]);
         }
-#else
+ #else
         nOS_InitList(&nOS_readyThreadsList);
+ #endif
 #endif
 #if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0) || (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
         nOS_InitList(&nOS_timeoutThreadsList);
 #endif
-#if (NOS_CONFIG_THREAD_SUSPEND_ALL_ENABLE > 0)
+#if (NOS_CONFIG_THREAD_SUSPEND_ALL_ENABLE > 0) || (NOS_CONFIG_THREAD_STACK_USAGE_ENABLE > 0)
         nOS_InitList(&nOS_allThreadsList);
 #endif
-
-#if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
-        nOS_idleHandle.prio = NOS_THREAD_PRIO_IDLE;
+#if (NOS_CONFIG_THREAD_BUDGET_ENABLE > 0)
+        nOS_InitList(&nOS_depletedThreadsList);
 #endif
-        nOS_idleHandle.state = NOS_THREAD_READY;
-#if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0) || (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
-        nOS_idleHandle.timeout = 0;
-#endif
-        nOS_idleHandle.readyWait.payload = &nOS_idleHandle;
-        nOS_AppendThreadToReadyList(&nOS_idleHandle);
+
+#if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+        /* Main thread is idle thread of core 0, port start idle threads of other cores */
+        for (c = 0; c < NOS_CONFIG_SMP_CORE_COUNT; c++) {
+            _InitIdle(&nOS_idleHandles[c], c);
+            nOS_runningThreads[c] = &nOS_idleHandles[c];
+            nOS_highPrioThreads[c] = &nOS_idleHandles[c];
+        }
+#else
+        _InitIdle(&nOS_idleHandle);
         nOS_runningThread = &nOS_idleHandle;
         nOS_highPrioThread = &nOS_idleHandle;
+#endif
 
         /* Let port doing special initialization if needed */
         nOS_InitSpecific();
+#if (NOS_CONFIG_THREAD_STATS_ENABLE > 0)
+        /* Cycle counter is started by port, main thread is running from now */
+ #if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+        for (c = 0; c < NOS_CONFIG_SMP_CORE_COUNT; c++) {
+            nOS_switchCyclesPerCore[c] = nOS_GetCycleCount();
+        }
+ #else
+        nOS_switchCycles = nOS_GetCycleCount();
+ #endif
+#endif
 
 #if (NOS_CONFIG_TIMER_ENABLE > 0)
         nOS_InitTimer();
@@ -470,12 +439,30 @@ nOS_Error nOS_Init(void)
 #if (NOS_CONFIG_SIGNAL_ENABLE > 0)
         nOS_InitSignal();
 #endif
+#if (NOS_CONFIG_TASK_ENABLE > 0)
+        nOS_InitTask();
+#endif
+#if (NOS_CONFIG_JOB_ENABLE > 0)
+        nOS_InitJob();
+#endif
 #if (NOS_CONFIG_TIME_ENABLE > 0)
         nOS_InitTime();
 #endif
 #if (NOS_CONFIG_ALARM_ENABLE > 0)
         nOS_InitAlarm();
 #endif
+#if (NOS_CONFIG_LOG_ENABLE > 0)
+        nOS_InitLog();
+#endif
+#if (NOS_CONFIG_POWER_ENABLE > 0)
+        nOS_InitPower();
+#endif
+#if (NOS_CONFIG_HRTIMER_ENABLE > 0)
+        nOS_InitHrTimer();
+#endif
+#if (NOS_CONFIG_THREAD_SPAWN_ENABLE > 0)
+        nOS_InitThreadSpawn();
+#endif
 
         nOS_initialized = true;
 
@@ -488,9 +475,14 @@ nOS_Error nOS_Init(void)
 nOS_Error nOS_Start(void)
 {
     nOS_Error       err;
-#if (NOS_CONFIG_SAFE > 0)
+#if (NOS_CONFIG_SAFE > 0) || (NOS_CONFIG_SMP_CORE_COUNT > 1)
     nOS_StatusReg   sr;
+#endif
+#if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+    uint8_t         c;
+#endif
 
+#if (NOS_CONFIG_SAFE > 0)
     if (!nOS_initialized) {
         nOS_EnterCritical(sr);
         nOS_Init();
@@ -504,6 +496,16 @@ nOS_Error nOS_Start(void)
     {
         /* Context switching is possible after this point */
         nOS_running = true;
+#if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+        /* Let other cores run threads created before scheduler start */
+        nOS_EnterCritical(sr);
+        for (c = 0; c < NOS_CONFIG_SMP_CORE_COUNT; c++) {
+            if (c != nOS_GetCoreId()) {
+                nOS_ScheduleCore(c);
+            }
+        }
+        nOS_LeaveCritical(sr);
+#endif
 
         err = NOS_OK;
     }
@@ -528,10 +530,18 @@ nOS_Error nOS_Yield(void)
 #endif
     {
         nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SCHED_EDF_ENABLE > 0)
+        /* EDF level stay ordered by deadline */
+        if (nOS_runningThread->prio != NOS_CONFIG_SCHED_EDF_PRIO)
+#endif
 #if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
         nOS_RotateList(&nOS_readyThreadsList[nOS_runningThread->prio]);
 #else
         nOS_RotateList(&nOS_readyThreadsList);
+#endif
+#if (NOS_CONFIG_SCHED_ROUND_ROBIN_ENABLE > 0)
+        /* Yielding thread will start a new time slice */
+        nOS_runningThread->quantumLeft = nOS_runningThread->quantum;
 #endif
         err = nOS_Schedule();
         nOS_LeaveCritical(sr);
@@ -543,48 +553,216 @@ nOS_Error nOS_Yield(void)
 void nOS_Tick(nOS_TickCounter ticks)
 {
     nOS_StatusReg   sr;
+    nOS_TickCounter n;
+#if (NOS_CONFIG_SCHED_ROUND_ROBIN_ENABLE > 0) && (NOS_CONFIG_SMP_CORE_COUNT > 1)
+    nOS_List        *list;
+#endif
+#if ((NOS_CONFIG_SCHED_ROUND_ROBIN_ENABLE > 0) || (NOS_CONFIG_THREAD_BUDGET_ENABLE > 0)) && (NOS_CONFIG_SMP_CORE_COUNT > 1)
+    uint8_t         c;
+#endif
+#if (NOS_CONFIG_SORTED_TIMEOUT_LIST_ENABLE > 0)
+    nOS_Thread      *thread;
+#endif
 
-#if (NOS_CONFIG_SAFE > 0)
-    if (ticks > 0)
+    while (ticks > 0) {
+#if (NOS_CONFIG_TICK_BATCH_SIZE > 0)
+        /* Bound time spent in critical section, interrupts are allowed between each batch */
+        n = (ticks > NOS_CONFIG_TICK_BATCH_SIZE) ? NOS_CONFIG_TICK_BATCH_SIZE : ticks;
+#else
+        n = ticks;
 #endif
-    {
+        ticks -= n;
+
+        /* All services are updated in the same critical section */
         nOS_EnterCritical(sr);
 #if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0) || (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
-        nOS_WalkInList(&nOS_timeoutThreadsList, nOS_TickThread, &ticks);
+ #if (NOS_CONFIG_SORTED_TIMEOUT_LIST_ENABLE > 0)
+        /* List is sorted by deadline, stop at first thread that has not expired */
+        thread = nOS_GetHeadOfList(&nOS_timeoutThreadsList, nOS_Thread, tout);
+        while ((thread != NULL) && ((thread->timeout - nOS_tickCounter) <= n)) {
+            nOS_TickThread(&thread->tout, &n);
+            thread = nOS_GetHeadOfList(&nOS_timeoutThreadsList, nOS_Thread, tout);
+        }
+ #else
+        nOS_WalkInList(&nOS_timeoutThreadsList, nOS_TickThread, &n);
+ #endif
 #endif
 #if (NOS_CONFIG_TIMER_ENABLE > 0) && (NOS_CONFIG_TIMER_TICK_ENABLE > 0)
-        nOS_TimerTick(ticks);
+        nOS_TimerTick(n);
 #endif
 #if (NOS_CONFIG_TIME_ENABLE > 0) && (NOS_CONFIG_TIME_TICK_ENABLE > 0)
-        nOS_TimeTick(ticks);
+        nOS_TimeTick(n);
 #endif
 #if (NOS_CONFIG_ALARM_ENABLE > 0) && (NOS_CONFIG_ALARM_TICK_ENABLE > 0)
         nOS_AlarmTick();
 #endif
 #if (NOS_CONFIG_SCHED_ROUND_ROBIN_ENABLE > 0)
- #if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
-        nOS_RotateList(&nOS_readyThreadsList[nOS_runningThread->prio]);
+ #if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+        /* Tick is received by only one core, share running priority of each core */
+        for (c = 0; c < NOS_CONFIG_SMP_CORE_COUNT; c++) {
+            list = &nOS_readyThreadsLists[c][nOS_runningThreads[c]->prio];
+            if (_ConsumeQuantum(nOS_runningThreads[c], n) && (list->head != list->tail)) {
+                nOS_RotateList(list);
+                if (c != nOS_GetCoreId()) {
+                    nOS_ScheduleCore(c);
+                }
+            }
+        }
+ #elif (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
+        if (_ConsumeQuantum(nOS_runningThread, n)
+  #if (NOS_CONFIG_SCHED_EDF_ENABLE > 0)
+            /* EDF level stay ordered by deadline */
+            && (nOS_runningThread->prio != NOS_CONFIG_SCHED_EDF_PRIO)
+  #endif
+           ) {
+            nOS_RotateList(&nOS_readyThreadsList[nOS_runningThread->prio]);
+        }
  #else
-        nOS_RotateList(&nOS_readyThreadsList);
+        if (_ConsumeQuantum(nOS_runningThread, n)) {
+            nOS_RotateList(&nOS_readyThreadsList);
+        }
+ #endif
+#endif
+        nOS_tickCounter += n;
+#if (NOS_CONFIG_THREAD_BUDGET_ENABLE > 0)
+        /* Restore replenished threads before charging elapsed ticks to running threads */
+        nOS_WalkInList(&nOS_depletedThreadsList, nOS_ReplenishThread, NULL);
+ #if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+        for (c = 0; c < NOS_CONFIG_SMP_CORE_COUNT; c++) {
+            nOS_ChargeThread(nOS_runningThreads[c], n);
+        }
+ #else
+        nOS_ChargeThread(nOS_runningThread, n);
  #endif
 #endif
-        nOS_tickCounter += ticks;
+#if (NOS_CONFIG_TICK_COUNT_LOCK_FREE_ENABLE > 0)
+        _PublishTickCount();
+#endif
+#if (NOS_CONFIG_SCHED_DEFERRED_ENABLE > 0)
+        /* Threads can have been woken up or rotated, decision is taken once when leaving interrupt */
+        nOS_needResched = true;
+#endif
         nOS_LeaveCritical(sr);
     }
 }
 
 nOS_TickCounter nOS_GetTickCount(void)
 {
+#if (NOS_CONFIG_TICK_COUNT_LOCK_FREE_ENABLE > 0)
+    uint8_t         seq;
+#else
     nOS_StatusReg   sr;
+#endif
     nOS_TickCounter tickcnt;
 
+#if (NOS_CONFIG_TICK_COUNT_LOCK_FREE_ENABLE > 0)
+    /* Read again if ticks counter has been published while reading */
+    do {
+        seq = _tickSeq;
+        nOS_MemoryBarrier();
+        tickcnt = _tickCopy[seq & 1];
+        nOS_MemoryBarrier();
+    } while (seq != _tickSeq);
+#else
     nOS_EnterCritical(sr);
     tickcnt = nOS_tickCounter;
     nOS_LeaveCritical(sr);
+#endif
 
     return tickcnt;
 }
 
+#if (NOS_CONFIG_TICKLESS_ENABLE > 0)
+ #if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0) || (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
+  #if (NOS_CONFIG_SORTED_TIMEOUT_LIST_ENABLE == 0)
+static void _GetNextTimeout (void *node, void *arg)
+{
+    nOS_Thread      *thread = nOS_GetNodeOwner((nOS_Node*)node, nOS_Thread, tout);
+    nOS_TickCounter *ticks  = (nOS_TickCounter*)arg;
+
+    if ((thread->timeout - nOS_tickCounter) < *ticks) {
+        *ticks = thread->timeout - nOS_tickCounter;
+    }
+}
+  #endif
+ #endif
+
+nOS_TickCounter nOS_GetNextWakeupTicks (void)
+{
+    nOS_StatusReg   sr;
+    nOS_TickCounter ticks = NOS_WAIT_INFINITE;
+#if (NOS_CONFIG_SCHED_ROUND_ROBIN_ENABLE > 0) && (NOS_CONFIG_SMP_CORE_COUNT > 1)
+    nOS_List        *list;
+    uint8_t         c;
+#endif
+#if ((NOS_CONFIG_TIMER_ENABLE > 0) && (NOS_CONFIG_TIMER_TICK_ENABLE > 0)) || ((NOS_CONFIG_TIME_ENABLE > 0) && (NOS_CONFIG_TIME_TICK_ENABLE > 0))
+    nOS_TickCounter tmp;
+#endif
+#if (NOS_CONFIG_SORTED_TIMEOUT_LIST_ENABLE > 0)
+    nOS_Thread      *thread;
+#endif
+
+    nOS_EnterCritical(sr);
+#if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0) || (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
+ #if (NOS_CONFIG_SORTED_TIMEOUT_LIST_ENABLE > 0)
+    /* List is sorted by deadline, first thread to wake up is at head */
+    thread = nOS_GetHeadOfList(&nOS_timeoutThreadsList, nOS_Thread, tout);
+    if (thread != NULL) {
+        ticks = thread->timeout - nOS_tickCounter;
+    }
+ #else
+    nOS_WalkInList(&nOS_timeoutThreadsList, _GetNextTimeout, &ticks);
+ #endif
+#endif
+#if (NOS_CONFIG_TIMER_ENABLE > 0) && (NOS_CONFIG_TIMER_TICK_ENABLE > 0)
+    tmp = nOS_TimerGetNextWakeup();
+    if (tmp < ticks) {
+        ticks = tmp;
+    }
+#endif
+#if (NOS_CONFIG_TIME_ENABLE > 0) && (NOS_CONFIG_TIME_TICK_ENABLE > 0)
+    tmp = nOS_TimeGetNextWakeup();
+    if (tmp < ticks) {
+        ticks = tmp;
+    }
+ #if (NOS_CONFIG_ALARM_ENABLE > 0) && (NOS_CONFIG_ALARM_TICK_ENABLE > 0)
+    tmp = nOS_AlarmGetNextWakeup();
+    if (tmp < ticks) {
+        ticks = tmp;
+    }
+ #endif
+#endif
+#if (NOS_CONFIG_SCHED_ROUND_ROBIN_ENABLE > 0)
+    /* Other threads ready at the same priority need ticks to share the CPU */
+ #if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+    for (c = 0; c < NOS_CONFIG_SMP_CORE_COUNT; c++) {
+        list = &nOS_readyThreadsLists[c][nOS_runningThreads[c]->prio];
+        if ((list->head != list->tail) && (ticks > nOS_runningThreads[c]->quantumLeft)) {
+            ticks = nOS_runningThreads[c]->quantumLeft;
+        }
+    }
+ #else
+  #if (NOS_CONFIG_SCHED_EDF_ENABLE > 0)
+    if ((nOS_runningThread->prio != NOS_CONFIG_SCHED_EDF_PRIO) &&
+        (nOS_readyThreadsList[nOS_runningThread->prio].head != nOS_readyThreadsList[nOS_runningThread->prio].tail)) {
+  #elif (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
+    if (nOS_readyThreadsList[nOS_runningThread->prio].head != nOS_readyThreadsList[nOS_runningThread->prio].tail) {
+  #else
+    if (nOS_readyThreadsList.head != nOS_readyThreadsList.tail) {
+  #endif
+        /* Wake up when time slice of running thread expire */
+        if (ticks > nOS_runningThread->quantumLeft) {
+            ticks = nOS_runningThread->quantumLeft;
+        }
+    }
+ #endif
+#endif
+    nOS_LeaveCritical(sr);
+
+    return ticks;
+}
+#endif
+
 #if defined(NOS_CONFIG_TICKS_PER_SECOND) && (NOS_CONFIG_TICKS_PER_SECOND > 0)
 uint32_t nOS_MsToTicks (uint16_t ms)
 {
@@ -712,6 +890,145 @@ nOS_Error nOS_SleepUntil (nOS_TickCounter tick)
 }
 #endif  /* NOS_CONFIG_SLEEP_UNTIL_ENABLE */
 
+#if (NOS_CONFIG_THREAD_PERIODIC_ENABLE > 0)
+/* Releases are kept on a grid of period from first release, so a late thread doesn't shift following ones. Deadline
+ * of a release is next release, so thread has missed it if it complete after next release has elapsed. */
+nOS_Error nOS_ThreadSetPeriodic (nOS_Thread *thread, nOS_TickCounter period, nOS_PeriodicCallback callback)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+    if (thread == NULL) {
+        thread = nOS_runningThread;
+    }
+
+    nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+    if (thread->state == NOS_THREAD_STOPPED) {
+        err = NOS_E_INV_OBJ;
+    } else
+#endif
+    {
+        thread->release = nOS_tickCounter;
+        thread->releasePeriod = period;
+        thread->missed = callback;
+        thread->periodic.releases = 0;
+        thread->periodic.misses = 0;
+        thread->periodic.lastJitter = 0;
+        thread->periodic.maxJitter = 0;
+        thread->periodic.lastResponse = 0;
+        thread->periodic.maxResponse = 0;
+        err = NOS_OK;
+    }
+    nOS_LeaveCritical(sr);
+
+    return err;
+}
+
+nOS_Error nOS_WaitNextPeriod (void)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+    nOS_Thread      *thread = nOS_runningThread;
+    nOS_TickCounter response = 0;
+    nOS_TickCounter jitter;
+    nOS_TickCounter ticks;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (nOS_isrNestingCounter > 0) {
+        err = NOS_E_ISR;
+    } else
+ #if (NOS_CONFIG_SCHED_LOCK_ENABLE > 0)
+    /* Can't switch context when scheduler is locked */
+    if (nOS_lockNestingCounter > 0) {
+        err = NOS_E_LOCKED;
+    } else
+ #endif
+    if (thread == &nOS_idleHandle) {
+        err = NOS_E_IDLE;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+        if (thread->releasePeriod == 0) {
+            err = NOS_E_INV_VAL;
+        }
+        else {
+            response = (nOS_TickCounter)(nOS_tickCounter - thread->release);
+            thread->periodic.lastResponse = response;
+            if (response > thread->periodic.maxResponse) {
+                thread->periodic.maxResponse = response;
+            }
+            if (response > thread->releasePeriod) {
+                thread->periodic.misses++;
+                if ((nOS_TickCounter)(response - thread->releasePeriod) >= thread->releasePeriod) {
+                    /* More than one release missed, restart releases from now */
+                    thread->release = nOS_tickCounter;
+                }
+                else {
+                    thread->release += thread->releasePeriod;
+                }
+                err = NOS_E_ELAPSED;
+            }
+            else {
+                thread->release += thread->releasePeriod;
+                ticks = (nOS_TickCounter)(thread->release - nOS_tickCounter);
+                err = NOS_OK;
+                if (ticks > 0) {
+                    err = nOS_WaitForEvent(NULL, NOS_THREAD_SLEEPING, ticks);
+                }
+            }
+            /* Release jitter is measured when thread run again */
+            jitter = (nOS_TickCounter)(nOS_tickCounter - thread->release);
+            thread->periodic.releases++;
+            thread->periodic.lastJitter = jitter;
+            if (jitter > thread->periodic.maxJitter) {
+                thread->periodic.maxJitter = jitter;
+            }
+        }
+        nOS_LeaveCritical(sr);
+
+        if ((err == NOS_E_ELAPSED) && (thread->missed != NULL)) {
+            /* Called from thread itself, outside of critical section */
+            thread->missed(thread, response);
+        }
+    }
+
+    return err;
+}
+
+nOS_Error nOS_ThreadGetPeriodicStats (nOS_Thread *thread, nOS_PeriodicStats *stats)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+    if (thread == NULL) {
+        thread = nOS_runningThread;
+    }
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (stats == NULL) {
+        err = NOS_E_NULL;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (thread->state == NOS_THREAD_STOPPED) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        {
+            *stats = thread->periodic;
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+#endif  /* NOS_CONFIG_THREAD_PERIODIC_ENABLE */
+
 #if (NOS_CONFIG_SCHED_LOCK_ENABLE > 0)
 nOS_Error nOS_SchedLock(void)
 {
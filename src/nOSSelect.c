@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2014-2016 Jim Tremblay
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#define NOS_PRIVATE
+#include "nOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if (NOS_CONFIG_SELECT_ENABLE > 0)
+#if (NOS_CONFIG_SAFE > 0)
+static bool _IsValid (nOS_SelectItem *item)
+{
+    nOS_Event   *event = (nOS_Event*)item->object;
+    bool        valid;
+
+    if (event == NULL) {
+        valid = false;
+    }
+    else {
+        switch (item->type) {
+#if (NOS_CONFIG_SEM_ENABLE > 0)
+            case NOS_SELECT_SEM:
+                valid = (event->type == NOS_EVENT_SEM);
+                break;
+#endif
+#if (NOS_CONFIG_QUEUE_ENABLE > 0)
+            case NOS_SELECT_QUEUE:
+                valid = (event->type == NOS_EVENT_QUEUE);
+                break;
+#endif
+#if (NOS_CONFIG_FLAG_ENABLE > 0)
+            case NOS_SELECT_FLAG:
+                valid = (event->type == NOS_EVENT_FLAG);
+                break;
+#endif
+#if (NOS_CONFIG_MEM_ENABLE > 0)
+            case NOS_SELECT_MEM:
+                valid = (event->type == NOS_EVENT_MEM);
+                break;
+#endif
+            default:
+                valid = false;
+                break;
+        }
+    }
+
+    return valid;
+}
+#endif
+
+/* Called from critical section */
+static bool _IsReady (nOS_SelectItem *item)
+{
+    bool    ready;
+
+    switch (item->type) {
+#if (NOS_CONFIG_SEM_ENABLE > 0)
+        case NOS_SELECT_SEM:
+            ready = (((nOS_Sem*)item->object)->count > 0);
+            break;
+#endif
+#if (NOS_CONFIG_QUEUE_ENABLE > 0)
+        case NOS_SELECT_QUEUE:
+            ready = (((nOS_Queue*)item->object)->bcount > 0);
+            break;
+#endif
+#if (NOS_CONFIG_FLAG_ENABLE > 0)
+        case NOS_SELECT_FLAG:
+            ready = ((((nOS_Flag*)item->object)->flags & item->flags) != NOS_FLAG_NONE);
+            break;
+#endif
+#if (NOS_CONFIG_MEM_ENABLE > 0)
+        case NOS_SELECT_MEM:
+            ready = (((nOS_Mem*)item->object)->blist != NULL);
+            break;
+#endif
+        default:
+            ready = false;
+            break;
+    }
+
+    return ready;
+}
+
+/* Called from critical section, return index of first ready item or count if none */
+static uint8_t _FindReady (nOS_SelectItem *items, uint8_t count)
+{
+    uint8_t     i;
+
+    for (i = 0; i < count; i++) {
+        if (_IsReady(&items[i])) {
+            break;
+        }
+    }
+
+    return i;
+}
+
+static void _Link (nOS_SelectContext *ctx)
+{
+    uint8_t     i;
+
+    for (i = 0; i < ctx->count; i++) {
+        ctx->items[i].thread = nOS_runningThread;
+        nOS_SetNodeOwner(&ctx->items[i].node, &ctx->items[i]);
+        nOS_AppendToList(&((nOS_Event*)ctx->items[i].object)->selectList, &ctx->items[i].node);
+    }
+}
+
+static void _Unlink (nOS_SelectContext *ctx)
+{
+    uint8_t     i;
+
+    for (i = 0; i < ctx->count; i++) {
+        nOS_RemoveFromList(&((nOS_Event*)ctx->items[i].object)->selectList, &ctx->items[i].node);
+    }
+}
+
+/* Wake up all threads selecting given object, called from critical section when object become ready or deleted */
+void nOS_SignalSelect (nOS_Event *event, nOS_Error err)
+{
+    nOS_Node    *it = event->selectList.head;
+    nOS_Thread  *thread;
+#if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
+    bool        sched = false;
+#endif
+
+    while (it != NULL) {
+        thread = nOS_GetNodeOwner(it, nOS_SelectItem, node)->thread;
+        it = it->next;
+        /* Thread stay linked to objects until it run again, wake it up only once */
+        if ((thread->state & NOS_THREAD_WAITING_MASK) == NOS_THREAD_SELECTING) {
+            ((nOS_SelectContext*)thread->ext)->event = event;
+            nOS_WakeUpThread(thread, err);
+#if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
+            sched = true;
+#endif
+        }
+    }
+
+#if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
+    if (sched) {
+        /* Verify if a highest prio thread is ready to run */
+        nOS_Schedule();
+    }
+#endif
+}
+
+/* Called from critical section when a selecting thread is deleted */
+void nOS_RemoveThreadFromSelect (nOS_Thread *thread)
+{
+    _Unlink((nOS_SelectContext*)thread->ext);
+}
+
+nOS_Error nOS_Select (nOS_SelectItem *items, uint8_t count, uint8_t *index, nOS_TickCounter timeout)
+{
+    nOS_Error           err;
+    nOS_StatusReg       sr;
+    nOS_SelectContext   ctx;
+    uint8_t             i;
+#if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0)
+    nOS_TickCounter     start = 0;
+    nOS_TickCounter     elapsed;
+#endif
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (items == NULL) {
+        err = NOS_E_NULL;
+    }
+    else if (count == 0) {
+        err = NOS_E_INV_VAL;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        err = NOS_OK;
+        for (i = 0; (i < count) && (err == NOS_OK); i++) {
+            if (!_IsValid(&items[i])) {
+                err = NOS_E_INV_OBJ;
+            }
+        }
+        if (err == NOS_OK)
+#endif
+        {
+            i = _FindReady(items, count);
+            if (i < count) {
+                err = NOS_OK;
+            }
+            else if (timeout == NOS_NO_WAIT) {
+                /* Caller can't wait? Try again. */
+                err = NOS_E_AGAIN;
+            }
+            else {
+                ctx.items = items;
+                ctx.count = count;
+#if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0)
+                if (timeout != NOS_WAIT_INFINITE) {
+                    start = nOS_tickCounter;
+                }
+#endif
+                do {
+                    ctx.event = NULL;
+                    _Link(&ctx);
+                    nOS_runningThread->ext = &ctx;
+                    err = nOS_WaitForEvent(NULL,
+                                           NOS_THREAD_SELECTING
+#if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0)
+                                          ,timeout
+#elif (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
+                                          ,NOS_WAIT_INFINITE
+#endif
+                                          );
+                    _Unlink(&ctx);
+
+                    if (err == NOS_OK) {
+                        /* Object can have been taken by a thread with higher prio, or item flags are not set */
+                        i = _FindReady(items, count);
+#if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0)
+                        if ((i == count) && (timeout != NOS_WAIT_INFINITE)) {
+                            elapsed = nOS_tickCounter - start;
+                            if (elapsed < timeout) {
+                                /* Wait again for the remaining time */
+                                timeout -= elapsed;
+                                start = nOS_tickCounter;
+                            }
+                            else {
+                                err = NOS_E_TIMEOUT;
+                            }
+                        }
+#endif
+                    }
+                    else if ((err == NOS_E_DELETED) && (ctx.event != NULL)) {
+                        /* Give position of deleted object to caller */
+                        for (i = 0; (nOS_Event*)items[i].object != ctx.event; i++);
+                    }
+                } while ((err == NOS_OK) && (i == count));
+            }
+        }
+        nOS_LeaveCritical(sr);
+
+        if ((index != NULL) && ((err == NOS_OK) || (err == NOS_E_DELETED))) {
+            *index = i;
+        }
+    }
+
+    return err;
+}
+#endif  /* NOS_CONFIG_SELECT_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
@@ -83,6 +83,169 @@ nOS_Error nOS_SemDelete (nOS_Sem *sem)
 }
 #endif
 
+#if (NOS_CONFIG_SEM_MULTI_ENABLE > 0)
+/* Called from critical section, give count of semaphore and then given count to waiting threads in waiting order,
+ * stop at first thread that need more than what is available. Return true if at least one thread has been awoken. */
+static bool _Distribute (nOS_Sem *sem, nOS_SemCounter *n)
+{
+    nOS_Thread      *thread = nOS_GetHeadOfList(&sem->e.waitList, nOS_Thread, readyWait);
+    nOS_SemCounter  need;
+    bool            woken = false;
+
+    while (thread != NULL) {
+        need = *(nOS_SemCounter*)thread->ext;
+        if (need <= sem->count) {
+            sem->count -= need;
+        }
+        else if ((need - sem->count) <= *n) {
+            *n -= (need - sem->count);
+            sem->count = 0;
+        }
+        else {
+            break;
+        }
+        nOS_WakeUpThread(thread, NOS_OK);
+        woken = true;
+        thread = nOS_GetHeadOfList(&sem->e.waitList, nOS_Thread, readyWait);
+    }
+
+    return woken;
+}
+
+nOS_Error nOS_SemTake (nOS_Sem *sem, nOS_TickCounter timeout)
+{
+    return nOS_SemTakeN(sem, 1, timeout);
+}
+
+nOS_Error nOS_SemTakeN (nOS_Sem *sem, nOS_SemCounter n, nOS_TickCounter timeout)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+    nOS_SemCounter  none = 0;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (sem == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (n == 0) {
+        err = NOS_E_INV_VAL;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (sem->e.type != NOS_EVENT_SEM) {
+            err = NOS_E_INV_OBJ;
+        }
+        else if ((sem->max > 0) && (n > sem->max)) {
+            /* Can never be satisfied */
+            err = NOS_E_INV_VAL;
+        } else
+#endif
+        if ((sem->count >= n) && (sem->e.waitList.head == NULL)) {
+            /* Sem available and no thread is waiting before. */
+            sem->count -= n;
+            err = NOS_OK;
+        }
+        else if (timeout == NOS_NO_WAIT) {
+            /* Calling thread can't wait. */
+            err = NOS_E_AGAIN;
+        }
+        else {
+            /* Calling thread must wait on sem, givers need to know how much it want. */
+            nOS_runningThread->ext = &n;
+            err = nOS_WaitForEvent((nOS_Event*)sem,
+                                   NOS_THREAD_TAKING_SEM
+#if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0)
+                                  ,timeout
+#elif (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
+                                  ,NOS_WAIT_INFINITE
+#endif
+                                  );
+            if (err != NOS_OK) {
+                /* Threads waiting behind can be satisfied by count that was not enough for calling thread */
+                if (_Distribute(sem, &none)) {
+#if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
+                    /* Verify if a highest prio thread is ready to run */
+                    nOS_Schedule();
+#endif
+                }
+            }
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+
+nOS_Error nOS_SemGive (nOS_Sem *sem)
+{
+    return nOS_SemGiveN(sem, 1);
+}
+
+nOS_Error nOS_SemGiveN (nOS_Sem *sem, nOS_SemCounter n)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+    bool            woken;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (sem == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (n == 0) {
+        err = NOS_E_INV_VAL;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (sem->e.type != NOS_EVENT_SEM) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        {
+            /* Waiting threads are served first, all in the same critical section */
+            woken = _Distribute(sem, &n);
+            if (n == 0) {
+                err = NOS_OK;
+            }
+            /* Remaining count is kept, can we increase count? */
+            else if ((sem->max - sem->count) >= n) {
+                sem->count += n;
+#if (NOS_CONFIG_SELECT_ENABLE > 0)
+                nOS_SignalSelect((nOS_Event*)sem, NOS_OK);
+#endif
+#if (NOS_CONFIG_TASK_ENABLE > 0)
+                nOS_WakeUpTasks();
+#endif
+                err = NOS_OK;
+            }
+            else if (sem->max > 0) {
+                /* Count is saturated, extra count is lost */
+                sem->count = sem->max;
+                err = NOS_E_OVERFLOW;
+            }
+            else if (woken) {
+                err = NOS_OK;
+            }
+            else {
+                /* No thread waiting to consume sem, inform producer */
+                err = NOS_E_NO_CONSUMER;
+            }
+#if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
+            if (woken) {
+                /* Verify if a highest prio thread is ready to run, only once for all awoken threads */
+                nOS_Schedule();
+            }
+#endif
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+#else
 nOS_Error nOS_SemTake (nOS_Sem *sem, nOS_TickCounter timeout)
 {
     nOS_Error       err;
@@ -156,6 +319,12 @@ nOS_Error nOS_SemGive (nOS_Sem *sem)
             /* No thread waiting for semaphore, can we increase count? */
             else if (sem->count < sem->max) {
                 sem->count++;
+#if (NOS_CONFIG_SELECT_ENABLE > 0)
+                nOS_SignalSelect((nOS_Event*)sem, NOS_OK);
+#endif
+#if (NOS_CONFIG_TASK_ENABLE > 0)
+                nOS_WakeUpTasks();
+#endif
                 err = NOS_OK;
             }
             else if (sem->max > 0) {
@@ -171,6 +340,7 @@ nOS_Error nOS_SemGive (nOS_Sem *sem)
 
     return err;
 }
+#endif
 
 bool nOS_SemIsAvailable (nOS_Sem *sem)
 {
@@ -14,6 +14,13 @@ extern "C" {
 #endif
 
 #if (NOS_CONFIG_SIGNAL_ENABLE > 0)
+typedef struct _Item
+{
+    nOS_Signal          *signal;
+    nOS_SignalCallback  callback;
+    void                *arg;
+} _Item;
+
 #if (NOS_CONFIG_SIGNAL_THREAD_ENABLE > 0)
  #if (NOS_CONFIG_THREAD_JOIN_ENABLE > 0)
   static int _Thread (void *arg);
@@ -24,12 +31,7 @@ extern "C" {
 
 #if (NOS_CONFIG_SIGNAL_HIGHEST_PRIO > 0)
  static nOS_List                _list[NOS_CONFIG_SIGNAL_HIGHEST_PRIO+1];
- static uint8_t                 _listByPrio;
- #ifndef NOS_USE_CLZ
-  static NOS_CONST uint8_t      _tableDeBruijn[8] = {
-       0, 5, 1, 6, 4, 3, 2, 7
-   };
- #endif
+ static nOS_BitmapWord          _listByPrio[NOS_BITMAP_SIZE(NOS_CONFIG_SIGNAL_HIGHEST_PRIO)];
 #else
  static nOS_List                _list;
 #endif
@@ -45,20 +47,8 @@ extern "C" {
 #if (NOS_CONFIG_SIGNAL_HIGHEST_PRIO > 0)
  static inline nOS_Signal* _FindHighestPrio (void)
  {
-     uint8_t prio;
-
-     if (_listByPrio != 0) {
- #ifdef NOS_USE_CLZ
-         prio = (uint8_t)(31 - _CLZ((uint32_t)_listByPrio));
- #else
-         prio = _listByPrio;
-         prio |= prio >> 1; // first round down to one less than a power of 2
-         prio |= prio >> 2;
-         prio |= prio >> 4;
-         prio = (uint8_t)_tableDeBruijn[(uint8_t)(prio * 0x1d) >> 5];
- #endif
-
-         return (nOS_Signal*)_list[prio].head->payload;
+     if (!nOS_IsBitmapEmpty(_listByPrio)) {
+         return nOS_GetNodeOwner(_list[nOS_GetHighestPrioInBitmap(_listByPrio)].head, nOS_Signal, node);
      }
      else {
          return (nOS_Signal*)NULL;
@@ -66,26 +56,94 @@ extern "C" {
  }
  static inline void _AppendToList (nOS_Signal *signal)
  {
-     uint8_t prio = signal->prio;
-
-     nOS_AppendToList(&_list[prio], &signal->node);
-     _listByPrio |= (0x00000001UL << prio);
+     nOS_AppendToList(&_list[signal->prio], &signal->node);
+     nOS_SetPrioInBitmap(_listByPrio, signal->prio);
  }
  static inline void _RemoveFromList (nOS_Signal *signal)
  {
-     uint8_t prio = signal->prio;
-
-     nOS_RemoveFromList(&_list[prio], &signal->node);
-     if (_list[prio].head == NULL) {
-         _listByPrio &=~ (0x00000001UL << prio);
+     nOS_RemoveFromList(&_list[signal->prio], &signal->node);
+     if (_list[signal->prio].head == NULL) {
+         nOS_ClearPrioInBitmap(_listByPrio, signal->prio);
      }
  }
 #else
- #define _FindHighestPrio()                 nOS_GetHeadOfList(&_list)
+ #define _FindHighestPrio()                 nOS_GetHeadOfList(&_list, nOS_Signal, node)
  #define _AppendToList(s)                   nOS_AppendToList(&_list, &(s)->node)
  #define _RemoveFromList(s)                 nOS_RemoveFromList(&_list, &(s)->node)
 #endif
 
+#if (NOS_CONFIG_SIGNAL_QUEUE_ENABLE > 0)
+/* Signal with a queue keep one argument per raise and stay raised until all of them are processed */
+ #define _NextIndex(s,i)                    ((uint8_t)(((i) + 1) < (s)->bmax ? ((i) + 1) : 0))
+ static void _Push (nOS_Signal *signal, void *arg)
+ {
+     uint16_t w = (uint16_t)signal->r + signal->bcount;
+
+     signal->buffer[w < signal->bmax ? w : (w - signal->bmax)] = arg;
+     signal->bcount++;
+ }
+ static void* _Pop (nOS_Signal *signal)
+ {
+     void *arg = signal->buffer[signal->r];
+
+     signal->r = _NextIndex(signal, signal->r);
+     signal->bcount--;
+
+     return arg;
+ }
+#endif
+
+/* Take up to max highest prio raised signals in the same critical section, then call their callback outside of it.
+ * Return number of signals taken. */
+static uint8_t _Process (uint8_t max)
+{
+    nOS_StatusReg       sr;
+    nOS_Signal          *signal;
+    _Item               items[NOS_CONFIG_PROCESS_BATCH_SIZE];
+    uint8_t             count = 0;
+    uint8_t             i;
+
+    nOS_EnterCritical(sr);
+    signal = (nOS_Signal *)_FindHighestPrio();
+    while ((signal != NULL) && (count < max) && (signal->state & NOS_SIGNAL_RAISED)) {
+        _RemoveFromList(signal);
+        nOS_Trace(NOS_TRACE_SIGNAL, signal, 0);
+
+        items[count].signal   = signal;
+        items[count].callback = signal->callback;
+#if (NOS_CONFIG_SIGNAL_QUEUE_ENABLE > 0)
+        if (signal->bmax > 0) {
+            items[count].arg  = _Pop(signal);
+        } else
+#endif
+        {
+            items[count].arg  = signal->arg;
+        }
+        count++;
+
+#if (NOS_CONFIG_SIGNAL_QUEUE_ENABLE > 0)
+        if (signal->bcount > 0) {
+            /* More raises pending, process them after other raised signals of same prio */
+            _AppendToList(signal);
+        } else
+#endif
+        {
+            signal->state = (nOS_SignalState)(signal->state &~ NOS_SIGNAL_RAISED);
+        }
+
+        signal = (nOS_Signal *)_FindHighestPrio();
+    }
+    nOS_LeaveCritical(sr);
+
+    for (i = 0; i < count; i++) {
+        if (items[i].callback != NULL) {
+            items[i].callback(items[i].signal, items[i].arg);
+        }
+    }
+
+    return count;
+}
+
 #if (NOS_CONFIG_SIGNAL_THREAD_ENABLE > 0)
 #if (NOS_CONFIG_THREAD_JOIN_ENABLE > 0)
 static int _Thread (void *arg)
@@ -98,7 +156,7 @@ static void _Thread (void *arg)
     NOS_UNUSED(arg);
 
     while (1) {
-        nOS_SignalProcess();
+        _Process(NOS_CONFIG_PROCESS_BATCH_SIZE);
 
         nOS_EnterCritical(sr);
         if (_FindHighestPrio() == NULL) {
@@ -125,8 +183,8 @@ static void _Thread (void *arg)
 void nOS_InitSignal (void)
 {
 #if (NOS_CONFIG_SIGNAL_HIGHEST_PRIO > 0)
-    uint8_t i;
-    for (i = 0; i < NOS_CONFIG_SIGNAL_HIGHEST_PRIO; i++) {
+    uint16_t i;
+    for (i = 0; i <= NOS_CONFIG_SIGNAL_HIGHEST_PRIO; i++) {
         nOS_InitList(&_list[i]);
     }
 #else
@@ -153,6 +211,12 @@ void nOS_InitSignal (void)
  #endif
  #if (NOS_CONFIG_THREAD_NAME_ENABLE > 0)
                     ,"nOS_Signal"
+ #endif
+ #if (NOS_CONFIG_THREAD_FPU_ENABLE > 0)
+                    ,true   /* Callbacks can use FPU */
+ #endif
+ #if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+                    ,0      /* Service threads run on core 0 with tick */
  #endif
                     );
 #endif
@@ -160,27 +224,12 @@ void nOS_InitSignal (void)
 
 void nOS_SignalProcess (void)
 {
-    nOS_StatusReg       sr;
-    nOS_Signal          *signal  = NULL;
-    nOS_SignalCallback  callback = NULL;
-    void                *arg     = NULL;
-
-    nOS_EnterCritical(sr);
-    signal = (nOS_Signal *)_FindHighestPrio();
-    if (signal != NULL) {
-        if (signal->state & NOS_SIGNAL_RAISED) {
-            signal->state = (nOS_SignalState)(signal->state &~ NOS_SIGNAL_RAISED);
-            _RemoveFromList(signal);
-
-            callback = signal->callback;
-            arg      = signal->arg;
-        }
-    }
-    nOS_LeaveCritical(sr);
+    _Process(1);
+}
 
-    if (callback != NULL) {
-        callback(signal, arg);
-    }
+uint8_t nOS_SignalProcessBatch (void)
+{
+    return _Process(NOS_CONFIG_PROCESS_BATCH_SIZE);
 }
 
 nOS_Error nOS_SignalCreate (nOS_Signal *signal,
@@ -219,7 +268,13 @@ nOS_Error nOS_SignalCreate (nOS_Signal *signal,
 #if (NOS_CONFIG_SIGNAL_HIGHEST_PRIO > 0)
             signal->prio         = prio;
 #endif
-            signal->node.payload = (void *)signal;
+#if (NOS_CONFIG_SIGNAL_QUEUE_ENABLE > 0)
+            signal->buffer       = NULL;
+            signal->bmax         = 0;
+            signal->bcount       = 0;
+            signal->r            = 0;
+#endif
+            nOS_SetNodeOwner(&signal->node, signal);
 
             err = NOS_OK;
         }
@@ -251,6 +306,9 @@ nOS_Error nOS_SignalDelete (nOS_Signal *signal)
             if (signal->state & NOS_SIGNAL_RAISED) {
                 _RemoveFromList(signal);
             }
+#if (NOS_CONFIG_SIGNAL_QUEUE_ENABLE > 0)
+            signal->bcount          = 0;
+#endif
             signal->state           = NOS_SIGNAL_DELETED;
 
             err = NOS_OK;
@@ -280,11 +338,27 @@ nOS_Error nOS_SignalSend (nOS_Signal *signal, void *arg)
         } else
 #endif
         if (signal->state & NOS_SIGNAL_RAISED) {
-            err = NOS_E_OVERFLOW;
+#if (NOS_CONFIG_SIGNAL_QUEUE_ENABLE > 0)
+            if (signal->bcount < signal->bmax) {
+                /* Already in list of raised signals, only keep argument */
+                _Push(signal, arg);
+                err = NOS_OK;
+            } else
+#endif
+            {
+                err = NOS_E_OVERFLOW;
+            }
         }
         else {
             signal->state = (nOS_SignalState)(signal->state | NOS_SIGNAL_RAISED);
-            signal->arg   = arg;
+#if (NOS_CONFIG_SIGNAL_QUEUE_ENABLE > 0)
+            if (signal->bmax > 0) {
+                _Push(signal, arg);
+            } else
+#endif
+            {
+                signal->arg = arg;
+            }
             _AppendToList(signal);
 
 #if (NOS_CONFIG_SIGNAL_THREAD_ENABLE > 0)
@@ -370,6 +444,45 @@ nOS_Error nOS_SignalSetPrio (nOS_Signal *signal, uint8_t prio)
 }
 #endif  /* NOS_CONFIG_SIGNAL_HIGHEST_PRIO */
 
+#if (NOS_CONFIG_SIGNAL_QUEUE_ENABLE > 0)
+nOS_Error nOS_SignalSetQueue (nOS_Signal *signal, void **buffer, uint8_t bmax)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (signal == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if ((buffer == NULL) != (bmax == 0)) {
+        err = NOS_E_INV_VAL;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (signal->state == NOS_SIGNAL_DELETED) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        if (signal->state & NOS_SIGNAL_RAISED) {
+            err = NOS_E_INV_STATE;
+        }
+        else {
+            signal->buffer = buffer;
+            signal->bmax   = bmax;
+            signal->bcount = 0;
+            signal->r      = 0;
+
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+#endif
+
 bool nOS_SignalIsRaised (nOS_Signal *signal)
 {
     nOS_StatusReg   sr;
@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2014-2016 Jim Tremblay
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#define NOS_PRIVATE
+#include "nOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if (NOS_CONFIG_STREAM_ENABLE > 0)
+/* Write index is only modified by producer and read index is only modified by consumer. One block is always kept
+ * empty to differentiate a full stream from an empty one. */
+#define _NextIndex(s,i)                 ((nOS_StreamCounter)(((i) + 1) < (s)->bmax ? ((i) + 1) : 0))
+
+nOS_Error nOS_StreamCreate (nOS_Stream *stream, void *buffer, nOS_StreamCounter bsize, nOS_StreamCounter bmax)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (stream == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (buffer == NULL) {
+        err = NOS_E_NULL;
+    }
+    else if (bsize == 0) {
+        err = NOS_E_INV_VAL;
+    }
+    else if (bmax < 2) {
+        err = NOS_E_INV_VAL;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (stream->e.type != NOS_EVENT_INVALID) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        {
+            nOS_CreateEvent((nOS_Event*)stream
+#if (NOS_CONFIG_SAFE > 0)
+                           ,NOS_EVENT_STREAM
+#endif
+                           );
+            stream->buffer = (uint8_t*)buffer;
+            stream->bsize  = bsize;
+            stream->bmax   = bmax;
+            stream->r      = 0;
+            stream->w      = 0;
+
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+
+#if (NOS_CONFIG_STREAM_DELETE_ENABLE > 0)
+nOS_Error nOS_StreamDelete (nOS_Stream *stream)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (stream == NULL) {
+        err = NOS_E_INV_OBJ;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (stream->e.type != NOS_EVENT_STREAM) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        {
+            stream->r      = 0;
+            stream->w      = 0;
+            stream->buffer = NULL;
+            stream->bsize  = 0;
+            stream->bmax   = 0;
+            nOS_DeleteEvent((nOS_Event*)stream);
+
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+#endif
+
+/* Can be called from producer thread or ISR, never wait */
+nOS_Error nOS_StreamWrite (nOS_Stream *stream, void *block)
+{
+    nOS_Error           err;
+    nOS_StatusReg       sr;
+    nOS_StreamCounter   w;
+    nOS_StreamCounter   next;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (stream == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (stream->e.type != NOS_EVENT_STREAM) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (block == NULL) {
+        err = NOS_E_NULL;
+    } else
+#endif
+    {
+        w = stream->w;
+        next = _NextIndex(stream, w);
+        if (next == stream->r) {
+            err = NOS_E_FULL;
+        }
+        else {
+            memcpy(&stream->buffer[(size_t)w * (size_t)stream->bsize], block, stream->bsize);
+            /* Block must be written before being published to consumer */
+            nOS_MemoryBarrier();
+            stream->w = next;
+            /* Write index must be published before checking if consumer is waiting */
+            nOS_MemoryBarrier();
+            /* Consumer can only wait when stream is empty, wake it up only in this case */
+            if (stream->e.waitList.head != NULL) {
+                nOS_EnterCritical(sr);
+                if (nOS_SendEvent((nOS_Event*)stream, NOS_OK) != NULL) {
+#if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
+                    /* Verify if a highest prio thread is ready to run */
+                    nOS_Schedule();
+#endif
+                }
+                nOS_LeaveCritical(sr);
+            }
+            err = NOS_OK;
+        }
+    }
+
+    return err;
+}
+
+/* Can be called from consumer thread only, or from ISR without waiting */
+nOS_Error nOS_StreamRead (nOS_Stream *stream, void *block, nOS_TickCounter timeout)
+{
+    nOS_Error           err;
+    nOS_StatusReg       sr;
+    nOS_StreamCounter   r;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (stream == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (stream->e.type != NOS_EVENT_STREAM) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (block == NULL) {
+        err = NOS_E_NULL;
+    } else
+#endif
+    {
+        r = stream->r;
+        if (r != stream->w) {
+            err = NOS_OK;
+        }
+        else if (timeout == NOS_NO_WAIT) {
+            err = NOS_E_EMPTY;
+        }
+        else {
+            nOS_EnterCritical(sr);
+            /* Producer can't write between this check and the wait, or it will see the consumer waiting */
+            if (r != stream->w) {
+                err = NOS_OK;
+            }
+            else {
+                err = nOS_WaitForEvent((nOS_Event*)stream,
+                                       NOS_THREAD_READING_STREAM
+#if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0)
+                                      ,timeout
+#elif (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
+                                      ,NOS_WAIT_INFINITE
+#endif
+                                      );
+            }
+            nOS_LeaveCritical(sr);
+        }
+
+        if (err == NOS_OK) {
+            /* Block must not be read before write index has been checked */
+            nOS_MemoryBarrier();
+            memcpy(block, &stream->buffer[(size_t)r * (size_t)stream->bsize], stream->bsize);
+            /* Block must be read before being released to producer */
+            nOS_MemoryBarrier();
+            stream->r = _NextIndex(stream, r);
+        }
+    }
+
+    return err;
+}
+
+nOS_StreamCounter nOS_StreamGetCount (nOS_Stream *stream)
+{
+    nOS_StreamCounter   r;
+    nOS_StreamCounter   w;
+    nOS_StreamCounter   bcount;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (stream == NULL) {
+        bcount = 0;
+    }
+    else if (stream->e.type != NOS_EVENT_STREAM) {
+        bcount = 0;
+    } else
+#endif
+    {
+        r = stream->r;
+        w = stream->w;
+        bcount = (w >= r) ? (w - r) : (stream->bmax - r + w);
+    }
+
+    return bcount;
+}
+#endif  /* NOS_CONFIG_STREAM_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
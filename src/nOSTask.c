@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2014-2016 Jim Tremblay
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#define NOS_PRIVATE
+#include "nOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if (NOS_CONFIG_TASK_ENABLE > 0)
+/* Stackless tasks are linked in creation order and all dispatched in turn on the same stack. Tasks never block: they
+ * leave their handler when they have to wait and dispatcher sleep only when all of them are waiting, until an object
+ * they can wait on change or until nearest sleeping task has to wake up. */
+#if (NOS_CONFIG_TASK_THREAD_ENABLE > 0)
+ #if (NOS_CONFIG_THREAD_JOIN_ENABLE > 0)
+  static int _Thread (void *arg);
+ #else
+  static void _Thread (void *arg);
+ #endif
+#endif
+
+static nOS_List                 _list;
+static nOS_Node                 *_next;
+static bool                     _pending;
+#if (NOS_CONFIG_TASK_THREAD_ENABLE > 0)
+ static nOS_Thread              _thread;
+ #ifdef NOS_SIMULATED_STACK
+  static nOS_Stack              _stack;
+ #else
+  static nOS_Stack              _stack[NOS_CONFIG_TASK_THREAD_STACK_SIZE];
+ #endif
+#endif
+
+static void _RemoveTask (nOS_Task *task)
+{
+    /* Keep dispatch position valid if next task to run is removed */
+    if (_next == &task->node) {
+        _next = task->node.next;
+    }
+    nOS_RemoveFromList(&_list, &task->node);
+    task->state = NOS_TASK_DELETED;
+}
+
+#if (NOS_CONFIG_TASK_THREAD_ENABLE > 0)
+#if (NOS_CONFIG_THREAD_JOIN_ENABLE > 0)
+static int _Thread (void *arg)
+#else
+static void _Thread (void *arg)
+#endif
+{
+    nOS_StatusReg   sr;
+    nOS_TickCounter wait;
+
+    NOS_UNUSED(arg);
+
+    while (1) {
+        wait = nOS_TaskProcess();
+
+        if (wait == 0) {
+            /* Let other threads of same prio run between passes */
+            nOS_Yield();
+        }
+        else {
+            nOS_EnterCritical(sr);
+            /* Don't sleep if an object has changed since the end of last pass */
+            if (!_pending) {
+#if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0) || (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
+                nOS_WaitForEvent(NULL, NOS_THREAD_ON_HOLD, wait);
+#else
+                /* Can't wait for sleeping tasks without timeout, poll them */
+                if (wait == NOS_WAIT_INFINITE) {
+                    nOS_WaitForEvent(NULL, NOS_THREAD_ON_HOLD);
+                }
+#endif
+            }
+            nOS_LeaveCritical(sr);
+        }
+
+#if (NOS_CONFIG_THREAD_JOIN_ENABLE > 0)
+        if (false) break; /* Remove "statement is unreachable" warning */
+    }
+
+    return 0;
+#else
+    }
+#endif
+}
+#endif  /* NOS_CONFIG_TASK_THREAD_ENABLE */
+
+void nOS_InitTask (void)
+{
+    nOS_InitList(&_list);
+    _next    = NULL;
+    _pending = false;
+#if (NOS_CONFIG_TASK_THREAD_ENABLE > 0)
+    nOS_ThreadCreate(&_thread,
+                     _Thread,
+                     NULL
+ #ifdef NOS_SIMULATED_STACK
+                    ,&_stack
+ #else
+                    ,_stack
+ #endif
+                    ,NOS_CONFIG_TASK_THREAD_STACK_SIZE
+ #ifdef NOS_USE_SEPARATE_CALL_STACK
+                    ,NOS_CONFIG_TASK_THREAD_CALL_STACK_SIZE
+ #endif
+ #if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
+                    ,NOS_CONFIG_TASK_THREAD_PRIO
+ #endif
+ #if (NOS_CONFIG_THREAD_SUSPEND_ENABLE > 0)
+                    ,NOS_THREAD_READY
+ #endif
+ #if (NOS_CONFIG_THREAD_NAME_ENABLE > 0)
+                    ,"nOS_Task"
+ #endif
+ #if (NOS_CONFIG_THREAD_FPU_ENABLE > 0)
+                    ,true   /* Tasks can use FPU */
+ #endif
+ #if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+                    ,0      /* Service threads run on core 0 with tick */
+ #endif
+                    );
+#endif
+}
+
+/* Called from critical section each time an object that tasks can wait on has changed */
+void nOS_WakeUpTasks (void)
+{
+    _pending = true;
+#if (NOS_CONFIG_TASK_THREAD_ENABLE > 0)
+    if ((_thread.state & NOS_THREAD_WAITING_MASK) == NOS_THREAD_ON_HOLD) {
+        nOS_WakeUpThread(&_thread, NOS_OK);
+ #if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
+        /* Verify if a highest prio thread is ready to run */
+        nOS_Schedule();
+ #endif
+    }
+#endif
+}
+
+nOS_TickCounter nOS_TaskProcess (void)
+{
+    nOS_StatusReg   sr;
+    nOS_Task        *task;
+    nOS_TaskResult  res;
+    nOS_TickCounter wait = NOS_WAIT_INFINITE;
+    nOS_TickCounter ticks;
+
+    nOS_EnterCritical(sr);
+    _pending = false;
+    _next = _list.head;
+    while (_next != NULL) {
+        task = nOS_GetNodeOwner(_next, nOS_Task, node);
+        _next = _next->next;
+        nOS_LeaveCritical(sr);
+
+        /* Handler run outside of critical section, it can create or delete any task */
+        res = task->handler(task, task->arg);
+
+        nOS_EnterCritical(sr);
+        if (res == NOS_TASK_ENDED) {
+            if (task->state != NOS_TASK_DELETED) {
+                _RemoveTask(task);
+            }
+        }
+        else if (res == NOS_TASK_YIELDED) {
+            wait = 0;
+        }
+        else if (res == NOS_TASK_SLEEPING) {
+            ticks = (nOS_TickCounter)(task->tick - nOS_tickCounter);
+            if (ticks > (NOS_TICK_COUNT_MAX >> 1)) {
+                /* Already elapsed */
+                ticks = 0;
+            }
+            if (ticks < wait) {
+                wait = ticks;
+            }
+        }
+    }
+    if (_pending) {
+        /* An object has changed during pass, waiting tasks have to try again */
+        wait = 0;
+    }
+    nOS_LeaveCritical(sr);
+
+    return wait;
+}
+
+nOS_Error nOS_TaskCreate (nOS_Task *task, nOS_TaskHandler handler, void *arg)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (task == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (handler == NULL) {
+        err = NOS_E_NULL;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (task->state != NOS_TASK_DELETED) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        {
+            task->state        = NOS_TASK_CREATED;
+            task->handler      = handler;
+            task->arg          = arg;
+            task->tick         = 0;
+            task->line         = 0;
+            nOS_SetNodeOwner(&task->node, task);
+            nOS_AppendToList(&_list, &task->node);
+            nOS_WakeUpTasks();
+
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+
+#if (NOS_CONFIG_TASK_DELETE_ENABLE > 0)
+nOS_Error nOS_TaskDelete (nOS_Task *task)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (task == NULL) {
+        err = NOS_E_INV_OBJ;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (task->state == NOS_TASK_DELETED) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        {
+            _RemoveTask(task);
+
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+#endif
+
+void nOS_TaskWakeUp (void)
+{
+    nOS_StatusReg   sr;
+
+    nOS_EnterCritical(sr);
+    nOS_WakeUpTasks();
+    nOS_LeaveCritical(sr);
+}
+#endif  /* NOS_CONFIG_TASK_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
@@ -13,14 +13,38 @@
 extern "C" {
 #endif
 
-#if (NOS_CONFIG_THREAD_SUSPEND_ENABLE > 0)
-static void _SuspendThread (void *payload, void *arg)
-{
-    nOS_Thread *thread = (nOS_Thread*)payload;
+#if (NOS_CONFIG_THREAD_STACK_USAGE_ENABLE > 0)
+/* Same pattern as ports debug painting, index 0 is the deepest word of stack */
+ #define _STACK_PATTERN                 ((nOS_Stack)~(nOS_Stack)0)
+ #ifdef NOS_STACK_GROW_UP
+  #define _StackWord(t,i)               ((t)->stackBase[(t)->stackSize - 1 - (i)])
+ #else
+  #define _StackWord(t,i)               ((t)->stackBase[(i)])
+ #endif
 
-    /* Avoid warning */
-    NOS_UNUSED(arg);
+static nOS_Node     *_scanNode;
+static size_t       _scanIndex;
+#endif
 
+#if (NOS_CONFIG_THREAD_SPAWN_ENABLE > 0)
+/* Pooled thread objects are linked in their free list by readyWait node, unused while thread is not ready or waiting.
+ * Free thread objects keep state of their last thread (finished or stopped) until they are spawned again. */
+ #define _SPAWN_FREE                    1
+ #define _SPAWN_DETACHED                2
+ #define _SPAWN_JOINABLE                3
+
+static nOS_List     _spawnList;
+static nOS_Thread   _spawnThreads[NOS_CONFIG_THREAD_SPAWN_COUNT];
+ #ifdef NOS_SIMULATED_STACK
+static nOS_Stack    _spawnStacks[NOS_CONFIG_THREAD_SPAWN_COUNT];
+ #else
+static nOS_Stack    _spawnStacks[NOS_CONFIG_THREAD_SPAWN_COUNT][NOS_CONFIG_THREAD_SPAWN_STACK_SIZE];
+ #endif
+#endif
+
+#if (NOS_CONFIG_THREAD_SUSPEND_ENABLE > 0)
+static void _SuspendThread (nOS_Thread *thread)
+{
     /* If thread not already suspended */
     if ( !(thread->state & NOS_THREAD_SUSPENDED) ) {
         if (thread->state == NOS_THREAD_READY) {
@@ -30,12 +54,8 @@ static void _SuspendThread (void *payload, void *arg)
     }
 }
 
-static void _ResumeThread (void *payload, void *arg)
+static void _ResumeThread (nOS_Thread *thread)
 {
-    nOS_Thread  *thread = (nOS_Thread*)payload;
-
-    NOS_UNUSED(arg);
-
     if (thread->state & NOS_THREAD_SUSPENDED) {
         thread->state = (nOS_ThreadState)(thread->state &~ NOS_THREAD_SUSPENDED);
         if (thread->state == NOS_THREAD_READY) {
@@ -43,12 +63,60 @@ static void _ResumeThread (void *payload, void *arg)
         }
     }
 }
+
+ #if (NOS_CONFIG_THREAD_SUSPEND_ALL_ENABLE > 0)
+static void _SuspendNode (void *node, void *arg)
+{
+    /* Avoid warning */
+    NOS_UNUSED(arg);
+
+    _SuspendThread(nOS_GetNodeOwner((nOS_Node*)node, nOS_Thread, node));
+}
+
+static void _ResumeNode (void *node, void *arg)
+{
+    NOS_UNUSED(arg);
+
+    _ResumeThread(nOS_GetNodeOwner((nOS_Node*)node, nOS_Thread, node));
+}
+ #endif
 #endif  /* NOS_CONFIG_THREAD_SUSPEND_ENABLE */
 
+#if (NOS_CONFIG_THREAD_SPAWN_ENABLE > 0)
+/* Called from critical section when spawned thread is deleted or when nothing more can be collected from it */
+static void _FreeSpawnThread (nOS_Thread *thread)
+{
+ #if (NOS_CONFIG_THREAD_SUSPEND_ALL_ENABLE > 0) || (NOS_CONFIG_THREAD_STACK_USAGE_ENABLE > 0)
+    if (thread->state == NOS_THREAD_FINISHED) {
+        /* Finished thread is still in list of all threads, deleted one has been removed already */
+  #if (NOS_CONFIG_THREAD_STACK_USAGE_ENABLE > 0)
+        if (_scanNode == &thread->node) {
+            _scanNode = NULL;
+        }
+  #endif
+        nOS_RemoveFromList(&nOS_allThreadsList, &thread->node);
+    }
+ #endif
+    thread->spawn = _SPAWN_FREE;
+    nOS_AppendToList(&_spawnList, &thread->readyWait);
+}
+#endif
+
+#if (NOS_CONFIG_THREAD_BUDGET_ENABLE > 0)
+/* Called from critical section when thread is removed from scheduler or its budget is changed */
+static void _CancelBudget (nOS_Thread *thread)
+{
+    if (thread->depleted) {
+        nOS_RemoveFromList(&nOS_depletedThreadsList, &thread->budgetNode);
+        thread->depleted = false;
+    }
+}
+#endif
+
 #if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0) || (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
-void nOS_TickThread (void *payload, void *arg)
+void nOS_TickThread (void *node, void *arg)
 {
-    nOS_Thread      *thread = (nOS_Thread*)payload;
+    nOS_Thread      *thread = nOS_GetNodeOwner((nOS_Node*)node, nOS_Thread, tout);
     nOS_ThreadState state   = (nOS_ThreadState)(thread->state & NOS_THREAD_WAITING_MASK);
     nOS_TickCounter ticks   = *(nOS_TickCounter *)arg;
     nOS_Error       err;
@@ -65,11 +133,10 @@ void nOS_TickThread (void *payload, void *arg)
 }
 #endif  /* NOS_CONFIG_WAITING_TIMEOUT_ENABLE & NOS_CONFIG_SLEEP_ENABLE & NOS_CONFIG_SLEEP_UNTIL_ENABLE */
 
-void nOS_WakeUpThread (nOS_Thread *thread, nOS_Error err)
+/* Called from critical section, clear waiting state of thread and return true if it is now ready to run */
+static bool _ReleaseThread (nOS_Thread *thread, nOS_Error err)
 {
-    if (thread->event != NULL) {
-        nOS_RemoveFromList(&thread->event->waitList, &thread->readyWait);
-    }
+    nOS_Trace(NOS_TRACE_WAKEUP, thread, -err);
     thread->error = (int)err;
     thread->state = (nOS_ThreadState)(thread->state &~ NOS_THREAD_WAITING_MASK);
 #if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0) || (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
@@ -78,11 +145,57 @@ void nOS_WakeUpThread (nOS_Thread *thread, nOS_Error err)
         nOS_RemoveFromList(&nOS_timeoutThreadsList, &thread->tout);
     }
 #endif
-    if (thread->state == NOS_THREAD_READY) {
+
+    return (thread->state == NOS_THREAD_READY);
+}
+
+void nOS_WakeUpThread (nOS_Thread *thread, nOS_Error err)
+{
+    if (thread->event != NULL) {
+        nOS_RemoveFromList(&thread->event->waitList, &thread->readyWait);
+    }
+    if (_ReleaseThread(thread, err)) {
         nOS_AppendThreadToReadyList(thread);
     }
 }
 
+/* Called from critical section with a list of waiting threads already detached from their event, threads are not
+ * removed from it one by one and list is empty on return. Following threads of same priority are appended to their
+ * ready list without updating ready bitmaps again. */
+void nOS_WakeUpThreads (nOS_List *list, nOS_Error err)
+{
+    nOS_Node    *it = list->head;
+    nOS_Thread  *thread;
+#if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0) && (NOS_CONFIG_SMP_CORE_COUNT == 1)
+    nOS_Thread  *last = NULL;
+#endif
+
+    while (it != NULL) {
+        thread = nOS_GetNodeOwner(it, nOS_Thread, readyWait);
+        it = it->next;
+        thread->event = NULL;
+        if (_ReleaseThread(thread, err)) {
+#if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0) && (NOS_CONFIG_SMP_CORE_COUNT == 1)
+            if ((last != NULL) && (last->prio == thread->prio)
+ #if (NOS_CONFIG_SCHED_EDF_ENABLE > 0)
+                /* EDF level is kept sorted by deadline */
+                && (thread->prio != NOS_CONFIG_SCHED_EDF_PRIO)
+ #endif
+               ) {
+                /* Ready bitmap already set by previous thread */
+                nOS_AppendToList(&nOS_readyThreadsList[thread->prio], &thread->readyWait);
+            } else {
+                nOS_AppendThreadToReadyList(thread);
+            }
+            last = thread;
+#else
+            nOS_AppendThreadToReadyList(thread);
+#endif
+        }
+    }
+    nOS_InitList(list);
+}
+
 #if (NOS_CONFIG_THREAD_JOIN_ENABLE > 0)
 int nOS_ThreadWrapper (void *arg)
 {
@@ -96,18 +209,32 @@ int nOS_ThreadWrapper (void *arg)
     nOS_EnterCritical(sr);
     nOS_runningThread->error = ret;
     nOS_runningThread->state = NOS_THREAD_FINISHED;
+#if (NOS_CONFIG_THREAD_BUDGET_ENABLE > 0)
+    _CancelBudget(nOS_runningThread);
+#endif
     do {
         thread = nOS_SendEvent((nOS_Event*)&nOS_runningThread->joined, NOS_OK);
         if (thread != NULL) {
             if (thread->ext != NULL) {
                 *(int*)thread->ext = ret;
             }
+#if (NOS_CONFIG_THREAD_SPAWN_ENABLE > 0)
+            /* Exit code has been collected by joining thread */
+            if (nOS_runningThread->spawn == _SPAWN_JOINABLE) {
+                nOS_runningThread->spawn = _SPAWN_DETACHED;
+            }
+#endif
         }
     } while (thread != NULL);
     nOS_RemoveThreadFromReadyList(nOS_runningThread);
-    nOS_LeaveCritical(sr);
-
+#if (NOS_CONFIG_THREAD_SPAWN_ENABLE > 0)
+    if (nOS_runningThread->spawn == _SPAWN_DETACHED) {
+        /* Spawning is not allowed from ISR, so context will be saved in stack before another thread take it */
+        _FreeSpawnThread(nOS_runningThread);
+    }
+#endif
     nOS_Schedule();
+    nOS_LeaveCritical(sr);
 
     /* will never go here */
     return 0;
@@ -115,7 +242,8 @@ int nOS_ThreadWrapper (void *arg)
 #endif
 
 #if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
- #if (NOS_CONFIG_THREAD_SET_PRIO_ENABLE > 0) || (NOS_CONFIG_MUTEX_ENABLE > 0)
+ #if (NOS_CONFIG_THREAD_SET_PRIO_ENABLE > 0) || (NOS_CONFIG_MUTEX_ENABLE > 0) || (NOS_CONFIG_RWLOCK_ENABLE > 0) ||             \
+     (NOS_CONFIG_THREAD_BUDGET_ENABLE > 0)
 void nOS_SetThreadPrio (nOS_Thread *thread, uint8_t prio)
 {
     if (thread->prio != prio)
@@ -129,11 +257,137 @@ void nOS_SetThreadPrio (nOS_Thread *thread, uint8_t prio)
         {
             nOS_AppendThreadToReadyList(thread);
         }
+#if (NOS_CONFIG_WAITING_PRIO_ORDER_ENABLE > 0)
+        else if ((thread->state & NOS_THREAD_WAITING_MASK) && (thread->event != NULL)
+ #if (NOS_CONFIG_WAITING_POLICY_ENABLE > 0)
+                 && (thread->event->policy == NOS_WAITING_POLICY_PRIO)
+ #endif
+                )
+        {
+            /* Keep waiting list ordered by priority */
+            nOS_RemoveFromList(&thread->event->waitList, &thread->readyWait);
+            nOS_InsertThreadToWaitList(thread->event, thread);
+        }
+#endif
     }
 }
- #endif /* NOS_CONFIG_THREAD_SET_PRIO_ENABLE || NOS_CONFIG_MUTEX_ENABLE */
+ #endif /* NOS_CONFIG_THREAD_SET_PRIO_ENABLE || NOS_CONFIG_MUTEX_ENABLE || NOS_CONFIG_RWLOCK_ENABLE || NOS_CONFIG_THREAD_BUDGET_ENABLE */
 #endif  /* NOS_CONFIG_HIGHEST_THREAD_PRIO */
 
+#if (NOS_CONFIG_THREAD_BUDGET_ENABLE > 0)
+/* Called from nOS_Tick for the thread that was running, after tick counter has been updated */
+void nOS_ChargeThread (nOS_Thread *thread, nOS_TickCounter ticks)
+{
+    if ((thread->budget > 0) && !thread->depleted) {
+        if ((nOS_TickCounter)(nOS_tickCounter - thread->replenish) <= (NOS_TICK_COUNT_MAX >> 1)) {
+            /* New period has started while thread was not depleted */
+            thread->budgetLeft = thread->budget;
+            thread->replenish = nOS_tickCounter + thread->budgetPeriod;
+        }
+        if (ticks < thread->budgetLeft) {
+            thread->budgetLeft -= ticks;
+        }
+        else {
+            /* Budget exhausted, demote thread until next replenishment */
+            thread->budgetLeft = 0;
+            thread->depleted = true;
+            thread->backupPrio = thread->prio;
+            nOS_AppendToList(&nOS_depletedThreadsList, &thread->budgetNode);
+            nOS_SetThreadPrio(thread, thread->budgetPrio);
+        }
+    }
+}
+
+void nOS_ReplenishThread (void *node, void *arg)
+{
+    nOS_Thread  *thread = nOS_GetNodeOwner((nOS_Node*)node, nOS_Thread, budgetNode);
+
+    NOS_UNUSED(arg);
+
+    if ((nOS_TickCounter)(nOS_tickCounter - thread->replenish) <= (NOS_TICK_COUNT_MAX >> 1)) {
+        _CancelBudget(thread);
+        thread->budgetLeft = thread->budget;
+        thread->replenish += thread->budgetPeriod;
+        if ((nOS_TickCounter)(nOS_tickCounter - thread->replenish) <= (NOS_TICK_COUNT_MAX >> 1)) {
+            /* More than one period missed, restart periods from now */
+            thread->replenish = nOS_tickCounter + thread->budgetPeriod;
+        }
+        /* Priority changed while demoted is kept */
+        if (thread->prio == thread->budgetPrio) {
+            nOS_SetThreadPrio(thread, thread->backupPrio);
+        }
+    }
+}
+
+nOS_Error nOS_ThreadSetBudget (nOS_Thread *thread, nOS_TickCounter budget, nOS_TickCounter period, uint8_t prio)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+    if (thread == NULL) {
+        thread = nOS_runningThread;
+    }
+
+#if (NOS_CONFIG_SAFE > 0)
+    if ((budget > period) || (prio > NOS_CONFIG_HIGHEST_THREAD_PRIO)) {
+        err = NOS_E_INV_VAL;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (thread->state == NOS_THREAD_STOPPED) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        {
+            if (thread->depleted) {
+                _CancelBudget(thread);
+                if (thread->prio == thread->budgetPrio) {
+                    nOS_SetThreadPrio(thread, thread->backupPrio);
+                }
+            }
+            thread->budget = budget;
+            thread->budgetLeft = budget;
+            thread->budgetPeriod = period;
+            thread->replenish = nOS_tickCounter + period;
+            thread->budgetPrio = prio;
+#if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
+            /* Verify if a highest prio thread is ready to run */
+            nOS_Schedule();
+#endif
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+
+nOS_TickCounter nOS_ThreadGetBudget (nOS_Thread *thread)
+{
+    nOS_StatusReg   sr;
+    nOS_TickCounter left;
+
+    if (thread == NULL) {
+        thread = nOS_runningThread;
+    }
+
+    nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+    if (thread->state == NOS_THREAD_STOPPED) {
+        left = 0;
+    } else
+#endif
+    {
+        left = thread->budgetLeft;
+    }
+    nOS_LeaveCritical(sr);
+
+    return left;
+}
+#endif  /* NOS_CONFIG_THREAD_BUDGET_ENABLE */
+
 nOS_Error nOS_ThreadCreate (nOS_Thread *thread,
                             nOS_ThreadEntry entry,
                             void *arg,
@@ -150,17 +404,26 @@ nOS_Error nOS_ThreadCreate (nOS_Thread *thread,
 #endif
 #if (NOS_CONFIG_THREAD_NAME_ENABLE > 0)
                            ,const char *name
+#endif
+#if (NOS_CONFIG_THREAD_FPU_ENABLE > 0)
+                           ,bool fpu
+#endif
+#if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+                           ,uint8_t core
 #endif
                            )
 {
     nOS_Error       err;
     nOS_StatusReg   sr;
+#if (NOS_CONFIG_THREAD_STACK_USAGE_ENABLE > 0)
+    size_t          i;
+#endif
 
 #if (NOS_CONFIG_SAFE > 0)
     if (thread == NULL) {
         err = NOS_E_INV_OBJ;
     }
-    else if (thread == &nOS_idleHandle) {
+    else if (nOS_IsIdleThread(thread)) {
         err = NOS_E_INV_OBJ;
     }
     else if (entry == NULL) {
@@ -189,6 +452,15 @@ nOS_Error nOS_ThreadCreate (nOS_Thread *thread,
         err = NOS_E_INV_STATE;
     } else
  #endif
+ #if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+  #if (NOS_CONFIG_SMP_WORK_STEALING_ENABLE > 0)
+    if ((core >= NOS_CONFIG_SMP_CORE_COUNT) && (core != NOS_THREAD_CORE_ANY)) {
+  #else
+    if (core >= NOS_CONFIG_SMP_CORE_COUNT) {
+  #endif
+        err = NOS_E_INV_VAL;
+    } else
+ #endif
 #endif
     {
         nOS_EnterCritical(sr);
@@ -200,6 +472,14 @@ nOS_Error nOS_ThreadCreate (nOS_Thread *thread,
         {
 #if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
             thread->prio = prio;
+#endif
+#if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+ #if (NOS_CONFIG_SMP_WORK_STEALING_ENABLE > 0)
+            thread->migratable = (core == NOS_THREAD_CORE_ANY);
+            thread->core = thread->migratable ? nOS_GetCoreId() : core;
+ #else
+            thread->core = core;
+ #endif
 #endif
             thread->state = NOS_THREAD_READY;
 #if (NOS_CONFIG_THREAD_SUSPEND_ENABLE > 0)
@@ -209,17 +489,60 @@ nOS_Error nOS_ThreadCreate (nOS_Thread *thread,
 #endif
             thread->event = NULL;
             thread->ext = NULL;
+#if (NOS_CONFIG_SCHED_ROUND_ROBIN_ENABLE > 0)
+            thread->quantum = NOS_CONFIG_SCHED_ROUND_ROBIN_QUANTUM;
+            thread->quantumLeft = NOS_CONFIG_SCHED_ROUND_ROBIN_QUANTUM;
+#endif
+#if (NOS_CONFIG_THREAD_BUDGET_ENABLE > 0)
+            thread->budget = 0;
+            thread->budgetLeft = 0;
+            thread->depleted = false;
+            nOS_SetNodeOwner(&thread->budgetNode, thread);
+#endif
+#if (NOS_CONFIG_THREAD_PERIODIC_ENABLE > 0)
+            thread->release = 0;
+            thread->releasePeriod = 0;
+            thread->missed = NULL;
+#endif
+#if (NOS_CONFIG_HRTIMER_ENABLE > 0)
+            thread->hrSleep.running = false;
+#endif
+#if (NOS_CONFIG_SCHED_EDF_ENABLE > 0)
+            thread->deadline = 0;
+            thread->relDeadline = 0;
+            thread->period = 0;
+#endif
 #if (NOS_CONFIG_THREAD_NAME_ENABLE > 0)
             thread->name = name;
+#endif
+#if (NOS_CONFIG_THREAD_NOTIFY_ENABLE > 0)
+            thread->notified = 0;
+            thread->notifyMask = 0;
+#endif
+#if (NOS_CONFIG_THREAD_FPU_ENABLE > 0)
+            thread->fpu = fpu;
+#endif
+#if (NOS_CONFIG_THREAD_STATS_ENABLE > 0)
+            thread->stats.runTime = 0;
+            thread->stats.switchCount = 0;
+            thread->stats.maxSlice = 0;
 #endif
             thread->error = (int)NOS_OK;
-            thread->readyWait.payload = thread;
+            nOS_SetNodeOwner(&thread->readyWait, thread);
 #if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0) || (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
-            thread->tout.payload = thread;
+            nOS_SetNodeOwner(&thread->tout, thread);
             thread->timeout = 0;
 #endif
-#if (NOS_CONFIG_THREAD_SUSPEND_ALL_ENABLE > 0)
-            thread->node.payload = thread;
+#if (NOS_CONFIG_THREAD_STACK_USAGE_ENABLE > 0)
+            thread->stackBase = stack;
+            thread->stackSize = ssize;
+            thread->stackFree = ssize;
+            for (i = 0; i < ssize; i++) {
+                stack[i] = _STACK_PATTERN;
+            }
+#endif
+#if (NOS_CONFIG_THREAD_SUSPEND_ALL_ENABLE > 0) || (NOS_CONFIG_THREAD_STACK_USAGE_ENABLE > 0)
+            nOS_SetNodeOwner(&thread->node, thread);
             nOS_AppendToList(&nOS_allThreadsList, &thread->node);
 #endif
 #if (NOS_CONFIG_THREAD_JOIN_ENABLE > 0)
@@ -264,7 +587,7 @@ nOS_Error nOS_ThreadDelete (nOS_Thread *thread)
 
 #if (NOS_CONFIG_SAFE > 0)
     /* Main thread can't be deleted */
-    if (thread == &nOS_idleHandle) {
+    if (nOS_IsIdleThread(thread)) {
         err = NOS_E_INV_OBJ;
     } else
  #if (NOS_CONFIG_SCHED_LOCK_ENABLE > 0)
@@ -280,10 +603,28 @@ nOS_Error nOS_ThreadDelete (nOS_Thread *thread)
         if (thread->state == NOS_THREAD_STOPPED) {
             err = NOS_E_INV_OBJ;
         } else
+ #if (NOS_CONFIG_THREAD_SPAWN_ENABLE > 0)
+        if (thread->spawn == _SPAWN_FREE) {
+            /* Already back in spawn pool */
+            err = NOS_E_INV_OBJ;
+        } else
+ #endif
 #endif
         {
-#if (NOS_CONFIG_THREAD_SUSPEND_ALL_ENABLE > 0)
+#if (NOS_CONFIG_THREAD_STACK_USAGE_ENABLE > 0)
+            if (_scanNode == &thread->node) {
+                /* Restart scan from first thread */
+                _scanNode = NULL;
+            }
+#endif
+#if (NOS_CONFIG_THREAD_SUSPEND_ALL_ENABLE > 0) || (NOS_CONFIG_THREAD_STACK_USAGE_ENABLE > 0)
             nOS_RemoveFromList(&nOS_allThreadsList, &thread->node);
+#endif
+#if (NOS_CONFIG_THREAD_BUDGET_ENABLE > 0)
+            _CancelBudget(thread);
+#endif
+#if (NOS_CONFIG_HRTIMER_ENABLE > 0)
+            nOS_StopHrSleep(thread);
 #endif
             if (thread->state == NOS_THREAD_READY) {
                 nOS_RemoveThreadFromReadyList(thread);
@@ -292,6 +633,16 @@ nOS_Error nOS_ThreadDelete (nOS_Thread *thread)
                 if (thread->event != NULL) {
                     nOS_RemoveFromList(&thread->event->waitList, &thread->readyWait);
                 }
+#if (NOS_CONFIG_SELECT_ENABLE > 0)
+                else if ((thread->state & NOS_THREAD_WAITING_MASK) == NOS_THREAD_SELECTING) {
+                    nOS_RemoveThreadFromSelect(thread);
+                }
+#endif
+#if (NOS_CONFIG_TIME_ENABLE > 0) && (NOS_CONFIG_TIME_WAIT_ENABLE > 0)
+                else if ((thread->state & NOS_THREAD_WAITING_MASK) == NOS_THREAD_WAITING_TIME) {
+                    nOS_RemoveThreadFromTimeWait(thread);
+                }
+#endif
 #if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0) || (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
                 if (thread->state & NOS_THREAD_WAIT_TIMEOUT) {
                     nOS_RemoveFromList(&nOS_timeoutThreadsList, &thread->tout);
@@ -305,6 +656,11 @@ nOS_Error nOS_ThreadDelete (nOS_Thread *thread)
             thread->timeout = 0;
 #endif
             thread->error   = (int)NOS_E_DELETED;
+#if (NOS_CONFIG_THREAD_SPAWN_ENABLE > 0)
+            if (thread->spawn != 0) {
+                _FreeSpawnThread(thread);
+            }
+#endif
 
             err = NOS_OK;
         }
@@ -333,7 +689,7 @@ nOS_Error nOS_ThreadAbort (nOS_Thread *thread)
     else if (thread == nOS_runningThread) {
         err = NOS_E_INV_OBJ;
     }
-    else if (thread == &nOS_idleHandle) {
+    else if (nOS_IsIdleThread(thread)) {
         err = NOS_E_INV_OBJ;
     } else
 #endif
@@ -376,7 +732,7 @@ nOS_Error nOS_ThreadSuspend (nOS_Thread *thread)
     }
 
 #if (NOS_CONFIG_SAFE > 0)
-    if (thread == &nOS_idleHandle) {
+    if (nOS_IsIdleThread(thread)) {
         err = NOS_E_INV_OBJ;
     } else
  #if (NOS_CONFIG_SCHED_LOCK_ENABLE > 0)
@@ -397,7 +753,7 @@ nOS_Error nOS_ThreadSuspend (nOS_Thread *thread)
         } else
 #endif
         {
-            _SuspendThread(thread, NULL);
+            _SuspendThread(thread);
             if (thread == nOS_runningThread) {
                 nOS_Schedule();
             }
@@ -421,7 +777,7 @@ nOS_Error nOS_ThreadResume (nOS_Thread *thread)
     else if (thread == nOS_runningThread) {
         err = NOS_E_INV_OBJ;
     }
-    else if (thread == &nOS_idleHandle) {
+    else if (nOS_IsIdleThread(thread)) {
         err = NOS_E_INV_OBJ;
     } else
 #endif
@@ -436,7 +792,7 @@ nOS_Error nOS_ThreadResume (nOS_Thread *thread)
         } else
 #endif
         {
-            _ResumeThread(thread, NULL);
+            _ResumeThread(thread);
 #if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
             /* Verify if a highest prio thread is ready to run */
             nOS_Schedule();
@@ -465,7 +821,11 @@ nOS_Error nOS_ThreadSuspendAll (void)
 #endif
     {
         nOS_EnterCritical(sr);
-        nOS_WalkInList(&nOS_allThreadsList, _SuspendThread, NULL);
+#if (NOS_CONFIG_CRITICAL_WALK_LIMIT > 0)
+        nOS_WalkInListBounded(&nOS_allThreadsList, _SuspendNode, NULL, &sr);
+#else
+        nOS_WalkInList(&nOS_allThreadsList, _SuspendNode, NULL);
+#endif
         if (nOS_runningThread != &nOS_idleHandle) {
             nOS_Schedule();
         }
@@ -482,7 +842,11 @@ nOS_Error nOS_ThreadResumeAll (void)
     nOS_StatusReg   sr;
 
     nOS_EnterCritical(sr);
-    nOS_WalkInList(&nOS_allThreadsList, _ResumeThread, NULL);
+#if (NOS_CONFIG_CRITICAL_WALK_LIMIT > 0)
+    nOS_WalkInListBounded(&nOS_allThreadsList, _ResumeNode, NULL, &sr);
+#else
+    nOS_WalkInList(&nOS_allThreadsList, _ResumeNode, NULL);
+#endif
 #if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
     /* Verify if a highest prio thread is ready to run */
     nOS_Schedule();
@@ -556,6 +920,133 @@ int16_t nOS_ThreadGetPriority (nOS_Thread *thread)
 }
 #endif  /* NOS_CONFIG_HIGHEST_THREAD_PRIO & NOS_CONFIG_THREAD_SET_PRIO_ENABLE */
 
+#if (NOS_CONFIG_SCHED_ROUND_ROBIN_ENABLE > 0)
+nOS_Error nOS_ThreadSetQuantum (nOS_Thread *thread, uint16_t quantum)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+    if (thread == NULL) {
+        thread = nOS_runningThread;
+    }
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (quantum == 0) {
+        err = NOS_E_INV_VAL;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (thread->state == NOS_THREAD_STOPPED) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        {
+            thread->quantum = quantum;
+            if (thread->quantumLeft > quantum) {
+                thread->quantumLeft = quantum;
+            }
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+#endif  /* NOS_CONFIG_SCHED_ROUND_ROBIN_ENABLE */
+
+#if (NOS_CONFIG_SCHED_EDF_ENABLE > 0)
+nOS_Error nOS_ThreadSetDeadline (nOS_Thread *thread, nOS_TickCounter deadline, nOS_TickCounter period)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+    if (thread == NULL) {
+        thread = nOS_runningThread;
+    }
+
+    nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+    if (thread->state == NOS_THREAD_STOPPED) {
+        err = NOS_E_INV_OBJ;
+    } else
+#endif
+    {
+        if (thread->state == NOS_THREAD_READY) {
+            nOS_RemoveThreadFromReadyList(thread);
+        }
+        thread->deadline = nOS_tickCounter + deadline;
+        thread->relDeadline = deadline;
+        thread->period = period;
+        if (thread->state == NOS_THREAD_READY) {
+            /* Move thread to its new position in EDF level */
+            nOS_AppendThreadToReadyList(thread);
+#if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
+            /* Verify if a highest prio thread is ready to run */
+            nOS_Schedule();
+#endif
+        }
+        err = NOS_OK;
+    }
+    nOS_LeaveCritical(sr);
+
+    return err;
+}
+
+#if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0) || (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
+nOS_Error nOS_ThreadWaitNextRelease (void)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+    nOS_TickCounter release;
+    nOS_TickCounter ticks;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (nOS_isrNestingCounter > 0) {
+        err = NOS_E_ISR;
+    } else
+ #if (NOS_CONFIG_SCHED_LOCK_ENABLE > 0)
+    /* Can't switch context when scheduler is locked */
+    if (nOS_lockNestingCounter > 0) {
+        err = NOS_E_LOCKED;
+    } else
+ #endif
+    if (nOS_runningThread == &nOS_idleHandle) {
+        err = NOS_E_IDLE;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+        if (nOS_runningThread->period == 0) {
+            err = NOS_E_INV_VAL;
+        }
+        else {
+            /* Next release is computed from current one to avoid drift */
+            release = nOS_runningThread->deadline - nOS_runningThread->relDeadline + nOS_runningThread->period;
+            ticks = release - nOS_tickCounter;
+            if ((ticks == 0) || (ticks > (NOS_TICK_COUNT_MAX >> 1))) {
+                /* Next release already reached, reorder running thread with its new deadline */
+                nOS_RemoveThreadFromReadyList(nOS_runningThread);
+                nOS_runningThread->deadline = release + nOS_runningThread->relDeadline;
+                nOS_AppendThreadToReadyList(nOS_runningThread);
+                nOS_Schedule();
+                err = NOS_E_ELAPSED;
+            }
+            else {
+                /* Thread is not in ready list while sleeping, deadline will be used when woken up */
+                nOS_runningThread->deadline = release + nOS_runningThread->relDeadline;
+                err = nOS_WaitForEvent(NULL, NOS_THREAD_SLEEPING, ticks);
+            }
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+#endif
+#endif  /* NOS_CONFIG_SCHED_EDF_ENABLE */
+
 #if (NOS_CONFIG_THREAD_NAME_ENABLE > 0)
 const char* nOS_ThreadGetName (nOS_Thread *thread)
 {
@@ -613,6 +1104,135 @@ nOS_Error nOS_ThreadSetName (nOS_Thread *thread, const char *name)
 }
 #endif  /* NOS_CONFIG_THREAD_NAME_ENABLE */
 
+#if (NOS_CONFIG_THREAD_STATS_ENABLE > 0)
+/* Called from critical section */
+static void _GetStats (nOS_Thread *thread, nOS_ThreadStats *stats)
+{
+    *stats = thread->stats;
+    if (thread == nOS_runningThread) {
+        /* Add current time slice */
+        stats->runTime += (uint32_t)(nOS_GetCycleCount() - nOS_switchCycles);
+    }
+}
+
+nOS_Error nOS_ThreadGetStats (nOS_Thread *thread, nOS_ThreadStats *stats)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (stats == NULL) {
+        err = NOS_E_NULL;
+    } else
+#endif
+    {
+        if (thread == NULL) {
+            thread = nOS_runningThread;
+        }
+
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (thread->state == NOS_THREAD_STOPPED) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        {
+            _GetStats(thread, stats);
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+
+nOS_Error nOS_GetIdleStats (nOS_ThreadStats *stats)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (stats == NULL) {
+        err = NOS_E_NULL;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+        _GetStats(&nOS_idleHandle, stats);
+        nOS_LeaveCritical(sr);
+
+        err = NOS_OK;
+    }
+
+    return err;
+}
+#endif  /* NOS_CONFIG_THREAD_STATS_ENABLE */
+
+#if (NOS_CONFIG_THREAD_STACK_USAGE_ENABLE > 0)
+size_t nOS_ThreadGetStackUsage (nOS_Thread *thread)
+{
+    size_t          usage;
+    nOS_StatusReg   sr;
+
+    if (thread == NULL) {
+        thread = nOS_runningThread;
+    }
+
+    nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+    if (thread->state == NOS_THREAD_STOPPED) {
+        usage = 0;
+    } else
+#endif
+    if (nOS_IsIdleThread(thread)) {
+        usage = 0;
+    }
+    else {
+        usage = thread->stackSize - thread->stackFree;
+    }
+    nOS_LeaveCritical(sr);
+
+    return usage;
+}
+
+void nOS_ThreadScanStack (void)
+{
+    nOS_StatusReg   sr;
+    nOS_Thread      *thread;
+    size_t          i;
+    size_t          end;
+
+    nOS_EnterCritical(sr);
+    if (_scanNode == NULL) {
+        _scanNode  = nOS_allThreadsList.head;
+        _scanIndex = 0;
+    }
+    if (_scanNode != NULL) {
+        thread = nOS_GetNodeOwner(_scanNode, nOS_Thread, node);
+        /* Words above previous watermark are already known as used */
+        end = _scanIndex + NOS_CONFIG_THREAD_STACK_SCAN_WORDS;
+        if (end > thread->stackFree) {
+            end = thread->stackFree;
+        }
+        for (i = _scanIndex; i < end; i++) {
+            if (_StackWord(thread, i) != _STACK_PATTERN) {
+                thread->stackFree = i;
+                break;
+            }
+        }
+        if (i < thread->stackFree) {
+            /* Continue with same thread on next call */
+            _scanIndex = i;
+        }
+        else {
+            _scanNode  = _scanNode->next;
+            _scanIndex = 0;
+        }
+    }
+    nOS_LeaveCritical(sr);
+}
+#endif  /* NOS_CONFIG_THREAD_STACK_USAGE_ENABLE */
+
 #if (NOS_CONFIG_THREAD_JOIN_ENABLE > 0)
 nOS_Error nOS_ThreadJoin (nOS_Thread *thread, int *ret, nOS_TickCounter timeout)
 {
@@ -631,6 +1251,12 @@ nOS_Error nOS_ThreadJoin (nOS_Thread *thread, int *ret, nOS_TickCounter timeout)
             if (ret != NULL) {
                 *ret = thread->error;
             }
+#if (NOS_CONFIG_THREAD_SPAWN_ENABLE > 0)
+            if (thread->spawn == _SPAWN_JOINABLE) {
+                /* Exit code collected, thread object can be spawned again */
+                _FreeSpawnThread(thread);
+            }
+#endif
             err = NOS_OK;
         }
         else if (timeout == NOS_NO_WAIT) {
@@ -656,6 +1282,185 @@ nOS_Error nOS_ThreadJoin (nOS_Thread *thread, int *ret, nOS_TickCounter timeout)
 }
 #endif  /* NOS_CONFIG_THREAD_JOIN_ENABLE */
 
+#if (NOS_CONFIG_THREAD_SPAWN_ENABLE > 0)
+void nOS_InitThreadSpawn (void)
+{
+    uint8_t     i;
+
+    nOS_InitList(&_spawnList);
+    for (i = 0; i < NOS_CONFIG_THREAD_SPAWN_COUNT; i++) {
+        nOS_SetNodeOwner(&_spawnThreads[i].readyWait, &_spawnThreads[i]);
+        _FreeSpawnThread(&_spawnThreads[i]);
+    }
+}
+
+nOS_Thread* nOS_ThreadSpawn (nOS_ThreadEntry entry,
+                             void *arg,
+                             bool join
+#if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
+                            ,uint8_t prio
+#endif
+                            )
+{
+    nOS_StatusReg   sr;
+    nOS_Thread      *thread;
+    nOS_Stack       *stack;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (nOS_isrNestingCounter > 0) {
+        thread = NULL;
+    }
+    else if (entry == NULL) {
+        thread = NULL;
+    } else
+ #if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
+    if (prio > NOS_CONFIG_HIGHEST_THREAD_PRIO) {
+        thread = NULL;
+    } else
+ #endif
+#endif
+    {
+        nOS_EnterCritical(sr);
+        thread = nOS_GetHeadOfList(&_spawnList, nOS_Thread, readyWait);
+        if (thread != NULL) {
+            nOS_RemoveFromList(&_spawnList, &thread->readyWait);
+#ifdef NOS_SIMULATED_STACK
+            stack = &_spawnStacks[thread - _spawnThreads];
+#else
+            stack = _spawnStacks[thread - _spawnThreads];
+#endif
+            /* Set before creation, a higher prio spawned thread can run and return before nOS_ThreadCreate return */
+            thread->state = NOS_THREAD_STOPPED;
+            thread->spawn = join ? _SPAWN_JOINABLE : _SPAWN_DETACHED;
+            nOS_ThreadCreate(thread,
+                             entry,
+                             arg,
+                             stack,
+                             NOS_CONFIG_THREAD_SPAWN_STACK_SIZE
+#ifdef NOS_USE_SEPARATE_CALL_STACK
+                            ,NOS_CONFIG_THREAD_SPAWN_CALL_STACK_SIZE
+#endif
+#if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
+                            ,prio
+#endif
+#if (NOS_CONFIG_THREAD_SUSPEND_ENABLE > 0)
+                            ,NOS_THREAD_READY
+#endif
+#if (NOS_CONFIG_THREAD_NAME_ENABLE > 0)
+                            ,"nOS_Spawn"
+#endif
+#if (NOS_CONFIG_THREAD_FPU_ENABLE > 0)
+                            ,true   /* Entry is not known in advance */
+#endif
+#if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+ #if (NOS_CONFIG_SMP_WORK_STEALING_ENABLE > 0)
+                            ,NOS_THREAD_CORE_ANY
+ #else
+                            ,nOS_GetCoreId()
+ #endif
+#endif
+                            );
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return thread;
+}
+#endif  /* NOS_CONFIG_THREAD_SPAWN_ENABLE */
+
+#if (NOS_CONFIG_THREAD_NOTIFY_ENABLE > 0)
+nOS_Error nOS_ThreadNotify (nOS_Thread *thread, uint32_t bits, nOS_NotifyAction action)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (thread == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if ((action != NOS_NOTIFY_SET_BITS) && (action != NOS_NOTIFY_INCREMENT) && (action != NOS_NOTIFY_OVERWRITE)) {
+        err = NOS_E_INV_VAL;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (thread->state == NOS_THREAD_STOPPED) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        {
+            if (action == NOS_NOTIFY_SET_BITS) {
+                thread->notified |= bits;
+            }
+            else if (action == NOS_NOTIFY_INCREMENT) {
+                thread->notified += bits;
+            }
+            else {
+                thread->notified = bits;
+            }
+            /* Mask is only set while thread is waiting for notification */
+            if ((thread->notified & thread->notifyMask) != 0) {
+                thread->notifyMask = 0;
+                nOS_WakeUpThread(thread, NOS_OK);
+#if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
+                /* Verify if a highest prio thread is ready to run */
+                nOS_Schedule();
+#endif
+            }
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+
+nOS_Error nOS_ThreadNotifyWait (uint32_t mask, uint32_t *value, nOS_TickCounter timeout)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (mask == 0) {
+        err = NOS_E_INV_VAL;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+        if ((nOS_runningThread->notified & mask) != 0) {
+            err = NOS_OK;
+        }
+        else if (timeout == NOS_NO_WAIT) {
+            /* Calling thread can't wait. */
+            err = NOS_E_AGAIN;
+        }
+        else {
+            nOS_runningThread->notifyMask = mask;
+            /* Calling thread must wait to be notified, no event and no waiting list needed. */
+            err = nOS_WaitForEvent(NULL,
+                                   NOS_THREAD_WAITING_NOTIFY
+#if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0)
+                                  ,timeout
+#elif (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
+                                  ,NOS_WAIT_INFINITE
+#endif
+                                  );
+            nOS_runningThread->notifyMask = 0;
+        }
+        if (err == NOS_OK) {
+            if (value != NULL) {
+                *value = nOS_runningThread->notified;
+            }
+            nOS_runningThread->notified &= ~mask;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+#endif  /* NOS_CONFIG_THREAD_NOTIFY_ENABLE */
+
 #ifdef __cplusplus
 }
 #endif
@@ -23,47 +23,131 @@ extern "C" {
  static uint16_t            _prescaler;
 #endif
 static nOS_Time             _time;
+#if (NOS_CONFIG_TIME_DATE_CACHE_ENABLE > 0)
+ static nOS_TimeDate        _timedate;  /* Always equal to converted _time */
+#endif
+#if (NOS_CONFIG_TIME_PRECISE_ENABLE > 0)
+ static volatile uint16_t   _seq;
+ static nOS_TimePrecise     _precise[2];
+#endif
 #if (NOS_CONFIG_TIME_WAIT_ENABLE > 0)
- static nOS_Event           _event;
+ static nOS_List            _waitList;  /* Sorted by time, next thread to wake up is at head */
 #endif
 static NOS_CONST uint8_t    _daysPerMonth[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
 
 #if (NOS_CONFIG_TIME_WAIT_ENABLE > 0)
-static void _TickTime(void *payload, void *arg)
+/* Waiting thread context, lives on stack of waiting thread and is linked in sorted wait list */
+typedef struct _WaitContext
+{
+    nOS_Time    time;
+    nOS_Thread  *thread;
+    nOS_Node    node;
+} _WaitContext;
+
+#define _GetHeadOfWaitList()            nOS_GetHeadOfList(&_waitList, _WaitContext, node)
+
+/* Called from critical section, insert thread after all waiting threads with same or earlier time */
+static void _InsertToWaitList (_WaitContext *ctx)
 {
-    nOS_Thread  *thread = (nOS_Thread *)payload;
-    nOS_Time    time    = *(nOS_Time *)thread->ext;
+    nOS_Node    *it = _waitList.head;
 
-    /* Avoid warning */
-    NOS_UNUSED(arg);
+    while ((it != NULL) && (nOS_GetNodeOwner(it, _WaitContext, node)->time <= ctx->time)) {
+        it = it->next;
+    }
+
+    nOS_InsertToList(&_waitList, &ctx->node, it);
+}
+
+/* Called from critical section when a thread waiting for time is deleted */
+void nOS_RemoveThreadFromTimeWait (nOS_Thread *thread)
+{
+    nOS_RemoveFromList(&_waitList, &((_WaitContext*)thread->ext)->node);
+}
+#endif
 
-    if (time >= _time) {
-        nOS_WakeUpThread(thread, NOS_OK);
+#if (NOS_CONFIG_TIME_DATE_CACHE_ENABLE > 0)
+/* Called from critical section, advance cached date by one second */
+static void _IncrementTimeDate (void)
+{
+    if (++_timedate.second == 60) {
+        _timedate.second = 0;
+        if (++_timedate.minute == 60) {
+            _timedate.minute = 0;
+            if (++_timedate.hour == 24) {
+                _timedate.hour = 0;
+                _timedate.weekday = (_timedate.weekday == 7) ? 1 : (uint8_t)(_timedate.weekday + 1);
+                if (++_timedate.day > DAYS_PER_MONTH(_timedate.month, _timedate.year)) {
+                    _timedate.day = 1;
+                    if (++_timedate.month > 12) {
+                        _timedate.month = 1;
+                        _timedate.year++;
+                    }
+                }
+            }
+        }
     }
 }
 #endif
 
+#if (NOS_CONFIG_TIME_PRECISE_ENABLE > 0)
+/* Called from critical section, publish time to lock-free readers. Each copy is written while sequence number
+ * select the other one, a reader that interrupt this function always read a stable copy. */
+static void _PublishPrecise (void)
+{
+    nOS_TimePrecise     precise;
+
+    precise.time   = _time;
+ #if (NOS_CONFIG_TIME_TICKS_PER_SECOND > 1)
+    precise.ticks  = _prescaler;
+ #else
+    precise.ticks  = 0;
+ #endif
+ #if (NOS_CONFIG_CYCLE_COUNTER_ENABLE > 0)
+    precise.cycles = nOS_GetCycleCount();
+ #endif
+
+    _seq++;
+    nOS_MemoryBarrier();
+    _precise[0] = precise;
+    nOS_MemoryBarrier();
+    _seq++;
+    nOS_MemoryBarrier();
+    _precise[1] = precise;
+    nOS_MemoryBarrier();
+}
+#endif
+
 void nOS_InitTime (void)
 {
 #if (NOS_CONFIG_TIME_TICKS_PER_SECOND > 1)
     _prescaler  = 0;
 #endif
     _time       = 0;
+#if (NOS_CONFIG_TIME_DATE_CACHE_ENABLE > 0)
+    _timedate   = nOS_TimeConvert(0);
+#endif
+#if (NOS_CONFIG_TIME_PRECISE_ENABLE > 0)
+    _PublishPrecise();
+#endif
 #if (NOS_CONFIG_TIME_WAIT_ENABLE > 0)
-    nOS_CreateEvent(&_event
- #if (NOS_CONFIG_SAFE > 0)
-                   ,NOS_EVENT_BASE
- #endif
-                   );
+    nOS_InitList(&_waitList);
 #endif
 }
 
+/* Called from critical section if NOS_CONFIG_TIME_TICK_ENABLE is enabled */
 void nOS_TimeTick (nOS_TickCounter ticks)
 {
+#if (NOS_CONFIG_TIME_TICK_ENABLE == 0)
     nOS_StatusReg   sr;
+#endif
     nOS_Time        dt;
+#if (NOS_CONFIG_TIME_WAIT_ENABLE > 0)
+    _WaitContext    *ctx;
+#endif
 
+#if (NOS_CONFIG_TIME_TICK_ENABLE == 0)
     nOS_EnterCritical(sr);
+#endif
 #if (NOS_CONFIG_TIME_TICKS_PER_SECOND == 1)
     dt = (nOS_Time)ticks;
 #else
@@ -77,13 +161,78 @@ void nOS_TimeTick (nOS_TickCounter ticks)
 #endif
     {
         _time += dt;
+#if (NOS_CONFIG_TIME_DATE_CACHE_ENABLE > 0)
+        if (dt == 1) {
+            _IncrementTimeDate();
+        }
+        else {
+            /* Many seconds elapsed at once (tickless idle or late call), convert again */
+            _timedate = nOS_TimeConvert(_time);
+        }
+#endif
 #if (NOS_CONFIG_TIME_WAIT_ENABLE > 0)
-        nOS_WalkInList(&_event.waitList, _TickTime, NULL);
+        /* List is sorted by time, stop at first thread that has not reached its time */
+        ctx = _GetHeadOfWaitList();
+        while ((ctx != NULL) && (ctx->time <= _time)) {
+            nOS_RemoveFromList(&_waitList, &ctx->node);
+            nOS_WakeUpThread(ctx->thread, NOS_OK);
+            ctx = _GetHeadOfWaitList();
+        }
 #endif
     }
+#if (NOS_CONFIG_TIME_PRECISE_ENABLE > 0)
+    _PublishPrecise();
+#endif
+#if (NOS_CONFIG_TIME_TICK_ENABLE == 0)
     nOS_LeaveCritical(sr);
+#endif
 }
 
+#if (NOS_CONFIG_TICKLESS_ENABLE > 0)
+/* Called from critical section */
+nOS_TickCounter nOS_TimeGetTicksUntil (nOS_Time time)
+{
+    nOS_TickCounter ticks;
+    nOS_Time        dt;
+
+    if (time <= _time) {
+        ticks = 0;
+    }
+    else {
+        dt = time - _time;
+        /* Time will be incremented at each completed second */
+        if (dt > (nOS_Time)(NOS_TICKS_WAIT_MAX / NOS_CONFIG_TIME_TICKS_PER_SECOND)) {
+            ticks = NOS_TICKS_WAIT_MAX;
+        }
+        else {
+            ticks = (nOS_TickCounter)(dt * NOS_CONFIG_TIME_TICKS_PER_SECOND);
+ #if (NOS_CONFIG_TIME_TICKS_PER_SECOND > 1)
+            ticks -= _prescaler;
+ #endif
+        }
+    }
+
+    return ticks;
+}
+
+/* Called from critical section */
+nOS_TickCounter nOS_TimeGetNextWakeup (void)
+{
+    nOS_TickCounter ticks = NOS_WAIT_INFINITE;
+ #if (NOS_CONFIG_TIME_WAIT_ENABLE > 0)
+    _WaitContext    *ctx;
+
+    /* List is sorted by time, next thread to wake up is at head */
+    ctx = _GetHeadOfWaitList();
+    if (ctx != NULL) {
+        ticks = nOS_TimeGetTicksUntil(ctx->time);
+    }
+ #endif
+
+    return ticks;
+}
+#endif
+
 nOS_Time nOS_TimeGet (void)
 {
     nOS_StatusReg   sr;
@@ -96,6 +245,25 @@ nOS_Time nOS_TimeGet (void)
     return time;
 }
 
+#if (NOS_CONFIG_TIME_PRECISE_ENABLE > 0)
+/* Can be called from any ISR, never enter critical section */
+nOS_TimePrecise nOS_TimeGetPrecise (void)
+{
+    nOS_TimePrecise     precise;
+    uint16_t            seq;
+
+    /* Read again if time has been published while reading */
+    do {
+        seq = _seq;
+        nOS_MemoryBarrier();
+        precise = _precise[seq & 1];
+        nOS_MemoryBarrier();
+    } while (seq != _seq);
+
+    return precise;
+}
+#endif
+
 nOS_Error nOS_TimeSet (nOS_Time time)
 {
     nOS_StatusReg   sr;
@@ -104,51 +272,58 @@ nOS_Error nOS_TimeSet (nOS_Time time)
     _time = time;
 #if (NOS_CONFIG_TIME_TICKS_PER_SECOND > 1)
     _prescaler = 0;
+#endif
+#if (NOS_CONFIG_TIME_DATE_CACHE_ENABLE > 0)
+    _timedate = nOS_TimeConvert(time);
+#endif
+#if (NOS_CONFIG_TIME_PRECISE_ENABLE > 0)
+    _PublishPrecise();
 #endif
     nOS_LeaveCritical(sr);
 
     return NOS_OK;
 }
 
+/* Constant time conversion, based on days since 1st March of year 0 and 400 years eras of 146097 days (see
+ * "chrono-Compatible Low-Level Date Algorithms" from Howard Hinnant). Years start in March to have leap day at
+ * end of year. */
 nOS_TimeDate nOS_TimeConvert (nOS_Time time)
 {
     nOS_TimeDate    timedate;
-    uint16_t        days;
+    uint32_t        days;
+    uint32_t        era;
+    uint32_t        doe;    /* Day of era, from 0 to 146096 */
+    uint32_t        yoe;    /* Year of era, from 0 to 399 */
+    uint32_t        doy;    /* Day of year starting in March, from 0 to 365 */
+    uint32_t        mp;     /* Month starting in March, from 0 to 11 */
 
     /* First extract HH:MM:SS from _time */
-    timedate.second = time % 60;
+    timedate.second = (uint8_t)(time % 60);
     time /= 60;
-    timedate.minute = time % 60;
+    timedate.minute = (uint8_t)(time % 60);
     time /= 60;
-    timedate.hour = time % 24;
+    timedate.hour = (uint8_t)(time % 24);
     time /= 24;
     /* At this point, time is now in number of days since 1st January 1970 */
+    days = (uint32_t)time;
 
     /* Second, get week day we are */
     /* 1st January 1970 was a Thursday (4th day or index 3) */
     /* weekday go from 1 (Monday) to 7 (Sunday) */
-    timedate.weekday = ((time + 3) % 7) + 1;
-
-    /* Third, find in which year we are */
-    timedate.year = 1970;
-    days = 365; /* 1970 is not a leap year */
-    while (time >= days) {
-        time -= days;
-        timedate.year++;
-        days = DAYS_PER_YEAR(timedate.year);
-    }
+    timedate.weekday = (uint8_t)(((days + 3UL) % 7UL) + 1UL);
 
-    /* Fourth, find in which month of the present year we are */
-    timedate.month = 1;
-    days = 31;  /* January have 31 days */
-    while (time >= days) {
-        time -= days;
-        timedate.month++;
-        days = DAYS_PER_MONTH(timedate.month, timedate.year);
-    }
+    /* Third, find year, month and day from days since 1st March of year 0 (719468 days before 1st January 1970) */
+    days += 719468UL;
+    era = days / 146097UL;
+    doe = days - (era * 146097UL);
+    yoe = (doe - (doe / 1460UL) + (doe / 36524UL) - (doe / 146096UL)) / 365UL;
+    doy = doe - ((365UL * yoe) + (yoe / 4UL) - (yoe / 100UL));
+    mp = ((5UL * doy) + 2UL) / 153UL;
 
-    /* Last, we have in which day of month we are */
-    timedate.day = (uint8_t)(time + 1);
+    timedate.day = (uint8_t)(doy - (((153UL * mp) + 2UL) / 5UL) + 1UL);
+    timedate.month = (uint8_t)((mp < 10UL) ? (mp + 3UL) : (mp - 9UL));
+    /* January and February belong to the previous year starting in March */
+    timedate.year = (uint16_t)((era * 400UL) + yoe + ((timedate.month <= 2) ? 1UL : 0UL));
 
     return timedate;
 }
@@ -158,6 +333,7 @@ nOS_Error nOS_TimeWait (nOS_Time time)
 {
     nOS_Error       err;
     nOS_StatusReg   sr;
+    _WaitContext    ctx;
 
 #if (NOS_CONFIG_SAFE > 0)
     if (nOS_isrNestingCounter > 0) {
@@ -182,13 +358,21 @@ nOS_Error nOS_TimeWait (nOS_Time time)
             err = NOS_OK;
         }
         else {
-            nOS_runningThread->ext = (void*)&time;
-            err = nOS_WaitForEvent(&_event,
+            ctx.time = time;
+            ctx.thread = nOS_runningThread;
+            nOS_SetNodeOwner(&ctx.node, &ctx);
+            nOS_runningThread->ext = &ctx;
+            _InsertToWaitList(&ctx);
+            err = nOS_WaitForEvent(NULL,
                                    NOS_THREAD_WAITING_TIME
 #if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0) || (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
                                   ,NOS_WAIT_INFINITE
 #endif
                                   );
+            if (err != NOS_OK) {
+                /* Aborted, thread is still linked in wait list */
+                nOS_RemoveFromList(&_waitList, &ctx.node);
+            }
         }
         nOS_LeaveCritical(sr);
     }
@@ -214,7 +398,18 @@ uint8_t nOS_TimeGetDaysPerMonth(uint8_t month, uint16_t year)
 
 nOS_TimeDate nOS_TimeDateGet (void)
 {
+#if (NOS_CONFIG_TIME_DATE_CACHE_ENABLE > 0)
+    nOS_StatusReg   sr;
+    nOS_TimeDate    timedate;
+
+    nOS_EnterCritical(sr);
+    timedate = _timedate;
+    nOS_LeaveCritical(sr);
+
+    return timedate;
+#else
     return nOS_TimeConvert(nOS_TimeGet());
+#endif
 }
 
 nOS_Error nOS_TimeDateSet (nOS_TimeDate timedate)
@@ -222,31 +417,28 @@ nOS_Error nOS_TimeDateSet (nOS_TimeDate timedate)
     return nOS_TimeSet(nOS_TimeDateConvert(timedate));
 }
 
+/* Constant time conversion, inverse of nOS_TimeConvert */
 nOS_Time nOS_TimeDateConvert (nOS_TimeDate timedate)
 {
-    nOS_Time    time = 0;
-    uint16_t    year;
-    uint8_t     month;
-
-    /* Increment time variable until we reach timedate given by user */
-
-    /* Do not count on-going year */
-    year = 1970;
-    while (year < timedate.year) {
-        time += (DAYS_PER_YEAR(year) * 86400UL);
-        year++;
-    }
-
-    /* Do not count on-going month */
-    month = 1;
-    while (month < timedate.month) {
-        time += (DAYS_PER_MONTH(month, timedate.year) * 86400UL);
-        month++;
-    }
-
-    /* Do not count half day */
-    time += ((timedate.day-1) * 86400UL); /* 86400 seconds per day */
-
+    nOS_Time    time;
+    uint32_t    year;
+    uint32_t    era;
+    uint32_t    yoe;    /* Year of era, from 0 to 399 */
+    uint32_t    doy;    /* Day of year starting in March, from 0 to 365 */
+    uint32_t    doe;    /* Day of era, from 0 to 146096 */
+
+    /* January and February belong to the previous year starting in March */
+    year = (uint32_t)timedate.year - ((timedate.month <= 2) ? 1UL : 0UL);
+    era = year / 400UL;
+    yoe = year - (era * 400UL);
+    doy = (((153UL * ((timedate.month > 2) ? ((uint32_t)timedate.month - 3UL) : ((uint32_t)timedate.month + 9UL))) + 2UL) / 5UL)
+          + (uint32_t)timedate.day - 1UL;
+    doe = (yoe * 365UL) + (yoe / 4UL) - (yoe / 100UL) + doy;
+
+    /* Days since 1st January 1970 */
+    time = (nOS_Time)((era * 146097UL) + doe - 719468UL);
+
+    time *= 86400UL; /* 86400 seconds per day */
     time += (timedate.hour * 3600UL);
     time += (timedate.minute * 60UL);
     time += timedate.second;
@@ -17,11 +17,23 @@ extern "C" {
 typedef struct _TickContext
 {
     nOS_TickCounter ticks;
-#if (NOS_CONFIG_TIMER_THREAD_ENABLE > 0)
+#if (NOS_CONFIG_TIMER_THREAD_COUNT > 1)
+    uint8_t         triggered;  /* One bit by band */
+#elif (NOS_CONFIG_TIMER_THREAD_ENABLE > 0)
     bool            triggered;
 #endif
+#if (NOS_CONFIG_TIMER_SLACK_ENABLE > 0)
+    bool            expired;    /* At least one timer reach end of its slack window */
+#endif
 } _TickContext;
 
+typedef struct _Item
+{
+    nOS_Timer           *timer;
+    nOS_TimerCallback   callback;
+    void                *arg;
+} _Item;
+
 #if (NOS_CONFIG_TIMER_THREAD_ENABLE > 0)
  #if (NOS_CONFIG_THREAD_JOIN_ENABLE > 0)
   static int _Thread (void *arg);
@@ -29,21 +41,33 @@ typedef struct _TickContext
   static void _Thread (void *arg);
  #endif
 #endif
-static  void    _Tick       (void *payload, void *arg);
+static  void    _Tick       (void *node, void *arg);
 
-static nOS_List                 _activeList;
+#if (NOS_CONFIG_TIMER_WHEEL_ENABLE > 0)
+ static nOS_List                _activeList[NOS_CONFIG_TIMER_WHEEL_SIZE];
+ #if (NOS_CONFIG_TICKLESS_ENABLE > 0)
+  /* Earliest deadline of timers in each slot of the wheel. Can be earlier than the real one when the earliest timer
+   * is removed from its slot, until nOS_TimerTick walks this slot again. */
+  static nOS_TimerCounter       _slotMin[NOS_CONFIG_TIMER_WHEEL_SIZE];
+ #endif
+#else
+ static nOS_List                _activeList;
+#endif
 #if (NOS_CONFIG_TIMER_HIGHEST_PRIO > 0)
  static nOS_List                _triggeredList[NOS_CONFIG_TIMER_HIGHEST_PRIO+1];
- static uint8_t                 _triggeredListByPrio;
- #ifndef NOS_USE_CLZ
-  static NOS_CONST uint8_t      _tableDeBruijn[8] = {
-       0, 5, 1, 6, 4, 3, 2, 7
-   };
- #endif
+ static nOS_BitmapWord          _triggeredListByPrio[NOS_BITMAP_SIZE(NOS_CONFIG_TIMER_HIGHEST_PRIO)];
 #else
  static nOS_List                _triggeredList;
 #endif
-#if (NOS_CONFIG_TIMER_THREAD_ENABLE > 0)
+#if (NOS_CONFIG_TIMER_THREAD_COUNT > 1)
+ static nOS_Thread              _thread[NOS_CONFIG_TIMER_THREAD_COUNT];
+ #ifdef NOS_SIMULATED_STACK
+  static nOS_Stack              _stack[NOS_CONFIG_TIMER_THREAD_COUNT];
+ #else
+  static nOS_Stack              _stack[NOS_CONFIG_TIMER_THREAD_COUNT][NOS_CONFIG_TIMER_THREAD_STACK_SIZE];
+ #endif
+ static uint8_t                 _bandTop[NOS_CONFIG_TIMER_THREAD_COUNT];
+#elif (NOS_CONFIG_TIMER_THREAD_ENABLE > 0)
  static nOS_Thread              _thread;
  #ifdef NOS_SIMULATED_STACK
   static nOS_Stack              _stack;
@@ -52,26 +76,73 @@ static nOS_List                 _activeList;
  #endif
 #endif
 static nOS_TimerCounter         _tickCounter;
-
-#define _AppendToActiveList(t)          nOS_AppendToList(&_activeList, &(t)->node)
-#define _RemoveFromActiveList(t)        nOS_RemoveFromList(&_activeList, &(t)->node)
+#if (NOS_CONFIG_CRITICAL_WALK_LIMIT > 0) && (NOS_CONFIG_TIMER_TICK_ENABLE == 0)
+ /* Ticks being processed by nOS_TimerTick, already elapsed but added to _tickCounter only at the end. Timers started
+  * by interrupts while walk is paused count from current time. */
+ static nOS_TickCounter         _walkTicks;
+ #define _GetTickCounter()              (nOS_TimerCounter)(_tickCounter + _walkTicks)
+ #define _WalkActiveList(l,h,c)         nOS_WalkInListBounded(l, h, c, &sr)
+#else
+ #define _GetTickCounter()              _tickCounter
+ #define _WalkActiveList(l,h,c)         nOS_WalkInList(l, h, c)
+#endif
+
+#if (NOS_CONFIG_TIMER_WHEEL_ENABLE > 0)
+ #define _GetWheelSlot(c)               (uint16_t)((c) & (NOS_CONFIG_TIMER_WHEEL_SIZE - 1))
+ #if (NOS_CONFIG_TICKLESS_ENABLE > 0)
+  static inline void _UpdateSlotMin (nOS_Timer *timer)
+  {
+      uint16_t  slot = _GetWheelSlot(timer->count);
+
+      if ((nOS_TimerCounter)(timer->count - _tickCounter) < (nOS_TimerCounter)(_slotMin[slot] - _tickCounter)) {
+          _slotMin[slot] = timer->count;
+      }
+  }
+  static inline void _AppendToActiveList (nOS_Timer *timer)
+  {
+      uint16_t  slot = _GetWheelSlot(timer->count);
+
+      if (_activeList[slot].head == NULL) {
+          _slotMin[slot] = timer->count;
+      }
+      else {
+          _UpdateSlotMin(timer);
+      }
+      nOS_AppendToList(&_activeList[slot], &timer->node);
+  }
+ #else
+  #define _AppendToActiveList(t)        nOS_AppendToList(&_activeList[_GetWheelSlot((t)->count)], &(t)->node)
+ #endif
+ #define _RemoveFromActiveList(t)       nOS_RemoveFromList(&_activeList[_GetWheelSlot((t)->count)], &(t)->node)
+ /* Timer is hashed in wheel by its deadline, move it to its new slot if needed */
+ static inline void _SetCount (nOS_Timer *timer, nOS_TimerCounter count)
+ {
+     if ((timer->state & (NOS_TIMER_RUNNING | NOS_TIMER_PAUSED)) == NOS_TIMER_RUNNING) {
+         _RemoveFromActiveList(timer);
+         timer->count = count;
+         _AppendToActiveList(timer);
+     }
+     else {
+         timer->count = count;
+     }
+ }
+#else
+ #define _AppendToActiveList(t)         nOS_AppendToList(&_activeList, &(t)->node)
+ #define _RemoveFromActiveList(t)       nOS_RemoveFromList(&_activeList, &(t)->node)
+ #define _SetCount(t,c)                 (t)->count = (c)
+#endif
+#if (NOS_CONFIG_TIMER_THREAD_COUNT > 1)
+ /* Timer priorities are split in bands of about the same size, band n is processed by timer thread n */
+ #define _GetBand(p)                    (uint8_t)(((uint16_t)(p) * NOS_CONFIG_TIMER_THREAD_COUNT) / (NOS_CONFIG_TIMER_HIGHEST_PRIO + 1))
+#endif
 #if (NOS_CONFIG_TIMER_HIGHEST_PRIO > 0)
- static inline nOS_Timer* _FindTriggeredHighestPrio (void)
+ /* Find highest prio triggered timer in priorities from bottom to top inclusively */
+ static inline nOS_Timer* _FindTriggered (uint8_t bottom, uint8_t top)
  {
      uint8_t prio;
 
-     if (_triggeredListByPrio != 0) {
- #ifdef NOS_USE_CLZ
-         prio = (uint8_t)(31 - _CLZ((uint32_t)_triggeredListByPrio));
- #else
-         prio = _triggeredListByPrio;
-         prio |= prio >> 1; // first round down to one less than a power of 2
-         prio |= prio >> 2;
-         prio |= prio >> 4;
-         prio = (uint8_t)_tableDeBruijn[(uint8_t)(prio * 0x1d) >> 5];
- #endif
-
-         return (nOS_Timer*)_triggeredList[prio].head->payload;
+     if (nOS_FindPrioInBitmap(_triggeredListByPrio, top, &prio) && (prio >= bottom)) {
+         return nOS_GetNodeOwner(_triggeredList[prio].head, nOS_Timer, trig);
      }
      else {
          return (nOS_Timer*)NULL;
@@ -79,25 +150,83 @@ static nOS_TimerCounter         _tickCounter;
  }
  static inline void _AppendToTriggeredList (nOS_Timer *timer)
  {
-     uint8_t prio = timer->prio;
-
-     nOS_AppendToList(&_triggeredList[prio], &timer->trig);
-     _triggeredListByPrio |= (0x00000001UL << prio);
+     nOS_AppendToList(&_triggeredList[timer->prio], &timer->trig);
+     nOS_SetPrioInBitmap(_triggeredListByPrio, timer->prio);
  }
  static inline void _RemoveFromTriggeredList (nOS_Timer *timer)
  {
-     uint8_t prio = timer->prio;
-
-     nOS_RemoveFromList(&_triggeredList[prio], &timer->trig);
-     if (_triggeredList[prio].head == NULL) {
-         _triggeredListByPrio &=~ (0x00000001UL << prio);
+     nOS_RemoveFromList(&_triggeredList[timer->prio], &timer->trig);
+     if (_triggeredList[timer->prio].head == NULL) {
+         nOS_ClearPrioInBitmap(_triggeredListByPrio, timer->prio);
      }
  }
 #else
- #define _FindTriggeredHighestPrio()    nOS_GetHeadOfList(&_triggeredList)
+ #define _FindTriggered(b,t)            nOS_GetHeadOfList(&_triggeredList, nOS_Timer, trig)
  #define _AppendToTriggeredList(t)      nOS_AppendToList(&_triggeredList, &(t)->trig)
  #define _RemoveFromTriggeredList(t)    nOS_RemoveFromList(&_triggeredList, &(t)->trig)
 #endif
+#define _FindTriggeredHighestPrio()     _FindTriggered(0, NOS_CONFIG_TIMER_HIGHEST_PRIO)
+
+/* Take up to max highest prio triggered timers in priorities from bottom to top in the same critical section, then
+ * call their callback outside of it. Return number of timers taken. */
+static uint8_t _Process (uint8_t bottom, uint8_t top, uint8_t max)
+{
+    nOS_StatusReg       sr;
+    nOS_Timer           *timer;
+    _Item               items[NOS_CONFIG_PROCESS_BATCH_SIZE];
+    uint8_t             count = 0;
+    uint8_t             i;
+
+#if (NOS_CONFIG_TIMER_HIGHEST_PRIO == 0)
+    NOS_UNUSED(bottom);
+    NOS_UNUSED(top);
+#endif
+
+    nOS_EnterCritical(sr);
+    timer = (nOS_Timer*)_FindTriggered(bottom, top);
+    while ((timer != NULL) && (count < max)) {
+        timer->overflow--;
+        if (timer->overflow == 0) {
+            _RemoveFromTriggeredList(timer);
+        }
+        else {
+#if (NOS_CONFIG_TIMER_HIGHEST_PRIO > 0)
+            nOS_RotateList(&_triggeredList[timer->prio]);
+#else
+            nOS_RotateList(&_triggeredList);
+#endif
+        }
+
+        nOS_Trace(NOS_TRACE_TIMER, timer, 0);
+
+        /* Call callback function outside of critical section */
+        items[count].timer    = timer;
+        items[count].callback = timer->callback;
+        items[count].arg      = timer->arg;
+        count++;
+
+        timer = (nOS_Timer*)_FindTriggered(bottom, top);
+    }
+    nOS_LeaveCritical(sr);
+
+    for (i = 0; i < count; i++) {
+        if (items[i].callback != NULL) {
+            items[i].callback(items[i].timer, items[i].arg);
+        }
+    }
+
+    return count;
+}
+
+#if (NOS_CONFIG_TIMER_THREAD_COUNT > 1)
+/* Called from critical section when timers of a band are triggered */
+static void _WakeUpBand (uint8_t band)
+{
+    if (_thread[band].state == (NOS_THREAD_READY | NOS_THREAD_ON_HOLD)) {
+        nOS_WakeUpThread(&_thread[band], NOS_OK);
+    }
+}
+#endif
 
 #if (NOS_CONFIG_TIMER_THREAD_ENABLE > 0)
 #if (NOS_CONFIG_THREAD_JOIN_ENABLE > 0)
@@ -107,14 +236,22 @@ static void _Thread (void *arg)
 #endif
 {
     nOS_StatusReg   sr;
+#if (NOS_CONFIG_TIMER_THREAD_COUNT > 1)
+    uint8_t         band = (uint8_t)(size_t)arg;
+    uint8_t         bottom = (band > 0) ? (uint8_t)(_bandTop[band-1] + 1) : 0;
+    uint8_t         top = _bandTop[band];
+#else
+    uint8_t         bottom = 0;
+    uint8_t         top = NOS_CONFIG_TIMER_HIGHEST_PRIO;
 
     NOS_UNUSED(arg);
+#endif
 
     while (true) {
-        nOS_TimerProcess();
+        _Process(bottom, top, NOS_CONFIG_PROCESS_BATCH_SIZE);
 
         nOS_EnterCritical(sr);
-        if (_FindTriggeredHighestPrio() == NULL) {
+        if (_FindTriggered(bottom, top) == NULL) {
             nOS_WaitForEvent(NULL,
                              NOS_THREAD_ON_HOLD
 #if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0) || (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
@@ -135,19 +272,43 @@ static void _Thread (void *arg)
 }
 #endif
 
+#if (NOS_CONFIG_TIMER_SLACK_ENABLE > 0)
+/* Called from critical section */
+static void _CheckDeadline (void *node, void *arg)
+{
+    nOS_Timer           *timer  = nOS_GetNodeOwner((nOS_Node*)node, nOS_Timer, node);
+    _TickContext        *ctx    = (_TickContext *)arg;
+
+    if ((nOS_TimerCounter)(timer->count + timer->slack - _tickCounter) <= ctx->ticks) {
+        ctx->expired = true;
+    }
+}
+#endif
+
 /* Called from critical section */
-static void _Tick (void *payload, void *arg)
+static void _Tick (void *node, void *arg)
 {
-    nOS_Timer           *timer  = (nOS_Timer *)payload;
+    nOS_Timer           *timer  = nOS_GetNodeOwner((nOS_Node*)node, nOS_Timer, node);
     _TickContext        *ctx    = (_TickContext *)arg;
     nOS_TimerCounter    overflow;
+#if (NOS_CONFIG_TIMER_SLACK_ENABLE > 0)
+    nOS_TimerCounter    late    = (nOS_TimerCounter)(_tickCounter - timer->count);
 
+    /* Timer reach its deadline during elapsed ticks or is already late but still in its slack window */
+    if (((timer->count - _tickCounter) <= ctx->ticks) || ((late > 0) && (late <= timer->slack))) {
+#else
     if ((timer->count - _tickCounter) <= ctx->ticks) {
+#endif
         overflow = 1;
         if (((nOS_TimerMode)timer->state & NOS_TIMER_MODE) == NOS_TIMER_FREE_RUNNING) {
             /* Free running timer */
+#if (NOS_CONFIG_TIMER_SLACK_ENABLE > 0)
+            /* Keep original period, lateness included */
+            overflow += (nOS_TimerCounter)((nOS_TimerCounter)ctx->ticks - (nOS_TimerCounter)(timer->count - _tickCounter)) / timer->reload;
+#else
             overflow += ((ctx->ticks - (timer->count - _tickCounter)) / timer->reload);
-            timer->count += (overflow * timer->reload);
+#endif
+            _SetCount(timer, timer->count + (overflow * timer->reload));
         }
         else {
             /* One-shot timer */
@@ -162,25 +323,77 @@ static void _Tick (void *payload, void *arg)
         } else {
             timer->overflow += overflow;
         }
-#if (NOS_CONFIG_TIMER_THREAD_ENABLE > 0)
+#if (NOS_CONFIG_TIMER_THREAD_COUNT > 1)
+        ctx->triggered |= (uint8_t)(0x01 << _GetBand(timer->prio));
+#elif (NOS_CONFIG_TIMER_THREAD_ENABLE > 0)
         ctx->triggered = true;
 #endif
     }
+#if (NOS_CONFIG_TIMER_WHEEL_ENABLE > 0) && (NOS_CONFIG_TICKLESS_ENABLE > 0)
+    else {
+        /* Timer stay in walked slot for a next turn of the wheel */
+        _UpdateSlotMin(timer);
+    }
+#endif
 }
 
 void nOS_InitTimer(void)
 {
+#if (NOS_CONFIG_TIMER_HIGHEST_PRIO > 0) || (NOS_CONFIG_TIMER_WHEEL_ENABLE > 0)
+    uint16_t i;
+#endif
+
 #if (NOS_CONFIG_TIMER_HIGHEST_PRIO > 0)
-    uint8_t i;
-    for (i = 0; i < NOS_CONFIG_TIMER_HIGHEST_PRIO; i++) {
+    for (i = 0; i <= NOS_CONFIG_TIMER_HIGHEST_PRIO; i++) {
         nOS_InitList(&_triggeredList[i]);
     }
 #else
     nOS_InitList(&_triggeredList);
 #endif
     _tickCounter = 0;
+#if (NOS_CONFIG_CRITICAL_WALK_LIMIT > 0) && (NOS_CONFIG_TIMER_TICK_ENABLE == 0)
+    _walkTicks = 0;
+#endif
+#if (NOS_CONFIG_TIMER_WHEEL_ENABLE > 0)
+    for (i = 0; i < NOS_CONFIG_TIMER_WHEEL_SIZE; i++) {
+        nOS_InitList(&_activeList[i]);
+    }
+#else
     nOS_InitList(&_activeList);
-#if (NOS_CONFIG_TIMER_THREAD_ENABLE > 0)
+#endif
+#if (NOS_CONFIG_TIMER_THREAD_COUNT > 1)
+    for (i = 0; i <= NOS_CONFIG_TIMER_HIGHEST_PRIO; i++) {
+        _bandTop[_GetBand(i)] = (uint8_t)i;
+    }
+    for (i = 0; i < NOS_CONFIG_TIMER_THREAD_COUNT; i++) {
+        nOS_ThreadCreate(&_thread[i],
+                         _Thread,
+                         (void*)(size_t)i
+ #ifdef NOS_SIMULATED_STACK
+                        ,&_stack[i]
+ #else
+                        ,_stack[i]
+ #endif
+                        ,NOS_CONFIG_TIMER_THREAD_STACK_SIZE
+ #ifdef NOS_USE_SEPARATE_CALL_STACK
+                        ,NOS_CONFIG_TIMER_THREAD_CALL_STACK_SIZE
+ #endif
+                        ,(uint8_t)(NOS_CONFIG_TIMER_THREAD_PRIO + i)
+ #if (NOS_CONFIG_THREAD_SUSPEND_ENABLE > 0)
+                        ,NOS_THREAD_READY
+ #endif
+ #if (NOS_CONFIG_THREAD_NAME_ENABLE > 0)
+                        ,"nOS_Timer"
+ #endif
+ #if (NOS_CONFIG_THREAD_FPU_ENABLE > 0)
+                        ,true   /* Callbacks can use FPU */
+ #endif
+ #if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+                        ,0      /* Service threads run on core 0 with tick */
+ #endif
+                        );
+    }
+#elif (NOS_CONFIG_TIMER_THREAD_ENABLE > 0)
     nOS_ThreadCreate(&_thread,
                      _Thread,
                      NULL
@@ -201,63 +414,147 @@ void nOS_InitTimer(void)
  #endif
  #if (NOS_CONFIG_THREAD_NAME_ENABLE > 0)
                     ,"nOS_Timer"
+ #endif
+ #if (NOS_CONFIG_THREAD_FPU_ENABLE > 0)
+                    ,true   /* Callbacks can use FPU */
+ #endif
+ #if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+                    ,0      /* Service threads run on core 0 with tick */
  #endif
                     );
 #endif
 }
 
+/* Called from critical section if NOS_CONFIG_TIMER_TICK_ENABLE is enabled */
 void nOS_TimerTick (nOS_TickCounter ticks)
 {
+#if (NOS_CONFIG_TIMER_TICK_ENABLE == 0)
     nOS_StatusReg   sr;
+#endif
     _TickContext    ctx;
+#if (NOS_CONFIG_TIMER_WHEEL_ENABLE > 0)
+    nOS_TickCounter i;
+    nOS_TickCounter n;
+#endif
+#if (NOS_CONFIG_TIMER_THREAD_COUNT > 1)
+    uint8_t         band;
+#endif
 
     ctx.ticks = ticks;
-#if (NOS_CONFIG_TIMER_THREAD_ENABLE > 0)
+#if (NOS_CONFIG_TIMER_THREAD_COUNT > 1)
+    ctx.triggered = 0;
+#elif (NOS_CONFIG_TIMER_THREAD_ENABLE > 0)
     ctx.triggered = false;
 #endif
+#if (NOS_CONFIG_TIMER_SLACK_ENABLE > 0)
+    ctx.expired = false;
+#endif
 
+#if (NOS_CONFIG_TIMER_TICK_ENABLE == 0)
     nOS_EnterCritical(sr);
-    nOS_WalkInList(&_activeList, _Tick, &ctx);
-#if (NOS_CONFIG_TIMER_THREAD_ENABLE > 0)
+#endif
+#if (NOS_CONFIG_CRITICAL_WALK_LIMIT > 0) && (NOS_CONFIG_TIMER_TICK_ENABLE == 0)
+    _walkTicks = ticks;
+#endif
+#if (NOS_CONFIG_TIMER_WHEEL_ENABLE > 0)
+    /* Only slots of elapsed ticks can contain expired timers, no need to check a slot more than one time */
+    n = (ticks < NOS_CONFIG_TIMER_WHEEL_SIZE) ? ticks : NOS_CONFIG_TIMER_WHEEL_SIZE;
+    for (i = 1; i <= n; i++) {
+ #if (NOS_CONFIG_TICKLESS_ENABLE > 0)
+        /* Earliest deadline of slot is found again while walking it, start from latest possible deadline */
+        _slotMin[_GetWheelSlot(_tickCounter + i)] = (nOS_TimerCounter)(_tickCounter - 1);
+ #endif
+        _WalkActiveList(&_activeList[_GetWheelSlot(_tickCounter + i)], _Tick, &ctx);
+    }
+#elif (NOS_CONFIG_TIMER_SLACK_ENABLE > 0)
+    /* Trigger all due timers together, only when one of them can't wait longer */
+    _WalkActiveList(&_activeList, _CheckDeadline, &ctx);
+    if (ctx.expired) {
+        _WalkActiveList(&_activeList, _Tick, &ctx);
+    }
+#else
+    _WalkActiveList(&_activeList, _Tick, &ctx);
+#endif
+#if (NOS_CONFIG_TIMER_THREAD_COUNT > 1)
+    for (band = 0; band < NOS_CONFIG_TIMER_THREAD_COUNT; band++) {
+        if ((ctx.triggered & (0x01 << band)) != 0) {
+            _WakeUpBand(band);
+        }
+    }
+#elif (NOS_CONFIG_TIMER_THREAD_ENABLE > 0)
     if (ctx.triggered && (_thread.state == (NOS_THREAD_READY | NOS_THREAD_ON_HOLD))) {
         nOS_WakeUpThread(&_thread, NOS_OK);
     }
 #endif
     _tickCounter += ticks;
+#if (NOS_CONFIG_CRITICAL_WALK_LIMIT > 0) && (NOS_CONFIG_TIMER_TICK_ENABLE == 0)
+    _walkTicks = 0;
+#endif
+#if (NOS_CONFIG_TIMER_TICK_ENABLE == 0)
     nOS_LeaveCritical(sr);
+#endif
 }
 
-void nOS_TimerProcess (void)
+#if (NOS_CONFIG_TICKLESS_ENABLE > 0)
+#if (NOS_CONFIG_TIMER_WHEEL_ENABLE == 0)
+static void _GetNextWakeup (void *node, void *arg)
 {
-    nOS_StatusReg       sr;
-    nOS_Timer           *timer;
-    nOS_TimerCallback   callback = NULL;
-    void                *arg;
-
-    nOS_EnterCritical(sr);
-    timer = (nOS_Timer*)_FindTriggeredHighestPrio();
-    if (timer != NULL) {
-        timer->overflow--;
-        if (timer->overflow == 0) {
-            _RemoveFromTriggeredList(timer);
-        }
-        else {
-#if (NOS_CONFIG_TIMER_HIGHEST_PRIO > 0)
-            nOS_RotateList(&_triggeredList[timer->prio]);
+    nOS_Timer           *timer  = nOS_GetNodeOwner((nOS_Node*)node, nOS_Timer, node);
+    nOS_TickCounter     *ticks  = (nOS_TickCounter *)arg;
+#if (NOS_CONFIG_TIMER_SLACK_ENABLE > 0)
+    /* Wake up at end of slack window, timers due before will be grouped */
+    nOS_TimerCounter    remaining = timer->count + timer->slack - _tickCounter;
 #else
-            nOS_RotateList(&_triggeredList);
+    nOS_TimerCounter    remaining = timer->count - _tickCounter;
 #endif
-        }
 
-        /* Call callback function outside of critical section */
-        callback = timer->callback;
-        arg      = timer->arg;
+    if (remaining < *ticks) {
+        *ticks = (nOS_TickCounter)remaining;
     }
-    nOS_LeaveCritical(sr);
+}
+#endif
 
-    if (callback != NULL) {
-        callback(timer, arg);
+/* Called from critical section */
+nOS_TickCounter nOS_TimerGetNextWakeup (void)
+{
+    nOS_TickCounter     ticks = NOS_WAIT_INFINITE;
+#if (NOS_CONFIG_TIMER_WHEEL_ENABLE > 0)
+    nOS_TimerCounter    remaining;
+    uint16_t            i;
+#endif
+
+    if (_FindTriggeredHighestPrio() != NULL) {
+        /* Callbacks are waiting to be processed */
+        ticks = 0;
+    }
+    else {
+#if (NOS_CONFIG_TIMER_WHEEL_ENABLE > 0)
+        /* Only earliest deadline of each slot is needed, timers are not walked */
+        for (i = 0; i < NOS_CONFIG_TIMER_WHEEL_SIZE; i++) {
+            if (_activeList[i].head != NULL) {
+                remaining = _slotMin[i] - _tickCounter;
+                if (remaining < ticks) {
+                    ticks = (nOS_TickCounter)remaining;
+                }
+            }
+        }
+#else
+        nOS_WalkInList(&_activeList, _GetNextWakeup, &ticks);
+#endif
     }
+
+    return ticks;
+}
+#endif
+
+void nOS_TimerProcess (void)
+{
+    _Process(0, NOS_CONFIG_TIMER_HIGHEST_PRIO, 1);
+}
+
+uint8_t nOS_TimerProcessBatch (void)
+{
+    return _Process(0, NOS_CONFIG_TIMER_HIGHEST_PRIO, NOS_CONFIG_PROCESS_BATCH_SIZE);
 }
 
 nOS_Error nOS_TimerCreate (nOS_Timer *timer,
@@ -267,6 +564,9 @@ nOS_Error nOS_TimerCreate (nOS_Timer *timer,
                            nOS_TimerMode mode
 #if (NOS_CONFIG_TIMER_HIGHEST_PRIO > 0)
                           ,uint8_t prio
+#endif
+#if (NOS_CONFIG_TIMER_SLACK_ENABLE > 0)
+                          ,nOS_TimerCounter slack
 #endif
                           )
 {
@@ -303,8 +603,11 @@ nOS_Error nOS_TimerCreate (nOS_Timer *timer,
 #if (NOS_CONFIG_TIMER_HIGHEST_PRIO > 0)
             timer->prio         = prio;
 #endif
-            timer->node.payload = (void *)timer;
-            timer->trig.payload = (void *)timer;
+#if (NOS_CONFIG_TIMER_SLACK_ENABLE > 0)
+            timer->slack        = slack;
+#endif
+            nOS_SetNodeOwner(&timer->node, timer);
+            nOS_SetNodeOwner(&timer->trig, timer);
 
             err = NOS_OK;
         }
@@ -371,11 +674,11 @@ nOS_Error nOS_TimerStart (nOS_Timer *timer)
         } else
 #endif
         {
+            _SetCount(timer, _GetTickCounter() + timer->reload);
             if ( !(timer->state & NOS_TIMER_RUNNING) ) {
                 timer->state = (nOS_TimerState)(timer->state | NOS_TIMER_RUNNING);
                 _AppendToActiveList(timer);
             }
-            timer->count = _tickCounter + timer->reload;
 
             err = NOS_OK;
         }
@@ -440,12 +743,12 @@ nOS_Error nOS_TimerRestart (nOS_Timer *timer, nOS_TimerCounter reload)
         } else
 #endif
         {
+            timer->reload = reload;
+            _SetCount(timer, _GetTickCounter() + reload);
             if ( !(timer->state & NOS_TIMER_RUNNING) ) {
                 timer->state  = (nOS_TimerState)(timer->state | NOS_TIMER_RUNNING);
                 _AppendToActiveList(timer);
             }
-            timer->reload = reload;
-            timer->count  = _tickCounter + reload;
 
             err = NOS_OK;
         }
@@ -634,6 +937,10 @@ nOS_Error nOS_TimerSetPrio (nOS_Timer *timer, uint8_t prio)
             timer->prio = prio;
             if (timer->overflow > 0) {
                 _AppendToTriggeredList(timer);
+#if (NOS_CONFIG_TIMER_THREAD_COUNT > 1)
+                /* Timer can have moved to another band */
+                _WakeUpBand(_GetBand(prio));
+#endif
             }
             err = NOS_OK;
         }
@@ -644,6 +951,36 @@ nOS_Error nOS_TimerSetPrio (nOS_Timer *timer, uint8_t prio)
 }
 #endif
 
+#if (NOS_CONFIG_TIMER_SLACK_ENABLE > 0)
+nOS_Error nOS_TimerSetSlack (nOS_Timer *timer, nOS_TimerCounter slack)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (timer == NULL) {
+        err = NOS_E_INV_OBJ;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (timer->state == NOS_TIMER_DELETED) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        {
+            timer->slack = slack;
+
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+#endif
+
 bool nOS_TimerIsRunning (nOS_Timer *timer)
 {
     nOS_StatusReg   sr;
@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2014-2016 Jim Tremblay
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#define NOS_PRIVATE
+#include "nOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if (NOS_CONFIG_TOPIC_ENABLE > 0)
+/* Topic version is a free running count of published samples: sample of version v is stored in slot (v % bmax) and
+ * stay there until version (v + bmax) is published. Subscribers only compare their own version with topic version,
+ * so publisher never need to know who is reading. */
+#define _Slot(t,v)                      (&(t)->buffer[(size_t)((v) % (t)->bmax) * (size_t)(t)->bsize])
+
+static nOS_Error _TakeSample (nOS_Subscriber *sub, const void **sample)
+{
+    nOS_Topic   *topic = sub->topic;
+    uint32_t    pending = topic->seq - sub->seq;
+    nOS_Error   err;
+
+    if (pending > topic->bmax) {
+        /* Unread samples have been overwritten, restart from oldest one still in ring */
+        sub->seq = topic->seq - topic->bmax;
+        err = NOS_E_OVERFLOW;
+    }
+    else if (pending > 0) {
+        *sample = _Slot(topic, sub->seq);
+        sub->seq++;
+        err = NOS_OK;
+    }
+    else {
+        err = NOS_E_EMPTY;
+    }
+
+    return err;
+}
+
+nOS_Error nOS_TopicCreate (nOS_Topic *topic, void *buffer, uint16_t bsize, uint16_t bmax)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (topic == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (buffer == NULL) {
+        err = NOS_E_NULL;
+    }
+    else if ((bsize == 0) || (bmax == 0)) {
+        err = NOS_E_INV_VAL;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (topic->e.type != NOS_EVENT_INVALID) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        {
+            nOS_CreateEvent((nOS_Event*)topic
+#if (NOS_CONFIG_SAFE > 0)
+                           ,NOS_EVENT_TOPIC
+#endif
+                           );
+            topic->buffer = (uint8_t*)buffer;
+            topic->bsize  = bsize;
+            topic->bmax   = bmax;
+            topic->seq    = 0;
+
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+
+#if (NOS_CONFIG_TOPIC_DELETE_ENABLE > 0)
+nOS_Error nOS_TopicDelete (nOS_Topic *topic)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (topic == NULL) {
+        err = NOS_E_INV_OBJ;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (topic->e.type != NOS_EVENT_TOPIC) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        {
+            topic->buffer = NULL;
+            topic->bsize  = 0;
+            topic->bmax   = 0;
+            topic->seq    = 0;
+            nOS_DeleteEvent((nOS_Event*)topic);
+
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+#endif
+
+nOS_Error nOS_TopicPublish (nOS_Topic *topic, const void *sample)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (topic == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (sample == NULL) {
+        err = NOS_E_NULL;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (topic->e.type != NOS_EVENT_TOPIC) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        {
+            memcpy(_Slot(topic, topic->seq), sample, topic->bsize);
+            topic->seq++;
+            /* Waiting subscribers have all read every sample, wake up them together */
+            if (topic->e.waitList.head != NULL) {
+                nOS_BroadcastEvent((nOS_Event*)topic, NOS_OK);
+            }
+
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+
+nOS_Error nOS_TopicSubscribe (nOS_Topic *topic, nOS_Subscriber *sub)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (topic == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (sub == NULL) {
+        err = NOS_E_INV_OBJ;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (topic->e.type != NOS_EVENT_TOPIC) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        {
+            sub->topic = topic;
+            sub->seq   = topic->seq;
+
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+
+nOS_Error nOS_TopicReceive (nOS_Subscriber *sub, const void **sample, nOS_TickCounter timeout)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (sub == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (sample == NULL) {
+        err = NOS_E_NULL;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if ((sub->topic == NULL) || (sub->topic->e.type != NOS_EVENT_TOPIC)) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        {
+            err = _TakeSample(sub, sample);
+            if ((err == NOS_E_EMPTY) && (timeout != NOS_NO_WAIT)) {
+                err = nOS_WaitForEvent((nOS_Event*)sub->topic,
+                                       NOS_THREAD_READING_TOPIC
+#if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0)
+                                      ,timeout
+#elif (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
+                                      ,NOS_WAIT_INFINITE
+#endif
+                                      );
+                if (err == NOS_OK) {
+                    /* Woken up by publisher, but others may have published again before subscriber could run */
+                    err = _TakeSample(sub, sample);
+                }
+            }
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+
+bool nOS_TopicIsValid (nOS_Subscriber *sub)
+{
+    nOS_StatusReg   sr;
+    bool            valid;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (sub == NULL) {
+        valid = false;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if ((sub->topic == NULL) || (sub->topic->e.type != NOS_EVENT_TOPIC)) {
+            valid = false;
+        } else
+#endif
+        {
+            /* Last received sample is version (seq - 1), its slot is reused when version (seq - 1 + bmax) is published */
+            valid = ((uint32_t)(sub->topic->seq - sub->seq) < sub->topic->bmax);
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return valid;
+}
+#endif  /* NOS_CONFIG_TOPIC_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
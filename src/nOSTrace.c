@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2014-2016 Jim Tremblay
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#define NOS_PRIVATE
+#include "nOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if (NOS_CONFIG_TRACE_ENABLE > 0)
+#define _NextIndex(i)                   ((uint16_t)(((i) + 1) < NOS_CONFIG_TRACE_BUFFER_SIZE ? ((i) + 1) : 0))
+
+static nOS_TraceRecord  _buffer[NOS_CONFIG_TRACE_BUFFER_SIZE];
+static uint16_t         _r;
+static uint16_t         _w;
+static uint16_t         _count;
+static uint16_t         _seq;
+
+/* Called from critical section, overwrite oldest record when buffer is full */
+void nOS_TraceWrite (nOS_TraceType type, void *object, uint8_t arg)
+{
+    nOS_TraceRecord *record = &_buffer[_w];
+
+#if (NOS_CONFIG_CYCLE_COUNTER_ENABLE > 0)
+    record->time   = (uint32_t)nOS_GetCycleCount();
+#else
+    record->time   = (uint32_t)nOS_tickCounter;
+#endif
+    record->object = (uint32_t)(size_t)object;
+    record->seq    = _seq++;
+    record->type   = (uint8_t)type;
+    record->arg    = arg;
+
+    _w = _NextIndex(_w);
+    if (_count < NOS_CONFIG_TRACE_BUFFER_SIZE) {
+        _count++;
+    }
+    else {
+        _r = _NextIndex(_r);
+    }
+}
+
+nOS_Error nOS_TraceRead (nOS_TraceRecord *record)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (record == NULL) {
+        err = NOS_E_NULL;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+        if (_count == 0) {
+            err = NOS_E_EMPTY;
+        }
+        else {
+            *record = _buffer[_r];
+            _r = _NextIndex(_r);
+            _count--;
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+#endif  /* NOS_CONFIG_TRACE_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) 2014-2016 Jim Tremblay
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#define NOS_PRIVATE
+#include "nOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if (NOS_CONFIG_WORKQUEUE_ENABLE > 0)
+/* Work items are linked in queue with their own node, so submitting never allocate. A work item stay at the head of
+ * the queue until its last chunk is claimed, each worker claiming the next chunk of the range under critical section.
+ * Workers wait on the main event, threads waiting for all work to complete wait on the second one. */
+static nOS_Error _Submit (nOS_WorkQueue *workq, nOS_Work *work, nOS_WorkCallback callback, void *arg,
+                          uint32_t begin, uint32_t end, uint32_t chunk)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+    uint32_t        chunks;
+
+    nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+    if (workq->e.type != NOS_EVENT_WORKQUEUE) {
+        err = NOS_E_INV_OBJ;
+    } else
+#endif
+    {
+        work->callback = callback;
+        work->arg      = arg;
+        work->next     = begin;
+        work->end      = end;
+        work->chunk    = chunk;
+        nOS_SetNodeOwner(&work->node, work);
+        nOS_AppendToList(&workq->list, &work->node);
+
+        /* Wake up one waiting worker per chunk at most */
+        chunks = ((end - begin) / chunk) + ((((end - begin) % chunk) != 0) ? 1 : 0);
+        while ((chunks > 0) && (nOS_SendEvent(&workq->e, NOS_OK) != NULL)) {
+            chunks--;
+        }
+#if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
+        /* Verify if a highest prio thread is ready to run */
+        nOS_Schedule();
+#endif
+
+        err = NOS_OK;
+    }
+    nOS_LeaveCritical(sr);
+
+    return err;
+}
+
+nOS_Error nOS_WorkQueueCreate (nOS_WorkQueue *workq)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (workq == NULL) {
+        err = NOS_E_INV_OBJ;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (workq->e.type != NOS_EVENT_INVALID) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        {
+            nOS_CreateEvent((nOS_Event*)workq
+#if (NOS_CONFIG_SAFE > 0)
+                           ,NOS_EVENT_WORKQUEUE
+#endif
+                           );
+            nOS_CreateEvent(&workq->done
+#if (NOS_CONFIG_SAFE > 0)
+                           ,NOS_EVENT_WORKQUEUE
+#endif
+                           );
+            nOS_InitList(&workq->list);
+            workq->running = 0;
+
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+
+#if (NOS_CONFIG_WORKQUEUE_DELETE_ENABLE > 0)
+/* Work items still in queue are not touched, their nodes are simply forgotten */
+nOS_Error nOS_WorkQueueDelete (nOS_WorkQueue *workq)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (workq == NULL) {
+        err = NOS_E_INV_OBJ;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (workq->e.type != NOS_EVENT_WORKQUEUE) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        {
+            nOS_InitList(&workq->list);
+            workq->running = 0;
+            nOS_DeleteEvent(&workq->done);
+            nOS_DeleteEvent((nOS_Event*)workq);
+
+            err = NOS_OK;
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+#endif
+
+nOS_Error nOS_WorkQueueSubmit (nOS_WorkQueue *workq, nOS_Work *work, nOS_WorkCallback callback, void *arg)
+{
+    nOS_Error       err;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (workq == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (work == NULL) {
+        err = NOS_E_NULL;
+    }
+    else if (callback == NULL) {
+        err = NOS_E_NULL;
+    } else
+#endif
+    {
+        /* Single job is a range of one index */
+        err = _Submit(workq, work, callback, arg, 0, 1, 1);
+    }
+
+    return err;
+}
+
+nOS_Error nOS_WorkQueueFor (nOS_WorkQueue *workq, nOS_Work *work, nOS_WorkCallback callback, void *arg,
+                            uint32_t begin, uint32_t end, uint32_t chunk)
+{
+    nOS_Error       err;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (workq == NULL) {
+        err = NOS_E_INV_OBJ;
+    }
+    else if (work == NULL) {
+        err = NOS_E_NULL;
+    }
+    else if (callback == NULL) {
+        err = NOS_E_NULL;
+    }
+    else if ((begin >= end) || (chunk == 0)) {
+        err = NOS_E_INV_VAL;
+    } else
+#endif
+    {
+        err = _Submit(workq, work, callback, arg, begin, end, chunk);
+    }
+
+    return err;
+}
+
+nOS_Error nOS_WorkQueueExecute (nOS_WorkQueue *workq, nOS_TickCounter timeout)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+    nOS_Work        *work;
+    uint32_t        begin;
+    uint32_t        end;
+#if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0)
+    nOS_TickCounter start;
+    nOS_TickCounter elapsed;
+#endif
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (workq == NULL) {
+        err = NOS_E_INV_OBJ;
+    } else
+#endif
+    {
+        work = NULL;
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (workq->e.type != NOS_EVENT_WORKQUEUE) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        {
+#if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0)
+            start = nOS_tickCounter;
+#endif
+            do {
+                work = nOS_GetHeadOfList(&workq->list, nOS_Work, node);
+                if (work != NULL) {
+                    begin = work->next;
+                    end = ((work->end - begin) > work->chunk) ? (begin + work->chunk) : work->end;
+                    work->next = end;
+                    if (end == work->end) {
+                        /* Last chunk claimed, work item can be reused once done */
+                        nOS_RemoveFromList(&workq->list, &work->node);
+                    }
+                    workq->running++;
+                    err = NOS_OK;
+                }
+                else if (timeout == NOS_NO_WAIT) {
+                    err = NOS_E_EMPTY;
+                }
+                else {
+                    /* Another worker can claim the chunk before this one run, wait again for the remaining time */
+#if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0)
+                    if (timeout != NOS_WAIT_INFINITE) {
+                        elapsed = nOS_tickCounter - start;
+                        timeout = (elapsed < timeout) ? (timeout - elapsed) : NOS_NO_WAIT;
+                        start = nOS_tickCounter;
+                    }
+                    if (timeout == NOS_NO_WAIT) {
+                        err = NOS_E_TIMEOUT;
+                    } else
+#endif
+                    {
+                        err = nOS_WaitForEvent((nOS_Event*)workq,
+                                               NOS_THREAD_WAITING_WORK
+#if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0)
+                                              ,timeout
+#elif (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
+                                              ,NOS_WAIT_INFINITE
+#endif
+                                              );
+                    }
+                }
+            } while ((err == NOS_OK) && (work == NULL));
+        }
+        nOS_LeaveCritical(sr);
+
+        if (work != NULL) {
+            /* Run chunk outside of critical section */
+            work->callback(work->arg, begin, end);
+
+            nOS_EnterCritical(sr);
+            workq->running--;
+            if ((workq->running == 0) && (workq->list.head == NULL)) {
+                /* Wake up all threads waiting for work completion */
+                nOS_BroadcastEvent(&workq->done, NOS_OK);
+            }
+            nOS_LeaveCritical(sr);
+        }
+    }
+
+    return err;
+}
+
+nOS_Error nOS_WorkQueueWait (nOS_WorkQueue *workq, nOS_TickCounter timeout)
+{
+    nOS_Error       err;
+    nOS_StatusReg   sr;
+
+#if (NOS_CONFIG_SAFE > 0)
+    if (workq == NULL) {
+        err = NOS_E_INV_OBJ;
+    } else
+#endif
+    {
+        nOS_EnterCritical(sr);
+#if (NOS_CONFIG_SAFE > 0)
+        if (workq->e.type != NOS_EVENT_WORKQUEUE) {
+            err = NOS_E_INV_OBJ;
+        } else
+#endif
+        if ((workq->running == 0) && (workq->list.head == NULL)) {
+            err = NOS_OK;
+        }
+        else if (timeout == NOS_NO_WAIT) {
+            err = NOS_E_AGAIN;
+        }
+        else {
+            err = nOS_WaitForEvent(&workq->done,
+                                   NOS_THREAD_JOINING_WORK
+#if (NOS_CONFIG_WAITING_TIMEOUT_ENABLE > 0)
+                                  ,timeout
+#elif (NOS_CONFIG_SLEEP_ENABLE > 0) || (NOS_CONFIG_SLEEP_UNTIL_ENABLE > 0)
+                                  ,NOS_WAIT_INFINITE
+#endif
+                                  );
+        }
+        nOS_LeaveCritical(sr);
+    }
+
+    return err;
+}
+#endif  /* NOS_CONFIG_WORKQUEUE_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
@@ -16,6 +16,12 @@ extern "C" {
 void PendSV_Handler(void) __attribute__( ( naked ) );
 
 static nOS_Stack _isrStack[NOS_CONFIG_ISR_STACK_SIZE] __attribute__ ( ( section(".noinit") ) );
+#if (NOS_CONFIG_KERNEL_IRQ_MASK > 0)
+/* Only accessed with interrupts disabled, saved by outermost critical section */
+static nOS_StatusReg _nesting;
+static uint32_t _enabledIrqs;
+static uint32_t _tickState;
+#endif
 
 void nOS_InitSpecific(void)
 {
@@ -76,8 +82,98 @@ void nOS_InitContext(nOS_Thread *thread, nOS_Stack *stack, size_t ssize, nOS_Thr
     thread->stackPtr = tos;
 }
 
+#if (NOS_CONFIG_KERNEL_IRQ_MASK > 0)
+/* Interrupts are globally disabled only for a few instructions to save and change masks atomically. SysTick is a
+ * system exception that can't be disabled in NVIC, its interrupt is disabled in SysTick itself and a tick that elapse
+ * meanwhile is pended again when leaving outermost critical section. */
+nOS_StatusReg nOS_MaskKernelIrqs (void)
+{
+    nOS_StatusReg   sr;
+    uint32_t        primask = _GetPRIMASK();
+
+    _DI();
+    sr = _nesting;
+    if (sr == 0) {
+        /* Save enabled kernel interrupts from NVIC_ISER and disable them with NVIC_ICER */
+        _enabledIrqs = *(volatile uint32_t *)0xE000E100UL & NOS_CONFIG_KERNEL_IRQ_MASK;
+        *(volatile uint32_t *)0xE000E180UL = NOS_CONFIG_KERNEL_IRQ_MASK;
+        /* Clear TICKINT, reading SysTick CSR also clear COUNTFLAG */
+        _tickState = *(volatile uint32_t *)0xE000E010UL & 0x00000002UL;
+        if (_tickState != 0) {
+            *(volatile uint32_t *)0xE000E010UL &=~ 0x00000002UL;
+            if (*(volatile uint32_t *)0xE000ED04UL & 0x04000000UL) {
+                /* Tick already pending, move it after critical section */
+                *(volatile uint32_t *)0xE000ED04UL = 0x02000000UL;
+                _tickState |= 0x00010000UL;
+            }
+        }
+        _DSB();
+        _ISB();
+    }
+    _nesting = sr + 1;
+    _SetPRIMASK(primask);
+
+    return sr;
+}
+
+void nOS_UnmaskKernelIrqs (nOS_StatusReg sr)
+{
+    uint32_t        primask;
+    uint32_t        csr;
+#if (NOS_CONFIG_SCHED_DEFERRED_ENABLE > 0)
+    bool            resched = false;
+
+    /* Take pending scheduling decision while kernel interrupts are still disabled */
+    if ((sr == 0) && nOS_needResched) {
+        resched = nOS_ResolveSchedule();
+    }
+#endif
+
+    primask = _GetPRIMASK();
+    _DI();
+    _nesting = sr;
+    if (sr == 0) {
+        if (_tickState != 0) {
+            csr = *(volatile uint32_t *)0xE000E010UL;
+            *(volatile uint32_t *)0xE000E010UL = csr | 0x00000002UL;
+            /* COUNTFLAG set if SysTick reached zero while its interrupt was disabled */
+            if (((csr | *(volatile uint32_t *)0xE000E010UL) & 0x00010000UL) || (_tickState & 0x00010000UL)) {
+                *(volatile uint32_t *)0xE000ED04UL = 0x04000000UL;
+            }
+        }
+        *(volatile uint32_t *)0xE000E100UL = _enabledIrqs;
+#if (NOS_CONFIG_SCHED_DEFERRED_ENABLE > 0)
+        if (resched) {
+            /* PendSV can't be disabled in NVIC, request it only when leaving outermost critical section */
+            *(volatile uint32_t *)0xE000ED04UL = 0x10000000UL;
+        }
+#endif
+        _DSB();
+        _ISB();
+    }
+    _SetPRIMASK(primask);
+}
+#endif
+
 void nOS_SwitchContext (void)
 {
+#if (NOS_CONFIG_KERNEL_IRQ_MASK > 0)
+    nOS_StatusReg   sr = _nesting;
+
+    /* PendSV can't be disabled in NVIC, leave critical section before requesting context switch */
+    nOS_UnmaskKernelIrqs(0);
+
+    /* Request context switch */
+    *(volatile uint32_t *)0xE000ED04UL = 0x10000000UL;
+    _DSB();
+    _ISB();
+
+    _NOP();
+
+    /* Enter critical section again at same nesting level */
+    (void)nOS_MaskKernelIrqs();
+    _nesting = sr;
+#else
     /* Request context switch */
     *(volatile uint32_t *)0xE000ED04UL = 0x10000000UL;
 
@@ -92,6 +188,7 @@ void nOS_SwitchContext (void)
     _DI();
     _DSB();
     _ISB();
+#endif
 }
 
 void nOS_EnterIsr (void)
@@ -104,6 +201,7 @@ void nOS_EnterIsr (void)
     {
         nOS_EnterCritical(sr);
         nOS_isrNestingCounter++;
+        nOS_Trace(NOS_TRACE_ISR_ENTER, NULL, nOS_isrNestingCounter);
         nOS_LeaveCritical(sr);
     }
 }
@@ -118,18 +216,21 @@ void nOS_LeaveIsr (void)
     {
         nOS_EnterCritical(sr);
         nOS_isrNestingCounter--;
-#if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0) || (NOS_CONFIG_SCHED_ROUND_ROBIN_ENABLE > 0)
+        nOS_Trace(NOS_TRACE_ISR_LEAVE, NULL, nOS_isrNestingCounter);
+#if (NOS_CONFIG_SCHED_DEFERRED_ENABLE > 0)
+        /* Pending scheduling decision is taken only once by nOS_LeaveCritical when leaving outermost interrupt */
+#elif (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0) || (NOS_CONFIG_SCHED_ROUND_ROBIN_ENABLE > 0)
         if (nOS_isrNestingCounter == 0) {
  #if (NOS_CONFIG_SCHED_LOCK_ENABLE > 0)
             if (nOS_lockNestingCounter == 0)
  #endif
             {
  #if (NOS_CONFIG_HIGHEST_THREAD_PRIO == 0)
-                nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList);
+                nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList, nOS_Thread, readyWait);
  #elif (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
                 nOS_highPrioThread = nOS_FindHighPrioThread();
  #else
-                nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList[nOS_runningThread->prio]);
+                nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList[nOS_runningThread->prio], nOS_Thread, readyWait);
  #endif
                 if (nOS_runningThread != nOS_highPrioThread) {
                     *(volatile uint32_t *)0xE000ED04UL = 0x10000000UL;
@@ -141,6 +242,135 @@ void nOS_LeaveIsr (void)
     }
 }
 
+#if (NOS_CONFIG_TICKLESS_ENABLE > 0)
+void nOS_TicklessIdle (void)
+{
+    nOS_TickCounter ticks;
+    nOS_TickCounter elapsed;
+    uint32_t        period;
+    uint32_t        cycles;
+    uint32_t        count;
+    uint32_t        next;
+
+    /* Disable interrupts, a pending interrupt will still wake up the CPU from WFI */
+    _DI();
+    _DSB();
+    _ISB();
+
+    ticks = nOS_GetNextWakeupTicks();
+    if (ticks > 1) {
+        /* Number of cycles per tick as configured by the application */
+        period = *(volatile uint32_t *)0xE000E014UL + 1;
+        /* SysTick counter is limited to 24 bits */
+        if (ticks > (nOS_TickCounter)(0x00FFFFFFUL / period)) {
+            ticks = (nOS_TickCounter)(0x00FFFFFFUL / period);
+        }
+
+        /* Stop SysTick and reload it with what remain of current tick plus ticks to skip */
+        *(volatile uint32_t *)0xE000E010UL &=~ 0x00000001UL;
+        cycles = *(volatile uint32_t *)0xE000E018UL + ((uint32_t)(ticks - 1) * period);
+        *(volatile uint32_t *)0xE000E014UL = cycles - 1;
+        *(volatile uint32_t *)0xE000E018UL = 0;
+        *(volatile uint32_t *)0xE000E010UL |= 0x00000001UL;
+
+        _DSB();
+        _WFI();
+        _ISB();
+
+        /* Stop SysTick, reading COUNTFLAG clear it */
+        if (*(volatile uint32_t *)0xE000E010UL & 0x00010000UL) {
+            *(volatile uint32_t *)0xE000E010UL &=~ 0x00000001UL;
+            /* Whole period elapsed, SysTick interrupt is pending and will send the last tick */
+            elapsed = ticks - 1;
+            count = ((cycles - 1) - *(volatile uint32_t *)0xE000E018UL) % period;
+        }
+        else {
+            *(volatile uint32_t *)0xE000E010UL &=~ 0x00000001UL;
+            /* Woken up by another interrupt, compute completed ticks */
+            count = cycles - *(volatile uint32_t *)0xE000E018UL;
+            elapsed = (nOS_TickCounter)(count / period);
+            count %= period;
+        }
+        next = period - count;
+        if (next <= 1) {
+            /* Current tick is practically completed */
+            elapsed++;
+            next = period;
+        }
+
+        /* Restart SysTick with what remain of current tick, next ticks will use normal period */
+        *(volatile uint32_t *)0xE000E014UL = next - 1;
+        *(volatile uint32_t *)0xE000E018UL = 0;
+        *(volatile uint32_t *)0xE000E010UL |= 0x00000001UL;
+        *(volatile uint32_t *)0xE000E014UL = period - 1;
+
+        if (elapsed > 0) {
+            /* Send elapsed ticks like from SysTick handler to request context switch if needed */
+            nOS_EnterIsr();
+            nOS_Tick(elapsed);
+            nOS_LeaveIsr();
+        }
+    }
+    else if (ticks == 1) {
+        /* Next event is on next tick, just wait for SysTick interrupt */
+        _DSB();
+        _WFI();
+        _ISB();
+    }
+
+    _EI();
+    _DSB();
+    _ISB();
+}
+#endif
+
+#if (NOS_CONFIG_POWER_ENABLE > 0)
+NOS_CONST nOS_PowerMode nOS_powerModes[NOS_POWER_MODE_COUNT] = {
+    {0,                                 true},      /* NOS_POWER_SLEEP: core clock stopped, SysTick keep running */
+    {NOS_CONFIG_POWER_DEEP_LATENCY,     false}      /* NOS_POWER_DEEP_SLEEP: device specific, SysTick stopped */
+};
+
+void nOS_PowerIdle (void)
+{
+    nOS_TickCounter ticks;
+
+    /* Disable interrupts, a pending interrupt will still wake up the CPU from WFI */
+    _DI();
+    _DSB();
+    _ISB();
+
+#if (NOS_CONFIG_TICKLESS_ENABLE > 0)
+    ticks = nOS_GetNextWakeupTicks();
+#else
+    ticks = 1;
+#endif
+    if (ticks > 0) {
+        if (nOS_PowerSelectMode(ticks) == NOS_POWER_DEEP_SLEEP) {
+            /* Nothing is waiting on ticks, set SLEEPDEEP bit only for this WFI */
+            *(volatile uint32_t *)0xE000ED10UL |= 0x00000004UL;
+            _DSB();
+            _WFI();
+            _ISB();
+            *(volatile uint32_t *)0xE000ED10UL &=~ 0x00000004UL;
+        }
+        else {
+#if (NOS_CONFIG_TICKLESS_ENABLE > 0)
+            /* Skip ticks until next event, interrupts are enabled again when leaving */
+            nOS_TicklessIdle();
+#else
+            _DSB();
+            _WFI();
+            _ISB();
+#endif
+        }
+    }
+
+    _EI();
+    _DSB();
+    _ISB();
+}
+#endif
+
 void PendSV_Handler(void)
 {
     __asm volatile (
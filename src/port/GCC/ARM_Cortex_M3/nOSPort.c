@@ -35,6 +35,12 @@ void nOS_InitSpecific(void)
     _SetCONTROL(_GetCONTROL() | 0x00000002UL);
     /* Set PendSV exception to lowest priority */
     *(volatile uint32_t *)0xE000ED20UL |= 0x00FF0000UL;
+#if (NOS_CONFIG_CYCLE_COUNTER_ENABLE > 0)
+    /* Enable trace and start DWT cycle counter */
+    *(volatile uint32_t *)0xE000EDFCUL |= 0x01000000UL;
+    *(volatile uint32_t *)0xE0001004UL = 0;
+    *(volatile uint32_t *)0xE0001000UL |= 0x00000001UL;
+#endif
 }
 
 void nOS_InitContext(nOS_Thread *thread, nOS_Stack *stack, size_t ssize, nOS_ThreadEntry entry, void *arg)
@@ -116,6 +122,7 @@ void nOS_EnterIsr (void)
     {
         nOS_EnterCritical(sr);
         nOS_isrNestingCounter++;
+        nOS_Trace(NOS_TRACE_ISR_ENTER, NULL, nOS_isrNestingCounter);
         nOS_LeaveCritical(sr);
     }
 }
@@ -130,18 +137,21 @@ void nOS_LeaveIsr (void)
     {
         nOS_EnterCritical(sr);
         nOS_isrNestingCounter--;
-#if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0) || (NOS_CONFIG_SCHED_ROUND_ROBIN_ENABLE > 0)
+        nOS_Trace(NOS_TRACE_ISR_LEAVE, NULL, nOS_isrNestingCounter);
+#if (NOS_CONFIG_SCHED_DEFERRED_ENABLE > 0)
+        /* Pending scheduling decision is taken only once by nOS_LeaveCritical when leaving outermost interrupt */
+#elif (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0) || (NOS_CONFIG_SCHED_ROUND_ROBIN_ENABLE > 0)
         if (nOS_isrNestingCounter == 0) {
  #if (NOS_CONFIG_SCHED_LOCK_ENABLE > 0)
             if (nOS_lockNestingCounter == 0)
  #endif
             {
  #if (NOS_CONFIG_HIGHEST_THREAD_PRIO == 0)
-                nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList);
+                nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList, nOS_Thread, readyWait);
  #elif (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
                 nOS_highPrioThread = nOS_FindHighPrioThread();
  #else
-                nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList[nOS_runningThread->prio]);
+                nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList[nOS_runningThread->prio], nOS_Thread, readyWait);
  #endif
                 if (nOS_runningThread != nOS_highPrioThread) {
                     *(volatile uint32_t *)0xE000ED04UL = 0x10000000UL;
@@ -153,6 +163,135 @@ void nOS_LeaveIsr (void)
     }
 }
 
+#if (NOS_CONFIG_TICKLESS_ENABLE > 0)
+void nOS_TicklessIdle (void)
+{
+    nOS_TickCounter ticks;
+    nOS_TickCounter elapsed;
+    uint32_t        period;
+    uint32_t        cycles;
+    uint32_t        count;
+    uint32_t        next;
+
+    /* Disable interrupts, a pending interrupt will still wake up the CPU from WFI */
+    _DI();
+    _DSB();
+    _ISB();
+
+    ticks = nOS_GetNextWakeupTicks();
+    if (ticks > 1) {
+        /* Number of cycles per tick as configured by the application */
+        period = *(volatile uint32_t *)0xE000E014UL + 1;
+        /* SysTick counter is limited to 24 bits */
+        if (ticks > (nOS_TickCounter)(0x00FFFFFFUL / period)) {
+            ticks = (nOS_TickCounter)(0x00FFFFFFUL / period);
+        }
+
+        /* Stop SysTick and reload it with what remain of current tick plus ticks to skip */
+        *(volatile uint32_t *)0xE000E010UL &=~ 0x00000001UL;
+        cycles = *(volatile uint32_t *)0xE000E018UL + ((uint32_t)(ticks - 1) * period);
+        *(volatile uint32_t *)0xE000E014UL = cycles - 1;
+        *(volatile uint32_t *)0xE000E018UL = 0;
+        *(volatile uint32_t *)0xE000E010UL |= 0x00000001UL;
+
+        _DSB();
+        _WFI();
+        _ISB();
+
+        /* Stop SysTick, reading COUNTFLAG clear it */
+        if (*(volatile uint32_t *)0xE000E010UL & 0x00010000UL) {
+            *(volatile uint32_t *)0xE000E010UL &=~ 0x00000001UL;
+            /* Whole period elapsed, SysTick interrupt is pending and will send the last tick */
+            elapsed = ticks - 1;
+            count = ((cycles - 1) - *(volatile uint32_t *)0xE000E018UL) % period;
+        }
+        else {
+            *(volatile uint32_t *)0xE000E010UL &=~ 0x00000001UL;
+            /* Woken up by another interrupt, compute completed ticks */
+            count = cycles - *(volatile uint32_t *)0xE000E018UL;
+            elapsed = (nOS_TickCounter)(count / period);
+            count %= period;
+        }
+        next = period - count;
+        if (next <= 1) {
+            /* Current tick is practically completed */
+            elapsed++;
+            next = period;
+        }
+
+        /* Restart SysTick with what remain of current tick, next ticks will use normal period */
+        *(volatile uint32_t *)0xE000E014UL = next - 1;
+        *(volatile uint32_t *)0xE000E018UL = 0;
+        *(volatile uint32_t *)0xE000E010UL |= 0x00000001UL;
+        *(volatile uint32_t *)0xE000E014UL = period - 1;
+
+        if (elapsed > 0) {
+            /* Send elapsed ticks like from SysTick handler to request context switch if needed */
+            nOS_EnterIsr();
+            nOS_Tick(elapsed);
+            nOS_LeaveIsr();
+        }
+    }
+    else if (ticks == 1) {
+        /* Next event is on next tick, just wait for SysTick interrupt */
+        _DSB();
+        _WFI();
+        _ISB();
+    }
+
+    _EI();
+    _DSB();
+    _ISB();
+}
+#endif
+
+#if (NOS_CONFIG_POWER_ENABLE > 0)
+NOS_CONST nOS_PowerMode nOS_powerModes[NOS_POWER_MODE_COUNT] = {
+    {0,                                 true},      /* NOS_POWER_SLEEP: core clock stopped, SysTick keep running */
+    {NOS_CONFIG_POWER_DEEP_LATENCY,     false}      /* NOS_POWER_DEEP_SLEEP: device specific, SysTick stopped */
+};
+
+void nOS_PowerIdle (void)
+{
+    nOS_TickCounter ticks;
+
+    /* Disable interrupts, a pending interrupt will still wake up the CPU from WFI */
+    _DI();
+    _DSB();
+    _ISB();
+
+#if (NOS_CONFIG_TICKLESS_ENABLE > 0)
+    ticks = nOS_GetNextWakeupTicks();
+#else
+    ticks = 1;
+#endif
+    if (ticks > 0) {
+        if (nOS_PowerSelectMode(ticks) == NOS_POWER_DEEP_SLEEP) {
+            /* Nothing is waiting on ticks, set SLEEPDEEP bit only for this WFI */
+            *(volatile uint32_t *)0xE000ED10UL |= 0x00000004UL;
+            _DSB();
+            _WFI();
+            _ISB();
+            *(volatile uint32_t *)0xE000ED10UL &=~ 0x00000004UL;
+        }
+        else {
+#if (NOS_CONFIG_TICKLESS_ENABLE > 0)
+            /* Skip ticks until next event, interrupts are enabled again when leaving */
+            nOS_TicklessIdle();
+#else
+            _DSB();
+            _WFI();
+            _ISB();
+#endif
+        }
+    }
+
+    _EI();
+    _DSB();
+    _ISB();
+}
+#endif
+
 void PendSV_Handler(void)
 {
     __asm volatile (
@@ -173,6 +312,12 @@ void PendSV_Handler(void)
         /* Save PSP to nOS_Thread object of current running thread */
         "STR        R0,         [R2]                \n"
 
+#if (NOS_CONFIG_THREAD_STATS_ENABLE > 0) || (NOS_CONFIG_TRACE_ENABLE > 0)
+        /* Account elapsed time slice and trace context switch, R0-R3, R12 and LR are not needed anymore */
+        "BL         nOS_AccountSwitch               \n"
+        "LDR        R3,         runningThread       \n"
+#endif
+
         /* Get the location of nOS_highPrioThread */
         "LDR        R1,         highPrioThread      \n"
         "LDR        R2,         [R1]                \n"
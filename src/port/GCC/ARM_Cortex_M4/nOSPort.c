@@ -35,6 +35,16 @@ void nOS_InitSpecific(void)
     _SetCONTROL(_GetCONTROL() | 0x00000002UL);
     /* Set PendSV exception to lowest priority */
     *(volatile uint32_t *)0xE000ED20UL |= 0x00FF0000UL;
+#if (NOS_CONFIG_CYCLE_COUNTER_ENABLE > 0)
+    /* Enable trace and start DWT cycle counter */
+    *(volatile uint32_t *)0xE000EDFCUL |= 0x01000000UL;
+    *(volatile uint32_t *)0xE0001004UL = 0;
+    *(volatile uint32_t *)0xE0001000UL |= 0x00000001UL;
+#endif
+#if defined(__VFP_FP__) && !defined(__SOFTFP__)
+    /* Enable automatic and lazy FP context stacking, S0-S15 are saved on exception entry only when really needed */
+    *(volatile uint32_t *)0xE000EF34UL |= 0xC0000000UL;
+#endif
 }
 
 void nOS_InitContext(nOS_Thread *thread, nOS_Stack *stack, size_t ssize, nOS_ThreadEntry entry, void *arg)
@@ -117,6 +127,7 @@ void nOS_EnterIsr (void)
     {
         nOS_EnterCritical(sr);
         nOS_isrNestingCounter++;
+        nOS_Trace(NOS_TRACE_ISR_ENTER, NULL, nOS_isrNestingCounter);
         nOS_LeaveCritical(sr);
     }
 }
@@ -131,18 +142,21 @@ void nOS_LeaveIsr (void)
     {
         nOS_EnterCritical(sr);
         nOS_isrNestingCounter--;
-#if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0) || (NOS_CONFIG_SCHED_ROUND_ROBIN_ENABLE > 0)
+        nOS_Trace(NOS_TRACE_ISR_LEAVE, NULL, nOS_isrNestingCounter);
+#if (NOS_CONFIG_SCHED_DEFERRED_ENABLE > 0)
+        /* Pending scheduling decision is taken only once by nOS_LeaveCritical when leaving outermost interrupt */
+#elif (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0) || (NOS_CONFIG_SCHED_ROUND_ROBIN_ENABLE > 0)
         if (nOS_isrNestingCounter == 0) {
  #if (NOS_CONFIG_SCHED_LOCK_ENABLE > 0)
             if (nOS_lockNestingCounter == 0)
  #endif
             {
  #if (NOS_CONFIG_HIGHEST_THREAD_PRIO == 0)
-                nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList);
+                nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList, nOS_Thread, readyWait);
  #elif (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
                 nOS_highPrioThread = nOS_FindHighPrioThread();
  #else
-                nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList[nOS_runningThread->prio]);
+                nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList[nOS_runningThread->prio], nOS_Thread, readyWait);
  #endif
                 if (nOS_runningThread != nOS_highPrioThread) {
                     *(volatile uint32_t *)0xE000ED04UL = 0x10000000UL;
@@ -154,6 +168,135 @@ void nOS_LeaveIsr (void)
     }
 }
 
+#if (NOS_CONFIG_TICKLESS_ENABLE > 0)
+void nOS_TicklessIdle (void)
+{
+    nOS_TickCounter ticks;
+    nOS_TickCounter elapsed;
+    uint32_t        period;
+    uint32_t        cycles;
+    uint32_t        count;
+    uint32_t        next;
+
+    /* Disable interrupts, a pending interrupt will still wake up the CPU from WFI */
+    _DI();
+    _DSB();
+    _ISB();
+
+    ticks = nOS_GetNextWakeupTicks();
+    if (ticks > 1) {
+        /* Number of cycles per tick as configured by the application */
+        period = *(volatile uint32_t *)0xE000E014UL + 1;
+        /* SysTick counter is limited to 24 bits */
+        if (ticks > (nOS_TickCounter)(0x00FFFFFFUL / period)) {
+            ticks = (nOS_TickCounter)(0x00FFFFFFUL / period);
+        }
+
+        /* Stop SysTick and reload it with what remain of current tick plus ticks to skip */
+        *(volatile uint32_t *)0xE000E010UL &=~ 0x00000001UL;
+        cycles = *(volatile uint32_t *)0xE000E018UL + ((uint32_t)(ticks - 1) * period);
+        *(volatile uint32_t *)0xE000E014UL = cycles - 1;
+        *(volatile uint32_t *)0xE000E018UL = 0;
+        *(volatile uint32_t *)0xE000E010UL |= 0x00000001UL;
+
+        _DSB();
+        _WFI();
+        _ISB();
+
+        /* Stop SysTick, reading COUNTFLAG clear it */
+        if (*(volatile uint32_t *)0xE000E010UL & 0x00010000UL) {
+            *(volatile uint32_t *)0xE000E010UL &=~ 0x00000001UL;
+            /* Whole period elapsed, SysTick interrupt is pending and will send the last tick */
+            elapsed = ticks - 1;
+            count = ((cycles - 1) - *(volatile uint32_t *)0xE000E018UL) % period;
+        }
+        else {
+            *(volatile uint32_t *)0xE000E010UL &=~ 0x00000001UL;
+            /* Woken up by another interrupt, compute completed ticks */
+            count = cycles - *(volatile uint32_t *)0xE000E018UL;
+            elapsed = (nOS_TickCounter)(count / period);
+            count %= period;
+        }
+        next = period - count;
+        if (next <= 1) {
+            /* Current tick is practically completed */
+            elapsed++;
+            next = period;
+        }
+
+        /* Restart SysTick with what remain of current tick, next ticks will use normal period */
+        *(volatile uint32_t *)0xE000E014UL = next - 1;
+        *(volatile uint32_t *)0xE000E018UL = 0;
+        *(volatile uint32_t *)0xE000E010UL |= 0x00000001UL;
+        *(volatile uint32_t *)0xE000E014UL = period - 1;
+
+        if (elapsed > 0) {
+            /* Send elapsed ticks like from SysTick handler to request context switch if needed */
+            nOS_EnterIsr();
+            nOS_Tick(elapsed);
+            nOS_LeaveIsr();
+        }
+    }
+    else if (ticks == 1) {
+        /* Next event is on next tick, just wait for SysTick interrupt */
+        _DSB();
+        _WFI();
+        _ISB();
+    }
+
+    _EI();
+    _DSB();
+    _ISB();
+}
+#endif
+
+#if (NOS_CONFIG_POWER_ENABLE > 0)
+NOS_CONST nOS_PowerMode nOS_powerModes[NOS_POWER_MODE_COUNT] = {
+    {0,                                 true},      /* NOS_POWER_SLEEP: core clock stopped, SysTick keep running */
+    {NOS_CONFIG_POWER_DEEP_LATENCY,     false}      /* NOS_POWER_DEEP_SLEEP: device specific, SysTick stopped */
+};
+
+void nOS_PowerIdle (void)
+{
+    nOS_TickCounter ticks;
+
+    /* Disable interrupts, a pending interrupt will still wake up the CPU from WFI */
+    _DI();
+    _DSB();
+    _ISB();
+
+#if (NOS_CONFIG_TICKLESS_ENABLE > 0)
+    ticks = nOS_GetNextWakeupTicks();
+#else
+    ticks = 1;
+#endif
+    if (ticks > 0) {
+        if (nOS_PowerSelectMode(ticks) == NOS_POWER_DEEP_SLEEP) {
+            /* Nothing is waiting on ticks, set SLEEPDEEP bit only for this WFI */
+            *(volatile uint32_t *)0xE000ED10UL |= 0x00000004UL;
+            _DSB();
+            _WFI();
+            _ISB();
+            *(volatile uint32_t *)0xE000ED10UL &=~ 0x00000004UL;
+        }
+        else {
+#if (NOS_CONFIG_TICKLESS_ENABLE > 0)
+            /* Skip ticks until next event, interrupts are enabled again when leaving */
+            nOS_TicklessIdle();
+#else
+            _DSB();
+            _WFI();
+            _ISB();
+#endif
+        }
+    }
+
+    _EI();
+    _DSB();
+    _ISB();
+}
+#endif
+
 void PendSV_Handler(void)
 {
     __asm volatile (
@@ -181,6 +324,12 @@ void PendSV_Handler(void)
         /* Save PSP to nOS_Thread object of current running thread */
         "STR        R0,         [R2]                \n"
 
+#if (NOS_CONFIG_THREAD_STATS_ENABLE > 0) || (NOS_CONFIG_TRACE_ENABLE > 0)
+        /* Account elapsed time slice and trace context switch, R0-R3, R12 and LR are not needed anymore */
+        "BL         nOS_AccountSwitch               \n"
+        "LDR        R3,         runningThread       \n"
+#endif
+
         /* Get the location of nOS_highPrioThread */
         "LDR        R1,         highPrioThread      \n"
         "LDR        R2,         [R1]                \n"
@@ -188,6 +337,20 @@ void PendSV_Handler(void)
         /* Copy nOS_highPrioThread to nOS_runningThread */
         "STR        R2,         [R3]                \n"
 
+#if defined(__VFP_FP__) && !defined(__SOFTFP__) && (NOS_CONFIG_THREAD_FPU_ENABLE > 0)
+        /* Give FPU access (CP10 and CP11) to high prio thread only if it use it */
+        "LDR        R3,         cpacr               \n"
+        "LDR        R1,         [R3]                \n"
+        "BIC        R1,         R1,     #0x00F00000 \n"
+        "LDRB       R12,        [R2, #4]            \n"
+        "CMP        R12,        #0                  \n"
+        "IT         NE                              \n"
+        "ORRNE      R1,         R1,     #0x00F00000 \n"
+        "STR        R1,         [R3]                \n"
+        "DSB                                        \n"
+        "ISB                                        \n"
+#endif
+
         /* Restore PSP from nOS_Thread object of high prio thread */
         "LDR        R0,         [R2]                \n"
 
@@ -214,6 +377,9 @@ void PendSV_Handler(void)
         ".align 2                                   \n"
         "runningThread: .word nOS_runningThread     \n"
         "highPrioThread: .word nOS_highPrioThread   \n"
+#if defined(__VFP_FP__) && !defined(__SOFTFP__) && (NOS_CONFIG_THREAD_FPU_ENABLE > 0)
+        "cpacr: .word 0xE000ED88                    \n"
+#endif
     );
 }
 
@@ -9,6 +9,10 @@
 #define NOS_PRIVATE
 #include "nOS.h"
 
+#if (NOS_CONFIG_POWER_ENABLE > 0)
+ #include <avr/sleep.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -17,6 +21,13 @@ extern "C" {
  static nOS_Stack _isrStack[NOS_CONFIG_ISR_STACK_SIZE];
 #endif
 
+#if (NOS_CONFIG_POWER_ENABLE > 0)
+NOS_CONST nOS_PowerMode nOS_powerModes[NOS_POWER_MODE_COUNT] = {
+    {0,                                 true},      /* NOS_POWER_IDLE: CPU and flash clocks stopped */
+    {NOS_CONFIG_POWER_DEEP_LATENCY,     false}      /* NOS_POWER_DOWN: oscillator stopped, start up time on wake up */
+};
+#endif
+
 void nOS_InitSpecific(void)
 {
 #ifdef NOS_CONFIG_ISR_STACK_SIZE
@@ -101,14 +112,17 @@ void nOS_InitContext(nOS_Thread *thread, nOS_Stack *stack, size_t ssize, nOS_Thr
 #else
      tos  -= 6;                                     /* R26 to R31 */
 #endif
+    *tos-- = 0x00;                                  /* Frame marker: all registers */
 
     thread->stackPtr = tos;
 }
 
-/* Absolutely need a naked function because function call push the return address on the stack */
+/* Absolutely need a naked function because function call push the return address on the stack. Switch is always
+ * requested by running thread with interrupts disabled, so only registers preserved across function calls are saved,
+ * other registers are already considered lost by caller. */
 void nOS_SwitchContext(void)
 {
-    PUSH_CONTEXT();
+    PUSH_CALL_CONTEXT();
     nOS_runningThread->stackPtr = (uint8_t*)SP;
     nOS_runningThread = nOS_highPrioThread;
     SP = (int)nOS_highPrioThread->stackPtr;
@@ -132,6 +146,7 @@ nOS_Stack *nOS_EnterIsr (nOS_Stack *sp)
 #endif
         }
         nOS_isrNestingCounter++;
+        nOS_Trace(NOS_TRACE_ISR_ENTER, NULL, nOS_isrNestingCounter);
     }
 
     return sp;
@@ -145,6 +160,7 @@ nOS_Stack *nOS_LeaveIsr (nOS_Stack *sp)
     {
         /* Interrupts already disabled before leaving ISR */
         nOS_isrNestingCounter--;
+        nOS_Trace(NOS_TRACE_ISR_LEAVE, NULL, nOS_isrNestingCounter);
         if (nOS_isrNestingCounter == 0) {
 #if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0) || (NOS_CONFIG_SCHED_ROUND_ROBIN_ENABLE > 0)
  #if (NOS_CONFIG_SCHED_LOCK_ENABLE > 0)
@@ -152,11 +168,11 @@ nOS_Stack *nOS_LeaveIsr (nOS_Stack *sp)
  #endif
             {
  #if (NOS_CONFIG_HIGHEST_THREAD_PRIO == 0)
-                nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList);
+                nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList, nOS_Thread, readyWait);
  #elif (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
                 nOS_highPrioThread = nOS_FindHighPrioThread();
  #else
-                nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList[nOS_runningThread->prio]);
+                nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList[nOS_runningThread->prio], nOS_Thread, readyWait);
  #endif
                 nOS_runningThread = nOS_highPrioThread;
             }
@@ -168,6 +184,36 @@ nOS_Stack *nOS_LeaveIsr (nOS_Stack *sp)
     return sp;
 }
 
+#if (NOS_CONFIG_POWER_ENABLE > 0)
+void nOS_PowerIdle (void)
+{
+    nOS_TickCounter ticks;
+
+    cli();
+
+#if (NOS_CONFIG_TICKLESS_ENABLE > 0)
+    ticks = nOS_GetNextWakeupTicks();
+#else
+    ticks = 1;
+#endif
+    if (ticks > 0) {
+        if (nOS_PowerSelectMode(ticks) == NOS_POWER_DOWN) {
+            set_sleep_mode(SLEEP_MODE_PWR_DOWN);
+        }
+        else {
+            set_sleep_mode(SLEEP_MODE_IDLE);
+        }
+        sleep_enable();
+        /* Instruction following sei is always executed before pending interrupts, wake up can't be missed */
+        sei();
+        sleep_cpu();
+        sleep_disable();
+    }
+
+    sei();
+}
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -17,6 +17,29 @@ extern "C" {
  static nOS_Stack _isrStack[NOS_CONFIG_ISR_STACK_SIZE];
 #endif
 
+#if (NOS_CONFIG_POWER_ENABLE > 0)
+/* Typical wake up latencies, tick timer is expected to be clocked by ACLK that keep running up to LPM3. */
+NOS_CONST nOS_PowerMode nOS_powerModes[NOS_POWER_MODE_COUNT] = {
+    {0,                                 true},      /* NOS_POWER_LPM0: CPU and MCLK off */
+    {6,                                 true},      /* NOS_POWER_LPM1: DCO off if not used by SMCLK */
+    {6,                                 true},      /* NOS_POWER_LPM2: SMCLK off */
+    {150,                               true},      /* NOS_POWER_LPM3: only ACLK on */
+    {NOS_CONFIG_POWER_DEEP_LATENCY,     false}      /* NOS_POWER_LPM4: all clocks off */
+};
+static NOS_CONST uint16_t _lpmBits[NOS_POWER_MODE_COUNT] = {
+    LPM0_bits, LPM1_bits, LPM2_bits, LPM3_bits, LPM4_bits
+};
+static volatile bool _sleeping;
+
+/* Offset in bytes from stack pointer given to nOS_EnterIsr to SR saved by interrupt: frame pushed by NOS_ISR (all
+ * registers and marker), SR pushed by NOS_ISR and return address of call from interrupt vector. */
+ #if (__MSP430X_LARGE__ > 0)
+  #define _SR_OFFSET                58
+ #else
+  #define _SR_OFFSET                30
+ #endif
+#endif
+
 void nOS_InitContext(nOS_Thread *thread, nOS_Stack *stack, size_t ssize, nOS_ThreadEntry entry, void *arg)
 {
     /* Stack grow from high to low address */
@@ -58,10 +81,11 @@ void nOS_InitContext(nOS_Thread *thread, nOS_Stack *stack, size_t ssize, nOS_Thr
     *tos-- = (nOS_Stack)0x07070707;                 /* R7 */
     *tos-- = (nOS_Stack)0x06060606;                 /* R6 */
     *tos-- = (nOS_Stack)0x05050505;                 /* R5 */
-    *tos   = (nOS_Stack)0x04040404;                 /* R4 */
+    *tos-- = (nOS_Stack)0x04040404;                 /* R4 */
 #else
-     tos  -= 7;                                     /* R11 to R4 */
+     tos  -= 8;                                     /* R11 to R4 */
 #endif
+    *tos   = (nOS_Stack)0;                          /* Frame marker: all registers */
 
     thread->stackPtr = tos;
 }
@@ -72,8 +96,9 @@ void nOS_SwitchContextHandler(void)
         /* Simulate an interrupt by pushing SR */
          PUSH_SR"                                   \n"
         "                                           \n"
-        /* Push all registers to running thread stack */
-         PUSH_CONTEXT"                              \n"
+        /* Push registers preserved across function calls to running thread stack, switch is always requested by
+         * running thread and others are already considered lost by caller */
+         PUSH_CALL_FRAME"                           \n"
         "                                           \n"
         /* Save stack pointer to running thread structure */
          MOV_X"     &nOS_runningThread,     r12     \n"
@@ -87,8 +112,8 @@ void nOS_SwitchContextHandler(void)
         /* Restore stack pointer from high prio thread structure */
          MOV_X"     @r12,                   sp      \n"
         "                                           \n"
-        /* Pop all registers from high prio thread stack */
-         POP_CONTEXT"                               \n"
+        /* Pop registers saved in high prio thread stack */
+         POP_FRAME"                                 \n"
         "                                           \n"
          POP_SR"                                    \n"
         "                                           \n"
@@ -104,6 +129,13 @@ nOS_Stack* nOS_EnterIsr (nOS_Stack *sp)
     {
         if (nOS_isrNestingCounter == 0) {
             nOS_runningThread->stackPtr = sp;
+#if (NOS_CONFIG_POWER_ENABLE > 0)
+            if (_sleeping) {
+                /* Main thread is in low power mode, don't go back to sleep when returning to it */
+                *(volatile uint16_t *)((uint8_t *)sp + _SR_OFFSET) &=~ LPM4_bits;
+                _sleeping = false;
+            }
+#endif
 #ifdef NOS_CONFIG_ISR_STACK_SIZE
             sp = &_isrStack[NOS_CONFIG_ISR_STACK_SIZE-1];
 #else
@@ -111,6 +143,7 @@ nOS_Stack* nOS_EnterIsr (nOS_Stack *sp)
 #endif
         }
         nOS_isrNestingCounter++;
+        nOS_Trace(NOS_TRACE_ISR_ENTER, NULL, nOS_isrNestingCounter);
     }
 
     return sp;
@@ -123,6 +156,7 @@ nOS_Stack* nOS_LeaveIsr (nOS_Stack *sp)
 #endif
     {
         nOS_isrNestingCounter--;
+        nOS_Trace(NOS_TRACE_ISR_LEAVE, NULL, nOS_isrNestingCounter);
         if (nOS_isrNestingCounter == 0) {
 #if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0) || (NOS_CONFIG_SCHED_ROUND_ROBIN_ENABLE > 0)
  #if (NOS_CONFIG_SCHED_LOCK_ENABLE > 0)
@@ -130,11 +164,11 @@ nOS_Stack* nOS_LeaveIsr (nOS_Stack *sp)
  #endif
             {
  #if (NOS_CONFIG_HIGHEST_THREAD_PRIO == 0)
-                nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList);
+                nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList, nOS_Thread, readyWait);
  #elif (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
                 nOS_highPrioThread = nOS_FindHighPrioThread();
  #else
-                nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList[nOS_runningThread->prio]);
+                nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList[nOS_runningThread->prio], nOS_Thread, readyWait);
  #endif
                 nOS_runningThread = nOS_highPrioThread;
             }
@@ -146,6 +180,33 @@ nOS_Stack* nOS_LeaveIsr (nOS_Stack *sp)
     return sp;
 }
 
+#if (NOS_CONFIG_POWER_ENABLE > 0)
+void nOS_PowerIdle (void)
+{
+    nOS_TickCounter ticks;
+    uint8_t         mode;
+
+    __disable_interrupt();
+    __no_operation();
+
+#if (NOS_CONFIG_TICKLESS_ENABLE > 0)
+    ticks = nOS_GetNextWakeupTicks();
+#else
+    ticks = 1;
+#endif
+    if (ticks > 0) {
+        mode = nOS_PowerSelectMode(ticks);
+        _sleeping = true;
+        /* Enter low power mode and enable interrupts with the same instruction, wake up can't be missed */
+        __bis_SR_register(_lpmBits[mode] | GIE);
+        __no_operation();
+        _sleeping = false;
+    }
+
+    __enable_interrupt();
+}
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -6,11 +6,16 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/.
  */
 
+#include "nOSConfig.h"
+
     RSEG    CODE:CODE(2)
     thumb
 
     EXTERN nOS_runningThread
     EXTERN nOS_highPrioThread
+#if (NOS_CONFIG_THREAD_STATS_ENABLE > 0) || (NOS_CONFIG_TRACE_ENABLE > 0)
+    EXTERN nOS_AccountSwitch
+#endif
 
     PUBLIC PendSV_Handler
 
@@ -31,6 +36,11 @@ PendSV_Handler:
 
     /* Save PSP to nOS_Thread object of current running thread */
     STR         R0,         [R2]
+#if (NOS_CONFIG_THREAD_STATS_ENABLE > 0) || (NOS_CONFIG_TRACE_ENABLE > 0)
+    /* Account elapsed time slice and trace context switch, R0-R3, R12 and LR are not needed anymore */
+    BL          nOS_AccountSwitch
+    LDR         R3,         =nOS_runningThread
+#endif
 
     /* Get the location of nOS_highPrioThread */
     LDR         R1,         =nOS_highPrioThread
@@ -6,11 +6,16 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/.
  */
 
+#include "nOSConfig.h"
+
     RSEG    CODE:CODE(2)
     thumb
 
     EXTERN nOS_runningThread
     EXTERN nOS_highPrioThread
+#if (NOS_CONFIG_THREAD_STATS_ENABLE > 0) || (NOS_CONFIG_TRACE_ENABLE > 0)
+    EXTERN nOS_AccountSwitch
+#endif
 
     PUBLIC PendSV_Handler
 
@@ -38,6 +43,11 @@ PendSV_Handler:
 
     /* Save PSP to nOS_Thread object of current running thread */
     STR         R0,         [R2]
+#if (NOS_CONFIG_THREAD_STATS_ENABLE > 0) || (NOS_CONFIG_TRACE_ENABLE > 0)
+    /* Account elapsed time slice and trace context switch, R0-R3, R12 and LR are not needed anymore */
+    BL          nOS_AccountSwitch
+    LDR         R3,         =nOS_runningThread
+#endif
 
     /* Get the location of nOS_highPrioThread */
     LDR         R1,         =nOS_highPrioThread
@@ -46,6 +56,20 @@ PendSV_Handler:
     /* Copy nOS_highPrioThread to nOS_runningThread */
     STR         R2,         [R3]
 
+#if defined(__ARMVFP__) && (NOS_CONFIG_THREAD_FPU_ENABLE > 0)
+    /* Give FPU access (CP10 and CP11) to high prio thread only if it use it */
+    LDR         R3,         =0xE000ED88
+    LDR         R1,         [R3]
+    BIC         R1,         R1,         #0x00F00000
+    LDRB        R12,        [R2, #4]
+    CMP         R12,        #0
+    IT          NE
+    ORRNE       R1,         R1,         #0x00F00000
+    STR         R1,         [R3]
+    DSB
+    ISB
+#endif
+
     /* Restore PSP from nOS_Thread object of high prio thread */
     LDR         R0,         [R2]
 
@@ -129,6 +129,7 @@ void nOS_EnterIsr (nOS_Stack *sp)
             nOS_runningThread->stackPtr = sp;
         }
         nOS_isrNestingCounter++;
+        nOS_Trace(NOS_TRACE_ISR_ENTER, NULL, nOS_isrNestingCounter);
     }
 }
 
@@ -140,6 +141,7 @@ nOS_Stack *nOS_LeaveIsr (nOS_Stack *sp)
     {
         /* Interrupts already disabled before leaving ISR */
         nOS_isrNestingCounter--;
+        nOS_Trace(NOS_TRACE_ISR_LEAVE, NULL, nOS_isrNestingCounter);
         if (nOS_isrNestingCounter == 0) {
 #if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0) || (NOS_CONFIG_SCHED_ROUND_ROBIN_ENABLE > 0)
  #if (NOS_CONFIG_SCHED_LOCK_ENABLE > 0)
@@ -147,11 +149,11 @@ nOS_Stack *nOS_LeaveIsr (nOS_Stack *sp)
  #endif
             {
  #if (NOS_CONFIG_HIGHEST_THREAD_PRIO == 0)
-                nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList);
+                nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList, nOS_Thread, readyWait);
  #elif (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
                 nOS_highPrioThread = nOS_FindHighPrioThread();
  #else
-                nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList[nOS_runningThread->prio]);
+                nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList[nOS_runningThread->prio], nOS_Thread, readyWait);
  #endif
                 nOS_runningThread = nOS_highPrioThread;
             }
@@ -14,6 +14,12 @@ extern "C" {
 #endif
 
 static nOS_Stack _isrStack[NOS_CONFIG_ISR_STACK_SIZE];
+#if (NOS_CONFIG_KERNEL_IRQ_MASK > 0)
+/* Only accessed with interrupts disabled, saved by outermost critical section */
+static nOS_StatusReg _nesting;
+static uint32_t _enabledIrqs;
+static uint32_t _tickState;
+#endif
 
 void nOS_InitSpecific(void)
 {
@@ -74,8 +80,98 @@ void nOS_InitContext(nOS_Thread *thread, nOS_Stack *stack, size_t ssize, nOS_Thr
     thread->stackPtr = tos;
 }
 
+#if (NOS_CONFIG_KERNEL_IRQ_MASK > 0)
+/* Interrupts are globally disabled only for a few instructions to save and change masks atomically. SysTick is a
+ * system exception that can't be disabled in NVIC, its interrupt is disabled in SysTick itself and a tick that elapse
+ * meanwhile is pended again when leaving outermost critical section. */
+nOS_StatusReg nOS_MaskKernelIrqs (void)
+{
+    nOS_StatusReg   sr;
+    uint32_t        primask = _GetPRIMASK();
+
+    __disable_irq();
+    sr = _nesting;
+    if (sr == 0) {
+        /* Save enabled kernel interrupts from NVIC_ISER and disable them with NVIC_ICER */
+        _enabledIrqs = *(volatile uint32_t *)0xE000E100UL & NOS_CONFIG_KERNEL_IRQ_MASK;
+        *(volatile uint32_t *)0xE000E180UL = NOS_CONFIG_KERNEL_IRQ_MASK;
+        /* Clear TICKINT, reading SysTick CSR also clear COUNTFLAG */
+        _tickState = *(volatile uint32_t *)0xE000E010UL & 0x00000002UL;
+        if (_tickState != 0) {
+            *(volatile uint32_t *)0xE000E010UL &=~ 0x00000002UL;
+            if (*(volatile uint32_t *)0xE000ED04UL & 0x04000000UL) {
+                /* Tick already pending, move it after critical section */
+                *(volatile uint32_t *)0xE000ED04UL = 0x02000000UL;
+                _tickState |= 0x00010000UL;
+            }
+        }
+        __dsb(0xF);
+        __isb(0xF);
+    }
+    _nesting = sr + 1;
+    _SetPRIMASK(primask);
+
+    return sr;
+}
+
+void nOS_UnmaskKernelIrqs (nOS_StatusReg sr)
+{
+    uint32_t        primask;
+    uint32_t        csr;
+#if (NOS_CONFIG_SCHED_DEFERRED_ENABLE > 0)
+    bool            resched = false;
+
+    /* Take pending scheduling decision while kernel interrupts are still disabled */
+    if ((sr == 0) && nOS_needResched) {
+        resched = nOS_ResolveSchedule();
+    }
+#endif
+
+    primask = _GetPRIMASK();
+    __disable_irq();
+    _nesting = sr;
+    if (sr == 0) {
+        if (_tickState != 0) {
+            csr = *(volatile uint32_t *)0xE000E010UL;
+            *(volatile uint32_t *)0xE000E010UL = csr | 0x00000002UL;
+            /* COUNTFLAG set if SysTick reached zero while its interrupt was disabled */
+            if (((csr | *(volatile uint32_t *)0xE000E010UL) & 0x00010000UL) || (_tickState & 0x00010000UL)) {
+                *(volatile uint32_t *)0xE000ED04UL = 0x04000000UL;
+            }
+        }
+        *(volatile uint32_t *)0xE000E100UL = _enabledIrqs;
+#if (NOS_CONFIG_SCHED_DEFERRED_ENABLE > 0)
+        if (resched) {
+            /* PendSV can't be disabled in NVIC, request it only when leaving outermost critical section */
+            *(volatile uint32_t *)0xE000ED04UL = 0x10000000UL;
+        }
+#endif
+        __dsb(0xF);
+        __isb(0xF);
+    }
+    _SetPRIMASK(primask);
+}
+#endif
+
 void nOS_SwitchContext (void)
 {
+#if (NOS_CONFIG_KERNEL_IRQ_MASK > 0)
+    nOS_StatusReg   sr = _nesting;
+
+    /* PendSV can't be disabled in NVIC, leave critical section before requesting context switch */
+    nOS_UnmaskKernelIrqs(0);
+
+    /* Request context switch */
+    *(volatile uint32_t *)0xE000ED04UL = 0x10000000UL;
+    __dsb(0xF);
+    __isb(0xF);
+
+    __nop();
+
+    /* Enter critical section again at same nesting level */
+    (void)nOS_MaskKernelIrqs();
+    _nesting = sr;
+#else
     /* Request context switch */
     *(volatile uint32_t *)0xE000ED04UL = 0x10000000UL;
 
@@ -90,6 +186,7 @@ void nOS_SwitchContext (void)
     __disable_irq();
     __dsb(0xF);
     __isb(0xF);
+#endif
 }
 
 void nOS_EnterIsr (void)
@@ -102,6 +199,7 @@ void nOS_EnterIsr (void)
     {
         nOS_EnterCritical(sr);
         nOS_isrNestingCounter++;
+        nOS_Trace(NOS_TRACE_ISR_ENTER, NULL, nOS_isrNestingCounter);
         nOS_LeaveCritical(sr);
     }
 }
@@ -116,18 +214,21 @@ void nOS_LeaveIsr (void)
     {
         nOS_EnterCritical(sr);
         nOS_isrNestingCounter--;
-#if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0) || (NOS_CONFIG_SCHED_ROUND_ROBIN_ENABLE > 0)
+        nOS_Trace(NOS_TRACE_ISR_LEAVE, NULL, nOS_isrNestingCounter);
+#if (NOS_CONFIG_SCHED_DEFERRED_ENABLE > 0)
+        /* Pending scheduling decision is taken only once by nOS_LeaveCritical when leaving outermost interrupt */
+#elif (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0) || (NOS_CONFIG_SCHED_ROUND_ROBIN_ENABLE > 0)
         if (nOS_isrNestingCounter == 0) {
  #if (NOS_CONFIG_SCHED_LOCK_ENABLE > 0)
             if (nOS_lockNestingCounter == 0)
  #endif
             {
  #if (NOS_CONFIG_HIGHEST_THREAD_PRIO == 0)
-                nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList);
+                nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList, nOS_Thread, readyWait);
  #elif (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
                 nOS_highPrioThread = nOS_FindHighPrioThread();
  #else
-                nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList[nOS_runningThread->prio]);
+                nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList[nOS_runningThread->prio], nOS_Thread, readyWait);
  #endif
                 if (nOS_runningThread != nOS_highPrioThread) {
                     *(volatile uint32_t *)0xE000ED04UL = 0x10000000UL;
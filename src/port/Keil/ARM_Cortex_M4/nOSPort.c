@@ -33,6 +33,16 @@ void nOS_InitSpecific(void)
     _SetCONTROL(_GetCONTROL() | 0x00000002UL);
     /* Set PendSV exception to lowest priority */
     *(volatile uint32_t *)0xE000ED20UL |= 0x00FF0000UL;
+#if (NOS_CONFIG_CYCLE_COUNTER_ENABLE > 0)
+    /* Enable trace and start DWT cycle counter */
+    *(volatile uint32_t *)0xE000EDFCUL |= 0x01000000UL;
+    *(volatile uint32_t *)0xE0001004UL = 0;
+    *(volatile uint32_t *)0xE0001000UL |= 0x00000001UL;
+#endif
+#if defined(__TARGET_FPU_VFP)
+    /* Enable automatic and lazy FP context stacking, S0-S15 are saved on exception entry only when really needed */
+    *(volatile uint32_t *)0xE000EF34UL |= 0xC0000000UL;
+#endif
 }
 
 void nOS_InitContext(nOS_Thread *thread, nOS_Stack *stack, size_t ssize, nOS_ThreadEntry entry, void *arg)
@@ -115,6 +125,7 @@ void nOS_EnterIsr (void)
     {
         nOS_EnterCritical(sr);
         nOS_isrNestingCounter++;
+        nOS_Trace(NOS_TRACE_ISR_ENTER, NULL, nOS_isrNestingCounter);
         nOS_LeaveCritical(sr);
     }
 }
@@ -129,18 +140,21 @@ void nOS_LeaveIsr (void)
     {
         nOS_EnterCritical(sr);
         nOS_isrNestingCounter--;
-#if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0) || (NOS_CONFIG_SCHED_ROUND_ROBIN_ENABLE > 0)
+        nOS_Trace(NOS_TRACE_ISR_LEAVE, NULL, nOS_isrNestingCounter);
+#if (NOS_CONFIG_SCHED_DEFERRED_ENABLE > 0)
+        /* Pending scheduling decision is taken only once by nOS_LeaveCritical when leaving outermost interrupt */
+#elif (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0) || (NOS_CONFIG_SCHED_ROUND_ROBIN_ENABLE > 0)
         if (nOS_isrNestingCounter == 0) {
  #if (NOS_CONFIG_SCHED_LOCK_ENABLE > 0)
             if (nOS_lockNestingCounter == 0)
  #endif
             {
  #if (NOS_CONFIG_HIGHEST_THREAD_PRIO == 0)
-                nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList);
+                nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList, nOS_Thread, readyWait);
  #elif (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
                 nOS_highPrioThread = nOS_FindHighPrioThread();
  #else
-                nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList[nOS_runningThread->prio]);
+                nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList[nOS_runningThread->prio], nOS_Thread, readyWait);
  #endif
                 if (nOS_runningThread != nOS_highPrioThread) {
                     *(volatile uint32_t *)0xE000ED04UL = 0x10000000UL;
@@ -156,6 +170,9 @@ __asm void PendSV_Handler(void)
 {
     extern nOS_runningThread;
     extern nOS_highPrioThread;
+#if (NOS_CONFIG_THREAD_STATS_ENABLE > 0) || (NOS_CONFIG_TRACE_ENABLE > 0)
+    extern nOS_AccountSwitch;
+#endif
 
     /* Disable interrupts */
     CPSID       I
@@ -180,6 +197,11 @@ __asm void PendSV_Handler(void)
 
     /* Save PSP to nOS_Thread object of current running thread */
     STR         R0,         [R2]
+#if (NOS_CONFIG_THREAD_STATS_ENABLE > 0) || (NOS_CONFIG_TRACE_ENABLE > 0)
+    /* Account elapsed time slice and trace context switch, R0-R3, R12 and LR are not needed anymore */
+    BL          nOS_AccountSwitch
+    LDR         R3,         =nOS_runningThread
+#endif
 
     /* Get the location of nOS_highPrioThread */
     LDR         R1,         =nOS_highPrioThread
@@ -188,6 +210,20 @@ __asm void PendSV_Handler(void)
     /* Copy nOS_highPrioThread to nOS_runningThread */
     STR         R2,         [R3]
 
+#if defined(__TARGET_FPU_VFP) && (NOS_CONFIG_THREAD_FPU_ENABLE > 0)
+    /* Give FPU access (CP10 and CP11) to high prio thread only if it use it */
+    LDR         R3,         =0xE000ED88
+    LDR         R1,         [R3]
+    BIC         R1,         R1,         #0x00F00000
+    LDRB        R12,        [R2, #4]
+    CMP         R12,        #0
+    IT          NE
+    ORRNE       R1,         R1,         #0x00F00000
+    STR         R1,         [R3]
+    DSB
+    ISB
+#endif
+
     /* Restore PSP from nOS_Thread object of high prio thread */
     LDR         R0,         [R2]
 
@@ -16,18 +16,47 @@
 #include <stdio.h>
 #include <stdarg.h>
 #include <time.h>
+#include <errno.h>
+#include <sched.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-volatile uint32_t       nOS_criticalNestingCounter;
-pthread_mutex_t         nOS_criticalSection;
+NOS_PORT_TLS volatile uint32_t  nOS_criticalNestingCounter;
+pthread_mutex_t                 nOS_criticalSection;
+#if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+NOS_PORT_TLS uint8_t            nOS_coreId;
+#endif
 
-static pthread_cond_t   _schedCond;
-volatile bool           _schedStarted;
-volatile bool           _schedRequest;
 static nOS_Stack        _idleStack;
+#if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+/* Idle threads of cores other than core 0 (main thread) */
+static nOS_Stack        _coreIdleStack[NOS_CONFIG_SMP_CORE_COUNT-1];
+static pthread_cond_t   _coreCond[NOS_CONFIG_SMP_CORE_COUNT];
+static bool             _corePending[NOS_CONFIG_SMP_CORE_COUNT];
+#endif
+#if (NOS_CONFIG_HRTIMER_ENABLE > 0)
+static pthread_cond_t   _hrCond;
+static bool             _hrArmed;
+static uint32_t         _hrCompare;
+#endif
+
+/* Called from critical section, wait to have the permission to run (given by previous running thread) */
+static void _WaitToRun (nOS_Stack *stack)
+{
+    while (!stack->running && !stack->exit) {
+        pthread_cond_wait(&stack->cond, &nOS_criticalSection);
+    }
+
+    if (stack->exit) {
+        /* Thread has been deleted and is created again in same stack, let creator continue without us */
+        stack->started = false;
+        pthread_cond_signal(&stack->cond);
+        pthread_mutex_unlock(&nOS_criticalSection);
+        pthread_exit(NULL);
+    }
+}
 
 static void* _Entry (void *arg)
 {
@@ -39,100 +68,249 @@ static void* _Entry (void *arg)
     thread->stackPtr->started = true;
     pthread_cond_signal(&thread->stackPtr->cond);
 
-    /* Wait to have the permission to run (given by scheduler) */
-    while (!thread->stackPtr->running) {
-        pthread_cond_wait(&thread->stackPtr->cond, &nOS_criticalSection);
-    }
+    _WaitToRun(thread->stackPtr);
 
     /* Initialize critical section counter */
     nOS_criticalNestingCounter = thread->stackPtr->crit;
+#if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+    /* Thread can have been moved to another core before its first run */
+    nOS_coreId = thread->core;
+#endif
 
     pthread_mutex_unlock(&nOS_criticalSection);
 
+#if (NOS_CONFIG_THREAD_JOIN_ENABLE > 0)
+    /* Entry return only when a finished thread is created again with same thread object and stack */
+    while (true) {
+        thread->stackPtr->entry(thread->stackPtr->arg);
+    }
+#else
     thread->stackPtr->entry(thread->stackPtr->arg);
+#endif
 
     return 0;
 }
 
-static void* _Scheduler (void *arg)
+#if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+/* Idle thread of other cores, run threads of its core until a reschedule request is received */
+static void* _CoreIdle (void *arg)
 {
-    pthread_mutex_lock(&nOS_criticalSection);
+    nOS_Thread  *thread = (nOS_Thread*)arg;
 
-    /* Signal to init we're running and ready to accept request */
-    _schedStarted = true;
-    pthread_cond_signal(&_schedCond);
+    nOS_coreId = thread->core;
 
-    /* Wait until scheduler is started */
-    pthread_mutex_unlock(&nOS_criticalSection);
-    while (!nOS_running) {
-        usleep(1000);
-    }
     pthread_mutex_lock(&nOS_criticalSection);
-
+    nOS_criticalNestingCounter = 1;
     while (true) {
-        /* Wait until a thread send a scheduling request */
-        while (!_schedRequest) {
-            pthread_cond_wait(&_schedCond, &nOS_criticalSection);
+        /* Request can be received while this core was running its threads, don't wait for another one */
+        while (!_corePending[nOS_coreId]) {
+            /* Mutex is released while waiting */
+            pthread_cond_wait(&_coreCond[nOS_coreId], &nOS_criticalSection);
         }
-        _schedRequest = false;
+        _corePending[nOS_coreId] = false;
+        if (nOS_running) {
+            nOS_Schedule();
+        }
+    }
 
-        /* Find next high prio thread and give him permission to run */
-#if (NOS_CONFIG_HIGHEST_THREAD_PRIO == 0)
-        nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList);
-#elif (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
-        nOS_highPrioThread = nOS_FindHighPrioThread();
-#else
-        nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList[nOS_runningThread->prio]);
+    return 0;
+}
 #endif
-        nOS_runningThread = nOS_highPrioThread;
-        nOS_highPrioThread->stackPtr->running = true;
-        pthread_cond_signal(&nOS_highPrioThread->stackPtr->cond);
-    }
 
-    pthread_mutex_unlock(&nOS_criticalSection);
+#define _TICK_PERIOD_NS                 (1000000000ULL / NOS_CONFIG_TICKS_PER_SECOND)
 
-    return 0;
+#if (NOS_CONFIG_VIRTUAL_TIME_ENABLE == 0) || (NOS_CONFIG_CYCLE_COUNTER_ENABLE > 0)
+static uint64_t _GetTimeNs (void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec);
 }
+#endif
+
+#if (NOS_CONFIG_VIRTUAL_TIME_ENABLE > 0)
+/* Called from critical section, true if no threads except main thread (idle) are ready to run */
+static bool _IsIdle (void)
+{
+#if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
+    return ((nOS_FindHighPrioThread() == &nOS_idleHandle) &&
+            (nOS_readyThreadsList[0].head == nOS_readyThreadsList[0].tail));
+#else
+    return (nOS_readyThreadsList.head == nOS_readyThreadsList.tail);
+#endif
+}
+#endif
 
 static void* _SysTick (void *arg)
 {
+    nOS_TickCounter     ticks;
+    uint32_t            crit;
+#if (NOS_CONFIG_VIRTUAL_TIME_ENABLE == 0)
+    uint64_t            next;
+    uint64_t            now;
+    uint64_t            late;
+    struct timespec     ts;
+#endif
+
     while (!nOS_running) {
         usleep(1000);
     }
 
+#if (NOS_CONFIG_VIRTUAL_TIME_ENABLE == 0)
+    next = _GetTimeNs();
+#endif
     while (true) {
-        usleep(1000000/NOS_CONFIG_TICKS_PER_SECOND);
+#if (NOS_CONFIG_VIRTUAL_TIME_ENABLE > 0)
+        /* Let threads run until they are all waiting */
+        sched_yield();
+#else
+        /* Sleep until absolute deadline of next tick, time spent in nOS_Tick don't accumulate */
+        next += _TICK_PERIOD_NS;
+        ts.tv_sec  = (time_t)(next / 1000000000ULL);
+        ts.tv_nsec = (long)(next % 1000000000ULL);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR);
+
+        /* Catch up missed periods if host was late to wake up */
+        ticks = 1;
+        now = _GetTimeNs();
+        if (now >= (next + _TICK_PERIOD_NS)) {
+            late   = (now - next) / _TICK_PERIOD_NS;
+            ticks += (nOS_TickCounter)late;
+            next  += late * _TICK_PERIOD_NS;
+        }
+#endif
 
         pthread_mutex_lock(&nOS_criticalSection);
+        /* Mutex can be released by a thread waiting on a condition inside its critical section (thread creation),
+         * keep its nesting counter like an interrupt keep context of interrupted code */
+        crit = nOS_criticalNestingCounter;
         nOS_criticalNestingCounter = 1;
 
-        /* Simulate entry in interrupt */
-        nOS_isrNestingCounter = 1;
+#if (NOS_CONFIG_VIRTUAL_TIME_ENABLE > 0)
+        if (!_IsIdle()) {
+            ticks = 0;
+        }
+ #if (NOS_CONFIG_TICKLESS_ENABLE > 0)
+        else {
+            /* Jump directly to next event */
+            ticks = nOS_GetNextWakeupTicks();
+            if ((ticks == 0) || (ticks == NOS_WAIT_INFINITE)) {
+                ticks = 1;
+            }
+        }
+ #else
+        else {
+            ticks = 1;
+        }
+ #endif
+#endif
+
+        if (ticks > 0) {
+            /* Simulate entry in interrupt */
+            nOS_isrNestingCounter = 1;
 
-        nOS_Tick(1);
+            nOS_Tick(ticks);
 
-        /* Simulate exit of interrupt */
-        nOS_isrNestingCounter = 0;
+            /* Simulate exit of interrupt */
+            nOS_isrNestingCounter = 0;
+#if (NOS_CONFIG_SCHED_DEFERRED_ENABLE > 0)
+            /* Host thread of running thread can't be preempted from here, pending decision is taken by running
+             * thread when it leave its outermost critical section (nOS_PendSchedule) */
+#endif
+        }
 
-        nOS_criticalNestingCounter = 0;
+        nOS_criticalNestingCounter = crit;
         pthread_mutex_unlock(&nOS_criticalSection);
     }
 
     return 0;
 }
 
+#if (NOS_CONFIG_HRTIMER_ENABLE > 0)
+/* Simulated compare interrupt, sleep until compare value is reached or moved */
+static void* _HrCompare (void *arg)
+{
+    int32_t             left;
+    uint64_t            ns;
+    uint32_t            crit;
+    struct timespec     ts;
+
+    NOS_UNUSED(arg);
+
+    pthread_mutex_lock(&nOS_criticalSection);
+    while (true) {
+        left = _hrArmed ? (int32_t)(_hrCompare - nOS_HrTimerReadCounter()) : 0;
+        if (!_hrArmed) {
+            /* Mutex is released while waiting */
+            pthread_cond_wait(&_hrCond, &nOS_criticalSection);
+        }
+        else if (left > 0) {
+            clock_gettime(CLOCK_MONOTONIC, &ts);
+            ns  = (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+            ns += ((uint64_t)left * 1000000000ULL + NOS_CONFIG_HRTIMER_FREQUENCY - 1) / NOS_CONFIG_HRTIMER_FREQUENCY;
+            ts.tv_sec  = (time_t)(ns / 1000000000ULL);
+            ts.tv_nsec = (long)(ns % 1000000000ULL);
+            /* Compare value can be changed while waiting, evaluate it again on wake up */
+            pthread_cond_timedwait(&_hrCond, &nOS_criticalSection, &ts);
+        }
+        else {
+            _hrArmed = false;
+            /* Keep nesting counter of thread that can wait on a condition inside its critical section */
+            crit = nOS_criticalNestingCounter;
+            nOS_criticalNestingCounter = 1;
+
+            /* Simulate entry in interrupt */
+            nOS_isrNestingCounter = 1;
+
+            nOS_HrTimerIsr();
+
+            /* Simulate exit of interrupt */
+            nOS_isrNestingCounter = 0;
+
+            nOS_criticalNestingCounter = crit;
+        }
+    }
+
+    return 0;
+}
+
+uint32_t nOS_HrTimerReadCounter (void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint32_t)((uint64_t)ts.tv_sec * NOS_CONFIG_HRTIMER_FREQUENCY +
+                      ((uint64_t)ts.tv_nsec * NOS_CONFIG_HRTIMER_FREQUENCY) / 1000000000ULL);
+}
+
+/* Called from critical section */
+void nOS_HrTimerSetCompare (uint32_t count)
+{
+    _hrCompare = count;
+    _hrArmed = true;
+    pthread_cond_signal(&_hrCond);
+}
+#endif
+
 void nOS_InitSpecific (void)
 {
     pthread_t pthread;
     pthread_mutexattr_t attr;
+#if (NOS_CONFIG_HRTIMER_ENABLE > 0)
+    pthread_condattr_t cattr;
+#endif
+#if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+    uint8_t c;
+#endif
 
     nOS_criticalNestingCounter = 0;
     pthread_mutexattr_init(&attr);
     pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
     pthread_mutex_init(&nOS_criticalSection, &attr);
 
-    pthread_cond_init (&_schedCond, NULL);
-
     nOS_idleHandle.stackPtr = &_idleStack;
     _idleStack.entry = NULL;
     _idleStack.arg = NULL;
@@ -141,64 +319,146 @@ void nOS_InitSpecific (void)
     _idleStack.running = true;
     pthread_cond_init(&_idleStack.cond, NULL);
 
-    pthread_mutex_lock(&nOS_criticalSection);
-
-    _schedStarted = false;
-    _schedRequest = false;
-    pthread_create(&pthread, NULL, _Scheduler, NULL);
-
-    /* Wait until scheduler is running and waiting for request */
-    while (!_schedStarted) {
-        pthread_cond_wait(&_schedCond, &nOS_criticalSection);
+#if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+    for (c = 0; c < NOS_CONFIG_SMP_CORE_COUNT; c++) {
+        pthread_cond_init(&_coreCond[c], NULL);
+        _corePending[c] = false;
+        if (c > 0) {
+            nOS_idleHandles[c].stackPtr = &_coreIdleStack[c-1];
+            _coreIdleStack[c-1].entry = NULL;
+            _coreIdleStack[c-1].arg = NULL;
+            _coreIdleStack[c-1].crit = 0;
+            _coreIdleStack[c-1].started = true;
+            _coreIdleStack[c-1].running = true;
+            pthread_cond_init(&_coreIdleStack[c-1].cond, NULL);
+            pthread_create(&_coreIdleStack[c-1].handle, NULL, _CoreIdle, &nOS_idleHandles[c]);
+        }
     }
+#endif
 
     /* Create a SysTick thread to allow sleep/timeout */
     pthread_create(&pthread, NULL, _SysTick, NULL);
 
-    pthread_mutex_unlock(&nOS_criticalSection);
+#if (NOS_CONFIG_HRTIMER_ENABLE > 0)
+    /* Compare deadlines are absolute values of monotonic clock */
+    pthread_condattr_init(&cattr);
+    pthread_condattr_setclock(&cattr, CLOCK_MONOTONIC);
+    pthread_cond_init(&_hrCond, &cattr);
+    _hrArmed = false;
+    pthread_create(&pthread, NULL, _HrCompare, NULL);
+#endif
 }
 
 /* Called from critical section */
 void nOS_InitContext (nOS_Thread *thread, nOS_Stack *stack, size_t ssize, nOS_ThreadEntry entry, void *arg)
 {
-    thread->stackPtr = stack;
-    stack->entry = entry;
-    stack->arg = arg;
-    stack->crit = 0;
-    stack->started = false;
-    stack->running = false;
+#if (NOS_CONFIG_THREAD_JOIN_ENABLE > 0)
+    if ((thread->stackPtr == stack) && stack->finished) {
+        /* Host thread of finished thread is waiting in nOS_ThreadWrapper, it will return to _Entry and call new entry
+         * when it get permission to run, critical nesting counter saved at its last switch is left as is */
+        stack->entry = entry;
+        stack->arg = arg;
+        stack->running = false;
+        stack->finished = false;
+    } else
+#endif
+    {
+        if ((thread->stackPtr == stack) && stack->started) {
+            /* Host thread of deleted thread is still waiting for permission to run somewhere in its old entry */
+            stack->exit = true;
+            pthread_cond_signal(&stack->cond);
+            while (stack->started) {
+                pthread_cond_wait(&stack->cond, &nOS_criticalSection);
+            }
+            pthread_join(stack->handle, NULL);
+            pthread_cond_destroy(&stack->cond);
+        }
+
+        thread->stackPtr = stack;
+        stack->entry = entry;
+        stack->arg = arg;
+        stack->crit = 0;
+        stack->started = false;
+        stack->running = false;
+        stack->exit = false;
+#if (NOS_CONFIG_THREAD_JOIN_ENABLE > 0)
+        stack->finished = false;
+#endif
 
-    pthread_cond_init(&stack->cond, NULL);
+        pthread_cond_init(&stack->cond, NULL);
 
-    pthread_create(&stack->handle, NULL, _Entry, thread);
+        pthread_create(&stack->handle, NULL, _Entry, thread);
 
-    /* Wait until thread is started and waiting to run */
-    while (!stack->started) {
-        pthread_cond_wait(&stack->cond, &nOS_criticalSection);
+        /* Wait until thread is started and waiting to run */
+        while (!stack->started) {
+            pthread_cond_wait(&stack->cond, &nOS_criticalSection);
+        }
     }
 }
 
-/* Called from critical section */
+/* Called from critical section, running thread give permission to run directly to high prio thread */
 void nOS_SwitchContext (void)
 {
+#if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+    nOS_Thread *thread = nOS_runningThread;
+#endif
     nOS_Stack *stack = nOS_runningThread->stackPtr;
 
-    /* Backup critical nesting counter and stop running */
-    stack->crit = nOS_criticalNestingCounter;
-    stack->running = false;
+    /* Find next high prio thread */
+#if (NOS_CONFIG_HIGHEST_THREAD_PRIO == 0)
+    nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList, nOS_Thread, readyWait);
+#elif (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
+    nOS_highPrioThread = nOS_FindHighPrioThread();
+#else
+    nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList[nOS_runningThread->prio], nOS_Thread, readyWait);
+#endif
 
-    /* Send scheduling request */
-    _schedRequest = true;
-    pthread_cond_signal(&_schedCond);
+    if (nOS_runningThread != nOS_highPrioThread) {
+        /* Backup critical nesting counter and stop running */
+        stack->crit = nOS_criticalNestingCounter;
+        stack->running = false;
+#if (NOS_CONFIG_THREAD_JOIN_ENABLE > 0)
+        /* Host thread can be reused if thread object is created again */
+        stack->finished = (nOS_runningThread->state == NOS_THREAD_FINISHED);
+#endif
 
-    /* Wait until we have permission to run */
-    while (!stack->running) {
-        pthread_cond_wait(&stack->cond, &nOS_criticalSection);
+#if (NOS_CONFIG_THREAD_STATS_ENABLE > 0) || (NOS_CONFIG_TRACE_ENABLE > 0)
+        nOS_AccountSwitch();
+#endif
+        /* Give permission to run to high prio thread */
+        nOS_runningThread = nOS_highPrioThread;
+        nOS_highPrioThread->stackPtr->running = true;
+        pthread_cond_signal(&nOS_highPrioThread->stackPtr->cond);
+
+        /* Wait until we have permission to run, mutex is released to high prio thread while waiting */
+        _WaitToRun(stack);
+
+        /* Restore critical nesting counter */
+        nOS_criticalNestingCounter = stack->crit;
+#if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+        /* Thread can be resumed on another core */
+        nOS_coreId = thread->core;
+#endif
     }
+}
 
-    /* Restore critical nesting counter */
-    nOS_criticalNestingCounter = stack->crit;
+#if (NOS_CONFIG_SMP_CORE_COUNT > 1)
+/* Called from critical section, simulated cores can't be interrupted: only idle thread of a core wait for this
+ * request, other threads see new scheduling decision at their next call to nOS (or nOS_Yield for main thread) */
+void nOS_ScheduleCore (uint8_t core)
+{
+    _corePending[core] = true;
+    pthread_cond_signal(&_coreCond[core]);
 }
+#endif
+
+#if (NOS_CONFIG_CYCLE_COUNTER_ENABLE > 0)
+/* No access to CPU cycles from user space, count nanoseconds instead */
+uint32_t nOS_GetCycleCount (void)
+{
+    return (uint32_t)_GetTimeNs();
+}
+#endif
 
 int nOS_Print (const char *format, ...)
 {
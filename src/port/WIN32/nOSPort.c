@@ -18,9 +18,15 @@ extern "C" {
 HANDLE                  nOS_hCritical;
 uint32_t                nOS_criticalNestingCounter;
 
-static HANDLE           _hSchedRequest;
 static nOS_Stack        _idleStack;
 
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+ #define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION  0x00000002
+#endif
+
+/* Waitable timers use 100 ns units */
+#define _TICK_PERIOD                    (10000000LL / NOS_CONFIG_TICKS_PER_SECOND)
+
 static DWORD WINAPI _Entry (LPVOID lpParameter)
 {
     nOS_Thread *thread = (nOS_Thread*)lpParameter;
@@ -29,86 +35,172 @@ static DWORD WINAPI _Entry (LPVOID lpParameter)
     nOS_criticalNestingCounter = 0;
     ReleaseMutex(nOS_hCritical);
 
+#if (NOS_CONFIG_THREAD_JOIN_ENABLE > 0)
+    /* Entry return only when a finished thread is created again with same thread object and stack */
+    while (true) {
+        thread->stackPtr->entry(thread->stackPtr->arg);
+    }
+#else
     /* Enter thread main loop */
     thread->stackPtr->entry(thread->stackPtr->arg);
+#endif
 
     return 0;
 }
 
-static DWORD WINAPI _Scheduler (LPVOID lpParameter)
+/* Called from critical section, give permission to run to high prio thread */
+static void _Resume (nOS_Thread *thread)
 {
-    NOS_UNUSED(lpParameter);
+    nOS_runningThread = thread;
 
-    while (!nOS_running) {
-        Sleep(1);
+    if (thread->stackPtr->sync) {
+        /* Thread is waiting in context switch */
+        thread->stackPtr->sync = false;
+        ReleaseSemaphore(thread->stackPtr->hsync, 1, NULL);
     }
+    else {
+        /* Thread has been preempted by SysTick or never run */
+        ResumeThread(thread->stackPtr->handle);
+    }
+}
 
-    while (true) {
-        /* Wait until a thread requesting a context switch */
-        while (WaitForSingleObject(_hSchedRequest, INFINITE) != WAIT_OBJECT_0);
-
-        /* Enter critical section */
-        while(WaitForSingleObject(nOS_hCritical, INFINITE) != WAIT_OBJECT_0);
-
-        /* Reset context switching request event in critical section */
-        ResetEvent(_hSchedRequest);
-
-        /* Suspend currently running thread */
-        SuspendThread(nOS_runningThread->stackPtr->handle);
-
-        nOS_runningThread = nOS_highPrioThread;
-
-        /* Resume high prio thread */
-        ResumeThread(nOS_highPrioThread->stackPtr->handle);
+#if (NOS_CONFIG_VIRTUAL_TIME_ENABLE == 0)
+static LONGLONG _GetTime (void)
+{
+    LARGE_INTEGER   freq;
+    LARGE_INTEGER   count;
 
-        /* Release sync object only if resumed thread is waiting in context switch */
-        if (nOS_highPrioThread->stackPtr->sync) {
-            nOS_highPrioThread->stackPtr->sync = false;
-            ReleaseSemaphore(nOS_highPrioThread->stackPtr->hsync, 1, NULL);
-        }
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
 
-        /* Leave critical section */
-        ReleaseMutex(nOS_hCritical);
-    }
-
-    return 0;
+    /* Convert to 100 ns units without overflow */
+    return ((count.QuadPart / freq.QuadPart) * 10000000LL) +
+           (((count.QuadPart % freq.QuadPart) * 10000000LL) / freq.QuadPart);
 }
+#else
+/* Called from critical section, true if no threads except main thread (idle) are ready to run */
+static bool _IsIdle (void)
+{
+#if (NOS_CONFIG_HIGHEST_THREAD_PRIO > 0)
+    return ((nOS_FindHighPrioThread() == &nOS_idleHandle) &&
+            (nOS_readyThreadsList[0].head == nOS_readyThreadsList[0].tail));
+#else
+    return (nOS_readyThreadsList.head == nOS_readyThreadsList.tail);
+#endif
+}
+#endif
 
 static DWORD WINAPI _SysTick (LPVOID lpParameter)
 {
+    nOS_TickCounter     ticks;
+#if (NOS_CONFIG_VIRTUAL_TIME_ENABLE == 0)
+    HANDLE              htimer;
+    LARGE_INTEGER       due;
+    LONGLONG            next;
+    LONGLONG            now;
+    LONGLONG            late;
+#endif
+#if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0) || (NOS_CONFIG_SCHED_ROUND_ROBIN_ENABLE > 0)
+    CONTEXT             ctx;
+#endif
+
     NOS_UNUSED(lpParameter);
 
+#if (NOS_CONFIG_VIRTUAL_TIME_ENABLE == 0)
+    /* High resolution timer is only available since Windows 10 1803, fallback to standard one */
+    htimer = CreateWaitableTimerExW(NULL,           /* Default security descriptor */
+                                    NULL,           /* No name */
+                                    CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+                                    TIMER_ALL_ACCESS);
+    if (htimer == NULL) {
+        htimer = CreateWaitableTimer(NULL,          /* Default security descriptor */
+                                     FALSE,         /* Auto reset */
+                                     NULL);         /* No name */
+    }
+#endif
+
     while (!nOS_running) {
         Sleep(1);
     }
 
+#if (NOS_CONFIG_VIRTUAL_TIME_ENABLE == 0)
+    next = _GetTime();
+#endif
     while (true) {
-        Sleep(1000/NOS_CONFIG_TICKS_PER_SECOND);
+#if (NOS_CONFIG_VIRTUAL_TIME_ENABLE > 0)
+        /* Let threads run until they are all waiting */
+        Sleep(0);
+#else
+        /* Wait until deadline of next tick, time spent in nOS_Tick don't accumulate */
+        next += _TICK_PERIOD;
+        now = _GetTime();
+        if (now < next) {
+            /* Negative due time is relative */
+            due.QuadPart = now - next;
+            SetWaitableTimer(htimer, &due, 0, NULL, NULL, FALSE);
+            while (WaitForSingleObject(htimer, INFINITE) != WAIT_OBJECT_0);
+        }
+
+        /* Catch up missed periods if host was late to wake up */
+        ticks = 1;
+        now = _GetTime();
+        if (now >= (next + _TICK_PERIOD)) {
+            late   = (now - next) / _TICK_PERIOD;
+            ticks += (nOS_TickCounter)late;
+            next  += late * _TICK_PERIOD;
+        }
+#endif
 
         /* Enter critical section */
         while(WaitForSingleObject(nOS_hCritical, INFINITE) != WAIT_OBJECT_0);
         nOS_criticalNestingCounter = 1;
 
-        /* Simulate entry in interrupt */
-        nOS_isrNestingCounter = 1;
+#if (NOS_CONFIG_VIRTUAL_TIME_ENABLE > 0)
+        if (!_IsIdle()) {
+            ticks = 0;
+        }
+ #if (NOS_CONFIG_TICKLESS_ENABLE > 0)
+        else {
+            /* Jump directly to next event */
+            ticks = nOS_GetNextWakeupTicks();
+            if ((ticks == 0) || (ticks == NOS_WAIT_INFINITE)) {
+                ticks = 1;
+            }
+        }
+ #else
+        else {
+            ticks = 1;
+        }
+ #endif
+#endif
+
+        if (ticks > 0) {
+            /* Simulate entry in interrupt */
+            nOS_isrNestingCounter = 1;
 
-        nOS_Tick(1);
+            nOS_Tick(ticks);
 
 #if (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0) || (NOS_CONFIG_SCHED_ROUND_ROBIN_ENABLE > 0)
  #if (NOS_CONFIG_HIGHEST_THREAD_PRIO == 0)
-        nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList);
+            nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList, nOS_Thread, readyWait);
  #elif (NOS_CONFIG_SCHED_PREEMPTIVE_ENABLE > 0)
-        nOS_highPrioThread = nOS_FindHighPrioThread();
+            nOS_highPrioThread = nOS_FindHighPrioThread();
  #else
-        nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList[nOS_runningThread->prio]);
+            nOS_highPrioThread = nOS_GetHeadOfList(&nOS_readyThreadsList[nOS_runningThread->prio], nOS_Thread, readyWait);
  #endif
-        if (nOS_runningThread != nOS_highPrioThread) {
-            SetEvent(_hSchedRequest);
-        }
+            if (nOS_runningThread != nOS_highPrioThread) {
+                /* Preempt running thread, it's outside of critical section, then switch directly to high prio */
+                SuspendThread(nOS_runningThread->stackPtr->handle);
+                /* SuspendThread is asynchronous, getting context wait until thread is really suspended */
+                ctx.ContextFlags = CONTEXT_CONTROL;
+                GetThreadContext(nOS_runningThread->stackPtr->handle, &ctx);
+                _Resume(nOS_highPrioThread);
+            }
 #endif
 
-        /* Simulate exit of interrupt */
-        nOS_isrNestingCounter = 0;
+            /* Simulate exit of interrupt */
+            nOS_isrNestingCounter = 0;
+        }
 
         /* Leave critical section */
         nOS_criticalNestingCounter = 0;
@@ -134,7 +226,7 @@ void nOS_InitSpecific (void)
                                        0,           /* Initial count = 0 */
                                        1,           /* Maximum count = 1 */
                                        NULL);       /* No name */
-    /* Convert pseudo handle of GetCurrentThread to real handle to be used by Scheduler */
+    /* Convert pseudo handle of GetCurrentThread to real handle to be used by SysTick */
     DuplicateHandle(GetCurrentProcess(),
                     GetCurrentThread(),
                     GetCurrentProcess(),
@@ -144,18 +236,6 @@ void nOS_InitSpecific (void)
                     DUPLICATE_SAME_ACCESS);
     _idleStack.id = GetCurrentThreadId();
 
-    /* Create an event for context switching request */
-    _hSchedRequest = CreateEvent(NULL,              /* Default security descriptor */
-                                 TRUE,              /* Manual reset */
-                                 FALSE,             /* Initial state is non-signaled */
-                                 NULL);             /* No name */
-
-    CreateThread(NULL,                              /* Default security descriptor */
-                 0,                                 /* Default stack size */
-                 _Scheduler,                        /* Start address of the thread */
-                 NULL,                              /* No argument */
-                 0,                                 /* Thread run immediately after creation */
-                 NULL);                             /* Don't get thread identifier */
     CreateThread(NULL,                              /* Default security descriptor */
                  0,                                 /* Default stack size */
                  _SysTick,                          /* Start address of the thread */
@@ -168,38 +248,58 @@ void nOS_InitContext (nOS_Thread *thread, nOS_Stack *stack, size_t ssize, nOS_Th
 {
     NOS_UNUSED(ssize);
 
-    thread->stackPtr = stack;
-    stack->entry = entry;
-    stack->arg = arg;
-    stack->sync = false;
-    /* Create a semaphore for context switching synchronization */
-    stack->hsync = CreateSemaphore(NULL,            /* Default security descriptor */
-                                   0,               /* Initial count = 0 */
-                                   1,               /* Maximum count = 1 */
-                                   NULL);           /* No name */
-    stack->handle = CreateThread(NULL,              /* Default security descriptor */
-                                 0,                 /* Default stack size */
-                                 _Entry,            /* Start address of the thread */
-                                 (LPVOID)thread,    /* Thread object as argument */
-                                 CREATE_SUSPENDED,  /* Thread created in suspended state */
-                                 &stack->id);       /* Store thread identifier in thread pseudo stack */
+#if (NOS_CONFIG_THREAD_JOIN_ENABLE > 0)
+    if ((thread->stackPtr == stack) && stack->finished) {
+        /* Host thread of finished thread is waiting in nOS_SwitchContext, it will return to _Entry and call new entry
+         * when its semaphore is released */
+        stack->entry = entry;
+        stack->arg = arg;
+        stack->finished = false;
+    } else
+#endif
+    {
+        thread->stackPtr = stack;
+        stack->entry = entry;
+        stack->arg = arg;
+        stack->sync = false;
+#if (NOS_CONFIG_THREAD_JOIN_ENABLE > 0)
+        stack->finished = false;
+#endif
+        /* Create a semaphore for context switching synchronization */
+        stack->hsync = CreateSemaphore(NULL,            /* Default security descriptor */
+                                       0,               /* Initial count = 0 */
+                                       1,               /* Maximum count = 1 */
+                                       NULL);           /* No name */
+        stack->handle = CreateThread(NULL,              /* Default security descriptor */
+                                     0,                 /* Default stack size */
+                                     _Entry,            /* Start address of the thread */
+                                     (LPVOID)thread,    /* Thread object as argument */
+                                     CREATE_SUSPENDED,  /* Thread created in suspended state */
+                                     &stack->id);       /* Store thread identifier in thread pseudo stack */
+    }
 }
 
+/* Called from critical section, running thread give permission to run directly to high prio thread */
 void nOS_SwitchContext (void)
 {
-    uint32_t crit;
+    nOS_Stack   *stack = nOS_runningThread->stackPtr;
+    uint32_t    crit;
 
     /* Backup thread's critical nesting counter */
     crit = nOS_criticalNestingCounter;
 
-    nOS_runningThread->stackPtr->sync = true;
-    SetEvent(_hSchedRequest);
+    stack->sync = true;
+#if (NOS_CONFIG_THREAD_JOIN_ENABLE > 0)
+    /* Host thread can be reused if thread object is created again */
+    stack->finished = (nOS_runningThread->state == NOS_THREAD_FINISHED);
+#endif
+    _Resume(nOS_highPrioThread);
 
-    /* Leave critical section (allow Scheduler and SysTick to run) */
+    /* Leave critical section (allow high prio thread and SysTick to run) */
     ReleaseMutex(nOS_hCritical);
 
-    /* Wait synchronization event from Scheduler */
-    while(WaitForSingleObject(nOS_runningThread->stackPtr->hsync, INFINITE) != WAIT_OBJECT_0);
+    /* Wait until another thread give us permission to run */
+    while(WaitForSingleObject(stack->hsync, INFINITE) != WAIT_OBJECT_0);
 
     /* Enter critical section */
     while(WaitForSingleObject(nOS_hCritical, INFINITE) != WAIT_OBJECT_0);